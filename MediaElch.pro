@@ -102,7 +102,12 @@ QMAKE_INFO_PLIST = MediaElch.plist
 SOURCES += src/main.cpp \
     src/concerts/ConcertController.cpp \
     src/data/MediaInfoFile.cpp \
+    src/network/HostTimeouts.cpp \
+    src/network/NetworkManager.cpp \
     src/network/NetworkRequest.cpp \
+    src/network/ReplayTransport.cpp \
+    src/network/RequestQueue.cpp \
+    src/network/ScrapeStats.cpp \
     src/ui/concerts/ConcertFilesWidget.cpp \
     src/ui/concerts/ConcertSearch.cpp \
     src/ui/concerts/ConcertSearchWidget.cpp \
@@ -114,7 +119,9 @@ SOURCES += src/main.cpp \
     src/concerts/ConcertModel.cpp \
     src/concerts/ConcertProxyModel.cpp \
     src/data/Database.cpp \
+    src/data/DatabaseService.cpp \
     src/data/ImageCache.cpp \
+    src/data/LibrarySnapshot.cpp \
     src/data/ResumeTime.cpp \
     src/movies/Movie.cpp \
     src/movies/file_searcher/MovieFileSearcher.cpp \
@@ -126,6 +133,7 @@ SOURCES += src/main.cpp \
     src/data/Rating.cpp \
     src/data/Storage.cpp \
     src/data/StreamDetails.cpp \
+    src/data/StreamDetailsAnalyzer.cpp \
     src/data/Subtitle.cpp \
     src/tv_shows/TvShow.cpp \
     src/tv_shows/TvShowEpisode.cpp \
@@ -142,10 +150,13 @@ SOURCES += src/main.cpp \
     src/imports/FileWorker.cpp \
     src/imports/DownloadFileSearcher.cpp \
     src/log/Log.cpp \
+    src/log/LogWriter.cpp \
+    src/export/CompiledTemplate.cpp \
     src/export/ExportTemplate.cpp \
     src/export/ExportTemplateLoader.cpp \
     src/export/MediaExport.cpp \
     src/export/SimpleEngine.cpp \
+    src/file/DirectoryListingCache.cpp \
     src/file/FileFilter.cpp \
     src/file/Path.cpp \
     src/globals/Actor.cpp \
@@ -158,6 +169,7 @@ SOURCES += src/main.cpp \
     src/globals/ImageDialog.cpp \
     src/globals/ImagePreviewDialog.cpp \
     src/globals/JsonRequest.cpp \
+    src/globals/LibraryReloader.cpp \
     src/globals/Manager.cpp \
     src/globals/MessageIds.cpp \
     src/globals/Meta.cpp \
@@ -193,6 +205,7 @@ SOURCES += src/main.cpp \
     src/media_centers/kodi/KodiNfoMeta.cpp \
     src/media_centers/kodi/MovieXmlReader.cpp \
     src/media_centers/kodi/MovieXmlWriter.cpp \
+    src/media_centers/kodi/NfoMergeWriter.cpp \
     src/media_centers/kodi/TvShowXmlReader.cpp \
     src/media_centers/kodi/TvShowXmlWriter.cpp \
     src/media_centers/kodi/v16/ArtistXmlWriterV16.cpp \
@@ -246,9 +259,13 @@ SOURCES += src/main.cpp \
     src/renamer/ConcertRenamer.cpp \
     src/renamer/EpisodeRenamer.cpp \
     src/renamer/MovieRenamer.cpp \
+    src/renamer/RenameJournal.cpp \
+    src/renamer/RenamePlan.cpp \
     src/renamer/Renamer.cpp \
     src/renamer/RenamerDialog.cpp \
     src/renamer/RenamerPlaceholders.cpp \
+    src/renamer/RenamerTemplate.cpp \
+    src/scrapers/HtmlPattern.cpp \
     src/scrapers/ScraperInterface.cpp \
     src/scrapers/image/FanartTv.cpp \
     src/scrapers/image/FanartTvMusic.cpp \
@@ -256,6 +273,8 @@ SOURCES += src/main.cpp \
     src/scrapers/image/TheTvDbImages.cpp \
     src/scrapers/image/TMDbImages.cpp \
     src/scrapers/concert/TMDbConcerts.cpp \
+    src/scrapers/imdb/ImdbActorImageCache.cpp \
+    src/scrapers/imdb/ImdbRequestQueue.cpp \
     src/scrapers/movie/AdultDvdEmpire.cpp \
     src/scrapers/movie/AEBN.cpp \
     src/scrapers/movie/CustomMovieScraper.cpp \
@@ -352,6 +371,9 @@ SOURCES += src/main.cpp \
     src/tv_shows/SeasonNumber.cpp \
     src/tv_shows/SeasonOrder.cpp \
     src/data/Certification.cpp \
+    src/data/ArtworkStage.cpp \
+    src/data/ArtworkWriter.cpp \
+    src/data/ContentHashCache.cpp \
     src/movies/MovieCrew.cpp \
     src/movies/MovieSet.cpp
 
@@ -362,7 +384,12 @@ macx {
 HEADERS  += Version.h \
     src/concerts/ConcertController.h \
     src/data/MediaInfoFile.h \
+    src/network/HostTimeouts.h \
+    src/network/NetworkManager.h \
     src/network/NetworkRequest.h \
+    src/network/ReplayTransport.h \
+    src/network/RequestQueue.h \
+    src/network/ScrapeStats.h \
     src/ui/concerts/ConcertFilesWidget.h \
     src/ui/concerts/ConcertSearch.h \
     src/ui/concerts/ConcertSearchWidget.h \
@@ -374,7 +401,9 @@ HEADERS  += Version.h \
     src/concerts/ConcertProxyModel.h \
     src/ui/concerts/ConcertStreamDetailsWidget.h \
     src/data/Database.h \
+    src/data/DatabaseService.h \
     src/data/ImageCache.h \
+    src/data/LibrarySnapshot.h \
     src/data/ResumeTime.h \
     src/media_centers/MediaCenterInterface.h \
     src/movies/Movie.h \
@@ -388,11 +417,14 @@ HEADERS  += Version.h \
     src/scrapers/music/MusicScraperInterface.h \
     src/scrapers/movie/MovieScraperInterface.h \
     src/scrapers/tv_show/TvScraperInterface.h \
+    src/scrapers/BackgroundParser.h \
+    src/scrapers/HtmlPattern.h \
     src/scrapers/ScraperInterface.h \
     src/data/Locale.h \
     src/data/Rating.h \
     src/data/Storage.h \
     src/data/StreamDetails.h \
+    src/data/StreamDetailsAnalyzer.h \
     src/data/Subtitle.h \
     src/tv_shows/TvShow.h \
     src/tv_shows/TvShowEpisode.h \
@@ -403,16 +435,19 @@ HEADERS  += Version.h \
     src/imports/MakeMkvCon.h \
     src/imports/MyFile.h \
     src/log/Log.h \
+    src/log/LogWriter.h \
     src/ui/export/ExportDialog.h \
     src/ui/imports/DownloadsWidget.h \
     src/ui/imports/ImportActions.h \
     src/ui/imports/ImportDialog.h \
     src/ui/imports/MakeMkvDialog.h \
     src/ui/imports/UnpackButtons.h \
+    src/export/CompiledTemplate.h \
     src/export/ExportTemplate.h \
     src/export/ExportTemplateLoader.h \
     src/export/MediaExport.h \
     src/export/SimpleEngine.h \
+    src/file/DirectoryListingCache.h \
     src/file/FileFilter.h \
     src/file/Path.h \
     src/globals/Actor.h \
@@ -425,6 +460,7 @@ HEADERS  += Version.h \
     src/globals/ImageDialog.h \
     src/globals/ImagePreviewDialog.h \
     src/globals/JsonRequest.h \
+    src/globals/LibraryReloader.h \
     src/globals/LocaleStringCompare.h \
     src/globals/Manager.h \
     src/globals/MessageIds.h \
@@ -466,6 +502,7 @@ HEADERS  += Version.h \
     src/media_centers/kodi/KodiNfoMeta.h \
     src/media_centers/kodi/MovieXmlReader.h \
     src/media_centers/kodi/MovieXmlWriter.h \
+    src/media_centers/kodi/NfoMergeWriter.h \
     src/media_centers/kodi/TvShowXmlReader.h \
     src/media_centers/kodi/v16/AlbumXmlWriterV16.h \
     src/media_centers/kodi/v16/ArtistXmlWriterV16.h \
@@ -520,10 +557,15 @@ HEADERS  += Version.h \
     src/renamer/ConcertRenamer.h \
     src/renamer/EpisodeRenamer.h \
     src/renamer/MovieRenamer.h \
+    src/renamer/RenameJournal.h \
+    src/renamer/RenamePlan.h \
     src/renamer/Renamer.h \
     src/renamer/RenamerDialog.h \
     src/renamer/RenamerPlaceholders.h \
+    src/renamer/RenamerTemplate.h \
     src/scrapers/concert/TMDbConcerts.h \
+    src/scrapers/imdb/ImdbActorImageCache.h \
+    src/scrapers/imdb/ImdbRequestQueue.h \
     src/scrapers/movie/AdultDvdEmpire.h \
     src/scrapers/movie/AEBN.h \
     src/scrapers/movie/CustomMovieScraper.h \
@@ -531,7 +573,9 @@ HEADERS  += Version.h \
     src/scrapers/movie/IMDB.h \
     src/scrapers/movie/imdb/ImdbMovieScraper.h \
     src/scrapers/movie/OFDb.h \
+    src/scrapers/movie/ScrapedMovieData.h \
     src/scrapers/movie/TMDb.h \
+    src/scrapers/movie/tmdb/TmdbMovieData.h \
     src/scrapers/movie/VideoBuster.h \
     src/scrapers/music/TvTunes.h \
     src/scrapers/music/UniversalMusicScraper.h \
@@ -620,6 +664,9 @@ HEADERS  += Version.h \
     src/tv_shows/SeasonNumber.h \
     src/tv_shows/SeasonOrder.h \
     src/data/Certification.h \
+    src/data/ArtworkStage.h \
+    src/data/ArtworkWriter.h \
+    src/data/ContentHashCache.h \
     src/movies/MovieCrew.h \
     src/movies/MovieSet.h
 
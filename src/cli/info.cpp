@@ -2,9 +2,12 @@
 
 #include "Version.h"
 #include "cli/common.h"
+#include "cli/info/ScrapeStatsReport.h"
 #include "cli/info/ScraperFeatureTable.h"
 #include "export/TableWriter.h"
 #include "globals/Manager.h"
+#include "network/ScrapeStats.h"
+#include "settings/Settings.h"
 
 #include <iomanip>
 #include <iostream>
@@ -15,6 +18,7 @@ namespace cli {
 enum class InfoObjectType
 {
     MovieScrapers,
+    ScrapeStats,
     Unknown
 };
 
@@ -23,6 +27,9 @@ static InfoObjectType infoTypeFromString(QString str)
     if ("movie_scrapers" == str) {
         return InfoObjectType::MovieScrapers;
     }
+    if ("scrape_stats" == str) {
+        return InfoObjectType::ScrapeStats;
+    }
     return InfoObjectType::Unknown;
 }
 
@@ -31,7 +38,9 @@ int info(QApplication& app, QCommandLineParser& parser)
     parser.clearPositionalArguments();
     // re-add this command so that it appears when help is printed
     parser.addPositionalArgument("info", "Query information about MediaElch.", "info [list_options]");
-    parser.addPositionalArgument("details", "What details to show. Possible values:\n - movie_scrapers", "<details>");
+    parser.addPositionalArgument("details",
+        "What details to show. Possible values:\n - movie_scrapers\n - scrape_stats (requests recorded by MediaElch)",
+        "<details>");
 
     parser.process(app);
 
@@ -44,6 +53,14 @@ int info(QApplication& app, QCommandLineParser& parser)
         printer.print();
         return 0;
     }
+    case InfoObjectType::ScrapeStats: {
+        // The samples are written by MediaElch when it quits, see Manager.
+        network::ScrapeStats& stats = network::ScrapeStats::instance();
+        stats.load(Settings::instance()->databaseDir().filePath("scrapeStats.json"));
+        ScrapeStatsReport report(std::cout, stats.samples());
+        report.print();
+        return 0;
+    }
     case InfoObjectType::Unknown:
         if (command.isEmpty()) {
             std::cout << "Missing info <details>" << std::endl;
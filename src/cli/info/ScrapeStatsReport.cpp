@@ -0,0 +1,70 @@
+#include "cli/info/ScrapeStatsReport.h"
+
+namespace mediaelch {
+namespace cli {
+
+void ScrapeStatsReport::print(int maxItems)
+{
+    if (m_samples.isEmpty()) {
+        m_out << "No scraper requests recorded, yet." << std::endl;
+        return;
+    }
+
+    m_out << "Scraper requests by provider (" << m_samples.size() << " requests):" << std::endl;
+    printProviders();
+    m_out << std::endl;
+    m_out << "Slowest items and their critical path:" << std::endl;
+    printItems(maxItems);
+}
+
+void ScrapeStatsReport::printProviders()
+{
+    TableLayout layout;
+    layout.addColumn(TableColumn("Provider", 20));
+    layout.addColumn(TableColumn("Requests", 8, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Failed", 6, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Timeouts", 8, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Retries", 7, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("KiB", 9, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("p50 ms", 7, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("p95 ms", 7, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("p99 ms", 7, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("max ms", 7, ColumnAlignment::Right));
+
+    TableWriter table(m_out, layout);
+    table.writeHeading();
+    for (const network::ProviderStats& provider : network::ScrapeStats::providerStats(m_samples)) {
+        table.writeCell(provider.provider);
+        table.writeCell(QString::number(provider.requests));
+        table.writeCell(QString::number(provider.failed));
+        table.writeCell(QString::number(provider.timeouts));
+        table.writeCell(QString::number(provider.retries));
+        table.writeCell(QString::number(provider.bytes / 1024));
+        table.writeCell(QString::number(provider.p50Ms));
+        table.writeCell(QString::number(provider.p95Ms));
+        table.writeCell(QString::number(provider.p99Ms));
+        table.writeCell(QString::number(provider.maxMs));
+    }
+}
+
+void ScrapeStatsReport::printItems(int maxItems)
+{
+    TableLayout layout;
+    layout.addColumn(TableColumn("Item", 30));
+    layout.addColumn(TableColumn("Requests", 8, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Total ms", 8, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Critical path", 60));
+
+    TableWriter table(m_out, layout);
+    table.writeHeading();
+    const QVector<network::ItemCriticalPath> items = network::ScrapeStats::criticalPaths(m_samples);
+    for (const network::ItemCriticalPath& item : items.mid(0, maxItems)) {
+        table.writeCell(item.item);
+        table.writeCell(QString::number(item.requests));
+        table.writeCell(QString::number(item.wallMs));
+        table.writeCell(network::criticalPathToString(item));
+    }
+}
+
+} // namespace cli
+} // namespace mediaelch
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "export/TableWriter.h"
+#include "network/ScrapeStats.h"
+
+#include <QVector>
+#include <ostream>
+#include <utility>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Prints per-provider latencies and the slowest items of the recorded scraper requests.
+class ScrapeStatsReport
+{
+public:
+    ScrapeStatsReport(std::ostream& out, QVector<network::RequestSample> samples) :
+        m_out{out}, m_samples{std::move(samples)}
+    {
+    }
+
+    void print(int maxItems = 10);
+
+private:
+    void printProviders();
+    void printItems(int maxItems);
+
+    std::ostream& m_out;
+    QVector<network::RequestSample> m_samples;
+};
+
+} // namespace cli
+} // namespace mediaelch
@@ -126,8 +126,13 @@ void ConcertController::loadData(TmdbId id, ConcertScraperInterface* scraperInte
 
 void ConcertController::loadStreamDetailsFromFile()
 {
-    using namespace std::chrono;
     m_concert->streamDetails()->loadStreamDetails();
+    updateFromStreamDetails();
+}
+
+void ConcertController::updateFromStreamDetails()
+{
+    using namespace std::chrono;
     seconds runtime(
         m_concert->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     m_concert->setRuntime(duration_cast<minutes>(runtime));
@@ -25,6 +25,7 @@ public:
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
     void loadData(TmdbId id, ConcertScraperInterface* scraperInterface, QSet<ConcertScraperInfos> infos);
     void loadStreamDetailsFromFile();
+    void updateFromStreamDetails();
     void scraperLoadDone(ConcertScraperInterface* scraper);
     QSet<ConcertScraperInfos> infosToLoad();
     bool infoLoaded() const;
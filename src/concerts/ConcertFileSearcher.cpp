@@ -2,9 +2,11 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QPair>
 #include <QSqlQuery>
 #include <QSqlRecord>
 
+#include "file/DirectoryListingCache.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
@@ -42,9 +44,23 @@ void ConcertFileSearcher::setConcertDirectories(QVector<SettingsDir> directories
 ///  2. Reload all entries from disk if it's forced here or in its directory settings
 ///  3. Load all entries from the database
 void ConcertFileSearcher::reload(bool force)
+{
+    prepareReload();
+    load(force);
+    addLoadedToGui();
+}
+
+void ConcertFileSearcher::prepareReload()
 {
     m_aborted = false;
+    m_loadedConcerts.clear();
+    // Pick up files that were changed by other programs.
+    mediaelch::DirectoryListingCache::instance().clear();
+    Manager::instance()->concertModel()->clear();
+}
 
+void ConcertFileSearcher::load(bool force)
+{
     clearOldConcerts(force);
 
     emit searchStarted(tr("Searching for Concerts..."));
@@ -55,12 +71,21 @@ void ConcertFileSearcher::reload(bool force)
     emit currentDir("");
     emit searchStarted(tr("Loading Concerts..."));
 
-    addConcertsToGui(loadConcertsFromDatabase());
-
+    m_loadedConcerts = loadConcertsFromDatabase();
     qDebug() << "Searching for concerts done";
-    if (!m_aborted) {
-        emit concertsLoaded();
+}
+
+void ConcertFileSearcher::addLoadedToGui()
+{
+    if (m_aborted) {
+        // Concerts of an aborted reload are never added to the model.
+        qDeleteAll(m_loadedConcerts);
+        m_loadedConcerts.clear();
+        return;
     }
+    addConcertsToGui(m_loadedConcerts);
+    m_loadedConcerts.clear();
+    emit concertsLoaded();
 }
 
 /**
@@ -185,9 +210,6 @@ void ConcertFileSearcher::clearOldConcerts(bool forceClear)
         database().clearAllConcerts();
     }
 
-    // clear gui
-    Manager::instance()->concertModel()->clear();
-
     for (const SettingsDir& dir : m_directories) {
         if (dir.autoReload || forceClear) {
             database().clearConcertsInDirectory(dir.path);
@@ -212,10 +234,11 @@ QVector<QStringList> ConcertFileSearcher::loadContentsFromDiskIfRequired(bool fo
 void ConcertFileSearcher::storeContentsInDatabase(const QVector<QStringList>& contents)
 {
     // Setup concerts
-    database().transaction();
+    // The concerts are stored after all were loaded so that the write lock isn't held while reading NFO files.
+    QVector<QPair<Concert*, QString>> concerts;
     for (const QStringList& files : contents) {
         if (m_aborted) {
-            return;
+            break;
         }
 
         bool inSeparateFolder = false;
@@ -241,13 +264,24 @@ void ConcertFileSearcher::storeContentsInDatabase(const QVector<QStringList>& co
                 path = m_directories[index].path.path();
             }
         }
-        Concert concert(files, this);
-        concert.setInSeparateFolder(inSeparateFolder);
-        concert.controller()->loadData(Manager::instance()->mediaCenterInterface());
-        emit currentDir(concert.name());
-        database().add(&concert, path);
+        auto* concert = new Concert(files, this);
+        concert->setInSeparateFolder(inSeparateFolder);
+        concert->controller()->loadData(Manager::instance()->mediaCenterInterface());
+        emit currentDir(concert->name());
+        concerts.append({concert, path});
+    }
+
+    const bool stored = database().writeInTransaction([&]() {
+        for (const auto& concert : concerts) {
+            database().add(concert.first, concert.second);
+        }
+    });
+    if (!stored) {
+        qWarning() << "[ConcertFileSearcher] Could not store the concerts in the cache";
+    }
+    for (const auto& concert : concerts) {
+        delete concert.first;
     }
-    database().commit();
 }
 
 void ConcertFileSearcher::setupDatabaseConcerts(QVector<Concert*>& dbConcerts)
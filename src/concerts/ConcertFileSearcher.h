@@ -6,6 +6,7 @@
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <atomic>
 
 class ConcertFileSearcher : public QObject
 {
@@ -14,7 +15,17 @@ public:
     explicit ConcertFileSearcher(QObject* parent = nullptr);
     void setConcertDirectories(QVector<SettingsDir> directories);
 
+    /// \brief Clears the concert model and resets the searcher. Must be called in the GUI thread.
+    void prepareReload();
+    /// \brief Loads all concerts without touching the GUI. May be called in a worker thread
+    ///        if the searcher lives in it, see LibraryReloader.
+    void load(bool force);
+    /// \brief Adds concerts of the last load() to the concert model and emits concertsLoaded().
+    ///        Must be called in the GUI thread.
+    void addLoadedToGui();
+
 public slots:
+    /// \brief Reloads all concerts in the current thread.
     void reload(bool force);
     void abort();
 
@@ -27,7 +38,8 @@ signals:
 private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
-    bool m_aborted = false;
+    QVector<Concert*> m_loadedConcerts;
+    std::atomic<bool> m_aborted{false};
 
 private:
     Database& database();
@@ -0,0 +1,292 @@
+#include "data/ArtworkStage.h"
+
+#include "data/ContentHashCache.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include <atomic>
+
+namespace mediaelch {
+
+/// Not a member of ArtworkStage: images may be released after the stage was destroyed on exit.
+static std::atomic<qint64> s_memoryUsage{0};
+
+struct StagedImage::Entry
+{
+    Entry() = default;
+    Entry(const Entry&) = delete;
+    Entry& operator=(const Entry&) = delete;
+
+    ~Entry()
+    {
+        if (countsAgainstBudget) {
+            s_memoryUsage -= size;
+        }
+        if (!file.isEmpty()) {
+            QFile::remove(file);
+        }
+    }
+
+    /// Guards data and file: images are moved to disk by the writer thread of the stage.
+    mutable QMutex mutex;
+    QByteArray data;
+    QString file;
+    qint64 size = 0;
+    QByteArray hash;
+    bool countsAgainstBudget = false;
+};
+
+StagedImage StagedImage::fromData(const QByteArray& data)
+{
+    if (data.isNull()) {
+        return {};
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->data = data;
+    entry->size = data.size();
+    entry->hash = ContentHashCache::contentHash(data);
+    return StagedImage(entry);
+}
+
+qint64 StagedImage::size() const
+{
+    return isNull() ? 0 : m_entry->size;
+}
+
+QByteArray StagedImage::hash() const
+{
+    return isNull() ? QByteArray() : m_entry->hash;
+}
+
+QByteArray StagedImage::data() const
+{
+    if (isNull()) {
+        return {};
+    }
+    QString fileName;
+    {
+        QMutexLocker locker(&m_entry->mutex);
+        if (m_entry->file.isEmpty()) {
+            return m_entry->data;
+        }
+        fileName = m_entry->file;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[ArtworkStage] Could not read staged image" << fileName;
+        return {};
+    }
+    return file.readAll();
+}
+
+QString StagedImage::stagedFile() const
+{
+    if (isNull()) {
+        return {};
+    }
+    QMutexLocker locker(&m_entry->mutex);
+    return m_entry->file;
+}
+
+StagingWriter::StagingWriter(ArtworkStage& stage) : m_stage{stage}, m_hash{QCryptographicHash::Md5}
+{
+    // Same hash as ContentHashCache::contentHash().
+}
+
+StagingWriter::~StagingWriter()
+{
+    if (m_file.isOpen()) {
+        m_file.close();
+        m_file.remove();
+    }
+}
+
+void StagingWriter::write(const QByteArray& chunk)
+{
+    if (chunk.isEmpty()) {
+        return;
+    }
+    m_hash.addData(chunk);
+    const qint64 stagedBytes = m_size;
+    m_size += chunk.size();
+
+    if (!m_file.isOpen() && (m_inMemoryOnly || m_size <= ArtworkStage::smallImageLimit())) {
+        m_buffer.append(chunk);
+        return;
+    }
+    if (!m_file.isOpen()) {
+        m_file.setFileName(m_stage.newFilePath());
+        if (m_file.fileName().isEmpty() || !m_file.open(QIODevice::WriteOnly)
+            || m_file.write(m_buffer) != m_buffer.size()) {
+            keepInMemory(0);
+            m_buffer.append(chunk);
+            return;
+        }
+        m_buffer.clear();
+    }
+    if (m_file.write(chunk) != chunk.size()) {
+        keepInMemory(stagedBytes);
+        m_buffer.append(chunk);
+    }
+}
+
+void StagingWriter::keepInMemory(qint64 stagedBytes)
+{
+    // Better use more memory than losing the image.
+    qWarning() << "[ArtworkStage] Could not stage image on disk, keeping it in memory:" << m_file.fileName();
+    if (m_file.isOpen()) {
+        m_file.close();
+        if (stagedBytes > 0 && m_file.open(QIODevice::ReadOnly)) {
+            m_buffer = m_file.read(stagedBytes);
+            m_file.close();
+        }
+    }
+    m_file.remove();
+    m_inMemoryOnly = true;
+}
+
+StagedImage StagingWriter::finish()
+{
+    if (m_size == 0) {
+        return {};
+    }
+    auto entry = std::make_shared<StagedImage::Entry>();
+    entry->size = m_size;
+    entry->hash = m_hash.result().toHex();
+
+    if (m_file.isOpen() && !m_file.flush()) {
+        keepInMemory(m_size);
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+        entry->file = m_file.fileName();
+        return StagedImage(entry);
+    }
+
+    const QByteArray data = m_buffer;
+    m_buffer.clear();
+    if (m_inMemoryOnly) {
+        entry->data = data;
+        return StagedImage(entry);
+    }
+    return m_stage.place(entry, data);
+}
+
+ArtworkStage::ArtworkStage()
+{
+    m_writer.setMaxThreadCount(1);
+}
+
+ArtworkStage& ArtworkStage::instance()
+{
+    static ArtworkStage s_instance;
+    return s_instance;
+}
+
+qint64 ArtworkStage::memoryBudget() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_memoryBudget;
+}
+
+void ArtworkStage::setMemoryBudget(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_memoryBudget = qMax<qint64>(0, bytes);
+}
+
+qint64 ArtworkStage::memoryUsage()
+{
+    return s_memoryUsage;
+}
+
+StagedImage ArtworkStage::stage(const QByteArray& data)
+{
+    if (data.isNull()) {
+        return {};
+    }
+
+    auto entry = std::make_shared<StagedImage::Entry>();
+    entry->size = data.size();
+    entry->hash = ContentHashCache::contentHash(data);
+    return place(entry, data);
+}
+
+std::unique_ptr<StagingWriter> ArtworkStage::beginStaging()
+{
+    return std::unique_ptr<StagingWriter>(new StagingWriter(*this));
+}
+
+void ArtworkStage::waitForPendingWrites()
+{
+    m_writer.waitForDone();
+}
+
+StagedImage ArtworkStage::place(std::shared_ptr<StagedImage::Entry> entry, const QByteArray& data)
+{
+    if (data.size() <= smallImageLimit() && reserveMemory(data.size())) {
+        entry->data = data;
+        entry->countsAgainstBudget = true;
+        return StagedImage(entry);
+    }
+
+    // The image is kept in memory until the writer thread has staged it, so that the calling
+    // thread, usually the GUI thread, doesn't wait for the disk.
+    entry->data = data;
+    const QString filePath = newFilePath();
+    if (filePath.isEmpty()) {
+        qWarning() << "[ArtworkStage] Could not stage image on disk, keeping it in memory";
+        return StagedImage(entry);
+    }
+    QtConcurrent::run(&m_writer, [entry, data, filePath]() {
+        if (entry.use_count() == 1) {
+            return; // released before it was staged
+        }
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.flush()) {
+            // Better use more memory than losing the image.
+            qWarning() << "[ArtworkStage] Could not stage image on disk, keeping it in memory:" << filePath;
+            file.close();
+            file.remove();
+            return;
+        }
+        file.close();
+        QMutexLocker locker(&entry->mutex);
+        entry->file = filePath;
+        entry->data.clear();
+    });
+    return StagedImage(entry);
+}
+
+bool ArtworkStage::reserveMemory(qint64 bytes)
+{
+    const qint64 budget = memoryBudget();
+    qint64 usage = s_memoryUsage;
+    do {
+        if (usage + bytes > budget) {
+            return false;
+        }
+    } while (!s_memoryUsage.compare_exchange_weak(usage, usage + bytes));
+    return true;
+}
+
+QString ArtworkStage::newFilePath()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_dir == nullptr) {
+        m_dir = std::make_unique<QTemporaryDir>(QDir::temp().filePath("MediaElch-artwork-XXXXXX"));
+        if (!m_dir->isValid()) {
+            qWarning() << "[ArtworkStage] Could not create a staging directory in" << QDir::tempPath();
+        }
+    }
+    if (!m_dir->isValid()) {
+        return {};
+    }
+    return m_dir->path() + QString("/%1.img").arg(++m_fileCounter);
+}
+
+} // namespace mediaelch
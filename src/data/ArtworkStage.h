@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <memory>
+
+namespace mediaelch {
+
+/// \brief Handle of an image that was downloaded or loaded but not saved, yet.
+///
+/// The image's bytes are either kept in memory or in a file of the ArtworkStage.  Copies of a
+/// handle share the image; it is released once the last handle is destroyed.  Default-constructed
+/// handles are null.  Handles are immutable and can be passed between threads.
+class StagedImage
+{
+public:
+    StagedImage() = default;
+    /// \brief Wraps data without staging it, e.g. for images that are written right away.
+    static StagedImage fromData(const QByteArray& data);
+
+    bool isNull() const { return m_entry == nullptr; }
+    qint64 size() const;
+    /// \brief Content hash of the image, see ContentHashCache::contentHash().
+    QByteArray hash() const;
+    /// \brief The image's bytes.  Reads the staged file if the image is not kept in memory.
+    QByteArray data() const;
+    /// \brief The staged file or an empty string if the image is kept in memory or is still being
+    ///        written to the stage, see ArtworkStage::waitForPendingWrites().
+    QString stagedFile() const;
+
+    struct Entry;
+
+private:
+    friend class ArtworkStage;
+    friend class StagingWriter;
+    explicit StagedImage(std::shared_ptr<const Entry> entry) : m_entry{std::move(entry)} {}
+
+    std::shared_ptr<const Entry> m_entry;
+};
+
+class ArtworkStage;
+
+/// \brief Stages an image chunk by chunk, e.g. while it is downloaded.  See ArtworkStage::beginStaging().
+///
+/// Chunks are kept in memory until the image exceeds ArtworkStage::smallImageLimit().  From then on
+/// they are appended to a file of the stage, so that large images are never buffered completely.
+class StagingWriter
+{
+public:
+    /// Removes the staged file if finish() was not called.
+    ~StagingWriter();
+
+    void write(const QByteArray& chunk);
+    /// \brief Returns the staged image or a null handle if nothing was written.
+    StagedImage finish();
+
+private:
+    friend class ArtworkStage;
+    explicit StagingWriter(ArtworkStage& stage);
+    /// Moves the first \p stagedBytes of the staging file back into memory, e.g. if the disk is full.
+    void keepInMemory(qint64 stagedBytes);
+
+    ArtworkStage& m_stage;
+    QByteArray m_buffer;
+    QFile m_file;
+    QCryptographicHash m_hash;
+    qint64 m_size = 0;
+    /// Set if the staging file could not be written.
+    bool m_inMemoryOnly = false;
+};
+
+/// \brief Staging area for artwork that is not saved, yet.
+///
+/// Scraping many movies downloads posters, backdrops, extra fanarts and actor thumbnails that
+/// are only written once the user saves.  Instead of keeping all of them in memory, images larger
+/// than smallImageLimit() and all images that exceed the memory budget are written to a
+/// temporary directory.  Movies and actors only hold StagedImage handles to them; TV shows and
+/// concerts still keep their artwork as bytes.  Thread-safe.
+class ArtworkStage
+{
+public:
+    static ArtworkStage& instance();
+
+    /// Images up to this size are kept in memory as long as the memory budget allows it.
+    static constexpr qint64 smallImageLimit() { return 256 * 1024; }
+    static constexpr qint64 defaultMemoryBudget() { return 64 * 1024 * 1024; }
+
+    /// \brief Bytes of small images that are kept in memory at most.  0 stages all images on disk.
+    qint64 memoryBudget() const;
+    void setMemoryBudget(qint64 bytes);
+    /// \brief Bytes of staged images that are currently kept in memory.
+    static qint64 memoryUsage();
+
+    /// \brief Stages \p data.  Returns a null handle if \p data is null.  Images that are staged on
+    ///        disk are written by a background thread; until then, they are kept in memory.
+    StagedImage stage(const QByteArray& data);
+    /// \brief Starts staging an image whose data arrives in chunks, e.g. from QNetworkReply::readyRead.
+    std::unique_ptr<StagingWriter> beginStaging();
+    /// \brief Blocks until all images passed to stage() are written to disk.
+    void waitForPendingWrites();
+
+private:
+    friend class StagingWriter;
+    ArtworkStage();
+    /// Keeps \p data of \p entry in memory if the budget allows it or writes it to the stage.
+    StagedImage place(std::shared_ptr<StagedImage::Entry> entry, const QByteArray& data);
+    bool reserveMemory(qint64 bytes);
+    /// Path of a new file in the staging directory; empty if there is none.
+    QString newFilePath();
+
+    mutable QMutex m_mutex;
+    qint64 m_memoryBudget = defaultMemoryBudget();
+    std::unique_ptr<QTemporaryDir> m_dir;
+    quint64 m_fileCounter = 0;
+    /// Writes images to the stage off the calling thread, one after the other.
+    QThreadPool m_writer;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,273 @@
+#include "data/ArtworkWriter.h"
+
+#include "data/ContentHashCache.h"
+#include "file/DirectoryListingCache.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+namespace mediaelch {
+
+ArtworkWriter::ArtworkWriter(ContentHashCache* hashes) : m_hashes{hashes}
+{
+}
+
+void ArtworkWriter::add(const FilePath& file, const QByteArray& data)
+{
+    enqueue(file, wrap(data), false);
+}
+
+void ArtworkWriter::add(const FilePath& file, const StagedImage& image)
+{
+    enqueue(file, image, false);
+}
+
+void ArtworkWriter::addActorThumb(const FilePath& file, const QByteArray& data)
+{
+    enqueue(file, wrap(data), true);
+}
+
+void ArtworkWriter::addActorThumb(const FilePath& file, const StagedImage& image)
+{
+    enqueue(file, image, true);
+}
+
+void ArtworkWriter::addExtraFanart(const DirectoryPath& dir, const QByteArray& data)
+{
+    addExtraFanart(dir, wrap(data));
+}
+
+void ArtworkWriter::addExtraFanart(const DirectoryPath& dir, const StagedImage& image)
+{
+    if (image.isNull()) {
+        return;
+    }
+    const QByteArray hash = image.hash();
+    const QDir directory = dir.dir();
+
+    for (const QFileInfo& existing : directory.entryInfoList({"fanart*.jpg"}, QDir::Files)) {
+        if (existing.size() == image.size()
+            && m_hashes->isUnchanged(FilePath(existing.absoluteFilePath()), image.size(), hash)) {
+            ++m_skipped;
+            return;
+        }
+    }
+    for (const Job& job : m_jobs) {
+        if (job.image.hash() == hash && m_reservedFiles.contains(job.file.toString())
+            && QFileInfo(job.file.toString()).absolutePath() == directory.absolutePath()) {
+            ++m_skipped;
+            return;
+        }
+    }
+
+    int num = 1;
+    QString fileName;
+    do {
+        fileName = directory.absoluteFilePath(QString("fanart%1.jpg").arg(num++));
+    } while (m_reservedFiles.contains(fileName) || QFileInfo::exists(fileName));
+
+    m_reservedFiles.insert(fileName);
+    enqueue(fileName, image, false);
+}
+
+void ArtworkWriter::enqueue(const FilePath& file, const StagedImage& image, bool linkable)
+{
+    if (!file.isValid() || image.isNull()) {
+        return;
+    }
+    Job job;
+    job.file = file;
+    job.image = image;
+    job.linkable = linkable;
+    m_jobs.append(job);
+}
+
+StagedImage ArtworkWriter::wrap(const QByteArray& data)
+{
+    if (data.isNull()) {
+        return {};
+    }
+    auto known = m_wrappedData.constFind(data.constData());
+    if (known != m_wrappedData.cend() && known.value().size() == data.size()) {
+        return known.value();
+    }
+    const StagedImage image = StagedImage::fromData(data);
+    m_wrappedData.insert(data.constData(), image);
+    return image;
+}
+
+bool ArtworkWriter::commit()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<Job> writes;
+    QVector<QPair<Job, FilePath>> links;
+    // First file of this batch that is written for a payload.
+    QHash<QByteArray, FilePath> linkSources;
+
+    for (const Job& job : m_jobs) {
+        if (m_hashes->isUnchanged(job.file, job.image.size(), job.image.hash())) {
+            ++m_skipped;
+            continue;
+        }
+        if (job.linkable) {
+            // Actors appear in many titles, so thumbnails are linked across directories as well.
+            FilePath source = linkSources.value(job.image.hash());
+            if (!source.isValid()) {
+                source = m_hashes->fileWithHash(job.image.hash());
+            }
+            if (source.isValid() && source != job.file) {
+                links.append(qMakePair(job, source));
+                continue;
+            }
+            linkSources.insert(job.image.hash(), job.file);
+        }
+        writes.append(job);
+    }
+
+    QSet<QString> dirs;
+    for (const Job& job : m_jobs) {
+        dirs.insert(QFileInfo(job.file.toString()).absolutePath());
+    }
+    for (const QString& dir : dirs) {
+        QDir().mkpath(dir);
+    }
+
+    // File paths are passed as strings: FilePath's QFileInfo must not be shared across threads.
+    QThreadPool pool;
+    pool.setMaxThreadCount(maxParallelWrites());
+    QVector<QFuture<bool>> results;
+    results.reserve(writes.size());
+    for (const Job& job : writes) {
+        const QString path = job.file.toString();
+        const StagedImage image = job.image;
+        results.append(QtConcurrent::run(&pool, [path, image]() { return writeFile(path, image); }));
+    }
+    pool.waitForDone();
+
+    bool success = true;
+    for (int i = 0; i < writes.size(); ++i) {
+        if (results[i].result()) {
+            m_hashes->remember(writes[i].file, writes[i].image.hash());
+            DirectoryListingCache::instance().invalidateFileDir(writes[i].file.toString());
+            ++m_written;
+        } else {
+            success = false;
+        }
+    }
+
+    for (const auto& link : links) {
+        const Job& job = link.first;
+        const QString path = job.file.toString();
+        if (replaceWithLink(link.second.toString(), path)) {
+            ++m_linked;
+        } else if (writeFile(path, job.image)) {
+            ++m_written;
+        } else {
+            success = false;
+            continue;
+        }
+        m_hashes->remember(job.file, job.image.hash());
+        DirectoryListingCache::instance().invalidateFileDir(path);
+    }
+
+    qDebug() << "[ArtworkWriter] Wrote" << m_written << "files, linked" << m_linked << "and skipped" << m_skipped
+             << "unchanged ones in" << timer.elapsed() << "ms";
+
+    m_jobs.clear();
+    m_wrappedData.clear();
+    m_reservedFiles.clear();
+    return success;
+}
+
+bool ArtworkWriter::writeFile(const QString& filePath, const StagedImage& image)
+{
+    const QString stagedFile = image.stagedFile();
+    // Replace the file instead of writing it in place: it may be hardlinked.
+    QSaveFile out(filePath);
+    if (!out.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ArtworkWriter] File could not be opened for writing:" << filePath;
+        return false;
+    }
+    if (stagedFile.isEmpty()) {
+        out.write(image.data());
+    } else {
+        // Copy in chunks: staged images may be large.
+        QFile in(stagedFile);
+        if (!in.open(QIODevice::ReadOnly)) {
+            qWarning() << "[ArtworkWriter] Staged image could not be read:" << stagedFile;
+            out.cancelWriting();
+            return false;
+        }
+        while (!in.atEnd()) {
+            const QByteArray chunk = in.read(64 * 1024);
+            if (chunk.isEmpty() || out.write(chunk) != chunk.size()) {
+                out.cancelWriting();
+                break;
+            }
+        }
+    }
+    if (!out.commit()) {
+        qWarning() << "[ArtworkWriter] File could not be written:" << filePath;
+        return false;
+    }
+    return true;
+}
+
+bool ArtworkWriter::replaceWithLink(const QString& existing, const QString& file)
+{
+    // Link under a temporary name in the same directory and rename it over the file, so that the file
+    // is replaced at once and stays as it is if linking fails, e.g. across file systems.
+    static QAtomicInt s_linkCounter;
+    const QString tempLink = QStringLiteral("%1.link-%2-%3")
+                                 .arg(file)
+                                 .arg(QCoreApplication::applicationPid())
+                                 .arg(s_linkCounter.fetchAndAddOrdered(1));
+    QFile::remove(tempLink);
+    if (!hardLink(existing, tempLink)) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    const bool renamed = MoveFileExW(reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(tempLink).utf16()),
+                             reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(file).utf16()),
+                             MOVEFILE_REPLACE_EXISTING)
+                         != 0;
+#else
+    const bool renamed = std::rename(QFile::encodeName(tempLink).constData(), QFile::encodeName(file).constData()) == 0;
+#endif
+    // rename() does nothing if both names already refer to the same file.
+    QFile::remove(tempLink);
+    return renamed;
+}
+
+bool ArtworkWriter::hardLink(const QString& existing, const QString& link)
+{
+#ifdef Q_OS_WIN
+    return CreateHardLinkW(reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(link).utf16()),
+               reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(existing).utf16()),
+               nullptr)
+           != 0;
+#else
+    // Fails across file systems, e.g. for libraries on several drives.
+    return ::link(QFile::encodeName(existing).constData(), QFile::encodeName(link).constData()) == 0;
+#endif
+}
+
+} // namespace mediaelch
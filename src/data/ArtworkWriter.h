@@ -0,0 +1,83 @@
+#pragma once
+
+#include "data/ArtworkStage.h"
+#include "file/Path.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+namespace mediaelch {
+
+class ContentHashCache;
+
+/// Writes the images of one save operation, e.g. of a movie, as one batch.
+///
+/// Images are queued with add(), addActorThumb() and addExtraFanart() and written by commit():
+///  - Files whose content is unchanged on disk are skipped (see ContentHashCache).
+///  - Each distinct payload is hashed only once, even if it is written to several files.
+///  - Images staged on disk (see ArtworkStage) are copied into place in chunks, without
+///    loading them into memory.
+///  - Files are written in parallel, at most maxParallelWrites() at once.
+///  - Actor thumbnails that are identical to a thumbnail written before, in this batch or in
+///    an earlier one, are hardlinked to it where the file system allows it, also across titles.
+///  - Extra fanarts that already exist in the extrafanart directory are not added again.
+///
+/// Files are replaced and never written in place, so that writing one of several hardlinked
+/// files does not change the others.  Links are created under a temporary name and renamed over
+/// the target, so that the target is never missing.
+class ArtworkWriter
+{
+public:
+    explicit ArtworkWriter(ContentHashCache* hashes);
+
+    static constexpr int maxParallelWrites() { return 4; }
+
+    void add(const FilePath& file, const QByteArray& data);
+    void add(const FilePath& file, const StagedImage& image);
+    void addActorThumb(const FilePath& file, const QByteArray& data);
+    void addActorThumb(const FilePath& file, const StagedImage& image);
+    /// Queues data as "fanart<n>.jpg" in \p dir with the first free n, unless \p dir already
+    /// contains a fanart with the same content.
+    void addExtraFanart(const DirectoryPath& dir, const QByteArray& data);
+    void addExtraFanart(const DirectoryPath& dir, const StagedImage& image);
+
+    /// Writes all queued files.  Returns false if any of them could not be written.
+    bool commit();
+
+    int writtenFiles() const { return m_written; }
+    int linkedFiles() const { return m_linked; }
+    int skippedFiles() const { return m_skipped; }
+
+    /// Creates \p link as a hardlink to \p existing.  \p link must not exist.
+    static bool hardLink(const QString& existing, const QString& link);
+    /// Replaces \p file by a hardlink to \p existing.  \p file is unchanged if that fails.
+    static bool replaceWithLink(const QString& existing, const QString& file);
+
+private:
+    struct Job
+    {
+        FilePath file;
+        StagedImage image;
+        bool linkable = false;
+    };
+
+    void enqueue(const FilePath& file, const StagedImage& image, bool linkable);
+    StagedImage wrap(const QByteArray& data);
+    static bool writeFile(const QString& filePath, const StagedImage& image);
+
+    ContentHashCache* m_hashes = nullptr;
+    QVector<Job> m_jobs;
+    /// Payloads that were already hashed, by their data pointer.  The images hold the payloads,
+    /// which keeps the pointers valid until the batch is committed.
+    QHash<const char*, StagedImage> m_wrappedData;
+    /// Extra fanart files that are queued but not yet written.
+    QSet<QString> m_reservedFiles;
+    int m_written = 0;
+    int m_linked = 0;
+    int m_skipped = 0;
+};
+
+} // namespace mediaelch
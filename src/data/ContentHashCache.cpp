@@ -0,0 +1,235 @@
+#include "data/ContentHashCache.h"
+
+#include "data/Database.h"
+#include "data/DatabaseService.h"
+#include "file/DirectoryListingCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace mediaelch {
+
+/// Resolution of modification times.  Qt only reports milliseconds; times without a millisecond part
+/// are likely from file systems that only store (even) seconds, e.g. FAT or ext3.
+static qint64 modificationTimeResolution(qint64 lastModified)
+{
+    return lastModified % 1000 == 0 ? 2000 : 1;
+}
+
+ContentHashCache::ContentHashCache(DatabaseService* database, QObject* parent) : QObject(parent), m_database{database}
+{
+    if (m_database != nullptr) {
+        m_persistedHashes = m_database->read(
+            std::function<QHash<QString, Database::FileHashRecord>(Database&)>([](Database& db) { //
+                return db.fileHashes();
+            }));
+        m_persistedHashesTaken = false;
+    }
+}
+
+bool ContentHashCache::persistedHashesLoaded()
+{
+    QMutexLocker locker(&m_mutex);
+    takePersistedHashes();
+    return m_persistedHashesTaken;
+}
+
+int ContentHashCache::skippedFiles() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_skippedFiles;
+}
+
+qint64 ContentHashCache::skippedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_skippedBytes;
+}
+
+QByteArray ContentHashCache::contentHash(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+}
+
+QByteArray ContentHashCache::contentHash(QIODevice* device)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(device);
+    return hash.result().toHex();
+}
+
+bool ContentHashCache::write(const FilePath& file, const QByteArray& data, QIODevice::OpenMode mode)
+{
+    if (isUnchanged(file, data)) {
+        QMutexLocker locker(&m_mutex);
+        ++m_skippedFiles;
+        m_skippedBytes += data.size();
+        qDebug() << "[ContentHashCache] Content unchanged, skip writing" << file.toString() << "| Skipped so far:"
+                 << m_skippedFiles << "files," << m_skippedBytes << "bytes";
+        return true;
+    }
+
+    QDir dir = QFileInfo(file.toString()).dir();
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+
+    // The existing file is only replaced if all data could be written, e.g. not if the disk is full.
+    QSaveFile out(file.toString());
+    if (!out.open(mode | QIODevice::WriteOnly)) {
+        qWarning() << "[ContentHashCache] File could not be opened for writing:" << file.toString();
+        return false;
+    }
+    if (out.write(data) != data.size() || !out.commit()) {
+        qWarning() << "[ContentHashCache] File could not be written:" << file.toString() << out.errorString();
+        return false;
+    }
+    DirectoryListingCache::instance().invalidateFileDir(file.toString());
+
+    store(file, contentHash(data));
+    return true;
+}
+
+bool ContentHashCache::isUnchanged(const FilePath& file, const QByteArray& data)
+{
+    return isUnchanged(file, data.size(), contentHash(data));
+}
+
+bool ContentHashCache::isUnchanged(const FilePath& file, qint64 dataSize, const QByteArray& hash)
+{
+    const QFileInfo fi(file.toString());
+    if (!fi.exists()) {
+        return false;
+    }
+
+    const qint64 size = fi.size();
+    const qint64 lastModified = fi.lastModified().toMSecsSinceEpoch();
+
+    Entry known;
+    if (entry(file, known) && known.size == size && known.lastModified == lastModified && !isRacy(known)) {
+        return known.hash == hash;
+    }
+
+    // Unknown file, modified by another program or possibly modified after the hash was stored:
+    // Compare the actual content.
+    if (size != dataSize) {
+        return false;
+    }
+    QFile in(file.toString());
+    if (!in.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray existingHash = contentHash(&in);
+    in.close();
+
+    store(file, existingHash);
+    return existingHash == hash;
+}
+
+void ContentHashCache::remember(const FilePath& file, const QByteArray& hash)
+{
+    store(file, hash);
+}
+
+FilePath ContentHashCache::fileWithHash(const QByteArray& hash)
+{
+    QString fileName;
+    Entry known;
+    {
+        QMutexLocker locker(&m_mutex);
+        fileName = m_filesByHash.value(hash);
+        if (fileName.isEmpty()) {
+            return {};
+        }
+        known = m_entries.value(fileName);
+    }
+
+    const FilePath file(fileName);
+    const QFileInfo fi(fileName);
+    bool isValid = fi.exists() && known.hash == hash && known.size == fi.size()
+                   && known.lastModified == fi.lastModified().toMSecsSinceEpoch();
+    if (isValid && isRacy(known)) {
+        QFile in(fileName);
+        isValid = in.open(QIODevice::ReadOnly) && contentHash(&in) == hash;
+    }
+    if (!isValid) {
+        QMutexLocker locker(&m_mutex);
+        m_filesByHash.remove(hash);
+        return {};
+    }
+    if (isRacy(known)) {
+        store(file, hash);
+    }
+    return file;
+}
+
+bool ContentHashCache::isRacy(const Entry& entry)
+{
+    return entry.stored >= 0 && entry.stored - entry.lastModified < modificationTimeResolution(entry.lastModified);
+}
+
+bool ContentHashCache::entry(const FilePath& file, Entry& entry)
+{
+    QMutexLocker locker(&m_mutex);
+    takePersistedHashes();
+    auto cached = m_entries.constFind(file.toString());
+    if (cached == m_entries.cend()) {
+        return false;
+    }
+    entry = cached.value();
+    return true;
+}
+
+void ContentHashCache::takePersistedHashes()
+{
+    if (m_persistedHashesTaken || !m_persistedHashes.isFinished()) {
+        return;
+    }
+    m_persistedHashesTaken = true;
+    const QHash<QString, Database::FileHashRecord> hashes = m_persistedHashes.result();
+    for (auto it = hashes.cbegin(); it != hashes.cend(); ++it) {
+        // Hashes of this session are newer.
+        if (!m_entries.contains(it.key())) {
+            Entry entry;
+            entry.hash = it.value().hash;
+            entry.size = it.value().size;
+            entry.lastModified = it.value().lastModified;
+            m_entries.insert(it.key(), entry);
+        }
+    }
+    m_persistedHashes = {};
+}
+
+void ContentHashCache::store(const FilePath& file, const QByteArray& hash)
+{
+    const QFileInfo fi(file.toString());
+    Entry entry;
+    entry.hash = hash;
+    entry.size = fi.size();
+    entry.lastModified = fi.lastModified().toMSecsSinceEpoch();
+    entry.stored = QDateTime::currentMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.insert(file.toString(), entry);
+        m_filesByHash.insert(hash, file.toString());
+    }
+
+    if (m_database != nullptr) {
+        // Racy entries are stored with an invalid time, so that the file is compared by content after
+        // a restart.  File paths are passed as strings: FilePath must not be shared across threads.
+        const QString path = file.toString();
+        const qint64 size = entry.size;
+        const qint64 lastModified = isRacy(entry) ? -1 : entry.lastModified;
+        m_database->write([path, hash, size, lastModified](Database& db) {
+            db.setFileHash(FilePath(path), hash, size, lastModified);
+        });
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "data/Database.h"
+#include "file/Path.h"
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+namespace mediaelch {
+
+class DatabaseService;
+
+/// Remembers content hashes of files written by MediaElch (NFO files, images).
+/// Writing a file whose content would not change is skipped so that its
+/// modification time stays the same and Kodi or backup tools don't have to
+/// re-read it. Hashes are stored in the database and thus survive restarts.
+/// A stored hash is only trusted if the file's size and modification time
+/// are unchanged as well, i.e. the file was not modified by other programs.
+/// Files that were modified shortly before their hash was stored may be changed
+/// again without a new modification time, see isRacy(); they are compared by content.
+///
+/// Thread-safe. Hashes are written to the database by the DatabaseService. Hashes of earlier
+/// sessions are loaded in the background; until then, files are compared by content.
+class ContentHashCache : public QObject
+{
+    Q_OBJECT
+public:
+    /// If database is null, hashes are only kept for this session.  Otherwise the stored hashes
+    /// are loaded in the background.
+    explicit ContentHashCache(DatabaseService* database, QObject* parent = nullptr);
+
+    /// Writes data to the given file unless the file already has the same content.
+    /// Directories are created if necessary. Returns false if the file could not be written.
+    bool write(const FilePath& file, const QByteArray& data, QIODevice::OpenMode mode = QIODevice::WriteOnly);
+    /// Returns true if the file exists and its content equals data.
+    bool isUnchanged(const FilePath& file, const QByteArray& data);
+    /// Same as above but for content of the given size and contentHash(), e.g. of a staged image.
+    bool isUnchanged(const FilePath& file, qint64 dataSize, const QByteArray& hash);
+
+    /// Remembers the hash of a file that was written without write(), e.g. by ArtworkWriter.
+    void remember(const FilePath& file, const QByteArray& hash);
+    /// Returns a file that was written in this session with the given content hash and was not
+    /// modified since, or an invalid path if there is none.
+    FilePath fileWithHash(const QByteArray& hash);
+
+    /// Returns true once the hashes of earlier sessions are available.
+    bool persistedHashesLoaded();
+
+    int skippedFiles() const;
+    qint64 skippedBytes() const;
+
+    static QByteArray contentHash(const QByteArray& data);
+    /// Same as above but reads the content from device without loading it into memory at once.
+    static QByteArray contentHash(QIODevice* device);
+
+private:
+    struct Entry
+    {
+        QByteArray hash;
+        qint64 size = -1;
+        qint64 lastModified = -1;
+        /// Time at which the hash was stored.  -1 for hashes of earlier sessions.
+        qint64 stored = -1;
+    };
+
+    /// Returns true if the file could have been changed after the hash was stored without
+    /// changing its modification time, i.e. if it was stored within the time resolution of
+    /// the file system after the file's last modification.
+    static bool isRacy(const Entry& entry);
+    bool entry(const FilePath& file, Entry& entry);
+    void store(const FilePath& file, const QByteArray& hash);
+    /// Adds the hashes of earlier sessions once they are loaded.  Requires m_mutex.
+    void takePersistedHashes();
+
+private:
+    /// Only guards the members below; file I/O is done without holding it.
+    mutable QMutex m_mutex;
+    DatabaseService* m_database = nullptr;
+    QFuture<QHash<QString, Database::FileHashRecord>> m_persistedHashes;
+    bool m_persistedHashesTaken = true;
+    /// Paths are stored as strings: FilePath must not be shared across threads.
+    QHash<QString, Entry> m_entries;
+    /// Files by their hash.
+    QHash<QByteArray, QString> m_filesByHash;
+    int m_skippedFiles = 0;
+    qint64 m_skippedBytes = 0;
+};
+
+} // namespace mediaelch
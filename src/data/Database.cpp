@@ -1,11 +1,15 @@
 #include "Database.h"
 
+#include <QAtomicInt>
 #include <QDebug>
 #include <QDesktopServices>
 #include <QDir>
+#include <QPair>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <QThread>
+#include <QThreadStorage>
 
 #include "concerts/Concert.h"
 #include "data/Subtitle.h"
@@ -21,15 +25,108 @@
 
 using namespace mediaelch;
 
-Database::Database(QObject* parent) : QObject(parent)
+namespace {
+
+/// Database connections of a worker thread by Database instance. They are removed when the thread finishes.
+struct ThreadConnections
+{
+    QHash<int, QString> names;
+    ~ThreadConnections()
+    {
+        for (const QString& name : names) {
+            QSqlDatabase::removeDatabase(name);
+        }
+    }
+};
+
+/// Runs a prepared statement and logs why it failed instead of silently losing the row.
+bool execQuery(QSqlQuery& query)
+{
+    if (query.exec()) {
+        return true;
+    }
+    qWarning() << "[Database] Statement failed:" << query.lastQuery() << query.lastError().text();
+    return false;
+}
+
+} // namespace
+
+static QThreadStorage<ThreadConnections*> s_threadConnections;
+static QAtomicInt s_connectionCounter;
+static QAtomicInt s_instanceCounter;
+
+/// How often starting or committing a write transaction is tried. Each attempt waits up to the busy timeout.
+static constexpr int s_writeLockAttempts = 3;
+
+/// Larger pages keep most NFO contents of a row on a single page.
+static constexpr int s_pageSize = 8192;
+/// Read the database through a memory mapping of up to 256 MiB instead of read() calls.
+static constexpr qint64 s_mmapSize = 256 * 1024 * 1024;
+
+/// Prefix of compressed contents. Uncompressed contents are XML and therefore start with "<".
+static const QByteArray s_compressedContentMagic = QByteArrayLiteral("MEZ1");
+
+/// Lookups that run for each item or directory of a library (re)load.  All of them must use an
+/// index, see Database::indexedStatements().
+static constexpr const char* s_sqlMoviesInDirectory =
+    "SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, M.hasLogo, "
+    "M.hasClearArt, M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
+    "FROM movies M "
+    "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
+    "LEFT JOIN labels L ON MF.file=L.fileName "
+    "WHERE path=:path "
+    "ORDER BY M.idMovie, MF.file";
+static constexpr const char* s_sqlDeleteMovieFilesInDirectory =
+    "DELETE FROM movieFiles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)";
+static constexpr const char* s_sqlConcertsInDirectory =
+    "SELECT idConcert, content, inSeparateFolder FROM concerts WHERE path=:path";
+static constexpr const char* s_sqlConcertFiles = "SELECT file FROM concertFiles WHERE idConcert=:idConcert";
+static constexpr const char* s_sqlShowsInDirectory = "SELECT idShow, dir, content, path FROM shows WHERE path=:path";
+static constexpr const char* s_sqlShowId = "SELECT idShow FROM shows WHERE dir=:dir";
+static constexpr const char* s_sqlEpisodesOfShow =
+    "SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow";
+static constexpr const char* s_sqlDeleteEpisodesInDirectory = "DELETE FROM episodes WHERE path=:path";
+static constexpr const char* s_sqlEpisodeFiles = "SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode";
+static constexpr const char* s_sqlShowSettingsId = "SELECT idShow FROM showsSettings WHERE dir=:dir";
+static constexpr const char* s_sqlShowsEpisodes =
+    "SELECT E.content, E.seasonNumber, E.episodeNumber FROM showsEpisodes E "
+    "JOIN showsSettings S ON E.idShow=S.idShow WHERE S.dir=:dir";
+static constexpr const char* s_sqlShowsEpisodeId = "SELECT idEpisode FROM showsEpisodes WHERE tvdbid=:tvdbid";
+static constexpr const char* s_sqlDeleteOutdatedShowsEpisodes =
+    "DELETE FROM showsEpisodes WHERE idShow=:idShow AND updated=0";
+static constexpr const char* s_sqlLabel = "SELECT color FROM labels WHERE fileName=:fileName";
+static constexpr const char* s_sqlFileHash = "SELECT hash, size, lastModified FROM fileHashes WHERE fileName=:fileName";
+static constexpr const char* s_sqlArtistsInDirectory = "SELECT idArtist, content, dir FROM artists WHERE path=:path";
+static constexpr const char* s_sqlAlbumsOfArtist = "SELECT idAlbum, content, dir FROM albums WHERE idArtist=:idArtist";
+static constexpr const char* s_sqlDeleteAlbumsInDirectory = "DELETE FROM albums WHERE path=:path";
+
+/// Settings that are not stored in the database file and must be set for each connection.
+static void configureConnection(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    query.exec("PRAGMA synchronous=0;");
+    query.exec("PRAGMA cache_size=20000;");
+    query.exec(QStringLiteral("PRAGMA mmap_size=%1;").arg(s_mmapSize));
+}
+
+Database::Database(QObject* parent) :
+    Database(Settings::instance()->databaseDir().filePath("MediaElch.sqlite"), parent)
+{
+}
+
+Database::Database(const mediaelch::FilePath& databaseFile, QObject* parent) :
+    QObject(parent), m_instanceId{s_instanceCounter.fetchAndAddOrdered(1)}
 {
-    mediaelch::DirectoryPath dataLocation = Settings::instance()->databaseDir();
+    mediaelch::DirectoryPath dataLocation = databaseFile.dir();
     QDir dir(dataLocation.dir());
     if (!dir.exists()) {
         dir.mkpath(dataLocation.toString());
     }
-    m_db = new QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "mediaDb"));
-    m_db->setDatabaseName(dataLocation.filePath("MediaElch.sqlite"));
+    m_db = new QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", QStringLiteral("mediaDb%1").arg(m_instanceId)));
+    m_db->setDatabaseName(databaseFile.toString());
+    // Libraries may be loaded in parallel, each with its own connection.
+    // Wait for other connections' write transactions instead of failing.
+    m_db->setConnectOptions("QSQLITE_BUSY_TIMEOUT=30000");
     if (!m_db->open()) {
         qWarning() << "Could not open cache database";
     } else {
@@ -37,40 +134,48 @@ Database::Database(QObject* parent) : QObject(parent)
 
         int myDbVersion = -1;
         query.prepare("SELECT * FROM sqlite_master WHERE name ='settings' and type='table';");
-        query.exec();
+        execQuery(query);
         if (query.next()) {
             query.prepare("SELECT value FROM settings WHERE idSettings=1");
-            query.exec();
+            execQuery(query);
             if (query.next()) {
                 myDbVersion = query.value(0).toInt();
             }
         }
 
+        if (myDbVersion < 0) {
+            // Only has an effect before the first table is created.
+            query.exec(QStringLiteral("PRAGMA page_size=%1;").arg(s_pageSize));
+        }
+
+        // Migrations that change the page size or free many pages rebuild the file once at the end.
+        bool vacuum = false;
+
         if (myDbVersion < 14) {
             query.prepare("DROP TABLE IF EXISTS movies;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS movieFiles;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS concerts;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS concertFiles;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS shows;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS showsSettings;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS episodes;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS showsEpisodes;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS episodeFiles;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS settings;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS importCache;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS labels;");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS movies ( "
                           "\"idMovie\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
@@ -87,39 +192,39 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"hasExtraFanarts\" integer NOT NULL, "
                           "\"discType\" integer NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS movieFiles( "
                           "\"idFile\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"idMovie\" integer NOT NULL, "
                           "\"file\" text NOT NULL "
                           ");");
-            query.exec();
+            execQuery(query);
             query.prepare("CREATE INDEX id_movie_idx ON movieFiles(idMovie);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS concerts ( "
                           "\"idConcert\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"content\" text NOT NULL, "
                           "\"inSeparateFolder\" integer NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS concertFiles( "
                           "\"idFile\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"idConcert\" integer NOT NULL, "
                           "\"file\" text NOT NULL "
                           ");");
-            query.exec();
+            execQuery(query);
             query.prepare("CREATE INDEX id_concert_idx ON concertFiles(idConcert);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS shows ( "
                           "\"idShow\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"dir\" text NOT NULL, "
                           "\"content\" text NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS showsSettings ( "
                           "\"idShow\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
@@ -128,7 +233,7 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"showMissingEpisodes\" integer NOT NULL, "
                           "\"hideSpecialsInMissingEpisodes\" integer NOT NULL, "
                           "\"dir\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS showsEpisodes ( "
                           "\"idEpisode\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
@@ -138,7 +243,7 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"episodeNumber\" integer NOT NULL, "
                           "\"tvdbid\" text NOT NULL, "
                           "\"updated\" integer NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS episodes ( "
                           "\"idEpisode\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
@@ -147,24 +252,24 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"seasonNumber\" integer NOT NULL, "
                           "\"episodeNumber\" integer NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS episodeFiles( "
                           "\"idFile\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"idEpisode\" integer NOT NULL, "
                           "\"file\" text NOT NULL "
                           ");");
-            query.exec();
+            execQuery(query);
             query.prepare("CREATE INDEX id_episode_idx ON episodeFiles(idEpisode);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS labels ( "
                           "\"idLabel\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"color\" integer NOT NULL, "
                           "\"fileName\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
             query.prepare("CREATE INDEX id_label_filename_idx ON tags(fileName);");
-            query.exec();
+            execQuery(query);
 
 
             query.prepare("CREATE TABLE IF NOT EXISTS importCache ( "
@@ -172,7 +277,7 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"filename\" text NOT NULL, "
                           "\"type\" text NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             myDbVersion = 14;
             updateDbVersion(14);
@@ -180,15 +285,15 @@ Database::Database(QObject* parent) : QObject(parent)
 
         if (myDbVersion < 15) {
             query.prepare("DROP TABLE IF EXISTS artists;");
-            query.exec();
+            execQuery(query);
             query.prepare("DROP TABLE IF EXISTS albums;");
-            query.exec();
+            execQuery(query);
             query.prepare("CREATE TABLE IF NOT EXISTS artists ( "
                           "\"idArtist\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                           "\"content\" text NOT NULL, "
                           "\"dir\" text NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS albums ( "
                           "\"idAlbum\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
@@ -196,14 +301,14 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"content\" text NOT NULL, "
                           "\"dir\" text NOT NULL, "
                           "\"path\" text NOT NULL);");
-            query.exec();
+            execQuery(query);
             myDbVersion = 15;
             updateDbVersion(15);
         }
 
         if (myDbVersion < 16) {
             query.prepare("DROP TABLE IF EXISTS movieSubtitles;");
-            query.exec();
+            execQuery(query);
 
             query.prepare("CREATE TABLE IF NOT EXISTS movieSubtitles( "
                           "\"idSubtitle\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
@@ -212,20 +317,93 @@ Database::Database(QObject* parent) : QObject(parent)
                           "\"language\" text NOT NULL, "
                           "\"forced\" integer NOT NULL "
                           ");");
-            query.exec();
+            execQuery(query);
             query.prepare("CREATE INDEX id_subtitle_idx ON movieSubtitles(idMovie);");
-            query.exec();
+            execQuery(query);
 
             myDbVersion = 16;
-            Q_UNUSED(myDbVersion);
             updateDbVersion(16);
         }
 
-        query.prepare("PRAGMA synchronous=0;");
-        query.exec();
+        if (myDbVersion < 17) {
+            query.prepare("CREATE TABLE IF NOT EXISTS fileHashes( "
+                          "\"fileName\" text NOT NULL PRIMARY KEY, "
+                          "\"hash\" text NOT NULL, "
+                          "\"size\" integer NOT NULL, "
+                          "\"lastModified\" integer NOT NULL "
+                          ");");
+            execQuery(query);
+
+            myDbVersion = 17;
+            updateDbVersion(17);
+        }
+
+        if (myDbVersion < 18) {
+            // Indexes match the WHERE and JOIN clauses below. Indexes that end with the selected columns
+            // (e.g. movieFiles(idMovie, file)) cover the query, so the table itself is not read.
+            const QStringList statements{"DROP INDEX IF EXISTS id_movie_idx;",
+                "DROP INDEX IF EXISTS id_concert_idx;",
+                "DROP INDEX IF EXISTS id_episode_idx;",
+                "CREATE INDEX IF NOT EXISTS movies_path_idx ON movies(path);",
+                "CREATE INDEX IF NOT EXISTS movie_files_idx ON movieFiles(idMovie, file);",
+                "CREATE INDEX IF NOT EXISTS labels_filename_idx ON labels(fileName, color);",
+                "CREATE INDEX IF NOT EXISTS concerts_path_idx ON concerts(path);",
+                "CREATE INDEX IF NOT EXISTS concert_files_idx ON concertFiles(idConcert, file);",
+                "CREATE INDEX IF NOT EXISTS shows_path_idx ON shows(path);",
+                "CREATE INDEX IF NOT EXISTS shows_dir_idx ON shows(dir);",
+                "CREATE INDEX IF NOT EXISTS shows_settings_dir_idx ON showsSettings(dir);",
+                "CREATE INDEX IF NOT EXISTS shows_episodes_show_idx ON showsEpisodes(idShow, updated);",
+                "CREATE INDEX IF NOT EXISTS shows_episodes_tvdbid_idx ON showsEpisodes(tvdbid);",
+                "CREATE INDEX IF NOT EXISTS episodes_show_idx ON episodes(idShow);",
+                "CREATE INDEX IF NOT EXISTS episodes_path_idx ON episodes(path);",
+                "CREATE INDEX IF NOT EXISTS episode_files_idx ON episodeFiles(idEpisode, file);",
+                "CREATE INDEX IF NOT EXISTS artists_path_idx ON artists(path);",
+                "CREATE INDEX IF NOT EXISTS albums_artist_idx ON albums(idArtist);",
+                "CREATE INDEX IF NOT EXISTS albums_path_idx ON albums(path);"};
+            for (const QString& statement : statements) {
+                if (!query.exec(statement)) {
+                    qWarning() << "[Database] Migration failed:" << statement << query.lastError().text();
+                }
+            }
+
+            // The page size of an existing database only changes when it is rebuilt,
+            // which is not possible in WAL mode.
+            query.exec(QStringLiteral("PRAGMA page_size=%1;").arg(s_pageSize));
+            vacuum = true;
+
+            myDbVersion = 18;
+            updateDbVersion(18);
+        }
+
+        if (myDbVersion < 19) {
+            compressStoredContent();
+            vacuum = true; // return the freed pages to the file system
+
+            myDbVersion = 19;
+            updateDbVersion(19);
+        }
 
-        query.prepare("PRAGMA cache_size=20000;");
-        query.exec();
+        if (myDbVersion < 20) {
+            query.prepare("CREATE TABLE IF NOT EXISTS imdbActorImages( "
+                          "\"profileUrl\" text NOT NULL PRIMARY KEY, "
+                          "\"imageUrl\" text NOT NULL, "
+                          "\"updated\" integer NOT NULL "
+                          ");");
+            execQuery(query);
+
+            myDbVersion = 20;
+            Q_UNUSED(myDbVersion);
+            updateDbVersion(20);
+        }
+
+        if (vacuum && !query.exec("VACUUM;")) {
+            qWarning() << "[Database] Could not rebuild the database:" << query.lastError().text();
+        }
+
+        // Readers don't block the writer and vice versa, see DatabaseService.
+        // The journal mode is stored in the database file.
+        query.exec("PRAGMA journal_mode=WAL;");
+        configureConnection(*m_db);
     }
 }
 
@@ -245,76 +423,203 @@ void Database::updateDbVersion(int version)
 {
     QSqlQuery query(*m_db);
     query.prepare("SELECT * FROM sqlite_master WHERE name ='settings' and type='table';");
-    query.exec();
+    execQuery(query);
     if (!query.next()) {
         query.prepare("CREATE TABLE IF NOT EXISTS settings( "
                       "\"idSettings\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
                       "\"value\" text NOT NULL "
                       ");");
-        query.exec();
+        execQuery(query);
     }
 
     query.prepare("SELECT value FROM settings WHERE idSettings=1");
-    query.exec();
+    execQuery(query);
     if (query.next()) {
         query.prepare("UPDATE settings SET value=:dbVersion WHERE idSettings=1");
         query.bindValue(":dbVersion", QString::number(version));
-        query.exec();
+        execQuery(query);
     } else {
         query.prepare("INSERT INTO settings(idSettings, value) VALUES(1, :dbVersion)");
         query.bindValue(":dbVersion", QString::number(version));
-        query.exec();
+        execQuery(query);
+    }
+}
+
+void Database::compressStoredContent()
+{
+    const QVector<QPair<QString, QString>> tables{{"movies", "idMovie"},
+        {"concerts", "idConcert"},
+        {"shows", "idShow"},
+        {"episodes", "idEpisode"},
+        {"showsEpisodes", "idEpisode"},
+        {"artists", "idArtist"},
+        {"albums", "idAlbum"}};
+
+    m_db->transaction();
+    for (const auto& table : tables) {
+        QSqlQuery selectQuery(*m_db);
+        selectQuery.exec(QStringLiteral("SELECT %1, content FROM %2").arg(table.second, table.first));
+        QSqlQuery updateQuery(*m_db);
+        updateQuery.prepare(
+            QStringLiteral("UPDATE %1 SET content=:content WHERE %2=:id").arg(table.first, table.second));
+        while (selectQuery.next()) {
+            const QByteArray content = selectQuery.value(1).toByteArray();
+            if (content.startsWith(s_compressedContentMagic)) {
+                continue;
+            }
+            updateQuery.bindValue(":content", compressContent(content));
+            updateQuery.bindValue(":id", selectQuery.value(0));
+            execQuery(updateQuery);
+        }
     }
+    m_db->commit();
+}
+
+QByteArray Database::compressContent(const QString& content)
+{
+    return compressContent(content.toUtf8());
+}
+
+QByteArray Database::compressContent(const QByteArray& utf8Content)
+{
+    if (utf8Content.isEmpty()) {
+        return QByteArray(""); // "content" columns are NOT NULL
+    }
+    const QByteArray compressed = s_compressedContentMagic + qCompress(utf8Content);
+    return compressed.size() < utf8Content.size() ? compressed : utf8Content;
+}
+
+QString Database::uncompressContent(const QByteArray& data)
+{
+    if (!data.startsWith(s_compressedContentMagic)) {
+        return QString::fromUtf8(data);
+    }
+    const QByteArray content = qUncompress(data.mid(s_compressedContentMagic.size()));
+    if (content.isEmpty()) {
+        qWarning() << "[Database] Could not uncompress cached NFO content";
+    }
+    return QString::fromUtf8(content);
+}
+
+QStringList Database::indexedStatements()
+{
+    return {s_sqlMoviesInDirectory,
+        s_sqlDeleteMovieFilesInDirectory,
+        s_sqlConcertsInDirectory,
+        s_sqlConcertFiles,
+        s_sqlShowsInDirectory,
+        s_sqlShowId,
+        s_sqlEpisodesOfShow,
+        s_sqlDeleteEpisodesInDirectory,
+        s_sqlEpisodeFiles,
+        s_sqlShowSettingsId,
+        s_sqlShowsEpisodes,
+        s_sqlShowsEpisodeId,
+        s_sqlDeleteOutdatedShowsEpisodes,
+        s_sqlLabel,
+        s_sqlFileHash,
+        s_sqlArtistsInDirectory,
+        s_sqlAlbumsOfArtist,
+        s_sqlDeleteAlbumsInDirectory};
 }
 
 /**
  * @brief Returns an object to the cache database
  * @return Cache database object
+ *
+ * SQLite connections must not be shared between threads, so each
+ * worker thread gets its own connection to the same database file.
  */
 QSqlDatabase Database::db()
 {
-    return *m_db;
+    if (QThread::currentThread() == thread()) {
+        return *m_db;
+    }
+    if (!s_threadConnections.hasLocalData()) {
+        s_threadConnections.setLocalData(new ThreadConnections);
+    }
+    // Connections are per instance: each Database may use another file.
+    QHash<int, QString>& names = s_threadConnections.localData()->names;
+    if (!names.contains(m_instanceId)) {
+        const QString name = QStringLiteral("mediaDb_%1").arg(s_connectionCounter.fetchAndAddOrdered(1));
+        QSqlDatabase threadDb = QSqlDatabase::cloneDatabase(*m_db, name);
+        if (!threadDb.open()) {
+            qWarning() << "[Database] Could not open cache database for thread" << name;
+        } else {
+            configureConnection(threadDb);
+        }
+        names.insert(m_instanceId, name);
+    }
+    return QSqlDatabase::database(names.value(m_instanceId));
 }
 
-void Database::transaction()
+bool Database::transaction()
 {
-    db().transaction();
+    QSqlQuery query(db());
+    for (int attempt = 1; attempt <= s_writeLockAttempts; ++attempt) {
+        // Take the write lock right away so that no statement inside the transaction fails with SQLITE_BUSY
+        // because another connection started writing in the meantime.
+        if (query.exec("BEGIN IMMEDIATE")) {
+            return true;
+        }
+        qWarning() << "[Database] Could not start a write transaction, attempt" << attempt << ":"
+                   << query.lastError().text();
+    }
+    return false;
 }
 
-void Database::commit()
+bool Database::commit()
 {
-    db().commit();
+    QSqlQuery query(db());
+    for (int attempt = 1; attempt <= s_writeLockAttempts; ++attempt) {
+        if (query.exec("COMMIT")) {
+            return true;
+        }
+        qWarning() << "[Database] Could not commit, attempt" << attempt << ":" << query.lastError().text();
+    }
+    query.exec("ROLLBACK");
+    qWarning() << "[Database] Rolled back the write transaction";
+    return false;
+}
+
+bool Database::writeInTransaction(const std::function<void()>& writes)
+{
+    if (!transaction()) {
+        return false;
+    }
+    writes();
+    return commit();
 }
 
 void Database::clearAllMovies()
 {
     QSqlQuery query(db());
     query.prepare("DELETE FROM movies");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movies'");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM movieFiles");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movieFiles'");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM movieSubtitles");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
-    query.exec();
+    execQuery(query);
 }
 
 void Database::clearMoviesInDirectory(DirectoryPath path)
 {
     QSqlQuery query(db());
-    query.prepare("DELETE FROM movieFiles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
+    query.prepare(s_sqlDeleteMovieFilesInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM movieSubtitles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM movies WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
 }
 
 void Database::add(Movie* movie, DirectoryPath path)
@@ -324,7 +629,7 @@ void Database::add(Movie* movie, DirectoryPath path)
                   "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
                   "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
                   ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
+    query.bindValue(":content", compressContent(movie->nfoContent()));
     query.bindValue(
         ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
     query.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
@@ -338,14 +643,14 @@ void Database::add(Movie* movie, DirectoryPath path)
     query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
     query.bindValue(":discType", static_cast<int>(movie->discType()));
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     int insertId = query.lastInsertId().toInt();
 
     for (const mediaelch::FilePath& file : movie->files()) {
         query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
         query.bindValue(":idMovie", insertId);
         query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        execQuery(query);
     }
 
     for (const Subtitle* subtitle : movie->subtitles()) {
@@ -355,7 +660,7 @@ void Database::add(Movie* movie, DirectoryPath path)
         query.bindValue(":files", subtitle->files().join("%§%"));
         query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
         query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+        execQuery(query);
     }
 
     setLabel(movie->files(), movie->label());
@@ -364,51 +669,66 @@ void Database::add(Movie* movie, DirectoryPath path)
 }
 
 void Database::update(Movie* movie)
+{
+    updateMovie(movie->databaseId(), movie->nfoContent(), movie->files(), subtitleRecords(*movie));
+}
+
+void Database::updateMovie(int idMovie,
+    const QString& content,
+    const mediaelch::FileList& files,
+    const QVector<SubtitleRecord>& subtitles)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
+    query.bindValue(":content", compressContent(content));
+    query.bindValue(":idMovie", idMovie);
+    execQuery(query);
 
     query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
-    for (const mediaelch::FilePath& file : movie->files()) {
+    query.bindValue(":idMovie", idMovie);
+    execQuery(query);
+    for (const mediaelch::FilePath& file : files) {
         query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", movie->databaseId());
+        query.bindValue(":idMovie", idMovie);
         query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        execQuery(query);
     }
 
     query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
-    for (const Subtitle* subtitle : movie->subtitles()) {
+    query.bindValue(":idMovie", idMovie);
+    execQuery(query);
+    for (const SubtitleRecord& subtitle : subtitles) {
         query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
                       ":language, :forced)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+        query.bindValue(":idMovie", idMovie);
+        query.bindValue(":files", subtitle.files.join("%§%"));
+        query.bindValue(":language", subtitle.language.isEmpty() ? "" : subtitle.language);
+        query.bindValue(":forced", subtitle.forced ? 1 : 0);
+        execQuery(query);
     }
 }
 
+QVector<Database::SubtitleRecord> Database::subtitleRecords(const Movie& movie)
+{
+    QVector<SubtitleRecord> records;
+    for (const Subtitle* subtitle : movie.subtitles()) {
+        SubtitleRecord record;
+        record.files = subtitle->files();
+        record.language = subtitle->language();
+        record.forced = subtitle->forced();
+        records.push_back(record);
+    }
+    return records;
+}
+
 QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
 {
-    transaction();
+    // A read transaction: unlike transaction() it doesn't take the write lock.
+    db().transaction();
     QSqlQuery query(db());
-    query.prepare("SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, "
-                  "M.hasLogo, M.hasClearArt, "
-                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
-                  "FROM movies M "
-                  "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
-                  "LEFT JOIN labels L ON MF.file=L.fileName "
-                  "WHERE path=:path "
-                  "ORDER BY M.idMovie, MF.file");
+    query.prepare(s_sqlMoviesInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
 
     QMap<int, Movie*> movies;
     while (query.next()) {
@@ -427,7 +747,7 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
             movie->setDatabaseId(query.value(query.record().indexOf("idMovie")).toInt());
             movie->setFileLastModified(query.value(query.record().indexOf("lastModified")).toDateTime());
             movie->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-            movie->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+            movie->setNfoContent(uncompressContent(query.value(query.record().indexOf("content")).toByteArray()));
             movie->images().setHasImage(
                 ImageType::MoviePoster, query.value(query.record().indexOf("hasPoster")).toInt() == 1);
             movie->images().setHasImage(
@@ -455,7 +775,7 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
     }
 
     query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles");
-    query.exec();
+    execQuery(query);
     while (query.next()) {
         int movieId = query.value(query.record().indexOf("idMovie")).toInt();
         Movie* movie = movies.value(movieId, nullptr);
@@ -470,7 +790,7 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
         movie->addSubtitle(subtitle, true);
     }
 
-    commit();
+    db().commit();
 
     return movies.values().toVector();
 }
@@ -479,13 +799,13 @@ void Database::clearAllConcerts()
 {
     QSqlQuery query(db());
     query.prepare("DELETE FROM concerts");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='concerts'");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM concertFiles");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='concertFiles'");
-    query.exec();
+    execQuery(query);
 }
 
 void Database::clearConcertsInDirectory(DirectoryPath path)
@@ -493,10 +813,10 @@ void Database::clearConcertsInDirectory(DirectoryPath path)
     QSqlQuery query(db());
     query.prepare("DELETE FROM concertFiles WHERE idConcert IN (SELECT idConcert FROM concerts WHERE path=:path)");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM concerts WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
 }
 
 void Database::add(Concert* concert, DirectoryPath path)
@@ -504,37 +824,42 @@ void Database::add(Concert* concert, DirectoryPath path)
     QSqlQuery query(db());
     query.prepare("INSERT INTO concerts(content, inSeparateFolder, path) "
                   "VALUES(:content, :inSeparateFolder, :path)");
-    query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent().toUtf8());
+    query.bindValue(":content", compressContent(concert->nfoContent()));
     query.bindValue(":inSeparateFolder", (concert->inSeparateFolder() ? 1 : 0));
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     int insertId = query.lastInsertId().toInt();
 
     for (const FilePath& file : concert->files()) {
         query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
         query.bindValue(":idConcert", insertId);
         query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        execQuery(query);
     }
     concert->setDatabaseId(insertId);
 }
 
 void Database::update(Concert* concert)
+{
+    updateConcert(concert->databaseId(), concert->nfoContent(), concert->files());
+}
+
+void Database::updateConcert(int idConcert, const QString& content, const mediaelch::FileList& files)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE concerts SET content=:content WHERE idConcert=:id");
-    query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent());
-    query.bindValue(":id", concert->databaseId());
-    query.exec();
+    query.bindValue(":content", compressContent(content));
+    query.bindValue(":id", idConcert);
+    execQuery(query);
 
     query.prepare("DELETE FROM concertFiles WHERE idConcert=:idConcert");
-    query.bindValue(":idConcert", concert->databaseId());
-    query.exec();
-    for (const FilePath& file : concert->files()) {
+    query.bindValue(":idConcert", idConcert);
+    execQuery(query);
+    for (const FilePath& file : files) {
         query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", concert->databaseId());
+        query.bindValue(":idConcert", idConcert);
         query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        execQuery(query);
     }
 }
 
@@ -543,14 +868,14 @@ QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
     QVector<Concert*> concerts;
     QSqlQuery query(db());
     QSqlQuery queryFiles(db());
-    query.prepare("SELECT idConcert, content, inSeparateFolder FROM concerts WHERE path=:path");
+    query.prepare(s_sqlConcertsInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     while (query.next()) {
         QStringList files;
-        queryFiles.prepare("SELECT file FROM concertFiles WHERE idConcert=:idConcert");
+        queryFiles.prepare(s_sqlConcertFiles);
         queryFiles.bindValue(":idConcert", query.value(query.record().indexOf("idConcert")).toInt());
-        queryFiles.exec();
+        execQuery(queryFiles);
         while (queryFiles.next()) {
             files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
         }
@@ -558,7 +883,7 @@ QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
         Concert* concert = new Concert(files, Manager::instance()->concertFileSearcher());
         concert->setDatabaseId(query.value(query.record().indexOf("idConcert")).toInt());
         concert->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-        concert->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        concert->setNfoContent(uncompressContent(query.value(query.record().indexOf("content")).toByteArray()));
         concerts.append(concert);
     }
     return concerts;
@@ -570,14 +895,14 @@ void Database::add(TvShow* show, DirectoryPath path)
     query.prepare("INSERT INTO shows(dir, content, path) "
                   "VALUES(:dir, :content, :path)");
     query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.bindValue(":content", show->nfoContent().isEmpty() ? "" : show->nfoContent().toUtf8());
+    query.bindValue(":content", compressContent(show->nfoContent()));
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     show->setDatabaseId(query.lastInsertId().toInt());
 
     query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
     query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
+    execQuery(query);
     if (query.next()) {
         show->setShowMissingEpisodes(query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1);
         show->setHideSpecialsInMissingEpisodes(
@@ -588,121 +913,152 @@ void Database::add(TvShow* show, DirectoryPath path)
         query.bindValue(":dir", show->dir().toString().toUtf8());
         query.bindValue(":tvdbid", show->tvdbId().toString());
         query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.exec();
+        execQuery(query);
         show->setShowMissingEpisodes(false);
         show->setHideSpecialsInMissingEpisodes(false);
     }
 }
 
 void Database::setShowMissingEpisodes(TvShow* show, bool showMissing)
+{
+    setShowMissingEpisodes(showSettingsRecord(*show), showMissing);
+}
+
+void Database::setShowMissingEpisodes(const ShowSettingsRecord& show, bool showMissing)
 {
     QSqlQuery query(db());
 
     query.prepare("SELECT showMissingEpisodes FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
+    query.bindValue(":dir", show.dir.toUtf8());
+    execQuery(query);
     if (query.next()) {
         query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, url=:url, tvdbid=:tvdbid WHERE dir=:dir");
         query.bindValue(":show", showMissing ? 1 : 0);
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.exec();
+        query.bindValue(":dir", show.dir.toUtf8());
+        query.bindValue(":tvdbid", show.tvdbId);
+        query.bindValue(":url", show.episodeGuideUrl.isEmpty() ? "" : show.episodeGuideUrl);
+        execQuery(query);
     } else {
         query.prepare(
             "INSERT INTO showsSettings(showMissingEpisodes, dir, tvdbid, url) VALUES(:show, :dir, :tvdbid, :url)");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
+        query.bindValue(":dir", show.dir.toUtf8());
+        query.bindValue(":url", show.episodeGuideUrl.isEmpty() ? "" : show.episodeGuideUrl);
+        query.bindValue(":tvdbid", show.tvdbId);
         query.bindValue(":show", showMissing ? 1 : 0);
-        query.exec();
+        execQuery(query);
     }
 }
 
 void Database::setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials)
+{
+    setHideSpecialsInMissingEpisodes(showSettingsRecord(*show), hideSpecials);
+}
+
+void Database::setHideSpecialsInMissingEpisodes(const ShowSettingsRecord& show, bool hideSpecials)
 {
     QSqlQuery query(db());
 
     query.prepare("SELECT hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
+    query.bindValue(":dir", show.dir.toUtf8());
+    execQuery(query);
     if (query.next()) {
         query.prepare(
             "UPDATE showsSettings SET hideSpecialsInMissingEpisodes=:hide, url=:url, tvdbid=:tvdbid WHERE dir=:dir");
         query.bindValue(":show", hideSpecials ? 1 : 0);
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.exec();
+        query.bindValue(":dir", show.dir.toUtf8());
+        query.bindValue(":tvdbid", show.tvdbId);
+        query.bindValue(":url", show.episodeGuideUrl.isEmpty() ? "" : show.episodeGuideUrl);
+        execQuery(query);
     } else {
         query.prepare("INSERT INTO showsSettings(hideSpecialsInMissingEpisodes, dir, tvdbid, url) VALUES(:hide, :dir, "
                       ":tvdbid, :url)");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
+        query.bindValue(":dir", show.dir.toUtf8());
+        query.bindValue(":url", show.episodeGuideUrl.isEmpty() ? "" : show.episodeGuideUrl);
+        query.bindValue(":tvdbid", show.tvdbId);
         query.bindValue(":hide", hideSpecials ? 1 : 0);
-        query.exec();
+        execQuery(query);
     }
 }
 
+Database::ShowSettingsRecord Database::showSettingsRecord(const TvShow& show)
+{
+    ShowSettingsRecord record;
+    record.dir = show.dir().toString();
+    record.tvdbId = show.tvdbId().toString();
+    record.episodeGuideUrl = show.episodeGuideUrl();
+    record.showMissingEpisodes = show.showMissingEpisodes();
+    record.hideSpecialsInMissingEpisodes = show.hideSpecialsInMissingEpisodes();
+    return record;
+}
+
 void Database::add(TvShowEpisode* episode, DirectoryPath path, int idShow)
 {
     QSqlQuery query(db());
     query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
                   "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
+    query.bindValue(":content", compressContent(episode->nfoContent()));
     query.bindValue(":idShow", idShow);
     query.bindValue(":path", path.toString().toUtf8());
     query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
     query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-    query.exec();
+    execQuery(query);
     int insertId = query.lastInsertId().toInt();
     for (const FilePath& file : episode->files()) {
         query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
         query.bindValue(":idEpisode", insertId);
         query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        execQuery(query);
     }
     episode->setDatabaseId(insertId);
 }
 
 void Database::update(TvShow* show)
+{
+    updateShow(show->databaseId(), show->nfoContent(), showSettingsRecord(*show));
+}
+
+void Database::updateShow(int idShow, const QString& content, const ShowSettingsRecord& settings)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE shows SET content=:content, dir=:dir WHERE idShow=:id");
-    query.bindValue(":content", show->nfoContent().isEmpty() ? "" : show->nfoContent());
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.bindValue(":id", show->databaseId());
-    query.exec();
+    query.bindValue(":content", compressContent(content));
+    query.bindValue(":dir", settings.dir.toUtf8());
+    query.bindValue(":id", idShow);
+    execQuery(query);
 
-    int id = showsSettingsId(show);
+    int id = showsSettingsId(settings.dir);
     query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, hideSpecialsInMissingEpisodes=:hide, url=:url, "
                   "tvdbid=:tvdbid WHERE idShow=:idShow");
-    query.bindValue(":show", show->showMissingEpisodes());
-    query.bindValue(":hide", show->hideSpecialsInMissingEpisodes());
+    query.bindValue(":show", settings.showMissingEpisodes);
+    query.bindValue(":hide", settings.hideSpecialsInMissingEpisodes);
     query.bindValue(":idShow", id);
-    query.bindValue(":tvdbid", show->tvdbId().toString());
-    query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-    query.exec();
+    query.bindValue(":tvdbid", settings.tvdbId);
+    query.bindValue(":url", settings.episodeGuideUrl.isEmpty() ? "" : settings.episodeGuideUrl);
+    execQuery(query);
 }
 
 void Database::update(TvShowEpisode* episode)
+{
+    updateEpisode(episode->databaseId(), episode->nfoContent(), episode->files());
+}
+
+void Database::updateEpisode(int idEpisode, const QString& content, const mediaelch::FileList& files)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE episodes SET content=:content WHERE idEpisode=:id");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent());
-    query.bindValue(":id", episode->databaseId());
-    query.exec();
+    query.bindValue(":content", compressContent(content));
+    query.bindValue(":id", idEpisode);
+    execQuery(query);
 
     query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
-    query.bindValue(":idEpisode", episode->databaseId());
-    query.exec();
+    query.bindValue(":idEpisode", idEpisode);
+    execQuery(query);
 
-    for (const FilePath& file : episode->files()) {
+    for (const FilePath& file : files) {
         query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", episode->databaseId());
+        query.bindValue(":idEpisode", idEpisode);
         query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        execQuery(query);
     }
 }
 
@@ -711,7 +1067,7 @@ int Database::showCount(DirectoryPath path)
     QSqlQuery query(db());
     query.prepare("SELECT COUNT(*) FROM shows WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     if (!query.next()) {
         return 0;
     }
@@ -724,21 +1080,21 @@ QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
 {
     QVector<TvShow*> shows;
     QSqlQuery query(db());
-    query.prepare("SELECT idShow, dir, content, path FROM shows WHERE path=:path");
+    query.prepare(s_sqlShowsInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     while (query.next()) {
         TvShow* show = new TvShow(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()),
             Manager::instance()->tvShowFileSearcher());
         show->setDatabaseId(query.value(query.record().indexOf("idShow")).toInt());
-        show->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        show->setNfoContent(uncompressContent(query.value(query.record().indexOf("content")).toByteArray()));
         shows.append(show);
     }
 
     for (TvShow* show : shows) {
         query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
         query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.exec();
+        execQuery(query);
         if (query.next()) {
             show->setShowMissingEpisodes(
                 query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1, false);
@@ -750,28 +1106,28 @@ QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
     return shows;
 }
 
-QVector<TvShowEpisode*> Database::episodes(int idShow)
+QVector<TvShowEpisode*> Database::episodes(TvShow* show)
 {
     QVector<TvShowEpisode*> episodes;
     QSqlQuery query(db());
     QSqlQuery queryFiles(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
-    query.bindValue(":idShow", idShow);
-    query.exec();
+    query.prepare(s_sqlEpisodesOfShow);
+    query.bindValue(":idShow", show->databaseId());
+    execQuery(query);
     while (query.next()) {
         QStringList files;
-        queryFiles.prepare("SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode");
+        queryFiles.prepare(s_sqlEpisodeFiles);
         queryFiles.bindValue(":idEpisode", query.value(query.record().indexOf("idEpisode")).toInt());
-        queryFiles.exec();
+        execQuery(queryFiles);
         while (queryFiles.next()) {
             files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
         }
 
-        TvShowEpisode* episode = new TvShowEpisode(files);
+        TvShowEpisode* episode = new TvShowEpisode(files, show);
         episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
         episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
         episode->setDatabaseId(query.value(query.record().indexOf("idEpisode")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        episode->setNfoContent(uncompressContent(query.value(query.record().indexOf("content")).toByteArray()));
         episodes.append(episode);
     }
     return episodes;
@@ -781,17 +1137,17 @@ void Database::clearAllTvShows()
 {
     QSqlQuery query(db());
     query.prepare("DELETE FROM shows");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM episodes");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM episodeFiles");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='shows'");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='episodes'");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='episodeFiles'");
-    query.exec();
+    execQuery(query);
 }
 
 void Database::clearTvShowsInDirectory(DirectoryPath path)
@@ -799,21 +1155,21 @@ void Database::clearTvShowsInDirectory(DirectoryPath path)
     QSqlQuery query(db());
     query.prepare("DELETE FROM shows WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM episodeFiles WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE path=:path)");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    query.prepare("DELETE FROM episodes WHERE path=:path");
+    execQuery(query);
+    query.prepare(s_sqlDeleteEpisodesInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
 }
 
 void Database::clearTvShowInDirectory(DirectoryPath path)
 {
     QSqlQuery query(db());
-    query.prepare("SELECT idShow FROM shows WHERE dir=:dir");
+    query.prepare(s_sqlShowId);
     query.bindValue(":dir", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     if (!query.next()) {
         return;
     }
@@ -821,42 +1177,47 @@ void Database::clearTvShowInDirectory(DirectoryPath path)
 
     query.prepare("DELETE FROM episodeFiles WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE idShow=:idShow)");
     query.bindValue(":idShow", idShow);
-    query.exec();
+    execQuery(query);
 
     query.prepare("DELETE FROM shows WHERE idShow=:idShow");
     query.bindValue(":idShow", idShow);
-    query.exec();
+    execQuery(query);
 
     query.prepare("DELETE FROM episodes WHERE idShow=:idShow");
     query.bindValue(":idShow", idShow);
-    query.exec();
+    execQuery(query);
 }
 
 int Database::episodeCount()
 {
     QSqlQuery query(db());
     query.prepare("SELECT COUNT(*) FROM episodes");
-    query.exec();
+    execQuery(query);
     query.next();
     return query.value(0).toInt();
 }
 
 int Database::showsSettingsId(TvShow* show)
+{
+    return showsSettingsId(show->dir());
+}
+
+int Database::showsSettingsId(const DirectoryPath& showDir)
 {
     QSqlQuery query(db());
-    query.prepare("SELECT idShow FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
+    query.prepare(s_sqlShowSettingsId);
+    query.bindValue(":dir", showDir.toString().toUtf8());
+    execQuery(query);
     if (query.next()) {
         return query.value(0).toInt();
     }
 
     query.prepare("INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir) VALUES(:show, "
                   ":hide, :dir)");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
+    query.bindValue(":dir", showDir.toString().toUtf8());
     query.bindValue(":show", 0);
     query.bindValue(":hide", 0);
-    query.exec();
+    execQuery(query);
     return query.lastInsertId().toInt();
 }
 
@@ -865,60 +1226,93 @@ void Database::clearEpisodeList(int showsSettingsId)
     QSqlQuery query(db());
     query.prepare("UPDATE showsEpisodes SET updated=0 WHERE idShow=:idShow");
     query.bindValue(":idShow", showsSettingsId);
-    query.exec();
+    execQuery(query);
 }
 
-void Database::addEpisodeToShowList(TvShowEpisode* episode, int showsSettingsId, TvDbId tvdbid)
+void Database::addEpisodesToShowList(const QVector<ShowsEpisodeRecord>& episodes, int showsSettingsId)
 {
-    kodi::EpisodeXmlWriterV18 xmlWriter({episode});
-    const QByteArray xmlContent = xmlWriter.getEpisodeXml();
+    // Queries are prepared once for all episodes.
+    QSqlQuery selectQuery(db());
+    selectQuery.prepare(s_sqlShowsEpisodeId);
+    QSqlQuery updateQuery(db());
+    updateQuery.prepare("UPDATE showsEpisodes SET seasonNumber=:seasonNumber, episodeNumber=:episodeNumber, updated=1, "
+                        "content=:content WHERE idEpisode=:idEpisode");
+    QSqlQuery insertQuery(db());
+    insertQuery.prepare("INSERT INTO showsEpisodes(content, idShow, seasonNumber, episodeNumber, tvdbid, updated) "
+                        "VALUES(:content, :idShow, :seasonNumber, :episodeNumber, :tvdbid, 1)");
+
+    for (const ShowsEpisodeRecord& episode : episodes) {
+        selectQuery.bindValue(":tvdbid", episode.tvdbId);
+        execQuery(selectQuery);
+        if (selectQuery.next()) {
+            const int idEpisode = selectQuery.value(0).toInt();
+            selectQuery.finish();
+            updateQuery.bindValue(":content", compressContent(episode.content));
+            updateQuery.bindValue(":idEpisode", idEpisode);
+            updateQuery.bindValue(":seasonNumber", episode.season.toInt());
+            updateQuery.bindValue(":episodeNumber", episode.episode.toInt());
+            execQuery(updateQuery);
+        } else {
+            selectQuery.finish();
+            insertQuery.bindValue(":content", compressContent(episode.content));
+            insertQuery.bindValue(":idShow", showsSettingsId);
+            insertQuery.bindValue(":seasonNumber", episode.season.toInt());
+            insertQuery.bindValue(":episodeNumber", episode.episode.toInt());
+            insertQuery.bindValue(":tvdbid", episode.tvdbId);
+            execQuery(insertQuery);
+        }
+    }
+}
 
-    QSqlQuery query(db());
-    query.prepare("SELECT idEpisode FROM showsEpisodes WHERE tvdbid=:tvdbid");
-    query.bindValue(":tvdbid", tvdbid.toString());
-    query.exec();
-    if (query.next()) {
-        const int idEpisode = query.value(0).toInt();
-        query.prepare("UPDATE showsEpisodes SET seasonNumber=:seasonNumber, episodeNumber=:episodeNumber, updated=1, "
-                      "content=:content WHERE idEpisode=:idEpisode");
-        query.bindValue(":content", xmlContent.isEmpty() ? "" : xmlContent);
-        query.bindValue(":idEpisode", idEpisode);
-        query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-        query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-        query.exec();
-    } else {
-        query.prepare("INSERT INTO showsEpisodes(content, idShow, seasonNumber, episodeNumber, tvdbid, updated) "
-                      "VALUES(:content, :idShow, :seasonNumber, :episodeNumber, :tvdbid, 1)");
-        query.bindValue(":content", xmlContent.isEmpty() ? "" : xmlContent);
-        query.bindValue(":idShow", showsSettingsId);
-        query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-        query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-        query.bindValue(":tvdbid", tvdbid.toString());
-        query.exec();
+QVector<Database::ShowsEpisodeRecord> Database::showsEpisodeRecords(const QVector<TvShowEpisode*>& episodes)
+{
+    QVector<ShowsEpisodeRecord> records;
+    records.reserve(episodes.size());
+    for (TvShowEpisode* episode : episodes) {
+        kodi::EpisodeXmlWriterV18 xmlWriter({episode});
+        ShowsEpisodeRecord record;
+        record.season = episode->seasonNumber();
+        record.episode = episode->episodeNumber();
+        record.content = QString::fromUtf8(xmlWriter.getEpisodeXml());
+        record.tvdbId = episode->tvdbId().toString();
+        records.push_back(record);
     }
+    return records;
 }
 
 void Database::cleanUpEpisodeList(int showsSettingsId)
 {
     QSqlQuery query(db());
-    query.prepare("DELETE FROM showsEpisodes WHERE idShow=:idShow AND updated=0");
+    query.prepare(s_sqlDeleteOutdatedShowsEpisodes);
     query.bindValue(":idShow", showsSettingsId);
-    query.exec();
+    execQuery(query);
 }
 
 QVector<TvShowEpisode*> Database::showsEpisodes(TvShow* show)
 {
-    int id = showsSettingsId(show);
     QVector<TvShowEpisode*> episodes;
+    for (const ShowsEpisodeRecord& record : showsEpisodes(show->dir())) {
+        TvShowEpisode* episode = new TvShowEpisode(QStringList(), show);
+        episode->setSeason(record.season);
+        episode->setEpisode(record.episode);
+        episode->setNfoContent(record.content);
+        episodes.append(episode);
+    }
+    return episodes;
+}
+
+QVector<Database::ShowsEpisodeRecord> Database::showsEpisodes(const DirectoryPath& showDir)
+{
+    QVector<ShowsEpisodeRecord> episodes;
     QSqlQuery query(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM showsEpisodes WHERE idShow=:idShow");
-    query.bindValue(":idShow", id);
-    query.exec();
+    query.prepare(s_sqlShowsEpisodes);
+    query.bindValue(":dir", showDir.toString().toUtf8());
+    execQuery(query);
     while (query.next()) {
-        TvShowEpisode* episode = new TvShowEpisode(QStringList(), show);
-        episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
-        episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        ShowsEpisodeRecord episode;
+        episode.season = SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt());
+        episode.episode = EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt());
+        episode.content = uncompressContent(query.value(query.record().indexOf("content")).toByteArray());
         episodes.append(episode);
     }
     return episodes;
@@ -929,7 +1323,7 @@ void Database::addImport(QString fileName, QString type, DirectoryPath path)
     int id = 1;
     QSqlQuery query(db());
     query.prepare("SELECT MAX(id) FROM importCache");
-    query.exec();
+    execQuery(query);
     if (query.next()) {
         id = query.value(0).toInt() + 1;
     }
@@ -939,7 +1333,7 @@ void Database::addImport(QString fileName, QString type, DirectoryPath path)
     query.bindValue(":filename", fileName);
     query.bindValue(":type", type);
     query.bindValue(":path", path.toString());
-    query.exec();
+    execQuery(query);
 }
 
 bool Database::guessImport(QString fileName, QString& type, QString& path)
@@ -948,7 +1342,7 @@ bool Database::guessImport(QString fileName, QString& type, QString& path)
 
     QSqlQuery query(db());
     query.prepare("SELECT filename, type, path FROM importCache");
-    query.exec();
+    execQuery(query);
     while (query.next()) {
         qreal p = helper::similarity(fileName, query.value(query.record().indexOf("filename")).toString());
         if (p > 0.7 && p > bestMatch) {
@@ -961,13 +1355,86 @@ bool Database::guessImport(QString fileName, QString& type, QString& path)
     return (bestMatch != 0);
 }
 
+/// Returns the renamed path or an empty string if \p path is not affected by renaming \p from.
+static QString renamedPath(const QString& path, const QString& from, const QString& to)
+{
+    if (path == from) {
+        return to;
+    }
+    if (path.startsWith(from + '/')) {
+        return to + path.mid(from.length());
+    }
+    return QString();
+}
+
+void Database::renamePath(const QString& path, const QString& newPath)
+{
+    struct PathColumn
+    {
+        const char* table;
+        const char* id;
+        const char* column;
+    };
+    // Paths are stored as UTF-8; they are compared in C++ because SQLite's string functions don't
+    // match paths on directory boundaries.  This is only done to recover from interrupted renames.
+    const PathColumn columns[] = {{"movieFiles", "idFile", "file"},
+        {"concertFiles", "idFile", "file"},
+        {"episodeFiles", "idFile", "file"},
+        {"shows", "idShow", "dir"},
+        {"showsSettings", "idShow", "dir"}};
+
+    for (const PathColumn& column : columns) {
+        QVector<QPair<QVariant, QString>> renamed;
+        QSqlQuery query(db());
+        query.exec(QStringLiteral("SELECT %1, %2 FROM %3").arg(column.id, column.column, column.table));
+        while (query.next()) {
+            const QString newValue = renamedPath(QString::fromUtf8(query.value(1).toByteArray()), path, newPath);
+            if (!newValue.isEmpty()) {
+                renamed << qMakePair(query.value(0), newValue);
+            }
+        }
+        query.prepare(
+            QStringLiteral("UPDATE %1 SET %2=:value WHERE %3=:id").arg(column.table, column.column, column.id));
+        for (const auto& row : renamed) {
+            query.bindValue(":value", row.second.toUtf8());
+            query.bindValue(":id", row.first);
+            execQuery(query);
+        }
+    }
+
+    // Subtitle files are joined, see update(Movie*).
+    QVector<QPair<QVariant, QString>> renamedSubtitles;
+    QSqlQuery query(db());
+    query.exec("SELECT idSubtitle, files FROM movieSubtitles");
+    while (query.next()) {
+        QStringList files = query.value(1).toString().split("%§%");
+        bool changed = false;
+        for (QString& file : files) {
+            const QString newFile = renamedPath(file, path, newPath);
+            if (!newFile.isEmpty()) {
+                file = newFile;
+                changed = true;
+            }
+        }
+        if (changed) {
+            renamedSubtitles << qMakePair(query.value(0), files.join("%§%"));
+        }
+    }
+    query.prepare("UPDATE movieSubtitles SET files=:files WHERE idSubtitle=:id");
+    for (const auto& row : renamedSubtitles) {
+        query.bindValue(":files", row.second);
+        query.bindValue(":id", row.first);
+        execQuery(query);
+    }
+}
+
 void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLabel)
 {
     int color = static_cast<int>(colorLabel);
     QSqlQuery query(db());
     int id = 1;
     query.prepare("SELECT MAX(idLabel) FROM labels");
-    query.exec();
+    execQuery(query);
     if (query.next()) {
         id = query.value(0).toInt() + 1;
     }
@@ -975,19 +1442,19 @@ void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLa
     for (const mediaelch::FilePath& fileName : fileNames) {
         query.prepare("SELECT idLabel FROM labels WHERE fileName=:fileName");
         query.bindValue(":fileName", fileName.toString().toUtf8());
-        query.exec();
+        execQuery(query);
         if (query.next()) {
             int idLabel = query.value(query.record().indexOf("idLabel")).toInt();
             query.prepare("UPDATE labels SET color=:color WHERE idLabel=:idLabel");
             query.bindValue(":idLabel", idLabel);
             query.bindValue(":color", color);
-            query.exec();
+            execQuery(query);
         } else {
             query.prepare("INSERT INTO labels(idLabel, color, fileName) VALUES(:idLabel, :color, :fileName)");
             query.bindValue(":idLabel", id);
             query.bindValue(":color", color);
             query.bindValue(":fileName", fileName.toString().toUtf8());
-            query.exec();
+            execQuery(query);
         }
     }
 }
@@ -999,9 +1466,9 @@ ColorLabel Database::getLabel(const mediaelch::FileList& fileNames)
     }
 
     QSqlQuery query(db());
-    query.prepare("SELECT color FROM labels WHERE fileName=:fileName");
+    query.prepare(s_sqlLabel);
     query.bindValue(":fileName", fileNames.first().toString().toUtf8());
-    query.exec();
+    execQuery(query);
     if (query.next()) {
         return static_cast<ColorLabel>(query.value(query.record().indexOf("color")).toInt());
     }
@@ -1009,13 +1476,80 @@ ColorLabel Database::getLabel(const mediaelch::FileList& fileNames)
     return ColorLabel::NoLabel;
 }
 
+bool Database::fileHash(const mediaelch::FilePath& file, QByteArray& hash, qint64& size, qint64& lastModified)
+{
+    QSqlQuery query(db());
+    query.prepare(s_sqlFileHash);
+    query.bindValue(":fileName", file.toString().toUtf8());
+    execQuery(query);
+    if (!query.next()) {
+        return false;
+    }
+    hash = query.value(query.record().indexOf("hash")).toByteArray();
+    size = query.value(query.record().indexOf("size")).toLongLong();
+    lastModified = query.value(query.record().indexOf("lastModified")).toLongLong();
+    return true;
+}
+
+QHash<QString, Database::FileHashRecord> Database::fileHashes()
+{
+    QHash<QString, FileHashRecord> hashes;
+    QSqlQuery query(db());
+    query.prepare("SELECT fileName, hash, size, lastModified FROM fileHashes");
+    execQuery(query);
+    while (query.next()) {
+        FileHashRecord record;
+        record.hash = query.value(1).toByteArray();
+        record.size = query.value(2).toLongLong();
+        record.lastModified = query.value(3).toLongLong();
+        hashes.insert(QString::fromUtf8(query.value(0).toByteArray()), record);
+    }
+    return hashes;
+}
+
+void Database::setFileHash(const mediaelch::FilePath& file, const QByteArray& hash, qint64 size, qint64 lastModified)
+{
+    QSqlQuery query(db());
+    query.prepare("INSERT OR REPLACE INTO fileHashes(fileName, hash, size, lastModified) "
+                  "VALUES(:fileName, :hash, :size, :lastModified)");
+    query.bindValue(":fileName", file.toString().toUtf8());
+    query.bindValue(":hash", QString::fromLatin1(hash));
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    execQuery(query);
+}
+
+QHash<QString, QString> Database::imdbActorImageUrls(qint64 updatedAfter)
+{
+    QHash<QString, QString> imageUrls;
+    QSqlQuery query(db());
+    query.prepare("SELECT profileUrl, imageUrl FROM imdbActorImages WHERE updated>:updated");
+    query.bindValue(":updated", updatedAfter);
+    execQuery(query);
+    while (query.next()) {
+        imageUrls.insert(query.value(0).toString(), query.value(1).toString());
+    }
+    return imageUrls;
+}
+
+void Database::setImdbActorImageUrl(const QString& profileUrl, const QString& imageUrl, qint64 updated)
+{
+    QSqlQuery query(db());
+    query.prepare("INSERT OR REPLACE INTO imdbActorImages(profileUrl, imageUrl, updated) "
+                  "VALUES(:profileUrl, :imageUrl, :updated)");
+    query.bindValue(":profileUrl", profileUrl);
+    query.bindValue(":imageUrl", imageUrl);
+    query.bindValue(":updated", updated);
+    execQuery(query);
+}
+
 void Database::clearAllArtists()
 {
     QSqlQuery query(db());
     query.prepare("DELETE FROM artists");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='artists'");
-    query.exec();
+    execQuery(query);
     clearAllAlbums();
 }
 
@@ -1024,7 +1558,7 @@ void Database::clearArtistsInDirectory(DirectoryPath path)
     QSqlQuery query(db());
     query.prepare("DELETE FROM artists WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     clearAlbumsInDirectory(path);
 }
 
@@ -1033,34 +1567,39 @@ void Database::add(Artist* artist, DirectoryPath path)
     QSqlQuery query(db());
     query.prepare("INSERT INTO artists(content, dir, path) "
                   "VALUES(:content, :dir, :path)");
-    query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent().toUtf8());
+    query.bindValue(":content", compressContent(artist->nfoContent()));
     query.bindValue(":dir", artist->path().toString().toUtf8());
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     artist->setDatabaseId(query.lastInsertId().toInt());
 }
 
 void Database::update(Artist* artist)
+{
+    updateArtist(artist->databaseId(), artist->nfoContent());
+}
+
+void Database::updateArtist(int idArtist, const QString& content)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE artists SET content=:content WHERE idArtist=:id");
-    query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent());
-    query.bindValue(":id", artist->databaseId());
-    query.exec();
+    query.bindValue(":content", compressContent(content));
+    query.bindValue(":id", idArtist);
+    execQuery(query);
 }
 
 QVector<Artist*> Database::artistsInDirectory(DirectoryPath path)
 {
     QVector<Artist*> artists;
     QSqlQuery query(db());
-    query.prepare("SELECT idArtist, content, dir FROM artists WHERE path=:path");
+    query.prepare(s_sqlArtistsInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     while (query.next()) {
         Artist* artist = new Artist(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()),
             Manager::instance()->musicFileSearcher());
         artist->setDatabaseId(query.value(query.record().indexOf("idArtist")).toInt());
-        artist->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        artist->setNfoContent(uncompressContent(query.value(query.record().indexOf("content")).toByteArray()));
         artists.append(artist);
     }
     return artists;
@@ -1070,17 +1609,17 @@ void Database::clearAllAlbums()
 {
     QSqlQuery query(db());
     query.prepare("DELETE FROM albums");
-    query.exec();
+    execQuery(query);
     query.prepare("DELETE FROM sqlite_sequence WHERE name='albums'");
-    query.exec();
+    execQuery(query);
 }
 
 void Database::clearAlbumsInDirectory(DirectoryPath path)
 {
     QSqlQuery query(db());
-    query.prepare("DELETE FROM albums WHERE path=:path");
+    query.prepare(s_sqlDeleteAlbumsInDirectory);
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
 }
 
 void Database::add(Album* album, DirectoryPath path)
@@ -1089,34 +1628,39 @@ void Database::add(Album* album, DirectoryPath path)
     query.prepare("INSERT INTO albums(idArtist, content, dir, path) "
                   "VALUES(:idArtist, :content, :dir, :path)");
     query.bindValue(":idArtist", album->artistObj()->databaseId());
-    query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent().toUtf8());
+    query.bindValue(":content", compressContent(album->nfoContent()));
     query.bindValue(":dir", album->path().toString().toUtf8());
     query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    execQuery(query);
     album->setDatabaseId(query.lastInsertId().toInt());
 }
 
 void Database::update(Album* album)
+{
+    updateAlbum(album->databaseId(), album->nfoContent());
+}
+
+void Database::updateAlbum(int idAlbum, const QString& content)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE albums SET content=:content WHERE idAlbum=:id");
-    query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent());
-    query.bindValue(":id", album->databaseId());
-    query.exec();
+    query.bindValue(":content", compressContent(content));
+    query.bindValue(":id", idAlbum);
+    execQuery(query);
 }
 
 QVector<Album*> Database::albums(Artist* artist)
 {
     QVector<Album*> albums;
     QSqlQuery query(db());
-    query.prepare("SELECT idAlbum, content, dir FROM albums WHERE idArtist=:idArtist");
+    query.prepare(s_sqlAlbumsOfArtist);
     query.bindValue(":idArtist", artist->databaseId());
-    query.exec();
+    execQuery(query);
     while (query.next()) {
         Album* album = new Album(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()),
             Manager::instance()->musicFileSearcher());
         album->setDatabaseId(query.value(query.record().indexOf("idAlbum")).toInt());
-        album->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        album->setNfoContent(uncompressContent(query.value(query.record().indexOf("content")).toByteArray()));
         album->setArtistObj(artist);
         artist->addAlbum(album);
         albums.append(album);
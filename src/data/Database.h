@@ -2,14 +2,19 @@
 
 #include "file/Path.h"
 #include "globals/Globals.h"
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
 #include "tv_shows/TvDbId.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
+#include <functional>
+
 class Album;
 class Artist;
 class Concert;
@@ -21,62 +26,158 @@ class Database : public QObject
 {
     Q_OBJECT
 public:
+    /// Values of a subtitle as stored by update(Movie*).
+    struct SubtitleRecord
+    {
+        QStringList files;
+        QString language;
+        bool forced = false;
+    };
+
+    /// Values of a TV show that identify its entry in "showsSettings".
+    struct ShowSettingsRecord
+    {
+        /// A plain string: records are passed to the writer thread of DatabaseService.
+        QString dir;
+        QString tvdbId;
+        QString episodeGuideUrl;
+        bool showMissingEpisodes = false;
+        bool hideSpecialsInMissingEpisodes = false;
+    };
+
+    /// Episode of the episode list of a TV show, see showsEpisodes().
+    struct ShowsEpisodeRecord
+    {
+        SeasonNumber season;
+        EpisodeNumber episode;
+        QString content;
+        /// Only set by showsEpisodeRecords().
+        QString tvdbId;
+    };
+
+    /// Content hash of a file written by MediaElch, see mediaelch::ContentHashCache.
+    struct FileHashRecord
+    {
+        QByteArray hash;
+        qint64 size = -1;
+        qint64 lastModified = -1;
+    };
+
+    /// \brief Opens MediaElch.sqlite in the database directory of the settings.
     explicit Database(QObject* parent = nullptr);
+    /// \brief Opens or creates the given database file and migrates it to the current schema.
+    explicit Database(const mediaelch::FilePath& databaseFile, QObject* parent = nullptr);
     ~Database() override;
     QSqlDatabase db();
-    void transaction();
-    void commit();
+    /// Starts a transaction that holds the write lock. Returns false if another connection kept it too long.
+    bool transaction();
+    /// Commits the transaction started by transaction(). Rolls it back and returns false if that fails.
+    bool commit();
+    /// Runs the given writes in one transaction(). Keep slow work like reading NFO files out of it.
+    bool writeInTransaction(const std::function<void()>& writes);
     void clearAllMovies();
     void clearMoviesInDirectory(mediaelch::DirectoryPath path);
     void add(Movie* movie, mediaelch::DirectoryPath path);
     void update(Movie* movie);
+    void updateMovie(int idMovie,
+        const QString& content,
+        const mediaelch::FileList& files,
+        const QVector<SubtitleRecord>& subtitles);
     QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path);
 
     void clearAllConcerts();
     void clearConcertsInDirectory(mediaelch::DirectoryPath path);
     void add(Concert* concert, mediaelch::DirectoryPath path);
     void update(Concert* concert);
+    void updateConcert(int idConcert, const QString& content, const mediaelch::FileList& files);
     QVector<Concert*> concertsInDirectory(mediaelch::DirectoryPath path);
 
     void add(TvShow* show, mediaelch::DirectoryPath path);
     void add(TvShowEpisode* episode, mediaelch::DirectoryPath path, int idShow);
     void update(TvShow* show);
+    void updateShow(int idShow, const QString& content, const ShowSettingsRecord& settings);
     void update(TvShowEpisode* episode);
+    void updateEpisode(int idEpisode, const QString& content, const mediaelch::FileList& files);
     void clearAllTvShows();
     void clearTvShowsInDirectory(mediaelch::DirectoryPath path);
     void clearTvShowInDirectory(mediaelch::DirectoryPath path);
     int showCount(mediaelch::DirectoryPath path);
     QVector<TvShow*> showsInDirectory(mediaelch::DirectoryPath path);
-    QVector<TvShowEpisode*> episodes(int idShow);
+    /// Episodes of the show. They are created as children of the show, so that they are moved to
+    /// another thread together with it, see mediaelch::LibraryReloader.
+    QVector<TvShowEpisode*> episodes(TvShow* show);
     int episodeCount();
 
     void setShowMissingEpisodes(TvShow* show, bool showMissing);
+    void setShowMissingEpisodes(const ShowSettingsRecord& show, bool showMissing);
     void setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials);
+    void setHideSpecialsInMissingEpisodes(const ShowSettingsRecord& show, bool hideSpecials);
     int showsSettingsId(TvShow* show);
+    int showsSettingsId(const mediaelch::DirectoryPath& showDir);
     void clearEpisodeList(int showsSettingsId);
     void cleanUpEpisodeList(int showsSettingsId);
-    void addEpisodeToShowList(TvShowEpisode* episode, int showsSettingsId, TvDbId tvdbid);
+    /// Adds or updates the given episodes. Call it inside a transaction for large lists.
+    void addEpisodesToShowList(const QVector<ShowsEpisodeRecord>& episodes, int showsSettingsId);
     QVector<TvShowEpisode*> showsEpisodes(TvShow* show);
+    /// Episode list of the show in the given directory. Only reads from the database.
+    QVector<ShowsEpisodeRecord> showsEpisodes(const mediaelch::DirectoryPath& showDir);
 
     void clearAllArtists();
     void clearArtistsInDirectory(mediaelch::DirectoryPath path);
     void add(Artist* artist, mediaelch::DirectoryPath path);
     void update(Artist* artist);
+    void updateArtist(int idArtist, const QString& content);
     QVector<Artist*> artistsInDirectory(mediaelch::DirectoryPath path);
 
     void clearAllAlbums();
     void clearAlbumsInDirectory(mediaelch::DirectoryPath path);
     void add(Album* album, mediaelch::DirectoryPath path);
     void update(Album* album);
+    void updateAlbum(int idAlbum, const QString& content);
     QVector<Album*> albums(Artist* artist);
 
     void addImport(QString fileName, QString type, mediaelch::DirectoryPath path);
     bool guessImport(QString fileName, QString& type, QString& path);
 
+    /// \brief Replaces \p path and all paths inside of it by \p newPath in the files of movies,
+    /// concerts and episodes and in the directories of TV shows, e.g. to revert a rename.
+    void renamePath(const QString& path, const QString& newPath);
+
     void setLabel(const mediaelch::FileList& fileNames, ColorLabel color);
     ColorLabel getLabel(const mediaelch::FileList& fileNames);
 
+    /// Content hash of a file written by MediaElch, see mediaelch::ContentHashCache.
+    /// Size and lastModified (msecs since epoch) describe the file after it was written.
+    bool fileHash(const mediaelch::FilePath& file, QByteArray& hash, qint64& size, qint64& lastModified);
+    /// \brief All stored file hashes by file name.
+    QHash<QString, FileHashRecord> fileHashes();
+    void setFileHash(const mediaelch::FilePath& file, const QByteArray& hash, qint64 size, qint64 lastModified);
+
+    /// Image URLs of IMDb actor profiles, see mediaelch::imdb::ActorImageCache.
+    /// Only entries that were updated after \p updatedAfter (msecs since epoch) are returned.
+    QHash<QString, QString> imdbActorImageUrls(qint64 updatedAfter);
+    void setImdbActorImageUrl(const QString& profileUrl, const QString& imageUrl, qint64 updated);
+
+    /// \brief Encodes NFO content for the "content" columns.
+    /// Content is stored zlib-compressed (see qCompress()) if that makes it smaller.
+    static QByteArray compressContent(const QString& content);
+    static QByteArray compressContent(const QByteArray& utf8Content);
+    /// \brief Decodes a "content" column. Uncompressed content of older versions is returned as is.
+    static QString uncompressContent(const QByteArray& data);
+
+    /// \brief Lookups that run for each item or directory of a library (re)load.
+    /// Each of them must use an index; the tests check their query plans.
+    static QStringList indexedStatements();
+
+    static QVector<SubtitleRecord> subtitleRecords(const Movie& movie);
+    static ShowSettingsRecord showSettingsRecord(const TvShow& show);
+    /// \brief Episodes as stored by addEpisodesToShowList(). Their XML is created on the calling thread.
+    static QVector<ShowsEpisodeRecord> showsEpisodeRecords(const QVector<TvShowEpisode*>& episodes);
+
 private:
     QSqlDatabase* m_db;
+    /// Identifies the connections of this instance in worker threads, see db().
+    const int m_instanceId;
     void updateDbVersion(int version);
+    void compressStoredContent();
 };
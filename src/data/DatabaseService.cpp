@@ -0,0 +1,202 @@
+#include "data/DatabaseService.h"
+
+#include "concerts/Concert.h"
+#include "movies/Movie.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+namespace mediaelch {
+
+DatabaseService::DatabaseService(Database* database, QObject* parent) : QObject(parent), m_database{database}
+{
+    // The writer keeps its thread (and therefore its connection) for its whole lifetime.
+    m_writer.setMaxThreadCount(1);
+    m_writer.setExpiryTimeout(-1);
+    m_readers.setMaxThreadCount(s_maxReaders);
+    QtConcurrent::run(&m_writer, this, &DatabaseService::writeLoop);
+}
+
+DatabaseService::~DatabaseService()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopped = true;
+        m_writesQueued.wakeAll();
+    }
+    m_writer.waitForDone();
+    m_readers.waitForDone();
+}
+
+void DatabaseService::write(Job job)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_stopped) {
+        qWarning() << "[DatabaseService] Write queued after shutdown; it is ignored";
+        return;
+    }
+    m_queue.push_back(std::move(job));
+    ++m_enqueued;
+    // The writer is either idle (first job) or coalescing; only wake it if it has something new to do.
+    if (m_queue.size() == 1 || m_queue.size() >= s_maxBatchSize) {
+        m_writesQueued.wakeAll();
+    }
+}
+
+void DatabaseService::flush()
+{
+    waitForWrites(enqueuedWrites());
+}
+
+qint64 DatabaseService::enqueuedWrites()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_enqueued;
+}
+
+void DatabaseService::waitForWrites(qint64 sequence)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_committed >= sequence) {
+        return;
+    }
+    m_flushRequested = true;
+    m_writesQueued.wakeAll();
+    while (m_committed < sequence) {
+        m_writesCommitted.wait(&m_mutex);
+    }
+}
+
+void DatabaseService::writeLoop()
+{
+    QMutexLocker locker(&m_mutex);
+    forever {
+        while (m_queue.isEmpty() && !m_stopped) {
+            m_writesQueued.wait(&m_mutex);
+        }
+        if (m_queue.isEmpty()) {
+            break; // stopped and all writes are committed
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        while (!m_stopped && !m_flushRequested && m_queue.size() < s_maxBatchSize) {
+            const qint64 remaining = s_flushIntervalMs - timer.elapsed();
+            if (remaining <= 0) {
+                break;
+            }
+            m_writesQueued.wait(&m_mutex, static_cast<unsigned long>(remaining));
+        }
+
+        QVector<Job> batch;
+        batch.swap(m_queue);
+        m_flushRequested = false;
+        locker.unlock();
+
+        const bool committed = m_database->writeInTransaction([this, &batch]() {
+            for (const Job& job : batch) {
+                job(*m_database);
+            }
+        });
+        if (!committed) {
+            qWarning() << "[DatabaseService] Could not commit" << batch.size() << "cache writes";
+        }
+
+        locker.relock();
+        m_committed += batch.size();
+        m_writesCommitted.wakeAll();
+    }
+}
+
+void DatabaseService::update(Movie* movie)
+{
+    const int id = movie->databaseId();
+    const QString content = movie->nfoContent();
+    const QStringList files = movie->files().toStringList();
+    const QVector<Database::SubtitleRecord> subtitles = Database::subtitleRecords(*movie);
+    write([id, content, files, subtitles](Database& db) { db.updateMovie(id, content, files, subtitles); });
+}
+
+void DatabaseService::update(Concert* concert)
+{
+    const int id = concert->databaseId();
+    const QString content = concert->nfoContent();
+    const QStringList files = concert->files().toStringList();
+    write([id, content, files](Database& db) { db.updateConcert(id, content, files); });
+}
+
+void DatabaseService::update(TvShow* show)
+{
+    const int id = show->databaseId();
+    const QString content = show->nfoContent();
+    const Database::ShowSettingsRecord settings = Database::showSettingsRecord(*show);
+    write([id, content, settings](Database& db) { db.updateShow(id, content, settings); });
+}
+
+void DatabaseService::update(TvShowEpisode* episode)
+{
+    const int id = episode->databaseId();
+    const QString content = episode->nfoContent();
+    const QStringList files = episode->files().toStringList();
+    write([id, content, files](Database& db) { db.updateEpisode(id, content, files); });
+}
+
+void DatabaseService::update(Artist* artist)
+{
+    const int id = artist->databaseId();
+    const QString content = artist->nfoContent();
+    write([id, content](Database& db) { db.updateArtist(id, content); });
+}
+
+void DatabaseService::update(Album* album)
+{
+    const int id = album->databaseId();
+    const QString content = album->nfoContent();
+    write([id, content](Database& db) { db.updateAlbum(id, content); });
+}
+
+void DatabaseService::setLabel(const FileList& fileNames, ColorLabel colorLabel)
+{
+    const QStringList files = fileNames.toStringList();
+    write([files, colorLabel](Database& db) { db.setLabel(files, colorLabel); });
+}
+
+void DatabaseService::setShowMissingEpisodes(TvShow* show, bool showMissing)
+{
+    const Database::ShowSettingsRecord settings = Database::showSettingsRecord(*show);
+    write([settings, showMissing](Database& db) { db.setShowMissingEpisodes(settings, showMissing); });
+}
+
+void DatabaseService::setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials)
+{
+    const Database::ShowSettingsRecord settings = Database::showSettingsRecord(*show);
+    write([settings, hideSpecials](Database& db) { db.setHideSpecialsInMissingEpisodes(settings, hideSpecials); });
+}
+
+void DatabaseService::storeEpisodeList(TvShow* show, const QVector<TvShowEpisode*>& episodes)
+{
+    const QString dir = show->dir().toString();
+    const QVector<Database::ShowsEpisodeRecord> records = Database::showsEpisodeRecords(episodes);
+    write([dir, records](Database& db) {
+        const int showsSettingsId = db.showsSettingsId(dir);
+        db.clearEpisodeList(showsSettingsId);
+        db.addEpisodesToShowList(records, showsSettingsId);
+        db.cleanUpEpisodeList(showsSettingsId);
+    });
+}
+
+void DatabaseService::showsEpisodes(TvShow* show,
+    QObject* context,
+    std::function<void(QVector<Database::ShowsEpisodeRecord>)> callback)
+{
+    const QString dir = show->dir().toString();
+    read<QVector<Database::ShowsEpisodeRecord>>(
+        [dir](Database& db) { return db.showsEpisodes(dir); }, context, std::move(callback));
+}
+
+} // namespace mediaelch
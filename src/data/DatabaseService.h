@@ -0,0 +1,122 @@
+#pragma once
+
+#include "data/Database.h"
+#include "globals/Globals.h"
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtConcurrent>
+
+#include <functional>
+
+class Album;
+class Artist;
+class Concert;
+class Movie;
+class TvShow;
+class TvShowEpisode;
+
+namespace mediaelch {
+
+/// \brief Runs Database queries off the GUI thread.
+///
+/// Writes are queued and executed by a single writer thread. Writes that are
+/// queued within a short interval are committed in one transaction, so that
+/// saving many items does not result in one fsync per item. Reads run on a
+/// small pool of reader threads, each using its own connection (see
+/// Database::db()). A read only starts after all writes that were queued
+/// before it have been committed, so callers always see their own writes.
+///
+/// Media objects must not be accessed from another thread. The convenience
+/// functions therefore copy all values on the calling thread. Paths are copied
+/// as QString because FilePath and DirectoryPath share QFileInfo/QDir data.
+class DatabaseService : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Job = std::function<void(Database&)>;
+
+    explicit DatabaseService(Database* database, QObject* parent = nullptr);
+    /// \brief Commits all pending writes before returning.
+    ~DatabaseService() override;
+
+    /// \brief Queues a write. Returns immediately.
+    void write(Job job);
+    /// \brief Blocks until all writes queued so far are committed.
+    /// Must not be called from inside a job.
+    void flush();
+
+    /// \brief Runs the given query on a reader thread.
+    template<typename T>
+    QFuture<T> read(std::function<T(Database&)> query)
+    {
+        const qint64 sequence = enqueuedWrites();
+        return QtConcurrent::run(&m_readers, [this, sequence, query]() {
+            waitForWrites(sequence);
+            return query(*m_database);
+        });
+    }
+
+    /// \brief Runs the given query on a reader thread and calls \p callback with
+    /// its result on the thread of \p context. The callback is not called if
+    /// \p context is destroyed before the query has finished.
+    template<typename T>
+    void read(std::function<T(Database&)> query, QObject* context, std::function<void(T)> callback)
+    {
+        auto* watcher = new QFutureWatcher<T>(context);
+        connect(watcher, &QFutureWatcher<T>::finished, watcher, [watcher, callback]() {
+            callback(watcher->result());
+            watcher->deleteLater();
+        });
+        watcher->setFuture(read<T>(std::move(query)));
+    }
+
+    void update(Movie* movie);
+    void update(Concert* concert);
+    void update(TvShow* show);
+    void update(TvShowEpisode* episode);
+    void update(Artist* artist);
+    void update(Album* album);
+    void setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLabel);
+    void setShowMissingEpisodes(TvShow* show, bool showMissing);
+    void setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials);
+    /// \brief Replaces the episode list of the given show, see Database::addEpisodesToShowList().
+    void storeEpisodeList(TvShow* show, const QVector<TvShowEpisode*>& episodes);
+    /// \brief Loads the episode list of the given show, see Database::showsEpisodes().
+    void showsEpisodes(TvShow* show,
+        QObject* context,
+        std::function<void(QVector<Database::ShowsEpisodeRecord>)> callback);
+
+private:
+    void writeLoop();
+    qint64 enqueuedWrites();
+    void waitForWrites(qint64 sequence);
+
+private:
+    /// Maximum number of writes committed in one transaction.
+    static constexpr int s_maxBatchSize = 200;
+    /// Time the writer waits for further writes before it commits.
+    static constexpr int s_flushIntervalMs = 500;
+    static constexpr int s_maxReaders = 4;
+
+    Database* m_database;
+    QThreadPool m_writer;
+    QThreadPool m_readers;
+
+    QMutex m_mutex;
+    QWaitCondition m_writesQueued;
+    QWaitCondition m_writesCommitted;
+    QVector<Job> m_queue;
+    qint64 m_enqueued = 0;
+    qint64 m_committed = 0;
+    bool m_flushRequested = false;
+    bool m_stopped = false;
+};
+
+} // namespace mediaelch
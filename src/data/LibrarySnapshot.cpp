@@ -0,0 +1,129 @@
+#include "data/LibrarySnapshot.h"
+
+#include <QDebug>
+#include <QSaveFile>
+#include <cstring>
+
+namespace mediaelch {
+
+static const char s_magic[4] = {'M', 'E', 'S', 'N'};
+static constexpr quint32 s_byteOrder = 0x01020304;
+
+std::unique_ptr<LibrarySnapshot> LibrarySnapshot::open(const QString& fileName)
+{
+    std::unique_ptr<LibrarySnapshot> snapshot(new LibrarySnapshot);
+    snapshot->m_file.setFileName(fileName);
+    if (!snapshot->m_file.exists() || !snapshot->m_file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    snapshot->m_size = snapshot->m_file.size();
+    if (snapshot->m_size < static_cast<qint64>(sizeof(Header))) {
+        qWarning() << "[LibrarySnapshot] File is too small:" << fileName;
+        return nullptr;
+    }
+    snapshot->m_data = snapshot->m_file.map(0, snapshot->m_size);
+    if (snapshot->m_data == nullptr) {
+        qWarning() << "[LibrarySnapshot] Could not map file:" << fileName << snapshot->m_file.errorString();
+        return nullptr;
+    }
+
+    Header header;
+    std::memcpy(&header, snapshot->m_data, sizeof(Header));
+    if (std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0 || header.version != version
+        || header.byteOrder != s_byteOrder) {
+        qInfo() << "[LibrarySnapshot] Ignoring snapshot of another version:" << fileName;
+        return nullptr;
+    }
+
+    const qint64 recordsSize = static_cast<qint64>(header.count) * static_cast<qint64>(sizeof(Record));
+    if (static_cast<qint64>(sizeof(Header)) + recordsSize > snapshot->m_size) {
+        qWarning() << "[LibrarySnapshot] File is truncated:" << fileName;
+        return nullptr;
+    }
+
+    snapshot->m_count = header.count;
+    snapshot->m_records = reinterpret_cast<const Record*>(snapshot->m_data + sizeof(Header));
+    snapshot->m_strings = reinterpret_cast<const QChar*>(snapshot->m_data + sizeof(Header) + recordsSize);
+    snapshot->m_stringCount =
+        static_cast<quint32>((snapshot->m_size - static_cast<qint64>(sizeof(Header)) - recordsSize) / 2);
+    return snapshot;
+}
+
+bool LibrarySnapshot::write(const QString& fileName, const QVector<Entry>& entries)
+{
+    QVector<Record> records;
+    records.reserve(entries.size());
+    QString strings;
+
+    const auto addString = [&strings](const QString& string) {
+        StringRef ref;
+        ref.offset = static_cast<quint32>(strings.size());
+        ref.length = static_cast<quint32>(string.size());
+        strings.append(string);
+        return ref;
+    };
+
+    for (const Entry& entry : entries) {
+        Record record;
+        record.databaseId = entry.databaseId;
+        record.year = entry.year;
+        record.flags = entry.flags;
+        record.label = entry.label;
+        record.count = entry.count;
+        record.title = addString(entry.title);
+        record.sortTitle = addString(entry.sortTitle);
+        record.path = addString(entry.path);
+        records.push_back(record);
+    }
+
+    Header header;
+    std::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.version = version;
+    header.byteOrder = s_byteOrder;
+    header.count = static_cast<quint32>(records.size());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[LibrarySnapshot] Could not write" << fileName << file.errorString();
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(records.constData()),
+        static_cast<qint64>(records.size()) * static_cast<qint64>(sizeof(Record)));
+    file.write(reinterpret_cast<const char*>(strings.constData()), static_cast<qint64>(strings.size()) * 2);
+    if (!file.commit()) {
+        qWarning() << "[LibrarySnapshot] Could not write" << fileName << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+LibrarySnapshot::Entry LibrarySnapshot::entry(int index) const
+{
+    Entry entry;
+    if (index < 0 || static_cast<quint32>(index) >= m_count) {
+        return entry;
+    }
+    const Record& record = m_records[index];
+    entry.databaseId = record.databaseId;
+    entry.year = record.year;
+    entry.flags = record.flags;
+    entry.label = record.label;
+    entry.count = record.count;
+    entry.title = string(record.title);
+    entry.sortTitle = string(record.sortTitle);
+    entry.path = string(record.path);
+    return entry;
+}
+
+QString LibrarySnapshot::string(const StringRef& ref) const
+{
+    // Guard against corrupted files: References must be inside the mapped string table.
+    if (ref.offset > m_stringCount || ref.length > m_stringCount - ref.offset) {
+        return QString();
+    }
+    return QString(m_strings + ref.offset, static_cast<int>(ref.length));
+}
+
+} // namespace mediaelch
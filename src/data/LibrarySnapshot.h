@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+namespace mediaelch {
+
+/// Read-only snapshot of the fields that the movie and TV show lists display.
+///
+/// A snapshot is written after each successful library scan. On the next start
+/// it is memory-mapped, so that the lists show their rows immediately while the
+/// library is loaded in the background. Loading a snapshot only validates its
+/// header; entries are read from the mapped file when they are accessed.
+///
+/// \par File format
+/// A header (magic, version, byte order, entry count) is followed by fixed-size
+/// records and a table of UTF-16 strings that the records reference. Snapshots
+/// with an unknown version or a different byte order are ignored.
+class LibrarySnapshot
+{
+public:
+    enum Flag : quint32
+    {
+        InfoLoaded = 1U << 0U,
+        Watched = 1U << 1U,
+        SyncNeeded = 1U << 2U,
+        HasNewEpisodes = 1U << 3U
+    };
+
+    struct Entry
+    {
+        int databaseId = -1;
+        int year = 0;
+        quint32 flags = 0;
+        int label = 0;
+        /// Number of episodes of TV shows.
+        int count = 0;
+        QString title;
+        QString sortTitle;
+        QString path;
+    };
+
+    /// Returns nullptr if the file does not exist or is not a valid snapshot.
+    static std::unique_ptr<LibrarySnapshot> open(const QString& fileName);
+    static bool write(const QString& fileName, const QVector<Entry>& entries);
+
+    int count() const { return static_cast<int>(m_count); }
+    Entry entry(int index) const;
+
+    static constexpr quint32 version = 1;
+
+private:
+    struct StringRef
+    {
+        quint32 offset;
+        quint32 length;
+    };
+
+    struct Record
+    {
+        qint32 databaseId;
+        qint32 year;
+        quint32 flags;
+        qint32 label;
+        qint32 count;
+        StringRef title;
+        StringRef sortTitle;
+        StringRef path;
+    };
+
+    struct Header
+    {
+        char magic[4];
+        quint32 version;
+        quint32 byteOrder;
+        quint32 count;
+    };
+
+    LibrarySnapshot() = default;
+    QString string(const StringRef& ref) const;
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    quint32 m_count = 0;
+    const Record* m_records = nullptr;
+    const QChar* m_strings = nullptr;
+    quint32 m_stringCount = 0;
+};
+
+} // namespace mediaelch
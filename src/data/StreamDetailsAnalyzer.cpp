@@ -0,0 +1,499 @@
+#include "data/StreamDetailsAnalyzer.h"
+
+#include "concerts/Concert.h"
+#include "movies/Movie.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+namespace mediaelch {
+
+/// Results are applied in batches with this interval to keep the number of model updates low.
+static constexpr int s_applyIntervalMs = 250;
+/// Jobs per worker thread that are handed to the pool at once. The pool must not
+/// run dry between two batches, but paused jobs should stay in our own queue.
+static constexpr int s_jobsPerThread = 4;
+/// Changes of the queue within this interval are stored at once.
+static constexpr int s_saveDelayMs = 5000;
+/// Items of a previous session that are not found in the library within this time are dropped,
+/// e.g. because their files were deleted or their library directory was removed.
+static constexpr qint64 s_unresolvedMaxAgeMs = 30LL * 24 * 60 * 60 * 1000;
+/// At most this many unresolved items are kept; the oldest ones are dropped first.
+static constexpr int s_maxUnresolved = 20000;
+
+static QString itemName(const Movie* movie)
+{
+    return movie->name();
+}
+
+static QString itemName(const Concert* concert)
+{
+    return concert->name();
+}
+
+static QString itemName(const TvShowEpisode* episode)
+{
+    return episode->title();
+}
+
+StreamDetailsAnalyzer::StreamDetailsAnalyzer(QString queueFile, QObject* parent) :
+    QObject(parent), m_queueFile{std::move(queueFile)}
+{
+    // MediaInfo mostly waits for the disk. More threads than cores would only
+    // cause seeking on spinning disks.
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+
+    m_applyTimer.setInterval(s_applyIntervalMs);
+    connect(&m_applyTimer, &QTimer::timeout, this, &StreamDetailsAnalyzer::applyResults);
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(s_saveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &StreamDetailsAnalyzer::saveQueue);
+    if (QCoreApplication::instance() != nullptr) {
+        connect(QCoreApplication::instance(),
+            &QCoreApplication::aboutToQuit,
+            this,
+            &StreamDetailsAnalyzer::saveIfChanged);
+    }
+
+    loadQueue();
+}
+
+StreamDetailsAnalyzer::~StreamDetailsAnalyzer()
+{
+    // Running probes can't be interrupted. Their items are still part of the
+    // stored queue and are analyzed again in the next session.
+    saveIfChanged();
+    m_pool.waitForDone();
+}
+
+void StreamDetailsAnalyzer::enqueue(const QVector<Movie*>& movies)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (Movie* movie : movies) {
+        enqueueItem(ItemType::Movie, movie, movie->files(), itemName(movie), now);
+    }
+    scheduleSave();
+    startJobs();
+}
+
+void StreamDetailsAnalyzer::enqueue(const QVector<Concert*>& concerts)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (Concert* concert : concerts) {
+        enqueueItem(ItemType::Concert, concert, concert->files(), itemName(concert), now);
+    }
+    scheduleSave();
+    startJobs();
+}
+
+void StreamDetailsAnalyzer::enqueue(const QVector<TvShowEpisode*>& episodes)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (TvShowEpisode* episode : episodes) {
+        enqueueItem(ItemType::Episode, episode, episode->files(), itemName(episode), now);
+    }
+    scheduleSave();
+    startJobs();
+}
+
+void StreamDetailsAnalyzer::restore(const QVector<Movie*>& movies)
+{
+    restoreItems(ItemType::Movie, movies);
+}
+
+void StreamDetailsAnalyzer::restore(const QVector<Concert*>& concerts)
+{
+    restoreItems(ItemType::Concert, concerts);
+}
+
+void StreamDetailsAnalyzer::restore(const QVector<TvShowEpisode*>& episodes)
+{
+    restoreItems(ItemType::Episode, episodes);
+}
+
+template<class T>
+void StreamDetailsAnalyzer::restoreItems(ItemType type, const QVector<T*>& items)
+{
+    if (m_unresolved.isEmpty()) {
+        return;
+    }
+
+    QHash<QString, T*> itemsByFile;
+    for (T* item : items) {
+        if (!item->files().isEmpty()) {
+            itemsByFile.insert(item->files().first().toString(), item);
+        }
+    }
+
+    QVector<UnresolvedItem> unresolved;
+    int restored = 0;
+    for (const UnresolvedItem& entry : m_unresolved) {
+        T* item = (entry.type == type) ? itemsByFile.value(entry.file, nullptr) : nullptr;
+        if (item == nullptr) {
+            unresolved.append(entry);
+            continue;
+        }
+        enqueueItem(type, item, item->files(), itemName(item), entry.queuedAt);
+        ++restored;
+    }
+    if (restored == 0) {
+        return;
+    }
+
+    qDebug() << "[StreamDetailsAnalyzer] Restored" << restored << "items of the previous session";
+    m_unresolved = unresolved;
+    scheduleSave();
+    startJobs();
+}
+
+void StreamDetailsAnalyzer::pause()
+{
+    if (m_paused) {
+        return;
+    }
+    m_paused = true;
+    scheduleSave();
+    emit pausedChanged(true);
+}
+
+void StreamDetailsAnalyzer::resume()
+{
+    if (!m_paused) {
+        return;
+    }
+    m_paused = false;
+    scheduleSave();
+    emit pausedChanged(false);
+    startJobs();
+}
+
+void StreamDetailsAnalyzer::clear()
+{
+    m_queue.clear();
+    m_unresolved.clear();
+    scheduleSave();
+    updateTimer();
+}
+
+void StreamDetailsAnalyzer::saveIfChanged()
+{
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        saveQueue();
+    }
+}
+
+QStringList StreamDetailsAnalyzer::queuedFiles() const
+{
+    QStringList files;
+    for (const Job& job : m_queue) {
+        files << job.files.first();
+    }
+    return files;
+}
+
+bool StreamDetailsAnalyzer::isActive() const
+{
+    return !m_queue.isEmpty() || !m_running.isEmpty();
+}
+
+int StreamDetailsAnalyzer::totalCount() const
+{
+    return m_analyzedCount + m_running.size() + m_queue.size();
+}
+
+double StreamDetailsAnalyzer::filesPerSecond() const
+{
+    const qint64 elapsedMs = m_elapsedMs + (m_runTimer.isValid() ? m_runTimer.elapsed() : 0);
+    return elapsedMs > 0 ? m_analyzedFiles * 1000.0 / elapsedMs : 0.0;
+}
+
+double StreamDetailsAnalyzer::megabytesPerSecond() const
+{
+    const qint64 elapsedMs = m_elapsedMs + (m_runTimer.isValid() ? m_runTimer.elapsed() : 0);
+    return elapsedMs > 0 ? (m_analyzedBytes / (1024.0 * 1024.0)) * 1000.0 / elapsedMs : 0.0;
+}
+
+void StreamDetailsAnalyzer::enqueueItem(ItemType type,
+    QObject* item,
+    const FileList& files,
+    const QString& name,
+    qint64 queuedAt)
+{
+    if (files.isEmpty()) {
+        return;
+    }
+    Job job;
+    job.id = m_nextId++;
+    job.type = type;
+    job.queuedAt = queuedAt;
+    job.item = item;
+    job.files = files.toStringList();
+    job.name = name;
+    m_queue.append(job);
+}
+
+void StreamDetailsAnalyzer::addUnresolved(const Job& job)
+{
+    // Removed from the library in the meantime, e.g. by a reload. Reloaded items are restored.
+    UnresolvedItem entry;
+    entry.type = job.type;
+    entry.file = job.files.first();
+    entry.queuedAt = job.queuedAt;
+    m_unresolved.append(entry);
+    if (m_unresolved.size() > s_maxUnresolved) {
+        m_unresolved.remove(0, m_unresolved.size() - s_maxUnresolved);
+    }
+}
+
+void StreamDetailsAnalyzer::startJobs()
+{
+    const int maxRunning = m_pool.maxThreadCount() * s_jobsPerThread;
+    while (!m_paused && !m_queue.isEmpty() && m_running.size() < maxRunning) {
+        const Job job = m_queue.takeFirst();
+        if (job.item.isNull()) {
+            addUnresolved(job);
+            continue;
+        }
+        m_running.insert(job.id, job);
+
+        const int id = job.id;
+        const QStringList files = job.files;
+        QtConcurrent::run(&m_pool, [this, id, files]() {
+            Result result = analyze(id, files);
+            QMutexLocker locker(&m_resultMutex);
+            m_results.append(std::move(result));
+        });
+    }
+    updateTimer();
+}
+
+StreamDetailsAnalyzer::Result StreamDetailsAnalyzer::analyze(int id, const QStringList& files)
+{
+    StreamDetails details(nullptr, FileList(files));
+    details.loadStreamDetails();
+
+    Result result;
+    result.id = id;
+    result.videoDetails = details.videoDetails();
+    result.audioDetails = details.audioDetails();
+    result.subtitleDetails = details.subtitleDetails();
+    result.files = files.size();
+    for (const QString& file : files) {
+        result.bytes += QFileInfo(file).size();
+    }
+    return result;
+}
+
+void StreamDetailsAnalyzer::applyResults()
+{
+    QVector<Result> results;
+    {
+        QMutexLocker locker(&m_resultMutex);
+        results.swap(m_results);
+    }
+
+    QString lastItem;
+    for (const Result& result : results) {
+        const Job job = m_running.take(result.id);
+        if (job.item.isNull()) {
+            addUnresolved(job);
+            continue;
+        }
+        apply(job, result);
+        lastItem = job.name;
+        ++m_analyzedCount;
+        m_analyzedFiles += result.files;
+        m_analyzedBytes += result.bytes;
+    }
+
+    if (!results.isEmpty()) {
+        emit itemAnalyzed(lastItem);
+        emit progress(m_analyzedCount, totalCount());
+        scheduleSave();
+    }
+
+    startJobs();
+}
+
+void StreamDetailsAnalyzer::apply(const Job& job, const Result& result)
+{
+    StreamDetails* details = nullptr;
+    switch (job.type) {
+    case ItemType::Movie: details = static_cast<Movie*>(job.item.data())->streamDetails(); break;
+    case ItemType::Concert: details = static_cast<Concert*>(job.item.data())->streamDetails(); break;
+    case ItemType::Episode: details = static_cast<TvShowEpisode*>(job.item.data())->streamDetails(); break;
+    }
+
+    // Same order as StreamDetails::loadStreamDetails() so that derived values are the same.
+    details->clear();
+    for (auto it = result.videoDetails.cbegin(); it != result.videoDetails.cend(); ++it) {
+        details->setVideoDetail(it.key(), it.value());
+    }
+    for (int i = 0; i < result.audioDetails.size(); ++i) {
+        const auto& audio = result.audioDetails.at(i);
+        for (auto it = audio.cbegin(); it != audio.cend(); ++it) {
+            details->setAudioDetail(i, it.key(), it.value());
+        }
+    }
+    for (int i = 0; i < result.subtitleDetails.size(); ++i) {
+        const auto& subtitle = result.subtitleDetails.at(i);
+        for (auto it = subtitle.cbegin(); it != subtitle.cend(); ++it) {
+            details->setSubtitleDetail(i, it.key(), it.value());
+        }
+    }
+
+    switch (job.type) {
+    case ItemType::Movie: static_cast<Movie*>(job.item.data())->controller()->updateFromStreamDetails(); break;
+    case ItemType::Concert: static_cast<Concert*>(job.item.data())->controller()->updateFromStreamDetails(); break;
+    case ItemType::Episode: static_cast<TvShowEpisode*>(job.item.data())->updateFromStreamDetails(); break;
+    }
+}
+
+void StreamDetailsAnalyzer::updateTimer()
+{
+    if (!m_running.isEmpty()) {
+        if (!m_runTimer.isValid()) {
+            m_runTimer.start();
+        }
+        if (!m_applyTimer.isActive()) {
+            m_applyTimer.start();
+        }
+        return;
+    }
+
+    m_applyTimer.stop();
+    if (m_runTimer.isValid()) {
+        m_elapsedMs += m_runTimer.elapsed();
+        m_runTimer.invalidate();
+    }
+
+    if (m_queue.isEmpty()) {
+        if (m_analyzedCount > 0) {
+            qDebug() << "[StreamDetailsAnalyzer] Analyzed" << m_analyzedFiles << "files |" << filesPerSecond()
+                     << "files/s |" << megabytesPerSecond() << "MB/s";
+        }
+        m_analyzedCount = 0;
+        m_analyzedFiles = 0;
+        m_analyzedBytes = 0;
+        m_elapsedMs = 0;
+        emit finished();
+    }
+}
+
+QString StreamDetailsAnalyzer::typeToString(ItemType type)
+{
+    switch (type) {
+    case ItemType::Movie: return QStringLiteral("movie");
+    case ItemType::Concert: return QStringLiteral("concert");
+    case ItemType::Episode: return QStringLiteral("episode");
+    }
+    return QString();
+}
+
+void StreamDetailsAnalyzer::loadQueue()
+{
+    QFile file(m_queueFile);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+    m_paused = json.value("paused").toBool();
+
+    const QHash<QString, ItemType> types{{typeToString(ItemType::Movie), ItemType::Movie},
+        {typeToString(ItemType::Concert), ItemType::Concert},
+        {typeToString(ItemType::Episode), ItemType::Episode}};
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    int expired = 0;
+    for (const QJsonValue& value : json.value("items").toArray()) {
+        const QJsonObject item = value.toObject();
+        UnresolvedItem entry;
+        entry.file = item.value("file").toString();
+        // Items of older versions have no time; they count as queued now.
+        entry.queuedAt = static_cast<qint64>(item.value("queuedAt").toDouble(static_cast<double>(now)));
+        const QString type = item.value("type").toString();
+        if (!types.contains(type) || entry.file.isEmpty()) {
+            continue;
+        }
+        if (now - entry.queuedAt > s_unresolvedMaxAgeMs) {
+            ++expired;
+            continue;
+        }
+        entry.type = types.value(type);
+        m_unresolved.append(entry);
+    }
+    if (m_unresolved.size() > s_maxUnresolved) {
+        expired += m_unresolved.size() - s_maxUnresolved;
+        m_unresolved.remove(0, m_unresolved.size() - s_maxUnresolved);
+    }
+    qDebug() << "[StreamDetailsAnalyzer] Loaded" << m_unresolved.size() << "queued items of the previous session,"
+             << "dropped" << expired << "expired ones";
+}
+
+void StreamDetailsAnalyzer::scheduleSave()
+{
+    if (!m_saveTimer.isActive()) {
+        m_saveTimer.start();
+    }
+}
+
+void StreamDetailsAnalyzer::saveQueue()
+{
+    if (m_queueFile.isEmpty()) {
+        return;
+    }
+
+    // Stored in the order in which the items were queued, so that they are analyzed in the same order
+    // once they are restored.
+    QVector<UnresolvedItem> entries;
+    for (const Job& job : m_running) {
+        entries.append({job.type, job.files.first(), job.queuedAt});
+    }
+    for (const Job& job : m_queue) {
+        entries.append({job.type, job.files.first(), job.queuedAt});
+    }
+    entries.append(m_unresolved);
+    std::stable_sort(entries.begin(), entries.end(), [](const UnresolvedItem& a, const UnresolvedItem& b) {
+        return a.queuedAt < b.queuedAt;
+    });
+
+    QJsonArray items;
+    for (const UnresolvedItem& entry : entries) {
+        items.append(QJsonObject{{"type", typeToString(entry.type)},
+            {"file", entry.file},
+            {"queuedAt", static_cast<double>(entry.queuedAt)}});
+    }
+
+    if (items.isEmpty()) {
+        QFile::remove(m_queueFile);
+        return;
+    }
+
+    QSaveFile file(m_queueFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[StreamDetailsAnalyzer] Could not store queue in" << m_queueFile;
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject{{"paused", m_paused}, {"items", items}}).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "[StreamDetailsAnalyzer] Could not store queue in" << m_queueFile;
+    }
+}
+
+} // namespace mediaelch
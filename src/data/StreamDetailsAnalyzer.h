@@ -0,0 +1,164 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+
+class Concert;
+class Movie;
+class TvShowEpisode;
+
+namespace mediaelch {
+
+/// \brief Loads stream details of movies, concerts and episodes in the background.
+///
+/// Files are analyzed with MediaInfo on a thread pool. The results are applied
+/// to the media objects on the GUI thread in batches, so that thousands of files
+/// don't block the UI. The analysis can be paused and resumed. The queue is
+/// stored on disk when it changes, so that an analysis that was interrupted by
+/// closing MediaElch continues once the library is loaded again, see restore().
+/// Changes are stored with a short delay and on exit, not on every applied batch.
+/// Items of a previous session that are not found again are dropped after some time.
+class StreamDetailsAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// \param queueFile JSON file in which the queue is stored between sessions.
+    explicit StreamDetailsAnalyzer(QString queueFile, QObject* parent = nullptr);
+    ~StreamDetailsAnalyzer() override;
+
+    void enqueue(const QVector<Movie*>& movies);
+    void enqueue(const QVector<Concert*>& concerts);
+    void enqueue(const QVector<TvShowEpisode*>& episodes);
+
+    /// \brief Queues items of a previous session that are part of the given list.
+    void restore(const QVector<Movie*>& movies);
+    void restore(const QVector<Concert*>& concerts);
+    void restore(const QVector<TvShowEpisode*>& episodes);
+
+    /// \brief Stops starting new analyses. Files that are already analyzed are still applied.
+    void pause();
+    void resume();
+    /// \brief Removes all items that were not analyzed, yet.
+    void clear();
+    /// \brief Stores the queue now if a change was not stored, yet.
+    void saveIfChanged();
+
+    /// \brief First files of the queued items in the order in which they are analyzed.
+    QStringList queuedFiles() const;
+    /// \brief Number of items of a previous session that were not found in the library, yet.
+    int unresolvedCount() const { return m_unresolved.size(); }
+
+    bool isPaused() const { return m_paused; }
+    /// \brief True if items are queued or being analyzed.
+    bool isActive() const;
+    /// \brief Items analyzed since the queue was last empty.
+    int analyzedCount() const { return m_analyzedCount; }
+    /// \brief Items analyzed plus items that are still pending.
+    int totalCount() const;
+
+    /// \brief Number of media files that were probed by MediaInfo.
+    int analyzedFiles() const { return m_analyzedFiles; }
+    /// \brief Size of all probed files. MediaInfo only reads the parts of a file it needs.
+    qint64 analyzedBytes() const { return m_analyzedBytes; }
+    /// \brief Average throughput while the analysis was running (not paused).
+    double filesPerSecond() const;
+    double megabytesPerSecond() const;
+
+signals:
+    void progress(int analyzed, int total);
+    void itemAnalyzed(QString name);
+    void pausedChanged(bool paused);
+    /// \brief All items were analyzed and applied.
+    void finished();
+
+private:
+    enum class ItemType
+    {
+        Movie,
+        Concert,
+        Episode
+    };
+
+    /// An item of a previous session that was not found in the library, yet.
+    struct UnresolvedItem
+    {
+        ItemType type = ItemType::Movie;
+        QString file;
+        /// Milliseconds since epoch when the item was queued.
+        qint64 queuedAt = 0;
+    };
+
+    struct Job
+    {
+        int id = 0;
+        ItemType type = ItemType::Movie;
+        qint64 queuedAt = 0;
+        QPointer<QObject> item;
+        /// Plain strings: Worker threads must not share implicitly shared QFileInfo objects.
+        QStringList files;
+        QString name;
+    };
+
+    struct Result
+    {
+        int id = 0;
+        QMap<StreamDetails::VideoDetails, QString> videoDetails;
+        QVector<QMap<StreamDetails::AudioDetails, QString>> audioDetails;
+        QVector<QMap<StreamDetails::SubtitleDetails, QString>> subtitleDetails;
+        int files = 0;
+        qint64 bytes = 0;
+    };
+
+    void enqueueItem(ItemType type, QObject* item, const FileList& files, const QString& name, qint64 queuedAt);
+    void addUnresolved(const Job& job);
+    template<class T>
+    void restoreItems(ItemType type, const QVector<T*>& items);
+    void startJobs();
+    void applyResults();
+    void apply(const Job& job, const Result& result);
+    void updateTimer();
+    void loadQueue();
+    void scheduleSave();
+    void saveQueue();
+
+    static Result analyze(int id, const QStringList& files);
+    static QString typeToString(ItemType type);
+
+    QString m_queueFile;
+    QThreadPool m_pool;
+    /// Results are collected by the workers and applied by m_applyTimer.
+    QTimer m_applyTimer;
+    /// Collects changes of the queue, see scheduleSave().
+    QTimer m_saveTimer;
+    QMutex m_resultMutex;
+    QVector<Result> m_results;
+
+    QList<Job> m_queue;
+    /// Jobs whose results were not applied, yet.
+    QMap<int, Job> m_running;
+    /// Items of a previous session that were not found in the library, oldest first.
+    QVector<UnresolvedItem> m_unresolved;
+    int m_nextId = 1;
+
+    bool m_paused = false;
+    int m_analyzedCount = 0;
+    int m_analyzedFiles = 0;
+    qint64 m_analyzedBytes = 0;
+    QElapsedTimer m_runTimer;
+    qint64 m_elapsedMs = 0;
+};
+
+} // namespace mediaelch
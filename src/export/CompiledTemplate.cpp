@@ -0,0 +1,222 @@
+#include "export/CompiledTemplate.h"
+
+#include <QRegularExpression>
+
+namespace mediaelch {
+
+void TemplateValues::set(const QString& name, const QString& value)
+{
+    m_variables.insert(name, value);
+}
+
+void TemplateValues::setBlock(const QString& blockName, QVector<Variables> items, const QString& separator)
+{
+    m_blocks.insert(blockName, Block{std::move(items), separator});
+}
+
+void TemplateValues::setRenderedBlock(const QString& blockName, const QString& content)
+{
+    m_renderedBlocks.insert(blockName, content);
+}
+
+CompiledTemplate::CompiledTemplate(const QString& content)
+{
+    parse(content);
+}
+
+void CompiledTemplate::parse(const QString& content)
+{
+    static const QString open = QStringLiteral("{{ ");
+    static const QString close = QStringLiteral(" }}");
+    static const QString beginBlock = QStringLiteral("BEGIN_BLOCK_");
+    static const QRegularExpression imageRx(R"(^IMAGE\.(.*)\[(\d*), ?(\d*)\]$)");
+
+    int pos = 0;
+    while (pos < content.length()) {
+        const int start = content.indexOf(open, pos);
+        if (start == -1) {
+            break;
+        }
+        const int end = content.indexOf(close, start + open.length());
+        if (end == -1) {
+            break;
+        }
+        // "{{ a {{ B }}": Only the innermost braces form a placeholder.
+        const int nested = content.indexOf(open, start + open.length());
+        if (nested != -1 && nested < end) {
+            appendLiteral(content.mid(pos, nested - pos));
+            pos = nested;
+            continue;
+        }
+
+        appendLiteral(content.mid(pos, start - pos));
+
+        const int placeholderEnd = end + close.length();
+        const QString name = content.mid(start + open.length(), end - start - open.length());
+        const QString original = content.mid(start, placeholderEnd - start);
+
+        if (name.startsWith(beginBlock)) {
+            const QString blockName = name.mid(beginBlock.length());
+            const QString endTag = QStringLiteral("{{ END_BLOCK_%1 }}").arg(blockName);
+            const int endTagPos = content.indexOf(endTag, placeholderEnd);
+            if (endTagPos == -1) {
+                appendLiteral(original);
+                pos = placeholderEnd;
+                continue;
+            }
+            Segment segment;
+            segment.type = Segment::Type::Block;
+            segment.text = blockName;
+            segment.original = content.mid(start, endTagPos + endTag.length() - start);
+            segment.block = std::make_shared<CompiledTemplate>(
+                content.mid(placeholderEnd, endTagPos - placeholderEnd).trimmed());
+            m_segments.push_back(segment);
+            pos = endTagPos + endTag.length();
+            continue;
+        }
+
+        const QRegularExpressionMatch match = imageRx.match(name);
+        if (match.hasMatch()) {
+            const QSize size(match.captured(2).toInt(), match.captured(3).toInt());
+            if (size.isEmpty()) {
+                appendLiteral(original);
+            } else {
+                Segment segment;
+                segment.type = Segment::Type::Image;
+                segment.text = match.captured(1).toLower();
+                segment.original = original;
+                segment.imageSize = size;
+                m_segments.push_back(segment);
+            }
+        } else {
+            Segment segment;
+            segment.type = Segment::Type::Variable;
+            segment.text = name;
+            segment.original = original;
+            m_segments.push_back(segment);
+        }
+        pos = placeholderEnd;
+    }
+
+    appendLiteral(content.mid(pos));
+}
+
+void CompiledTemplate::appendLiteral(const QString& text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    m_literalLength += text.length();
+    if (!m_segments.isEmpty() && m_segments.last().type == Segment::Type::Literal) {
+        m_segments.last().text.append(text);
+        return;
+    }
+    Segment segment;
+    segment.text = text;
+    m_segments.push_back(segment);
+}
+
+QString CompiledTemplate::render(const TemplateValues& values, const ImageResolver& resolveImage) const
+{
+    QString out;
+    // Values are usually shorter than the template itself.
+    out.reserve(m_literalLength * 2);
+    renderTo(out, values, nullptr, resolveImage);
+    return out;
+}
+
+void CompiledTemplate::renderTo(QString& out,
+    const TemplateValues& values,
+    const TemplateValues::Variables* item,
+    const ImageResolver& resolveImage) const
+{
+    for (const Segment& segment : m_segments) {
+        switch (segment.type) {
+        case Segment::Type::Literal: out.append(segment.text); break;
+        case Segment::Type::Variable: {
+            if (item != nullptr) {
+                const auto itemValue = item->constFind(segment.text);
+                if (itemValue != item->cend()) {
+                    out.append(itemValue.value());
+                    break;
+                }
+            }
+            const auto value = values.m_variables.constFind(segment.text);
+            out.append(value != values.m_variables.cend() ? value.value() : segment.original);
+            break;
+        }
+        case Segment::Type::Image: {
+            const QString path = resolveImage ? resolveImage(segment.text, segment.imageSize) : QString();
+            out.append(path.isNull() ? segment.original : path);
+            break;
+        }
+        case Segment::Type::Block: {
+            const auto rendered = values.m_renderedBlocks.constFind(segment.text);
+            if (rendered != values.m_renderedBlocks.cend()) {
+                out.append(rendered.value());
+                break;
+            }
+            const auto block = values.m_blocks.constFind(segment.text);
+            if (block == values.m_blocks.cend()) {
+                out.append(segment.original);
+                break;
+            }
+            const QVector<TemplateValues::Variables>& items = block.value().items;
+            for (int i = 0; i < items.size(); ++i) {
+                if (i > 0) {
+                    out.append(block.value().separator);
+                }
+                segment.block->renderTo(out, values, &items.at(i), resolveImage);
+            }
+            break;
+        }
+        }
+    }
+}
+
+const CompiledTemplate* CompiledTemplate::block(const QString& blockName) const
+{
+    for (const Segment& segment : m_segments) {
+        if (segment.type != Segment::Type::Block) {
+            continue;
+        }
+        if (segment.text == blockName) {
+            return segment.block.get();
+        }
+        const CompiledTemplate* nested = segment.block->block(blockName);
+        if (nested != nullptr) {
+            return nested;
+        }
+    }
+    return nullptr;
+}
+
+bool CompiledTemplate::splitAtBlock(const QString& blockName,
+    CompiledTemplate& before,
+    CompiledTemplate& blockTemplate,
+    CompiledTemplate& after) const
+{
+    for (int i = 0; i < m_segments.size(); ++i) {
+        const Segment& segment = m_segments.at(i);
+        if (segment.type != Segment::Type::Block || segment.text != blockName) {
+            continue;
+        }
+        before = CompiledTemplate();
+        after = CompiledTemplate();
+        for (int j = 0; j < m_segments.size(); ++j) {
+            if (j == i) {
+                continue;
+            }
+            CompiledTemplate& part = (j < i) ? before : after;
+            part.m_segments.push_back(m_segments.at(j));
+            if (m_segments.at(j).type == Segment::Type::Literal) {
+                part.m_literalLength += m_segments.at(j).text.length();
+            }
+        }
+        blockTemplate = *segment.block;
+        return true;
+    }
+    return false;
+}
+
+} // namespace mediaelch
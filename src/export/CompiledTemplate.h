@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QHash>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include <memory>
+
+namespace mediaelch {
+
+/// Values used to render a CompiledTemplate. Variables are stored without
+/// braces, e.g. "MOVIE.TITLE" for "{{ MOVIE.TITLE }}".
+class TemplateValues
+{
+public:
+    using Variables = QHash<QString, QString>;
+
+    void set(const QString& name, const QString& value);
+    /// Each item of the block "{{ BEGIN_BLOCK_<name> }}" is rendered with its own variables.
+    /// Variables that are not set for an item are looked up in this object.
+    void setBlock(const QString& blockName, QVector<Variables> items, const QString& separator = " ");
+    /// Replace the whole block with the given content, e.g. for nested blocks
+    /// that were rendered by the caller.
+    void setRenderedBlock(const QString& blockName, const QString& content);
+
+private:
+    friend class CompiledTemplate;
+
+    struct Block
+    {
+        QVector<Variables> items;
+        QString separator;
+    };
+
+    Variables m_variables;
+    QHash<QString, Block> m_blocks;
+    QHash<QString, QString> m_renderedBlocks;
+};
+
+/// Template of the SimpleEngine that is parsed once into literal and placeholder
+/// segments. Rendering only appends strings, so that the template does not have
+/// to be searched again for each exported item.
+///
+/// Supported placeholders:
+///   - {{ NAME }}
+///   - {{ IMAGE.TYPE[width, height] }}
+///   - {{ BEGIN_BLOCK_NAME }} ... {{ END_BLOCK_NAME }}
+///
+/// Placeholders without a value are rendered as-is. Rendering is const and
+/// can therefore be done from multiple threads at once.
+class CompiledTemplate
+{
+public:
+    /// Returns the path of the exported image for the given (lower case) image type
+    /// or a null string if the placeholder shall not be replaced.
+    using ImageResolver = std::function<QString(const QString& type, const QSize& size)>;
+
+    CompiledTemplate() = default;
+    explicit CompiledTemplate(const QString& content);
+
+    bool isEmpty() const { return m_segments.isEmpty(); }
+
+    QString render(const TemplateValues& values, const ImageResolver& resolveImage = nullptr) const;
+
+    /// Returns the inner template of the first block with the given name or nullptr.
+    /// Nested blocks are searched as well.
+    const CompiledTemplate* block(const QString& blockName) const;
+
+    /// Splits the template at the first top-level block with the given name.
+    /// Used for list pages so that the items can be written one after the other.
+    /// Returns false if there is no such block.
+    bool splitAtBlock(const QString& blockName,
+        CompiledTemplate& before,
+        CompiledTemplate& blockTemplate,
+        CompiledTemplate& after) const;
+
+private:
+    struct Segment
+    {
+        enum class Type
+        {
+            Literal,
+            Variable,
+            Image,
+            Block
+        };
+
+        Type type = Type::Literal;
+        /// Literal text, variable name, lower case image type or block name.
+        QString text;
+        /// The placeholder as written in the template; used if no value is available.
+        QString original;
+        QSize imageSize;
+        std::shared_ptr<CompiledTemplate> block;
+    };
+
+    void parse(const QString& content);
+    void appendLiteral(const QString& text);
+    void renderTo(QString& out,
+        const TemplateValues& values,
+        const TemplateValues::Variables* item,
+        const ImageResolver& resolveImage) const;
+
+private:
+    QVector<Segment> m_segments;
+    int m_literalLength = 0;
+};
+
+} // namespace mediaelch
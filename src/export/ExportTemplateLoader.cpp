@@ -16,6 +16,7 @@
 
 #include "data/Storage.h"
 #include "globals/VersionInfo.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
 #include "settings/Settings.h"
 
@@ -34,7 +35,8 @@ ExportTemplateLoader* ExportTemplateLoader::instance(QObject* parent)
 
 void ExportTemplateLoader::getRemoteTemplates()
 {
-    QNetworkReply* reply = m_qnam.get(mediaelch::network::requestWithDefaults(QUrl(s_themeListUrl)));
+    QNetworkReply* reply =
+        mediaelch::network::accessManager()->get(mediaelch::network::requestWithDefaults(QUrl(s_themeListUrl)));
     connect(reply, &QNetworkReply::finished, this, &ExportTemplateLoader::onLoadRemoteTemplatesFinished);
 }
 
@@ -180,7 +182,8 @@ ExportTemplate* ExportTemplateLoader::parseTemplate(QXmlStreamReader& xml)
 
 void ExportTemplateLoader::installTemplate(ExportTemplate* exportTemplate)
 {
-    QNetworkReply* reply = m_qnam.get(mediaelch::network::requestWithDefaults(QUrl(exportTemplate->remoteFile())));
+    QNetworkReply* reply = mediaelch::network::accessManager()->get(
+        mediaelch::network::requestWithDefaults(QUrl(exportTemplate->remoteFile())));
     reply->setProperty("storage", Storage::toVariant(reply, exportTemplate));
     connect(reply, &QNetworkReply::finished, this, &ExportTemplateLoader::onDownloadTemplateFinished);
 }
@@ -33,7 +33,6 @@ private slots:
     void onDownloadTemplateFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QVector<ExportTemplate*> m_localTemplates;
     QVector<ExportTemplate*> m_remoteTemplates;
 
@@ -7,8 +7,13 @@
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
-#include <QApplication>
 #include <QEventLoop>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <utility>
 
 static QString colorLabelToString(ColorLabel label)
 {
@@ -37,121 +42,222 @@ SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
     m_template->copyTo(m_dir.path());
 }
 
-void SimpleEngine::exportMovies(QVector<Movie*> movies)
+template<class T>
+void SimpleEngine::exportInBatches(const QVector<T*>& items, std::function<QString(T*)> renderItem, QFile& listFile)
 {
-    std::sort(movies.begin(), movies.end(), Movie::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Movies);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Movie);
-
-    QString listMovieItem;
-    QString listMovieBlock;
-    QStringList movieList;
-    QRegExp rx(R"(\{\{ BEGIN_BLOCK_MOVIE \}\}(.*)\{\{ END_BLOCK_MOVIE \}\})");
-    rx.setMinimal(true);
-
-    int pos = 0;
-    while ((pos = rx.indexIn(listContent, pos)) != -1) {
-        pos += rx.matchedLength();
-
-        listMovieBlock = rx.cap(0);
-        listMovieItem = rx.cap(1).trimmed();
-    }
-
-    m_dir.mkdir("movies");
-    m_dir.mkdir("movie_images");
+    // Items are exported in batches so that the list page can be written and progress
+    // can be reported while the export is still running. The GUI thread keeps
+    // processing events while waiting for a batch.
+    const int batchSize = qMax(1, QThreadPool::globalInstance()->maxThreadCount()) * 4;
+    bool isFirstListItem = true;
 
-    for (Movie* movie : movies) {
+    for (int i = 0; i < items.size(); i += batchSize) {
         if (m_cancelFlag.load()) {
             return;
         }
 
-        // We can't replace an empty block...
-        if (!listMovieItem.isEmpty()) {
-            QString m = listMovieItem;
-            replaceVars(m, movie);
-            movieList << m;
+        // Rendering reads the media objects and therefore happens here.  Worker threads
+        // only get copies of the rendered pages and of the image paths.
+        QStringList listItems;
+        for (T* item : items.mid(i, batchSize)) {
+            listItems << renderItem(item);
+        }
+        QVector<QueuedFile> files;
+        std::swap(files, m_queuedFiles);
+
+        QFuture<void> future = QtConcurrent::map(files, [this](const QueuedFile& file) { writeQueuedFile(file); });
+        QFutureWatcher<void> watcher;
+        QEventLoop loop;
+        connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+        watcher.setFuture(future);
+        if (!future.isFinished()) {
+            loop.exec();
         }
 
-        if (!itemContent.isEmpty()) {
-            QString movieTemplate = itemContent;
-            replaceVars(movieTemplate, movie, true);
-            QFile file(m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(movieTemplate.toUtf8());
-                file.close();
+        for (const QString& listItem : listItems) {
+            if (!listItem.isEmpty() && listFile.isOpen()) {
+                if (!isFirstListItem) {
+                    listFile.write("\n");
+                }
+                listFile.write(listItem.toUtf8());
+                isFirstListItem = false;
             }
+            emit sigItemExported();
         }
+    }
+}
+
+void SimpleEngine::queuePage(const QString& fileName, const QString& content)
+{
+    QueuedFile file;
+    file.destination = fileName;
+    file.content = content;
+    m_queuedFiles << file;
+}
+
+void SimpleEngine::queueImage(QSize size, QString imageFile, QString destinationFile)
+{
+    // The same image may be used on the list and detail page.
+    if (m_savedImages.contains(destinationFile)) {
+        return;
+    }
+    m_savedImages.insert(destinationFile);
+
+    QueuedFile file;
+    file.destination = destinationFile;
+    file.imageSource = imageFile;
+    file.imageSize = size;
+    m_queuedFiles << file;
+}
+
+void SimpleEngine::writeQueuedFile(const QueuedFile& queued) const
+{
+    if (queued.imageSource.isEmpty()) {
+        QFile file(queued.destination);
+        if (file.open(QFile::WriteOnly | QFile::Text)) {
+            file.write(queued.content.toUtf8());
+            file.close();
+        }
+        return;
+    }
+
+    // Let the image reader scale while decoding. For JPEGs this avoids
+    // decoding the full resolution image.
+    QImageReader reader(queued.imageSource);
+    const QSize originalSize = reader.size();
+    if (originalSize.isValid()) {
+        reader.setScaledSize(originalSize.scaled(queued.imageSize, Qt::KeepAspectRatio));
+    }
+
+    QImage img = reader.read();
+    if (img.isNull()) {
+        qWarning() << "[Export][SimpleEngine] Cannot load image:" << queued.imageSource << reader.errorString();
+        return;
+    }
 
-        emit sigItemExported();
-        QApplication::processEvents();
+    if (!originalSize.isValid()) {
+        img = img.scaled(queued.imageSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
 
-    // If the movie block is empty, replacing it would result in add a line break after each character
-    if (!listMovieBlock.isEmpty()) {
-        listContent.replace(listMovieBlock, movieList.join("\n"));
+    if (!img.isNull()) {
+        img.save(queued.destination);
+    } else {
+        qWarning() << "[Export][SimpleEngine] Could not scale (result was empty):" << queued.imageSource;
     }
+}
 
-    QFile file(m_dir.path() + "/movies.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+void SimpleEngine::writeListPage(QFile& listFile, const CompiledTemplate& listTemplate)
+{
+    if (listFile.isOpen()) {
+        listFile.write(listTemplate.render(TemplateValues{}).toUtf8());
     }
 }
 
-void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
+void SimpleEngine::exportMovies(QVector<Movie*> movies)
 {
-    m.replace("{{ MOVIE.ID }}", QString::number(movie->movieId(), 'f', 0));
-    m.replace("{{ MOVIE.LINK }}", QString("movies/%1.html").arg(movie->movieId()));
-    m.replace("{{ MOVIE.IMDB_ID }}", movie->imdbId().toString());
-    m.replace("{{ MOVIE.TMDB_ID }}", movie->tmdbId().toString());
-    m.replace("{{ MOVIE.TITLE }}", movie->name().toHtmlEscaped());
-    m.replace("{{ MOVIE.YEAR }}", movie->released().isValid() ? movie->released().toString("yyyy") : "");
-    m.replace("{{ MOVIE.ORIGINAL_TITLE }}", movie->originalName().toHtmlEscaped());
-    m.replace("{{ MOVIE.PLOT }}", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.PLOT_SIMPLE }}", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.SET }}", movie->set().name.toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGLINE }}", movie->tagline().toHtmlEscaped());
-    m.replace("{{ MOVIE.GENRES }}", movie->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.COUNTRIES }}", movie->countries().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.STUDIOS }}", movie->studios().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGS }}", movie->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.WRITER }}", movie->writer().toHtmlEscaped());
-    m.replace("{{ MOVIE.DIRECTOR }}", movie->director().toHtmlEscaped());
-    m.replace("{{ MOVIE.CERTIFICATION }}", movie->certification().toString().toHtmlEscaped());
-    m.replace("{{ MOVIE.TRAILER }}", movie->trailer().toString());
-    m.replace("{{ MOVIE.LABEL }}", colorLabelToString(movie->label()));
+    std::sort(movies.begin(), movies.end(), Movie::lessThan);
+    const CompiledTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Movies));
+    const CompiledTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Movie));
+
+    CompiledTemplate listBefore;
+    CompiledTemplate listMovieItem;
+    CompiledTemplate listAfter;
+    if (!listTemplate.splitAtBlock("MOVIE", listBefore, listMovieItem, listAfter)) {
+        listBefore = listTemplate;
+    }
+
+    m_dir.mkdir("movies");
+    m_dir.mkdir("movie_images");
+
+    QFile listFile(m_dir.path() + "/movies.html");
+    if (!listFile.open(QFile::WriteOnly | QFile::Text)) {
+        qWarning() << "[Export][SimpleEngine] Cannot write file:" << listFile.fileName();
+    }
+    writeListPage(listFile, listBefore);
+
+    exportInBatches<Movie>(
+        movies,
+        [&](Movie* movie) {
+            TemplateValues values;
+            addVars(values, movie);
+
+            if (!itemTemplate.isEmpty()) {
+                const QString content = itemTemplate.render(values, [&](const QString& type, const QSize& size) {
+                    return resolveImage(type, size, true, movie, nullptr, nullptr, nullptr);
+                });
+                queuePage(m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId()), content);
+            }
+
+            // We can't replace an empty block...
+            if (listMovieItem.isEmpty()) {
+                return QString();
+            }
+            return listMovieItem.render(values, [&](const QString& type, const QSize& size) {
+                return resolveImage(type, size, false, movie, nullptr, nullptr, nullptr);
+            });
+        },
+        listFile);
+
+    if (m_cancelFlag.load()) {
+        return;
+    }
+    writeListPage(listFile, listAfter);
+}
+
+void SimpleEngine::addVars(TemplateValues& values, Movie* movie)
+{
+    values.set("MOVIE.ID", QString::number(movie->movieId(), 'f', 0));
+    values.set("MOVIE.LINK", QString("movies/%1.html").arg(movie->movieId()));
+    values.set("MOVIE.IMDB_ID", movie->imdbId().toString());
+    values.set("MOVIE.TMDB_ID", movie->tmdbId().toString());
+    values.set("MOVIE.TITLE", movie->name().toHtmlEscaped());
+    values.set("MOVIE.YEAR", movie->released().isValid() ? movie->released().toString("yyyy") : "");
+    values.set("MOVIE.ORIGINAL_TITLE", movie->originalName().toHtmlEscaped());
+    values.set("MOVIE.PLOT", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("MOVIE.PLOT_SIMPLE", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("MOVIE.SET", movie->set().name.toHtmlEscaped());
+    values.set("MOVIE.TAGLINE", movie->tagline().toHtmlEscaped());
+    values.set("MOVIE.GENRES", movie->genres().join(", ").toHtmlEscaped());
+    values.set("MOVIE.COUNTRIES", movie->countries().join(", ").toHtmlEscaped());
+    values.set("MOVIE.STUDIOS", movie->studios().join(", ").toHtmlEscaped());
+    values.set("MOVIE.TAGS", movie->tags().join(", ").toHtmlEscaped());
+    values.set("MOVIE.WRITER", movie->writer().toHtmlEscaped());
+    values.set("MOVIE.DIRECTOR", movie->director().toHtmlEscaped());
+    values.set("MOVIE.CERTIFICATION", movie->certification().toString().toHtmlEscaped());
+    values.set("MOVIE.TRAILER", movie->trailer().toString());
+    values.set("MOVIE.LABEL", colorLabelToString(movie->label()));
 
     // @todo multiple ratings
     if (!movie->ratings().isEmpty()) {
         double rating = movie->ratings().front().rating;
         int voteCount = movie->ratings().front().voteCount;
-        m.replace("{{ MOVIE.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ MOVIE.VOTES }}", QString::number(voteCount, 'f', 0));
+        values.set("MOVIE.RATING", QString::number(rating, 'f', 1));
+        values.set("MOVIE.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ MOVIE.RATING }}", "n/a");
-        m.replace("{{ MOVIE.VOTES }}", "n/a");
+        values.set("MOVIE.RATING", "n/a");
+        values.set("MOVIE.VOTES", "n/a");
     }
 
-    m.replace("{{ MOVIE.RUNTIME }}", QString::number(movie->runtime().count(), 'f', 0));
-    m.replace("{{ MOVIE.PLAY_COUNT }}", QString::number(movie->playcount(), 'f', 0));
-    m.replace("{{ MOVIE.LAST_PLAYED }}",
-        movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace(
-        "{{ MOVIE.DATE_ADDED }}", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILE_LAST_MODIFIED }}",
+    values.set("MOVIE.RUNTIME", QString::number(movie->runtime().count(), 'f', 0));
+    values.set("MOVIE.PLAY_COUNT", QString::number(movie->playcount(), 'f', 0));
+    values.set(
+        "MOVIE.LAST_PLAYED", movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
+    values.set(
+        "MOVIE.DATE_ADDED", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
+    values.set("MOVIE.FILE_LAST_MODIFIED",
         movie->fileLastModified().isValid() ? movie->fileLastModified().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILENAME }}", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
+    values.set("MOVIE.FILENAME", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
     if (!movie->files().isEmpty()) {
         QFileInfo fi(movie->files().first().toString());
-        m.replace("{{ MOVIE.DIR }}", fi.absolutePath());
+        values.set("MOVIE.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ MOVIE.DIR }}", "");
+        values.set("MOVIE.DIR", "");
     }
 
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", movie->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", movie->genres());
-    replaceSingleBlock(m, "COUNTRIES", "COUNTRY.NAME", movie->countries());
-    replaceSingleBlock(m, "STUDIOS", "STUDIO.NAME", movie->studios());
+    addSingleBlock(values, "TAGS", "TAG.NAME", movie->tags());
+    addSingleBlock(values, "GENRES", "GENRE.NAME", movie->genres());
+    addSingleBlock(values, "COUNTRIES", "COUNTRY.NAME", movie->countries());
+    addSingleBlock(values, "STUDIOS", "STUDIO.NAME", movie->studios());
 
     QStringList actorNames;
     QStringList actorRoles;
@@ -159,124 +265,108 @@ void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
         actorNames << actor->name;
         actorRoles << actor->role;
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, QVector<QStringList>() << actorNames << actorRoles);
+    addMultiBlock(values, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, QVector<QStringList>() << actorNames << actorRoles);
 
-    replaceStreamDetailsVars(m, movie->streamDetails());
-    replaceImages(m, subDir, movie, nullptr, nullptr, nullptr);
+    addStreamDetailsVars(values, movie->streamDetails());
 }
 
 void SimpleEngine::exportConcerts(QVector<Concert*> concerts)
 {
     std::sort(concerts.begin(), concerts.end(), Concert::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Concerts);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Concert);
-
-    QString listConcertItem;
-    QString listConcertBlock;
-    QStringList concertList;
-    QRegExp rx(R"(\{\{ BEGIN_BLOCK_CONCERT \}\}(.*)\{\{ END_BLOCK_CONCERT \}\})");
-    rx.setMinimal(true);
-
-    int pos = 0;
-    while ((pos = rx.indexIn(listContent, pos)) != -1) {
-        pos += rx.matchedLength();
+    const CompiledTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Concerts));
+    const CompiledTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Concert));
 
-        listConcertBlock = rx.cap(0);
-        listConcertItem = rx.cap(1).trimmed();
+    CompiledTemplate listBefore;
+    CompiledTemplate listConcertItem;
+    CompiledTemplate listAfter;
+    if (!listTemplate.splitAtBlock("CONCERT", listBefore, listConcertItem, listAfter)) {
+        listBefore = listTemplate;
     }
 
     m_dir.mkdir("concerts");
     m_dir.mkdir("concert_images");
 
-    for (const Concert* concert : concerts) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
+    QFile listFile(m_dir.path() + "/concerts.html");
+    if (!listFile.open(QFile::WriteOnly | QFile::Text)) {
+        qWarning() << "[Export][SimpleEngine] Cannot write file:" << listFile.fileName();
+    }
+    writeListPage(listFile, listBefore);
 
-        QString concertTemplate = itemContent;
-        replaceVars(concertTemplate, concert, true);
-        QFile file(m_dir.path() + QString("/concerts/%1.html").arg(concert->concertId()));
-        if (file.open(QFile::WriteOnly | QFile::Text)) {
-            file.write(concertTemplate.toUtf8());
-            file.close();
-        }
+    exportInBatches<Concert>(
+        concerts,
+        [&](Concert* concert) {
+            TemplateValues values;
+            addVars(values, concert);
 
-        QString c = listConcertItem;
-        replaceVars(c, concert);
-        concertList << c;
-        emit sigItemExported();
-        QApplication::processEvents();
-    }
+            const QString content = itemTemplate.render(values, [&](const QString& type, const QSize& size) {
+                return resolveImage(type, size, true, nullptr, concert, nullptr, nullptr);
+            });
+            queuePage(m_dir.path() + QString("/concerts/%1.html").arg(concert->concertId()), content);
 
-    listContent.replace(listConcertBlock, concertList.join("\n"));
+            return listConcertItem.render(values, [&](const QString& type, const QSize& size) {
+                return resolveImage(type, size, false, nullptr, concert, nullptr, nullptr);
+            });
+        },
+        listFile);
 
-    QFile file(m_dir.path() + "/concerts.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (m_cancelFlag.load()) {
+        return;
     }
+    writeListPage(listFile, listAfter);
 }
 
-void SimpleEngine::replaceVars(QString& m, const Concert* concert, bool subDir)
+void SimpleEngine::addVars(TemplateValues& values, const Concert* concert)
 {
-    m.replace("{{ CONCERT.ID }}", QString::number(concert->concertId(), 'f', 0));
-    m.replace("{{ CONCERT.LINK }}", QString("concerts/%1.html").arg(concert->concertId()));
-    m.replace("{{ CONCERT.TITLE }}", concert->name().toHtmlEscaped());
-    m.replace("{{ CONCERT.ARTIST }}", concert->artist().toHtmlEscaped());
-    m.replace("{{ CONCERT.ALBUM }}", concert->album().toHtmlEscaped());
-    m.replace("{{ CONCERT.TAGLINE }}", concert->tagline().toHtmlEscaped());
+    values.set("CONCERT.ID", QString::number(concert->concertId(), 'f', 0));
+    values.set("CONCERT.LINK", QString("concerts/%1.html").arg(concert->concertId()));
+    values.set("CONCERT.TITLE", concert->name().toHtmlEscaped());
+    values.set("CONCERT.ARTIST", concert->artist().toHtmlEscaped());
+    values.set("CONCERT.ALBUM", concert->album().toHtmlEscaped());
+    values.set("CONCERT.TAGLINE", concert->tagline().toHtmlEscaped());
 
     if (concert->ratings().isEmpty()) {
-        m.replace("{{ CONCERT.RATING }}", "n/a");
+        values.set("CONCERT.RATING", "n/a");
     } else {
-        m.replace("{{ CONCERT.RATING }}", QString::number(concert->ratings().first().rating, 'f', 1));
+        values.set("CONCERT.RATING", QString::number(concert->ratings().first().rating, 'f', 1));
     }
 
-    m.replace("{{ CONCERT.YEAR }}", concert->released().isValid() ? concert->released().toString("yyyy") : "");
-    m.replace("{{ CONCERT.RUNTIME }}", QString::number(concert->runtime().count(), 'f', 0));
-    m.replace("{{ CONCERT.CERTIFICATION }}", concert->certification().toString().toHtmlEscaped());
-    m.replace("{{ CONCERT.TRAILER }}", concert->trailer().toString());
-    m.replace("{{ CONCERT.PLAY_COUNT }}", QString::number(concert->playcount(), 'f', 0));
-    m.replace("{{ CONCERT.LAST_PLAYED }}",
+    values.set("CONCERT.YEAR", concert->released().isValid() ? concert->released().toString("yyyy") : "");
+    values.set("CONCERT.RUNTIME", QString::number(concert->runtime().count(), 'f', 0));
+    values.set("CONCERT.CERTIFICATION", concert->certification().toString().toHtmlEscaped());
+    values.set("CONCERT.TRAILER", concert->trailer().toString());
+    values.set("CONCERT.PLAY_COUNT", QString::number(concert->playcount(), 'f', 0));
+    values.set("CONCERT.LAST_PLAYED",
         concert->lastPlayed().isValid() ? concert->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
 
-    m.replace("{{ CONCERT.FILENAME }}", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
+    values.set("CONCERT.FILENAME", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
     if (!concert->files().isEmpty()) {
         QFileInfo fi(concert->files().first().toString());
-        m.replace("{{ CONCERT.DIR }}", fi.absolutePath());
+        values.set("CONCERT.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ CONCERT.DIR }}", "");
+        values.set("CONCERT.DIR", "");
     }
 
-    m.replace("{{ CONCERT.PLOT }}", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ CONCERT.TAGS }}", concert->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ CONCERT.GENRES }}", concert->genres().join(", ").toHtmlEscaped());
+    values.set("CONCERT.PLOT", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("CONCERT.TAGS", concert->tags().join(", ").toHtmlEscaped());
+    values.set("CONCERT.GENRES", concert->genres().join(", ").toHtmlEscaped());
 
-    replaceStreamDetailsVars(m, concert->streamDetails());
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", concert->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", concert->genres());
-    replaceImages(m, subDir, nullptr, concert, nullptr, nullptr);
+    addStreamDetailsVars(values, concert->streamDetails());
+    addSingleBlock(values, "TAGS", "TAG.NAME", concert->tags());
+    addSingleBlock(values, "GENRES", "GENRE.NAME", concert->genres());
 }
 
 void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
 {
     std::sort(shows.begin(), shows.end(), TvShow::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShows);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShow);
-    QString episodeContent = m_template->getTemplate(ExportTemplate::ExportSection::Episode);
-
-    QString listTvShowItem;
-    QString listTvShowBlock;
-    QStringList tvShowList;
-    QRegExp rx(R"(\{\{ BEGIN_BLOCK_TVSHOW \}\}(.*)\{\{ END_BLOCK_TVSHOW \}\})");
-    rx.setMinimal(true);
+    const CompiledTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::TvShows));
+    const CompiledTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::TvShow));
+    const CompiledTemplate episodeTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Episode));
 
-    int pos = 0;
-    while ((pos = rx.indexIn(listContent, pos)) != -1) {
-        pos += rx.matchedLength();
-
-        listTvShowBlock = rx.cap(0);
-        listTvShowItem = rx.cap(1).trimmed();
+    CompiledTemplate listBefore;
+    CompiledTemplate listTvShowItem;
+    CompiledTemplate listAfter;
+    if (!listTemplate.splitAtBlock("TVSHOW", listBefore, listTvShowItem, listAfter)) {
+        listBefore = listTemplate;
     }
 
     m_dir.mkdir("tvshows");
@@ -284,83 +374,90 @@ void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
     m_dir.mkdir("episodes");
     m_dir.mkdir("episode_images");
 
-    for (TvShow* show : shows) {
-        if (m_cancelFlag.load()) {
-            return;
-        }
-
-        // tvshow.html - Single TV show
-        {
-            QString showTemplate = itemContent;
-            replaceVars(showTemplate, show, true);
-            QFile file(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(showTemplate.toUtf8());
-                file.close();
+    QFile listFile(m_dir.path() + "/tvshows.html");
+    if (!listFile.open(QFile::WriteOnly | QFile::Text)) {
+        qWarning() << "[Export][SimpleEngine] Cannot write file:" << listFile.fileName();
+    }
+    writeListPage(listFile, listBefore);
+
+    // tvshow.html - Single TV show
+    // tvshows.html - All TV shows listed
+    exportInBatches<TvShow>(
+        shows,
+        [&](TvShow* show) {
+            TemplateValues values;
+            addVars(values, show);
+
+            {
+                TemplateValues showValues = values;
+                addSeasons(showValues, itemTemplate, show, true);
+                const QString content = itemTemplate.render(showValues, [&](const QString& type, const QSize& size) {
+                    return resolveImage(type, size, true, nullptr, nullptr, show, nullptr);
+                });
+                queuePage(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()), content);
             }
-            QApplication::processEvents();
-        }
 
-        // tvshows.html - All TV shows listed
-        {
-            QString showBlock = listTvShowItem;
-            replaceVars(showBlock, show, false);
-            tvShowList << showBlock;
-            emit sigItemExported();
-            QApplication::processEvents();
-        }
+            addSeasons(values, listTvShowItem, show, false);
+            return listTvShowItem.render(values, [&](const QString& type, const QSize& size) {
+                return resolveImage(type, size, false, nullptr, nullptr, show, nullptr);
+            });
+        },
+        listFile);
+
+    if (m_cancelFlag.load()) {
+        return;
+    }
+    writeListPage(listFile, listAfter);
 
-        // episode.html - Single episode
+    // episode.html - Single episode
+    QVector<TvShowEpisode*> episodes;
+    for (TvShow* show : shows) {
         for (TvShowEpisode* episode : show->episodes()) {
-            if (episode->isDummy()) {
-                continue;
-            }
-            QString episodeTemplate = episodeContent;
-            replaceVars(episodeTemplate, episode, true);
-            QFile file(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(episodeTemplate.toUtf8());
-                file.close();
+            if (!episode->isDummy()) {
+                episodes << episode;
             }
-            emit sigItemExported();
-            QApplication::processEvents();
         }
     }
 
-    listContent.replace(listTvShowBlock, tvShowList.join("\n"));
-
-    QFile file(m_dir.path() + "/tvshows.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
-    }
+    QFile noListFile;
+    exportInBatches<TvShowEpisode>(
+        episodes,
+        [&](TvShowEpisode* episode) {
+            TemplateValues values;
+            addVars(values, episode);
+            const QString content = episodeTemplate.render(values, [&](const QString& type, const QSize& size) {
+                return resolveImage(type, size, true, nullptr, nullptr, nullptr, episode);
+            });
+            queuePage(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()), content);
+            return QString();
+        },
+        noListFile);
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
+void SimpleEngine::addVars(TemplateValues& values, const TvShow* show)
 {
-    m.replace("{{ TVSHOW.ID }}", QString::number(show->showId(), 'f', 0));
-    m.replace("{{ TVSHOW.LINK }}", QString("tvshows/%1.html").arg(show->showId()));
-    m.replace("{{ TVSHOW.IMDB_ID }}", show->imdbId().toString());
-    m.replace("{{ TVSHOW.TITLE }}", show->title().toHtmlEscaped());
+    values.set("TVSHOW.ID", QString::number(show->showId(), 'f', 0));
+    values.set("TVSHOW.LINK", QString("tvshows/%1.html").arg(show->showId()));
+    values.set("TVSHOW.IMDB_ID", show->imdbId().toString());
+    values.set("TVSHOW.TITLE", show->title().toHtmlEscaped());
 
     // @todo multiple ratings
     if (!show->ratings().isEmpty()) {
         double rating = show->ratings().front().rating;
         int voteCount = show->ratings().front().voteCount;
-        m.replace("{{ TVSHOW.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ TVSHOW.VOTES }}", QString::number(voteCount, 'f', 0));
+        values.set("TVSHOW.RATING", QString::number(rating, 'f', 1));
+        values.set("TVSHOW.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ TVSHOW.RATING }}", "n/a");
-        m.replace("{{ TVSHOW.VOTES }}", "n/a");
+        values.set("TVSHOW.RATING", "n/a");
+        values.set("TVSHOW.VOTES", "n/a");
     }
 
-    m.replace("{{ TVSHOW.CERTIFICATION }}", show->certification().toString().toHtmlEscaped());
-    m.replace(
-        "{{ TVSHOW.FIRST_AIRED }}", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ TVSHOW.STUDIO }}", show->network().toHtmlEscaped());
-    m.replace("{{ TVSHOW.PLOT }}", show->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ TVSHOW.TAGS }}", show->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.GENRES }}", show->genres().join(", ").toHtmlEscaped());
+    values.set("TVSHOW.CERTIFICATION", show->certification().toString().toHtmlEscaped());
+    values.set("TVSHOW.FIRST_AIRED", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
+    values.set("TVSHOW.STUDIO", show->network().toHtmlEscaped());
+    values.set("TVSHOW.PLOT", show->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("TVSHOW.TAGS", show->tags().join(", ").toHtmlEscaped());
+    values.set("TVSHOW.GENRES", show->genres().join(", ").toHtmlEscaped());
 
     QStringList actorNames;
     QStringList actorRoles;
@@ -368,103 +465,88 @@ void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
         actorNames << actor->name;
         actorRoles << actor->role;
     }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles});
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", show->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", show->genres());
-
-    QString listSeasonItem;
-    QString listSeasonBlock;
-    QStringList seasonList;
-    QRegExp rx;
-    rx.setMinimal(true);
-    rx.setPattern(R"(\{\{ BEGIN_BLOCK_SEASON \}\}(.*)\{\{ END_BLOCK_SEASON \}\})");
-
-    for (int pos = 0; (pos = rx.indexIn(m, pos)) != -1;) {
-        pos += rx.matchedLength();
-
-        listSeasonBlock = rx.cap(0);
-        listSeasonItem = rx.cap(1).trimmed();
-    }
+    addMultiBlock(values, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles});
+    addSingleBlock(values, "TAGS", "TAG.NAME", show->tags());
+    addSingleBlock(values, "GENRES", "GENRE.NAME", show->genres());
+}
 
-    if (listSeasonBlock.isEmpty() || listSeasonItem.isEmpty()) {
-        replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
+void SimpleEngine::addSeasons(TemplateValues& values,
+    const CompiledTemplate& showTemplate,
+    const TvShow* show,
+    bool subDir)
+{
+    const CompiledTemplate* seasonTemplate = showTemplate.block("SEASON");
+    if (seasonTemplate == nullptr || seasonTemplate->isEmpty()) {
         return;
     }
+    const CompiledTemplate* episodeTemplate = seasonTemplate->block("EPISODE");
 
     QVector<SeasonNumber> seasons = show->seasons(false);
     std::sort(seasons.begin(), seasons.end());
+    QStringList seasonList;
     for (const SeasonNumber& season : seasons) {
-        QVector<TvShowEpisode*> episodes = show->episodes(season);
-        std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
-        QString s = listSeasonItem;
-        s.replace("{{ SEASON }}", season.toString());
+        TemplateValues seasonValues = values;
+        seasonValues.set("SEASON", season.toString());
 
-        QString listEpisodeItem;
-        QString listEpisodeBlock;
         QStringList episodeList;
-        rx.setPattern(R"(\{\{ BEGIN_BLOCK_EPISODE \}\}(.*)\{\{ END_BLOCK_EPISODE \}\})");
-
-        for (int pos = 0; (pos = rx.indexIn(s, pos)) != -1;) {
-            pos += rx.matchedLength();
-
-            listEpisodeBlock = rx.cap(0);
-            listEpisodeItem = rx.cap(1).trimmed();
-        }
-
-        if (!listEpisodeItem.isEmpty()) {
-            for (TvShowEpisode* episode : episodes) {
-                QString e = listEpisodeItem;
-                replaceVars(e, episode, subDir);
-                episodeList << e;
+        if (episodeTemplate != nullptr && !episodeTemplate->isEmpty()) {
+            QVector<TvShowEpisode*> episodes = show->episodes(season);
+            std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
+            for (const TvShowEpisode* episode : episodes) {
+                TemplateValues episodeValues = seasonValues;
+                addVars(episodeValues, episode);
+                episodeList << episodeTemplate->render(episodeValues, [&](const QString& type, const QSize& size) {
+                    return resolveImage(type, size, subDir, nullptr, nullptr, nullptr, episode);
+                });
             }
         }
-        s.replace(listEpisodeBlock, episodeList.join("\n"));
-        seasonList << s;
+        seasonValues.setRenderedBlock("EPISODE", episodeList.join("\n"));
+        seasonList << seasonTemplate->render(seasonValues, [&](const QString& type, const QSize& size) {
+            return resolveImage(type, size, subDir, nullptr, nullptr, show, nullptr);
+        });
     }
 
-    m.replace(listSeasonBlock, seasonList.join("\n"));
-    replaceImages(m, subDir, nullptr, nullptr, show, nullptr);
+    values.setRenderedBlock("SEASON", seasonList.join("\n"));
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShowEpisode* episode, bool subDir)
+void SimpleEngine::addVars(TemplateValues& values, const TvShowEpisode* episode)
 {
-    m.replace("{{ SHOW.TITLE }}", episode->tvShow()->title().toHtmlEscaped());
-    m.replace("{{ SHOW.LINK }}", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
-    m.replace("{{ EPISODE.LINK }}", QString("../episodes/%1.html").arg(episode->episodeId()));
-    m.replace("{{ EPISODE.TITLE }}", episode->title().toHtmlEscaped());
-    m.replace("{{ EPISODE.SEASON }}", episode->seasonString().toHtmlEscaped());
-    m.replace("{{ EPISODE.EPISODE }}", episode->episodeString().toHtmlEscaped());
+    values.set("SHOW.TITLE", episode->tvShow()->title().toHtmlEscaped());
+    values.set("SHOW.LINK", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
+    values.set("EPISODE.LINK", QString("../episodes/%1.html").arg(episode->episodeId()));
+    values.set("EPISODE.TITLE", episode->title().toHtmlEscaped());
+    values.set("EPISODE.SEASON", episode->seasonString().toHtmlEscaped());
+    values.set("EPISODE.EPISODE", episode->episodeString().toHtmlEscaped());
     if (episode->ratings().isEmpty()) {
-        m.replace("{{ EPISODE.RATING }}", "n/a");
+        values.set("EPISODE.RATING", "n/a");
     } else {
-        m.replace("{{ EPISODE.RATING }}", QString::number(episode->ratings().first().rating, 'f', 1));
+        values.set("EPISODE.RATING", QString::number(episode->ratings().first().rating, 'f', 1));
     }
-    m.replace("{{ EPISODE.CERTIFICATION }}", episode->certification().toString().toHtmlEscaped());
-    m.replace("{{ EPISODE.FIRST_AIRED }}",
-        episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ EPISODE.LAST_PLAYED }}",
+    values.set("EPISODE.CERTIFICATION", episode->certification().toString().toHtmlEscaped());
+    values.set(
+        "EPISODE.FIRST_AIRED", episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
+    values.set("EPISODE.LAST_PLAYED",
         episode->lastPlayed().isValid() ? episode->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ EPISODE.STUDIO }}", episode->network().toHtmlEscaped());
-    m.replace("{{ EPISODE.PLOT }}", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ EPISODE.WRITERS }}", episode->writers().join(", ").toHtmlEscaped());
-    m.replace("{{ EPISODE.DIRECTORS }}", episode->directors().join(", ").toHtmlEscaped());
-
-    replaceStreamDetailsVars(m, episode->streamDetails());
-    replaceSingleBlock(m, "WRITERS", "WRITER.NAME", episode->writers());
-    replaceSingleBlock(m, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
-    replaceImages(m, subDir, nullptr, nullptr, nullptr, episode);
+    values.set("EPISODE.STUDIO", episode->network().toHtmlEscaped());
+    values.set("EPISODE.PLOT", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
+    values.set("EPISODE.WRITERS", episode->writers().join(", ").toHtmlEscaped());
+    values.set("EPISODE.DIRECTORS", episode->directors().join(", ").toHtmlEscaped());
+
+    addStreamDetailsVars(values, episode->streamDetails());
+    addSingleBlock(values, "WRITERS", "WRITER.NAME", episode->writers());
+    addSingleBlock(values, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
 }
 
-void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* details)
+void SimpleEngine::addStreamDetailsVars(TemplateValues& values, const StreamDetails* details)
 {
     const auto videoDetails = (details != nullptr) ? details->videoDetails() : decltype(details->videoDetails()){};
     const auto audioDetails = (details != nullptr) ? details->audioDetails() : decltype(details->audioDetails()){};
 
-    m.replace("{{ FILEINFO.WIDTH }}", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
-    m.replace("{{ FILEINFO.HEIGHT }}", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
-    m.replace("{{ FILEINFO.ASPECT }}", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
-    m.replace("{{ FILEINFO.CODEC }}", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
-    m.replace("{{ FILEINFO.DURATION }}", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
+    values.set("FILEINFO.WIDTH", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
+    values.set("FILEINFO.HEIGHT", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
+    values.set("FILEINFO.ASPECT", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
+    values.set("FILEINFO.CODEC", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
+    values.set("FILEINFO.DURATION", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
 
     QStringList audioCodecs;
     QStringList audioChannels;
@@ -474,9 +556,9 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
         audioChannels << audioDetails.at(i).value(StreamDetails::AudioDetails::Channels);
         audioLanguages << audioDetails.at(i).value(StreamDetails::AudioDetails::Language);
     }
-    m.replace("{{ FILEINFO.AUDIO.CODEC }}", audioCodecs.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.CHANNELS }}", audioChannels.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.LANGUAGE }}", audioLanguages.join("|"));
+    values.set("FILEINFO.AUDIO.CODEC", audioCodecs.join("|"));
+    values.set("FILEINFO.AUDIO.CHANNELS", audioChannels.join("|"));
+    values.set("FILEINFO.AUDIO.LANGUAGE", audioLanguages.join("|"));
 
     QStringList subtitleLanguages;
     if (details != nullptr) {
@@ -484,114 +566,68 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
             subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
         }
     }
-    m.replace("{{ FILEINFO.SUBTITLES.LANGUAGE }}", subtitleLanguages.join("|"));
+    values.set("FILEINFO.SUBTITLES.LANGUAGE", subtitleLanguages.join("|"));
 }
 
-void SimpleEngine::replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces)
+void SimpleEngine::addSingleBlock(TemplateValues& values, QString blockName, QString itemName, QStringList replaces)
 {
-    replaceMultiBlock(m, blockName, QStringList() << itemName, QVector<QStringList>() << replaces);
+    addMultiBlock(values, blockName, QStringList() << itemName, QVector<QStringList>() << replaces);
 }
 
-void SimpleEngine::replaceMultiBlock(QString& m,
+void SimpleEngine::addMultiBlock(TemplateValues& values,
     QString blockName,
     QStringList itemNames,
     QVector<QStringList> replaces)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
-    rx.setPattern("\\{\\{ BEGIN_BLOCK_" + blockName + R"( \}\}(.*)\{\{ END_BLOCK_)" + blockName + " \\}\\}");
-    if (rx.indexIn(m) != -1) {
-        QString block = rx.cap(0);
-        QString item = rx.cap(1).trimmed();
-        QStringList list;
-        for (int i = 0, n = replaces.at(0).count(); i < n; ++i) {
-            QString subItem = item;
-            for (int x = 0, y = itemNames.count(); x < y; ++x) {
-                subItem.replace("{{ " + itemNames.at(x) + " }}", replaces.at(x).at(i).toHtmlEscaped());
-            }
-            list << subItem;
+    QVector<TemplateValues::Variables> items;
+    for (int i = 0, n = replaces.at(0).count(); i < n; ++i) {
+        TemplateValues::Variables item;
+        for (int x = 0, y = itemNames.count(); x < y; ++x) {
+            item.insert(itemNames.at(x), replaces.at(x).at(i).toHtmlEscaped());
         }
-        m.replace(block, list.join(" "));
-    }
-}
-
-void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality)
-{
-    Q_UNUSED(format)
-    Q_UNUSED(quality)
-
-    QImage img(imageFile);
-    if (img.isNull()) {
-        qWarning() << "[Export][SimpleEngine] Cannot load image:" << imageFile;
-        return;
-    }
-
-    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-
-    if (!img.isNull()) {
-        img.save(destinationFile);
-    } else {
-        qWarning() << "[Export][SimpleEngine] Could not scale (result was empty):" << imageFile;
+        items << item;
     }
+    values.setBlock(blockName, items, " ");
 }
 
-void SimpleEngine::replaceImages(QString& m,
-    const bool& subDir,
+QString SimpleEngine::resolveImage(const QString& type,
+    const QSize& size,
+    bool subDir,
     const Movie* movie,
     const Concert* concert,
     const TvShow* tvShow,
     const TvShowEpisode* episode)
 {
-    QString item;
-    QSize size;
-    QRegExp rx(R"(\{\{ IMAGE.(.*)\[(\d*), ?(\d*)\] \}\})");
-    rx.setMinimal(true);
-    int pos = 0;
-    while (rx.indexIn(m, pos) != -1) {
-        item = rx.cap(0);
-        QString type = rx.cap(1).toLower();
-        size.setWidth(rx.cap(2).toInt());
-        size.setHeight(rx.cap(3).toInt());
-
-        pos += rx.matchedLength();
-
-        if (item.isEmpty() || size.isEmpty()) {
-            continue;
-        }
+    QString destFile;
+    bool imageSaved = false;
+    bool isPlaceholderUsed = true;
+    QString typeName;
+    if (movie != nullptr) {
+        imageSaved = saveImageForType(type, size, destFile, movie, &isPlaceholderUsed);
+        typeName = "movie";
 
-        QString destFile;
-        bool imageSaved = false;
-        bool isPlaceholderUsed = true;
-        QString typeName;
-        if (movie != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, movie, &isPlaceholderUsed);
-            typeName = "movie";
-
-        } else if (concert != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, concert, &isPlaceholderUsed);
-            typeName = "concert";
-
-        } else if (tvShow != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, tvShow, &isPlaceholderUsed);
-            typeName = "tvshow";
-
-        } else if (episode != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, episode, &isPlaceholderUsed);
-            typeName = "episode";
-        }
+    } else if (concert != nullptr) {
+        imageSaved = saveImageForType(type, size, destFile, concert, &isPlaceholderUsed);
+        typeName = "concert";
 
-        if (!isPlaceholderUsed) {
-            continue;
-        }
+    } else if (tvShow != nullptr) {
+        imageSaved = saveImageForType(type, size, destFile, tvShow, &isPlaceholderUsed);
+        typeName = "tvshow";
 
-        if (imageSaved) {
-            m.replace(item, (subDir ? "../" : "") + destFile);
-        } else {
-            m.replace(item,
-                (subDir ? "../" : "")
-                    + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height()));
-        }
+    } else if (episode != nullptr) {
+        imageSaved = saveImageForType(type, size, destFile, episode, &isPlaceholderUsed);
+        typeName = "episode";
+    }
+
+    if (!isPlaceholderUsed) {
+        return QString();
+    }
+
+    if (imageSaved) {
+        return (subDir ? "../" : "") + destFile;
     }
+    return (subDir ? "../" : "")
+           + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height());
 }
 
 bool SimpleEngine::saveImageForType(const QString& type,
@@ -636,8 +672,7 @@ bool SimpleEngine::saveImageForType(const QString& type,
         return false;
     }
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
+    queueImage(size, filename, m_dir.path() + "/" + destFile);
 
     return true;
 }
@@ -684,8 +719,7 @@ bool SimpleEngine::saveImageForType(const QString& type,
         return false;
     }
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
+    queueImage(size, filename, m_dir.path() + "/" + destFile);
 
     return true;
 }
@@ -734,8 +768,7 @@ bool SimpleEngine::saveImageForType(const QString& type,
         return false;
     }
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
+    queueImage(size, filename, m_dir.path() + "/" + destFile);
 
     return true;
 }
@@ -756,7 +789,7 @@ bool SimpleEngine::saveImageForType(const QString& type,
         if (filename.isEmpty()) {
             return false;
         }
-        saveImage(size, filename, m_dir.path() + "/" + destFile, "jpg", 90);
+        queueImage(size, filename, m_dir.path() + "/" + destFile);
     } else {
         *isPlaceHolderUsed = false;
         return false;
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "export/CompiledTemplate.h"
 #include "export/ExportTemplate.h"
 
 #include <QDir>
+#include <QFile>
 #include <QObject>
+#include <QSet>
+#include <QSize>
 #include <atomic>
+#include <functional>
 
 class Concert;
 class Movie;
@@ -16,6 +21,10 @@ namespace mediaelch {
 
 /// Default export engine for MediaElch. Simple find&replace semantics,
 /// only basic functionality (e.g. condintional block)
+///
+/// Templates are compiled once per export. Items are rendered on the GUI thread in
+/// batches; their pages and images are written on the global thread pool and
+/// list pages are written to disk item by item.
 class SimpleEngine : public QObject
 {
     Q_OBJECT
@@ -36,9 +45,31 @@ public:
     void exportTvShows(QVector<TvShow*> shows);
 
 private:
-    void saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality);
-    void replaceImages(QString& m,
-        const bool& subDir,
+    /// A page or image that was queued while rendering the current batch.
+    struct QueuedFile
+    {
+        QString destination;
+        /// Content of a page; empty for images.
+        QString content;
+        /// Image that is scaled to imageSize; empty for pages.
+        QString imageSource;
+        QSize imageSize;
+    };
+
+    /// Renders all items in batches and streams the result of renderItem (an entry of the
+    /// list page) to listFile in the order of items.  renderItem runs on the GUI thread,
+    /// because media objects must not be read while the GUI keeps processing events.  The
+    /// pages and images it queues are written on the global thread pool.
+    template<class T>
+    void exportInBatches(const QVector<T*>& items, std::function<QString(T*)> renderItem, QFile& listFile);
+    void queuePage(const QString& fileName, const QString& content);
+    void queueImage(QSize size, QString imageFile, QString destinationFile);
+    void writeQueuedFile(const QueuedFile& file) const;
+    void writeListPage(QFile& listFile, const CompiledTemplate& listTemplate);
+
+    QString resolveImage(const QString& type,
+        const QSize& size,
+        bool subDir,
         const Movie* movie,
         const Concert* concert,
         const TvShow* tvShow,
@@ -63,18 +94,22 @@ private:
         QString& destFile,
         const TvShowEpisode* episode,
         bool* isPlaceHolderUsed);
-    void replaceVars(QString& m, Movie* movie, bool subDir = false);
-    void replaceVars(QString& m, const Concert* concert, bool subDir = false);
-    void replaceVars(QString& m, const TvShow* show, bool subDir = false);
-    void replaceVars(QString& m, const TvShowEpisode* episode, bool subDir = false);
-    void replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces);
-    void replaceMultiBlock(QString& m, QString blockName, QStringList itemNames, QVector<QStringList> replaces);
-    void replaceStreamDetailsVars(QString& m, const StreamDetails* details);
+    void addVars(TemplateValues& values, Movie* movie);
+    void addVars(TemplateValues& values, const Concert* concert);
+    void addVars(TemplateValues& values, const TvShow* show);
+    void addVars(TemplateValues& values, const TvShowEpisode* episode);
+    void addSeasons(TemplateValues& values, const CompiledTemplate& showTemplate, const TvShow* show, bool subDir);
+    void addSingleBlock(TemplateValues& values, QString blockName, QString itemName, QStringList replaces);
+    void addMultiBlock(TemplateValues& values, QString blockName, QStringList itemNames, QVector<QStringList> replaces);
+    void addStreamDetailsVars(TemplateValues& values, const StreamDetails* details);
 
 private:
     std::atomic_bool& m_cancelFlag;
     ExportTemplate* m_template = nullptr;
     QDir m_dir;
+    /// Images that were already queued during this export.
+    QSet<QString> m_savedImages;
+    QVector<QueuedFile> m_queuedFiles;
 };
 
 } // namespace mediaelch
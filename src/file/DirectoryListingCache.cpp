@@ -0,0 +1,173 @@
+#include "file/DirectoryListingCache.h"
+
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+namespace mediaelch {
+
+DirectoryListingCache& DirectoryListingCache::instance()
+{
+    static DirectoryListingCache cache;
+    return cache;
+}
+
+bool DirectoryListingCache::isFile(const QString& filePath)
+{
+    if (filePath.isEmpty()) {
+        return false;
+    }
+    const QFileInfo fi(QDir::cleanPath(filePath));
+    return isFile(DirectoryPath(fi.absolutePath()), fi.fileName());
+}
+
+bool DirectoryListingCache::isFile(const DirectoryPath& dir, const QString& fileName)
+{
+    if (!dir.isValid() || fileName.isEmpty()) {
+        return false;
+    }
+    if (fileName.contains('/')) {
+        // e.g. "extrafanart/fanart1.jpg"
+        return isFile(dir.filePath(fileName));
+    }
+    return listing(dir.toString())->files.contains(lookupKey(fileName));
+}
+
+QStringList DirectoryListingCache::files(const DirectoryPath& dir,
+    const QStringList& nameFilters,
+    QDir::Filters filters,
+    QDir::SortFlags sort)
+{
+    if (!dir.isValid()) {
+        return {};
+    }
+
+    QStringList names;
+    for (const Entry& entry : listing(dir.toString())->entries) {
+        const bool typeMatches = entry.isFile ? filters.testFlag(QDir::Files) : filters.testFlag(QDir::System);
+        if (!typeMatches || (entry.isHidden && !filters.testFlag(QDir::Hidden))) {
+            continue;
+        }
+        if (nameFilters.isEmpty() || QDir::match(nameFilters, entry.name)) {
+            names << entry.name;
+        }
+    }
+
+    const Qt::CaseSensitivity cs = sort.testFlag(QDir::IgnoreCase) ? Qt::CaseInsensitive : Qt::CaseSensitive;
+    std::sort(names.begin(), names.end(), [cs](const QString& lhs, const QString& rhs) {
+        return QString::compare(lhs, rhs, cs) < 0;
+    });
+    return names;
+}
+
+void DirectoryListingCache::invalidate(const DirectoryPath& dir)
+{
+    QMutexLocker locker(&m_mutex);
+    m_listings.remove(dir.toString());
+    ++m_generation;
+    if (!m_readingGenerations.isEmpty()) {
+        m_invalidatedGenerations.insert(dir.toString(), m_generation);
+    }
+}
+
+void DirectoryListingCache::invalidateFileDir(const QString& filePath)
+{
+    invalidate(DirectoryPath(QFileInfo(QDir::cleanPath(filePath)).absolutePath()));
+}
+
+void DirectoryListingCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_listings.clear();
+    m_invalidatedGenerations.clear();
+    m_clearedGeneration = ++m_generation;
+}
+
+int DirectoryListingCache::cachedDirectories()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_listings.size();
+}
+
+std::shared_ptr<const DirectoryListingCache::Listing> DirectoryListingCache::listing(const QString& dirPath)
+{
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto cached = m_listings.constFind(dirPath);
+        if (cached != m_listings.constEnd() && !cached.value()->age.hasExpired(s_maxAgeMs)) {
+            return cached.value();
+        }
+        generation = m_generation;
+        ++m_readingGenerations[generation];
+    }
+
+    // Read the directory without holding the lock: other threads may use listings of other directories.
+    // If two threads read the same directory, the last one wins, which is fine.
+    std::shared_ptr<const Listing> listing = readListing(dirPath);
+    QMutexLocker locker(&m_mutex);
+    // If the directory was invalidated meanwhile, the listing may miss files that were just
+    // written.  It is still good enough for this call, but must not be cached.
+    if (m_clearedGeneration <= generation && m_invalidatedGenerations.value(dirPath, 0) <= generation) {
+        m_listings.insert(dirPath, listing);
+    }
+    if (--m_readingGenerations[generation] == 0) {
+        m_readingGenerations.remove(generation);
+        pruneInvalidations();
+    }
+    return listing;
+}
+
+void DirectoryListingCache::pruneInvalidations()
+{
+    // Invalidations up to the generation of the oldest running read can't affect any read.
+    // Without running reads, none are needed, so the hash doesn't grow with each write.
+    if (m_readingGenerations.isEmpty()) {
+        m_invalidatedGenerations.clear();
+        return;
+    }
+    const quint64 oldestRead = m_readingGenerations.firstKey();
+    for (auto it = m_invalidatedGenerations.begin(); it != m_invalidatedGenerations.end();) {
+        if (it.value() <= oldestRead) {
+            it = m_invalidatedGenerations.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::shared_ptr<const DirectoryListingCache::Listing> DirectoryListingCache::readListing(const QString& dirPath)
+{
+    auto listing = std::make_shared<Listing>();
+    listing->age.start();
+
+    // A single readdir(); for most entries, the type is known without a stat() call.
+    QDirIterator it(dirPath, QDir::Files | QDir::System | QDir::Hidden | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        Entry entry;
+        entry.name = fi.fileName();
+        entry.isFile = fi.isFile();
+        entry.isHidden = fi.isHidden();
+        if (entry.isFile) {
+            listing->files.insert(lookupKey(entry.name));
+        }
+        listing->entries.push_back(std::move(entry));
+    }
+    return listing;
+}
+
+QString DirectoryListingCache::lookupKey(const QString& fileName)
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_MAC)
+    // Same behavior as QFileInfo::isFile() on the default file systems.
+    return fileName.toLower();
+#else
+    return fileName;
+#endif
+}
+
+} // namespace mediaelch
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "file/Path.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+
+namespace mediaelch {
+
+/// \brief Caches directory listings so that file existence checks don't hit the file system.
+///
+/// Checking whether e.g. "poster.jpg", "movie-poster.jpg" or "folder.jpg" exists for each
+/// image type results in dozens of stat() calls per movie, which is slow on network shares.
+/// Instead, each directory is read once and all checks are answered from memory.
+///
+/// Listings are re-read after maxAge() and whenever MediaElch writes into the directory,
+/// see invalidate(). File searchers clear the cache when the library is reloaded.
+/// All methods are thread-safe.
+class DirectoryListingCache
+{
+public:
+    DirectoryListingCache() = default;
+    /// \brief Cache shared by all media center interfaces and file searchers.
+    static DirectoryListingCache& instance();
+
+    /// \brief Returns true if the file exists and is a file (or a link to one), like QFileInfo::isFile().
+    bool isFile(const QString& filePath);
+    bool isFile(const DirectoryPath& dir, const QString& fileName);
+
+    /// \brief Names of the entries in \p dir that match one of the wildcard \p nameFilters.
+    ///
+    /// Like QDir::entryList(): supported filters are QDir::Files, QDir::System and QDir::Hidden.
+    /// Names are sorted by name; pass QDir::IgnoreCase to sort case-insensitively.
+    QStringList files(const DirectoryPath& dir,
+        const QStringList& nameFilters,
+        QDir::Filters filters = QDir::Files,
+        QDir::SortFlags sort = QDir::Name | QDir::IgnoreCase);
+
+    /// \brief Drops the listing of \p dir. Must be called after writing into the directory.
+    void invalidate(const DirectoryPath& dir);
+    /// \brief Drops the listing of the directory that contains \p filePath.
+    void invalidateFileDir(const QString& filePath);
+    void clear();
+
+    int cachedDirectories();
+    static qint64 maxAge() { return s_maxAgeMs; }
+
+private:
+    struct Entry
+    {
+        QString name;
+        bool isFile = false;
+        bool isHidden = false;
+    };
+
+    struct Listing
+    {
+        QVector<Entry> entries;
+        /// File names (lower case on case-insensitive file systems) of all entries that are files.
+        QSet<QString> files;
+        QElapsedTimer age;
+    };
+
+    std::shared_ptr<const Listing> listing(const QString& dirPath);
+    static std::shared_ptr<const Listing> readListing(const QString& dirPath);
+    static QString lookupKey(const QString& fileName);
+    void pruneInvalidations();
+
+    /// Files added by other programs are picked up after this time.
+    static constexpr qint64 s_maxAgeMs = 30 * 1000;
+
+    QMutex m_mutex;
+    QHash<QString, std::shared_ptr<const Listing>> m_listings;
+    /// Incremented by invalidate() and clear(). Listings that were read while their
+    /// directory was invalidated are outdated and are not cached.
+    quint64 m_generation = 0;
+    quint64 m_clearedGeneration = 0;
+    /// Only needed while reads are running that started before the invalidation, see pruneInvalidations().
+    QHash<QString, quint64> m_invalidatedGenerations;
+    /// Generations at which the currently running reads started and how many reads started at each.
+    QMap<quint64, int> m_readingGenerations;
+};
+
+} // namespace mediaelch
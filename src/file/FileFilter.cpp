@@ -1,13 +1,16 @@
 #include "file/FileFilter.h"
 
+#include "file/DirectoryListingCache.h"
+
 namespace mediaelch {
 
 QStringList FileFilter::files(QDir directory) const
 {
-    if (m_filters.isEmpty() || !directory.exists()) {
+    if (m_filters.isEmpty()) {
         return {};
     }
-    return directory.entryList(m_filters, QDir::Files | QDir::System);
+    // The listing is reused by KodiXml when looking for images next to the files.
+    return DirectoryListingCache::instance().files(DirectoryPath(directory), m_filters, QDir::Files | QDir::System);
 }
 
 bool FileFilter::hasFilter() const
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "data/ArtworkStage.h"
+
 #include <QMetaType>
 #include <QString>
 #include <QVector>
@@ -9,7 +11,7 @@ struct Actor
     QString name;
     QString role;
     QString thumb;
-    QByteArray image;
+    mediaelch::StagedImage image;
     QString id;
     int order = 0; // used by Kodi NFO
     bool imageHasChanged = false;
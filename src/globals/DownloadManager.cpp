@@ -4,23 +4,51 @@
 #include <QFile>
 #include <QTimer>
 
+#include "concerts/Concert.h"
 #include "globals/DownloadManagerElement.h"
+#include "movies/Movie.h"
 #include "music/Album.h"
 #include "music/Artist.h"
+#include "network/HostTimeouts.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
+#include "network/ScrapeStats.h"
 #include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
 
 DownloadManager::DownloadManager(QObject* parent) : QObject(parent), m_downloading{false}
 {
     connect(&m_timer, &QTimer::timeout, this, &DownloadManager::downloadTimeout);
 }
 
+/// @brief Returns a request for \p url that is tagged with the item that \p download belongs to.
+QNetworkRequest DownloadManager::downloadRequest(const DownloadManagerElement& download, const QUrl& url)
+{
+    QString item;
+    if (download.movie != nullptr) {
+        item = download.movie->name();
+    } else if (download.show != nullptr) {
+        item = download.show->title();
+    } else if (download.episode != nullptr) {
+        item = download.episode->tvShow() != nullptr ? download.episode->tvShow()->title() : download.episode->title();
+    } else if (download.concert != nullptr) {
+        item = download.concert->name();
+    } else if (download.album != nullptr) {
+        item = download.album->title();
+    } else if (download.artist != nullptr) {
+        item = download.artist->name();
+    }
+
+    QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    mediaelch::network::setRequestTag(request, {QString(), item, QStringLiteral("download")});
+    return request;
+}
+
 /// @brief Returns the network access manager
 /// @return Network access manager object
 QNetworkAccessManager* DownloadManager::qnam()
 {
-    static auto* s_qnam = new QNetworkAccessManager();
-    return s_qnam;
+    return mediaelch::network::accessManager();
 }
 
 bool DownloadManager::isLocalFile(const QUrl& url) const
@@ -185,10 +213,11 @@ void DownloadManager::startNextDownload()
         return;
     }
 
-    m_timer.start(8000);
-
     m_currentDownloadElement = m_queue.dequeue();
     DownloadManagerElement download = m_currentDownloadElement;
+    // Give the first response a bit more time than later progress.
+    m_timeoutMilliseconds = mediaelch::network::HostTimeouts::instance().timeoutFor(download.url.host());
+    m_timer.start(m_timeoutMilliseconds + 2000);
 
     if (download.imageType == ImageType::Actor || download.imageType == ImageType::TvShowEpisodeThumb) {
         if (download.movie != nullptr) {
@@ -221,16 +250,25 @@ void DownloadManager::startNextDownload()
 
     if (isLocalFile(download.url)) {
         QFile file(download.url.toString());
-        QByteArray data;
-        if (file.open(QIODevice::ReadOnly)) {
-            data = file.readAll();
-            file.close();
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "[DownloadManager] Could not read" << file.fileName();
+        } else if (isStagedWhileDownloading(download)) {
+            auto staging = mediaelch::ArtworkStage::instance().beginStaging();
+            while (!file.atEnd()) {
+                const QByteArray chunk = file.read(64 * 1024);
+                if (chunk.isEmpty()) {
+                    break;
+                }
+                staging->write(chunk);
+            }
+            download.image = staging->finish();
+        } else {
+            download.data = file.readAll();
         }
-
-        download.data = data;
+        file.close();
 
         if (download.actor != nullptr && download.imageType == ImageType::Actor && (download.movie == nullptr)) {
-            download.actor->image = data;
+            download.actor->image = download.image;
 
         } else if (download.imageType == ImageType::TvShowEpisodeThumb && !download.directDownload) {
             download.episode->setThumbnailImage(data);
@@ -246,13 +284,43 @@ void DownloadManager::startNextDownload()
     } else {
         locker.relock();
         m_downloading = true;
-        QNetworkReply* reply = qnam()->get(mediaelch::network::requestWithDefaults(download.url));
+        QNetworkReply* reply = qnam()->get(downloadRequest(download, download.url));
         m_currentReply = reply;
         locker.unlock();
+        mediaelch::network::HostTimeouts::instance().watch(reply);
+        connectReply(reply, download);
+    }
+}
 
-        connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
-        connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
+bool DownloadManager::isStagedWhileDownloading(const DownloadManagerElement& download)
+{
+    return download.imageType == ImageType::Actor && download.actor != nullptr;
+}
+
+void DownloadManager::connectReply(QNetworkReply* reply, const DownloadManagerElement& download)
+{
+    mediaelch::network::ScrapeStats::instance().watch(reply, download.retries);
+    m_staging.reset();
+    if (isStagedWhileDownloading(download)) {
+        m_staging = mediaelch::ArtworkStage::instance().beginStaging();
+        connect(reply, &QNetworkReply::readyRead, this, &DownloadManager::downloadReadyRead);
+    }
+    connect(reply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
+    connect(reply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
+}
+
+/// @brief Passes the received bytes of an actor image to the stage.
+void DownloadManager::downloadReadyRead()
+{
+    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
+    if (reply == nullptr || reply != m_currentReply || m_staging == nullptr) {
+        return;
+    }
+    const int returnCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (returnCode == 302 || returnCode == 301 || reply->error() != QNetworkReply::NoError) {
+        return; // only the body of the final response is the image
     }
+    m_staging->write(reply->readAll());
 }
 
 /// @brief Called by the current network reply
@@ -266,7 +334,7 @@ void DownloadManager::downloadProgress(qint64 received, qint64 total)
         m_currentDownloadElement.bytesReceived = received;
         m_currentDownloadElement.bytesTotal = total;
         element = m_currentDownloadElement;
-        m_timer.start(5000);
+        m_timer.start(m_timeoutMilliseconds);
     }
     emit sigDownloadProgress(element);
 }
@@ -289,6 +357,8 @@ void DownloadManager::downloadTimeout()
 
     // abort() calls downloadFinished() which would result in a deadlock if we still had the lock
     locker.unlock();
+    mediaelch::network::HostTimeouts::instance().reportTimeout(reply->url().host());
+    mediaelch::network::ScrapeStats::markTimedOut(reply);
     reply->abort();
     reply->deleteLater();
 
@@ -324,10 +394,9 @@ void DownloadManager::downloadFinished()
     const int returnCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     if (returnCode == 302 || returnCode == 301) {
         QMutexLocker locker(&m_mutex);
-        m_currentReply = qnam()->get(mediaelch::network::requestWithDefaults(
-            reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
-        connect(m_currentReply, &QNetworkReply::finished, this, &DownloadManager::downloadFinished);
-        connect(m_currentReply, &QNetworkReply::downloadProgress, this, &DownloadManager::downloadProgress);
+        m_currentReply = qnam()->get(downloadRequest(
+            m_currentDownloadElement, reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
+        connectReply(m_currentReply, m_currentDownloadElement);
         return;
     }
 
@@ -335,17 +404,23 @@ void DownloadManager::downloadFinished()
     m_downloading = false;
 
     QByteArray data;
+    mediaelch::StagedImage image;
     if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "[DownloadManager] Network Error:" << reply->errorString() << "|" << m_currentReply->url();
+    } else if (m_staging != nullptr) {
+        m_staging->write(reply->readAll());
+        image = m_staging->finish();
     } else {
         data = reply->readAll();
     }
+    m_staging.reset();
 
     m_currentDownloadElement.data = data;
+    m_currentDownloadElement.image = image;
 
     if (m_currentDownloadElement.actor != nullptr && m_currentDownloadElement.imageType == ImageType::Actor
         && m_currentDownloadElement.movie == nullptr) {
-        m_currentDownloadElement.actor->image = data;
+        m_currentDownloadElement.actor->image = image;
 
     } else if (m_currentDownloadElement.imageType == ImageType::TvShowEpisodeThumb
                && !m_currentDownloadElement.directDownload) {
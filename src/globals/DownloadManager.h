@@ -1,17 +1,21 @@
 #pragma once
 
+#include "data/ArtworkStage.h"
 #include "globals/DownloadManagerElement.h"
 #include "globals/Globals.h"
 
 #include <QMutex>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QObject>
 #include <QQueue>
 #include <QTimer>
 #include <QUrl>
 #include <QVector>
 
+#include <memory>
+
 class Artist;
 class Album;
 
@@ -44,6 +48,7 @@ signals:
 
 private slots:
     void downloadProgress(qint64 received, qint64 total);
+    void downloadReadyRead();
     void downloadFinished();
     void startNextDownload();
     void downloadTimeout();
@@ -59,7 +64,11 @@ private:
     void checkAllAlbumDownloadsFinished();
 
     QNetworkAccessManager* qnam();
+    static QNetworkRequest downloadRequest(const DownloadManagerElement& download, const QUrl& url);
     bool isLocalFile(const QUrl& url) const;
+    /// Actor images are staged while they are downloaded instead of buffering them.
+    static bool isStagedWhileDownloading(const DownloadManagerElement& download);
+    void connectReply(QNetworkReply* reply, const DownloadManagerElement& download);
 
     QNetworkReply* m_currentReply = nullptr;
     DownloadManagerElement m_currentDownloadElement;
@@ -68,5 +77,9 @@ private:
     bool m_downloading = false;
     QMutex m_mutex;
     QTimer m_timer;
+    /// Inactivity timeout of the current download, see mediaelch::network::HostTimeouts.
+    int m_timeoutMilliseconds = 5000;
     int m_retries = 0;
+    /// Receives the current download if isStagedWhileDownloading().
+    std::unique_ptr<mediaelch::StagingWriter> m_staging;
 };
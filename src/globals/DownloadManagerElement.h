@@ -18,7 +18,10 @@ public:
 
     ImageType imageType{ImageType::None};
     QUrl url;
+    /// Downloaded bytes.  Not set for actor images, which are staged while they are downloaded.
     QByteArray data;
+    /// The staged actor image, see mediaelch::ArtworkStage::beginStaging().
+    mediaelch::StagedImage image;
     qint64 bytesReceived{0};
     qint64 bytesTotal{0};
     /// \brief How often did the download manager try to download this element?
@@ -4,12 +4,16 @@
 #include <QBuffer>
 #include <QDebug>
 #include <QFileDialog>
+#include <QFutureWatcher>
+#include <QImageReader>
 #include <QLabel>
 #include <QMovie>
 #include <QPainter>
+#include <QScrollBar>
 #include <QSize>
 #include <QStandardPaths>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/qmath.h>
 
 #include "concerts/Concert.h"
@@ -19,6 +23,7 @@
 #include "movies/Movie.h"
 #include "music/Album.h"
 #include "music/Artist.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
 #include "scrapers/image/ImageProviderInterface.h"
 #include "tv_shows/TvShow.h"
@@ -58,6 +63,7 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     connect(ui->gallery,       elchOverload<QString>(&ImageGallery::sigRemoveImage),  this, &ImageDialog::onImageClosed);
     connect(ui->imageProvider, elchOverload<int>(&QComboBox::currentIndexChanged),    this, &ImageDialog::onProviderChanged);
     // clang-format on
+    connect(ui->table->verticalScrollBar(), &QScrollBar::valueChanged, this, &ImageDialog::onTableScrolled);
 
     ui->btnAcceptImages->hide();
 
@@ -66,7 +72,6 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     ui->labelSpinner->setMovie(movie);
     clearSearch();
     setImageType(ImageType::MoviePoster);
-    m_currentDownloadReply = nullptr;
     m_multiSelection = false;
 
     QPixmap zoomOut(":/img/zoom_out.png");
@@ -289,7 +294,6 @@ void ImageDialog::setDownloads(QVector<Poster> downloads, bool initial)
         DownloadElement d;
         d.originalUrl = poster.originalUrl;
         d.thumbUrl = poster.thumbUrl;
-        d.downloaded = false;
         d.resolution = poster.originalSize;
         d.hint = poster.hint;
         if (!poster.language.isEmpty()) {
@@ -299,8 +303,8 @@ void ImageDialog::setDownloads(QVector<Poster> downloads, bool initial)
     }
     ui->labelLoading->setVisible(true);
     ui->labelSpinner->setVisible(true);
-    startNextDownload();
     renderTable();
+    startDownloads();
     if (downloads.count() == 0) {
         ui->stackedWidget->setCurrentIndex(2);
     }
@@ -312,78 +316,204 @@ void ImageDialog::setDownloads(QVector<Poster> downloads, bool initial)
  */
 QNetworkAccessManager* ImageDialog::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 /**
- * @brief Starts the next download if there is one
+ * @brief Starts downloads until s_maxDownloads are running.
+ * Images in the visible part of the table are downloaded first.
  */
-void ImageDialog::startNextDownload()
+void ImageDialog::startDownloads()
 {
-    qDebug() << "[ImageDialog] Start next download";
-
-    int nextIndex = -1;
-    for (int i = 0, n = m_elements.size(); i < n; i++) {
-        if (!m_elements[i].downloaded) {
-            nextIndex = i;
-            break;
+    int running = 0;
+    bool finished = true;
+    for (const DownloadElement& element : m_elements) {
+        if (element.state == DownloadElement::State::Loading) {
+            ++running;
+        }
+        if (element.state != DownloadElement::State::Done) {
+            finished = false;
         }
     }
 
-    if (nextIndex == -1) {
+    if (finished) {
         ui->labelLoading->setVisible(false);
         ui->labelSpinner->setVisible(false);
         return;
     }
-    m_currentDownloadIndex = nextIndex;
-    m_currentDownloadReply = qnam()->get(mediaelch::network::requestWithDefaults(m_elements[nextIndex].thumbUrl));
-    connect(m_currentDownloadReply, &QNetworkReply::finished, this, &ImageDialog::downloadFinished);
+
+    const QPair<int, int> visible = visibleElements();
+    const int lastVisible = qMin(visible.second, m_elements.size() - 1);
+    for (int i = visible.first; i <= lastVisible && running < s_maxDownloads; ++i) {
+        if (m_elements[i].state == DownloadElement::State::Pending) {
+            startDownload(i, m_elements[i].thumbUrl);
+            ++running;
+        }
+    }
+    for (int i = 0, n = m_elements.size(); i < n && running < s_maxDownloads; ++i) {
+        if (m_elements[i].state == DownloadElement::State::Pending) {
+            startDownload(i, m_elements[i].thumbUrl);
+            ++running;
+        }
+    }
+}
+
+void ImageDialog::startDownload(int index, const QUrl& url)
+{
+    QNetworkReply* reply = qnam()->get(mediaelch::network::requestWithDefaults(url));
+    m_elements[index].state = DownloadElement::State::Loading;
+    m_elements[index].reply = reply;
+    const int generation = m_downloadGeneration;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, index, generation]() {
+        onDownloadFinished(reply, index, generation);
+    });
 }
 
 /**
- * @brief Called when a download has finished
- * Renders the table and displays the downloaded image and starts the next download
+ * @brief Called when a download has finished. The image is decoded on a worker thread.
  */
-void ImageDialog::downloadFinished()
+void ImageDialog::onDownloadFinished(QNetworkReply* reply, int index, int generation)
 {
-    if (m_currentDownloadReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 302
-        || m_currentDownloadReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 301) {
-        m_currentDownloadReply->deleteLater();
-        m_currentDownloadReply = qnam()->get(mediaelch::network::requestWithDefaults(
-            m_currentDownloadReply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
-        connect(m_currentDownloadReply, &QNetworkReply::finished, this, &ImageDialog::downloadFinished);
+    reply->deleteLater();
+    // The download was cancelled or m_elements has been cleared in the meantime.
+    if (generation != m_downloadGeneration || index >= m_elements.size() || m_elements[index].reply != reply) {
+        return;
+    }
+    m_elements[index].reply = nullptr;
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode == 302 || statusCode == 301) {
+        startDownload(index, reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl());
         return;
     }
 
-    if (m_currentDownloadReply->error() == QNetworkReply::NoError) {
-        m_elements[m_currentDownloadIndex].pixmap.loadFromData(m_currentDownloadReply->readAll());
-        helper::setDevicePixelRatio(m_elements[m_currentDownloadIndex].pixmap, helper::devicePixelRatio(this));
+    if (reply->error() != QNetworkReply::NoError) {
+        showError(tr("Error while downloading one or more images: %1").arg(reply->errorString()));
+        qWarning() << "Network Error: " << reply->errorString() << " | " << reply->url();
+        // Mark item as done even if there was an error to avoid an infinite loop.
+        m_elements[index].state = DownloadElement::State::Done;
+        startDownloads();
+        return;
+    }
 
-        if (!m_elements[m_currentDownloadIndex].pixmap.isNull()) {
-            const int width = static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
-            m_elements[m_currentDownloadIndex].scaledPixmap =
-                m_elements[m_currentDownloadIndex].pixmap.scaledToWidth(width, Qt::SmoothTransformation);
-            helper::setDevicePixelRatio(
-                m_elements[m_currentDownloadIndex].scaledPixmap, helper::devicePixelRatio(this));
-            m_elements[m_currentDownloadIndex].cellWidget->setImage(m_elements[m_currentDownloadIndex].scaledPixmap);
-            m_elements[m_currentDownloadIndex].cellWidget->setHint(
-                m_elements[m_currentDownloadIndex].resolution, m_elements[m_currentDownloadIndex].hint);
+    m_elements[index].state = DownloadElement::State::Decoding;
+    auto* watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, index, generation]() {
+        watcher->deleteLater();
+        if (generation == m_downloadGeneration && index < m_elements.size()) {
+            onImageDecoded(index, watcher->result());
         }
-        ui->table->resizeRowsToContents();
+    });
+    watcher->setFuture(QtConcurrent::run(&ImageDialog::decodePreview, reply->readAll(), maxPreviewWidth()));
+    startDownloads();
+}
 
-    } else {
-        showError(tr("Error while downloading one or more images: %1").arg(m_currentDownloadReply->errorString()));
-        qWarning() << "Network Error: " << m_currentDownloadReply->errorString() << " | "
-                   << m_currentDownloadReply->url();
+void ImageDialog::onImageDecoded(int index, const QImage& image)
+{
+    m_elements[index].state = DownloadElement::State::Done;
+    m_elements[index].image = image;
+    showPreview(index);
+    startDownloads();
+}
+
+/**
+ * @brief Decodes an image. Large images are scaled down while they are decoded,
+ * which is a lot faster than decoding the full resolution and scaling it afterwards.
+ * Called on a worker thread.
+ */
+QImage ImageDialog::decodePreview(const QByteArray& data, int maxWidth)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    const QSize size = reader.size();
+    if (size.isValid() && size.width() > maxWidth) {
+        reader.setScaledSize(size.scaled(maxWidth, size.height(), Qt::KeepAspectRatio));
+    }
+    return reader.read();
+}
+
+/**
+ * @brief Aborts downloads of images that were scrolled out of view if visible images are still waiting.
+ */
+void ImageDialog::onTableScrolled()
+{
+    const QPair<int, int> visible = visibleElements();
+    bool visiblePending = false;
+    for (int i = visible.first, n = qMin(visible.second + 1, m_elements.size()); i < n; ++i) {
+        if (m_elements[i].state == DownloadElement::State::Pending) {
+            visiblePending = true;
+            break;
+        }
+    }
+    if (!visiblePending) {
+        return;
     }
 
-    // It is possible that m_elements has been cleared by aborting all downloads
-    if (m_currentDownloadIndex < m_elements.size()) {
-        // Mark item as downloaded even if there was an error to avoid an infinite loop.
-        m_elements[m_currentDownloadIndex].downloaded = true;
+    for (int i = 0, n = m_elements.size(); i < n; ++i) {
+        DownloadElement& element = m_elements[i];
+        if (element.state == DownloadElement::State::Loading && (i < visible.first || i > visible.second)) {
+            QNetworkReply* reply = element.reply;
+            element.reply = nullptr;
+            element.state = DownloadElement::State::Pending;
+            reply->abort();
+        }
     }
-    m_currentDownloadReply->deleteLater();
-    startNextDownload();
+    startDownloads();
+}
+
+QPair<int, int> ImageDialog::visibleElements() const
+{
+    const int cols = ui->table->columnCount();
+    const int firstRow = ui->table->rowAt(0);
+    if (cols == 0 || firstRow < 0) {
+        return {0, -1};
+    }
+    int lastRow = ui->table->rowAt(ui->table->viewport()->height() - 1);
+    if (lastRow < 0) {
+        lastRow = ui->table->rowCount() - 1;
+    }
+    return {firstRow * cols, (lastRow + 1) * cols - 1};
+}
+
+/**
+ * @brief Shows the preview of the element in its cell, if it was loaded.
+ */
+void ImageDialog::showPreview(int index)
+{
+    const DownloadElement& element = m_elements[index];
+    if (element.image.isNull() || element.cellWidget == nullptr) {
+        return;
+    }
+    element.cellWidget->setImage(preview(index));
+    element.cellWidget->setHint(element.resolution, element.hint);
+    ui->table->resizeRowToContents(index / ui->table->columnCount());
+}
+
+/**
+ * @brief Returns the image of the element scaled to the current column width.
+ */
+QPixmap ImageDialog::preview(int index)
+{
+    const int width = static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
+    DownloadElement& element = m_elements[index];
+    auto cached = element.previews.constFind(width);
+    if (cached != element.previews.constEnd()) {
+        return cached.value();
+    }
+    QPixmap pixmap = QPixmap::fromImage(element.image.scaledToWidth(width, Qt::SmoothTransformation));
+    helper::setDevicePixelRatio(pixmap, helper::devicePixelRatio(this));
+    element.previews.insert(width, pixmap);
+    return pixmap;
+}
+
+/**
+ * @brief Width of the preview at the largest zoom level. Downloaded images are decoded to this width.
+ */
+int ImageDialog::maxPreviewWidth()
+{
+    return static_cast<int>((ui->previewSizeSlider->maximum() * 16 - 10) * helper::devicePixelRatio(this));
 }
 
 /**
@@ -393,6 +523,7 @@ void ImageDialog::renderTable()
 {
     const int cols = calcColumnCount();
     ui->table->setColumnCount(cols);
+    ui->table->setUpdatesEnabled(false);
     ui->table->setRowCount(0);
     ui->table->clearContents();
 
@@ -408,11 +539,8 @@ void ImageDialog::renderTable()
         auto item = new QTableWidgetItem;
         item->setData(Qt::UserRole, m_elements[i].originalUrl);
         auto label = new ImageLabel(ui->table);
-        if (!m_elements[i].pixmap.isNull()) {
-            const int width = static_cast<int>((getColumnWidth() - 10) * helper::devicePixelRatio(this));
-            QPixmap pixmap = m_elements[i].pixmap.scaledToWidth(width, Qt::SmoothTransformation);
-            helper::setDevicePixelRatio(pixmap, helper::devicePixelRatio(this));
-            label->setImage(pixmap);
+        if (!m_elements[i].image.isNull()) {
+            label->setImage(preview(i));
             label->setHint(m_elements[i].resolution, m_elements[i].hint);
         }
         m_elements[i].cellWidget = label;
@@ -420,6 +548,10 @@ void ImageDialog::renderTable()
         ui->table->setCellWidget(row, i % cols, label);
         ui->table->resizeRowToContents(row);
     }
+    ui->table->setUpdatesEnabled(true);
+
+    // Other images may be visible now.
+    onTableScrolled();
 }
 
 /**
@@ -545,17 +677,15 @@ void ImageDialog::cancelDownloads()
 {
     ui->labelLoading->setVisible(false);
     ui->labelSpinner->setVisible(false);
-    bool running = false;
-    for (const DownloadElement& d : m_elements) {
-        if (!d.downloaded) {
-            running = true;
-            break;
+    ++m_downloadGeneration;
+    for (DownloadElement& element : m_elements) {
+        if (element.reply != nullptr) {
+            QNetworkReply* reply = element.reply;
+            element.reply = nullptr;
+            reply->abort();
         }
     }
     m_elements.clear();
-    if (running) {
-        m_currentDownloadReply->abort();
-    }
 }
 
 /**
@@ -581,16 +711,13 @@ void ImageDialog::chooseLocalImage()
     DownloadElement d;
     d.originalUrl = fileName;
     d.thumbUrl = fileName;
-    d.downloaded = false;
+    d.state = DownloadElement::State::Done;
+    d.image = QImage(fileName);
+    d.resolution = d.image.size();
     m_elements.append(d);
 
     renderTable();
-    m_elements[index].pixmap = QPixmap(fileName);
-    m_elements[index].pixmap = m_elements[index].pixmap.scaledToWidth(getColumnWidth() - 10, Qt::SmoothTransformation);
-    m_elements[index].cellWidget->setImage(m_elements[index].pixmap);
-    m_elements[index].cellWidget->setHint(m_elements[index].pixmap.size());
-    ui->table->resizeRowsToContents();
-    m_elements[index].downloaded = true;
+    showPreview(index);
     if (m_multiSelection) {
         QByteArray ba;
         QFile file(fileName);
@@ -620,20 +747,15 @@ void ImageDialog::onImageDropped(QUrl url)
     DownloadElement d;
     d.originalUrl = url;
     d.thumbUrl = url;
-    d.downloaded = false;
+    d.state = DownloadElement::State::Done;
+    if (url.toString().startsWith("file://")) {
+        d.image = QImage(url.toLocalFile());
+        d.resolution = d.image.size();
+    }
     m_elements.append(d);
 
     renderTable();
-
-    if (url.toString().startsWith("file://")) {
-        m_elements[index].pixmap = QPixmap(url.toLocalFile());
-        m_elements[index].pixmap =
-            m_elements[index].pixmap.scaledToWidth(getColumnWidth() - 10, Qt::SmoothTransformation);
-        m_elements[index].cellWidget->setImage(m_elements[index].pixmap);
-        m_elements[index].cellWidget->setHint(m_elements[index].pixmap.size());
-    }
-    ui->table->resizeRowsToContents();
-    m_elements[index].downloaded = true;
+    showPreview(index);
     if (m_multiSelection) {
         QByteArray ba;
         QFile file(url.toLocalFile());
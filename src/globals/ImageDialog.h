@@ -8,9 +8,12 @@
 #include "tv_shows/SeasonNumber.h"
 
 #include <QDialog>
+#include <QHash>
+#include <QImage>
 #include <QLabel>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QPair>
 #include <QResizeEvent>
 #include <QTableWidgetItem>
 #include <QUrl>
@@ -63,8 +66,8 @@ protected:
     void resizeEvent(QResizeEvent* event) override;
 
 private slots:
-    void downloadFinished();
-    void startNextDownload();
+    void startDownloads();
+    void onTableScrolled();
     void imageClicked(int row, int col);
     void chooseLocalImage();
     void onImageDropped(QUrl url);
@@ -85,11 +88,22 @@ private:
 
     struct DownloadElement
     {
+        enum class State
+        {
+            Pending,
+            Loading,
+            Decoding,
+            Done
+        };
+
         QUrl thumbUrl;
         QUrl originalUrl;
-        QPixmap pixmap;
-        QPixmap scaledPixmap;
-        bool downloaded = false;
+        /// Decoded image. Downloaded images are at most as wide as the largest preview.
+        QImage image;
+        /// Scaled variants of image per preview width, so that zooming doesn't scale again.
+        QHash<int, QPixmap> previews;
+        State state = State::Pending;
+        QNetworkReply* reply = nullptr;
         ImageLabel* cellWidget = nullptr;
         QSize resolution;
         QString hint;
@@ -101,9 +115,11 @@ private:
         constexpr static int isDefaultProvider = Qt::UserRole + 1;
     };
 
-    QNetworkAccessManager m_qnam;
-    int m_currentDownloadIndex = 0;
-    QNetworkReply* m_currentDownloadReply = nullptr;
+    /// Number of previews that are downloaded at the same time.
+    static constexpr int s_maxDownloads = 6;
+
+    /// Incremented whenever m_elements is cleared, so that outdated replies and decoded images are dropped.
+    int m_downloadGeneration = 0;
     ImageType m_imageType = ImageType::None;
     QVector<DownloadElement> m_elements;
     QUrl m_imageUrl;
@@ -125,6 +141,15 @@ private:
 
     QNetworkAccessManager* qnam();
     void renderTable();
+    void startDownload(int index, const QUrl& url);
+    void onDownloadFinished(QNetworkReply* reply, int index, int generation);
+    void onImageDecoded(int index, const QImage& image);
+    void showPreview(int index);
+    QPixmap preview(int index);
+    /// Indexes of the first and last element in the visible part of the table.
+    QPair<int, int> visibleElements() const;
+    int maxPreviewWidth();
+    static QImage decodePreview(const QByteArray& data, int maxWidth);
     int calcColumnCount();
     int getColumnWidth();
     void loadImagesFromProvider(QString id);
@@ -7,6 +7,7 @@
 #include <QObject>
 #include <QUrl>
 
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
 
@@ -17,10 +18,12 @@ JsonPostRequest::JsonPostRequest(QUrl url, QJsonObject body, QObject* parent) :
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
-    QNetworkReply* reply = m_qnam.post(request, QJsonDocument(body).toJson());
+    QNetworkReply* reply = network::accessManager()->post(request, QJsonDocument(body).toJson());
     new NetworkReplyWatcher(this, reply);
+    // The shared access manager does not delete the reply together with this request.
+    QObject::connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
 
-    QObject::connect(reply, &QNetworkReply::finished, [reply, this]() {
+    QObject::connect(reply, &QNetworkReply::finished, this, [reply, this]() {
         QJsonDocument parsedJson;
 
         if (reply->error() == QNetworkReply::NoError) {
@@ -25,7 +25,6 @@ signals:
     void sigResponse(QJsonDocument& document);
 
 private:
-    QNetworkAccessManager m_qnam;
 };
 
 } // namespace mediaelch
@@ -0,0 +1,214 @@
+#include "globals/LibraryReloader.h"
+
+#include "globals/Manager.h"
+
+#include <QDebug>
+#include <QThread>
+#include <algorithm>
+
+namespace mediaelch {
+
+LibraryReloader::LibraryReloader(QObject* parent) : QObject(parent)
+{
+}
+
+LibraryReloader::~LibraryReloader()
+{
+    if (isRunning()) {
+        abort();
+    }
+}
+
+bool LibraryReloader::reload(const QVector<Library>& libraries, bool force)
+{
+    if (isRunning()) {
+        qWarning() << "[LibraryReloader] Reload requested while another reload is still running";
+        return false;
+    }
+
+    m_aborted = false;
+    m_jobs.clear();
+    for (Library library : libraries) {
+        Job job;
+        job.library = library;
+        job.searcher = searcherFor(library);
+        m_jobs.append(job);
+    }
+
+    for (int i = 0; i < m_jobs.size(); ++i) {
+        prepareReload(m_jobs[i].library);
+    }
+    for (int i = 0; i < m_jobs.size(); ++i) {
+        startJob(i, force);
+    }
+    return true;
+}
+
+void LibraryReloader::abort()
+{
+    m_aborted = true;
+    for (const Job& job : m_jobs) {
+        if (job.thread != nullptr) {
+            abortSearcher(job.library);
+        }
+    }
+    for (const Job& job : m_jobs) {
+        if (job.thread != nullptr) {
+            onJobFinished(job.thread);
+        }
+    }
+}
+
+bool LibraryReloader::isRunning() const
+{
+    return m_runningJobs > 0;
+}
+
+void LibraryReloader::startJob(int index, bool force)
+{
+    Job& job = m_jobs[index];
+    QObject* searcher = job.searcher;
+    const Library library = job.library;
+    QThread* guiThread = thread();
+
+    // Objects with a parent can't be moved to another thread.
+    job.searcherParent = searcher->parent();
+    searcher->setParent(nullptr);
+
+    job.thread = new QThread(this);
+    searcher->moveToThread(job.thread);
+
+    const auto onProgress = [this, index](int current, int max, int /*messageId*/) {
+        onJobProgress(index, current, max);
+    };
+    auto* manager = Manager::instance();
+    switch (library) {
+    case Library::Movies:
+        job.progressConnection = connect(manager->movieFileSearcher(), &MovieFileSearcher::progress, this, onProgress);
+        break;
+    case Library::TvShows:
+        job.progressConnection =
+            connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::progress, this, onProgress);
+        break;
+    case Library::Concerts:
+        job.progressConnection =
+            connect(manager->concertFileSearcher(), &ConcertFileSearcher::progress, this, onProgress);
+        break;
+    case Library::Music:
+        job.progressConnection = connect(manager->musicFileSearcher(), &MusicFileSearcher::progress, this, onProgress);
+        break;
+    }
+
+    // The searcher lives in the new thread, so this is called in it.
+    connect(job.thread, &QThread::started, searcher, [searcher, library, force, guiThread]() {
+        load(library, force);
+        // Hand the searcher and all media objects it created back to the GUI thread.
+        searcher->moveToThread(guiThread);
+        QThread::currentThread()->quit();
+    });
+    QThread* jobThread = job.thread;
+    connect(job.thread, &QThread::finished, this, [this, jobThread]() { onJobFinished(jobThread); });
+
+    ++m_runningJobs;
+    job.thread->start();
+}
+
+void LibraryReloader::onJobFinished(QThread* thread)
+{
+    // The job may have been finished by abort() already.
+    auto job = std::find_if(m_jobs.begin(), m_jobs.end(), [thread](const Job& j) { return j.thread == thread; });
+    if (thread == nullptr || job == m_jobs.end()) {
+        return;
+    }
+
+    // finished() is emitted shortly before the thread actually ends.
+    thread->wait();
+    thread->deleteLater();
+    job->thread = nullptr;
+    disconnect(job->progressConnection);
+
+    job->searcher->setParent(job->searcherParent);
+    addLoadedToGui(job->library);
+
+    --m_runningJobs;
+    if (m_runningJobs == 0 && !m_aborted) {
+        emit finished();
+    }
+}
+
+void LibraryReloader::onJobProgress(int index, int current, int max)
+{
+    if (index >= m_jobs.size()) {
+        return;
+    }
+    m_jobs[index].current = current;
+    m_jobs[index].max = max;
+
+    int sumCurrent = 0;
+    int sumMax = 0;
+    for (const Job& job : m_jobs) {
+        sumCurrent += job.current;
+        sumMax += job.max;
+    }
+    emit progress(sumCurrent, sumMax);
+}
+
+QObject* LibraryReloader::searcherFor(Library library)
+{
+    auto* manager = Manager::instance();
+    switch (library) {
+    case Library::Movies: return manager->movieFileSearcher();
+    case Library::TvShows: return manager->tvShowFileSearcher();
+    case Library::Concerts: return manager->concertFileSearcher();
+    case Library::Music: return manager->musicFileSearcher();
+    }
+    return nullptr;
+}
+
+void LibraryReloader::prepareReload(Library library)
+{
+    auto* manager = Manager::instance();
+    switch (library) {
+    case Library::Movies: manager->movieFileSearcher()->prepareReload(); break;
+    case Library::TvShows: manager->tvShowFileSearcher()->prepareReload(); break;
+    case Library::Concerts: manager->concertFileSearcher()->prepareReload(); break;
+    case Library::Music: manager->musicFileSearcher()->prepareReload(); break;
+    }
+}
+
+void LibraryReloader::load(Library library, bool force)
+{
+    auto* manager = Manager::instance();
+    // Searchers read from the database; they must see edits that are still queued.
+    manager->databaseService()->flush();
+    switch (library) {
+    case Library::Movies: manager->movieFileSearcher()->load(force); break;
+    case Library::TvShows: manager->tvShowFileSearcher()->load(force); break;
+    case Library::Concerts: manager->concertFileSearcher()->load(force); break;
+    case Library::Music: manager->musicFileSearcher()->load(force); break;
+    }
+}
+
+void LibraryReloader::addLoadedToGui(Library library)
+{
+    auto* manager = Manager::instance();
+    switch (library) {
+    case Library::Movies: manager->movieFileSearcher()->addLoadedToGui(); break;
+    case Library::TvShows: manager->tvShowFileSearcher()->addLoadedToGui(); break;
+    case Library::Concerts: manager->concertFileSearcher()->addLoadedToGui(); break;
+    case Library::Music: manager->musicFileSearcher()->addLoadedToGui(); break;
+    }
+}
+
+void LibraryReloader::abortSearcher(Library library)
+{
+    auto* manager = Manager::instance();
+    switch (library) {
+    case Library::Movies: manager->movieFileSearcher()->abort(); break;
+    case Library::TvShows: manager->tvShowFileSearcher()->abort(); break;
+    case Library::Concerts: manager->concertFileSearcher()->abort(); break;
+    case Library::Music: manager->musicFileSearcher()->abort(); break;
+    }
+}
+
+} // namespace mediaelch
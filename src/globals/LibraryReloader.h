@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QMetaObject>
+#include <QObject>
+#include <QVector>
+
+class QThread;
+
+namespace mediaelch {
+
+/// \brief Reloads several media libraries at the same time.
+///
+/// Each file searcher is moved to a thread of its own while it loads its
+/// library, so that e.g. movies and TV shows on different disks are scanned
+/// in parallel. Every thread uses its own database connection, see Database::db().
+/// Afterwards the searcher and all media objects it created are moved back to
+/// the GUI thread, where they are added to the models.
+///
+/// \par Example
+/// \code{cpp}
+///   LibraryReloader reloader;
+///   connect(&reloader, &LibraryReloader::finished, ...);
+///   reloader.reload({LibraryReloader::Library::Movies, LibraryReloader::Library::Music}, false);
+/// \endcode
+class LibraryReloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Library
+    {
+        Movies,
+        TvShows,
+        Concerts,
+        Music
+    };
+
+    explicit LibraryReloader(QObject* parent = nullptr);
+    ~LibraryReloader() override;
+
+    /// \brief Starts reloading the given libraries. Returns false if a reload is still running.
+    bool reload(const QVector<Library>& libraries, bool force);
+    /// \brief Aborts all searchers and waits for their threads. finished() is not emitted.
+    void abort();
+    bool isRunning() const;
+
+signals:
+    /// \brief Combined progress of all libraries that are reloaded.
+    void progress(int current, int max);
+    /// \brief All libraries are loaded and were added to their models.
+    void finished();
+
+private:
+    struct Job
+    {
+        Library library = Library::Movies;
+        QObject* searcher = nullptr;
+        /// Searchers are owned by the Manager. Objects with a parent can't be moved to another thread.
+        QObject* searcherParent = nullptr;
+        QThread* thread = nullptr;
+        QMetaObject::Connection progressConnection;
+        int current = 0;
+        int max = 0;
+    };
+
+    void startJob(int index, bool force);
+    void onJobFinished(QThread* thread);
+    void onJobProgress(int index, int current, int max);
+
+    static QObject* searcherFor(Library library);
+    static void prepareReload(Library library);
+    static void load(Library library, bool force);
+    static void addLoadedToGui(Library library);
+    static void abortSearcher(Library library);
+
+    QVector<Job> m_jobs;
+    int m_runningJobs = 0;
+    bool m_aborted = false;
+};
+
+} // namespace mediaelch
@@ -7,6 +7,7 @@
 #include "globals/Globals.h"
 #include "media_centers/KodiXml.h"
 #include "media_centers/MediaCenterInterface.h"
+#include "network/ScrapeStats.h"
 #include "scrapers/concert/TMDbConcerts.h"
 #include "scrapers/image/FanartTv.h"
 #include "scrapers/image/FanartTvMusic.h"
@@ -24,6 +25,7 @@
 #include "scrapers/music/UniversalMusicScraper.h"
 #include "scrapers/trailer/HdTrailers.h"
 #include "scrapers/tv_show/TheTvDb.h"
+#include "tv_shows/TvShow.h"
 
 Manager::Manager(QObject* parent) : QObject(parent)
 {
@@ -42,6 +44,38 @@ Manager::Manager(QObject* parent) : QObject(parent)
     m_concertModel = new ConcertModel(this);
     m_musicModel = new MusicModel(this);
     m_database = new Database(this);
+    m_databaseService = new mediaelch::DatabaseService(m_database, this);
+    m_contentHashes = new mediaelch::ContentHashCache(m_databaseService, this);
+    m_streamDetailsAnalyzer = new mediaelch::StreamDetailsAnalyzer(
+        Settings::instance()->databaseDir().filePath("streamDetailsQueue.json"), this);
+
+    // Show the movies and TV shows of the last scan until the libraries are loaded.
+    const mediaelch::DirectoryPath databaseDir = Settings::instance()->databaseDir();
+    m_movieModel->setSnapshot(mediaelch::LibrarySnapshot::open(databaseDir.filePath("movies.snapshot")));
+    m_tvShowModel->setSnapshot(mediaelch::LibrarySnapshot::open(databaseDir.filePath("tvshows.snapshot")));
+
+    // Keep the scraper performance data of earlier sessions; also read by "mediaelch-cli info scrape_stats".
+    mediaelch::network::ScrapeStats::instance().load(databaseDir.filePath("scrapeStats.json"));
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [databaseDir]() {
+        mediaelch::network::ScrapeStats::instance().save(databaseDir.filePath("scrapeStats.json"));
+    });
+
+    // Continue an analysis of the previous session once the items are loaded.
+    connect(m_movieFileSearcher, &mediaelch::MovieFileSearcher::moviesLoaded, this, [this, databaseDir]() {
+        m_streamDetailsAnalyzer->restore(m_movieModel->movies());
+        m_movieModel->writeSnapshot(databaseDir.filePath("movies.snapshot"));
+    });
+    connect(m_concertFileSearcher, &ConcertFileSearcher::concertsLoaded, this, [this]() {
+        m_streamDetailsAnalyzer->restore(m_concertModel->concerts());
+    });
+    connect(m_tvShowFileSearcher, &TvShowFileSearcher::tvShowsLoaded, this, [this]() {
+        QVector<TvShowEpisode*> episodes;
+        for (TvShow* show : m_tvShowModel->tvShows()) {
+            episodes << show->episodes();
+        }
+        m_streamDetailsAnalyzer->restore(episodes);
+        m_tvShowModel->writeSnapshot(databaseDir.filePath("tvshows.snapshot"));
+    });
 
     m_mediaCenters.append(new KodiXml(this));
     m_mediaCentersTvShow.append(new KodiXml(this));
@@ -66,7 +100,11 @@ Manager::Manager(QObject* parent) : QObject(parent)
     qRegisterMetaType<MusicModelItem*>("MusicModelItem*");
 }
 
-Manager::~Manager() = default;
+Manager::~Manager()
+{
+    // Commit pending writes while the database still exists.
+    delete m_databaseService;
+}
 
 Manager* Manager::instance()
 {
@@ -243,6 +281,21 @@ Database* Manager::database()
     return m_database;
 }
 
+mediaelch::DatabaseService* Manager::databaseService()
+{
+    return m_databaseService;
+}
+
+mediaelch::ContentHashCache* Manager::contentHashes()
+{
+    return m_contentHashes;
+}
+
+mediaelch::StreamDetailsAnalyzer* Manager::streamDetailsAnalyzer()
+{
+    return m_streamDetailsAnalyzer;
+}
+
 void Manager::setTvShowFilesWidget(TvShowFilesWidget* widget)
 {
     m_tvShowFilesWidget = widget;
@@ -2,7 +2,10 @@
 
 #include "concerts/ConcertFileSearcher.h"
 #include "concerts/ConcertModel.h"
+#include "data/ContentHashCache.h"
 #include "data/Database.h"
+#include "data/DatabaseService.h"
+#include "data/StreamDetailsAnalyzer.h"
 #include "media_centers/MediaCenterInterface.h"
 #include "movies/MovieModel.h"
 #include "movies/file_searcher/MovieFileSearcher.h"
@@ -58,6 +61,10 @@ public:
     ELCH_NODISCARD ConcertFileSearcher* concertFileSearcher();
     ELCH_NODISCARD MusicFileSearcher* musicFileSearcher();
     ELCH_NODISCARD Database* database();
+    /// \brief Asynchronous access to database(). Prefer it on the GUI thread.
+    ELCH_NODISCARD mediaelch::DatabaseService* databaseService();
+    ELCH_NODISCARD mediaelch::ContentHashCache* contentHashes();
+    ELCH_NODISCARD mediaelch::StreamDetailsAnalyzer* streamDetailsAnalyzer();
     ELCH_NODISCARD MovieModel* movieModel();
     ELCH_NODISCARD TvShowModel* tvShowModel();
     ELCH_NODISCARD ConcertModel* concertModel();
@@ -92,6 +99,9 @@ private:
     ConcertModel* m_concertModel = nullptr;
     MusicModel* m_musicModel = nullptr;
     Database* m_database = nullptr;
+    mediaelch::DatabaseService* m_databaseService = nullptr;
+    mediaelch::ContentHashCache* m_contentHashes = nullptr;
+    mediaelch::StreamDetailsAnalyzer* m_streamDetailsAnalyzer = nullptr;
     TvShowFilesWidget* m_tvShowFilesWidget = nullptr;
     MusicFilesWidget* m_musicFilesWidget = nullptr;
     FileScannerDialog* m_fileScannerDialog = nullptr;
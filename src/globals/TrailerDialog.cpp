@@ -3,6 +3,7 @@
 
 #include <QMessageBox>
 
+#include "file/DirectoryListingCache.h"
 #include "globals/Manager.h"
 #include "network/NetworkRequest.h"
 #include "scrapers/trailer/TrailerProvider.h"
@@ -372,6 +373,8 @@ void TrailerDialog::downloadFinished()
         file.remove();
     }
 
+    mediaelch::DirectoryListingCache::instance().invalidateFileDir(m_trailerFileName);
+
     ui->buttonDownload->setVisible(true);
     ui->buttonCancelDownload->setVisible(false);
     ui->progressBar->setVisible(false);
@@ -1,124 +1,229 @@
 #include "imports/DownloadFileSearcher.h"
 
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+
 namespace mediaelch {
 
+static QMutex s_cacheMutex;
+/// Filters that were used for the cached results. If they change, the cache is cleared.
+static QString s_cacheFilterKey;
+
+QHash<QString, DownloadFileSearcher::ScannedDirectory>& DownloadFileSearcher::directoryCache()
+{
+    static QHash<QString, ScannedDirectory> s_cache;
+    return s_cache;
+}
+
 void DownloadFileSearcher::scan()
 {
-    for (const SettingsDir& settingsDir : Settings::instance()->directorySettings().downloadDirectories()) {
-        QString dir = settingsDir.path.path();
-        QDirIterator it(dir,
-            QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-            QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-        while (it.hasNext()) {
-            it.next();
-            if (m_scanDownloads && isPackage(it.fileInfo())) {
-                QString base = baseName(it.fileInfo());
-                if (m_packages.contains(base)) {
-                    m_packages[base].files.append(it.filePath());
-                    m_packages[base].size += it.fileInfo().size();
-                } else {
-                    Package p;
-                    p.baseName = base;
-                    p.size = it.fileInfo().size();
-                    p.files << it.filePath();
-                    m_packages.insert(base, p);
-                }
-
-            } else if (m_scanImports && (isImportable(it.fileInfo()) || isSubtitle(it.fileInfo()))) {
-                QString base = it.fileInfo().completeBaseName();
-                if (m_imports.contains(base)) {
-                    if (isSubtitle(it.fileInfo())) {
-                        m_imports[base].extraFiles.append(it.filePath());
-                    } else {
-                        m_imports[base].files.append(it.filePath());
-                    }
-                    m_imports[base].size += it.fileInfo().size();
-                } else {
-                    Import i;
-                    i.baseName = base;
-                    if (isSubtitle(it.fileInfo())) {
-                        i.extraFiles << it.filePath();
-                    } else {
-                        i.files << it.filePath();
-                    }
-                    i.size = it.fileInfo().size();
-                    m_imports.insert(base, i);
-                }
+    QStringList importFilters;
+    importFilters << Settings::instance()->advanced()->movieFilters().filters();
+    importFilters << Settings::instance()->advanced()->tvShowFilters().filters();
+    importFilters << Settings::instance()->advanced()->concertFilters().filters();
+    importFilters.removeDuplicates();
+    const QStringList subtitleFilters = Settings::instance()->advanced()->subtitleFilters().filters();
+
+    m_importFilters = compileFilters(importFilters);
+    m_subtitleFilters = compileFilters(subtitleFilters);
+
+    {
+        QMutexLocker locker(&s_cacheMutex);
+        const QString filterKey = importFilters.join('|') + "||" + subtitleFilters.join('|');
+        if (filterKey != s_cacheFilterKey) {
+            directoryCache().clear();
+            s_cacheFilterKey = filterKey;
+        }
+
+        QSet<QString> visited;
+        for (const SettingsDir& settingsDir : Settings::instance()->directorySettings().downloadDirectories()) {
+            scanDirectory(settingsDir.path.path(), visited);
+        }
+
+        // Forget directories that were removed.
+        auto& cache = directoryCache();
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (visited.contains(it.key())) {
+                ++it;
+            } else {
+                it = cache.erase(it);
             }
         }
     }
 
-    QMapIterator<QString, Import> it(m_imports);
-    QStringList onlyExtraFiles;
-    while (it.hasNext()) {
-        it.next();
-        if (it.value().files.isEmpty()) {
-            onlyExtraFiles.append(it.key());
+    for (auto it = m_packageIndex.cbegin(); it != m_packageIndex.cend(); ++it) {
+        m_packages.insert(it.key(), it.value());
+    }
+    for (auto it = m_importIndex.cbegin(); it != m_importIndex.cend(); ++it) {
+        // Only extra files (e.g. subtitles) can't be imported.
+        if (!it.value().files.isEmpty()) {
+            m_imports.insert(it.key(), it.value());
         }
     }
+    m_packageIndex.clear();
+    m_importIndex.clear();
 
-    for (const QString& base : onlyExtraFiles) {
-        m_imports.remove(base);
+    emit sigScanFinished(this);
+}
+
+void DownloadFileSearcher::scanDirectory(const QString& path, QSet<QString>& visited)
+{
+    const QFileInfo dirInfo(path);
+    const QString absolutePath = dirInfo.absoluteFilePath();
+    // Symlinks may result in loops.
+    if (!dirInfo.isDir() || visited.contains(absolutePath)
+        || (dirInfo.isSymLink() && visited.contains(dirInfo.canonicalFilePath()))) {
+        return;
     }
+    visited.insert(absolutePath);
 
-    emit sigScanFinished(this);
+    // Copy: The cache is modified when scanning sub directories.
+    const ScannedDirectory directory = scannedDirectory(dirInfo);
+    for (const ScannedFile& file : directory.files) {
+        addFile(file);
+    }
+    for (const QString& subDirectory : directory.subDirectories) {
+        scanDirectory(subDirectory, visited);
+    }
 }
 
-QString DownloadFileSearcher::baseName(const QFileInfo& fileInfo) const
+DownloadFileSearcher::ScannedDirectory DownloadFileSearcher::scannedDirectory(const QFileInfo& dir)
 {
-    QString fileName = fileInfo.fileName();
-    QRegExp rx("(.*)(part[0-9]*)\\.rar");
-    if (rx.exactMatch(fileName)) {
-        return rx.cap(1).endsWith(".") ? rx.cap(1).mid(0, rx.cap(1).length() - 1) : rx.cap(1);
+    const QString path = dir.absoluteFilePath();
+    const QDateTime lastModified = dir.lastModified();
+
+    auto& cache = directoryCache();
+    const auto cached = cache.constFind(path);
+    if (cached != cache.cend() && cached.value().lastModified == lastModified) {
+        return cached.value();
     }
 
-    rx.setPattern("(.*)\\.r(ar|[0-9]*)");
-    if (rx.exactMatch(fileName)) {
-        return rx.cap(1);
+    ScannedDirectory directory;
+    directory.lastModified = lastModified;
+    const QFileInfoList entries = QDir(path).entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files);
+    for (const QFileInfo& entry : entries) {
+        if (entry.isDir()) {
+            directory.subDirectories << entry.absoluteFilePath();
+            continue;
+        }
+        ScannedFile file;
+        file.isPackage = isPackage(entry);
+        file.isImportable = isImportable(entry);
+        file.isSubtitle = isSubtitle(entry);
+        if (!file.isPackage && !file.isImportable && !file.isSubtitle) {
+            continue;
+        }
+        file.filePath = entry.absoluteFilePath();
+        file.baseName = file.isPackage ? baseName(entry) : entry.completeBaseName();
+        directory.files << file;
     }
 
-    return fileName;
+    cache.insert(path, directory);
+    return directory;
 }
 
-bool DownloadFileSearcher::isPackage(const QFileInfo& file) const
+void DownloadFileSearcher::addFile(const ScannedFile& file)
 {
-    if (file.suffix() == "rar") {
-        return true;
-    }
+    // The size changes while a file is being downloaded and is not cached.
+    const qint64 size = QFileInfo(file.filePath).size();
 
-    QRegExp rx("r[0-9]*");
-    return rx.exactMatch(file.suffix());
+    if (m_scanDownloads && file.isPackage) {
+        auto package = m_packageIndex.find(file.baseName);
+        if (package == m_packageIndex.end()) {
+            Package p;
+            p.baseName = file.baseName;
+            p.size = 0;
+            package = m_packageIndex.insert(file.baseName, p);
+        }
+        package.value().files.append(file.filePath);
+        package.value().size += size;
+
+    } else if (m_scanImports && (file.isImportable || file.isSubtitle)) {
+        auto import = m_importIndex.find(file.baseName);
+        if (import == m_importIndex.end()) {
+            Import i;
+            i.baseName = file.baseName;
+            i.size = 0;
+            import = m_importIndex.insert(file.baseName, i);
+        }
+        if (file.isSubtitle) {
+            import.value().extraFiles.append(file.filePath);
+        } else {
+            import.value().files.append(file.filePath);
+        }
+        import.value().size += size;
+    }
 }
 
-bool DownloadFileSearcher::isImportable(const QFileInfo& file) const
+DownloadFileSearcher::Filters DownloadFileSearcher::compileFilters(const QStringList& filters)
 {
-    QStringList filters;
-    filters << Settings::instance()->advanced()->movieFilters().filters();
-    filters << Settings::instance()->advanced()->tvShowFilters().filters();
-    filters << Settings::instance()->advanced()->concertFilters().filters();
-    filters.removeDuplicates();
+    // Matches simple filters such as "*.mkv".
+    static const QRegularExpression suffixFilter(R"(^\*\.([^*?\[\]\.]+)$)");
 
+    Filters compiled;
     for (const QString& filter : filters) {
-        QRegExp rx(filter);
-        rx.setPatternSyntax(QRegExp::Wildcard);
-        if (rx.exactMatch(file.fileName())) {
-            return true;
+        const QRegularExpressionMatch match = suffixFilter.match(filter);
+        if (match.hasMatch()) {
+            compiled.suffixes.insert(match.captured(1));
+        } else {
+            compiled.patterns << QRegExp(filter, Qt::CaseSensitive, QRegExp::Wildcard);
         }
     }
-    return false;
+    return compiled;
 }
 
-bool DownloadFileSearcher::isSubtitle(const QFileInfo& file) const
+bool DownloadFileSearcher::Filters::matches(const QFileInfo& file) const
 {
-    const QStringList filters = Settings::instance()->advanced()->subtitleFilters().filters();
-    for (const QString& filter : filters) {
-        QRegExp rx(filter);
-        rx.setPatternSyntax(QRegExp::Wildcard);
-        if (rx.exactMatch(file.fileName())) {
+    if (suffixes.contains(file.suffix())) {
+        return true;
+    }
+    const QString fileName = file.fileName();
+    for (const QRegExp& rx : patterns) {
+        if (rx.exactMatch(fileName)) {
             return true;
         }
     }
     return false;
 }
 
+QString DownloadFileSearcher::baseName(const QFileInfo& fileInfo) const
+{
+    static const QRegularExpression partRx(R"(^(.*)(part[0-9]*)\.rar$)");
+    static const QRegularExpression rarRx(R"(^(.*)\.r(ar|[0-9]*)$)");
+
+    const QString fileName = fileInfo.fileName();
+    QRegularExpressionMatch match = partRx.match(fileName);
+    if (match.hasMatch()) {
+        const QString base = match.captured(1);
+        return base.endsWith(".") ? base.mid(0, base.length() - 1) : base;
+    }
+
+    match = rarRx.match(fileName);
+    if (match.hasMatch()) {
+        return match.captured(1);
+    }
+
+    return fileName;
+}
+
+bool DownloadFileSearcher::isPackage(const QFileInfo& file) const
+{
+    static const QRegularExpression partRx("^r[0-9]*$");
+
+    const QString suffix = file.suffix();
+    return suffix == "rar" || partRx.match(suffix).hasMatch();
+}
+
+bool DownloadFileSearcher::isImportable(const QFileInfo& file) const
+{
+    return m_importFilters.matches(file);
+}
+
+bool DownloadFileSearcher::isSubtitle(const QFileInfo& file) const
+{
+    return m_subtitleFilters.matches(file);
+}
+
 } // namespace mediaelch
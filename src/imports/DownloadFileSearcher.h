@@ -2,8 +2,13 @@
 
 #include "settings/Settings.h"
 
-#include <QDirIterator>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <QRegExp>
+#include <QSet>
 #include <QString>
+#include <QVector>
 
 namespace mediaelch {
 
@@ -56,6 +61,43 @@ public:
     QMap<QString, Import> imports() { return m_imports; }
 
 private:
+    /// \brief Filters of MediaElch's settings, compiled once per scan.
+    struct Filters
+    {
+        /// Suffixes of simple filters like "*.mkv". Checked using a hash lookup.
+        QSet<QString> suffixes;
+        /// All other wildcard filters.
+        QVector<QRegExp> patterns;
+
+        bool matches(const QFileInfo& file) const;
+    };
+
+    /// \brief Scan result of a single file. Cached as long as the
+    ///        directory's modification time does not change.
+    struct ScannedFile
+    {
+        QString filePath;
+        QString baseName;
+        bool isPackage = false;
+        bool isImportable = false;
+        bool isSubtitle = false;
+    };
+
+    struct ScannedDirectory
+    {
+        QDateTime lastModified;
+        QVector<ScannedFile> files;
+        QStringList subDirectories;
+    };
+
+    void scanDirectory(const QString& path, QSet<QString>& visited);
+    ScannedDirectory scannedDirectory(const QFileInfo& dir);
+    void addFile(const ScannedFile& file);
+
+    static Filters compileFilters(const QStringList& filters);
+    /// \brief Results of previous scans. DownloadsWidget creates a new searcher for each scan.
+    static QHash<QString, ScannedDirectory>& directoryCache();
+
     /// \brief Extract the base file name of the given file, i.e. remove all part
     ///        data (e.g. "part1", ".r2") from the file name.
     QString baseName(const QFileInfo& fileInfo) const;
@@ -77,6 +119,12 @@ private:
 
     bool m_scanDownloads = false;
     bool m_scanImports = false;
+
+    Filters m_importFilters;
+    Filters m_subtitleFilters;
+    /// Used for grouping during a scan; copied to m_packages and m_imports afterwards.
+    QHash<QString, Package> m_packageIndex;
+    QHash<QString, Import> m_importIndex;
 };
 
 } // namespace mediaelch
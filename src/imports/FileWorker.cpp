@@ -2,6 +2,33 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QPair>
+#include <QStorageInfo>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent/QtConcurrentRun>
+
+/// Returns the device of the file system the given file will be stored on.
+/// The file and its parent directories do not need to exist.
+static QByteArray deviceOf(const QString& filePath)
+{
+    QString dirPath = QFileInfo(filePath).absolutePath();
+    while (!QFileInfo::exists(dirPath)) {
+        const QString parent = QFileInfo(dirPath).absolutePath();
+        if (parent == dirPath) {
+            break;
+        }
+        dirPath = parent;
+    }
+    return QStorageInfo(dirPath).device();
+}
+
+static qint64 bytesPerSecond(qint64 bytes, qint64 elapsedMs)
+{
+    return elapsedMs > 0 ? bytes * 1000 / elapsedMs : 0;
+}
 
 FileWorker::FileWorker(QObject* parent) : QObject(parent)
 {
@@ -19,22 +46,105 @@ QMap<QString, QString> FileWorker::files()
 
 void FileWorker::copyFiles()
 {
-    QMapIterator<QString, QString> it(files());
-    while (it.hasNext()) {
-        it.next();
-        MyFile file(it.key());
-        file.copy(it.value());
-    }
+    transferFiles(false);
     emit sigFinished();
 }
 
 void FileWorker::moveFiles()
 {
+    transferFiles(true);
+    emit sigFinished();
+}
+
+void FileWorker::transferFiles(bool move)
+{
+    m_bytesTransferred = 0;
+    m_bytesTotal = 0;
+    m_lastProgressMs = 0;
+
+    QMap<QByteArray, QVector<QPair<QString, QString>>> filesPerDevice;
     QMapIterator<QString, QString> it(files());
     while (it.hasNext()) {
         it.next();
-        MyFile file(it.key());
-        file.rename(it.value());
+        m_bytesTotal += QFileInfo(it.key()).size();
+        filesPerDevice[deviceOf(it.value())].append(qMakePair(it.key(), it.value()));
     }
-    emit sigFinished();
+
+    m_elapsed.start();
+
+    // One thread per destination device.
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, filesPerDevice.size()));
+    for (const auto& deviceFiles : filesPerDevice) {
+        QtConcurrent::run(&pool, [this, deviceFiles, move]() {
+            for (const auto& file : deviceFiles) {
+                transferFile(file.first, file.second, move);
+            }
+        });
+    }
+    pool.waitForDone();
+
+    const qint64 transferred = m_bytesTransferred;
+    const qint64 elapsedMs = m_elapsed.elapsed();
+    qDebug() << "[FileWorker] Transferred" << transferred << "bytes in" << elapsedMs << "ms |"
+             << bytesPerSecond(transferred, elapsedMs) << "bytes/s";
+    emit sigProgress(transferred, m_bytesTotal, bytesPerSecond(transferred, elapsedMs));
+}
+
+bool FileWorker::transferFile(const QString& source, const QString& destination, bool move)
+{
+    if (move && deviceOf(source) == deviceOf(destination)) {
+        // Same file system: Renaming is cheap.
+        const qint64 size = QFileInfo(source).size();
+        if (QFile(source).rename(destination)) {
+            addProgress(size);
+            return true;
+        }
+        // E.g. bind mounts report the same device but can't be renamed across.
+        qDebug() << "[FileWorker] Could not rename" << source << "to" << destination << "| copying it instead";
+    }
+
+    const bool success = copyFile(source, destination, move);
+    if (!success) {
+        qWarning() << "[FileWorker] Could not transfer" << source << "to" << destination;
+    }
+    return success;
+}
+
+bool FileWorker::copyFile(const QString& source, const QString& destination, bool removeSource)
+{
+    MyFile file(source);
+    QByteArray checksum;
+    if (!file.copy(destination, [this](qint64 bytes) { addProgress(bytes); }, removeSource ? &checksum : nullptr)) {
+        return false;
+    }
+    if (!removeSource) {
+        return true;
+    }
+
+    // Only delete the source if the copy is known to be identical.
+    if (MyFile::checksum(destination) != checksum) {
+        qWarning() << "[FileWorker] Checksum mismatch after copying" << source << "to" << destination;
+        QFile::remove(destination);
+        return false;
+    }
+    if (!QFile::remove(source)) {
+        qWarning() << "[FileWorker] Could not remove source file after moving it:" << source;
+    }
+    return true;
+}
+
+void FileWorker::addProgress(qint64 bytes)
+{
+    const qint64 transferred = (m_bytesTransferred += bytes);
+
+    QMutexLocker locker(&m_progressMutex);
+    const qint64 elapsedMs = m_elapsed.elapsed();
+    if (elapsedMs - m_lastProgressMs < 250) {
+        return;
+    }
+    m_lastProgressMs = elapsedMs;
+    locker.unlock();
+
+    emit sigProgress(transferred, m_bytesTotal, bytesPerSecond(transferred, elapsedMs));
 }
@@ -2,9 +2,15 @@
 
 #include "imports/MyFile.h"
 
+#include <QElapsedTimer>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
+#include <atomic>
 
+/// Copies or moves files of an import. Files are transferred in parallel
+/// if their destinations are located on different devices; transfers to the
+/// same device are done one after the other to avoid disk thrashing.
 class FileWorker : public QObject
 {
     Q_OBJECT
@@ -19,7 +25,22 @@ public slots:
 
 signals:
     void sigFinished();
+    /// Progress of all files. bytesPerSecond is the average throughput since the start.
+    void sigProgress(qint64 bytesTransferred, qint64 bytesTotal, qint64 bytesPerSecond);
+
+private:
+    void transferFiles(bool move);
+    bool transferFile(const QString& source, const QString& destination, bool move);
+    /// Copies the file and, if removeSource is set, removes the source once the checksums match.
+    bool copyFile(const QString& source, const QString& destination, bool removeSource);
+    void addProgress(qint64 bytes);
 
 private:
     QMap<QString, QString> m_files;
+
+    std::atomic<qint64> m_bytesTransferred{0};
+    qint64 m_bytesTotal = 0;
+    QElapsedTimer m_elapsed;
+    qint64 m_lastProgressMs = 0;
+    QMutex m_progressMutex;
 };
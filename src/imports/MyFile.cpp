@@ -1,13 +1,22 @@
 #include "MyFile.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QFileInfo>
 
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <sys/sendfile.h>
+#endif
+
+/// Large buffers reduce the number of syscalls, which is important for network shares.
+static constexpr qint64 s_copyBufferSize = 4 * 1024 * 1024;
+
 MyFile::MyFile(const QString& name) : QFile(name)
 {
 }
 
-bool MyFile::copy(const QString& newName)
+bool MyFile::copy(const QString& newName, const ProgressCallback& progress, QByteArray* checksum)
 {
     if (fileName().isEmpty()) {
         qWarning() << "QFile::copy: Empty or null file name";
@@ -18,50 +27,115 @@ bool MyFile::copy(const QString& newName)
     }
     unsetError();
     close();
-    if (error() == QFile::NoError) {
-        bool error = false;
-        if (!open(QFile::ReadOnly)) {
-            error = true;
-        } else {
-            QFile out(newName);
-            if (!out.open(QIODevice::ReadWrite)) {
-                error = true;
-            }
-            if (error) {
-                out.close();
-                close();
-            } else {
-                char block[4096]; // NOLINT: This file neeeds a refactoring nonetheless; allow c array for now
-                qint64 totalRead = 0;
-                while (!atEnd()) {
-                    qint64 in = read(block, sizeof(block));
-                    if (in <= 0) {
-                        break;
-                    }
-                    totalRead += in;
-                    if (in != out.write(block, in)) {
-                        close();
-                        error = true;
-                        break;
-                    }
-                }
+    if (!open(QFile::ReadOnly | QFile::Unbuffered)) {
+        return false;
+    }
+    QFile out(newName);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        close();
+        return false;
+    }
+
+    bool success = false;
+    if (checksum == nullptr) {
+        success = copyInKernel(out, progress);
+    }
+    // Fall back to buffered copies if nothing could be copied by the kernel,
+    // e.g. because sendfile() is not supported by the file system.
+    if (!success && out.size() == 0) {
+        success = copyBuffered(out, progress, checksum);
+    }
+    out.close();
+
+    if (!success) {
+        qWarning() << "[MyFile] Could not copy" << fileName() << "to" << newName;
+        out.remove();
+        close();
+        return false;
+    }
+
+    QFile::setPermissions(newName, permissions());
+    close();
+    unsetError();
+    return true;
+}
+
+bool MyFile::copyBuffered(QFile& out, const ProgressCallback& progress, QByteArray* checksum)
+{
+    if (!seek(0)) {
+        return false;
+    }
+    QByteArray buffer(static_cast<int>(s_copyBufferSize), Qt::Uninitialized);
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    qint64 totalRead = 0;
+    while (true) {
+        const qint64 in = read(buffer.data(), buffer.size());
+        if (in < 0) {
+            return false;
+        }
+        if (in == 0) {
+            break;
+        }
+        if (checksum != nullptr) {
+            hash.addData(buffer.constData(), static_cast<int>(in));
+        }
+        if (in != out.write(buffer.constData(), in)) {
+            return false;
+        }
+        totalRead += in;
+        if (progress) {
+            progress(in);
+        }
+    }
 
-                if (totalRead != size()) {
-                    // Unable to read from the source. The error string is
-                    // already set from read().
-                    error = true;
-                }
-                if (error) {
-                    out.remove();
-                }
-            }
+    if (totalRead != size()) {
+        // Unable to read from the source. The error string is
+        // already set from read().
+        return false;
+    }
+    if (checksum != nullptr) {
+        *checksum = hash.result();
+    }
+    return true;
+}
+
+bool MyFile::copyInKernel(QFile& out, const ProgressCallback& progress)
+{
+#ifdef Q_OS_LINUX
+    const int inFd = handle();
+    const int outFd = out.handle();
+    qint64 remaining = size();
+    while (remaining > 0) {
+        const auto chunk = static_cast<size_t>(qMin(remaining, 16 * s_copyBufferSize));
+        const ssize_t written = ::sendfile(outFd, inFd, nullptr, chunk);
+        if (written < 0 && errno == EINTR) {
+            continue;
         }
-        if (!error) {
-            QFile::setPermissions(newName, permissions());
-            close();
-            unsetError();
-            return true;
+        if (written <= 0) {
+            return false;
+        }
+        remaining -= written;
+        if (progress) {
+            progress(written);
         }
     }
+    return true;
+#else
+    Q_UNUSED(out)
+    Q_UNUSED(progress)
     return false;
+#endif
+}
+
+QByteArray MyFile::checksum(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+    return hash.result();
 }
@@ -1,10 +1,25 @@
 #pragma once
+#include <QByteArray>
 #include <QFile>
+#include <functional>
 
 class MyFile : public QFile
 {
     Q_OBJECT
 public:
+    /// Called with the number of bytes that were written since the last call.
+    using ProgressCallback = std::function<void(qint64 bytes)>;
+
     explicit MyFile(const QString& name);
-    bool copy(const QString& newName);
+    /// Copies the file to newName, which must not exist. On Linux, the kernel copies the
+    /// data (sendfile) unless a checksum is requested. Otherwise large buffers are used.
+    /// If checksum is not null, it is set to the checksum of the data that was read.
+    bool copy(const QString& newName, const ProgressCallback& progress = nullptr, QByteArray* checksum = nullptr);
+
+    /// Checksum of the file's content as used by copy(). Returns an empty array on errors.
+    static QByteArray checksum(const QString& fileName);
+
+private:
+    bool copyBuffered(QFile& out, const ProgressCallback& progress, QByteArray* checksum);
+    bool copyInKernel(QFile& out, const ProgressCallback& progress);
 };
@@ -2,9 +2,12 @@
 
 #include "settings/Settings.h"
 
+#include <QHash>
 #include <QMessageBox>
 
-static QFile data;
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #if defined(Q_OS_MAC) || defined(Q_OS_LINUX)
 #include <unistd.h>
@@ -75,24 +78,76 @@ void initLoggingPattern()
     qSetMessagePattern(pattern);
 }
 
-void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+static LogWriter& logWriter()
 {
-#ifdef Q_OS_WIN
-    const QString newLine = "\r\n";
-#else
-    const QString newLine = "\n";
-#endif
+    // Never deleted, so that messages logged during static destruction don't
+    // access a destroyed writer.  See shutdownLogging().
+    static auto* writer = new LogWriter();
+    return *writer;
+}
+
+using LogLevels = QHash<QString, int>;
+
+/// Minimum severity per category.  Replaced as a whole by setLogLevel() so that
+/// messageHandler() can read it without locking.
+static std::shared_ptr<const LogLevels> s_logLevels = std::make_shared<const LogLevels>();
+static std::atomic<int> s_defaultLogLevel{0};
+/// Only guards setLogLevel() and resetLogLevels() against each other.
+static std::mutex s_logLevelsMutex;
+
+/// QtMsgType's values are not ordered by severity.
+static int severity(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return 0;
+    case QtInfoMsg: return 1;
+    case QtWarningMsg: return 2;
+    case QtCriticalMsg: return 3;
+    case QtFatalMsg: return 4;
+    }
+    return 0;
+}
+
+static QString logCategory(const QMessageLogContext& context, const QString& msg)
+{
+    if (context.category != nullptr && qstrcmp(context.category, "default") != 0) {
+        return QString::fromLatin1(context.category);
+    }
+    // Most messages start with their component, e.g. "[ImdbApi] ..."
+    if (msg.startsWith('[')) {
+        const int end = msg.indexOf(']');
+        if (end > 1 && end < 64) {
+            return msg.mid(1, end - 1);
+        }
+    }
+    return QString();
+}
 
-    QTextStream out(stderr);
-    if (data.isOpen()) {
-        out.setDevice(&data);
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+    if (type != QtFatalMsg && !std::atomic_load(&s_logLevels)->isEmpty()) {
+        if (!isLogLevelEnabled(logCategory(context, msg), type)) {
+            return;
+        }
+    } else if (severity(type) < s_defaultLogLevel.load(std::memory_order_relaxed)) {
+        return;
     }
 
-    out << qFormatLogMessage(type, context, msg) << newLine;
+    QByteArray message = qFormatLogMessage(type, context, msg).toLocal8Bit();
+    LogWriter& writer = logWriter();
 
     if (type == QtFatalMsg) {
+        writer.writeSync(message);
         abort();
     }
+
+    if (writer.isRunning()) {
+        // May drop the message if the buffer is full, see LogOverflowPolicy.
+        writer.write(std::move(message));
+    } else {
+        // After shutdownLogging()
+        writer.writeSync(message);
+    }
 }
 
 bool openLogFile(const QString& filePath)
@@ -101,16 +156,75 @@ bool openLogFile(const QString& filePath)
         return true;
     }
 
-    data.setFileName(filePath);
-
-    return data.open(QFile::WriteOnly | QFile::Truncate);
+    return logWriter().openFile(filePath);
 }
 
 void closeLogFile()
 {
-    if (data.isOpen()) {
-        data.close();
+    logWriter().closeFile();
+}
+
+void shutdownLogging()
+{
+    logWriter().stop();
+}
+
+void setLogLevel(const QString& category, QtMsgType minimumLevel)
+{
+    if (category.isEmpty()) {
+        s_defaultLogLevel.store(severity(minimumLevel));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(s_logLevelsMutex);
+    auto levels = std::make_shared<LogLevels>(*std::atomic_load(&s_logLevels));
+    levels->insert(category, severity(minimumLevel));
+    std::atomic_store(&s_logLevels, std::shared_ptr<const LogLevels>(std::move(levels)));
+}
+
+void resetLogLevels()
+{
+    std::lock_guard<std::mutex> lock(s_logLevelsMutex);
+    s_defaultLogLevel.store(0);
+    std::atomic_store(&s_logLevels, std::make_shared<const LogLevels>());
+}
+
+bool isLogLevelEnabled(const QString& category, QtMsgType type)
+{
+    if (type == QtFatalMsg) {
+        return true;
     }
+    const std::shared_ptr<const LogLevels> levels = std::atomic_load(&s_logLevels);
+    const int minimum = levels->value(category, s_defaultLogLevel.load(std::memory_order_relaxed));
+    return severity(type) >= minimum;
+}
+
+bool logLevelFromString(const QString& name, QtMsgType& level)
+{
+    const QString lower = name.trimmed().toLower();
+    if (lower == "debug") {
+        level = QtDebugMsg;
+    } else if (lower == "info") {
+        level = QtInfoMsg;
+    } else if (lower == "warning") {
+        level = QtWarningMsg;
+    } else if (lower == "critical") {
+        level = QtCriticalMsg;
+    } else if (lower == "fatal") {
+        level = QtFatalMsg;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void setLogOverflowPolicy(LogOverflowPolicy policy)
+{
+    logWriter().setOverflowPolicy(policy);
+}
+
+void setLogFileRotation(qint64 maxFileSize, int maxFiles)
+{
+    logWriter().setRotation(maxFileSize, maxFiles);
 }
 
 } // namespace mediaelch
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "log/LogWriter.h"
+
 #include <QDebug>
+#include <QString>
 
 namespace mediaelch {
 
@@ -17,6 +20,10 @@ void initLoggingPattern();
 /// messages are redirected to that.  Otherwise stderr is used.
 /// Repects QT_MESSAGE_PATTERN.
 ///
+/// Messages are only formatted on the calling thread and are written by a
+/// background thread, see LogWriter.  Fatal messages are written synchronously.
+/// Messages below the level set via setLogLevel() are discarded.
+///
 /// \see initLoggingPattern()
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg);
 
@@ -27,4 +34,29 @@ bool openLogFile(const QString& filePath);
 /// \brief Closes the currently used log file if it is opened.
 void closeLogFile();
 
+/// \brief Writes all pending messages and stops the background writer.
+/// Messages logged afterwards are written synchronously to stderr.
+void shutdownLogging();
+
+/// \brief Sets the minimum level of messages that are logged for the given category.
+///
+/// The category is either the name of the message's QLoggingCategory or, for
+/// messages of the default category, the component prefix of the message, e.g.
+/// "ImdbApi" for "[ImdbApi] Network Error".  An empty category sets the level
+/// for all categories without a level of their own.  Can be called at any time.
+/// Fatal messages are always logged.
+void setLogLevel(const QString& category, QtMsgType minimumLevel);
+/// \brief Removes all levels set via setLogLevel(). All messages are logged again.
+void resetLogLevels();
+bool isLogLevelEnabled(const QString& category, QtMsgType type);
+
+/// \brief Parses "debug", "info", "warning", "critical" and "fatal".
+/// \returns False if the name is unknown.
+bool logLevelFromString(const QString& name, QtMsgType& level);
+
+void setLogOverflowPolicy(LogOverflowPolicy policy);
+/// \brief Rotates the log file once it exceeds maxFileSize bytes. maxFiles rotated
+/// files are kept.  A size of 0 disables rotation.
+void setLogFileRotation(qint64 maxFileSize, int maxFiles);
+
 } // namespace mediaelch
@@ -0,0 +1,282 @@
+#include "log/LogWriter.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace mediaelch {
+
+#ifdef Q_OS_WIN
+static const char s_newLine[] = "\r\n";
+#else
+static const char s_newLine[] = "\n";
+#endif
+
+/// Messages are collected into batches of about this size so that the output is not
+/// flushed for every single message.
+static constexpr int s_maxBatchSize = 64 * 1024;
+
+/// The writer sleeps at most this long, even if no thread wakes it up.
+static constexpr std::chrono::milliseconds s_maxSleep{100};
+
+static std::size_t nextPowerOfTwo(int value)
+{
+    std::size_t result = 2;
+    while (result < static_cast<std::size_t>(value)) {
+        result <<= 1;
+    }
+    return result;
+}
+
+LogWriter::LogWriter(int capacity) :
+    m_capacity{nextPowerOfTwo(capacity)}, m_mask{m_capacity - 1}, m_buffer{new Cell[m_capacity]}
+{
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+LogWriter::~LogWriter()
+{
+    stop();
+}
+
+bool LogWriter::write(QByteArray message)
+{
+    if (!isRunning()) {
+        return false;
+    }
+    while (!tryEnqueue(message)) {
+        if (static_cast<LogOverflowPolicy>(m_overflowPolicy.load(std::memory_order_relaxed))
+            == LogOverflowPolicy::Drop) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            m_totalDropped.fetch_add(1, std::memory_order_relaxed);
+            wakeWriter();
+            return false;
+        }
+        wakeWriter();
+        std::this_thread::yield();
+        if (!isRunning()) {
+            return false;
+        }
+    }
+    wakeWriter();
+    return true;
+}
+
+void LogWriter::writeSync(const QByteArray& message)
+{
+    if (isRunning()) {
+        flush();
+    }
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    writeBatch(message + s_newLine);
+}
+
+void LogWriter::flush()
+{
+    if (!isRunning()) {
+        return;
+    }
+    const std::size_t target = m_enqueuePos.load(std::memory_order_acquire);
+    m_flushRequests.fetch_add(1);
+    wakeWriter();
+    {
+        std::unique_lock<std::mutex> lock(m_wakeupMutex);
+        m_flushed.wait(lock, [this, target]() {
+            return m_writtenPos.load() >= target || m_writerFinished;
+        });
+    }
+    m_flushRequests.fetch_sub(1);
+}
+
+void LogWriter::stop()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    m_stopRequested.store(true);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        m_wakeup.notify_one();
+    }
+    m_thread.join();
+    closeFile();
+}
+
+bool LogWriter::openFile(const QString& filePath)
+{
+    flush();
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_file.setFileName(filePath);
+    m_fileSize = 0;
+    return m_file.open(QFile::WriteOnly | QFile::Truncate);
+}
+
+void LogWriter::closeFile()
+{
+    flush();
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+void LogWriter::setOverflowPolicy(LogOverflowPolicy policy)
+{
+    m_overflowPolicy.store(static_cast<int>(policy), std::memory_order_relaxed);
+}
+
+void LogWriter::setRotation(qint64 maxFileSize, int maxFiles)
+{
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    m_maxFileSize = qMax<qint64>(0, maxFileSize);
+    m_maxFiles = qMax(0, maxFiles);
+}
+
+bool LogWriter::tryEnqueue(QByteArray& message)
+{
+    // Bounded multi-producer queue as described by Dmitry Vyukov: Each cell's sequence tells
+    // whether it is free for the producer at position "pos" (sequence == pos) or contains
+    // a message for the consumer (sequence == pos + 1).
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+        cell = &m_buffer[pos & m_mask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->message = std::move(message);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogWriter::tryDequeue(QByteArray& message)
+{
+    // Only called by the writer thread, i.e. there is a single consumer.
+    Cell& cell = m_buffer[m_dequeuePos & m_mask];
+    if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) {
+        return false;
+    }
+    message = std::move(cell.message);
+    cell.message = QByteArray();
+    cell.sequence.store(m_dequeuePos + m_capacity, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+void LogWriter::wakeWriter()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerSleeping.load()) {
+        std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        m_wakeup.notify_one();
+    }
+}
+
+void LogWriter::run()
+{
+    QByteArray batch;
+    QByteArray message;
+    while (true) {
+        batch.clear();
+        while (batch.size() < s_maxBatchSize && tryDequeue(message)) {
+            batch.append(message);
+            batch.append(s_newLine);
+        }
+        const quint64 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            batch.append(QStringLiteral("[Log] %1 messages were dropped because the log buffer was full")
+                             .arg(dropped)
+                             .toLocal8Bit());
+            batch.append(s_newLine);
+        }
+
+        if (!batch.isEmpty()) {
+            {
+                std::lock_guard<std::mutex> lock(m_outputMutex);
+                writeBatch(batch);
+            }
+            m_writtenPos.store(m_dequeuePos);
+            if (m_flushRequests.load() > 0) {
+                std::lock_guard<std::mutex> lock(m_wakeupMutex);
+                m_flushed.notify_all();
+            }
+            continue;
+        }
+
+        if (m_stopRequested.load()) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeupMutex);
+        m_writerSleeping.store(true);
+        const Cell& next = m_buffer[m_dequeuePos & m_mask];
+        if (next.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1 && !m_stopRequested.load()) {
+            m_wakeup.wait_for(lock, s_maxSleep);
+        }
+        m_writerSleeping.store(false);
+    }
+
+    std::lock_guard<std::mutex> lock(m_wakeupMutex);
+    m_writerFinished = true;
+    m_flushed.notify_all();
+}
+
+void LogWriter::writeBatch(const QByteArray& batch)
+{
+    if (!m_file.isOpen()) {
+        std::fwrite(batch.constData(), 1, static_cast<std::size_t>(batch.size()), stderr);
+        std::fflush(stderr);
+        return;
+    }
+
+    if (m_maxFileSize > 0 && m_fileSize > 0 && m_fileSize + batch.size() > m_maxFileSize) {
+        rotate();
+        if (!m_file.isOpen()) {
+            writeBatch(batch);
+            return;
+        }
+    }
+    const qint64 written = m_file.write(batch);
+    m_file.flush();
+    if (written > 0) {
+        m_fileSize += written;
+    }
+}
+
+void LogWriter::rotate()
+{
+    const QString filePath = m_file.fileName();
+    m_file.close();
+
+    if (m_maxFiles > 0) {
+        const auto rotatedPath = [&filePath](int i) { return QStringLiteral("%1.%2").arg(filePath).arg(i); };
+        QFile::remove(rotatedPath(m_maxFiles));
+        for (int i = m_maxFiles - 1; i >= 1; --i) {
+            QFile::rename(rotatedPath(i), rotatedPath(i + 1));
+        }
+        QFile::rename(filePath, rotatedPath(1));
+    }
+
+    m_file.setFileName(filePath);
+    m_fileSize = 0;
+    if (!m_file.open(QFile::WriteOnly | QFile::Truncate)) {
+        // Can't use qWarning() here; see class documentation.
+        std::fprintf(stderr, "[Log] Could not reopen the log file after rotating it\n");
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mediaelch {
+
+/// \brief What LogWriter::write() does if the buffer is full.
+enum class LogOverflowPolicy
+{
+    /// The message is discarded and counted. The number of dropped messages is logged
+    /// as soon as there is space again. The logging thread never waits.
+    Drop,
+    /// The logging thread waits until the writer thread has made space. No message is lost.
+    Block
+};
+
+/// \brief Writes log messages to stderr or a log file on a background thread.
+///
+/// Messages are passed through a bounded lock-free ring buffer that can be written to by
+/// many threads at once. Only the writer thread touches the output, so logging from the
+/// GUI or a file searcher never waits for the disk (unless LogOverflowPolicy::Block is used
+/// and the buffer is full).
+///
+/// If a maximum file size is set, the log file is rotated once it would exceed that size:
+/// "MediaElch.log" becomes "MediaElch.log.1", "MediaElch.log.1" becomes "MediaElch.log.2", etc.
+///
+/// The writer itself must not log using qDebug() & co. since that would end up in its own buffer.
+class LogWriter
+{
+public:
+    /// \param capacity Number of messages the buffer can hold. Rounded up to a power of two.
+    explicit LogWriter(int capacity = 4096);
+    ~LogWriter();
+
+    /// \brief Appends the message to the buffer. The writer adds a newline.
+    /// \returns False if the message was dropped or the writer is stopped.
+    bool write(QByteArray message);
+
+    /// \brief Writes all buffered messages and then the given one on the calling thread.
+    /// Used for fatal messages, which must be written before the application aborts,
+    /// and for messages that are logged after stop().
+    void writeSync(const QByteArray& message);
+
+    /// \brief Waits until all messages written before this call are written to the output.
+    void flush();
+
+    /// \brief Flushes all messages and stops the writer thread. Messages written afterwards are
+    /// rejected. Closes the log file.
+    void stop();
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    /// \brief Redirects all following messages to the given file. The file is truncated.
+    /// Messages already in the buffer are written to the previous output.
+    bool openFile(const QString& filePath);
+    /// \brief Writes all following messages to stderr again.
+    void closeFile();
+
+    void setOverflowPolicy(LogOverflowPolicy policy);
+    /// \brief Sets the log file size after which the file is rotated and how many rotated files are kept.
+    /// A size of 0 disables rotation.
+    void setRotation(qint64 maxFileSize, int maxFiles);
+
+    /// \brief Number of messages dropped since the writer was created.
+    quint64 droppedMessages() const { return m_totalDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        QByteArray message;
+    };
+
+    bool tryEnqueue(QByteArray& message);
+    bool tryDequeue(QByteArray& message);
+    void wakeWriter();
+    void run();
+    /// \brief Writes the batch to the current output. Rotates the file if necessary.
+    /// Must be called with m_outputMutex locked.
+    void writeBatch(const QByteArray& batch);
+    void rotate();
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_buffer;
+    std::atomic<std::size_t> m_enqueuePos{0};
+    /// Only used by the writer thread.
+    std::size_t m_dequeuePos = 0;
+    std::atomic<std::size_t> m_writtenPos{0};
+
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<bool> m_writerSleeping{false};
+    std::atomic<int> m_flushRequests{0};
+    std::atomic<int> m_overflowPolicy{static_cast<int>(LogOverflowPolicy::Drop)};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_totalDropped{0};
+
+    /// Guards m_writerFinished and the condition variables.
+    std::mutex m_wakeupMutex;
+    bool m_writerFinished = false;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_flushed;
+
+    /// Guards the output. Only locked by the writer thread and by (re)configuration,
+    /// never by write().
+    std::mutex m_outputMutex;
+    QFile m_file;
+    qint64 m_fileSize = 0;
+    qint64 m_maxFileSize = 0;
+    int m_maxFiles = 0;
+
+    std::thread m_thread;
+};
+
+} // namespace mediaelch
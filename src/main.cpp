@@ -10,16 +10,25 @@
 #include <QTranslator>
 
 #include "Version.h"
+#include "data/ArtworkStage.h"
 #include "log/Log.h"
 #include "settings/Settings.h"
 #include "ui/main/MainWindow.h"
 
 static void initLogFile()
 {
-    if (!Settings::instance()->advanced()->debugLog()) {
+    const AdvancedSettings* advanced = Settings::instance()->advanced();
+    mediaelch::setLogOverflowPolicy(advanced->logOverflowPolicy());
+    const QHash<QString, QtMsgType> levels = advanced->logLevels();
+    for (auto it = levels.constBegin(); it != levels.constEnd(); ++it) {
+        mediaelch::setLogLevel(it.key(), it.value());
+    }
+
+    if (!advanced->debugLog()) {
         return;
     }
-    const QString logFile = Settings::instance()->advanced()->logFile();
+    mediaelch::setLogFileRotation(advanced->logMaxFileSize(), advanced->logMaxFiles());
+    const QString logFile = advanced->logFile();
     bool success = mediaelch::openLogFile(logFile);
     if (success) {
         return;
@@ -83,6 +92,7 @@ int main(int argc, char* argv[])
     Settings::instance(QCoreApplication::instance())->loadSettings();
 
     initLogFile();
+    mediaelch::ArtworkStage::instance().setMemoryBudget(Settings::instance()->advanced()->artworkMemoryBudget());
     loadStylesheet(app);
 
     MainWindow window;
@@ -90,6 +100,7 @@ int main(int argc, char* argv[])
     int ret = QApplication::exec();
 
     mediaelch::closeLogFile();
+    mediaelch::shutdownLogging();
 
     return ret;
 }
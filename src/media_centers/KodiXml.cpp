@@ -1,5 +1,7 @@
 #include "KodiXml.h"
 
+#include "data/ArtworkWriter.h"
+#include "file/DirectoryListingCache.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
@@ -45,6 +47,13 @@
 #include <array>
 #include <memory>
 
+/// \brief Removes the file and drops the cached listing of its directory.
+static void removeFile(const QString& fileName)
+{
+    QFile::remove(fileName);
+    mediaelch::DirectoryListingCache::instance().invalidateFileDir(fileName);
+}
+
 KodiXml::KodiXml(QObject* parent)
 {
     setParent(parent);
@@ -103,17 +112,10 @@ bool KodiXml::saveMovie(Movie* movie)
     for (auto dataFile : Settings::instance()->dataFiles(DataFileType::MovieNfo)) {
         QString saveFileName = dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, movie->files().count() > 1);
         QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qDebug() << "Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qDebug() << "Saving to" << saveFilePath;
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
             qWarning() << "File could not be openend";
         } else {
-            file.write(xmlContent);
-            file.close();
             saved = true;
         }
     }
@@ -121,9 +123,10 @@ bool KodiXml::saveMovie(Movie* movie)
         return false;
     }
 
+    mediaelch::ArtworkWriter artwork(Manager::instance()->contentHashes());
     for (const auto imageType : Movie::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
-        if (movie->images().imageHasChanged(imageType) && !movie->images().image(imageType).isNull()) {
+        if (movie->images().imageHasChanged(imageType) && !movie->images().stagedImage(imageType).isNull()) {
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName =
                     dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, movie->files().count() > 1);
@@ -135,7 +138,7 @@ bool KodiXml::saveMovie(Movie* movie)
                     && (movie->discType() == DiscType::BluRay || movie->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                saveFile(getPath(movie).filePath(saveFileName), movie->images().image(imageType));
+                artwork.add(getPath(movie).filePath(saveFileName), movie->images().stagedImage(imageType));
             }
         }
 
@@ -151,37 +154,27 @@ bool KodiXml::saveMovie(Movie* movie)
                     && (movie->discType() == DiscType::BluRay || movie->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                QFile(getPath(movie).filePath(saveFileName)).remove();
+                removeFile(getPath(movie).filePath(saveFileName));
             }
         }
     }
 
     if (movie->inSeparateFolder() && !movie->files().isEmpty()) {
         for (const QString& file : movie->images().extraFanartsToRemove()) {
-            QFile::remove(file);
+            removeFile(file);
         }
-        QDir dir(movie->files().first().dir().toString() + "/extrafanart");
-        if (!dir.exists() && !movie->images().extraFanartToAdd().isEmpty()) {
-            QDir(movie->files().first().dir().toString()).mkdir("extrafanart");
-        }
-        for (const QByteArray& img : movie->images().extraFanartToAdd()) {
-            int num = 1;
-            while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-                ++num;
-            }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+        const mediaelch::DirectoryPath dir = movie->files().first().dir().subDir("extrafanart");
+        for (const mediaelch::StagedImage& img : movie->images().extraFanartToAdd()) {
+            artwork.addExtraFanart(dir, img);
         }
     }
 
     for (const Actor* actor : movie->actors()) {
         if (!actor->image.isNull()) {
-            QDir dir;
-            dir.mkdir(fi.absolutePath() + "/" + ".actors");
-            QString actorName = actor->name;
-            actorName = actorName.replace(" ", "_");
-            saveFile(fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
+            artwork.addActorThumb(actorImagePath(fi.absolutePath(), *actor), actor->image);
         }
     }
+    artwork.commit();
 
     for (Subtitle* subtitle : movie->subtitles()) {
         if (subtitle->changed()) {
@@ -207,10 +200,11 @@ bool KodiXml::saveMovie(Movie* movie)
                 }
             }
             subtitle->setFiles(newFiles);
+            mediaelch::DirectoryListingCache::instance().invalidate(fi.absolutePath());
         }
     }
 
-    Manager::instance()->database()->update(movie);
+    Manager::instance()->databaseService()->update(movie);
 
     return true;
 }
@@ -446,8 +440,17 @@ void KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomElement elem)
 /// @param streamDetails Stream Details object
 void KodiXml::writeStreamDetails(QXmlStreamWriter& xml, StreamDetails* streamDetails)
 {
-    if (streamDetails->videoDetails().isEmpty() && streamDetails->audioDetails().isEmpty()
-        && streamDetails->subtitleDetails().isEmpty()) {
+    writeStreamDetails(xml, streamDetails, {});
+}
+
+/// @brief Writes streamdetails and external subtitles to xml stream
+void KodiXml::writeStreamDetails(QXmlStreamWriter& xml,
+    const StreamDetails* streamDetails,
+    const QVector<Subtitle*>& subtitles)
+{
+    if (streamDetails == nullptr
+        || (streamDetails->videoDetails().isEmpty() && streamDetails->audioDetails().isEmpty()
+            && streamDetails->subtitleDetails().isEmpty() && subtitles.isEmpty())) {
         return;
     }
 
@@ -507,6 +510,13 @@ void KodiXml::writeStreamDetails(QXmlStreamWriter& xml, StreamDetails* streamDet
         xml.writeEndElement();
     }
 
+    for (const Subtitle* subtitle : subtitles) {
+        xml.writeStartElement("subtitle");
+        xml.writeTextElement("language", subtitle->language());
+        xml.writeTextElement("file", subtitle->files().first());
+        xml.writeEndElement();
+    }
+
     xml.writeEndElement();
     xml.writeEndElement();
 }
@@ -612,12 +622,8 @@ QString KodiXml::actorImageName(Movie* movie, Actor actor)
     if (movie->files().isEmpty()) {
         return QString();
     }
-    QFileInfo fi(movie->files().first().toString());
-    QString actorName = actor.name;
-    actorName = actorName.replace(" ", "_");
-    QString path = fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg";
-    fi.setFile(path);
-    if (fi.isFile()) {
+    const QString path = actorImagePath(QFileInfo(movie->files().first().toString()).absolutePath(), actor);
+    if (QFileInfo(path).isFile()) {
         return path;
     }
     return QString();
@@ -655,7 +661,7 @@ bool KodiXml::saveConcert(Concert* concert)
     }
 
     concert->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(concert);
+    Manager::instance()->databaseService()->update(concert);
 
     bool saved = false;
     QFileInfo fi(concert->files().first().toString());
@@ -663,17 +669,10 @@ bool KodiXml::saveConcert(Concert* concert)
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, concert->files().size() > 1);
         QString saveFilePath = mediaelch::DirectoryPath(fi.absolutePath()).filePath(saveFileName);
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qDebug() << "[KodiXml] Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qDebug() << "[KodiXml] Saving to" << saveFilePath;
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
             qWarning() << "[KodiXml] File could not be openend";
         } else {
-            file.write(xmlContent);
-            file.close();
             saved = true;
         }
     }
@@ -681,6 +680,7 @@ bool KodiXml::saveConcert(Concert* concert)
         return false;
     }
 
+    mediaelch::ArtworkWriter artwork(Manager::instance()->contentHashes());
     for (const auto imageType : Concert::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
         if (concert->imageHasChanged(imageType) && !concert->image(imageType).isNull()) {
@@ -695,7 +695,7 @@ bool KodiXml::saveConcert(Concert* concert)
                     && (concert->discType() == DiscType::BluRay || concert->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                saveFile(getPath(concert).filePath(saveFileName), concert->image(imageType));
+                artwork.add(getPath(concert).filePath(saveFileName), concert->image(imageType));
             }
         }
         if (concert->imagesToRemove().contains(imageType)) {
@@ -710,27 +710,21 @@ bool KodiXml::saveConcert(Concert* concert)
                     && (concert->discType() == DiscType::BluRay || concert->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                QFile(getPath(concert).filePath(saveFileName)).remove();
+                removeFile(getPath(concert).filePath(saveFileName));
             }
         }
     }
 
     if (concert->inSeparateFolder() && !concert->files().isEmpty()) {
         for (const QString& file : concert->extraFanartsToRemove()) {
-            QFile::remove(file);
-        }
-        QDir dir(QFileInfo(concert->files().first().toString()).absolutePath() + "/extrafanart");
-        if (!dir.exists() && !concert->extraFanartImagesToAdd().isEmpty()) {
-            QDir(QFileInfo(concert->files().first().toString()).absolutePath()).mkdir("extrafanart");
+            removeFile(file);
         }
+        const mediaelch::DirectoryPath dir = concert->files().first().dir().subDir("extrafanart");
         for (const QByteArray& img : concert->extraFanartImagesToAdd()) {
-            int num = 1;
-            while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-                ++num;
-            }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            artwork.addExtraFanart(dir, img);
         }
     }
+    artwork.commit();
 
     return true;
 }
@@ -792,11 +786,8 @@ QString KodiXml::actorImageName(TvShow* show, Actor actor)
     if (!show->dir().isValid()) {
         return QString();
     }
-    QString actorName = actor.name;
-    actorName = actorName.replace(" ", "_");
-    QString fileName = show->dir().subDir(".actors").filePath(actorName + ".jpg");
-    QFileInfo fi(fileName);
-    if (fi.isFile()) {
+    const QString fileName = actorImagePath(show->dir(), actor);
+    if (QFileInfo(fileName).isFile()) {
         return fileName;
     }
     return QString();
@@ -807,12 +798,8 @@ QString KodiXml::actorImageName(TvShowEpisode* episode, Actor actor)
     if (episode->files().isEmpty()) {
         return QString();
     }
-    QFileInfo fi(episode->files().first().toString());
-    QString actorName = actor.name;
-    actorName = actorName.replace(" ", "_");
-    QString path = fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg";
-    fi.setFile(path);
-    if (fi.isFile()) {
+    const QString path = actorImagePath(QFileInfo(episode->files().first().toString()).absolutePath(), actor);
+    if (QFileInfo(path).isFile()) {
         return path;
     }
     return QString();
@@ -957,35 +944,29 @@ bool KodiXml::saveTvShow(TvShow* show)
     }
 
     show->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(show);
+    Manager::instance()->databaseService()->update(show);
 
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowNfo)) {
         QString saveFilePath = show->dir().filePath(dataFile.saveFileName(""));
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qWarning() << "[KodiXml] Nfo file could not be openend for writing" << file.fileName();
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning() << "[KodiXml] Nfo file could not be openend for writing" << saveFilePath;
             return false;
         }
-        file.write(xmlContent);
-        file.close();
     }
 
+    mediaelch::ArtworkWriter artwork(Manager::instance()->contentHashes());
     for (const auto imageType : TvShow::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
         if (show->imageHasChanged(imageType) && !show->image(imageType).isNull()) {
             for (auto dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName("");
-                saveFile(show->dir().filePath(saveFileName), show->image(imageType));
+                artwork.add(show->dir().filePath(saveFileName), show->image(imageType));
             }
         }
         if (show->imagesToRemove().contains(imageType)) {
             for (auto dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName("");
-                QFile(show->dir().filePath(saveFileName)).remove();
+                removeFile(show->dir().filePath(saveFileName));
             }
         }
     }
@@ -996,14 +977,14 @@ bool KodiXml::saveTvShow(TvShow* show)
             if (show->seasonImageHasChanged(season, imageType) && !show->seasonImage(season, imageType).isNull()) {
                 for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                     QString saveFileName = dataFile.saveFileName("", season);
-                    saveFile(show->dir().filePath(saveFileName), show->seasonImage(season, imageType));
+                    artwork.add(show->dir().filePath(saveFileName), show->seasonImage(season, imageType));
                 }
             }
             if (show->imagesToRemove().contains(imageType)
                 && show->imagesToRemove().value(imageType).contains(season)) {
                 for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                     QString saveFileName = dataFile.saveFileName("", season);
-                    QFile(show->dir().filePath(saveFileName)).remove();
+                    removeFile(show->dir().filePath(saveFileName));
                 }
             }
         }
@@ -1011,30 +992,20 @@ bool KodiXml::saveTvShow(TvShow* show)
 
     if (show->dir().isValid()) {
         for (const QString& file : show->extraFanartsToRemove()) {
-            QFile::remove(file);
-        }
-        QDir dir(show->dir().toString() + "/extrafanart");
-        if (!dir.exists() && !show->extraFanartImagesToAdd().isEmpty()) {
-            QDir(show->dir().toString()).mkdir("extrafanart");
+            removeFile(file);
         }
+        const mediaelch::DirectoryPath dir = show->dir().subDir("extrafanart");
         for (const QByteArray& img : show->extraFanartImagesToAdd()) {
-            int num = 1;
-            while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
-                ++num;
-            }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            artwork.addExtraFanart(dir, img);
         }
     }
 
     for (const Actor* actor : show->actors()) {
         if (!actor->image.isNull()) {
-            QDir dir;
-            dir.mkdir(show->dir().toString() + "/" + ".actors");
-            QString actorName = actor->name;
-            actorName = actorName.replace(" ", "_");
-            saveFile(show->dir().toString() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
+            artwork.addActorThumb(actorImagePath(show->dir(), *actor), actor->image);
         }
     }
+    artwork.commit();
 
     return true;
 }
@@ -1067,7 +1038,7 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         subEpisode->setNfoContent(xmlContent);
         subEpisode->setSyncNeeded(true);
         subEpisode->setChanged(false);
-        Manager::instance()->database()->update(subEpisode);
+        Manager::instance()->databaseService()->update(subEpisode);
     }
 
     QFileInfo fi(episode->files().first().toString());
@@ -1075,32 +1046,26 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
         QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
             qWarning() << "[KodiXml] Nfo file could not be opened for writing" << saveFileName;
             return false;
         }
-        file.write(xmlContent);
-        file.close();
     }
 
+    mediaelch::ArtworkWriter artwork(Manager::instance()->contentHashes());
     fi.setFile(episode->files().first().toString());
     if (episode->thumbnailImageChanged() && !episode->thumbnailImage().isNull()) {
         if (helper::isBluRay(episode->files().at(0)) || helper::isDvd(episode->files().first())) {
             QDir dir = fi.dir();
             dir.cdUp();
-            saveFile(dir.absolutePath() + "/thumb.jpg", episode->thumbnailImage());
+            artwork.add(dir.absolutePath() + "/thumb.jpg", episode->thumbnailImage());
         } else if (helper::isDvd(episode->files().first(), true)) {
-            saveFile(fi.dir().absolutePath() + "/thumb.jpg", episode->thumbnailImage());
+            artwork.add(fi.dir().absolutePath() + "/thumb.jpg", episode->thumbnailImage());
         } else {
             for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowEpisodeThumb)) {
                 QString saveFileName =
                     dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
-                saveFile(fi.absolutePath() + "/" + saveFileName, episode->thumbnailImage());
+                artwork.add(fi.absolutePath() + "/" + saveFileName, episode->thumbnailImage());
             }
         }
     }
@@ -1110,14 +1075,14 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         if (helper::isBluRay(episode->files().first()) || helper::isDvd(episode->files().at(0))) {
             QDir dir = fi.dir();
             dir.cdUp();
-            QFile(dir.absolutePath() + "/thumb.jpg").remove();
+            removeFile(dir.absolutePath() + "/thumb.jpg");
         } else if (helper::isDvd(episode->files().first(), true)) {
-            QFile(fi.dir().absolutePath() + "/thumb.jpg").remove();
+            removeFile(fi.dir().absolutePath() + "/thumb.jpg");
         } else {
             for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowEpisodeThumb)) {
                 QString saveFileName =
                     dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
-                QFile(fi.absolutePath() + "/" + saveFileName).remove();
+                removeFile(fi.absolutePath() + "/" + saveFileName);
             }
         }
     }
@@ -1125,13 +1090,10 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
     fi.setFile(episode->files().first().toString());
     for (const Actor* actor : episode->actors()) {
         if (!actor->image.isNull()) {
-            QDir dir;
-            dir.mkdir(fi.absolutePath() + "/" + ".actors");
-            QString actorName = actor->name;
-            actorName = actorName.replace(" ", "_");
-            saveFile(fi.absolutePath() + "/" + ".actors" + "/" + actorName + ".jpg", actor->image);
+            artwork.addActorThumb(actorImagePath(fi.absolutePath(), *actor), actor->image);
         }
     }
+    artwork.commit();
 
     return true;
 }
@@ -1163,19 +1125,24 @@ QByteArray KodiXml::getEpisodeXml(const QVector<TvShowEpisode*>& episodes)
     return writer->getEpisodeXml();
 }
 
+/// \brief Absolute paths of all JPEG images in the given directory, e.g. "extrafanart".
+static QStringList jpegFiles(const mediaelch::DirectoryPath& dir)
+{
+    const QStringList filters = {"*.jpg", "*.jpeg", "*.JPEG", "*.Jpeg", "*.JPeg"};
+    QStringList files;
+    for (const QString& file :
+        mediaelch::DirectoryListingCache::instance().files(dir, filters, QDir::Files, QDir::Name)) {
+        files << QDir::toNativeSeparators(dir.filePath(file));
+    }
+    return files;
+}
+
 QStringList KodiXml::extraFanartNames(Movie* movie)
 {
     if (movie->files().isEmpty() || !movie->inSeparateFolder()) {
         return QStringList();
     }
-    QFileInfo fi(movie->files().first().toString());
-    QDir dir(fi.absolutePath() + "/extrafanart");
-    QStringList filters = {"*.jpg", "*.jpeg", "*.JPEG", "*.Jpeg", "*.JPeg"};
-    QStringList files;
-    for (const QString& file : dir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name)) {
-        files << QDir::toNativeSeparators(dir.path() + "/" + file);
-    }
-    return files;
+    return jpegFiles(movie->files().first().dir().subDir("extrafanart"));
 }
 
 QStringList KodiXml::extraFanartNames(Concert* concert)
@@ -1183,14 +1150,7 @@ QStringList KodiXml::extraFanartNames(Concert* concert)
     if (concert->files().isEmpty() || !concert->inSeparateFolder()) {
         return QStringList();
     }
-    QFileInfo fi(concert->files().first().toString());
-    QDir dir(fi.absolutePath() + "/extrafanart");
-    QStringList filters = {"*.jpg", "*.jpeg", "*.JPEG", "*.Jpeg", "*.JPeg"};
-    QStringList files;
-    for (const QString& file : dir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name)) {
-        files << QDir::toNativeSeparators(dir.path() + "/" + file);
-    }
-    return files;
+    return jpegFiles(concert->files().first().dir().subDir("extrafanart"));
 }
 
 QStringList KodiXml::extraFanartNames(TvShow* show)
@@ -1198,24 +1158,12 @@ QStringList KodiXml::extraFanartNames(TvShow* show)
     if (!show->dir().isValid()) {
         return QStringList();
     }
-    QDir dir(show->dir().subDir("extrafanart").toString());
-    QStringList filters = {"*.jpg", "*.jpeg", "*.JPEG", "*.Jpeg", "*.JPeg"};
-    QStringList files;
-    for (const QString& file : dir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name)) {
-        files << QDir::toNativeSeparators(dir.path() + "/" + file);
-    }
-    return files;
+    return jpegFiles(show->dir().subDir("extrafanart"));
 }
 
 QStringList KodiXml::extraFanartNames(Artist* artist)
 {
-    QDir dir(artist->path().subDir("extrafanart").toString());
-    QStringList filters = {"*.jpg", "*.jpeg", "*.JPEG", "*.Jpeg", "*.JPeg"};
-    QStringList files;
-    for (const QString& file : dir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name)) {
-        files << QDir::toNativeSeparators(dir.path() + "/" + file);
-    }
-    return files;
+    return jpegFiles(artist->path().subDir("extrafanart"));
 }
 
 QImage KodiXml::movieSetPoster(QString setName)
@@ -1250,7 +1198,12 @@ void KodiXml::saveMovieSetPoster(QString setName, QImage poster)
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::MovieSetPoster)) {
         QString fileName = movieSetFileName(setName, &dataFile);
         if (!fileName.isEmpty()) {
-            poster.save(fileName, "jpg", 100);
+            // Encode in memory first so that unchanged images are not written again.
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+            poster.save(&buffer, "jpg", 100);
+            saveFile(fileName, data);
         }
     }
 }
@@ -1263,25 +1216,29 @@ void KodiXml::saveMovieSetBackdrop(QString setName, QImage backdrop)
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::MovieSetBackdrop)) {
         QString fileName = movieSetFileName(setName, &dataFile);
         if (!fileName.isEmpty()) {
-            backdrop.save(fileName, "jpg", 100);
+            // Encode in memory first so that unchanged images are not written again.
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+            backdrop.save(&buffer, "jpg", 100);
+            saveFile(fileName, data);
         }
     }
 }
 
-bool KodiXml::saveFile(QString filename, QByteArray data)
+/// @brief Writes data to the given file. Files that already have the same
+///        content are not touched, see mediaelch::ContentHashCache.
+bool KodiXml::saveFile(QString filename, QByteArray data, QIODevice::OpenMode mode)
 {
-    QDir saveFileDir = QFileInfo(filename).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile file(filename);
+    return Manager::instance()->contentHashes()->write(mediaelch::FilePath(filename), data, mode);
+}
 
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(data);
-        file.close();
-        return true;
-    }
-    return false;
+/// @brief Path of the actor's thumbnail in the ".actors" directory of dir.
+QString KodiXml::actorImagePath(const mediaelch::DirectoryPath& dir, const Actor& actor)
+{
+    QString actorName = actor.name;
+    actorName = actorName.replace(" ", "_");
+    return dir.subDir(".actors").filePath(actorName + ".jpg");
 }
 
 mediaelch::DirectoryPath KodiXml::getPath(const Movie* movie)
@@ -1396,8 +1353,7 @@ QString KodiXml::imageFileName(const Movie* movie, ImageType type, QVector<DataF
             }
         }
         mediaelch::DirectoryPath path = getPath(movie);
-        QFileInfo pFi(path.filePath(file));
-        if (pFi.isFile() || constructName) {
+        if (constructName || mediaelch::DirectoryListingCache::instance().isFile(path, file)) {
             fileName = path.filePath(file);
             break;
         }
@@ -1440,8 +1396,7 @@ QString KodiXml::imageFileName(const Concert* concert, ImageType type, QVector<D
             }
         }
         mediaelch::DirectoryPath path = getPath(concert);
-        QFileInfo pFi(path.filePath(file));
-        if (pFi.isFile() || constructName) {
+        if (constructName || mediaelch::DirectoryListingCache::instance().isFile(path, file)) {
             fileName = path.filePath(file);
             break;
         }
@@ -1483,8 +1438,7 @@ QString KodiXml::imageFileName(const TvShow* show,
     QString fileName;
     for (DataFile dataFile : dataFiles) {
         QString loadFileName = dataFile.saveFileName("", season);
-        QFileInfo fi(show->dir().filePath(loadFileName));
-        if (fi.isFile() || constructName) {
+        if (constructName || mediaelch::DirectoryListingCache::instance().isFile(show->dir(), loadFileName)) {
             fileName = show->dir().filePath(loadFileName);
             break;
         }
@@ -1499,8 +1453,7 @@ QString saveDataFiles(mediaelch::DirectoryPath basePath,
 {
     for (DataFile dataFile : dataFiles) {
         QString file = dataFile.saveFileName(fileName);
-        QFileInfo pFi(basePath.filePath(file));
-        if (pFi.isFile() || constructName) {
+        if (constructName || mediaelch::DirectoryListingCache::instance().isFile(basePath, file)) {
             return basePath.filePath(file);
         }
     }
@@ -1525,12 +1478,12 @@ KodiXml::imageFileName(const TvShowEpisode* episode, ImageType type, QVector<Dat
         QDir dir = fi.dir();
         dir.cdUp();
         fi.setFile(dir.absolutePath() + "/thumb.jpg");
-        return fi.exists() ? fi.absoluteFilePath() : "";
+        return mediaelch::DirectoryListingCache::instance().isFile(fi.filePath()) ? fi.absoluteFilePath() : "";
     }
 
     if (helper::isDvd(episode->files().at(0), true)) {
         fi.setFile(fi.dir().absolutePath() + "/thumb.jpg");
-        return fi.exists() ? fi.absoluteFilePath() : "";
+        return mediaelch::DirectoryListingCache::instance().isFile(fi.filePath()) ? fi.absoluteFilePath() : "";
     }
 
     if (!constructName) {
@@ -1683,25 +1636,16 @@ bool KodiXml::saveArtist(Artist* artist)
     }
 
     artist->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(artist);
+    Manager::instance()->databaseService()->update(artist);
 
     QString fileName = nfoFilePath(artist);
     if (fileName.isEmpty()) {
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(fileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    {
-        QFile file(fileName);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qWarning() << "[KodiXml] File could not be openend";
-            return false;
-        }
-        file.write(xmlContent);
-        file.close();
+    if (!saveFile(fileName, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "[KodiXml] File could not be openend";
+        return false;
     }
     for (const auto imageType : Artist::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
@@ -1710,7 +1654,7 @@ bool KodiXml::saveArtist(Artist* artist)
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
                 if (!saveFileName.isEmpty()) {
-                    QFile(artist->path().filePath(saveFileName)).remove();
+                    removeFile(artist->path().filePath(saveFileName));
                 }
             }
         }
@@ -1724,7 +1668,7 @@ bool KodiXml::saveArtist(Artist* artist)
     }
 
     for (const QString& file : artist->extraFanartsToRemove()) {
-        QFile::remove(file);
+        removeFile(file);
     }
     QDir dir(artist->path().subDir("extrafanart").toString());
     if (!dir.exists() && !artist->extraFanartImagesToAdd().isEmpty()) {
@@ -1750,24 +1694,17 @@ bool KodiXml::saveAlbum(Album* album)
     }
 
     album->setNfoContent(xmlContent);
-    Manager::instance()->database()->update(album);
+    Manager::instance()->databaseService()->update(album);
 
     QString nfoFileName = nfoFilePath(album);
     if (nfoFileName.isEmpty()) {
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(nfoFileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile nfo(nfoFileName);
-    if (!nfo.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!saveFile(nfoFileName, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
         qWarning() << "[KodiXml] File could not be openend";
         return false;
     }
-    nfo.write(xmlContent);
-    nfo.close();
 
     for (const auto imageType : Album::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
@@ -1776,7 +1713,7 @@ bool KodiXml::saveAlbum(Album* album)
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
                 if (!saveFileName.isEmpty()) {
-                    QFile(album->path().filePath(saveFileName)).remove();
+                    removeFile(album->path().filePath(saveFileName));
                 }
             }
         }
@@ -1798,7 +1735,7 @@ bool KodiXml::saveAlbum(Album* album)
         // @todo: get filename from settings
         for (Image* image : album->bookletModel()->images()) {
             if (image->deletion() && !image->fileName().isEmpty()) {
-                QFile::remove(image->fileName());
+                removeFile(image->fileName());
             } else if (!image->deletion()) {
                 image->load();
             }
@@ -1808,11 +1745,7 @@ bool KodiXml::saveAlbum(Album* album)
             if (!image->deletion()) {
                 QString imageFileName = "booklet" + QString("%1").arg(bookletNum, 2, 10, QChar('0')) + ".jpg";
                 QString imageFilePath = album->path().subDir("booklet").filePath(imageFileName);
-                QFile file(imageFilePath);
-                if (file.open(QIODevice::WriteOnly)) {
-                    file.write(image->rawData());
-                    file.close();
-                }
+                saveFile(imageFilePath, image->rawData());
                 bookletNum++;
             }
         }
@@ -1930,11 +1863,9 @@ void KodiXml::loadBooklets(Album* album)
         return;
     }
 
-    QDir dir(album->path().subDir("booklet").toString());
-    QStringList filters{"*.jpg", "*.jpeg", "*.JPEG", "*.Jpeg", "*.JPeg"};
-    for (const QString& file : dir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name)) {
+    for (const QString& file : jpegFiles(album->path().subDir("booklet"))) {
         auto img = new Image;
-        img->setFileName(QDir::toNativeSeparators(dir.path() + "/" + file));
+        img->setFileName(file);
         album->bookletModel()->addImage(img);
     }
     album->bookletModel()->setHasChanged(false);
@@ -99,6 +99,9 @@ public:
     QString nfoFilePath(Album* album) override;
 
     static void writeStreamDetails(QXmlStreamWriter& xml, StreamDetails* streamDetails);
+    static void writeStreamDetails(QXmlStreamWriter& xml,
+        const StreamDetails* streamDetails,
+        const QVector<Subtitle*>& subtitles);
     static void writeStreamDetails(QDomDocument& doc,
         const StreamDetails* streamDetails,
         QVector<Subtitle*> subtitles = QVector<Subtitle*>());
@@ -119,7 +122,8 @@ private:
     QByteArray getAlbumXml(Album* album);
     bool loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc);
     void loadStreamDetails(StreamDetails* streamDetails, QDomElement elem);
-    bool saveFile(QString filename, QByteArray data);
+    bool saveFile(QString filename, QByteArray data, QIODevice::OpenMode mode = QIODevice::WriteOnly);
+    static QString actorImagePath(const mediaelch::DirectoryPath& dir, const Actor& actor);
     mediaelch::DirectoryPath getPath(const Movie* movie);
     mediaelch::DirectoryPath getPath(const Concert* concert);
     QString movieSetFileName(QString setName, DataFile* dataFile);
@@ -0,0 +1,253 @@
+#include "media_centers/kodi/NfoMergeWriter.h"
+
+#include <QDebug>
+#include <QThreadStorage>
+
+namespace mediaelch {
+namespace kodi {
+
+static QThreadStorage<QByteArray> s_threadBuffers;
+/// Most NFO files fit into this, so the buffer rarely grows.
+static constexpr int s_initialBufferCapacity = 64 * 1024;
+
+NfoMergeWriter::NfoMergeWriter(QString rootElement) : m_rootElement{std::move(rootElement)}
+{
+}
+
+void NfoMergeWriter::setTextValue(const QString& name, const QString& value)
+{
+    for (Operation& operation : m_operations) {
+        if (operation.type == Operation::Type::Text && !operation.dropped && operation.name == name) {
+            operation.value = value;
+            return;
+        }
+    }
+    Operation operation{Operation::Type::Text, name, value, nullptr};
+    operation.mayUpdateInPlace = !isReplaced(name);
+    m_operations.push_back(std::move(operation));
+}
+
+void NfoMergeWriter::setListValue(const QString& name, const QStringList& values)
+{
+    replaceElements(name, [name, values](QXmlStreamWriter& xml) {
+        for (const QString& value : values) {
+            xml.writeTextElement(name, value);
+        }
+    });
+}
+
+void NfoMergeWriter::removeChildNodes(const QString& name)
+{
+    replaceElements(name, nullptr);
+}
+
+void NfoMergeWriter::replaceElements(const QString& name, ElementWriter writer)
+{
+    for (Operation& operation : m_operations) {
+        if (operation.type == Operation::Type::Text && operation.name == name) {
+            operation.dropped = true;
+        }
+    }
+    m_operations.push_back(Operation{Operation::Type::Replace, name, QString(), std::move(writer)});
+}
+
+QByteArray NfoMergeWriter::merge(const QString& existingNfo) const
+{
+    QByteArray& buffer = threadBuffer();
+    if (!write(buffer, existingNfo)) {
+        qWarning() << "[NfoMergeWriter] Existing NFO content is not valid XML; writing a new one";
+        write(buffer, QString());
+    }
+    // Deep copy with the exact size; the buffer itself is reused.
+    return QByteArray(buffer.constData(), buffer.size());
+}
+
+QByteArray& NfoMergeWriter::threadBuffer()
+{
+    QByteArray& buffer = s_threadBuffers.localData();
+    if (buffer.capacity() < s_initialBufferCapacity) {
+        // reserve() also prevents resize(0) from freeing the memory
+        buffer.reserve(s_initialBufferCapacity);
+    }
+    buffer.resize(0);
+    return buffer;
+}
+
+bool NfoMergeWriter::write(QByteArray& buffer, const QString& existingNfo) const
+{
+    // QXmlStreamWriter overwrites the buffer from its start but doesn't truncate it.
+    buffer.resize(0);
+    QXmlStreamWriter xml(&buffer);
+    xml.setAutoFormatting(true);
+    xml.setAutoFormattingIndent(4);
+    xml.writeStartDocument("1.0", true);
+
+    QVector<bool> updated(m_operations.size(), false);
+
+    if (existingNfo.isEmpty()) {
+        xml.writeStartElement(m_rootElement);
+        writeNewElements(xml, updated);
+        xml.writeEndElement();
+        xml.writeEndDocument();
+        return true;
+    }
+
+    QXmlStreamReader reader(existingNfo);
+    bool hasRoot = false;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (!reader.isStartElement()) {
+            if (!reader.isStartDocument() && !reader.isEndDocument()) {
+                copyToken(reader, xml); // comments around the root element
+            }
+            continue;
+        }
+
+        hasRoot = true;
+        xml.writeStartElement(reader.qualifiedName().toString());
+        xml.writeAttributes(reader.attributes());
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.isEndElement()) {
+                break;
+            }
+            if (!reader.isStartElement()) {
+                copyToken(reader, xml);
+                continue;
+            }
+
+            const QString name = reader.qualifiedName().toString();
+            const int index = textOperation(name);
+            if (isReplaced(name)) {
+                reader.skipCurrentElement();
+            } else if (index >= 0 && !updated[index]) {
+                writeTextInPlace(reader, xml, m_operations[index].value);
+                updated[index] = true;
+            } else {
+                copyElement(reader, xml);
+            }
+        }
+        writeNewElements(xml, updated);
+        xml.writeEndElement();
+    }
+
+    if (reader.hasError() || !hasRoot) {
+        return false;
+    }
+    xml.writeEndDocument();
+    return true;
+}
+
+void NfoMergeWriter::writeTextInPlace(QXmlStreamReader& reader, QXmlStreamWriter& xml, const QString& value)
+{
+    xml.writeStartElement(reader.qualifiedName().toString());
+    xml.writeAttributes(reader.attributes());
+
+    bool written = false;
+    // The reader may report one text in several parts.
+    bool inReplacedText = false;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isCharacters() && !reader.isWhitespace()) {
+            if (!written) {
+                xml.writeCharacters(value);
+                written = true;
+                inReplacedText = true;
+            } else if (!inReplacedText) {
+                copyToken(reader, xml);
+            }
+            continue;
+        }
+        inReplacedText = false;
+
+        if (reader.isStartElement()) {
+            copyElement(reader, xml);
+        } else if (reader.isEndElement()) {
+            if (!written) {
+                xml.writeCharacters(value);
+            }
+            xml.writeEndElement();
+            return;
+        } else {
+            copyToken(reader, xml);
+        }
+    }
+}
+
+void NfoMergeWriter::writeNewElements(QXmlStreamWriter& xml, const QVector<bool>& updated) const
+{
+    for (int i = 0; i < m_operations.size(); ++i) {
+        const Operation& operation = m_operations[i];
+        if (operation.type == Operation::Type::Replace) {
+            if (operation.writer) {
+                operation.writer(xml);
+            }
+        } else if (!operation.dropped && !updated[i]) {
+            xml.writeTextElement(operation.name, operation.value);
+        }
+    }
+}
+
+int NfoMergeWriter::textOperation(const QString& name) const
+{
+    for (int i = 0; i < m_operations.size(); ++i) {
+        const Operation& operation = m_operations[i];
+        if (operation.type == Operation::Type::Text && !operation.dropped && operation.mayUpdateInPlace
+            && operation.name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool NfoMergeWriter::isReplaced(const QString& name) const
+{
+    for (const Operation& operation : m_operations) {
+        if (operation.type == Operation::Type::Replace && operation.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void NfoMergeWriter::copyElement(QXmlStreamReader& reader, QXmlStreamWriter& xml)
+{
+    xml.writeStartElement(reader.qualifiedName().toString());
+    xml.writeAttributes(reader.attributes());
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            copyElement(reader, xml);
+        } else if (reader.isEndElement()) {
+            xml.writeEndElement();
+            return;
+        } else {
+            copyToken(reader, xml);
+        }
+    }
+}
+
+void NfoMergeWriter::copyToken(QXmlStreamReader& reader, QXmlStreamWriter& xml)
+{
+    switch (reader.tokenType()) {
+    case QXmlStreamReader::Characters:
+        if (reader.isCDATA()) {
+            xml.writeCDATA(reader.text().toString());
+        } else if (!reader.isWhitespace()) {
+            // Whitespace is re-created by auto formatting.
+            xml.writeCharacters(reader.text().toString());
+        }
+        break;
+    case QXmlStreamReader::Comment: xml.writeComment(reader.text().toString()); break;
+    case QXmlStreamReader::ProcessingInstruction:
+        xml.writeProcessingInstruction(
+            reader.processingInstructionTarget().toString(), reader.processingInstructionData().toString());
+        break;
+    case QXmlStreamReader::DTD: xml.writeDTD(reader.text().toString()); break;
+    case QXmlStreamReader::EntityReference: xml.writeEntityReference(reader.name().toString()); break;
+    default: break;
+    }
+}
+
+} // namespace kodi
+} // namespace mediaelch
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <functional>
+
+namespace mediaelch {
+namespace kodi {
+
+/// \brief Writes an NFO file and keeps all elements of an existing NFO file that MediaElch doesn't know.
+///
+/// Writers first describe the elements they manage, in the order in which new elements should appear.
+/// merge() then copies the existing NFO content in a single pass using QXmlStreamReader and
+/// QXmlStreamWriter: managed elements are replaced, all other elements (and comments) are kept
+/// at their position. No QDomDocument is built.
+///
+/// The semantics match the QDomDocument based helpers in KodiXml:
+///  - setTextValue(): like KodiXml::setTextValue(). The first existing element is updated in place,
+///    otherwise a new element is appended. Only direct children of the root element are considered.
+///  - replaceElements(), setListValue(), removeChildNodes(): like KodiXml::removeChildNodes() followed
+///    by KodiXml::appendXmlNode(). All existing elements are removed, new ones are appended.
+///
+/// merge() writes into a buffer that is reused by all writers of the current thread, so that bulk
+/// saves don't reallocate it for each item. Different instances may be used on different threads
+/// in parallel.
+class NfoMergeWriter
+{
+public:
+    /// \brief Writes the elements that replace existing ones. Called by merge().
+    using ElementWriter = std::function<void(QXmlStreamWriter&)>;
+
+    /// \param rootElement Root element of new NFO files, e.g. "movie".
+    explicit NfoMergeWriter(QString rootElement);
+
+    void setTextValue(const QString& name, const QString& value);
+    /// \brief Removes all elements called \p name and appends one text element per value.
+    void setListValue(const QString& name, const QStringList& values);
+    void removeChildNodes(const QString& name);
+    /// \brief Removes all elements called \p name. \p writer appends the new ones.
+    void replaceElements(const QString& name, ElementWriter writer);
+
+    /// \brief Returns the NFO content. If \p existingNfo is empty or not valid XML, a new document is written.
+    QByteArray merge(const QString& existingNfo) const;
+
+    /// \brief Buffer that is reused by XML writers of the current thread.
+    /// The buffer is cleared, but keeps its capacity. Copy the result before the next call.
+    static QByteArray& threadBuffer();
+
+private:
+    struct Operation
+    {
+        enum class Type
+        {
+            Text,
+            Replace
+        };
+        Type type;
+        QString name;
+        QString value;
+        ElementWriter writer;
+        /// Text values may update an existing element unless all of them were removed before.
+        bool mayUpdateInPlace = true;
+        /// Text values that are removed by a later replace operation are not written at all.
+        bool dropped = false;
+    };
+
+    bool write(QByteArray& buffer, const QString& existingNfo) const;
+    void writeNewElements(QXmlStreamWriter& xml, const QVector<bool>& updated) const;
+    int textOperation(const QString& name) const;
+    bool isReplaced(const QString& name) const;
+    static void writeTextInPlace(QXmlStreamReader& reader, QXmlStreamWriter& xml, const QString& value);
+    static void copyElement(QXmlStreamReader& reader, QXmlStreamWriter& xml);
+    static void copyToken(QXmlStreamReader& reader, QXmlStreamWriter& xml);
+
+    QString m_rootElement;
+    QVector<Operation> m_operations;
+};
+
+} // namespace kodi
+} // namespace mediaelch
@@ -2,6 +2,7 @@
 
 #include "globals/Helper.h"
 #include "media_centers/KodiXml.h"
+#include "media_centers/kodi/NfoMergeWriter.h"
 #include "settings/Settings.h"
 #include "tv_shows/TvShowEpisode.h"
 
@@ -16,7 +17,7 @@ EpisodeXmlWriterV17::EpisodeXmlWriterV17(QVector<TvShowEpisode*> episodes) : m_e
 
 QByteArray EpisodeXmlWriterV17::getEpisodeXml()
 {
-    QByteArray xmlContent;
+    QByteArray& xmlContent = NfoMergeWriter::threadBuffer();
     QXmlStreamWriter xml(&xmlContent);
     xml.setAutoFormatting(true);
     xml.writeStartDocument("1.0", true);
@@ -26,7 +27,7 @@ QByteArray EpisodeXmlWriterV17::getEpisodeXml()
     }
 
     xml.writeEndDocument();
-    return xmlContent;
+    return QByteArray(xmlContent.constData(), xmlContent.size());
 }
 
 
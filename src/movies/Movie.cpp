@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "data/ImageCache.h"
+#include "file/DirectoryListingCache.h"
 #include "globals/Helper.h"
 #include "media_centers/MediaCenterInterface.h"
 #include "settings/Settings.h"
@@ -160,7 +161,7 @@ void Movie::clearImages()
 {
     m_movieImages.clearImages();
     for (auto& actor : m_crew.actors()) {
-        actor->image = QByteArray();
+        actor->image = mediaelch::StagedImage();
     }
 }
 
@@ -966,10 +967,7 @@ bool Movie::hasLocalTrailer() const
     if (files().isEmpty()) {
         return false;
     }
-    QFileInfo fi(files().first().toString());
-    QString trailerFilter = QStringLiteral("%1*-trailer*").arg(fi.completeBaseName());
-    QDir dir(fi.canonicalPath());
-    return !dir.entryList({trailerFilter}).isEmpty();
+    return !localTrailerFileName().isEmpty();
 }
 
 QString Movie::localTrailerFileName() const
@@ -979,14 +977,14 @@ QString Movie::localTrailerFileName() const
     }
     QFileInfo fi(files().first().toString());
     QString trailerFilter = QStringLiteral("%1*-trailer*").arg(fi.completeBaseName());
-    QDir dir(fi.canonicalPath());
+    const mediaelch::DirectoryPath dir(fi.absolutePath());
 
-    QStringList contents = dir.entryList({trailerFilter});
+    QStringList contents = mediaelch::DirectoryListingCache::instance().files(dir, {trailerFilter});
     if (contents.isEmpty()) {
         return QString();
     }
 
-    return dir.absolutePath() + "/" + contents.first();
+    return dir.filePath(contents.first());
 }
 
 void Movie::setDateAdded(QDateTime date)
@@ -147,10 +147,15 @@ void MovieController::loadData(QHash<MovieScraperInterface*, QString> ids,
 }
 
 void MovieController::loadStreamDetailsFromFile()
+{
+    m_movie->streamDetails()->loadStreamDetails();
+    updateFromStreamDetails();
+}
+
+void MovieController::updateFromStreamDetails()
 {
     using namespace std::chrono;
     using namespace std::chrono_literals;
-    m_movie->streamDetails()->loadStreamDetails();
     seconds runtime =
         seconds(m_movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
     if (runtime > 0s) {
@@ -345,8 +350,8 @@ void MovieController::onDownloadFinished(DownloadManagerElement elem)
     m_downloadsLeft--;
     emit sigDownloadProgress(m_movie, m_downloadsLeft, m_downloadsSize);
 
-    if (!elem.data.isEmpty() && elem.imageType == ImageType::Actor) {
-        elem.actor->image = elem.data;
+    if (!elem.image.isNull() && elem.imageType == ImageType::Actor) {
+        elem.actor->image = elem.image;
     } else if (!elem.data.isEmpty() && elem.imageType == ImageType::MovieExtraFanart) {
         helper::resizeBackdrop(elem.data);
         m_movie->images().addExtraFanart(elem.data);
@@ -40,6 +40,8 @@ public:
         QSet<MovieScraperInfos> infos);
 
     void loadStreamDetailsFromFile();
+    /// @brief Updates the movie after its stream details were loaded, e.g. its runtime.
+    void updateFromStreamDetails();
 
     /// @brief Called when a ScraperInterface has finished loading
     ///        Emits the loaded signal
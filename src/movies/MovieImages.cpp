@@ -1,5 +1,6 @@
 #include "MovieImages.h"
 
+#include "data/ContentHashCache.h"
 #include "globals/Globals.h"
 #include "media_centers/MediaCenterInterface.h"
 #include "movies/Movie.h"
@@ -14,43 +15,43 @@ void MovieImages::clear(QSet<MovieScraperInfos> infos)
 {
     if (infos.contains(MovieScraperInfos::Backdrop)) {
         m_backdrops.clear();
-        m_images.insert(ImageType::MovieBackdrop, QByteArray());
+        m_images.insert(ImageType::MovieBackdrop, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MovieBackdrop, false);
         m_imagesToRemove.removeOne(ImageType::MovieBackdrop);
     }
     if (infos.contains(MovieScraperInfos::CdArt)) {
         m_discArts.clear();
-        m_images.insert(ImageType::MovieCdArt, QByteArray());
+        m_images.insert(ImageType::MovieCdArt, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MovieCdArt, false);
         m_imagesToRemove.removeOne(ImageType::MovieCdArt);
     }
     if (infos.contains(MovieScraperInfos::ClearArt)) {
         m_clearArts.clear();
-        m_images.insert(ImageType::MovieClearArt, QByteArray());
+        m_images.insert(ImageType::MovieClearArt, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MovieClearArt, false);
         m_imagesToRemove.removeOne(ImageType::MovieClearArt);
     }
     if (infos.contains(MovieScraperInfos::Logo)) {
         m_logos.clear();
-        m_images.insert(ImageType::MovieLogo, QByteArray());
+        m_images.insert(ImageType::MovieLogo, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MovieLogo, false);
         m_imagesToRemove.removeOne(ImageType::MovieLogo);
     }
     if (infos.contains(MovieScraperInfos::Poster)) {
         m_posters.clear();
-        m_images.insert(ImageType::MoviePoster, QByteArray());
+        m_images.insert(ImageType::MoviePoster, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MoviePoster, false);
         m_numPrimaryLangPosters = 0;
         m_imagesToRemove.removeOne(ImageType::MoviePoster);
     }
 
     if (infos.contains(MovieScraperInfos::Banner)) {
-        m_images.insert(ImageType::MovieBanner, QByteArray());
+        m_images.insert(ImageType::MovieBanner, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MovieBanner, false);
         m_imagesToRemove.removeOne(ImageType::MovieBanner);
     }
     if (infos.contains(MovieScraperInfos::Thumb)) {
-        m_images.insert(ImageType::MovieThumb, QByteArray());
+        m_images.insert(ImageType::MovieThumb, mediaelch::StagedImage());
         m_hasImageChanged.insert(ImageType::MovieThumb, false);
         m_imagesToRemove.removeOne(ImageType::MovieThumb);
     }
@@ -101,7 +102,7 @@ QStringList MovieImages::extraFanartsToRemove()
     return m_extraFanartsToRemove;
 }
 
-QVector<QByteArray> MovieImages::extraFanartToAdd()
+QVector<mediaelch::StagedImage> MovieImages::extraFanartToAdd()
 {
     return m_extraFanartToAdd.toVector();
 }
@@ -167,13 +168,19 @@ void MovieImages::addLogo(Poster logo)
 
 void MovieImages::addExtraFanart(QByteArray fanart)
 {
-    m_extraFanartToAdd.append(fanart);
+    m_extraFanartToAdd.append(mediaelch::ArtworkStage::instance().stage(fanart));
     m_movie.setChanged(true);
 }
 
 void MovieImages::removeExtraFanart(QByteArray fanart)
 {
-    m_extraFanartToAdd.removeOne(fanart);
+    const QByteArray hash = mediaelch::ContentHashCache::contentHash(fanart);
+    for (int i = 0; i < m_extraFanartToAdd.size(); ++i) {
+        if (m_extraFanartToAdd[i].hash() == hash) {
+            m_extraFanartToAdd.removeAt(i);
+            break;
+        }
+    }
     m_movie.setChanged(true);
 }
 
@@ -198,9 +205,9 @@ QVector<ExtraFanart> MovieImages::extraFanarts(MediaCenterInterface* mediaCenter
         f.path = file;
         fanarts.append(f);
     }
-    for (const QByteArray& img : m_extraFanartToAdd) {
+    for (const mediaelch::StagedImage& img : m_extraFanartToAdd) {
         ExtraFanart f;
-        f.image = img;
+        f.image = img.data();
         fanarts.append(f);
     }
     return fanarts;
@@ -215,7 +222,7 @@ void MovieImages::clearExtraFanartData()
 
 void MovieImages::removeImage(ImageType type)
 {
-    if (!m_images.value(type, QByteArray()).isNull()) {
+    if (!m_images.value(type).isNull()) {
         m_images.remove(type);
         m_hasImageChanged.insert(type, false);
     } else if (!m_imagesToRemove.contains(type)) {
@@ -226,7 +233,12 @@ void MovieImages::removeImage(ImageType type)
 
 QByteArray MovieImages::image(ImageType imageType) const
 {
-    return m_images.value(imageType, QByteArray());
+    return m_images.value(imageType).data();
+}
+
+mediaelch::StagedImage MovieImages::stagedImage(ImageType imageType) const
+{
+    return m_images.value(imageType);
 }
 
 bool MovieImages::imageHasChanged(ImageType imageType)
@@ -245,6 +257,11 @@ void MovieImages::setHasImage(ImageType imageType, bool has)
 }
 
 void MovieImages::setImage(ImageType imageType, QByteArray image)
+{
+    setImage(imageType, mediaelch::ArtworkStage::instance().stage(image));
+}
+
+void MovieImages::setImage(ImageType imageType, mediaelch::StagedImage image)
 {
     m_images.insert(imageType, image);
     m_hasImageChanged.insert(imageType, true);
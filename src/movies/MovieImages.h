@@ -5,6 +5,7 @@
 #include <QString>
 #include <QVector>
 
+#include "data/ArtworkStage.h"
 #include "globals/Globals.h"
 #include "globals/Poster.h"
 #include "globals/ScraperInfos.h"
@@ -25,7 +26,7 @@ public:
     QVector<Poster> logos() const;
     QVector<ExtraFanart> extraFanarts(MediaCenterInterface* mediaCenterInterface);
     QStringList extraFanartsToRemove();
-    QVector<QByteArray> extraFanartToAdd();
+    QVector<mediaelch::StagedImage> extraFanartToAdd();
     QVector<ImageType> imagesToRemove() const;
 
     void addPoster(Poster poster, bool primaryLang = false);
@@ -47,11 +48,16 @@ public:
     // Images
     bool hasExtraFanarts() const;
     void setHasExtraFanarts(bool has);
+    /// \brief The image's bytes.  Reads the image from disk if it is staged there; callers that
+    /// only need its file, size or hash should use stagedImage() instead.
     QByteArray image(ImageType imageType) const;
+    mediaelch::StagedImage stagedImage(ImageType imageType) const;
     bool imageHasChanged(ImageType imageType);
     void setHasImage(ImageType imageType, bool has);
     bool hasImage(ImageType imageType) const;
+    /// Stages the image, see mediaelch::ArtworkStage.
     void setImage(ImageType imageType, QByteArray image);
+    void setImage(ImageType imageType, mediaelch::StagedImage image);
 
 private:
     QList<Poster> m_posters;
@@ -65,10 +71,10 @@ private:
     int m_numPrimaryLangPosters{0};
     bool m_hasExtraFanarts{false};
 
-    QMap<ImageType, QByteArray> m_images;
+    QMap<ImageType, mediaelch::StagedImage> m_images;
     QMap<ImageType, bool> m_hasImage;
     QMap<ImageType, bool> m_hasImageChanged;
-    QList<QByteArray> m_extraFanartToAdd;
+    QList<mediaelch::StagedImage> m_extraFanartToAdd;
     QList<ImageType> m_imagesToRemove;
 
     Movie& m_movie;
@@ -28,6 +28,7 @@ MovieModel::MovieModel(QObject* parent) :
  */
 void MovieModel::addMovie(Movie* movie)
 {
+    clearSnapshot();
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_movies.append(movie);
     endInsertRows();
@@ -71,6 +72,9 @@ Movie* MovieModel::movie(int row)
 int MovieModel::rowCount(const QModelIndex& parent) const
 {
     Q_UNUSED(parent);
+    if (m_snapshot != nullptr) {
+        return m_snapshot->count();
+    }
     return m_movies.size();
 }
 
@@ -92,12 +96,15 @@ int MovieModel::columnCount(const QModelIndex& parent) const
  */
 QVariant MovieModel::data(const QModelIndex& index, int role) const
 {
-    if (index.row() < 0 || index.row() > m_movies.count()) {
+    if (index.row() < 0 || index.row() >= rowCount()) {
         return QVariant();
     }
     if (role == Qt::UserRole) {
         return index.row();
     }
+    if (m_snapshot != nullptr) {
+        return snapshotData(index, role);
+    }
 
     const Movie* const movie = m_movies[index.row()];
 
@@ -206,6 +213,87 @@ QVariant MovieModel::data(const QModelIndex& index, int role) const
     return QVariant();
 }
 
+/// \brief Subset of data() for rows of the library snapshot.
+QVariant MovieModel::snapshotData(const QModelIndex& index, int role) const
+{
+    using mediaelch::LibrarySnapshot;
+    if (index.column() != 0) {
+        if (role == Qt::ToolTipRole) {
+            return MovieModel::mediaStatusToText(MovieModel::columnToMediaStatus(index.column()));
+        }
+        return QVariant();
+    }
+
+    const LibrarySnapshot::Entry entry = m_snapshot->entry(index.row());
+    switch (role) {
+    case Qt::DisplayRole: return helper::appendArticle(entry.title);
+    case Qt::ToolTipRole:
+    case Qt::UserRole + 7: return entry.path;
+    case Qt::UserRole + 1: return (entry.flags & LibrarySnapshot::InfoLoaded) != 0;
+    case Qt::UserRole + 2: return false;
+    case Qt::UserRole + 3: return entry.year > 0 ? QDate(entry.year, 1, 1) : QDate();
+    case Qt::UserRole + 4: return (entry.flags & LibrarySnapshot::Watched) != 0;
+    case Qt::UserRole + 6: return (entry.flags & LibrarySnapshot::SyncNeeded) != 0;
+    case Qt::UserRole + 8: return entry.sortTitle.isEmpty() ? helper::appendArticle(entry.title) : entry.sortTitle;
+    case Qt::DecorationRole:
+        if ((entry.flags & LibrarySnapshot::InfoLoaded) == 0) {
+            return m_newIcon;
+        }
+        if ((entry.flags & LibrarySnapshot::SyncNeeded) != 0) {
+            return m_syncIcon;
+        }
+        break;
+    case Qt::BackgroundRole: return helper::colorForLabel(static_cast<ColorLabel>(entry.label));
+    default: break;
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags MovieModel::flags(const QModelIndex& index) const
+{
+    if (m_snapshot != nullptr) {
+        return Qt::ItemIsEnabled;
+    }
+    return QAbstractItemModel::flags(index);
+}
+
+void MovieModel::setSnapshot(std::unique_ptr<mediaelch::LibrarySnapshot> snapshot)
+{
+    beginResetModel();
+    m_snapshot = std::move(snapshot);
+    endResetModel();
+}
+
+void MovieModel::clearSnapshot()
+{
+    if (m_snapshot == nullptr) {
+        return;
+    }
+    beginResetModel();
+    m_snapshot.reset();
+    endResetModel();
+}
+
+bool MovieModel::writeSnapshot(const QString& fileName) const
+{
+    QVector<mediaelch::LibrarySnapshot::Entry> entries;
+    entries.reserve(m_movies.size());
+    for (const Movie* movie : m_movies) {
+        mediaelch::LibrarySnapshot::Entry entry;
+        entry.databaseId = movie->databaseId();
+        entry.year = movie->released().isValid() ? movie->released().year() : 0;
+        entry.flags = (movie->controller()->infoLoaded() ? mediaelch::LibrarySnapshot::InfoLoaded : 0U)
+                      | (movie->watched() ? mediaelch::LibrarySnapshot::Watched : 0U)
+                      | (movie->syncNeeded() ? mediaelch::LibrarySnapshot::SyncNeeded : 0U);
+        entry.label = static_cast<int>(movie->label());
+        entry.title = movie->name();
+        entry.sortTitle = movie->sortTitle();
+        entry.path = movie->files().isEmpty() ? QString() : movie->files().first().toString();
+        entries.push_back(entry);
+    }
+    return mediaelch::LibrarySnapshot::write(fileName, entries);
+}
+
 /**
  * @brief Returns an empty modelindex because no item has a parent
  * @param child Childindex
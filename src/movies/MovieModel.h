@@ -1,11 +1,13 @@
 #pragma once
 
+#include "data/LibrarySnapshot.h"
 #include "movies/Movie.h"
 
 #include <QAbstractItemModel>
 #include <QIcon>
 #include <QModelIndex>
 #include <QVector>
+#include <memory>
 
 class MovieModel : public QAbstractItemModel
 {
@@ -24,6 +26,7 @@ public:
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     QModelIndex index(int row, int column, const QModelIndex& parent) const override;
     QModelIndex parent(const QModelIndex& child) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
 
     virtual QVector<Movie*> movies();
     Movie* movie(int row);
@@ -32,6 +35,14 @@ public:
     void clear();
     int countNewMovies();
 
+    /// \brief Shows the rows of a library snapshot until movies are added.
+    /// Snapshot rows can't be selected because there are no Movie objects for them.
+    void setSnapshot(std::unique_ptr<mediaelch::LibrarySnapshot> snapshot);
+    void clearSnapshot();
+    bool hasSnapshot() const { return m_snapshot != nullptr; }
+    /// \brief Writes a snapshot of all movies, see mediaelch::LibrarySnapshot.
+    bool writeSnapshot(const QString& fileName) const;
+
     static int mediaStatusToColumn(MediaStatusColumn column);
     static QString mediaStatusToText(MediaStatusColumn column);
     static MediaStatusColumn columnToMediaStatus(int column);
@@ -40,7 +51,10 @@ private slots:
     void onMovieChanged(Movie* movie);
 
 private:
+    QVariant snapshotData(const QModelIndex& index, int role) const;
+
     QVector<Movie*> m_movies;
+    std::unique_ptr<mediaelch::LibrarySnapshot> m_snapshot;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
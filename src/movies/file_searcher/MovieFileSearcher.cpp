@@ -1,6 +1,5 @@
 #include "MovieFileSearcher.h"
 
-#include <QApplication>
 #include <QDebug>
 #include <QDirIterator>
 #include <QSqlQuery>
@@ -11,6 +10,7 @@
 #include <QtConcurrent/QtConcurrentRun>
 
 #include "data/Subtitle.h"
+#include "file/DirectoryListingCache.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
@@ -23,15 +23,29 @@ MovieFileSearcher::MovieFileSearcher(QObject* parent) :
 }
 
 void MovieFileSearcher::reload(bool force)
+{
+    prepareReload();
+    load(force);
+    addLoadedToGui();
+}
+
+void MovieFileSearcher::prepareReload()
 {
     m_aborted = false;
+    m_loadedMovies.clear();
+    // Pick up files that were changed by other programs.
+    mediaelch::DirectoryListingCache::instance().clear();
+    Manager::instance()->movieModel()->clear();
+}
+
+void MovieFileSearcher::load(bool force)
+{
     emit searchStarted(tr("Searching for Movies..."));
 
     if (force) {
         Manager::instance()->database()->clearAllMovies();
     }
 
-    Manager::instance()->movieModel()->clear();
     m_lastModifications.clear();
 
     QVector<MovieContents> moviesContent;
@@ -72,13 +86,24 @@ void MovieFileSearcher::reload(bool force)
         emit progress(++movieCounter, movieSum, m_progressMessageId);
     }
 
-    for (Movie* movie : movies) {
-        Manager::instance()->movieModel()->addMovie(movie);
-    }
+    m_loadedMovies = movies;
+}
 
-    if (!m_aborted) {
-        emit moviesLoaded();
+void MovieFileSearcher::addLoadedToGui()
+{
+    if (m_aborted) {
+        // Movies of an aborted reload are never added to the model.
+        qDeleteAll(m_loadedMovies);
+        m_loadedMovies.clear();
+        return;
     }
+    // The library may be empty now, so the snapshot rows are not necessarily replaced by addMovie().
+    Manager::instance()->movieModel()->clearSnapshot();
+    for (Movie* movie : m_loadedMovies) {
+        Manager::instance()->movieModel()->addMovie(movie);
+    }
+    m_loadedMovies.clear();
+    emit moviesLoaded();
 }
 
 Movie* MovieFileSearcher::loadMovieData(Movie* movie)
@@ -260,7 +285,6 @@ int MovieFileSearcher::loadMoviesFromDirectory(const SettingsDir& movieDir,
     }
 
     emit currentDir(path);
-    QApplication::processEvents();
     Manager::instance()->database()->clearMoviesInDirectory(path);
     QMap<QString, QStringList> contents;
     // No filter, no media files...
@@ -386,12 +410,26 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
     int& movieCounter)
 {
     QVector<Movie*> movies;
+    // Reading the NFO files is slow, so the movies of a directory are stored only after all were loaded.
+    // Otherwise the write lock is held while loading and concurrent searchers time out.
+    const auto storeInDatabase = [&movies](int first, const QString& path) {
+        Database* database = Manager::instance()->database();
+        const bool stored = database->writeInTransaction([&]() {
+            for (int i = first; i < movies.size(); ++i) {
+                database->add(movies[i], path);
+            }
+        });
+        if (!stored) {
+            qWarning() << "[MovieFileSearcher] Could not store the movies of" << path << "in the cache";
+        }
+    };
+
     for (const MovieContents& con : moviesContent) {
-        Manager::instance()->database()->transaction();
+        const int firstOfDirectory = movies.size();
         QMapIterator<QString, QStringList> itContents(con.contents);
         while (itContents.hasNext()) {
             if (m_aborted) {
-                Manager::instance()->database()->commit();
+                storeInDatabase(firstOfDirectory, con.path);
                 return movies;
             }
             itContents.next();
@@ -447,20 +485,24 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                 movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
                 if (discType == DiscType::Single) {
                     QFileInfo mFi(files.first());
-                    for (const QFileInfo& subFi : mFi.dir().entryInfoList(
-                             QStringList{"*.sub", "*.srt", "*.smi", "*.ssa"}, QDir::Files | QDir::NoDotAndDotDot)) {
-                        QString subFileName = subFi.fileName().mid(mFi.completeBaseName().length() + 1);
+                    // Answered from the listing that was read by getFiles().
+                    auto& listings = mediaelch::DirectoryListingCache::instance();
+                    const mediaelch::DirectoryPath movieDir(mFi.absolutePath());
+                    for (const QString& subFile :
+                        listings.files(movieDir, QStringList{"*.sub", "*.srt", "*.smi", "*.ssa"})) {
+                        const QFileInfo subFi(subFile); // only used to split the file name
+                        QString subFileName = subFile.mid(mFi.completeBaseName().length() + 1);
                         QStringList parts = subFileName.split(QRegExp(R"(\s+|\-+|\.+)"));
                         if (parts.isEmpty()) {
                             continue;
                         }
                         parts.takeLast();
 
-                        QStringList subFiles = QStringList() << subFi.fileName();
+                        QStringList subFiles = QStringList() << subFile;
                         if (QString::compare(subFi.suffix(), "sub", Qt::CaseInsensitive) == 0) {
-                            QFileInfo subIdxFi(subFi.absolutePath() + "/" + subFi.completeBaseName() + ".idx");
-                            if (subIdxFi.exists()) {
-                                subFiles << subIdxFi.fileName();
+                            const QString subIdxFile = subFi.completeBaseName() + ".idx";
+                            if (listings.isFile(movieDir, subIdxFile)) {
+                                subFiles << subIdxFile;
                             }
                         }
                         auto subtitle = new Subtitle(movie);
@@ -476,7 +518,6 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                         movie->addSubtitle(subtitle, true);
                     }
                 }
-                Manager::instance()->database()->add(movie, con.path);
                 movies.append(movie);
                 // emit currentDir(movie->name());
             } else {
@@ -505,7 +546,6 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                     movie->setFileLastModified(m_lastModifications.value(it.value().at(0)));
                     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
                     movie->setLabel(Manager::instance()->database()->getLabel(movie->files()));
-                    Manager::instance()->database()->add(movie, con.path);
                     movies.append(movie);
                     // emit currentDir(movie->name());
                 }
@@ -515,7 +555,7 @@ QVector<Movie*> MovieFileSearcher::loadAndStoreMoviesContents(QVector<MovieFileS
                 emit currentDir("");
             }
         }
-        Manager::instance()->database()->commit();
+        storeInDatabase(firstOfDirectory, con.path);
     }
     return movies;
 }
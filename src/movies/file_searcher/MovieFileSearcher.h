@@ -7,6 +7,7 @@
 #include <QObject>
 #include <QTime>
 #include <QVector>
+#include <atomic>
 #include <memory>
 
 namespace mediaelch {
@@ -44,7 +45,17 @@ public:
         bool separateFolders = false,
         bool firstScan = false);
 
+    /// \brief Clears the movie model and resets the searcher. Must be called in the GUI thread.
+    void prepareReload();
+    /// \brief Loads all movies without touching the GUI. May be called in a worker thread
+    ///        if the searcher lives in it, see LibraryReloader.
+    void load(bool force);
+    /// \brief Adds movies of the last load() to the movie model and emits moviesLoaded().
+    ///        Must be called in the GUI thread.
+    void addLoadedToGui();
+
 public slots:
+    /// \brief Reloads all movies in the current thread.
     void reload(bool force);
     void abort();
 
@@ -81,7 +92,8 @@ private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
     QHash<QString, QDateTime> m_lastModifications;
-    bool m_aborted;
+    QVector<Movie*> m_loadedMovies;
+    std::atomic<bool> m_aborted;
 };
 
 } // namespace mediaelch
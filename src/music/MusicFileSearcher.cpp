@@ -37,11 +37,23 @@ void MusicFileSearcher::setMusicDirectories(QVector<SettingsDir> directories)
 }
 
 void MusicFileSearcher::reload(bool force)
+{
+    prepareReload();
+    load(force);
+    addLoadedToGui();
+}
+
+void MusicFileSearcher::prepareReload()
 {
     m_aborted = false;
+    m_loadedArtists.clear();
+    m_loadedAlbums.clear();
+    Manager::instance()->musicModel()->clear();
+}
 
+void MusicFileSearcher::load(bool force)
+{
     emit searchStarted(tr("Searching for Music..."));
-    Manager::instance()->musicModel()->clear();
 
     QVector<Artist*> artists;
     QVector<Artist*> artistsFromDb;
@@ -124,32 +136,47 @@ void MusicFileSearcher::reload(bool force)
     int current = 0;
     int max = artists.length() + albums.length() + artistsFromDb.length() + albumsFromDb.length();
 
-    Manager::instance()->database()->transaction();
-    for (Artist* artist : artists) {
+    // Artists and albums are stored after all were loaded so that the write lock isn't held while reading NFO files.
+    const auto storeInDatabase = [&](int artistCount, int albumCount) {
+        Database* database = Manager::instance()->database();
+        const bool stored = database->writeInTransaction([&]() {
+            for (int i = 0; i < artistCount; ++i) {
+                database->add(artists[i], artistPaths.value(artists[i]));
+            }
+            for (int i = 0; i < albumCount; ++i) {
+                database->add(albums[i], albumPaths.value(albums[i]));
+            }
+        });
+        if (!stored) {
+            qWarning() << "[MusicFileSearcher] Could not store the artists and albums in the cache";
+        }
+    };
+
+    for (int i = 0; i < artists.size(); ++i) {
         if (m_aborted) {
-            Manager::instance()->database()->commit();
+            storeInDatabase(i, 0);
             return;
         }
+        Artist* artist = artists[i];
         artist->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
         if (current % 20 == 0) {
             emit currentDir(artist->name());
         }
         emit progress(++current, max, m_progressMessageId);
-        Manager::instance()->database()->add(artist, artistPaths.value(artist));
     }
-    for (Album* album : albums) {
+    for (int i = 0; i < albums.size(); ++i) {
         if (m_aborted) {
-            Manager::instance()->database()->commit();
+            storeInDatabase(artists.size(), i);
             return;
         }
+        Album* album = albums[i];
         album->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
         if (current % 20 == 0) {
             emit currentDir(album->artist() + "/" + album->title());
         }
         emit progress(++current, max, m_progressMessageId);
-        Manager::instance()->database()->add(album, albumPaths.value(album));
     }
-    Manager::instance()->database()->commit();
+    storeInDatabase(artists.size(), albums.size());
 
     QtConcurrent::blockingMapped(artistsFromDb, MusicFileSearcher::loadArtistData);
     QtConcurrent::blockingMapped(albumsFromDb, MusicFileSearcher::loadAlbumData);
@@ -157,12 +184,27 @@ void MusicFileSearcher::reload(bool force)
     artists.append(artistsFromDb);
     albums.append(albumsFromDb);
 
+    m_loadedArtists = artists;
+    m_loadedAlbums = albums;
+}
+
+void MusicFileSearcher::addLoadedToGui()
+{
+    if (m_aborted) {
+        // Artists and albums of an aborted reload are never added to the model.
+        qDeleteAll(m_loadedAlbums);
+        qDeleteAll(m_loadedArtists);
+        m_loadedAlbums.clear();
+        m_loadedArtists.clear();
+        return;
+    }
+
     QMap<Artist*, MusicModelItem*> artistModelItems;
-    for (Artist* artist : artists) {
+    for (Artist* artist : m_loadedArtists) {
         MusicModelItem* artistItem = Manager::instance()->musicModel()->appendChild(artist);
         artistModelItems.insert(artist, artistItem);
     }
-    for (Album* album : albums) {
+    for (Album* album : m_loadedAlbums) {
         MusicModelItem* artistItem = artistModelItems.value(album->artistObj(), nullptr);
         if (artistItem == nullptr) {
             qWarning() << "Artist item was not found for album" << album->path();
@@ -170,10 +212,10 @@ void MusicFileSearcher::reload(bool force)
         }
         artistItem->appendChild(album);
     }
+    m_loadedArtists.clear();
+    m_loadedAlbums.clear();
 
-    if (!m_aborted) {
-        emit musicLoaded();
-    }
+    emit musicLoaded();
 }
 
 void MusicFileSearcher::abort()
@@ -3,6 +3,8 @@
 #include "globals/Globals.h"
 
 #include <QObject>
+#include <QVector>
+#include <atomic>
 
 class Album;
 class Artist;
@@ -18,7 +20,17 @@ public:
     static Artist* loadArtistData(Artist* artist);
     static Album* loadAlbumData(Album* album);
 
+    /// \brief Clears the music model and resets the searcher. Must be called in the GUI thread.
+    void prepareReload();
+    /// \brief Loads all artists and albums without touching the GUI. May be called in a
+    ///        worker thread if the searcher lives in it, see LibraryReloader.
+    void load(bool force);
+    /// \brief Adds artists and albums of the last load() to the music model and emits
+    ///        musicLoaded(). Must be called in the GUI thread.
+    void addLoadedToGui();
+
 public slots:
+    /// \brief Reloads all artists and albums in the current thread.
     void reload(bool force);
     void abort();
 
@@ -31,5 +43,7 @@ signals:
 private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
-    bool m_aborted;
+    QVector<Artist*> m_loadedArtists;
+    QVector<Album*> m_loadedAlbums;
+    std::atomic<bool> m_aborted;
 };
@@ -0,0 +1,92 @@
+#include "network/HostTimeouts.h"
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+#include <cmath>
+#include <memory>
+
+namespace mediaelch {
+namespace network {
+
+HostTimeouts& HostTimeouts::instance()
+{
+    static HostTimeouts s_instance;
+    return s_instance;
+}
+
+int HostTimeouts::timeoutFor(const QString& host) const
+{
+    QMutexLocker locker(&m_mutex);
+    const HostState state = m_hosts.value(host);
+
+    if (state.consecutiveTimeouts >= deadHostTimeouts()) {
+        return minTimeout();
+    }
+
+    int timeout = defaultTimeout();
+    if (state.latency >= 0) {
+        timeout = qBound(minTimeout(), static_cast<int>(state.latency + 4 * state.deviation), maxTimeout());
+    }
+    // Back off for each timeout in a row: the host may just be slower than expected.
+    for (int i = 0; i < state.consecutiveTimeouts; ++i) {
+        timeout = qMin(2 * timeout, maxTimeout());
+    }
+    return timeout;
+}
+
+void HostTimeouts::watch(QNetworkReply* reply)
+{
+    const QString host = reply->url().host();
+    if (host.isEmpty()) {
+        return;
+    }
+
+    auto timer = std::make_shared<QElapsedTimer>();
+    timer->start();
+    const auto report = [this, reply, host, timer]() {
+        if (!timer->isValid()) {
+            return; // already reported
+        }
+        // Aborted requests, including timeouts, and connection errors have no meaningful latency.
+        const bool hasResponse = reply->bytesAvailable() > 0
+                                 || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid();
+        if (hasResponse) {
+            reportLatency(host, timer->elapsed());
+        }
+        timer->invalidate();
+    };
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, reply, report);
+    QObject::connect(reply, &QNetworkReply::finished, reply, report);
+}
+
+void HostTimeouts::reportLatency(const QString& host, qint64 milliseconds)
+{
+    QMutexLocker locker(&m_mutex);
+    HostState& state = m_hosts[host];
+    const auto sample = static_cast<double>(milliseconds);
+    // See RFC 6298, "Computing TCP's Retransmission Timer"
+    if (state.latency < 0) {
+        state.latency = sample;
+        state.deviation = sample / 2;
+    } else {
+        state.deviation = 0.75 * state.deviation + 0.25 * std::abs(state.latency - sample);
+        state.latency = 0.875 * state.latency + 0.125 * sample;
+    }
+    state.consecutiveTimeouts = 0;
+}
+
+void HostTimeouts::reportTimeout(const QString& host)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_hosts[host].consecutiveTimeouts;
+}
+
+void HostTimeouts::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_hosts.clear();
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QString>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Per-host timeouts that adapt to the latency observed for a host.
+///
+/// Requests are aborted if they make no progress for timeoutFor() milliseconds.  A fixed timeout
+/// aborts slow but healthy hosts and waits too long for dead ones.  Instead, the time until the
+/// first byte of each response is measured and, like TCP's retransmission timeout, the timeout
+/// is the smoothed latency plus four times its deviation, bounded by minTimeout() and maxTimeout().
+///
+/// If requests to a host time out, the next ones get twice as long (to give slow hosts a chance)
+/// until deadHostTimeouts() consecutive requests have timed out.  Then the host is considered dead
+/// and its requests fail after minTimeout() until one of them succeeds.  Thread-safe.
+class HostTimeouts
+{
+public:
+    static HostTimeouts& instance();
+
+    static constexpr int defaultTimeout() { return 6000; }
+    static constexpr int minTimeout() { return 3000; }
+    static constexpr int maxTimeout() { return 30000; }
+    static constexpr int deadHostTimeouts() { return 3; }
+
+    /// \brief Inactivity timeout in milliseconds for requests to \p host.
+    int timeoutFor(const QString& host) const;
+
+    /// \brief Measures the time until \p reply receives its first byte and reports it.
+    ///        Must be called right after the request was sent.
+    void watch(QNetworkReply* reply);
+
+    void reportLatency(const QString& host, qint64 milliseconds);
+    void reportTimeout(const QString& host);
+
+    void clear();
+
+private:
+    HostTimeouts() = default;
+
+    struct HostState
+    {
+        /// Smoothed latency and its mean deviation; -1 if no latency was reported, yet.
+        double latency = -1;
+        double deviation = 0;
+        int consecutiveTimeouts = 0;
+    };
+
+    mutable QMutex m_mutex;
+    QHash<QString, HostState> m_hosts;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,66 @@
+#include "network/NetworkManager.h"
+
+#include "network/ReplayTransport.h"
+
+#include <QCoreApplication>
+#include <QNetworkRequest>
+#include <QThread>
+#include <QThreadStorage>
+
+namespace mediaelch {
+namespace network {
+
+namespace {
+
+class SharedAccessManager : public QNetworkAccessManager
+{
+public:
+    using QNetworkAccessManager::QNetworkAccessManager;
+
+protected:
+    QNetworkReply* createRequest(Operation op, const QNetworkRequest& originalRequest, QIODevice* data) override
+    {
+        QNetworkRequest request(originalRequest);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        const QNetworkRequest::Attribute http2Allowed = QNetworkRequest::Http2AllowedAttribute;
+#elif QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+        const QNetworkRequest::Attribute http2Allowed = QNetworkRequest::HTTP2AllowedAttribute;
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+        // Requests may disable HTTP/2 explicitly, e.g. for servers with a broken implementation.
+        if (!request.attribute(http2Allowed).isValid()) {
+            request.setAttribute(http2Allowed, true);
+        }
+#endif
+
+        const ReplayConfig replay = replayConfig();
+        if (replay.mode == ReplayMode::Replay) {
+            return replayRequest(op, request, replay, this);
+        }
+        QNetworkReply* reply = QNetworkAccessManager::createRequest(op, request, data);
+        if (replay.mode == ReplayMode::Record) {
+            recordReply(op, request.url(), reply, replay);
+        }
+        return reply;
+    }
+};
+
+} // namespace
+
+QNetworkAccessManager* accessManager()
+{
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app != nullptr && QThread::currentThread() == app->thread()) {
+        static auto* s_mainThreadManager = new SharedAccessManager(app);
+        return s_mainThreadManager;
+    }
+    // Deleted when the thread finishes.
+    static QThreadStorage<QNetworkAccessManager*> s_threadManagers;
+    if (!s_threadManagers.hasLocalData()) {
+        s_threadManagers.setLocalData(new SharedAccessManager());
+    }
+    return s_threadManagers.localData();
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QNetworkAccessManager>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Returns the network access manager of the calling thread.
+///
+/// All scrapers and downloads of a thread share one QNetworkAccessManager so that its
+/// connections (keep-alive, TLS sessions and HTTP/2 multiplexing, where the server supports it)
+/// are reused across them.  The manager allows HTTP/2 for all requests.  It can also record
+/// responses or replay recorded ones instead of using the network, see replayConfig().
+///
+/// Replies are owned by the shared manager and are not deleted together with the object that
+/// sent them.  Connect to their signals with a context object and delete them once finished.
+QNetworkAccessManager* accessManager();
+
+} // namespace network
+} // namespace mediaelch
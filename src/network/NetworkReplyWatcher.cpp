@@ -1,5 +1,8 @@
 #include "network/NetworkReplyWatcher.h"
 
+#include "network/HostTimeouts.h"
+#include "network/ScrapeStats.h"
+
 #include <QDebug>
 
 NetworkReplyWatcher::NetworkReplyWatcher(QObject* parent, QNetworkReply* reply) : QObject(parent), m_reply{nullptr}
@@ -17,12 +20,19 @@ void NetworkReplyWatcher::setReply(QNetworkReply* reply)
     connect(m_reply, &QNetworkReply::finished, &m_timer, &QTimer::stop);
     connect(m_reply, &QObject::destroyed, this, &QObject::deleteLater);
     connect(m_reply, &QNetworkReply::downloadProgress, this, &NetworkReplyWatcher::onProgress);
+    m_timeoutMilliseconds = mediaelch::network::HostTimeouts::instance().timeoutFor(m_reply->url().host());
     m_timer.start(m_timeoutMilliseconds);
+    mediaelch::network::HostTimeouts::instance().watch(m_reply);
+    mediaelch::network::ScrapeStats::instance().watch(m_reply);
 }
 
 void NetworkReplyWatcher::onTimeout()
 {
     if (m_reply != nullptr) {
+        qDebug() << "[NetworkReplyWatcher] No progress for" << m_timeoutMilliseconds << "ms, aborting:"
+                 << m_reply->url();
+        mediaelch::network::HostTimeouts::instance().reportTimeout(m_reply->url().host());
+        mediaelch::network::ScrapeStats::markTimedOut(m_reply);
         m_reply->abort();
     }
 }
@@ -6,6 +6,8 @@
 
 /// \brief The NetworkReplyWatcher class takes a QNetworkReply* and watches it.
 /// A timeout is set which aborts the download if no response was received after N seconds.
+/// N depends on the latency of the reply's host, see mediaelch::network::HostTimeouts.
+/// The reply's costs are recorded in mediaelch::network::ScrapeStats.
 ///
 /// \example
 ///   new NetworkReplyWatcher(this, reply) // will delete itself when the reply is deleted
@@ -25,5 +27,5 @@ private:
     QNetworkReply* m_reply;
     QTimer m_timer;
 
-    const int m_timeoutMilliseconds = 6000;
+    int m_timeoutMilliseconds = 6000;
 };
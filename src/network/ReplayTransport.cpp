@@ -0,0 +1,367 @@
+#include "network/ReplayTransport.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTimer>
+#include <QUrlQuery>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace mediaelch {
+namespace network {
+
+namespace {
+
+/// Interval in milliseconds in which replayed responses receive the next chunk of data.
+constexpr int replayTickMs = 10;
+
+bool isApiKey(const QString& queryItem)
+{
+    const QString name = queryItem.toLower();
+    return name == "api_key" || name == "apikey" || name == "api-key";
+}
+
+/// Removes API keys, sorts the query and removes the fragment.
+QUrl normalizedUrl(const QUrl& url)
+{
+    QList<QPair<QString, QString>> items = QUrlQuery(url).queryItems(QUrl::FullyDecoded);
+    items.erase(std::remove_if(items.begin(),
+                    items.end(),
+                    [](const QPair<QString, QString>& item) { return isApiKey(item.first); }),
+        items.end());
+    std::sort(items.begin(), items.end());
+
+    QUrlQuery query;
+    query.setQueryItems(items);
+    QUrl normalized(url);
+    normalized.setQuery(items.isEmpty() ? QString() : query.query(QUrl::FullyEncoded), QUrl::StrictMode);
+    normalized.setFragment(QString());
+    return normalized;
+}
+
+QString operationName(QNetworkAccessManager::Operation operation)
+{
+    switch (operation) {
+    case QNetworkAccessManager::HeadOperation: return "HEAD";
+    case QNetworkAccessManager::GetOperation: return "GET";
+    case QNetworkAccessManager::PutOperation: return "PUT";
+    case QNetworkAccessManager::PostOperation: return "POST";
+    case QNetworkAccessManager::DeleteOperation: return "DELETE";
+    case QNetworkAccessManager::CustomOperation: return "CUSTOM";
+    case QNetworkAccessManager::UnknownOperation: break;
+    }
+    return "UNKNOWN";
+}
+
+/// Headers that describe the transfer and not the content are not recorded.
+bool isTransferHeader(const QByteArray& header)
+{
+    const QByteArray name = header.toLower();
+    return name == "content-encoding" || name == "content-length" || name == "transfer-encoding"
+           || name == "set-cookie" || name == "connection";
+}
+
+QMutex s_configMutex;
+
+ReplayConfig& configLocked()
+{
+    static ReplayConfig s_config = replayConfigFromEnvironment();
+    return s_config;
+}
+
+/// \brief Serves a recorded response like a real reply: metaDataChanged() after the latency,
+/// then readyRead() and downloadProgress() for each chunk the bandwidth allows, then finished().
+class ReplayReply : public QNetworkReply
+{
+public:
+    ReplayReply(QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const ReplayConfig& config,
+        QObject* parent) :
+        QNetworkReply(parent)
+    {
+        setRequest(request);
+        setUrl(request.url());
+        setOperation(operation);
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+        m_hasFixture =
+            NetworkFixtureStore(QDir(config.fixtureDir)).load(operation, request.url(), m_fixture);
+        if (!m_hasFixture) {
+            qWarning() << "[ReplayTransport] No recorded response for"
+                       << NetworkFixtureStore::keyFor(operation, request.url());
+        }
+        if (config.bandwidthKiBs > 0) {
+            m_bytesPerTick = qMax<qint64>(1, qint64(config.bandwidthKiBs) * 1024 * replayTickMs / 1000);
+        }
+
+        m_timer.setSingleShot(true);
+        connect(&m_timer, &QTimer::timeout, this, [this]() { onTimeout(); });
+        m_timer.start(qMax(0, config.latencyMs));
+    }
+
+    void abort() override
+    {
+        if (isFinished()) {
+            return;
+        }
+        m_timer.stop();
+        finishWithError(OperationCanceledError, QStringLiteral("Operation canceled"));
+    }
+
+    qint64 bytesAvailable() const override { return m_received - m_read + QNetworkReply::bytesAvailable(); }
+
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        const qint64 count = qMin(maxSize, m_received - m_read);
+        if (count <= 0) {
+            return isFinished() ? -1 : 0;
+        }
+        std::memcpy(data, m_fixture.body.constData() + m_read, static_cast<size_t>(count));
+        m_read += count;
+        return count;
+    }
+
+private:
+    void onTimeout()
+    {
+        if (!m_respondedHeaders) {
+            respondHeaders();
+        } else {
+            receive();
+        }
+    }
+
+    void respondHeaders()
+    {
+        m_respondedHeaders = true;
+        if (!m_hasFixture) {
+            finishWithError(ContentNotFoundError, QStringLiteral("No recorded response for %1").arg(url().toString()));
+            return;
+        }
+
+        if (m_fixture.url.isValid()) {
+            setUrl(m_fixture.url);
+        }
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, m_fixture.statusCode);
+        for (const RawHeaderPair& header : m_fixture.headers) {
+            setRawHeader(header.first, header.second);
+        }
+        setHeader(QNetworkRequest::ContentLengthHeader, m_fixture.body.size());
+        emit metaDataChanged();
+
+        if (m_bytesPerTick <= 0) {
+            receive();
+            return;
+        }
+        m_timer.setSingleShot(false);
+        m_timer.start(replayTickMs);
+    }
+
+    void receive()
+    {
+        const qint64 total = m_fixture.body.size();
+        m_received = (m_bytesPerTick <= 0) ? total : qMin(total, m_received + m_bytesPerTick);
+        emit downloadProgress(m_received, total);
+        if (m_received > 0) {
+            emit readyRead();
+        }
+        if (m_received < total) {
+            return;
+        }
+
+        m_timer.stop();
+        if (m_fixture.error != NoError) {
+            finishWithError(m_fixture.error, m_fixture.errorString);
+            return;
+        }
+        setFinished(true);
+        emit readChannelFinished();
+        emit finished();
+    }
+
+    void finishWithError(NetworkError error, const QString& errorString)
+    {
+        setError(error, errorString);
+        setFinished(true);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        emit errorOccurred(error);
+#else
+        emit this->error(error);
+#endif
+        emit readChannelFinished();
+        emit finished();
+    }
+
+    NetworkFixture m_fixture;
+    bool m_hasFixture = false;
+    bool m_respondedHeaders = false;
+    qint64 m_bytesPerTick = 0;
+    qint64 m_received = 0;
+    qint64 m_read = 0;
+    QTimer m_timer;
+};
+
+} // namespace
+
+NetworkFixtureStore::NetworkFixtureStore(QDir directory) : m_directory{std::move(directory)}
+{
+}
+
+QString NetworkFixtureStore::keyFor(QNetworkAccessManager::Operation operation, const QUrl& url)
+{
+    return operationName(operation) + " " + normalizedUrl(url).toString(QUrl::FullyEncoded);
+}
+
+QString NetworkFixtureStore::basePath(QNetworkAccessManager::Operation operation, const QUrl& url) const
+{
+    const QByteArray hash =
+        QCryptographicHash::hash(keyFor(operation, url).toUtf8(), QCryptographicHash::Sha1).toHex();
+    const QString host = url.host().isEmpty() ? QStringLiteral("local") : url.host();
+    return m_directory.filePath(host + "/" + QString::fromLatin1(hash));
+}
+
+bool NetworkFixtureStore::load(QNetworkAccessManager::Operation operation,
+    const QUrl& url,
+    NetworkFixture& fixture) const
+{
+    const QString path = basePath(operation, url);
+    QFile metaFile(path + ".json");
+    QFile bodyFile(path + ".body");
+    if (!metaFile.open(QIODevice::ReadOnly) || !bodyFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonParseError parseError{};
+    const QJsonObject json = QJsonDocument::fromJson(metaFile.readAll(), &parseError).object();
+    if (parseError.error != QJsonParseError::NoError || json.value("version").toInt() != 1) {
+        qWarning() << "[ReplayTransport] Ignoring invalid fixture" << metaFile.fileName() << parseError.errorString();
+        return false;
+    }
+
+    fixture.url = QUrl(json.value("url").toString());
+    fixture.statusCode = json.value("status").toInt();
+    fixture.headers.clear();
+    for (const QJsonValue& value : json.value("headers").toArray()) {
+        const QJsonArray header = value.toArray();
+        fixture.headers.append({header.at(0).toString().toUtf8(), header.at(1).toString().toUtf8()});
+    }
+    fixture.error = static_cast<QNetworkReply::NetworkError>(json.value("error").toInt());
+    fixture.errorString = json.value("errorString").toString();
+    fixture.body = bodyFile.readAll();
+    return true;
+}
+
+bool NetworkFixtureStore::save(QNetworkAccessManager::Operation operation,
+    const QUrl& url,
+    const NetworkFixture& fixture) const
+{
+    const QString path = basePath(operation, url);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        qWarning() << "[ReplayTransport] Could not create directory for" << path;
+        return false;
+    }
+
+    QJsonArray headers;
+    for (const QNetworkReply::RawHeaderPair& header : fixture.headers) {
+        headers.append(QJsonArray{QString::fromUtf8(header.first), QString::fromUtf8(header.second)});
+    }
+    QJsonObject json{{"version", 1},
+        {"request", keyFor(operation, url)},
+        {"url", normalizedUrl(fixture.url).toString()},
+        {"status", fixture.statusCode},
+        {"headers", headers},
+        {"error", static_cast<int>(fixture.error)},
+        {"errorString", fixture.errorString}};
+
+    QSaveFile metaFile(path + ".json");
+    QSaveFile bodyFile(path + ".body");
+    if (!metaFile.open(QIODevice::WriteOnly) || !bodyFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ReplayTransport] Could not write fixture" << path;
+        return false;
+    }
+    bodyFile.write(fixture.body);
+    metaFile.write(QJsonDocument(json).toJson(QJsonDocument::Indented));
+    return bodyFile.commit() && metaFile.commit();
+}
+
+ReplayConfig replayConfigFromEnvironment()
+{
+    ReplayConfig config;
+    const QString recordDir = QString::fromLocal8Bit(qgetenv("MEDIAELCH_NETWORK_RECORD"));
+    const QString replayDir = QString::fromLocal8Bit(qgetenv("MEDIAELCH_NETWORK_REPLAY"));
+    if (!replayDir.isEmpty()) {
+        config.mode = ReplayMode::Replay;
+        config.fixtureDir = replayDir;
+    } else if (!recordDir.isEmpty()) {
+        config.mode = ReplayMode::Record;
+        config.fixtureDir = recordDir;
+    }
+    config.latencyMs = qMax(0, qEnvironmentVariableIntValue("MEDIAELCH_NETWORK_LATENCY"));
+    config.bandwidthKiBs = qMax(0, qEnvironmentVariableIntValue("MEDIAELCH_NETWORK_BANDWIDTH"));
+    return config;
+}
+
+ReplayConfig replayConfig()
+{
+    QMutexLocker locker(&s_configMutex);
+    return configLocked();
+}
+
+void setReplayConfig(const ReplayConfig& config)
+{
+    QMutexLocker locker(&s_configMutex);
+    configLocked() = config;
+}
+
+QNetworkReply* replayRequest(QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const ReplayConfig& config,
+    QObject* parent)
+{
+    return new ReplayReply(operation, request, config, parent);
+}
+
+void recordReply(QNetworkAccessManager::Operation operation,
+    const QUrl& requestUrl,
+    QNetworkReply* reply,
+    const ReplayConfig& config)
+{
+    // This connection is made before the caller's, so the body can still be peeked at.
+    QObject::connect(reply, &QNetworkReply::finished, reply, [operation, requestUrl, reply, config]() {
+        const QVariant status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+        if (!status.isValid() || reply->error() == QNetworkReply::OperationCanceledError) {
+            return; // no response or aborted, e.g. timed out
+        }
+
+        NetworkFixture fixture;
+        fixture.url = reply->url();
+        fixture.statusCode = status.toInt();
+        for (const QNetworkReply::RawHeaderPair& header : reply->rawHeaderPairs()) {
+            if (!isTransferHeader(header.first)) {
+                fixture.headers.append(header);
+            }
+        }
+        fixture.body = reply->peek(reply->bytesAvailable());
+        fixture.error = reply->error();
+        fixture.errorString = (reply->error() != QNetworkReply::NoError) ? reply->errorString() : QString();
+
+        NetworkFixtureStore(QDir(config.fixtureDir)).save(operation, requestUrl, fixture);
+    });
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDir>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QUrl>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Recorded response of one request.
+struct NetworkFixture
+{
+    /// URL of the response, which differs from the request's URL if it was redirected.
+    QUrl url;
+    int statusCode = 0;
+    QList<QNetworkReply::RawHeaderPair> headers;
+    QByteArray body;
+    /// Error of the reply, e.g. ContentNotFoundError for "404 Not Found".
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QString errorString;
+};
+
+/// \brief Directory of recorded responses.
+///
+/// Each response is stored as "<host>/<hash>.json" (URL, status, headers and error) and
+/// "<host>/<hash>.body".  The hash is computed from the operation and the URL.  API keys are
+/// removed from the URL, so fixtures can be shared without leaking them.
+class NetworkFixtureStore
+{
+public:
+    explicit NetworkFixtureStore(QDir directory);
+
+    /// \brief Returns e.g. "GET https://api.themoviedb.org/3/movie/127380?language=en".
+    ///        Query items are sorted and API keys are removed.
+    static QString keyFor(QNetworkAccessManager::Operation operation, const QUrl& url);
+
+    bool load(QNetworkAccessManager::Operation operation, const QUrl& url, NetworkFixture& fixture) const;
+    bool save(QNetworkAccessManager::Operation operation, const QUrl& url, const NetworkFixture& fixture) const;
+
+private:
+    /// File path without extension.
+    QString basePath(QNetworkAccessManager::Operation operation, const QUrl& url) const;
+
+    QDir m_directory;
+};
+
+enum class ReplayMode
+{
+    /// Requests are sent to the network.
+    Off,
+    /// Requests are sent to the network and their responses are stored in the fixture directory.
+    Record,
+    /// Requests are answered from the fixture directory; nothing is sent to the network.
+    Replay
+};
+
+struct ReplayConfig
+{
+    ReplayMode mode = ReplayMode::Off;
+    QString fixtureDir;
+    /// Simulated time in milliseconds until the first byte of a replayed response arrives.
+    int latencyMs = 0;
+    /// Simulated bandwidth of replayed responses in KiB/s; 0 means unlimited.
+    int bandwidthKiBs = 0;
+};
+
+/// \brief Reads the configuration from the environment:
+///
+///  - MEDIAELCH_NETWORK_RECORD=<dir>: record all responses into <dir>
+///  - MEDIAELCH_NETWORK_REPLAY=<dir>: replay responses from <dir>
+///  - MEDIAELCH_NETWORK_LATENCY=<ms> and MEDIAELCH_NETWORK_BANDWIDTH=<KiB/s>: simulated
+///    network conditions for replayed responses
+ReplayConfig replayConfigFromEnvironment();
+
+/// \brief Configuration of accessManager()'s record/replay transport.  Defaults to
+///        replayConfigFromEnvironment().
+ReplayConfig replayConfig();
+void setReplayConfig(const ReplayConfig& config);
+
+/// \brief Returns a reply that serves the recorded response for \p request with the simulated
+///        latency and bandwidth of \p config.  If there is no recorded response, the reply fails
+///        with QNetworkReply::ContentNotFoundError.
+QNetworkReply* replayRequest(QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const ReplayConfig& config,
+    QObject* parent);
+
+/// \brief Stores the response of \p reply in the fixture directory of \p config once it has
+///        finished.  Must be called right after the request was sent.
+void recordReply(QNetworkAccessManager::Operation operation,
+    const QUrl& requestUrl,
+    QNetworkReply* reply,
+    const ReplayConfig& config);
+
+} // namespace network
+} // namespace mediaelch
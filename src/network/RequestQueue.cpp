@@ -0,0 +1,55 @@
+#include "network/RequestQueue.h"
+
+#include "network/NetworkManager.h"
+
+#include <memory>
+
+namespace mediaelch {
+namespace network {
+
+RequestQueue::RequestQueue(int maxConcurrentRequests, QObject* parent) :
+    QObject(parent), m_maxConcurrentRequests{qMax(1, maxConcurrentRequests)}
+{
+}
+
+void RequestQueue::get(const QNetworkRequest& request, QObject* context, StartedCallback started)
+{
+    m_queue.enqueue(QueuedRequest{request, context, std::move(started)});
+    startNext();
+}
+
+void RequestQueue::startNext()
+{
+    while (m_runningRequests < m_maxConcurrentRequests && !m_queue.isEmpty()) {
+        QueuedRequest next = m_queue.dequeue();
+        if (next.context.isNull()) {
+            continue; // e.g. the loader was aborted
+        }
+
+        QNetworkReply* reply = network::accessManager()->get(next.request);
+        ++m_runningRequests;
+        // Either signal frees the slot, whichever comes first. The reply may be deleted
+        // without having finished, e.g. if the caller aborts.
+        auto done = std::make_shared<bool>(false);
+        const auto onDone = [this, done]() {
+            if (!*done) {
+                *done = true;
+                onRequestDone();
+            }
+        };
+        connect(reply, &QNetworkReply::finished, this, onDone);
+        connect(reply, &QObject::destroyed, this, onDone);
+
+        next.started(reply);
+    }
+}
+
+void RequestQueue::onRequestDone()
+{
+    --m_runningRequests;
+    // Don't start new requests from within the reply's signal handlers.
+    QMetaObject::invokeMethod(this, "startNext", Qt::QueuedConnection);
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+
+#include <functional>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Sends GET requests with a bounded number of parallel requests.
+///
+/// Some sites throttle (or block) clients that send many requests at once. Requests that are
+/// sent through a RequestQueue are started in the order in which they were queued, but only
+/// maxConcurrentRequests at a time.
+///
+/// \example
+///   queue.get(request, this, [this](QNetworkReply* reply) {
+///       new NetworkReplyWatcher(this, reply);
+///       connect(reply, &QNetworkReply::finished, this, &Scraper::onLoadFinished);
+///   });
+///
+/// The callback is called once the request was started and must connect to the reply's signals.
+/// The caller owns the reply and must delete it (e.g. using deleteLater()) once it has finished.
+/// The queue must only be used from the thread it lives on.
+class RequestQueue : public QObject
+{
+    Q_OBJECT
+public:
+    using StartedCallback = std::function<void(QNetworkReply* reply)>;
+
+    explicit RequestQueue(int maxConcurrentRequests, QObject* parent = nullptr);
+
+    /// \brief Queues a GET request. If \p context is destroyed before the request is started,
+    /// the request is dropped and \p started is not called.
+    void get(const QNetworkRequest& request, QObject* context, StartedCallback started);
+
+    int maxConcurrentRequests() const { return m_maxConcurrentRequests; }
+    int runningRequests() const { return m_runningRequests; }
+    int queuedRequests() const { return m_queue.size(); }
+
+private slots:
+    void startNext();
+
+private:
+    struct QueuedRequest
+    {
+        QNetworkRequest request;
+        QPointer<QObject> context;
+        StartedCallback started;
+    };
+
+    void onRequestDone();
+
+    const int m_maxConcurrentRequests;
+    int m_runningRequests = 0;
+    QQueue<QueuedRequest> m_queue;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,357 @@
+#include "network/ScrapeStats.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSaveFile>
+#include <QStringList>
+#include <QUuid>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace mediaelch {
+namespace network {
+
+static const QNetworkRequest::Attribute ProviderAttribute = static_cast<QNetworkRequest::Attribute>(
+    QNetworkRequest::User + 100);
+static const QNetworkRequest::Attribute ItemAttribute = static_cast<QNetworkRequest::Attribute>(
+    QNetworkRequest::User + 101);
+static const QNetworkRequest::Attribute PhaseAttribute = static_cast<QNetworkRequest::Attribute>(
+    QNetworkRequest::User + 102);
+
+static const char* const TimedOutProperty = "mediaelchTimedOut";
+
+/// Version 1 files have no run ids.  Their samples are grouped into this run.
+static const char* const LegacyRun = "legacy";
+
+void setRequestTag(QNetworkRequest& request, const RequestTag& tag)
+{
+    request.setAttribute(ProviderAttribute, tag.provider);
+    request.setAttribute(ItemAttribute, tag.item);
+    request.setAttribute(PhaseAttribute, tag.phase);
+}
+
+RequestTag requestTag(const QNetworkRequest& request)
+{
+    RequestTag tag;
+    tag.provider = request.attribute(ProviderAttribute).toString();
+    tag.item = request.attribute(ItemAttribute).toString();
+    tag.phase = request.attribute(PhaseAttribute).toString();
+    if (tag.provider.isEmpty()) {
+        tag.provider = providerForHost(request.url().host());
+    }
+    if (tag.phase.isEmpty()) {
+        tag.phase = QStringLiteral("request");
+    }
+    return tag;
+}
+
+QString providerForHost(const QString& host)
+{
+    // clang-format off
+    static const QVector<QPair<QString, QString>> knownHosts = {
+        {"themoviedb.org",     "TMDb"},
+        {"tmdb.org",           "TMDb"},
+        {"imdb.com",           "IMDb"},
+        {"media-amazon.com",   "IMDb"},
+        {"fanart.tv",          "FanartTv"},
+        {"thetvdb.com",        "TheTvDb"},
+        {"ofdb.de",            "OFDb"},
+        {"allmusic.com",       "AllMusic"},
+        {"discogs.com",        "Discogs"},
+        {"theaudiodb.com",     "TheAudioDb"},
+        {"musicbrainz.org",    "MusicBrainz"},
+        {"videobuster.de",     "VideoBuster"},
+        {"aebn.net",           "AEBN"},
+        {"hotmovies.com",      "HotMovies"},
+        {"adultdvdempire.com", "AdultDvdEmpire"},
+        {"youtube.com",        "YouTube"}
+    };
+    // clang-format on
+    for (const auto& knownHost : knownHosts) {
+        if (host == knownHost.first || host.endsWith("." + knownHost.first)) {
+            return knownHost.second;
+        }
+    }
+    if (host.isEmpty()) {
+        return QStringLiteral("local");
+    }
+    return host.startsWith("www.") ? host.mid(4) : host;
+}
+
+QString criticalPathToString(const ItemCriticalPath& path)
+{
+    QStringList steps;
+    for (const RequestSample& request : path.path) {
+        steps << QStringLiteral("%1 %2 %3 ms").arg(request.tag.provider, request.tag.phase).arg(request.durationMs);
+    }
+    return steps.join(" > ");
+}
+
+ScrapeStats& ScrapeStats::instance()
+{
+    static ScrapeStats s_instance;
+    return s_instance;
+}
+
+ScrapeStats::ScrapeStats() : m_runId{QUuid::createUuid().toString()}
+{
+}
+
+QVector<qint64> ScrapeStats::histogramBuckets()
+{
+    return {100, 250, 500, 1000, 2500, 5000, 10000};
+}
+
+void ScrapeStats::watch(QNetworkReply* reply, int retries)
+{
+    if (reply == nullptr) {
+        return;
+    }
+
+    struct State
+    {
+        QElapsedTimer timer;
+        qint64 startedAt = 0;
+        qint64 bytes = 0;
+        bool recorded = false;
+    };
+    auto state = std::make_shared<State>();
+    state->timer.start();
+    state->startedAt = QDateTime::currentMSecsSinceEpoch();
+
+    QObject::connect(reply, &QNetworkReply::downloadProgress, reply, [state](qint64 received, qint64) {
+        state->bytes = received;
+    });
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, state, retries]() {
+        if (state->recorded) {
+            return;
+        }
+        state->recorded = true;
+
+        RequestSample sample;
+        sample.tag = requestTag(reply->request());
+        sample.startedAt = state->startedAt;
+        sample.durationMs = state->timer.elapsed();
+        sample.bytes = state->bytes;
+        sample.retries = retries;
+        sample.timedOut = reply->property(TimedOutProperty).toBool();
+        sample.failed = sample.timedOut || reply->error() != QNetworkReply::NoError;
+        record(sample);
+    });
+}
+
+void ScrapeStats::markTimedOut(QNetworkReply* reply)
+{
+    if (reply != nullptr) {
+        reply->setProperty(TimedOutProperty, true);
+    }
+}
+
+void ScrapeStats::record(const RequestSample& sample)
+{
+    RequestSample copy = sample;
+    if (copy.run.isEmpty()) {
+        copy.run = m_runId;
+    }
+    QMutexLocker locker(&m_mutex);
+    appendLocked(copy);
+}
+
+void ScrapeStats::appendLocked(const RequestSample& sample)
+{
+    if (m_samples.size() >= maxSamples()) {
+        // Drop the oldest tenth at once instead of shifting all samples for every new one.
+        m_samples.remove(0, maxSamples() / 10);
+    }
+    m_samples.append(sample);
+}
+
+QVector<RequestSample> ScrapeStats::samples() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_samples;
+}
+
+void ScrapeStats::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_samples.clear();
+}
+
+bool ScrapeStats::save(const QString& filePath) const
+{
+    QJsonArray array;
+    for (const RequestSample& sample : samples()) {
+        QJsonObject obj;
+        obj.insert("run", sample.run);
+        obj.insert("provider", sample.tag.provider);
+        obj.insert("item", sample.tag.item);
+        obj.insert("phase", sample.tag.phase);
+        obj.insert("startedAt", static_cast<double>(sample.startedAt));
+        obj.insert("durationMs", static_cast<double>(sample.durationMs));
+        obj.insert("bytes", static_cast<double>(sample.bytes));
+        obj.insert("retries", sample.retries);
+        obj.insert("timedOut", sample.timedOut);
+        obj.insert("failed", sample.failed);
+        array.append(obj);
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ScrapeStats] Could not write" << filePath;
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{{"version", 2}, {"samples", array}}).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
+bool ScrapeStats::load(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QJsonParseError parseError{};
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll(), &parseError).object();
+    const int version = json.value("version").toInt();
+    if (parseError.error != QJsonParseError::NoError || version < 1 || version > 2) {
+        qWarning() << "[ScrapeStats] Ignoring invalid file" << filePath << parseError.errorString();
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    for (const QJsonValue& value : json.value("samples").toArray()) {
+        const QJsonObject obj = value.toObject();
+        RequestSample sample;
+        sample.run = obj.value("run").toString(LegacyRun);
+        sample.tag.provider = obj.value("provider").toString();
+        sample.tag.item = obj.value("item").toString();
+        sample.tag.phase = obj.value("phase").toString();
+        sample.startedAt = static_cast<qint64>(obj.value("startedAt").toDouble());
+        sample.durationMs = static_cast<qint64>(obj.value("durationMs").toDouble());
+        sample.bytes = static_cast<qint64>(obj.value("bytes").toDouble());
+        sample.retries = obj.value("retries").toInt();
+        sample.timedOut = obj.value("timedOut").toBool();
+        sample.failed = obj.value("failed").toBool();
+        appendLocked(sample);
+    }
+    return true;
+}
+
+/// Nearest-rank percentile of sorted \p durations.
+static qint64 percentile(const QVector<qint64>& durations, double p)
+{
+    if (durations.isEmpty()) {
+        return 0;
+    }
+    const int rank = static_cast<int>(std::ceil(p * durations.size()));
+    return durations.at(qBound(0, rank - 1, durations.size() - 1));
+}
+
+QVector<ProviderStats> ScrapeStats::providerStats(const QVector<RequestSample>& samples)
+{
+    const QVector<qint64> buckets = histogramBuckets();
+    QMap<QString, ProviderStats> stats;
+    QMap<QString, QVector<qint64>> durations;
+
+    for (const RequestSample& sample : samples) {
+        ProviderStats& provider = stats[sample.tag.provider];
+        if (provider.histogram.isEmpty()) {
+            provider.provider = sample.tag.provider;
+            provider.histogram.fill(0, buckets.size() + 1);
+        }
+        ++provider.requests;
+        provider.failed += sample.failed ? 1 : 0;
+        provider.timeouts += sample.timedOut ? 1 : 0;
+        provider.retries += sample.retries;
+        provider.bytes += sample.bytes;
+        const auto bucket = std::lower_bound(buckets.cbegin(), buckets.cend(), sample.durationMs);
+        ++provider.histogram[static_cast<int>(bucket - buckets.cbegin())];
+        durations[sample.tag.provider].append(sample.durationMs);
+    }
+
+    QVector<ProviderStats> result;
+    for (ProviderStats& provider : stats) {
+        QVector<qint64>& sorted = durations[provider.provider];
+        std::sort(sorted.begin(), sorted.end());
+        provider.p50Ms = percentile(sorted, 0.50);
+        provider.p95Ms = percentile(sorted, 0.95);
+        provider.p99Ms = percentile(sorted, 0.99);
+        provider.maxMs = sorted.last();
+        result.append(provider);
+    }
+    return result;
+}
+
+QVector<ItemCriticalPath> ScrapeStats::criticalPaths(const QVector<RequestSample>& samples)
+{
+    // Only requests of the same run can overlap or follow each other.
+    QMap<QPair<QString, QString>, QVector<RequestSample>> items;
+    for (const RequestSample& sample : samples) {
+        if (!sample.tag.item.isEmpty()) {
+            items[qMakePair(sample.run, sample.tag.item)].append(sample);
+        }
+    }
+
+    QVector<ItemCriticalPath> result;
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        QVector<RequestSample>& requests = it.value();
+        std::sort(requests.begin(), requests.end(), [](const RequestSample& a, const RequestSample& b) {
+            return a.startedAt < b.startedAt;
+        });
+
+        // Longest chain of requests where each one started after its predecessor had finished.
+        // Items only have a few dozen requests, so quadratic time is fine.
+        const int n = requests.size();
+        QVector<qint64> longest(n, 0);
+        QVector<int> predecessor(n, -1);
+        qint64 firstStart = requests.first().startedAt;
+        qint64 lastEnd = 0;
+        int end = 0;
+        for (int i = 0; i < n; ++i) {
+            const RequestSample& request = requests.at(i);
+            longest[i] = request.durationMs;
+            for (int j = 0; j < i; ++j) {
+                const RequestSample& before = requests.at(j);
+                if (before.startedAt + before.durationMs <= request.startedAt
+                    && longest[j] + request.durationMs > longest[i]) {
+                    longest[i] = longest[j] + request.durationMs;
+                    predecessor[i] = j;
+                }
+            }
+            if (longest[i] > longest[end]) {
+                end = i;
+            }
+            lastEnd = qMax(lastEnd, request.startedAt + request.durationMs);
+        }
+
+        ItemCriticalPath path;
+        path.run = it.key().first;
+        path.item = it.key().second;
+        path.requests = n;
+        path.wallMs = lastEnd - firstStart;
+        path.criticalMs = longest[end];
+        for (int i = end; i >= 0; i = predecessor[i]) {
+            path.path.prepend(requests.at(i));
+        }
+        result.append(path);
+    }
+
+    std::sort(result.begin(), result.end(), [](const ItemCriticalPath& a, const ItemCriticalPath& b) {
+        return a.wallMs > b.wallMs;
+    });
+    return result;
+}
+
+} // namespace network
+} // namespace mediaelch
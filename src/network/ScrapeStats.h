@@ -0,0 +1,128 @@
+#pragma once
+
+#include <QMutex>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QVector>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Describes what a request is for: the provider that is asked, the item (movie, show, ...)
+/// that is scraped and the phase of scraping, e.g. "infos", "images" or "download".
+struct RequestTag
+{
+    QString provider;
+    QString item;
+    QString phase;
+};
+
+/// \brief Tags \p request so that its costs can be attributed in ScrapeStats.
+void setRequestTag(QNetworkRequest& request, const RequestTag& tag);
+/// \brief Returns the tag of \p request.  Missing values are derived from the URL:
+///        the provider from the host, the phase defaults to "request".
+RequestTag requestTag(const QNetworkRequest& request);
+/// \brief Returns a provider name for well-known scraper hosts, e.g. "TMDb" for
+///        "api.themoviedb.org", or the host itself.
+QString providerForHost(const QString& host);
+
+/// \brief Costs of one finished request.
+struct RequestSample
+{
+    RequestTag tag;
+    /// Session that recorded the sample, see ScrapeStats::runId().  Samples of earlier sessions are
+    /// loaded from disk, so the same item may have been scraped in several runs.
+    QString run;
+    /// Milliseconds since epoch when the request was sent.
+    qint64 startedAt = 0;
+    qint64 durationMs = 0;
+    qint64 bytes = 0;
+    /// How often the request was retried before, e.g. by the DownloadManager.
+    int retries = 0;
+    bool timedOut = false;
+    bool failed = false;
+};
+
+struct ProviderStats
+{
+    QString provider;
+    int requests = 0;
+    int failed = 0;
+    int timeouts = 0;
+    int retries = 0;
+    qint64 bytes = 0;
+    qint64 p50Ms = 0;
+    qint64 p95Ms = 0;
+    qint64 p99Ms = 0;
+    qint64 maxMs = 0;
+    /// Number of requests per latency bucket, see ScrapeStats::histogramBuckets().
+    QVector<int> histogram;
+};
+
+/// \brief The longest chain of consecutive requests of an item in one run.  Requests of an item that overlap
+/// run in parallel; the chain of requests where each one started after the previous one finished
+/// determines how long scraping the item took at least.
+struct ItemCriticalPath
+{
+    QString run;
+    QString item;
+    /// Time from the first request's start until the last request's end.
+    qint64 wallMs = 0;
+    int requests = 0;
+    /// Sum of the durations of the requests on the critical path.
+    qint64 criticalMs = 0;
+    /// Requests on the critical path in the order in which they were sent.
+    QVector<RequestSample> path;
+};
+
+/// \brief Returns e.g. "TMDb infos 310 ms > TMDb collection 120 ms > TMDb download 80 ms".
+QString criticalPathToString(const ItemCriticalPath& path);
+
+/// \brief Collects the costs of all scraper and download requests of a session.
+///
+/// Requests are recorded by watch(), which NetworkReplyWatcher and the DownloadManager call for
+/// every reply.  Only the last maxSamples() samples are kept.  Thread-safe.
+class ScrapeStats
+{
+public:
+    static ScrapeStats& instance();
+
+    static constexpr int maxSamples() { return 5000; }
+    /// \brief Upper bounds in milliseconds of the latency histogram's buckets.  The last bucket
+    ///        counts all requests that took longer.
+    static QVector<qint64> histogramBuckets();
+
+    /// \brief Records a sample once \p reply has finished.  The sample is tagged with the reply's
+    ///        request tag.  Must be called right after the request was sent.
+    void watch(QNetworkReply* reply, int retries = 0);
+    /// \brief Marks \p reply as timed out.  Call it before aborting the reply.
+    static void markTimedOut(QNetworkReply* reply);
+
+    /// \brief Identifies the samples of this session.
+    QString runId() const { return m_runId; }
+
+    /// \brief Adds \p sample.  Samples without a run are assigned to this session.
+    void record(const RequestSample& sample);
+    QVector<RequestSample> samples() const;
+    void clear();
+
+    /// \brief Stores all samples as JSON.
+    bool save(const QString& filePath) const;
+    /// \brief Adds the samples stored in \p filePath, e.g. of the previous session.
+    bool load(const QString& filePath);
+
+    static QVector<ProviderStats> providerStats(const QVector<RequestSample>& samples);
+    static QVector<ItemCriticalPath> criticalPaths(const QVector<RequestSample>& samples);
+
+private:
+    ScrapeStats();
+    void appendLocked(const RequestSample& sample);
+
+    const QString m_runId;
+    mutable QMutex m_mutex;
+    QVector<RequestSample> m_samples;
+};
+
+} // namespace network
+} // namespace mediaelch
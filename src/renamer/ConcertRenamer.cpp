@@ -8,16 +8,18 @@
 #include <QDir>
 #include <QFileInfo>
 
-ConcertRenamer::ConcertRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog) : Renamer(renamerConfig, dialog)
+ConcertRenamer::ConcertRenamer(RenamerConfig renamerConfig) : Renamer(renamerConfig)
 {
 }
 
-ConcertRenamer::RenameError ConcertRenamer::renameConcert(Concert& concert)
+mediaelch::RenamePlan::Item ConcertRenamer::planConcert(Concert& concert) const
 {
+    mediaelch::RenamePlan::Item item;
+    item.name = concert.name();
+
     QFileInfo concertInfo(concert.files().first().toString());
     QString fiCanonicalPath = concertInfo.canonicalPath();
     QDir dir(concertInfo.canonicalPath());
-    QString newFolderName = m_config.directoryPattern;
     QString newFileName;
     QStringList newConcertFiles;
     QString parentDirName;
@@ -25,8 +27,6 @@ ConcertRenamer::RenameError ConcertRenamer::renameConcert(Concert& concert)
     MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
     QString nfo = mediaCenter->nfoFilePath(&concert);
 
-    bool errorOccured = false;
-
     for (const mediaelch::FilePath& file : concert.files()) {
         QFileInfo fi(file.toString());
         newConcertFiles.append(fi.fileName());
@@ -43,64 +43,50 @@ ConcertRenamer::RenameError ConcertRenamer::renameConcert(Concert& concert)
         dir.cdUp();
     }
 
+    mediaelch::RenamerValues values;
+    values.set("title", concert.name());
+    values.set("artist", concert.artist());
+    values.set("album", concert.album());
+    values.set("year", concert.released().toString("yyyy"));
+    setStreamDetailValues(values, concert.streamDetails());
+
     if (!isBluRay && !isDvd && m_config.renameFiles) {
         newConcertFiles.clear();
         int partNo = 0;
-        const auto videoDetails = concert.streamDetails()->videoDetails();
+        const mediaelch::RenamerTemplate& filePattern =
+            (concert.files().count() == 1) ? m_filePattern : m_filePatternMulti;
+
         for (const mediaelch::FilePath& file : concert.files()) {
-            newFileName = (concert.files().count() == 1) ? m_config.filePattern : m_config.filePatternMulti;
             QFileInfo fi(file.toString());
             QString baseName = fi.completeBaseName();
             QDir currentDir = fi.dir();
 
-            Renamer::replace(newFileName, "title", concert.name());
-            Renamer::replace(newFileName, "artist", concert.artist());
-            Renamer::replace(newFileName, "album", concert.album());
-            Renamer::replace(newFileName, "year", concert.released().toString("yyyy"));
-            Renamer::replace(newFileName, "extension", fi.suffix());
-            Renamer::replace(newFileName, "partNo", QString::number(++partNo));
-            Renamer::replace(newFileName, "videoCodec", concert.streamDetails()->videoCodec());
-            Renamer::replace(newFileName, "audioCodec", concert.streamDetails()->audioCodec());
-            Renamer::replace(newFileName, "channels", QString::number(concert.streamDetails()->audioChannels()));
-            Renamer::replace(newFileName,
-                "resolution",
-                helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
-                    videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
-                    videoDetails.value(StreamDetails::VideoDetails::ScanType)));
-            Renamer::replaceCondition(
-                newFileName, "3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
+            mediaelch::RenamerValues fileValues = values;
+            fileValues.set("extension", fi.suffix());
+            fileValues.set("partNo", QString::number(++partNo));
+            newFileName = filePattern.render(fileValues);
             helper::sanitizeFileName(newFileName);
-            if (fi.fileName() != newFileName) {
-                if (!m_config.dryRun) {
-                    const int row =
-                        m_dialog->addResultToTable(fi.fileName(), newFileName, Renamer::RenameOperation::Rename);
-                    if (!Renamer::rename(file.toString(), fi.canonicalPath() + "/" + newFileName)) {
-                        m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                        errorOccured = true;
-                        continue;
-                    }
-                    newConcertFiles.append(newFileName);
-                }
-
-                QStringList filters;
-                for (const QString& extra : m_extraFiles.filters()) {
-                    filters << baseName + extra;
-                }
-                for (const QString& subFileName : currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
-                    QString subSuffix = subFileName.mid(baseName.length());
-                    QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
-                    QString newSubName = newBaseName + subSuffix;
-                    const int row =
-                        m_dialog->addResultToTable(subFileName, newSubName, Renamer::RenameOperation::Rename);
-                    if (!m_config.dryRun) {
-                        if (!Renamer::rename(currentDir.canonicalPath() + "/" + subFileName,
-                                currentDir.canonicalPath() + "/" + newSubName)) {
-                            m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                        }
-                    }
-                }
-            } else {
+
+            if (fi.fileName() == newFileName) {
                 newConcertFiles.append(fi.fileName());
+                continue;
+            }
+
+            item.rename(file.toString(), fi.canonicalPath() + "/" + newFileName, fi.fileName(), newFileName);
+            newConcertFiles.append(newFileName);
+
+            QStringList filters;
+            for (const QString& extra : m_extraFiles.filters()) {
+                filters << baseName + extra;
+            }
+            for (const QString& subFileName : currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
+                QString subSuffix = subFileName.mid(baseName.length());
+                QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
+                QString newSubName = newBaseName + subSuffix;
+                item.rename(currentDir.canonicalPath() + "/" + subFileName,
+                    currentDir.canonicalPath() + "/" + newSubName,
+                    subFileName,
+                    newSubName);
             }
         }
 
@@ -124,14 +110,7 @@ ConcertRenamer::RenameError ConcertRenamer::renameConcert(Concert& concert)
                 return;
             }
 
-            int row = m_dialog->addResultToTable(fileName, newDataFileName, Renamer::RenameOperation::Rename);
-            if (m_config.dryRun) {
-                return;
-            }
-
-            if (!Renamer::rename(filePath, fiCanonicalPath + "/" + newDataFileName)) {
-                m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-            }
+            item.rename(filePath, fiCanonicalPath + "/" + newDataFileName, fileName, newDataFileName);
         };
 
         const auto renameImageType = [&](ImageType imageType) {
@@ -145,61 +124,35 @@ ConcertRenamer::RenameError ConcertRenamer::renameConcert(Concert& concert)
         renameImageType(ImageType::ConcertBackdrop);
     }
 
-    int renameRow = -1;
+    QString newConcertFolder = dir.path();
     if (m_config.renameDirectories && concert.inSeparateFolder()) {
-        const auto videoDetails = concert.streamDetails()->videoDetails();
-        Renamer::replace(newFolderName, "title", concert.name());
-        Renamer::replace(newFolderName, "artist", concert.artist());
-        Renamer::replace(newFolderName, "album", concert.album());
-        Renamer::replace(newFolderName, "year", concert.released().toString("yyyy"));
-        Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
-        Renamer::replaceCondition(newFolderName, "dvd", isDvd);
-        Renamer::replaceCondition(
-            newFolderName, "3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
-        Renamer::replace(newFolderName, "videoCodec", concert.streamDetails()->videoCodec());
-        Renamer::replace(newFolderName, "audioCodec", concert.streamDetails()->audioCodec());
-        Renamer::replace(newFolderName, "channels", QString::number(concert.streamDetails()->audioChannels()));
-        Renamer::replace(newFolderName,
-            "resolution",
-            helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
-                videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
-                videoDetails.value(StreamDetails::VideoDetails::ScanType)));
+        mediaelch::RenamerValues directoryValues = values;
+        directoryValues.setCondition("bluray", isBluRay);
+        directoryValues.setCondition("dvd", isDvd);
+        QString newFolderName = m_directoryPattern.render(directoryValues);
         helper::sanitizeFileName(newFolderName);
         if (dir.dirName() != newFolderName) {
-            renameRow = m_dialog->addResultToTable(dir.dirName(), newFolderName, Renamer::RenameOperation::Rename);
-        }
-    }
-
-    QString newConcertFolder = dir.path();
-    if (!m_config.dryRun && dir.dirName() != newFolderName && m_config.renameDirectories
-        && concert.inSeparateFolder()) {
-        QDir parentDir(dir.path());
-        parentDir.cdUp();
-        if (!Renamer::rename(dir, parentDir.path() + "/" + newFolderName)) {
-            m_dialog->setResultStatus(renameRow, Renamer::RenameResult::Failed);
-            errorOccured = true;
-        } else {
+            QDir parentDir(dir.path());
+            parentDir.cdUp();
             newConcertFolder = parentDir.path() + "/" + newFolderName;
+            item.rename(dir.path(), newConcertFolder, dir.dirName(), newFolderName);
         }
     }
 
-    if (!errorOccured && !m_config.dryRun) {
-        QStringList files;
-        for (const QString& file : newConcertFiles) {
-            QString f = newConcertFolder;
-            if (isBluRay || isDvd) {
-                f += "/" + parentDirName;
-            }
-            f += "/" + file;
-            files << f;
+    QStringList files;
+    for (const QString& file : newConcertFiles) {
+        QString f = newConcertFolder;
+        if (isBluRay || isDvd) {
+            f += "/" + parentDirName;
         }
-        concert.setFiles(files);
-        Manager::instance()->database()->update(&concert);
+        f += "/" + file;
+        files << f;
     }
 
-
-    if (errorOccured) {
-        return RenameError::Error;
-    }
-    return RenameError::None;
+    Concert* concertPtr = &concert;
+    item.apply = [concertPtr, files]() {
+        concertPtr->setFiles(files);
+        Manager::instance()->databaseService()->update(concertPtr);
+    };
+    return item;
 }
@@ -1,13 +1,15 @@
 #pragma once
 
+#include "renamer/RenamePlan.h"
 #include "renamer/Renamer.h"
 
-class RenamerDialog;
 class Concert;
 
 class ConcertRenamer : public Renamer
 {
 public:
-    ConcertRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog);
-    RenameError renameConcert(Concert& concert);
+    explicit ConcertRenamer(RenamerConfig renamerConfig);
+    /// Computes all operations needed to rename the concert. Does not modify the
+    /// file system and can therefore be called for several concerts in parallel.
+    mediaelch::RenamePlan::Item planConcert(Concert& concert) const;
 };
@@ -8,25 +8,17 @@
 #include <QDir>
 #include <QFileInfo>
 
-EpisodeRenamer::EpisodeRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog) : Renamer(renamerConfig, dialog)
+EpisodeRenamer::EpisodeRenamer(RenamerConfig renamerConfig) : Renamer(renamerConfig)
 {
 }
 
-EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode,
-    QVector<TvShowEpisode*>& episodesRenamed)
+mediaelch::RenamePlan::Item EpisodeRenamer::planEpisode(TvShowEpisode& episode,
+    const QVector<TvShowEpisode*>& multiEpisodes) const
 {
-    const QString& seasonPattern = m_config.directoryPattern;
     const bool useSeasonDirectories = m_config.renameDirectories;
 
-    bool errorOccured = false;
-
-    QVector<TvShowEpisode*> multiEpisodes;
-    for (TvShowEpisode* subEpisode : episode.tvShow()->episodes()) {
-        if (subEpisode->files() == episode.files()) {
-            multiEpisodes.append(subEpisode);
-            episodesRenamed.append(subEpisode);
-        }
-    }
+    mediaelch::RenamePlan::Item item;
+    item.name = episode.title();
 
     const mediaelch::FilePath firstEpisode = episode.files().first();
     const bool isBluRay = helper::isBluRay(firstEpisode);
@@ -35,12 +27,11 @@ EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode
 
     QFileInfo episodeFileinfo(episode.files().first().toString());
     QString fiCanonicalPath = episodeFileinfo.canonicalPath();
-    mediaelch::FileList episodeFiles = episode.files();
     MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
     QString nfo = mediaCenter->nfoFilePath(&episode);
-    QString newNfoFileName = nfo;
+    QString newNfoFileName = QFileInfo(nfo).fileName();
     QString thumbnail = mediaCenter->imageFileName(&episode, ImageType::TvShowEpisodeThumb);
-    QString newThumbnailFileName = thumbnail;
+    QString newThumbnailFileName = QFileInfo(thumbnail).fileName();
     QStringList newEpisodeFiles;
 
     for (const mediaelch::FilePath& file : episode.files()) {
@@ -48,81 +39,65 @@ EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode
         newEpisodeFiles << info.fileName();
     }
 
+    mediaelch::RenamerValues values;
+    values.set("title", episode.title());
+    values.set("showTitle", episode.showTitle());
+    values.set("year", episode.firstAired().toString("yyyy"));
+    values.set("season", episode.seasonString());
+    setStreamDetailValues(values, episode.streamDetails());
+    if (multiEpisodes.count() > 1) {
+        QStringList episodeStrings;
+        for (TvShowEpisode* subEpisode : multiEpisodes) {
+            episodeStrings.append(subEpisode->episodeString());
+        }
+        std::sort(episodeStrings.begin(), episodeStrings.end());
+        values.set("episode", episodeStrings.join("-"));
+    } else {
+        values.set("episode", episode.episodeString());
+    }
+
     if (!isBluRay && !isDvd && !isDvdWithoutSub && m_config.renameFiles) {
         QString newFileName;
-        episodeFiles.clear();
-
         newEpisodeFiles.clear();
         int partNo = 0;
-        const auto videoDetails = episode.streamDetails()->videoDetails();
+        const mediaelch::RenamerTemplate& filePattern =
+            (episode.files().count() == 1) ? m_filePattern : m_filePatternMulti;
+
         for (const mediaelch::FilePath& file : episode.files()) {
-            newFileName = (episode.files().count() == 1) ? m_config.filePattern : m_config.filePatternMulti;
             QFileInfo episodeFileInfo(file.toString());
             QString baseName = episodeFileInfo.completeBaseName();
             QDir currentDir = episodeFileInfo.dir();
-            Renamer::replace(newFileName, "title", episode.title());
-            Renamer::replace(newFileName, "showTitle", episode.showTitle());
-            Renamer::replace(newFileName, "year", episode.firstAired().toString("yyyy"));
-            Renamer::replace(newFileName, "extension", episodeFileInfo.suffix());
-            Renamer::replace(newFileName, "season", episode.seasonString());
-            Renamer::replace(newFileName, "partNo", QString::number(++partNo));
-            Renamer::replace(newFileName, "videoCodec", episode.streamDetails()->videoCodec());
-            Renamer::replace(newFileName, "audioCodec", episode.streamDetails()->audioCodec());
-            Renamer::replace(newFileName, "channels", QString::number(episode.streamDetails()->audioChannels()));
-            Renamer::replace(newFileName,
-                "resolution",
-                helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
-                    videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
-                    videoDetails.value(StreamDetails::VideoDetails::ScanType)));
-            Renamer::replaceCondition(
-                newFileName, "3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
-
-            if (multiEpisodes.count() > 1) {
-                QStringList episodeStrings;
-                for (TvShowEpisode* subEpisode : multiEpisodes) {
-                    episodeStrings.append(subEpisode->episodeString());
-                }
-                std::sort(episodeStrings.begin(), episodeStrings.end());
-                Renamer::replace(newFileName, "episode", episodeStrings.join("-"));
-            } else {
-                Renamer::replace(newFileName, "episode", episode.episodeString());
-            }
 
+            mediaelch::RenamerValues fileValues = values;
+            fileValues.set("extension", episodeFileInfo.suffix());
+            fileValues.set("partNo", QString::number(++partNo));
+            newFileName = filePattern.render(fileValues);
             helper::sanitizeFileName(newFileName);
-            if (episodeFileInfo.fileName() != newFileName) {
-                const int episodeRow = m_dialog->addResultToTable(
-                    episodeFileInfo.fileName(), newFileName, Renamer::RenameOperation::Rename);
-                if (!m_config.dryRun) {
-                    if (!Renamer::rename(file.toString(), episodeFileInfo.canonicalPath() + "/" + newFileName)) {
-                        m_dialog->setResultStatus(episodeRow, Renamer::RenameResult::Failed);
-                        errorOccured = true;
-                    } else {
-                        newEpisodeFiles << newFileName;
-                    }
-                }
 
-                QStringList filters;
-                for (const QString& extra : m_extraFiles.filters()) {
-                    filters << baseName + extra;
-                }
-                for (const QString& subFileName : currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
-                    QString subSuffix = subFileName.mid(baseName.length());
-                    QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
-                    QString newSubName = newBaseName + subSuffix;
-                    const int row =
-                        m_dialog->addResultToTable(subFileName, newSubName, Renamer::RenameOperation::Rename);
-                    if (!m_config.dryRun) {
-                        if (!Renamer::rename(currentDir.canonicalPath() + "/" + subFileName,
-                                currentDir.canonicalPath() + "/" + newSubName)) {
-                            m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                            errorOccured = true;
-                        }
-                    }
-                }
-            } else {
+            if (episodeFileInfo.fileName() == newFileName) {
                 newEpisodeFiles << episodeFileInfo.fileName();
+                continue;
+            }
+
+            item.rename(file.toString(),
+                episodeFileInfo.canonicalPath() + "/" + newFileName,
+                episodeFileInfo.fileName(),
+                newFileName);
+            newEpisodeFiles << newFileName;
+
+            QStringList filters;
+            for (const QString& extra : m_extraFiles.filters()) {
+                filters << baseName + extra;
+            }
+            for (const QString& subFileName : currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
+                QString subSuffix = subFileName.mid(baseName.length());
+                QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
+                QString newSubName = newBaseName + subSuffix;
+                item.rename(currentDir.canonicalPath() + "/" + subFileName,
+                    currentDir.canonicalPath() + "/" + newSubName,
+                    subFileName,
+                    newSubName);
             }
-            episodeFiles << mediaelch::FilePath(episodeFileInfo.canonicalPath() + "/" + newFileName);
         }
 
         // Rename nfo
@@ -133,12 +108,7 @@ EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode
                 newNfoFileName = nfoFiles.first().saveFileName(newFileName);
                 helper::sanitizeFileName(newNfoFileName);
                 if (newNfoFileName != nfoFileName) {
-                    int row = m_dialog->addResultToTable(nfoFileName, newNfoFileName, Renamer::RenameOperation::Rename);
-                    if (!m_config.dryRun) {
-                        if (!Renamer::rename(nfo, fiCanonicalPath + "/" + newNfoFileName)) {
-                            m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                        }
-                    }
+                    item.rename(nfo, fiCanonicalPath + "/" + newNfoFileName, nfoFileName, newNfoFileName);
                 }
             }
         }
@@ -152,41 +122,31 @@ EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode
                     newFileName, SeasonNumber::NoSeason, episode.files().count() > 1);
                 helper::sanitizeFileName(newThumbnailFileName);
                 if (newThumbnailFileName != thumbnailFileName) {
-                    int row = m_dialog->addResultToTable(
-                        thumbnailFileName, newThumbnailFileName, Renamer::RenameOperation::Rename);
-                    if (!m_config.dryRun) {
-                        if (!Renamer::rename(thumbnail, fiCanonicalPath + "/" + newThumbnailFileName)) {
-                            m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                        }
-                    }
+                    item.rename(thumbnail,
+                        fiCanonicalPath + "/" + newThumbnailFileName,
+                        thumbnailFileName,
+                        newThumbnailFileName);
                 }
             }
         }
     }
 
-    if (!m_config.dryRun) {
-        QStringList files;
-        for (const QString& file : newEpisodeFiles) {
-            files << episodeFileinfo.path() + "/" + file;
-        }
-        episode.setFiles(files);
-        Manager::instance()->database()->update(&episode);
+    QStringList files;
+    for (const QString& file : newEpisodeFiles) {
+        files << episodeFileinfo.path() + "/" + file;
     }
 
     if (useSeasonDirectories) {
         QDir showDir(episode.tvShow()->dir().toString());
-        QString seasonDirName = seasonPattern;
-        Renamer::replace(seasonDirName, "season", episode.seasonString());
-        Renamer::replace(seasonDirName, "showTitle", episode.showTitle());
+        mediaelch::RenamerValues seasonValues;
+        seasonValues.set("season", episode.seasonString());
+        seasonValues.set("showTitle", episode.showTitle());
+        QString seasonDirName = m_directoryPattern.render(seasonValues);
         helper::sanitizeFileName(seasonDirName);
         QDir seasonDir(showDir.path() + "/" + seasonDirName);
         if (!seasonDir.exists()) {
-            int row = m_dialog->addResultToTable(seasonDirName, "", Renamer::RenameOperation::CreateDir);
-            if (!m_config.dryRun) {
-                if (!showDir.mkdir(seasonDirName)) {
-                    m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                }
-            }
+            // Created once for all episodes of the season, see RenamePlan::detectConflicts().
+            item.createDir(seasonDir.path(), seasonDirName);
         }
 
         if (isBluRay || isDvd || isDvdWithoutSub) {
@@ -198,66 +158,45 @@ EpisodeRenamer::RenameError EpisodeRenamer::renameEpisode(TvShowEpisode& episode
             QDir parentDir = dir;
             parentDir.cdUp();
             if (parentDir != seasonDir) {
-                int row = m_dialog->addResultToTable(dir.dirName(), seasonDirName, Renamer::RenameOperation::Move);
-                if (!m_config.dryRun) {
-                    if (!Renamer::rename(dir, seasonDir.absolutePath() + "/" + dir.dirName())) {
-                        m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                        errorOccured = true;
-                    } else {
-                        newEpisodeFiles.clear();
-                        QString oldDir = dir.absolutePath();
-                        QString newDir = seasonDir.absolutePath() + "/" + dir.dirName();
-                        for (const mediaelch::FilePath& file : episode.files()) {
-                            newEpisodeFiles << newDir + file.toString().mid(oldDir.length());
-                        }
-                        episode.setFiles(newEpisodeFiles);
-                        Manager::instance()->database()->update(&episode);
-                    }
+                QString oldDir = dir.absolutePath();
+                QString newDir = seasonDir.absolutePath() + "/" + dir.dirName();
+                item.move(oldDir, newDir, dir.dirName(), seasonDirName);
+                QStringList movedFiles;
+                for (const QString& file : files) {
+                    movedFiles << newDir + file.mid(oldDir.length());
                 }
+                files = movedFiles;
             }
+
         } else if (episodeFileinfo.dir() != seasonDir) {
-            newEpisodeFiles.clear();
-            for (const mediaelch::FilePath& fileName : episode.files()) {
-                QFileInfo fi(fileName.toString());
-                int row = m_dialog->addResultToTable(fi.fileName(), seasonDirName, Renamer::RenameOperation::Move);
-                if (!m_config.dryRun) {
-                    if (!Renamer::rename(fileName.toString(), seasonDir.path() + "/" + fi.fileName())) {
-                        m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                        errorOccured = true;
-                    } else {
-                        newEpisodeFiles << seasonDir.path() + "/" + fi.fileName();
-                    }
-                }
-            }
-            if (!m_config.dryRun) {
-                episode.setFiles(newEpisodeFiles);
-                Manager::instance()->database()->update(&episode);
+            QStringList movedFiles;
+            for (const QString& file : files) {
+                QFileInfo fi(file);
+                item.move(file, seasonDir.path() + "/" + fi.fileName(), fi.fileName(), seasonDirName);
+                movedFiles << seasonDir.path() + "/" + fi.fileName();
             }
+            files = movedFiles;
 
-            if (!newNfoFileName.isEmpty() && !nfo.isEmpty()) {
-                int row = m_dialog->addResultToTable(newNfoFileName, seasonDirName, Renamer::RenameOperation::Move);
-                if (!m_config.dryRun) {
-                    if (!Renamer::rename(
-                            fiCanonicalPath + "/" + newNfoFileName, seasonDir.path() + "/" + newNfoFileName)) {
-                        m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                    }
-                }
+            if (!newNfoFileName.isEmpty()) {
+                item.move(fiCanonicalPath + "/" + newNfoFileName,
+                    seasonDir.path() + "/" + newNfoFileName,
+                    newNfoFileName,
+                    seasonDirName);
             }
-            if (!thumbnail.isEmpty() && !newThumbnailFileName.isEmpty()) {
-                int row =
-                    m_dialog->addResultToTable(newThumbnailFileName, seasonDirName, Renamer::RenameOperation::Move);
-                if (!m_config.dryRun) {
-                    if (!Renamer::rename(fiCanonicalPath + "/" + newThumbnailFileName,
-                            seasonDir.path() + "/" + newThumbnailFileName)) {
-                        m_dialog->setResultStatus(row, Renamer::RenameResult::Failed);
-                    }
-                }
+            if (!newThumbnailFileName.isEmpty()) {
+                item.move(fiCanonicalPath + "/" + newThumbnailFileName,
+                    seasonDir.path() + "/" + newThumbnailFileName,
+                    newThumbnailFileName,
+                    seasonDirName);
             }
         }
     }
 
-    if (errorOccured) {
-        return RenameError::Error;
-    }
-    return RenameError::None;
+    item.apply = [multiEpisodes, files]() {
+        for (TvShowEpisode* subEpisode : multiEpisodes) {
+            subEpisode->setFiles(files);
+            Manager::instance()->databaseService()->update(subEpisode);
+        }
+    };
+    return item;
 }
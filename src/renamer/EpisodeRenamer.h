@@ -1,12 +1,17 @@
 #pragma once
+
+#include "renamer/RenamePlan.h"
 #include "renamer/Renamer.h"
 
-class RenamerDialog;
 class TvShowEpisode;
 
 class EpisodeRenamer : public Renamer
 {
 public:
-    EpisodeRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog);
-    RenameError renameEpisode(TvShowEpisode& episode, QVector<TvShowEpisode*>& episodesRenamed);
+    explicit EpisodeRenamer(RenamerConfig renamerConfig);
+    /// Computes all operations needed to rename the episode. multiEpisodes contains all
+    /// episodes that are stored in the same files, including the episode itself.
+    /// Does not modify the file system and can therefore be called in parallel.
+    mediaelch::RenamePlan::Item planEpisode(TvShowEpisode& episode,
+        const QVector<TvShowEpisode*>& multiEpisodes) const;
 };
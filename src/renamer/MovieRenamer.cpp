@@ -7,26 +7,30 @@
 
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
 
-MovieRenamer::MovieRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog) : Renamer(renamerConfig, dialog)
+MovieRenamer::MovieRenamer(RenamerConfig renamerConfig) : Renamer(renamerConfig)
 {
 }
 
-MovieRenamer::RenameError MovieRenamer::renameMovie(Movie& movie)
+mediaelch::RenamePlan::Item MovieRenamer::planMovie(Movie& movie) const
 {
+    mediaelch::RenamePlan::Item item;
+    item.name = movie.name();
+
     QFileInfo movieInfo(movie.files().first().toString());
     QString fiCanonicalPath = movieInfo.canonicalPath();
     QDir dir(movieInfo.canonicalPath());
-    QString newFolderName = m_config.directoryPattern;
 
     MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
     QString nfo = mediaCenter->nfoFilePath(&movie);
 
     QString newFileName;
-    QStringList FilmFiles;
+    // All files of the movie after renaming them. They are moved if a new directory is created.
+    QStringList filmFiles;
     QStringList newMovieFiles;
+    QHash<Subtitle*, QStringList> newSubtitleFiles;
     QString parentDirName;
-    bool errorOccured = false;
 
     for (const mediaelch::FilePath& file : movie.files()) {
         newMovieFiles.append(file.fileName());
@@ -48,125 +52,84 @@ MovieRenamer::RenameError MovieRenamer::renameMovie(Movie& movie)
         dir.cdUp();
     }
 
+    mediaelch::RenamerValues values;
+    values.set("title", movie.name());
+    values.set("originalTitle", movie.originalName());
+    values.set("sortTitle", movie.sortTitle());
+    values.set("year", movie.released().toString("yyyy"));
+    values.setValueCondition("imdbId", movie.imdbId().toString());
+    values.setValueCondition("movieset", movie.set().name);
+    setStreamDetailValues(values, movie.streamDetails());
+
     if (!isBluRay && !isDvd && m_config.renameFiles) {
         newMovieFiles.clear();
         int partNo = 0;
-        const auto videoDetails = movie.streamDetails()->videoDetails();
+        bool subtitlesRenamed = false;
+        const mediaelch::RenamerTemplate& filePattern =
+            (movie.files().count() == 1) ? m_filePattern : m_filePatternMulti;
+
         for (const mediaelch::FilePath& file : movie.files()) {
-            newFileName = (movie.files().count() == 1) ? m_config.filePattern : m_config.filePatternMulti;
             QFileInfo fi(file.toString());
-            QString baseName = fi.completeBaseName();
-            QDir currentDir = fi.dir();
-            MovieRenamer::replace(newFileName, "title", movie.name());
-            MovieRenamer::replace(newFileName, "originalTitle", movie.originalName());
-            MovieRenamer::replace(newFileName, "sortTitle", movie.sortTitle());
-            MovieRenamer::replace(newFileName, "year", movie.released().toString("yyyy"));
-            MovieRenamer::replace(newFileName, "extension", fi.suffix());
-            MovieRenamer::replace(newFileName, "partNo", QString::number(++partNo));
-            MovieRenamer::replace(newFileName, "videoCodec", movie.streamDetails()->videoCodec());
-            MovieRenamer::replace(newFileName, "audioCodec", movie.streamDetails()->audioCodec());
-            MovieRenamer::replace(newFileName, "channels", QString::number(movie.streamDetails()->audioChannels()));
-            MovieRenamer::replace(newFileName,
-                "resolution",
-                helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
-                    videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
-                    videoDetails.value(StreamDetails::VideoDetails::ScanType)));
-            MovieRenamer::replaceCondition(newFileName, "imdbId", movie.imdbId().toString());
-            MovieRenamer::replaceCondition(newFileName, "movieset", movie.set().name);
-            MovieRenamer::replaceCondition(
-                newFileName, "3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
+            mediaelch::RenamerValues fileValues = values;
+            fileValues.set("extension", fi.suffix());
+            fileValues.set("partNo", QString::number(++partNo));
+            newFileName = filePattern.render(fileValues);
             helper::sanitizeFileName(newFileName);
-            if (fi.fileName() != newFileName) {
-                if (!m_config.dryRun) {
-                    const int row = m_dialog->addResultToTable(fi.fileName(), newFileName, RenameOperation::Rename);
-                    if (!rename(file.toString(), fi.canonicalPath() + "/" + newFileName)) {
-                        m_dialog->setResultStatus(row, RenameResult::Failed);
-                        errorOccured = true;
-                        continue;
-                    }
-                    FilmFiles.append(newFileName);
-                    newMovieFiles.append(newFileName);
 
+            if (fi.fileName() == newFileName) {
+                filmFiles.append(fi.fileName());
+                newMovieFiles.append(fi.fileName());
+                continue;
+            }
+
+            item.rename(file.toString(), fi.canonicalPath() + "/" + newFileName, fi.fileName(), newFileName);
+            filmFiles.append(newFileName);
+            newMovieFiles.append(newFileName);
+
+            for (const QString& trailerFile : fi.dir().entryList(
+                     QStringList() << fi.completeBaseName() + "-trailer.*", QDir::Files | QDir::NoDotAndDotDot)) {
+                QFileInfo trailer(fi.canonicalPath() + "/" + trailerFile);
+                QString newTrailerFileName =
+                    newFileName.left(newFileName.lastIndexOf(".")) + "-trailer." + trailer.suffix();
+                if (trailer.fileName() != newTrailerFileName) {
+                    item.rename(fi.canonicalPath() + "/" + trailerFile,
+                        fi.canonicalPath() + "/" + newTrailerFileName,
+                        trailer.fileName(),
+                        newTrailerFileName);
+                    filmFiles.append(newTrailerFileName);
                 } else {
-                    FilmFiles.append(newFileName);
+                    filmFiles.append(trailer.fileName());
                 }
+            }
 
-                for (const QString& trailerFile : currentDir.entryList(
-                         QStringList() << fi.completeBaseName() + "-trailer.*", QDir::Files | QDir::NoDotAndDotDot)) {
-                    QFileInfo trailer(fi.canonicalPath() + "/" + trailerFile);
-                    QString newTrailerFileName = newFileName;
-                    newTrailerFileName =
-                        newTrailerFileName.left(newTrailerFileName.lastIndexOf(".")) + "-trailer." + trailer.suffix();
-                    if (trailer.fileName() != newTrailerFileName) {
-                        const int row =
-                            m_dialog->addResultToTable(trailer.fileName(), newTrailerFileName, RenameOperation::Rename);
-                        if (!m_config.dryRun) {
-                            if (!rename(fi.canonicalPath() + "/" + trailerFile,
-                                    fi.canonicalPath() + "/" + newTrailerFileName)) {
-                                m_dialog->setResultStatus(row, RenameResult::Failed);
-                            } else {
-                                FilmFiles.append(newTrailerFileName);
-                            }
-                        } else {
-                            FilmFiles.append(newTrailerFileName);
-                        }
-                    } else {
-                        FilmFiles.append(trailer.fileName());
-                    }
+            // Subtitles belong to the whole movie and are named after its first renamed file.
+            if (subtitlesRenamed) {
+                continue;
+            }
+            subtitlesRenamed = true;
+            for (Subtitle* subtitle : movie.subtitles()) {
+                QString subFileName = QFileInfo(newFileName).completeBaseName();
+                if (!subtitle->language().isEmpty()) {
+                    subFileName.append("." + subtitle->language());
                 }
-
-                /*
-                QStringList filters;
-                for (const QString &extra: m_extraFiles)
-                    filters << baseName + extra;
-                for (const QString &subFileName: currentDir.entryList(filters, QDir::Files |
-                QDir::NoDotAndDotDot)) { QString subSuffix = subFileName.mid(baseName.length()); QString newBaseName
-                = newFileName.left(newFileName.lastIndexOf(".")); QString newSubName = newBaseName + subSuffix;
-                    ui->results->append(tr("<b>Rename File</b> \"%1\" to \"%2\"").arg(subFileName).arg(newSubName));
-                    if (!dryRun) {
-                        if (!rename(currentDir.canonicalPath() + "/" + subFileName, currentDir.canonicalPath() + "/"
-                + newSubName)) ui->results->append("&nbsp;&nbsp;<span style=\"color:#ff0000;\"><b>" + tr("Failed") +
-                "</b></span>"); else FilmFiles.append(newSubName);
-                    }
-                    else
-                        FilmFiles.append(newSubName);
+                if (subtitle->forced()) {
+                    subFileName.append(".forced");
                 }
-                */
-
-                for (Subtitle* subtitle : movie.subtitles()) {
-                    QString subFileName = QFileInfo(newFileName).completeBaseName();
-                    if (!subtitle->language().isEmpty()) {
-                        subFileName.append("." + subtitle->language());
-                    }
-                    if (subtitle->forced()) {
-                        subFileName.append(".forced");
-                    }
 
-                    QStringList newSubFiles;
-                    for (const QString& subFile : subtitle->files()) {
-                        QFileInfo subFi(fi.canonicalPath() + "/" + subFile);
-                        QString newSubFileName = subFileName + "." + subFi.suffix();
-                        int row = m_dialog->addResultToTable(subFile, newSubFileName, RenameOperation::Rename);
-                        if (!m_config.dryRun) {
-                            if (!rename(
-                                    fi.canonicalPath() + "/" + subFile, fi.canonicalPath() + "/" + newSubFileName)) {
-                                newSubFiles << subFile;
-                                m_dialog->setResultStatus(row, RenameResult::Failed);
-                            } else {
-                                newSubFiles << newSubFileName;
-                                FilmFiles.append(newSubFileName);
-                            }
-                        } else {
-                            FilmFiles.append(newSubFileName);
-                        }
-                    }
-                    if (!m_config.dryRun) {
-                        subtitle->setFiles(newSubFiles, false);
+                QStringList newSubFiles;
+                for (const QString& subFile : subtitle->files()) {
+                    QFileInfo subFi(fi.canonicalPath() + "/" + subFile);
+                    QString newSubFileName = subFileName + "." + subFi.suffix();
+                    if (subFile != newSubFileName) {
+                        item.rename(fi.canonicalPath() + "/" + subFile,
+                            fi.canonicalPath() + "/" + newSubFileName,
+                            subFile,
+                            newSubFileName);
                     }
+                    newSubFiles << newSubFileName;
+                    filmFiles.append(newSubFileName);
                 }
-            } else {
-                FilmFiles.append(fi.fileName());
-                newMovieFiles.append(fi.fileName());
+                newSubtitleFiles.insert(subtitle, newSubFiles);
             }
         }
 
@@ -189,21 +152,12 @@ MovieRenamer::RenameError MovieRenamer::renameMovie(Movie& movie)
 
             if (newDataFileName == fileName) {
                 // File already has correct name
-                FilmFiles.append(fileName);
-                return;
-            }
-
-            int row = m_dialog->addResultToTable(fileName, newDataFileName, RenameOperation::Rename);
-            if (m_config.dryRun) {
-                FilmFiles.append(newDataFileName);
+                filmFiles.append(fileName);
                 return;
             }
 
-            if (rename(filePath, fiCanonicalPath + "/" + newDataFileName)) {
-                FilmFiles.append(newDataFileName);
-            } else {
-                m_dialog->setResultStatus(row, RenameResult::Failed);
-            }
+            item.rename(filePath, fiCanonicalPath + "/" + newDataFileName, fileName, newDataFileName);
+            filmFiles.append(newDataFileName);
         };
 
         const auto renameImageType = [&](ImageType imageType) {
@@ -222,123 +176,57 @@ MovieRenamer::RenameError MovieRenamer::renameMovie(Movie& movie)
         renameImageType(ImageType::MovieCdArt);
     }
 
-    int renameRow = -1;
     QString newMovieFolder = dir.path();
-    QString extension = !movie.files().isEmpty() ? movie.files().first().fileSuffix() : "";
-    const auto videoDetails = movie.streamDetails()->videoDetails();
-    // rename dir for already existe films dir
-    if (m_config.renameDirectories && movie.inSeparateFolder()) {
-        Renamer::replace(newFolderName, "title", movie.name());
-        Renamer::replace(newFolderName, "extension", extension);
-        Renamer::replace(newFolderName, "originalTitle", movie.originalName());
-        Renamer::replace(newFolderName, "sortTitle", movie.sortTitle());
-        Renamer::replace(newFolderName, "year", movie.released().toString("yyyy"));
-        Renamer::replace(newFolderName, "videoCodec", movie.streamDetails()->videoCodec());
-        Renamer::replace(newFolderName, "audioCodec", movie.streamDetails()->audioCodec());
-        Renamer::replace(newFolderName, "channels", QString::number(movie.streamDetails()->audioChannels()));
-        Renamer::replace(newFolderName,
-            "resolution",
-            helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
-                videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
-                videoDetails.value(StreamDetails::VideoDetails::ScanType)));
-        Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
-        Renamer::replaceCondition(newFolderName, "dvd", isDvd);
-        Renamer::replaceCondition(
-            newFolderName, "3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
-        Renamer::replaceCondition(newFolderName, "movieset", movie.set().name);
-        Renamer::replaceCondition(newFolderName, "imdbId", movie.imdbId().toString());
-        helper::sanitizeFileName(newFolderName);
-        if (dir.dirName() != newFolderName) {
-            renameRow = m_dialog->addResultToTable(dir.dirName(), newFolderName, RenameOperation::Rename);
-        }
-    }
-    // create dir for new dir structure
-    else if (m_config.renameDirectories) {
-        Renamer::replace(newFolderName, "title", movie.name());
-        Renamer::replace(newFolderName, "extension", extension);
-        Renamer::replace(newFolderName, "originalTitle", movie.originalName());
-        Renamer::replace(newFolderName, "sortTitle", movie.sortTitle());
-        Renamer::replace(newFolderName, "year", movie.released().toString("yyyy"));
-        Renamer::replace(newFolderName, "videoCodec", movie.streamDetails()->videoCodec());
-        Renamer::replace(newFolderName, "audioCodec", movie.streamDetails()->audioCodec());
-        Renamer::replace(newFolderName, "channels", QString::number(movie.streamDetails()->audioChannels()));
-        Renamer::replace(newFolderName,
-            "resolution",
-            helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
-                videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
-                videoDetails.value(StreamDetails::VideoDetails::ScanType)));
-        Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
-        Renamer::replaceCondition(newFolderName, "dvd", isDvd);
-        Renamer::replaceCondition(
-            newFolderName, "3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
-        Renamer::replaceCondition(newFolderName, "movieset", movie.set().name);
-        Renamer::replaceCondition(newFolderName, "imdbId", movie.imdbId().toString());
+    if (m_config.renameDirectories) {
+        mediaelch::RenamerValues directoryValues = values;
+        directoryValues.set("extension", movie.files().first().fileSuffix());
+        directoryValues.setCondition("bluray", isBluRay);
+        directoryValues.setCondition("dvd", isDvd);
+        QString newFolderName = m_directoryPattern.render(directoryValues);
         helper::sanitizeFileName(newFolderName);
 
-        if (dir.dirName() != newFolderName) { // check if movie is not already on good folder
+        if (dir.dirName() != newFolderName && movie.inSeparateFolder()) {
+            // rename dir for already existe films dir
+            QDir parentDir(dir.path());
+            parentDir.cdUp();
+            newMovieFolder = parentDir.path() + "/" + newFolderName;
+            item.rename(dir.path(), newMovieFolder, dir.dirName(), newFolderName);
+
+        } else if (dir.dirName() != newFolderName) {
+            // create dir for new dir structure
             int i = 0;
             while (dir.exists(newFolderName)) {
                 newFolderName = newFolderName + " " + QString::number(++i);
             }
-
-
-            if (!m_config.dryRun) {
-                const int row = m_dialog->addResultToTable(dir.dirName(), newFolderName, RenameOperation::CreateDir);
-                if (!dir.mkdir(newFolderName)) {
-                    m_dialog->setResultStatus(row, RenameResult::Failed);
-                    return RenameError::Error;
-                }
-                newMovieFolder = dir.path() + "/" + newFolderName;
-            }
-
-            for (const QString& fileName : FilmFiles) {
-                QFileInfo fi(fileName);
-                if (dir.dirName() != newFolderName) {
-                    const int row = m_dialog->addResultToTable(fi.fileName(),
-                        dir.dirName() + "/" + newFolderName + "/" + fi.fileName(),
-                        RenameOperation::Move);
-                    m_dialog->appendResultText(QObject::tr(R"(<b>Move File</b> "%1" to "%2")")
-                                                   .arg(fi.fileName())
-                                                   .arg(dir.dirName() + "/" + newFolderName + "/" + fi.fileName()));
-                    if (!m_config.dryRun) {
-                        if (!rename(dir.absolutePath() + "/" + fileName,
-                                dir.absolutePath() + "/" + newFolderName + "/" + fi.fileName())) {
-                            m_dialog->setResultStatus(row, RenameResult::Failed);
-                        }
-                    }
-                }
+            newMovieFolder = dir.path() + "/" + newFolderName;
+            item.createDir(newMovieFolder, dir.dirName(), newFolderName);
+
+            for (const QString& fileName : filmFiles) {
+                item.move(dir.absolutePath() + "/" + fileName,
+                    newMovieFolder + "/" + fileName,
+                    fileName,
+                    dir.dirName() + "/" + newFolderName + "/" + fileName);
             }
         }
     }
 
-
-    if (!m_config.dryRun && dir.dirName() != newFolderName && m_config.renameDirectories && movie.inSeparateFolder()) {
-        QDir parentDir(dir.path());
-        parentDir.cdUp();
-        if (!rename(dir, parentDir.path() + "/" + newFolderName)) {
-            m_dialog->setResultStatus(renameRow, RenameResult::Failed);
-            errorOccured = true;
-        } else {
-            newMovieFolder = parentDir.path() + "/" + newFolderName;
+    QStringList files;
+    for (const QString& file : newMovieFiles) {
+        QString f = newMovieFolder;
+        if (isBluRay || isDvd) {
+            f += "/" + parentDirName;
         }
+        f += "/" + file;
+        files << f;
     }
 
-    if (!errorOccured && !m_config.dryRun) {
-        QStringList files;
-        for (const QString& file : newMovieFiles) {
-            QString f = newMovieFolder;
-            if (isBluRay || isDvd) {
-                f += "/" + parentDirName;
-            }
-            f += "/" + file;
-            files << f;
+    Movie* moviePtr = &movie;
+    item.apply = [moviePtr, files, newSubtitleFiles]() {
+        for (auto it = newSubtitleFiles.cbegin(); it != newSubtitleFiles.cend(); ++it) {
+            it.key()->setFiles(it.value(), false);
         }
-        movie.setFiles(files);
-        Manager::instance()->database()->update(&movie);
-    }
-
-    if (errorOccured) {
-        return RenameError::Error;
-    }
-    return RenameError::None;
+        moviePtr->setFiles(files);
+        Manager::instance()->databaseService()->update(moviePtr);
+    };
+    return item;
 }
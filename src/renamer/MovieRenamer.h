@@ -1,13 +1,15 @@
 #pragma once
 
+#include "renamer/RenamePlan.h"
 #include "renamer/Renamer.h"
 
-class RenamerDialog;
 class Movie;
 
 class MovieRenamer : public Renamer
 {
 public:
-    MovieRenamer(RenamerConfig renamerConfig, RenamerDialog* dialog);
-    RenameError renameMovie(Movie& movie);
+    explicit MovieRenamer(RenamerConfig renamerConfig);
+    /// Computes all operations needed to rename the movie. Does not modify the
+    /// file system and can therefore be called for several movies in parallel.
+    mediaelch::RenamePlan::Item planMovie(Movie& movie) const;
 };
@@ -0,0 +1,218 @@
+#include "renamer/RenameJournal.h"
+
+#include "data/Database.h"
+#include "data/DatabaseService.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSet>
+
+namespace mediaelch {
+
+/// Number of items whose operations are journaled and committed at once.
+static constexpr int s_batchSize = 100;
+static const QByteArray s_commitEntry = QByteArrayLiteral("commit");
+/// Marks a directory of a CreateDir operation that did not exist before.
+static const QString s_createdEntry = QStringLiteral("created");
+
+static QByteArray journalEntry(const RenamePlan::Operation& operation)
+{
+    const QJsonArray entry{static_cast<int>(operation.type), operation.source, operation.destination};
+    return QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n';
+}
+
+static bool renamePath(const QString& source, const QString& destination)
+{
+    if (QFileInfo(source).isDir()) {
+        QDir dir(source);
+        return Renamer::rename(dir, destination);
+    }
+    return Renamer::rename(source, destination);
+}
+
+RenameJournal::RenameJournal(QString journalFile, DatabaseService* database) :
+    m_journalFile{std::move(journalFile)}, m_database{database}
+{
+}
+
+int RenameJournal::execute(const RenamePlan& plan, const ItemCallback& itemDone)
+{
+    QFile journal(m_journalFile);
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[RenameJournal] Could not open journal" << m_journalFile << "| Renaming without journal";
+    }
+
+    int failed = 0;
+
+    for (int batchStart = 0; batchStart < plan.items.size(); batchStart += s_batchSize) {
+        const int batchEnd = qMin(batchStart + s_batchSize, plan.items.size());
+
+        if (journal.isOpen()) {
+            QByteArray entries;
+            for (int i = batchStart; i < batchEnd; ++i) {
+                if (plan.items.at(i).conflicts.isEmpty()) {
+                    for (const RenamePlan::Operation& operation : plan.items.at(i).operations) {
+                        entries.append(journalEntry(operation));
+                    }
+                }
+            }
+            journal.write(entries);
+            journal.flush();
+        }
+
+        // Items queue their database updates with DatabaseService::update(). They are committed after
+        // the updates that were queued before, e.g. by saving an item, so those can't restore old paths.
+        for (int i = batchStart; i < batchEnd; ++i) {
+            const RenamePlan::Item& item = plan.items.at(i);
+            const bool success = item.conflicts.isEmpty() && executeItem(item, journal);
+            if (success && item.apply) {
+                item.apply();
+            }
+            if (!success) {
+                ++failed;
+            }
+            if (itemDone) {
+                itemDone(i, success);
+            }
+        }
+
+        // The batch is only committed once the database has the new paths. Otherwise recover() would
+        // revert the files of a batch whose paths were already stored.
+        if (m_database != nullptr) {
+            m_database->flush();
+        }
+        if (journal.isOpen()) {
+            journal.write(s_commitEntry + '\n');
+            journal.flush();
+        }
+        // A batch only takes a fraction of a second. Keep the results table updated.
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+
+    journal.close();
+    journal.remove();
+    return failed;
+}
+
+bool RenameJournal::executeItem(const RenamePlan::Item& item, QFile& journal)
+{
+    QVector<bool> createdDirs;
+    for (int i = 0; i < item.operations.size(); ++i) {
+        bool createdDir = false;
+        if (executeOperation(item.operations.at(i), createdDir)) {
+            createdDirs.push_back(createdDir);
+            if (createdDir && journal.isOpen()) {
+                // recover() must not remove directories that existed before, e.g. merged ones.
+                const QJsonArray entry{s_createdEntry, item.operations.at(i).destination};
+                journal.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n');
+                journal.flush();
+            }
+            continue;
+        }
+
+        qWarning() << "[RenameJournal] Could not rename" << item.operations.at(i).source << "to"
+                   << item.operations.at(i).destination << "| Reverting" << i << "operations of" << item.name;
+        for (int j = i - 1; j >= 0; --j) {
+            if (!revertOperation(item.operations.at(j), createdDirs.at(j))) {
+                qWarning() << "[RenameJournal] Could not revert renaming" << item.operations.at(j).source << "to"
+                           << item.operations.at(j).destination;
+            }
+        }
+        return false;
+    }
+    return true;
+}
+
+bool RenameJournal::executeOperation(const RenamePlan::Operation& operation, bool& createdDir)
+{
+    createdDir = false;
+    if (operation.type == Renamer::RenameOperation::CreateDir) {
+        // Directories may be shared by several items, see RenamePlan::detectConflicts().
+        if (QDir(operation.destination).exists()) {
+            return true;
+        }
+        createdDir = QDir().mkdir(operation.destination);
+        return createdDir;
+    }
+    return renamePath(operation.source, operation.destination);
+}
+
+bool RenameJournal::revertOperation(const RenamePlan::Operation& operation, bool createdDir)
+{
+    if (operation.type == Renamer::RenameOperation::CreateDir) {
+        // Only removes the directory if it is empty.
+        return !createdDir || QDir().rmdir(operation.destination);
+    }
+    return renamePath(operation.destination, operation.source);
+}
+
+int RenameJournal::recover()
+{
+    QFile journal(m_journalFile);
+    if (!journal.exists() || !journal.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+
+    QVector<RenamePlan::Operation> uncommitted;
+    QSet<QString> createdDirs;
+    while (!journal.atEnd()) {
+        const QByteArray line = journal.readLine().trimmed();
+        if (line == s_commitEntry) {
+            uncommitted.clear();
+            createdDirs.clear();
+            continue;
+        }
+        const QJsonArray entry = QJsonDocument::fromJson(line).array();
+        if (entry.size() == 2 && entry.at(0).toString() == s_createdEntry) {
+            createdDirs.insert(entry.at(1).toString());
+            continue;
+        }
+        if (entry.size() != 3) {
+            continue;
+        }
+        RenamePlan::Operation operation;
+        operation.type = static_cast<Renamer::RenameOperation>(entry.at(0).toInt());
+        operation.source = entry.at(1).toString();
+        operation.destination = entry.at(2).toString();
+        uncommitted.push_back(operation);
+    }
+    journal.close();
+
+    int reverted = 0;
+    for (int i = uncommitted.size() - 1; i >= 0; --i) {
+        const RenamePlan::Operation& operation = uncommitted.at(i);
+        if (operation.type == Renamer::RenameOperation::CreateDir) {
+            // Only directories that were created by the rename are removed, and only if they are empty.
+            if (createdDirs.contains(operation.destination) && QDir(operation.destination).exists()
+                && revertOperation(operation, true)) {
+                ++reverted;
+            }
+            continue;
+        }
+        // Operations that were not executed or already reverted are skipped.
+        const bool done = QFileInfo::exists(operation.destination) && !QFileInfo::exists(operation.source);
+        if (done && revertOperation(operation, false)) {
+            ++reverted;
+            // The database may already have the new path of the item.
+            if (m_database != nullptr) {
+                const QString path = operation.destination;
+                const QString originalPath = operation.source;
+                m_database->write([path, originalPath](Database& db) { db.renamePath(path, originalPath); });
+            }
+        }
+    }
+    if (m_database != nullptr) {
+        m_database->flush();
+    }
+
+    qDebug() << "[RenameJournal] Reverted" << reverted << "operations of an interrupted rename";
+    journal.remove();
+    return reverted;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "renamer/RenamePlan.h"
+
+#include <QFile>
+#include <QString>
+#include <functional>
+
+namespace mediaelch {
+
+class DatabaseService;
+
+/// Executes a RenamePlan.
+///
+/// Each item is renamed completely or not at all: If one of its operations
+/// fails, all operations of the item that were already done are reverted in
+/// reverse order. Items are executed in batches. The operations of a batch are
+/// written to a journal file before they are executed and the batch is
+/// committed afterwards, once the database updates that its items queued in the
+/// DatabaseService are committed as well. If MediaElch is terminated while
+/// renaming, recover() reverts the operations of the unfinished batch and the
+/// paths in the database.
+class RenameJournal
+{
+public:
+    /// Called after an item was either renamed or reverted.
+    using ItemCallback = std::function<void(int itemIndex, bool success)>;
+
+    /// If database is null, only files are renamed and reverted.
+    explicit RenameJournal(QString journalFile, DatabaseService* database = nullptr);
+
+    /// Executes all items of the plan that have no conflicts.
+    /// Returns the number of items that were not renamed.
+    int execute(const RenamePlan& plan, const ItemCallback& itemDone);
+
+    /// Reverts the unfinished batch of an interrupted execute().
+    /// Returns the number of reverted operations.
+    int recover();
+
+private:
+    bool executeItem(const RenamePlan::Item& item, QFile& journal);
+    static bool executeOperation(const RenamePlan::Operation& operation, bool& createdDir);
+    static bool revertOperation(const RenamePlan::Operation& operation, bool createdDir);
+
+    QString m_journalFile;
+    DatabaseService* m_database = nullptr;
+};
+
+} // namespace mediaelch
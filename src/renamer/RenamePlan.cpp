@@ -0,0 +1,116 @@
+#include "renamer/RenamePlan.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <algorithm>
+
+namespace mediaelch {
+
+void RenamePlan::Item::createDir(const QString& dir, const QString& displaySource, const QString& displayDestination)
+{
+    add(Renamer::RenameOperation::CreateDir, QString(), dir, displaySource, displayDestination);
+}
+
+void RenamePlan::Item::rename(const QString& source,
+    const QString& destination,
+    const QString& displaySource,
+    const QString& displayDestination)
+{
+    add(Renamer::RenameOperation::Rename, source, destination, displaySource, displayDestination);
+}
+
+void RenamePlan::Item::move(const QString& source,
+    const QString& destination,
+    const QString& displaySource,
+    const QString& displayDestination)
+{
+    add(Renamer::RenameOperation::Move, source, destination, displaySource, displayDestination);
+}
+
+void RenamePlan::Item::add(Renamer::RenameOperation type,
+    const QString& source,
+    const QString& destination,
+    const QString& displaySource,
+    const QString& displayDestination)
+{
+    Operation operation;
+    operation.type = type;
+    operation.source = source;
+    operation.destination = destination;
+    operation.displaySource = displaySource;
+    operation.displayDestination = displayDestination;
+    // Plans are computed on worker threads, so this check does not block the GUI.
+    operation.destinationExists = QFileInfo::exists(destination);
+    operations.push_back(operation);
+}
+
+void RenamePlan::detectConflicts()
+{
+    QSet<QString> sources;
+    for (const Item& item : items) {
+        for (const Operation& operation : item.operations) {
+            if (!operation.source.isEmpty()) {
+                sources.insert(operation.source);
+            }
+        }
+    }
+
+    QHash<QString, int> destinations;
+    QSet<QString> createdDirs;
+    for (int i = 0; i < items.size(); ++i) {
+        Item& item = items[i];
+        for (Operation& operation : item.operations) {
+            if (operation.type == Renamer::RenameOperation::CreateDir) {
+                operation.merged = createdDirs.contains(operation.destination);
+                createdDirs.insert(operation.destination);
+                continue;
+            }
+            // Renamer::rename() handles renames that only change the case.
+            if (QString::compare(operation.source, operation.destination, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+
+            const auto other = destinations.constFind(operation.destination);
+            if (other == destinations.constEnd()) {
+                destinations.insert(operation.destination, i);
+            } else if (other.value() != i) {
+                item.conflicts << QObject::tr("\"%1\" is also the new name of a file of \"%2\"")
+                                      .arg(operation.displayDestination, items.at(other.value()).name);
+            }
+
+            if (operation.destinationExists && !sources.contains(operation.destination)) {
+                item.conflicts << QObject::tr("\"%1\" already exists").arg(operation.displayDestination);
+            }
+        }
+    }
+}
+
+int RenamePlan::operationCount() const
+{
+    int count = 0;
+    for (const Item& item : items) {
+        count += item.operations.size();
+    }
+    return count;
+}
+
+int RenamePlan::conflictCount() const
+{
+    return static_cast<int>(std::count_if(
+        items.cbegin(), items.cend(), [](const Item& item) { return !item.conflicts.isEmpty(); }));
+}
+
+int RenamePlan::mergedDirectoryCount() const
+{
+    int count = 0;
+    for (const Item& item : items) {
+        count += static_cast<int>(std::count_if(item.operations.cbegin(),
+            item.operations.cend(),
+            [](const Operation& operation) { return operation.merged; }));
+    }
+    return count;
+}
+
+} // namespace mediaelch
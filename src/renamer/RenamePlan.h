@@ -0,0 +1,77 @@
+#pragma once
+
+#include "renamer/Renamer.h"
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+namespace mediaelch {
+
+/// All file system operations of a rename, computed in advance.
+///
+/// Renaming is done in two phases: The renamers compute a plan item for each
+/// movie, concert or episode without modifying the file system. This can be
+/// done in parallel and is all that is needed for a dry run. Afterwards
+/// conflicts between items are detected and the plan is executed by
+/// RenameJournal.
+class RenamePlan
+{
+public:
+    struct Operation
+    {
+        Renamer::RenameOperation type = Renamer::RenameOperation::Rename;
+        /// Absolute path of the renamed or moved file or directory. Empty for CreateDir.
+        QString source;
+        /// Absolute path of the new file or directory.
+        QString destination;
+        /// Shown to the user, usually file names without their directory.
+        QString displaySource;
+        QString displayDestination;
+        /// The destination existed while the plan was computed.
+        bool destinationExists = false;
+        /// The directory is created by an earlier item of the plan as well.
+        bool merged = false;
+    };
+
+    struct Item
+    {
+        QString name;
+        QVector<Operation> operations;
+        /// Items with conflicts are not renamed.
+        QStringList conflicts;
+        /// Updates the media object after all operations succeeded, e.g. its files.
+        std::function<void()> apply;
+
+        void createDir(const QString& dir, const QString& displaySource, const QString& displayDestination = {});
+        void rename(const QString& source,
+            const QString& destination,
+            const QString& displaySource,
+            const QString& displayDestination);
+        void move(const QString& source,
+            const QString& destination,
+            const QString& displaySource,
+            const QString& displayDestination);
+
+    private:
+        void add(Renamer::RenameOperation type,
+            const QString& source,
+            const QString& destination,
+            const QString& displaySource,
+            const QString& displayDestination);
+    };
+
+    QVector<Item> items;
+
+    /// Marks items as conflicting whose destinations are used by other items or
+    /// exist and are not renamed themselves. Directories that are created by
+    /// several items are merged, e.g. season directories.
+    void detectConflicts();
+
+    int operationCount() const;
+    int conflictCount() const;
+    int mergedDirectoryCount() const;
+};
+
+} // namespace mediaelch
@@ -1,5 +1,7 @@
 #include "Renamer.h"
 
+#include "data/StreamDetails.h"
+#include "file/DirectoryListingCache.h"
 #include "globals/Helper.h"
 #include "movies/Movie.h"
 #include "settings/Settings.h"
@@ -11,18 +13,32 @@
 
 /**
  * @brief Renamer base class for renaming files according to given patterns.
- *        Note: Currently RenamerDialog is required as a parameter. This may
- *        change in the future.
+ *        Renamers only compute a mediaelch::RenamePlan and are used from
+ *        multiple threads at once.
  * @param renamerConfig Configuration on pattern, etc. used by this renamer
- * @param dialog RenamerDialog that is notified on failure.
  */
-Renamer::Renamer(RenamerConfig renamerConfig, RenamerDialog* dialog) :
+Renamer::Renamer(RenamerConfig renamerConfig) :
     m_config(std::move(renamerConfig)),
-    m_dialog{dialog},
-    m_extraFiles(Settings::instance()->advanced()->subtitleFilters())
+    m_extraFiles(Settings::instance()->advanced()->subtitleFilters()),
+    m_filePattern(m_config.filePattern),
+    m_filePatternMulti(m_config.filePatternMulti),
+    m_directoryPattern(m_config.directoryPattern)
 {
 }
 
+void Renamer::setStreamDetailValues(mediaelch::RenamerValues& values, StreamDetails* streamDetails)
+{
+    const auto videoDetails = streamDetails->videoDetails();
+    values.set("videoCodec", streamDetails->videoCodec());
+    values.set("audioCodec", streamDetails->audioCodec());
+    values.set("channels", QString::number(streamDetails->audioChannels()));
+    values.set("resolution",
+        helper::matchResolution(videoDetails.value(StreamDetails::VideoDetails::Width).toInt(),
+            videoDetails.value(StreamDetails::VideoDetails::Height).toInt(),
+            videoDetails.value(StreamDetails::VideoDetails::ScanType)));
+    values.setCondition("3D", videoDetails.value(StreamDetails::VideoDetails::StereoMode) != "");
+}
+
 QString Renamer::typeToString(Renamer::RenameType type)
 {
     switch (type) {
@@ -79,17 +95,22 @@ bool Renamer::rename(const QString& file, const QString& newName)
         return false;
     }
 
+    bool renamed = false;
     if (newFile.exists()) {
-        if (!f.rename(newName + ".tmp")) {
-            return false;
-        }
-        return f.rename(newName);
+        renamed = f.rename(newName + ".tmp") && f.rename(newName);
+    } else {
+        renamed = f.rename(newName);
     }
-    return f.rename(newName);
+    mediaelch::DirectoryListingCache::instance().invalidateFileDir(file);
+    mediaelch::DirectoryListingCache::instance().invalidateFileDir(newName);
+    return renamed;
 }
 
 bool Renamer::rename(QDir& dir, QString newName)
 {
+    // All cached listings below the old path are outdated.
+    mediaelch::DirectoryListingCache::instance().clear();
+
     if (QString::compare(dir.path(), newName, Qt::CaseInsensitive) == 0) {
         QDir tmpDir;
         if (!tmpDir.rename(dir.path(), dir.path() + "tmp")) {
@@ -1,14 +1,14 @@
 #pragma once
 
 #include "file/FileFilter.h"
+#include "renamer/RenamerTemplate.h"
 
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
-class Movie;
-class RenamerDialog;
 class QDir;
+class StreamDetails;
 
 struct RenamerConfig
 {
@@ -47,7 +47,7 @@ public:
         Error
     };
 
-    Renamer(RenamerConfig config, RenamerDialog* dialog);
+    explicit Renamer(RenamerConfig config);
 
     static QString typeToString(Renamer::RenameType type);
     static QString replace(QString& text, const QString& search, const QString& replace);
@@ -58,7 +58,14 @@ public:
     static bool rename(const QString& file, const QString& newName);
 
 protected:
+    /// Sets the placeholders and conditions that depend on stream details,
+    /// e.g. "<videoCodec>" or "{3D}".
+    static void setStreamDetailValues(mediaelch::RenamerValues& values, StreamDetails* streamDetails);
+
     RenamerConfig m_config;
-    RenamerDialog* m_dialog;
     const mediaelch::FileFilter& m_extraFiles;
+    // Patterns of m_config, parsed once for all items.
+    mediaelch::RenamerTemplate m_filePattern;
+    mediaelch::RenamerTemplate m_filePatternMulti;
+    mediaelch::RenamerTemplate m_directoryPattern;
 };
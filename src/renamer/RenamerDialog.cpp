@@ -6,11 +6,18 @@
 #include "renamer/ConcertRenamer.h"
 #include "renamer/EpisodeRenamer.h"
 #include "renamer/MovieRenamer.h"
+#include "renamer/RenameJournal.h"
+#include "renamer/RenamerTemplate.h"
 
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QSet>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrentMap>
+#include <functional>
 
 RenamerDialog::RenamerDialog(QWidget* parent) : QDialog(parent), ui(new Ui::RenamerDialog)
 {
@@ -90,6 +97,10 @@ int RenamerDialog::exec()
 
     ui->results->clear();
     ui->resultsTable->setRowCount(0);
+    const int reverted = mediaelch::RenameJournal(journalFile(), Manager::instance()->databaseService()).recover();
+    if (reverted > 0) {
+        ui->results->append(tr("Reverted %n file operations of an interrupted rename", "", reverted));
+    }
     ui->btnDryRun->setEnabled(true);
     ui->btnRename->setEnabled(true);
 
@@ -197,36 +208,46 @@ void RenamerDialog::renameType(const bool isDryRun)
     config.filePatternMulti = ui->fileNamingMulti->text();
     config.renameFiles = ui->chkFileNaming->isChecked();
 
+    // Phase one: Compute what has to be renamed. Phase two: Rename it.
+    mediaelch::RenamePlan plan;
     if (m_renameType == Renamer::RenameType::Movies) {
         config.directoryPattern = ui->directoryNaming->text();
         config.renameDirectories = ui->chkDirectoryNaming->isChecked();
-        renameMovies(m_movies, config);
+        planMovies(m_movies, config, plan);
 
     } else if (m_renameType == Renamer::RenameType::Concerts) {
         config.directoryPattern = ui->directoryNaming->text();
         config.renameDirectories = ui->chkDirectoryNaming->isChecked();
-        renameConcerts(m_concerts, config);
+        planConcerts(m_concerts, config, plan);
 
     } else if (m_renameType == Renamer::RenameType::TvShows) {
         config.directoryPattern = ui->seasonNaming->text();
         config.renameDirectories = ui->chkSeasonDirectories->isChecked();
-        renameEpisodes(m_episodes, config);
-        renameShows(m_shows, ui->directoryNaming->text(), ui->chkDirectoryNaming->isChecked(), isDryRun);
+        planEpisodes(m_episodes, config, plan);
+        // Shows are renamed after their episodes, which are updated with the new show directory.
+        planShows(m_shows, ui->directoryNaming->text(), ui->chkDirectoryNaming->isChecked(), plan);
+    }
+
+    plan.detectConflicts();
+    const QVector<QVector<int>> rows = addPlanToTable(plan);
+    if (!isDryRun) {
+        executePlan(plan, rows);
     }
+
     if (isDryRun) {
         m_filesRenamed = true;
     }
     ui->results->append("<span style=\"color:#01a800;\"><b>" + tr("Finished") + "</b></span>");
 }
 
-void RenamerDialog::renameMovies(QVector<Movie*> movies, const RenamerConfig& config)
+void RenamerDialog::planMovies(QVector<Movie*> movies, const RenamerConfig& config, mediaelch::RenamePlan& plan)
 {
     if ((config.renameFiles && config.filePattern.isEmpty())
         || (config.renameDirectories && config.directoryPattern.isEmpty())) {
         return;
     }
 
-    MovieRenamer renamer(config, this);
+    QVector<Movie*> moviesToRename;
     for (Movie* movie : movies) {
         if (movie->files().isEmpty() || (movie->files().count() > 1 && config.filePatternMulti.isEmpty())) {
             continue;
@@ -235,24 +256,31 @@ void RenamerDialog::renameMovies(QVector<Movie*> movies, const RenamerConfig& co
             ui->results->append(QObject::tr("<b>Movie</b> \"%1\" has been edited but is not saved").arg(movie->name()));
             continue;
         }
-
-        QApplication::processEvents();
-
-        Renamer::RenameError err = renamer.renameMovie(*movie);
-        if (err != Renamer::RenameError::None) {
-            m_renameErrorOccured = true;
-        }
+        moviesToRename.push_back(movie);
     }
+
+    // Planning only reads from the media objects and the file system. The GUI thread
+    // is blocked meanwhile, so that the movies can't be modified.
+    const MovieRenamer renamer(config);
+    std::function<mediaelch::RenamePlan::Item(Movie*)> planMovie = [&renamer](Movie* movie) {
+        return renamer.planMovie(*movie);
+    };
+    plan.items += QtConcurrent::blockingMapped<QVector<mediaelch::RenamePlan::Item>>(moviesToRename, planMovie);
 }
 
-void RenamerDialog::renameEpisodes(QVector<TvShowEpisode*> episodes, const RenamerConfig& config)
+void RenamerDialog::planEpisodes(QVector<TvShowEpisode*> episodes,
+    const RenamerConfig& config,
+    mediaelch::RenamePlan& plan)
 {
     if (config.renameFiles && config.filePattern.isEmpty()) {
         return;
     }
 
-    EpisodeRenamer renamer(config, this);
-    QVector<TvShowEpisode*> episodesRenamed;
+    // Episodes that are stored in the same files (multi-episode files) are renamed together.
+    using EpisodeGroup = QPair<TvShowEpisode*, QVector<TvShowEpisode*>>;
+    QHash<TvShow*, QHash<QString, QVector<TvShowEpisode*>>> episodesByFiles;
+    QSet<TvShowEpisode*> episodesRenamed;
+    QVector<EpisodeGroup> episodesToRename;
 
     for (TvShowEpisode* episode : episodes) {
         if (episode->files().isEmpty() || (episode->files().count() > 1 && config.filePatternMulti.isEmpty())
@@ -264,24 +292,39 @@ void RenamerDialog::renameEpisodes(QVector<TvShowEpisode*> episodes, const Renam
             continue;
         }
 
-        QApplication::processEvents();
-
-        Renamer::RenameError err = renamer.renameEpisode(*episode, episodesRenamed);
-        if (err != Renamer::RenameError::None) {
-            m_renameErrorOccured = true;
+        TvShow* show = episode->tvShow();
+        if (!episodesByFiles.contains(show)) {
+            QHash<QString, QVector<TvShowEpisode*>>& showEpisodes = episodesByFiles[show];
+            for (TvShowEpisode* subEpisode : show->episodes()) {
+                showEpisodes[subEpisode->files().toStringList().join('\n')].push_back(subEpisode);
+            }
+        }
+        const QVector<TvShowEpisode*> multiEpisodes =
+            episodesByFiles[show].value(episode->files().toStringList().join('\n'));
+        for (TvShowEpisode* subEpisode : multiEpisodes) {
+            episodesRenamed.insert(subEpisode);
         }
+        episodesToRename.push_back(qMakePair(episode, multiEpisodes));
     }
+
+    const EpisodeRenamer renamer(config);
+    std::function<mediaelch::RenamePlan::Item(const EpisodeGroup&)> planEpisode = [&renamer](
+                                                                                    const EpisodeGroup& group) {
+        return renamer.planEpisode(*group.first, group.second);
+    };
+    plan.items += QtConcurrent::blockingMapped<QVector<mediaelch::RenamePlan::Item>>(episodesToRename, planEpisode);
 }
 
-void RenamerDialog::renameShows(QVector<TvShow*> shows,
+void RenamerDialog::planShows(QVector<TvShow*> shows,
     const QString& directoryPattern,
-    const bool& renameDirectories,
-    const bool& dryRun)
+    bool renameDirectories,
+    mediaelch::RenamePlan& plan)
 {
     if ((renameDirectories && directoryPattern.isEmpty()) || !renameDirectories) {
         return;
     }
 
+    const mediaelch::RenamerTemplate pattern(directoryPattern);
     for (TvShow* show : shows) {
         if (show->hasChanged()) {
             ui->results->append(tr("<b>TV Show</b> \"%1\" has been edited but is not saved").arg(show->title()));
@@ -289,48 +332,48 @@ void RenamerDialog::renameShows(QVector<TvShow*> shows,
         }
 
         QDir dir(show->dir().toString());
-        QString newFolderName = directoryPattern;
-        Renamer::replace(newFolderName, "title", show->title());
-        Renamer::replace(newFolderName, "showTitle", show->title());
-        Renamer::replace(newFolderName, "year", show->firstAired().toString("yyyy"));
+        mediaelch::RenamerValues values;
+        values.set("title", show->title());
+        values.set("showTitle", show->title());
+        values.set("year", show->firstAired().toString("yyyy"));
+        QString newFolderName = pattern.render(values);
         helper::sanitizeFileName(newFolderName);
-        if (newFolderName != dir.dirName()) {
-            const int row = addResultToTable(dir.dirName(), newFolderName, Renamer::RenameOperation::Rename);
-            QDir parentDir(dir.path());
-            parentDir.cdUp();
-            if (dryRun) {
-                continue;
-            }
-            if (!Renamer::rename(dir, parentDir.absolutePath() + "/" + newFolderName)) {
-                setResultStatus(row, Renamer::RenameResult::Failed);
-                m_renameErrorOccured = true;
-                continue;
-            }
-            const QString newShowDir = parentDir.absolutePath() + "/" + newFolderName;
+        if (newFolderName == dir.dirName()) {
+            continue;
+        }
+
+        QDir parentDir(dir.path());
+        parentDir.cdUp();
+        const QString newShowDir = parentDir.absolutePath() + "/" + newFolderName;
+
+        mediaelch::RenamePlan::Item item;
+        item.name = show->title();
+        item.rename(dir.path(), newShowDir, dir.dirName(), newFolderName);
+        item.apply = [show, newShowDir]() {
             const QString oldShowDir = show->dir().toString();
             show->setDir(newShowDir);
-            Manager::instance()->database()->update(show);
+            Manager::instance()->databaseService()->update(show);
             for (TvShowEpisode* episode : show->episodes()) {
                 QStringList files;
                 for (const mediaelch::FilePath& file : episode->files()) {
                     files << newShowDir + file.toString().mid(oldShowDir.length());
                 }
                 episode->setFiles(files);
-                Manager::instance()->database()->update(episode);
+                Manager::instance()->databaseService()->update(episode);
             }
-        }
+        };
+        plan.items.push_back(item);
     }
 }
 
-void RenamerDialog::renameConcerts(QVector<Concert*> concerts, const RenamerConfig& config)
+void RenamerDialog::planConcerts(QVector<Concert*> concerts, const RenamerConfig& config, mediaelch::RenamePlan& plan)
 {
     if ((config.renameFiles && config.filePattern.isEmpty())
         || (config.renameDirectories && config.directoryPattern.isEmpty())) {
         return;
     }
 
-    ConcertRenamer renamer(config, this);
-
+    QVector<Concert*> concertsToRename;
     for (Concert* concert : concerts) {
         if (concert->files().isEmpty() || (concert->files().count() > 1 && config.filePatternMulti.isEmpty())) {
             continue;
@@ -339,14 +382,69 @@ void RenamerDialog::renameConcerts(QVector<Concert*> concerts, const RenamerConf
             ui->results->append(tr("<b>Concert</b> \"%1\" has been edited but is not saved").arg(concert->name()));
             continue;
         }
+        concertsToRename.push_back(concert);
+    }
 
-        QApplication::processEvents();
+    const ConcertRenamer renamer(config);
+    std::function<mediaelch::RenamePlan::Item(Concert*)> planConcert = [&renamer](Concert* concert) {
+        return renamer.planConcert(*concert);
+    };
+    plan.items += QtConcurrent::blockingMapped<QVector<mediaelch::RenamePlan::Item>>(concertsToRename, planConcert);
+}
 
-        Renamer::RenameError err = renamer.renameConcert(*concert);
-        if (err != Renamer::RenameError::None) {
-            m_renameErrorOccured = true;
+QVector<QVector<int>> RenamerDialog::addPlanToTable(const mediaelch::RenamePlan& plan)
+{
+    QVector<QVector<int>> rows;
+    rows.reserve(plan.items.size());
+
+    ui->resultsTable->setUpdatesEnabled(false);
+    for (const mediaelch::RenamePlan::Item& item : plan.items) {
+        QVector<int> itemRows;
+        for (const mediaelch::RenamePlan::Operation& operation : item.operations) {
+            if (!operation.merged) {
+                itemRows << addResultToTable(operation.displaySource, operation.displayDestination, operation.type);
+            }
         }
+        if (!item.conflicts.isEmpty()) {
+            for (int row : itemRows) {
+                setResultStatus(row, Renamer::RenameResult::Failed);
+            }
+            for (const QString& conflict : item.conflicts) {
+                ui->results->append(tr("<b>Conflict</b> \"%1\": %2").arg(item.name, conflict));
+            }
+        }
+        rows.push_back(itemRows);
+    }
+    ui->resultsTable->setUpdatesEnabled(true);
+
+    ui->results->append(tr("%n file operations", "", plan.operationCount()));
+    if (plan.mergedDirectoryCount() > 0) {
+        ui->results->append(tr("%n directories are shared by several items", "", plan.mergedDirectoryCount()));
+    }
+    if (plan.conflictCount() > 0) {
+        ui->results->append(tr("%n items have conflicts and will not be renamed", "", plan.conflictCount()));
     }
+    return rows;
+}
+
+void RenamerDialog::executePlan(const mediaelch::RenamePlan& plan, const QVector<QVector<int>>& rows)
+{
+    mediaelch::RenameJournal journal(journalFile(), Manager::instance()->databaseService());
+    const int failed = journal.execute(plan, [this, &rows](int itemIndex, bool success) {
+        if (!success) {
+            for (int row : rows.at(itemIndex)) {
+                setResultStatus(row, Renamer::RenameResult::Failed);
+            }
+        }
+    });
+    if (failed > 0) {
+        m_renameErrorOccured = true;
+    }
+}
+
+QString RenamerDialog::journalFile()
+{
+    return Settings::instance()->databaseDir().filePath("renamer.journal");
 }
 
 int RenamerDialog::addResultToTable(const QString& oldFileName,
@@ -2,6 +2,7 @@
 
 #include "concerts/Concert.h"
 #include "movies/Movie.h"
+#include "renamer/RenamePlan.h"
 #include "renamer/Renamer.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
@@ -61,11 +62,15 @@ private:
     bool m_renameErrorOccured = 0;
 
     void renameType(const bool isDryRun);
-    void renameMovies(QVector<Movie*> movies, const RenamerConfig& config);
-    void renameConcerts(QVector<Concert*> concerts, const RenamerConfig& config);
-    void renameEpisodes(QVector<TvShowEpisode*> episodes, const RenamerConfig& config);
-    void renameShows(QVector<TvShow*> shows,
+    void planMovies(QVector<Movie*> movies, const RenamerConfig& config, mediaelch::RenamePlan& plan);
+    void planConcerts(QVector<Concert*> concerts, const RenamerConfig& config, mediaelch::RenamePlan& plan);
+    void planEpisodes(QVector<TvShowEpisode*> episodes, const RenamerConfig& config, mediaelch::RenamePlan& plan);
+    void planShows(QVector<TvShow*> shows,
         const QString& directoryPattern,
-        const bool& renameDirectories,
-        const bool& dryRun = false);
+        bool renameDirectories,
+        mediaelch::RenamePlan& plan);
+    /// Returns the table rows of each plan item.
+    QVector<QVector<int>> addPlanToTable(const mediaelch::RenamePlan& plan);
+    void executePlan(const mediaelch::RenamePlan& plan, const QVector<QVector<int>>& rows);
+    static QString journalFile();
 };
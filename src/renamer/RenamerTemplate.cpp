@@ -0,0 +1,143 @@
+#include "renamer/RenamerTemplate.h"
+
+namespace mediaelch {
+
+void RenamerValues::set(const QString& name, const QString& value)
+{
+    m_values.insert(name, value);
+}
+
+void RenamerValues::setCondition(const QString& name, bool condition)
+{
+    m_conditions.insert(name, condition);
+}
+
+void RenamerValues::setValueCondition(const QString& name, const QString& value)
+{
+    m_values.insert(name, value);
+    m_conditions.insert(name, !value.isEmpty());
+}
+
+/// Placeholder and condition names only consist of letters and digits, e.g. "3D" or "imdbId".
+static bool isName(const QStringRef& name)
+{
+    if (name.isEmpty()) {
+        return false;
+    }
+    for (const QChar c : name) {
+        if (!c.isLetterOrNumber()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RenamerTemplate::RenamerTemplate(const QString& pattern)
+{
+    parse(pattern);
+}
+
+void RenamerTemplate::parse(const QString& pattern)
+{
+    int pos = 0;
+    int literalStart = 0;
+    while (pos < pattern.length()) {
+        const QChar c = pattern.at(pos);
+        if (c != '<' && c != '{') {
+            ++pos;
+            continue;
+        }
+
+        const QChar closing = (c == '<') ? QChar('>') : QChar('}');
+        const int end = pattern.indexOf(closing, pos + 1);
+        if (end == -1) {
+            break;
+        }
+        const QStringRef name = pattern.midRef(pos + 1, end - pos - 1);
+        if (!isName(name)) {
+            ++pos;
+            continue;
+        }
+
+        if (c == '<') {
+            appendLiteral(pattern.mid(literalStart, pos - literalStart));
+            Segment segment;
+            segment.type = Segment::Type::Placeholder;
+            segment.text = name.toString();
+            m_segments.push_back(segment);
+            pos = end + 1;
+            literalStart = pos;
+            continue;
+        }
+
+        // Like Renamer::replaceCondition(), the condition ends at the first closing tag.
+        const QString closeTag = QStringLiteral("{/%1}").arg(name.toString());
+        const int closeTagPos = pattern.indexOf(closeTag, end + 1);
+        if (closeTagPos == -1) {
+            ++pos;
+            continue;
+        }
+        appendLiteral(pattern.mid(literalStart, pos - literalStart));
+        Segment segment;
+        segment.type = Segment::Type::Condition;
+        segment.text = name.toString();
+        segment.content = std::make_shared<RenamerTemplate>(pattern.mid(end + 1, closeTagPos - end - 1));
+        m_segments.push_back(segment);
+        pos = closeTagPos + closeTag.length();
+        literalStart = pos;
+    }
+    appendLiteral(pattern.mid(literalStart));
+}
+
+void RenamerTemplate::appendLiteral(const QString& text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    if (!m_segments.isEmpty() && m_segments.last().type == Segment::Type::Literal) {
+        m_segments.last().text.append(text);
+        return;
+    }
+    Segment segment;
+    segment.type = Segment::Type::Literal;
+    segment.text = text;
+    m_segments.push_back(segment);
+}
+
+QString RenamerTemplate::render(const RenamerValues& values) const
+{
+    QString out;
+    renderTo(out, values);
+    return out;
+}
+
+void RenamerTemplate::renderTo(QString& out, const RenamerValues& values) const
+{
+    for (const Segment& segment : m_segments) {
+        switch (segment.type) {
+        case Segment::Type::Literal: out.append(segment.text); break;
+        case Segment::Type::Placeholder: {
+            const auto value = values.m_values.constFind(segment.text);
+            if (value != values.m_values.constEnd()) {
+                out.append(value.value());
+            } else {
+                out.append('<').append(segment.text).append('>');
+            }
+            break;
+        }
+        case Segment::Type::Condition: {
+            const auto condition = values.m_conditions.constFind(segment.text);
+            if (condition == values.m_conditions.constEnd()) {
+                out.append('{').append(segment.text).append('}');
+                segment.content->renderTo(out, values);
+                out.append(QStringLiteral("{/")).append(segment.text).append('}');
+            } else if (condition.value()) {
+                segment.content->renderTo(out, values);
+            }
+            break;
+        }
+        }
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+namespace mediaelch {
+
+/// Values of the placeholders and conditions of a RenamerTemplate.
+class RenamerValues
+{
+public:
+    /// Value of the placeholder "<name>".
+    void set(const QString& name, const QString& value);
+    /// The content of "{name}...{/name}" is only kept if the condition is true.
+    void setCondition(const QString& name, bool condition);
+    /// Sets the placeholder "<name>" and a condition "{name}...{/name}" that is true
+    /// if the value is not empty. Same as Renamer::replaceCondition(text, name, value).
+    void setValueCondition(const QString& name, const QString& value);
+
+private:
+    friend class RenamerTemplate;
+
+    QHash<QString, QString> m_values;
+    QHash<QString, bool> m_conditions;
+};
+
+/// Renamer pattern such as "<title> (<year>){3D} 3D{/3D}.<extension>" that is
+/// parsed once into literal, placeholder and condition segments. The result of
+/// render() is the same as calling Renamer::replace() and Renamer::replaceCondition()
+/// for all values, but the pattern is not searched again for each placeholder and
+/// each renamed file.
+///
+/// Placeholders and conditions without a value are kept as they are. Rendering
+/// is const and can therefore be done from multiple threads at once.
+class RenamerTemplate
+{
+public:
+    RenamerTemplate() = default;
+    explicit RenamerTemplate(const QString& pattern);
+
+    bool isEmpty() const { return m_segments.isEmpty(); }
+
+    QString render(const RenamerValues& values) const;
+
+private:
+    struct Segment
+    {
+        enum class Type
+        {
+            Literal,
+            Placeholder,
+            Condition
+        };
+
+        Type type = Type::Literal;
+        /// Literal text, placeholder name or condition name.
+        QString text;
+        /// Content of a condition.
+        std::shared_ptr<RenamerTemplate> content;
+    };
+
+    void parse(const QString& pattern);
+    void appendLiteral(const QString& text);
+    void renderTo(QString& out, const RenamerValues& values) const;
+
+private:
+    QVector<Segment> m_segments;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <utility>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief Runs \p parse on the global thread pool and passes its result to \p done
+/// on the thread of \p context.
+///
+/// Used to extract data from large responses without blocking the GUI thread.
+/// \p parse must not access \p context or any other object that is used on another
+/// thread; pass it the response and return plain values.  \p done is not called if
+/// \p context is destroyed before parsing has finished.
+template<typename Parse, typename Done>
+void parseInBackground(QObject* context, Parse parse, Done done)
+{
+    using Result = decltype(parse());
+    auto* watcher = new QFutureWatcher<Result>(context);
+    QObject::connect(watcher, &QFutureWatcher<Result>::finished, context, [watcher, done]() {
+        watcher->deleteLater();
+        done(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run(std::move(parse)));
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,66 @@
+#include "scrapers/HtmlPattern.h"
+
+#include <QDebug>
+
+namespace mediaelch {
+namespace scraper {
+
+HtmlPattern::HtmlPattern(const QString& pattern, Matching matching)
+{
+    QRegularExpression::PatternOptions options = QRegularExpression::DotMatchesEverythingOption;
+    if (matching == Matching::Minimal) {
+        options |= QRegularExpression::InvertedGreedinessOption;
+    }
+    m_regex.setPattern(pattern);
+    m_regex.setPatternOptions(options);
+    if (!m_regex.isValid()) {
+        qCritical() << "[HtmlPattern] Invalid pattern:" << pattern << "|" << m_regex.errorString();
+    }
+    // Compile the pattern now instead of on its first use.
+    m_regex.optimize();
+}
+
+bool HtmlPattern::find(const QString& html, QRegularExpressionMatch& match, int offset) const
+{
+    match = m_regex.match(html, offset);
+    return match.hasMatch();
+}
+
+QRegularExpressionMatch HtmlPattern::match(const QString& html, int offset) const
+{
+    return m_regex.match(html, offset);
+}
+
+QRegularExpressionMatchIterator HtmlPattern::globalMatch(const QString& html) const
+{
+    return m_regex.globalMatch(html);
+}
+
+QString HtmlPattern::capture(const QString& html, int nth) const
+{
+    return m_regex.match(html).captured(nth);
+}
+
+QStringList HtmlPattern::captureAll(const QString& html, int nth) const
+{
+    QStringList captures;
+    QRegularExpressionMatchIterator it = m_regex.globalMatch(html);
+    while (it.hasNext()) {
+        captures << it.next().captured(nth);
+    }
+    return captures;
+}
+
+QString HtmlPattern::replaced(QString html, const QString& replacement) const
+{
+    return html.replace(m_regex, replacement);
+}
+
+QString removeHtmlTags(QString html)
+{
+    static const HtmlPattern tags("<[^>]*>", HtmlPattern::Matching::Greedy);
+    return tags.replaced(std::move(html));
+}
+
+} // namespace scraper
+} // namespace mediaelch
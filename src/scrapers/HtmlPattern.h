@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief A precompiled regular expression for extracting data from HTML pages.
+///
+/// The HTML based scrapers search whole pages, often hundreds of KB, with many patterns.
+/// Declare patterns as function-local statics so that they are only compiled (and JIT
+/// compiled where supported) once instead of on every call.  A pattern can be used from
+/// multiple threads at once.
+///
+/// Patterns behave like QRegExp's did: "." matches newlines as well and with
+/// Matching::Minimal all quantifiers are lazy, like after QRegExp::setMinimal(true).
+class HtmlPattern
+{
+public:
+    enum class Matching
+    {
+        Greedy,
+        Minimal
+    };
+
+    explicit HtmlPattern(const QString& pattern, Matching matching = Matching::Minimal);
+
+    /// \brief Searches for the first match after \p offset.
+    /// \returns True if the pattern matched, in which case \p match is set.
+    bool find(const QString& html, QRegularExpressionMatch& match, int offset = 0) const;
+    QRegularExpressionMatch match(const QString& html, int offset = 0) const;
+    QRegularExpressionMatchIterator globalMatch(const QString& html) const;
+
+    /// \brief Returns the \p nth capture of the first match or an empty string if there is none.
+    QString capture(const QString& html, int nth = 1) const;
+    /// \brief Returns the \p nth capture of all matches.
+    QStringList captureAll(const QString& html, int nth = 1) const;
+
+    /// \brief Returns \p html with \p replacement for every match.
+    QString replaced(QString html, const QString& replacement = QString()) const;
+
+    bool isValid() const { return m_regex.isValid(); }
+    const QRegularExpression& regex() const { return m_regex; }
+
+private:
+    QRegularExpression m_regex;
+};
+
+/// \brief Removes all HTML tags, e.g. "<b>Title</b>" becomes "Title".
+QString removeHtmlTags(QString html);
+
+} // namespace scraper
+} // namespace mediaelch
@@ -7,12 +7,15 @@
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QLabel>
+#include <QPointer>
 
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
 #include "ui/main/MainWindow.h"
 
 TMDbConcerts::TMDbConcerts(QObject* parent) :
@@ -141,7 +144,7 @@ void TMDbConcerts::saveSettings(ScraperSettings& settings)
  */
 QNetworkAccessManager* TMDbConcerts::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 /**
@@ -419,7 +422,7 @@ void TMDbConcerts::loadData(TmdbId id, Concert* concert, QSet<ConcertScraperInfo
 
 /**
  * @brief Called when the concert infos are downloaded
- * @see TMDbConcerts::parseAndAssignInfos
+ * @see TMDbConcerts::assignInfos
  */
 void TMDbConcerts::loadFinished()
 {
@@ -431,18 +434,17 @@ void TMDbConcerts::loadFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, concert, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "Network Error (load)" << reply->errorString();
+        concert->controller()->removeFromLoadsLeft(ScraperData::Infos);
+        return;
     }
-    concert->controller()->removeFromLoadsLeft(ScraperData::Infos);
+    parseAndAssignInfos(reply->readAll(), concert, infos, ScraperData::Infos);
 }
 
 /**
  * @brief Called when the concert trailers are downloaded
- * @see TMDbConcerts::parseAndAssignInfos
+ * @see TMDbConcerts::assignInfos
  */
 void TMDbConcerts::loadTrailersFinished()
 {
@@ -454,18 +456,17 @@ void TMDbConcerts::loadTrailersFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, concert, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         qDebug() << "Network Error (trailers)" << reply->errorString();
+        concert->controller()->removeFromLoadsLeft(ScraperData::Trailers);
+        return;
     }
-    concert->controller()->removeFromLoadsLeft(ScraperData::Trailers);
+    parseAndAssignInfos(reply->readAll(), concert, infos, ScraperData::Trailers);
 }
 
 /**
  * @brief Called when the concert images are downloaded
- * @see TMDbConcerts::parseAndAssignInfos
+ * @see TMDbConcerts::assignInfos
  */
 void TMDbConcerts::loadImagesFinished()
 {
@@ -477,18 +478,17 @@ void TMDbConcerts::loadImagesFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, concert, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "Network Error (images)" << reply->errorString();
+        concert->controller()->removeFromLoadsLeft(ScraperData::Images);
+        return;
     }
-    concert->controller()->removeFromLoadsLeft(ScraperData::Images);
+    parseAndAssignInfos(reply->readAll(), concert, infos, ScraperData::Images);
 }
 
 /**
  * @brief Called when the concert releases are downloaded
- * @see TMDbConcerts::parseAndAssignInfos
+ * @see TMDbConcerts::assignInfos
  */
 void TMDbConcerts::loadReleasesFinished()
 {
@@ -500,30 +500,57 @@ void TMDbConcerts::loadReleasesFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, concert, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "Network Error (releases)" << reply->errorString();
+        concert->controller()->removeFromLoadsLeft(ScraperData::Releases);
+        return;
     }
-    concert->controller()->removeFromLoadsLeft(ScraperData::Releases);
+    parseAndAssignInfos(reply->readAll(), concert, infos, ScraperData::Releases);
 }
 
 /**
- * @brief Parses JSON data and assigns it to the given concert object
- *        Handles all types of data from TMDb (info, releases, trailers, images)
+ * @brief Parses JSON data on a worker thread, assigns it to the given concert object and
+ *        removes \p type from the concert's loads left.
  * @param json JSON data
  * @param concert Concert object
  * @param infos List of infos to load
+ * @param type Type of the data (info, releases, trailers, images)
  */
-void TMDbConcerts::parseAndAssignInfos(QString json, Concert* concert, QSet<ConcertScraperInfos> infos)
+void TMDbConcerts::parseAndAssignInfos(const QByteArray& json,
+    Concert* concert,
+    QSet<ConcertScraperInfos> infos,
+    ScraperData type)
+{
+    const QPointer<Concert> concertPtr(concert);
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json]() {
+            QJsonParseError parseError{};
+            const QJsonObject parsedJson = QJsonDocument::fromJson(json, &parseError).object();
+            if (parseError.error != QJsonParseError::NoError) {
+                qWarning() << "Error parsing concert info json " << parseError.errorString();
+                return QJsonObject();
+            }
+            return parsedJson;
+        },
+        [this, concertPtr, infos, type](const QJsonObject& parsedJson) {
+            if (concertPtr.isNull()) {
+                return;
+            }
+            assignInfos(parsedJson, concertPtr.data(), infos);
+            concertPtr->controller()->removeFromLoadsLeft(type);
+        });
+}
+
+/**
+ * @brief Assigns JSON data to the given concert object
+ *        Handles all types of data from TMDb (info, releases, trailers, images)
+ * @param parsedJson JSON data
+ * @param concert Concert object
+ * @param infos List of infos to load
+ */
+void TMDbConcerts::assignInfos(const QJsonObject& parsedJson, Concert* concert, QSet<ConcertScraperInfos> infos)
 {
-    QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Error parsing concert info json " << parseError.errorString();
-        return;
-    }
 
     // Infos
     if (!parsedJson.value("imdb_id").toString().isEmpty()) {
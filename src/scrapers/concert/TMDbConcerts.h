@@ -4,6 +4,7 @@
 #include "settings/ScraperSettings.h"
 
 #include <QComboBox>
+#include <QJsonObject>
 #include <QLocale>
 #include <QObject>
 #include <QWidget>
@@ -38,7 +39,6 @@ private slots:
 
 private:
     QString m_apiKey;
-    QNetworkAccessManager m_qnam;
     QLocale m_locale;
     QString m_language2;
     QString m_baseUrl;
@@ -52,5 +52,9 @@ private:
     QString country() const;
     QNetworkAccessManager* qnam();
     QVector<ScraperSearchResult> parseSearch(QString json, int& nextPage);
-    void parseAndAssignInfos(QString json, Concert* concert, QSet<ConcertScraperInfos> infos);
+    void parseAndAssignInfos(const QByteArray& json,
+        Concert* concert,
+        QSet<ConcertScraperInfos> infos,
+        ScraperData type);
+    void assignInfos(const QJsonObject& parsedJson, Concert* concert, QSet<ConcertScraperInfos> infos);
 };
@@ -7,9 +7,13 @@
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QLabel>
+#include <QPointer>
 
 #include "data/Storage.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
+#include "network/ScrapeStats.h"
+#include "scrapers/BackgroundParser.h"
 #include "scrapers/movie/TMDb.h"
 #include "scrapers/tv_show/TheTvDb.h"
 #include "ui/main/MainWindow.h"
@@ -126,7 +130,7 @@ QVector<ImageType> FanartTv::provides()
  */
 QNetworkAccessManager* FanartTv::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 /**
@@ -283,10 +287,12 @@ void FanartTv::loadMovieData(TmdbId tmdbId, ImageType type)
 {
     QUrl url = QStringLiteral("https://webservice.fanart.tv/v3/movies/%1?%2").arg(tmdbId.toString(), keyParameter());
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    mediaelch::network::setRequestTag(request, {"FanartTv", QString(), "images"});
 
     qDebug() << "[FanartTv] Load movie data:" << url;
 
     QNetworkReply* reply = qnam()->get(request);
+    mediaelch::network::ScrapeStats::instance().watch(reply);
     reply->setProperty("infoToLoad", static_cast<int>(type));
     connect(reply, &QNetworkReply::finished, this, &FanartTv::onLoadMovieDataFinished);
 }
@@ -295,10 +301,12 @@ void FanartTv::loadMovieData(TmdbId tmdbId, QVector<ImageType> types, Movie* mov
 {
     QUrl url = QStringLiteral("https://webservice.fanart.tv/v3/movies/%1?%2").arg(tmdbId.toString(), keyParameter());
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    mediaelch::network::setRequestTag(request, {"FanartTv", movie->name(), "images"});
 
     qDebug() << "[FanartTv] Load movie data with image types:" << url;
 
     QNetworkReply* reply = qnam()->get(request);
+    mediaelch::network::ScrapeStats::instance().watch(reply);
     reply->setProperty("storage", Storage::toVariant(reply, movie));
     reply->setProperty("infosToLoad", Storage::toVariant(reply, types));
     connect(reply, &QNetworkReply::finished, this, &FanartTv::onLoadAllMovieDataFinished);
@@ -308,10 +316,12 @@ void FanartTv::loadConcertData(TmdbId tmdbId, QVector<ImageType> types, Concert*
 {
     QUrl url = QStringLiteral("https://webservice.fanart.tv/v3/movies/%1?%2").arg(tmdbId.toString(), keyParameter());
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    mediaelch::network::setRequestTag(request, {"FanartTv", concert->name(), "images"});
 
     qDebug() << "[FanartTv] Load concert data with image types:" << url;
 
     QNetworkReply* reply = qnam()->get(request);
+    mediaelch::network::ScrapeStats::instance().watch(reply);
     reply->setProperty("infosToLoad", Storage::toVariant(reply, types));
     reply->setProperty("storage", Storage::toVariant(reply, concert));
     connect(reply, &QNetworkReply::finished, this, &FanartTv::onLoadAllConcertDataFinished);
@@ -333,9 +343,16 @@ void FanartTv::onLoadMovieDataFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
-    QVector<Poster> posters = parseMovieData(msg, ImageType(reply->property("infoToLoad").toInt()));
-    emit sigImagesLoaded(posters, {});
+    const QByteArray json = reply->readAll();
+    const auto type = ImageType(reply->property("infoToLoad").toInt());
+    const QString language = m_language;
+    const QString discType = m_preferredDiscType;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json, type, language, discType]() {
+            return parseMovieData(parseJson(json, "movie"), type, language, discType);
+        },
+        [this](QVector<Poster> posters) { emit sigImagesLoaded(posters, {}); });
 }
 
 /**
@@ -345,20 +362,28 @@ void FanartTv::onLoadMovieDataFinished()
 void FanartTv::onLoadAllMovieDataFinished()
 {
     auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    Movie* movie = reply->property("storage").value<Storage*>()->movie();
+    const QPointer<Movie> movie = reply->property("storage").value<Storage*>()->movie();
     reply->deleteLater();
 
     if (reply->error() != QNetworkReply::NoError) {
         emit sigMovieImagesLoaded(movie, {});
     }
 
-    QMap<ImageType, QVector<Poster>> posters;
-    QString msg = QString::fromUtf8(reply->readAll());
-    for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
-        posters.insert(type, parseMovieData(msg, type));
-    }
-
-    emit sigMovieImagesLoaded(movie, posters);
+    const QByteArray json = reply->readAll();
+    const QVector<ImageType> types = reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad();
+    const QString language = m_language;
+    const QString discType = m_preferredDiscType;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json, types, language, discType]() {
+            const QJsonObject parsedJson = parseJson(json, "movie");
+            QMap<ImageType, QVector<Poster>> posters;
+            for (const auto type : types) {
+                posters.insert(type, parseMovieData(parsedJson, type, language, discType));
+            }
+            return posters;
+        },
+        [this, movie](QMap<ImageType, QVector<Poster>> posters) { emit sigMovieImagesLoaded(movie, posters); });
 }
 
 /**
@@ -368,29 +393,59 @@ void FanartTv::onLoadAllMovieDataFinished()
 void FanartTv::onLoadAllConcertDataFinished()
 {
     auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    Concert* concert = reply->property("storage").value<Storage*>()->concert();
+    const QPointer<Concert> concert = reply->property("storage").value<Storage*>()->concert();
     reply->deleteLater();
 
     if (reply->error() != QNetworkReply::NoError) {
         emit sigConcertImagesLoaded(concert, {});
     }
 
-    QMap<ImageType, QVector<Poster>> posters;
-    QString msg = QString::fromUtf8(reply->readAll());
-    for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
-        posters.insert(type, parseMovieData(msg, type));
-    }
-
-    emit sigConcertImagesLoaded(concert, posters);
+    const QByteArray json = reply->readAll();
+    const QVector<ImageType> types = reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad();
+    const QString language = m_language;
+    const QString discType = m_preferredDiscType;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json, types, language, discType]() {
+            const QJsonObject parsedJson = parseJson(json, "movie");
+            QMap<ImageType, QVector<Poster>> posters;
+            for (const auto type : types) {
+                posters.insert(type, parseMovieData(parsedJson, type, language, discType));
+            }
+            return posters;
+        },
+        [this, concert](QMap<ImageType, QVector<Poster>> posters) { emit sigConcertImagesLoaded(concert, posters); });
 }
 
 /**
- * @brief Parses JSON data for movies
+ * @brief Parses a response of Fanart.tv. Thread-safe.
  * @param json JSON data
+ * @param kind Kind of response for error messages, e.g. "movie"
+ * @return The object containing all URLs to fanart images. Empty on errors.
+ */
+QJsonObject FanartTv::parseJson(const QByteArray& json, const char* kind)
+{
+    QJsonParseError parseError{};
+    // The JSON contains one object with all URLs to fanart images
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
+
+    if (parseError.error != QJsonParseError::NoError) {
+        qWarning() << "Error parsing fanart" << kind << "json " << parseError.errorString();
+        return {};
+    }
+    return parsedJson;
+}
+
+/**
+ * @brief Parses JSON data for movies. Thread-safe.
+ * @param parsedJson JSON data, see parseJson()
  * @param type Type of image (ImageType)
  * @return List of posters
  */
-QVector<Poster> FanartTv::parseMovieData(QString json, ImageType type)
+QVector<Poster> FanartTv::parseMovieData(const QJsonObject& parsedJson,
+    ImageType type,
+    const QString& language,
+    const QString& preferredDiscType)
 {
     QMap<ImageType, QStringList> map;
     // clang-format off
@@ -409,15 +464,6 @@ QVector<Poster> FanartTv::parseMovieData(QString json, ImageType type)
 
     QVector<Poster> posters;
 
-    QJsonParseError parseError{};
-    // The JSON contains one object with all URLs to fanart images
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
-
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Error parsing fanart movie json " << parseError.errorString();
-        return posters;
-    }
-
     for (const auto& section : map.value(type)) {
         const auto jsonPosters = parsedJson.value(section).toArray();
 
@@ -448,7 +494,7 @@ QVector<Poster> FanartTv::parseMovieData(QString json, ImageType type)
             }();
 
             b.language = poster.value("lang").toString();
-            insertPoster(posters, b, m_language, m_preferredDiscType);
+            insertPoster(posters, b, language, preferredDiscType);
         }
     }
 
@@ -492,8 +538,10 @@ void FanartTv::loadTvShowData(TvDbId tvdbId, ImageType type, SeasonNumber season
 {
     QUrl url = QStringLiteral("https://webservice.fanart.tv/v3/tv/%1?%2").arg(tvdbId.toString(), keyParameter());
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    mediaelch::network::setRequestTag(request, {"FanartTv", QString(), "images"});
 
     QNetworkReply* reply = qnam()->get(request);
+    mediaelch::network::ScrapeStats::instance().watch(reply);
     reply->setProperty("infoToLoad", static_cast<int>(type));
     reply->setProperty("season", season.toInt());
     connect(reply, &QNetworkReply::finished, this, &FanartTv::onLoadTvShowDataFinished);
@@ -503,8 +551,10 @@ void FanartTv::loadTvShowData(TvDbId tvdbId, QVector<ImageType> types, TvShow* s
 {
     QUrl url = QStringLiteral("https://webservice.fanart.tv/v3/tv/%1?%2").arg(tvdbId.toString(), keyParameter());
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    mediaelch::network::setRequestTag(request, {"FanartTv", show->title(), "images"});
 
     QNetworkReply* reply = qnam()->get(request);
+    mediaelch::network::ScrapeStats::instance().watch(reply);
     reply->setProperty("infosToLoad", Storage::toVariant(reply, types));
     reply->setProperty("storage", Storage::toVariant(reply, show));
     connect(reply, &QNetworkReply::finished, this, &FanartTv::onLoadAllTvShowDataFinished);
@@ -526,11 +576,17 @@ void FanartTv::onLoadTvShowDataFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
-    QVector<Poster> posters = parseTvShowData(
-        msg, ImageType(reply->property("infoToLoad").toInt()), SeasonNumber(reply->property("season").toInt()));
-
-    emit sigImagesLoaded(posters, {});
+    const QByteArray json = reply->readAll();
+    const auto type = ImageType(reply->property("infoToLoad").toInt());
+    const auto season = SeasonNumber(reply->property("season").toInt());
+    const QString language = m_language;
+    const QString discType = m_preferredDiscType;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json, type, season, language, discType]() {
+            return parseTvShowData(parseJson(json, "TV show"), type, season, language, discType);
+        },
+        [this](QVector<Poster> posters) { emit sigImagesLoaded(posters, {}); });
 }
 
 /**
@@ -540,17 +596,28 @@ void FanartTv::onLoadTvShowDataFinished()
 void FanartTv::onLoadAllTvShowDataFinished()
 {
     auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    TvShow* show = reply->property("storage").value<Storage*>()->show();
+    const QPointer<TvShow> show = reply->property("storage").value<Storage*>()->show();
     reply->deleteLater();
-    QMap<ImageType, QVector<Poster>> posters;
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        for (const auto type : reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad()) {
-            posters.insert(type, parseTvShowData(msg, type));
-        }
+    if (reply->error() != QNetworkReply::NoError) {
+        emit sigTvShowImagesLoaded(show, {});
+        return;
     }
-    reply->deleteLater();
-    emit sigTvShowImagesLoaded(show, posters);
+
+    const QByteArray json = reply->readAll();
+    const QVector<ImageType> types = reply->property("infosToLoad").value<Storage*>()->imageInfosToLoad();
+    const QString language = m_language;
+    const QString discType = m_preferredDiscType;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json, types, language, discType]() {
+            const QJsonObject parsedJson = parseJson(json, "TV show");
+            QMap<ImageType, QVector<Poster>> posters;
+            for (const auto type : types) {
+                posters.insert(type, parseTvShowData(parsedJson, type, SeasonNumber::NoSeason, language, discType));
+            }
+            return posters;
+        },
+        [this, show](QMap<ImageType, QVector<Poster>> posters) { emit sigTvShowImagesLoaded(show, posters); });
 }
 
 /**
@@ -653,12 +720,16 @@ void FanartTv::tvShowSeasonThumbs(TvDbId tvdbId, SeasonNumber season)
 }
 
 /**
- * @brief Parses JSON data for TV shows
- * @param json JSON data
+ * @brief Parses JSON data for TV shows. Thread-safe.
+ * @param parsedJson JSON data, see parseJson()
  * @param type Type of image (ImageType)
  * @return List of posters
  */
-QVector<Poster> FanartTv::parseTvShowData(QString json, ImageType type, SeasonNumber season)
+QVector<Poster> FanartTv::parseTvShowData(const QJsonObject& parsedJson,
+    ImageType type,
+    SeasonNumber season,
+    const QString& language,
+    const QString& preferredDiscType)
 {
     QMap<ImageType, QStringList> map;
 
@@ -676,15 +747,6 @@ QVector<Poster> FanartTv::parseTvShowData(QString json, ImageType type, SeasonNu
 
     QVector<Poster> posters;
 
-    QJsonParseError parseError{};
-    // The JSON contains one object with all URLs to fanart images
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
-
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Error parsing fanart TV show json " << parseError.errorString();
-        return posters;
-    }
-
     for (const QString& section : map.value(type)) {
         const auto jsonPosters = parsedJson.value(section).toArray();
 
@@ -727,7 +789,7 @@ QVector<Poster> FanartTv::parseTvShowData(QString json, ImageType type, SeasonNu
                 return QStringLiteral("");
             }();
             b.language = poster.value("lang").toString();
-            insertPoster(posters, b, m_language, m_preferredDiscType);
+            insertPoster(posters, b, language, preferredDiscType);
         }
     }
 
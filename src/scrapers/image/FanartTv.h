@@ -5,6 +5,7 @@
 #include "scrapers/movie/MovieScraperInterface.h"
 
 #include <QComboBox>
+#include <QJsonObject>
 #include <QLineEdit>
 #include <QMap>
 #include <QNetworkAccessManager>
@@ -90,7 +91,6 @@ private:
     QVector<ImageType> m_provides;
     QString m_apiKey;
     QString m_personalApiKey;
-    QNetworkAccessManager m_qnam;
     int m_searchResultLimit;
     TheTvDb* m_tvdb;
     TMDb* m_tmdb;
@@ -102,12 +102,21 @@ private:
     QLineEdit* m_personalApiKeyEdit;
 
     QNetworkAccessManager* qnam();
-    QVector<Poster> parseMovieData(QString json, ImageType type);
     void loadMovieData(TmdbId tmdbId, ImageType type);
     void loadMovieData(TmdbId tmdbId, QVector<ImageType> types, Movie* movie);
     void loadConcertData(TmdbId tmdbId, QVector<ImageType> types, Concert* concert);
-    QVector<Poster> parseTvShowData(QString json, ImageType type, SeasonNumber season = SeasonNumber::NoSeason);
     void loadTvShowData(TvDbId tvdbId, ImageType type, SeasonNumber season = SeasonNumber::NoSeason);
     void loadTvShowData(TvDbId tvdbId, QVector<ImageType> types, TvShow* show);
     QString keyParameter();
+
+    static QJsonObject parseJson(const QByteArray& json, const char* kind);
+    static QVector<Poster> parseMovieData(const QJsonObject& parsedJson,
+        ImageType type,
+        const QString& language,
+        const QString& preferredDiscType);
+    static QVector<Poster> parseTvShowData(const QJsonObject& parsedJson,
+        ImageType type,
+        SeasonNumber season,
+        const QString& language,
+        const QString& preferredDiscType);
 };
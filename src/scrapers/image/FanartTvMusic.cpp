@@ -9,6 +9,7 @@
 #include <QJsonValue>
 
 #include "data/Storage.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
 #include "scrapers/image/FanartTv.h"
 #include "scrapers/movie/TMDb.h"
@@ -49,7 +50,7 @@ QVector<ImageType> FanartTvMusic::provides()
 
 QNetworkAccessManager* FanartTvMusic::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 void FanartTvMusic::searchAlbum(QString artistName, QString searchStr, int limit)
@@ -77,7 +77,6 @@ private:
     QVector<ImageType> m_provides;
     QString m_apiKey;
     QString m_personalApiKey;
-    QNetworkAccessManager m_qnam;
     int m_searchResultLimit;
     QString m_language;
 
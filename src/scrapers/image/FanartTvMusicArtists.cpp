@@ -8,6 +8,7 @@
 #include <QJsonValue>
 
 #include "data/Storage.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
 #include "scrapers/image/FanartTv.h"
 #include "scrapers/movie/TMDb.h"
@@ -56,7 +57,7 @@ QVector<ImageType> FanartTvMusicArtists::provides()
  */
 QNetworkAccessManager* FanartTvMusicArtists::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 /**
@@ -0,0 +1,139 @@
+#include "scrapers/imdb/ImdbActorImageCache.h"
+
+#include "data/DatabaseService.h"
+#include "globals/Manager.h"
+#include "network/NetworkReplyWatcher.h"
+#include "network/NetworkRequest.h"
+#include "scrapers/imdb/ImdbRequestQueue.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QRegExp>
+
+namespace mediaelch {
+namespace imdb {
+
+ActorImageCache& ActorImageCache::instance()
+{
+    static auto* cache = new ActorImageCache(QCoreApplication::instance());
+    return *cache;
+}
+
+ActorImageCache::ActorImageCache(QObject* parent) : QObject(parent)
+{
+    DatabaseService* database = Manager::instance()->databaseService();
+    if (database == nullptr) {
+        m_databaseLoaded = true;
+        return;
+    }
+    const qint64 updatedAfter = QDateTime::currentDateTime().addDays(-s_maxAgeDays).toMSecsSinceEpoch();
+    database->read<QHash<QString, QString>>(
+        [updatedAfter](Database& db) { return db.imdbActorImageUrls(updatedAfter); },
+        this,
+        [this](QHash<QString, QString> imageUrls) { onDatabaseLoaded(imageUrls); });
+}
+
+void ActorImageCache::imageUrl(const QUrl& profileUrl, QObject* context, Callback callback)
+{
+    const QString key = profileUrl.toString();
+    if (key.isEmpty()) {
+        callback(QString());
+        return;
+    }
+
+    auto cached = m_imageUrls.constFind(key);
+    if (cached != m_imageUrls.constEnd()) {
+        ++m_cacheHits;
+        callback(cached.value());
+        return;
+    }
+
+    const bool isLoading = m_waiters.contains(key);
+    m_waiters[key].push_back(Waiter{context, std::move(callback)});
+    if (isLoading) {
+        ++m_cacheHits; // e.g. the same actor in two movies of a multi-scrape
+    } else if (m_databaseLoaded) {
+        load(key);
+    }
+    // Otherwise the profile is loaded once the database entries are available.
+}
+
+void ActorImageCache::onDatabaseLoaded(const QHash<QString, QString>& imageUrls)
+{
+    qDebug() << "[ImdbActorImageCache] Loaded" << imageUrls.size() << "actor image URLs from the database";
+    for (auto it = imageUrls.constBegin(); it != imageUrls.constEnd(); ++it) {
+        if (!m_imageUrls.contains(it.key())) {
+            m_imageUrls.insert(it.key(), it.value());
+        }
+    }
+    m_databaseLoaded = true;
+
+    const QStringList waiting = m_waiters.keys();
+    for (const QString& profileUrl : waiting) {
+        auto cached = m_imageUrls.constFind(profileUrl);
+        if (cached != m_imageUrls.constEnd()) {
+            ++m_cacheHits;
+            onProfileLoaded(profileUrl, cached.value());
+        } else {
+            load(profileUrl);
+        }
+    }
+}
+
+void ActorImageCache::load(const QString& profileUrl)
+{
+    ++m_networkRequests;
+    auto request = network::requestWithDefaults(QUrl(profileUrl));
+    // The actor's image should be the same for all languages. So we can
+    // just load the English version of the page.
+    request.setRawHeader("Accept-Language", "en");
+
+    requestQueue().get(request, this, [this, profileUrl](QNetworkReply* reply) {
+        new NetworkReplyWatcher(this, reply);
+        connect(reply, &QNetworkReply::finished, this, [this, profileUrl, reply]() {
+            reply->deleteLater();
+            if (reply->error() != QNetworkReply::NoError) {
+                // Not cached, so that the next scrape tries again.
+                qWarning() << "[ImdbActorImageCache] Network Error (load actor image)" << reply->errorString();
+                onProfileLoaded(profileUrl, QString());
+                return;
+            }
+
+            const QString imageUrl = parseImageUrl(QString::fromUtf8(reply->readAll()));
+            m_imageUrls.insert(profileUrl, imageUrl);
+            DatabaseService* database = Manager::instance()->databaseService();
+            if (database != nullptr) {
+                const qint64 updated = QDateTime::currentDateTime().toMSecsSinceEpoch();
+                database->write([profileUrl, imageUrl, updated](Database& db) {
+                    db.setImdbActorImageUrl(profileUrl, imageUrl, updated);
+                });
+            }
+            onProfileLoaded(profileUrl, imageUrl);
+        });
+    });
+}
+
+void ActorImageCache::onProfileLoaded(const QString& profileUrl, const QString& imageUrl)
+{
+    const QVector<Waiter> waiters = m_waiters.take(profileUrl);
+    for (const Waiter& waiter : waiters) {
+        if (!waiter.context.isNull()) {
+            waiter.callback(imageUrl);
+        }
+    }
+}
+
+QString ActorImageCache::parseImageUrl(const QString& html)
+{
+    QRegExp rx(R"re(<link rel=['"]image_src['"] href="([^"]+)">)re");
+    rx.setMinimal(true);
+    if (rx.indexIn(html) == -1) {
+        return "";
+    }
+
+    return rx.cap(1);
+}
+
+} // namespace imdb
+} // namespace mediaelch
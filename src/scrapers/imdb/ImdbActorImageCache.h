@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+#include <functional>
+
+namespace mediaelch {
+namespace imdb {
+
+/// \brief Maps IMDb actor profiles (e.g. "https://www.imdb.com/name/nm0000244/") to the URL of their image.
+///
+/// The image URL is only available on the actor's profile page, i.e. it needs one request per actor.
+/// Actors appear in many movies, so the URLs are cached for the whole session and stored in the
+/// database for later sessions. Lookups for a profile that is already being loaded share its request.
+/// Requests are sent through imdb::requestQueue(). Must only be used from the GUI thread.
+class ActorImageCache : public QObject
+{
+    Q_OBJECT
+public:
+    using Callback = std::function<void(QString imageUrl)>;
+
+    static ActorImageCache& instance();
+
+    /// \brief Calls \p callback with the actor's image URL, or with an empty string if the profile has
+    /// no image or could not be loaded. Cached URLs are passed to \p callback before this function
+    /// returns. \p callback is not called if \p context is destroyed before the URL is available.
+    void imageUrl(const QUrl& profileUrl, QObject* context, Callback callback);
+
+    /// \brief Number of lookups that did not need a request of their own.
+    int cacheHits() const { return m_cacheHits; }
+    int networkRequests() const { return m_networkRequests; }
+
+    static QString parseImageUrl(const QString& html);
+
+private:
+    struct Waiter
+    {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    explicit ActorImageCache(QObject* parent = nullptr);
+
+    void onDatabaseLoaded(const QHash<QString, QString>& imageUrls);
+    void load(const QString& profileUrl);
+    void onProfileLoaded(const QString& profileUrl, const QString& imageUrl);
+
+    /// Cached entries are reloaded after this time in case the actor's image has changed.
+    static constexpr qint64 s_maxAgeDays = 90;
+
+    QHash<QString, QString> m_imageUrls;
+    QHash<QString, QVector<Waiter>> m_waiters;
+    bool m_databaseLoaded = false;
+    int m_cacheHits = 0;
+    int m_networkRequests = 0;
+};
+
+} // namespace imdb
+} // namespace mediaelch
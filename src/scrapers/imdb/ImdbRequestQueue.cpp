@@ -0,0 +1,19 @@
+#include "scrapers/imdb/ImdbRequestQueue.h"
+
+#include <QCoreApplication>
+
+namespace mediaelch {
+namespace imdb {
+
+/// A few parallel requests keep multi-scrapes fast without being throttled.
+static constexpr int s_maxConcurrentRequests = 4;
+
+network::RequestQueue& requestQueue()
+{
+    // Deleted together with the application, while the network stack still exists.
+    static auto* queue = new network::RequestQueue(s_maxConcurrentRequests, QCoreApplication::instance());
+    return *queue;
+}
+
+} // namespace imdb
+} // namespace mediaelch
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "network/RequestQueue.h"
+
+namespace mediaelch {
+namespace imdb {
+
+/// \brief Queue for all requests to imdb.com, shared by the IMDb movie scraper
+/// and the IMDb requests of TheTvDb. IMDb throttles clients that send many
+/// requests at once, e.g. one request per actor for each movie of a multi-scrape.
+/// Must only be used from the GUI thread.
+network::RequestQueue& requestQueue();
+
+} // namespace imdb
+} // namespace mediaelch
@@ -2,11 +2,14 @@
 
 #include <QDebug>
 #include <QGridLayout>
-#include <QRegExp>
+#include <QPointer>
 
 #include "data/Storage.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/HtmlPattern.h"
 #include "ui/main/MainWindow.h"
 
 AEBN::AEBN(QObject* parent) :
@@ -123,7 +126,7 @@ void AEBN::search(QString searchStr)
         "Large&theaterId=822&genreId=%3")
                  .arg(m_language, encodedSearch, m_genreId));
     auto request = mediaelch::network::requestWithDefaults(url);
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     connect(reply, &QNetworkReply::finished, this, &AEBN::onSearchFinished);
 }
@@ -144,28 +147,29 @@ void AEBN::onSearchFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
-    emit searchDone(parseSearch(msg), {});
+    const QString msg = QString::fromUtf8(reply->readAll());
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg]() { return parseSearch(msg); },
+        [this](QVector<ScraperSearchResult> results) { emit searchDone(results, {}); });
 }
 
-QVector<ScraperSearchResult> AEBN::parseSearch(QString html)
+QVector<ScraperSearchResult> AEBN::parseSearch(const QString& html)
 {
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rx("<a id=\"FTSMovieSearch_link_image_detail_[0-9]+\" "
+                                "href=\"/dispatcher/"
+                                "movieDetail\\?genreId=([0-9]+)&amp;theaterId=([0-9]+)&amp;movieId=([0-9]+)([^\"]*)\" "
+                                "title=\"([^\"]*)\"><img src=\"([^\"]*)\" alt=\"([^\"]*)\" /></a>");
+
     QVector<ScraperSearchResult> results;
-    int offset = 0;
-    QRegExp rx("<a id=\"FTSMovieSearch_link_image_detail_[0-9]+\" "
-               "href=\"/dispatcher/"
-               "movieDetail\\?genreId=([0-9]+)&amp;theaterId=([0-9]+)&amp;movieId=([0-9]+)([^\"]*)\" "
-               "title=\"([^\"]*)\"><img src=\"([^\"]*)\" alt=\"([^\"]*)\" /></a>");
-    //    QRegExp rx("<a id=\"FTSMovieSearch_link_image_detail_[0-9]+\"
-    //    href=\"/dispatcher/movieDetail\\?movieId=([0-9]+)([^\"]*)\" title=\"([^\"]*)\"><img src=\"([^\"]*)\"
-    //    alt=\"([^\"]*)\" /></a>");
-    rx.setMinimal(true);
-    while ((offset = rx.indexIn(html, offset)) != -1) {
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
         ScraperSearchResult result;
-        result.id = rx.cap(3);
-        result.name = rx.cap(5);
+        result.id = match.captured(3);
+        result.name = match.captured(5);
         results << result;
-        offset += rx.matchedLength();
     }
 
     return results;
@@ -179,7 +183,7 @@ void AEBN::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
         "https://straight.theater.aebn.net/dispatcher/movieDetail?movieId=%1&locale=%2&theaterId=822&genreId=%3")
                  .arg(ids.values().first(), m_language, m_genreId));
     auto request = mediaelch::network::requestWithDefaults(url);
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     reply->setProperty("storage", Storage::toVariant(reply, movie));
     reply->setProperty("infosToLoad", Storage::toVariant(reply, infos));
@@ -192,149 +196,185 @@ void AEBN::onLoadFinished()
     Movie* movie = reply->property("storage").value<Storage*>()->movie();
     reply->deleteLater();
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        QStringList actorIds;
-        parseAndAssignInfos(msg, movie, reply->property("infosToLoad").value<Storage*>()->movieInfosToLoad(), actorIds);
-        if (!actorIds.isEmpty()) {
-            downloadActors(movie, actorIds);
-            return;
-        }
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error" << reply->errorString();
+        movie->controller()->scraperLoadDone(this);
+        return;
     }
-    movie->controller()->scraperLoadDone(this);
+
+    const QString msg = QString::fromUtf8(reply->readAll());
+    const QSet<MovieScraperInfos> infos = reply->property("infosToLoad").value<Storage*>()->movieInfosToLoad();
+    const QPointer<Movie> moviePtr(movie);
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg, infos]() { return parseInfos(msg, infos); },
+        [this, moviePtr](const ScrapedMovieData& data) {
+            if (moviePtr.isNull()) {
+                return;
+            }
+            QStringList actorIds;
+            assignInfos(data, moviePtr.data(), actorIds);
+            if (!actorIds.isEmpty()) {
+                downloadActors(moviePtr.data(), actorIds);
+                return;
+            }
+            moviePtr->controller()->scraperLoadDone(this);
+        });
 }
 
-void AEBN::parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos, QStringList& actorIds)
+ScrapedMovieData AEBN::parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
-
-    rx.setPattern(R"(<h1 itemprop="name"  class="md-movieTitle"  >(.*)</h1>)");
-    if (infos.contains(MovieScraperInfos::Title) && rx.indexIn(html) != -1) {
-        movie->setName(rx.cap(1));
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxTitle(R"(<h1 itemprop="name"  class="md-movieTitle"  >(.*)</h1>)");
+    static const HtmlPattern rxRuntime(
+        "<span class=\"runTime\"><span itemprop=\"duration\" content=\"([^\"]*)\">([0-9]+)</span>");
+    static const HtmlPattern rxReleased(
+        "<span class=\"detailsLink\" itemprop=\"datePublished\" content=\"([0-9]{4})(.*)\">");
+    static const HtmlPattern rxOverview("<span itemprop=\"about\">(.*)</span>");
+    static const HtmlPattern rxPoster(
+        "<div id=\"md-boxCover\"><a href=\"([^\"]*)\" target=\"_blank\" onclick=\"([^\"]*)\"><img "
+        "itemprop=\"thumbnailUrl\" src=\"([^\"]*)\" alt=\"([^\"]*)\" name=\"boxImage\" id=\"boxImage\" "
+        "/></a>");
+    static const HtmlPattern rxSet("<span class=\"detailsLink\"><a href=\"([^\"]*)\" class=\"series\">(.*)</a>");
+    static const HtmlPattern rxDirector(
+        "<span class=\"detailsLink\" itemprop=\"director\" itemscope "
+        "itemtype=\"http://schema.org/Person\">(.*)<a href=\"(.*)\" itemprop=\"name\">(.*)</a>");
+    static const HtmlPattern rxStudio("<a href=\"(.*)\" itemprop=\"productionCompany\">(.*)</a>");
+    static const HtmlPattern rxGenre("<a href=\"(.*)\"(.*) itemprop=\"genre\">(.*)</a>");
+    static const HtmlPattern rxSexActs("<a href=\"(.*)sexActs=[0-9]*(.*)\" (.*)>(.*)</a>");
+    static const HtmlPattern rxPositions("<a href=\"(.*)positions=[0-9]*(.*)\" (.*)>(.*)</a>");
+    static const HtmlPattern rxStar(
+        "<a href=\"/dispatcher/starDetail\\?(.*)starId=([0-9]*)&amp;(.*)\"  class=\"linkWithPopup\" "
+        "onmouseover=\"(.*)\" onmouseout=\"killPopUp\\(\\)\"   itemprop=\"actor\" itemscope "
+        "itemtype=\"http://schema.org/Person\"><span itemprop=\"name\">(.*)</span></a>");
+    static const HtmlPattern rxActor(
+        "<a href=\"([^\"]*)\"   itemprop=\"actor\" itemscope itemtype=\"http://schema.org/Person\"><span "
+        "itemprop=\"name\">(.*)</span></a>");
+
+    ScrapedMovieData data;
+    QRegularExpressionMatch match;
+
+    if (infos.contains(MovieScraperInfos::Title) && rxTitle.find(html, match)) {
+        data.title = match.captured(1);
     }
 
-    rx.setPattern("<span class=\"runTime\"><span itemprop=\"duration\" content=\"([^\"]*)\">([0-9]+)</span>");
-    if (infos.contains(MovieScraperInfos::Runtime) && rx.indexIn(html) != -1) {
-        movie->setRuntime(std::chrono::minutes(rx.cap(2).toInt()));
+    if (infos.contains(MovieScraperInfos::Runtime) && rxRuntime.find(html, match)) {
+        data.runtime = match.captured(2).toInt();
     }
 
-    rx.setPattern("<span class=\"detailsLink\" itemprop=\"datePublished\" content=\"([0-9]{4})(.*)\">");
-    if (infos.contains(MovieScraperInfos::Released) && rx.indexIn(html) != -1) {
-        movie->setReleased(QDate::fromString(rx.cap(1), "yyyy"));
+    if (infos.contains(MovieScraperInfos::Released) && rxReleased.find(html, match)) {
+        data.released = QDate::fromString(match.captured(1), "yyyy");
     }
 
-    rx.setPattern("<span itemprop=\"about\">(.*)</span>");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
-        movie->setOverview(rx.cap(1));
-        if (Settings::instance()->usePlotForOutline()) {
-            movie->setOutline(rx.cap(1));
-        }
+    if (infos.contains(MovieScraperInfos::Overview) && rxOverview.find(html, match)) {
+        data.overview = match.captured(1);
     }
 
-    rx.setPattern("<div id=\"md-boxCover\"><a href=\"([^\"]*)\" target=\"_blank\" onclick=\"([^\"]*)\"><img "
-                  "itemprop=\"thumbnailUrl\" src=\"([^\"]*)\" alt=\"([^\"]*)\" name=\"boxImage\" id=\"boxImage\" "
-                  "/></a>");
-    if (infos.contains(MovieScraperInfos::Poster) && rx.indexIn(html) != -1) {
+    if (infos.contains(MovieScraperInfos::Poster) && rxPoster.find(html, match)) {
         Poster p;
-        p.thumbUrl = QString("https:") + rx.cap(3);
-        p.originalUrl = QString("https:") + rx.cap(1);
-        movie->images().addPoster(p);
+        p.thumbUrl = QString("https:") + match.captured(3);
+        p.originalUrl = QString("https:") + match.captured(1);
+        data.posters.append(p);
     }
 
-    rx.setPattern("<span class=\"detailsLink\"><a href=\"([^\"]*)\" class=\"series\">(.*)</a>");
-    if (infos.contains(MovieScraperInfos::Set) && rx.indexIn(html) != -1) {
-        MovieSet set;
-        set.name = rx.cap(2);
-        movie->setSet(set);
+    if (infos.contains(MovieScraperInfos::Set) && rxSet.find(html, match)) {
+        data.set = match.captured(2);
     }
 
-    rx.setPattern("<span class=\"detailsLink\" itemprop=\"director\" itemscope "
-                  "itemtype=\"http://schema.org/Person\">(.*)<a href=\"(.*)\" itemprop=\"name\">(.*)</a>");
-    if (infos.contains(MovieScraperInfos::Director) && rx.indexIn(html) != -1) {
-        movie->setDirector(rx.cap(3));
+    if (infos.contains(MovieScraperInfos::Director) && rxDirector.find(html, match)) {
+        data.director = match.captured(3);
     }
 
-    rx.setPattern("<a href=\"(.*)\" itemprop=\"productionCompany\">(.*)</a>");
-    if (infos.contains(MovieScraperInfos::Studios) && rx.indexIn(html) != -1) {
-        movie->addStudio(rx.cap(2));
+    if (infos.contains(MovieScraperInfos::Studios) && rxStudio.find(html, match)) {
+        data.studios << match.captured(2);
     }
 
     if (infos.contains(MovieScraperInfos::Genres)) {
-        int offset = 0;
-        rx.setPattern("<a href=\"(.*)\"(.*) itemprop=\"genre\">(.*)</a>");
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            movie->addGenre(rx.cap(3));
-            offset += rx.matchedLength();
-        }
+        data.genres = rxGenre.captureAll(html, 3);
     }
 
     if (infos.contains(MovieScraperInfos::Tags)) {
-        int offset = 0;
-        rx.setPattern("<a href=\"(.*)sexActs=[0-9]*(.*)\" (.*)>(.*)</a>");
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            movie->addTag(rx.cap(4));
-            offset += rx.matchedLength();
-        }
-        offset = 0;
-        rx.setPattern("<a href=\"(.*)positions=[0-9]*(.*)\" (.*)>(.*)</a>");
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            movie->addTag(rx.cap(4));
-            offset += rx.matchedLength();
-        }
+        data.tags = rxSexActs.captureAll(html, 4) + rxPositions.captureAll(html, 4);
     }
 
     if (infos.contains(MovieScraperInfos::Actors)) {
-        // clear actors
-        movie->setActors({});
-
-        int offset = 0;
-        rx.setPattern("<a href=\"/dispatcher/starDetail\\?(.*)starId=([0-9]*)&amp;(.*)\"  class=\"linkWithPopup\" "
-                      "onmouseover=\"(.*)\" onmouseout=\"killPopUp\\(\\)\"   itemprop=\"actor\" itemscope "
-                      "itemtype=\"http://schema.org/Person\"><span itemprop=\"name\">(.*)</span></a>");
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            offset += rx.matchedLength();
-
-            const QString actorName = rx.cap(5);
-            const QVector<Actor*> actors = movie->actors();
-
-            const bool actorAlreadyAdded = std::any_of(actors.cbegin(), actors.cend(), [&actorName](const Actor* a) { //
-                return a->name == actorName;                                                                          //
+        data.hasActors = true;
+        const auto isAdded = [&data](const QString& actorName) {
+            return std::any_of(data.actors.cbegin(), data.actors.cend(), [&actorName](const Actor& a) {
+                return a.name == actorName;
             });
+        };
 
-            if (actorAlreadyAdded) {
-                continue;
+        // Stars have an id that is used to load their images.
+        QRegularExpressionMatchIterator it = rxStar.globalMatch(html);
+        while (it.hasNext()) {
+            match = it.next();
+            if (!isAdded(match.captured(5))) {
+                Actor a;
+                a.name = match.captured(5);
+                a.id = match.captured(2);
+                data.actors.append(a);
             }
+        }
 
-            Actor a;
-            a.name = rx.cap(5);
-            a.id = rx.cap(2);
-            movie->addActor(a);
-            if (Settings::instance()->downloadActorImages() && !actorIds.contains(rx.cap(2))) {
-                actorIds.append(rx.cap(2));
+        it = rxActor.globalMatch(html);
+        while (it.hasNext()) {
+            match = it.next();
+            if (!isAdded(match.captured(2))) {
+                Actor a;
+                a.name = match.captured(2);
+                data.actors.append(a);
             }
         }
+    }
 
-        offset = 0;
-        rx.setPattern("<a href=\"([^\"]*)\"   itemprop=\"actor\" itemscope itemtype=\"http://schema.org/Person\"><span "
-                      "itemprop=\"name\">(.*)</span></a>");
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            offset += rx.matchedLength();
-
-            const QString actorName = rx.cap(2);
-            const QVector<Actor*> actors = movie->actors();
-
-            const bool actorAlreadyAdded = std::any_of(actors.cbegin(), actors.cend(), [&actorName](const Actor* a) { //
-                return a->name == actorName;                                                                          //
-            });
+    return data;
+}
 
-            if (!actorAlreadyAdded) {
-                Actor a;
-                a.name = rx.cap(2);
-                movie->addActor(a);
+void AEBN::assignInfos(const ScrapedMovieData& data, Movie* movie, QStringList& actorIds)
+{
+    if (!data.title.isEmpty()) {
+        movie->setName(data.title);
+    }
+    if (data.runtime > -1) {
+        movie->setRuntime(std::chrono::minutes(data.runtime));
+    }
+    if (data.released.isValid()) {
+        movie->setReleased(data.released);
+    }
+    if (!data.overview.isEmpty()) {
+        movie->setOverview(data.overview);
+        if (Settings::instance()->usePlotForOutline()) {
+            movie->setOutline(data.overview);
+        }
+    }
+    for (const Poster& poster : data.posters) {
+        movie->images().addPoster(poster);
+    }
+    if (!data.set.isEmpty()) {
+        MovieSet set;
+        set.name = data.set;
+        movie->setSet(set);
+    }
+    if (!data.director.isEmpty()) {
+        movie->setDirector(data.director);
+    }
+    for (const QString& studio : data.studios) {
+        movie->addStudio(studio);
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(genre);
+    }
+    for (const QString& tag : data.tags) {
+        movie->addTag(tag);
+    }
+    if (data.hasActors) {
+        movie->setActors({});
+        for (const Actor& actor : data.actors) {
+            movie->addActor(actor);
+            if (!actor.id.isEmpty() && Settings::instance()->downloadActorImages() && !actorIds.contains(actor.id)) {
+                actorIds.append(actor.id);
             }
         }
     }
@@ -352,7 +392,7 @@ void AEBN::downloadActors(Movie* movie, QStringList actorIds)
         "https://straight.theater.aebn.net/dispatcher/starDetail?locale=%2&starId=%1&theaterId=822&genreId=%3")
                  .arg(id, m_language, m_genreId));
     auto request = mediaelch::network::requestWithDefaults(url);
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     reply->setProperty("storage", Storage::toVariant(reply, movie));
     reply->setProperty("actorIds", actorIds);
@@ -380,12 +420,13 @@ void AEBN::onActorLoadFinished()
 
 void AEBN::parseAndAssignActor(QString html, Movie* movie, QString id)
 {
-    QRegExp rx(R"lit(<img itemprop="image" src="([^"]*)" alt="([^"]*)" class="star" />)lit");
-    rx.setMinimal(true);
-    if (rx.indexIn(html) != -1) {
+    static const mediaelch::scraper::HtmlPattern rx(
+        R"lit(<img itemprop="image" src="([^"]*)" alt="([^"]*)" class="star" />)lit");
+    QRegularExpressionMatch match;
+    if (rx.find(html, match)) {
         for (Actor* a : movie->actors()) {
             if (a->id == id) {
-                a->thumb = QStringLiteral("https:") + rx.cap(1);
+                a->thumb = QStringLiteral("https:") + match.captured(1);
             }
         }
     }
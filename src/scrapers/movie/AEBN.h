@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scrapers/movie/MovieScraperInterface.h"
+#include "scrapers/movie/ScrapedMovieData.h"
 
 #include <QComboBox>
 #include <QMap>
@@ -30,13 +31,15 @@ public:
     QWidget* settingsWidget() override;
     bool isAdult() const override;
 
+    /// \brief Extracts the results of a search page. Thread-safe.
+    static QVector<ScraperSearchResult> parseSearch(const QString& html);
+
 private slots:
     void onSearchFinished();
     void onLoadFinished();
     void onActorLoadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QSet<MovieScraperInfos> m_scraperSupports;
     QString m_language;
     QString m_genreId;
@@ -44,8 +47,10 @@ private:
     QComboBox* m_box;
     QComboBox* m_genreBox;
 
-    QVector<ScraperSearchResult> parseSearch(QString html);
-    void parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos, QStringList& actorIds);
+    /// \brief Extracts the infos of a movie's page. Thread-safe.
+    static ScrapedMovieData parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos);
+    /// \brief Assigns the result of parseInfos() and collects the ids of actors whose images are loaded.
+    void assignInfos(const ScrapedMovieData& data, Movie* movie, QStringList& actorIds);
     void downloadActors(Movie* movie, QStringList actorIds);
     void parseAndAssignActor(QString html, Movie* movie, QString id);
 };
@@ -1,12 +1,15 @@
 #include "AdultDvdEmpire.h"
 
 #include <QDebug>
-#include <QRegExp>
+#include <QPointer>
 #include <QTextDocument>
 
 #include "data/Storage.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/HtmlPattern.h"
 #include "settings/Settings.h"
 
 AdultDvdEmpire::AdultDvdEmpire(QObject* parent) :
@@ -67,7 +70,7 @@ QString AdultDvdEmpire::defaultLanguageKey()
 
 QNetworkAccessManager* AdultDvdEmpire::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 void AdultDvdEmpire::search(QString searchStr)
@@ -96,33 +99,43 @@ void AdultDvdEmpire::onSearchFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
-    emit searchDone(parseSearch(msg), {});
+    const QString msg = QString::fromUtf8(reply->readAll());
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg]() { return parseSearch(msg); },
+        [this](QVector<ScraperSearchResult> results) {
+            // QTextDocument is only used on the GUI thread.
+            QTextDocument doc;
+            for (ScraperSearchResult& result : results) {
+                doc.setHtml(result.name);
+                result.name = doc.toPlainText();
+            }
+            emit searchDone(results, {});
+        });
 }
 
-QVector<ScraperSearchResult> AdultDvdEmpire::parseSearch(QString html)
+QVector<ScraperSearchResult> AdultDvdEmpire::parseSearch(const QString& html)
 {
-    QTextDocument doc;
+    static const mediaelch::scraper::HtmlPattern rx(
+        R"re(<a href="([^"]*)"[\n\t\s]*title="([^"]*)" Category="List Page" Label="Title">)re");
+
     QVector<ScraperSearchResult> results;
-    int offset = 0;
-    QRegExp rx(R"re(<a href="([^"]*)"[\n\t\s]*title="([^"]*)" Category="List Page" Label="Title">)re");
-    rx.setMinimal(true);
-    while ((offset = rx.indexIn(html, offset)) != -1) {
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
         // DVDs vs VideoOnDemand (VOD)
         QString type;
-        if (rx.cap(1).endsWith("-movies.html")) {
+        if (match.captured(1).endsWith("-movies.html")) {
             type = "[DVD] ";
-        } else if (rx.cap(1).endsWith("-blu-ray.html")) {
+        } else if (match.captured(1).endsWith("-blu-ray.html")) {
             type = "[BluRay] ";
-        } else if (rx.cap(1).endsWith("-videos.html")) {
+        } else if (match.captured(1).endsWith("-videos.html")) {
             type = "[VOD] ";
         }
-        doc.setHtml(rx.cap(2).trimmed());
         ScraperSearchResult result;
-        result.id = rx.cap(1);
-        result.name = type + doc.toPlainText();
+        result.id = match.captured(1);
+        result.name = type + match.captured(2).trimmed();
         results << result;
-        offset += rx.matchedLength();
     }
 
     return results;
@@ -147,108 +160,169 @@ void AdultDvdEmpire::onLoadFinished()
     Movie* movie = reply->property("storage").value<Storage*>()->movie();
     reply->deleteLater();
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, reply->property("infosToLoad").value<Storage*>()->movieInfosToLoad());
-
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error" << reply->errorString();
+        movie->controller()->scraperLoadDone(this);
+        return;
     }
 
-    movie->controller()->scraperLoadDone(this);
+    const QString msg = QString::fromUtf8(reply->readAll());
+    const QSet<MovieScraperInfos> infos = reply->property("infosToLoad").value<Storage*>()->movieInfosToLoad();
+    const QPointer<Movie> moviePtr(movie);
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg, infos]() { return parseInfos(msg, infos); },
+        [this, moviePtr](const ScrapedMovieData& data) {
+            if (moviePtr.isNull()) {
+                return;
+            }
+            assignInfos(data, moviePtr.data());
+            moviePtr->controller()->scraperLoadDone(this);
+        });
 }
 
-void AdultDvdEmpire::parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos)
+ScrapedMovieData AdultDvdEmpire::parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos)
 {
-    QTextDocument doc;
-    QRegExp rx;
-    rx.setMinimal(true);
-
-    rx.setPattern("<h1>(.*)</h1>");
-    if (infos.contains(MovieScraperInfos::Title) && rx.indexIn(html) != -1) {
-        doc.setHtml(rx.cap(1).trimmed());
-        movie->setName(doc.toPlainText());
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxTitle("<h1>(.*)</h1>");
+    static const HtmlPattern rxRuntime("<small>Length: </small> ([0-9]*) hrs. ([0-9]*) mins.[\\s\\n]*</li>");
+    static const HtmlPattern rxReleased("<li><small>Production Year:</small> ([0-9]{4})[\\s\\n]*</li>");
+    static const HtmlPattern rxStudio(
+        "<li><small>Studio: </small><a href=\"[^\"]*\"[\\s\\n]*Category=\"Item Page\"[\\s\\n]*Label=\"Studio "
+        "- Details\">(.*)[\\s\\n]*</a>");
+    static const HtmlPattern rxActor(R"re(<a href="/\d+/[^"]*".*Category="Item Page" Label="Performer">)re"
+                                     R"re(<div class="[^"]+"><u>([^<]+)</u>.*<img src="([^"]+)")re");
+    static const HtmlPattern rxDirector(
+        R"(<a href="/\d+/[^"]+"\r\n\s+Category="Item Page" Label="Director">([^<]+)</a>)");
+    static const HtmlPattern rxCategories(R"(<strong>Categories:</strong>&nbsp;(.*)</div>)");
+    static const HtmlPattern rxCategory(
+        R"(<a href="[^"]*"[\r\s\n]*Category="Item Page" Label="Category">([^<]*)</a>)");
+    static const HtmlPattern rxOverview(
+        R"(<h4 class="m-b-0 text-dark synopsis">(<p( class="markdown-h[12]")?>.*)</p></h4>)");
+    static const HtmlPattern rxPoster("href=\"([^\"]*)\"[\\s\\n]*id=\"front-cover\"");
+    static const HtmlPattern rxSet(
+        R"(<a href="[^"]*"[\s\r\n]*Category="Item Page" Label="Series">[\s\r\n]*([^<]*)<span)");
+    static const HtmlPattern rxBackdrop(R"re(<a rel="(scene)?screenshots"[\s\n]*href="([^"]*)")re");
+
+    ScrapedMovieData data;
+    QRegularExpressionMatch match;
+
+    // Title, studio, overview and set are HTML; they are converted by assignInfos().
+    if (infos.contains(MovieScraperInfos::Title) && rxTitle.find(html, match)) {
+        data.title = match.captured(1).trimmed();
     }
 
-    rx.setPattern("<small>Length: </small> ([0-9]*) hrs. ([0-9]*) mins.[\\s\\n]*</li>");
-    if (infos.contains(MovieScraperInfos::Runtime) && rx.indexIn(html) != -1) {
-        using namespace std::chrono;
-        minutes runtime = hours(rx.cap(1).toInt()) + minutes(rx.cap(2).toInt());
-        movie->setRuntime(runtime);
+    if (infos.contains(MovieScraperInfos::Runtime) && rxRuntime.find(html, match)) {
+        data.runtime = match.captured(1).toInt() * 60 + match.captured(2).toInt();
     }
 
-    rx.setPattern("<li><small>Production Year:</small> ([0-9]{4})[\\s\\n]*</li>");
-    if (infos.contains(MovieScraperInfos::Released) && rx.indexIn(html) != -1) {
-        movie->setReleased(QDate::fromString(rx.cap(1), "yyyy"));
+    if (infos.contains(MovieScraperInfos::Released) && rxReleased.find(html, match)) {
+        data.released = QDate::fromString(match.captured(1), "yyyy");
     }
 
-    rx.setPattern("<li><small>Studio: </small><a href=\"[^\"]*\"[\\s\\n]*Category=\"Item Page\"[\\s\\n]*Label=\"Studio "
-                  "- Details\">(.*)[\\s\\n]*</a>");
-    if (infos.contains(MovieScraperInfos::Studios) && rx.indexIn(html) != -1) {
-        doc.setHtml(rx.cap(1));
-        movie->addStudio(doc.toPlainText().trimmed());
+    if (infos.contains(MovieScraperInfos::Studios) && rxStudio.find(html, match)) {
+        data.studios << match.captured(1);
     }
 
     if (infos.contains(MovieScraperInfos::Actors)) {
-        // clear actors
-        movie->setActors({});
-
-        int offset = 0;
-        rx.setPattern(R"re(<a href="/\d+/[^"]*".*Category="Item Page" Label="Performer">)re"
-                      R"re(<div class="[^"]+"><u>([^<]+)</u>.*<img src="([^"]+)")re");
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            offset += rx.matchedLength();
+        data.hasActors = true;
+        QRegularExpressionMatchIterator it = rxActor.globalMatch(html);
+        while (it.hasNext()) {
+            match = it.next();
             Actor a;
-            a.name = rx.cap(1);
-            a.thumb = rx.cap(2);
-            movie->addActor(a);
+            a.name = match.captured(1);
+            a.thumb = match.captured(2);
+            data.actors.append(a);
         }
     }
 
-    rx.setPattern(R"(<a href="/\d+/[^"]+"\r\n\s+Category="Item Page" Label="Director">([^<]+)</a>)");
-    if (infos.contains(MovieScraperInfos::Director) && rx.indexIn(html) != -1) {
-        movie->setDirector(rx.cap(1).trimmed());
+    if (infos.contains(MovieScraperInfos::Director) && rxDirector.find(html, match)) {
+        data.director = match.captured(1).trimmed();
     }
 
     // get the list of categories first (to avoid parsing categories of other movies)
-    rx.setPattern(R"(<strong>Categories:</strong>&nbsp;(.*)</div>)");
-    if (infos.contains(MovieScraperInfos::Genres) && rx.indexIn(html) != -1) {
-        QString categoryHtml = rx.cap(1);
-        rx.setPattern(R"(<a href="[^"]*"[\r\s\n]*Category="Item Page" Label="Category">([^<]*)</a>)");
-        int offset = 0;
-        while ((offset = rx.indexIn(categoryHtml, offset)) != -1) {
-            movie->addGenre(rx.cap(1).trimmed());
-            offset += rx.matchedLength();
+    if (infos.contains(MovieScraperInfos::Genres) && rxCategories.find(html, match)) {
+        for (const QString& genre : rxCategory.captureAll(match.captured(1))) {
+            data.genres << genre.trimmed();
         }
     }
 
-    rx.setPattern(R"(<h4 class="m-b-0 text-dark synopsis">(<p( class="markdown-h[12]")?>.*)</p></h4>)");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
+    if (infos.contains(MovieScraperInfos::Overview) && rxOverview.find(html, match)) {
         // add some newlines to simulate the paragraphs (scene descriptions)
-        QString content{rx.cap(1).trimmed()};
+        QString content{match.captured(1).trimmed()};
         content.remove("<p class=\"markdown-h1\">");
         content.remove("<p>");
         content.replace("<p class=\"markdown-h2\">", "<br>");
         content.replace("</p>", "<br>");
-        doc.setHtml(content);
+        data.overview = content;
+    }
+
+    if (infos.contains(MovieScraperInfos::Poster) && rxPoster.find(html, match)) {
+        Poster p;
+        p.thumbUrl = match.captured(1);
+        p.originalUrl = match.captured(1);
+        data.posters.append(p);
+    }
+
+    if (infos.contains(MovieScraperInfos::Set) && rxSet.find(html, match)) {
+        data.set = match.captured(1);
+    }
+
+    if (infos.contains(MovieScraperInfos::Backdrop)) {
+        for (const QString& url : rxBackdrop.captureAll(html, 2)) {
+            Poster p;
+            p.thumbUrl = url;
+            p.originalUrl = url;
+            data.backdrops.append(p);
+        }
+    }
+
+    return data;
+}
+
+void AdultDvdEmpire::assignInfos(const ScrapedMovieData& data, Movie* movie)
+{
+    QTextDocument doc;
+
+    if (!data.title.isEmpty()) {
+        doc.setHtml(data.title);
+        movie->setName(doc.toPlainText());
+    }
+    if (data.runtime > -1) {
+        movie->setRuntime(std::chrono::minutes(data.runtime));
+    }
+    if (data.released.isValid()) {
+        movie->setReleased(data.released);
+    }
+    for (const QString& studio : data.studios) {
+        doc.setHtml(studio);
+        movie->addStudio(doc.toPlainText().trimmed());
+    }
+    if (data.hasActors) {
+        movie->setActors({});
+        for (const Actor& actor : data.actors) {
+            movie->addActor(actor);
+        }
+    }
+    if (!data.director.isEmpty()) {
+        movie->setDirector(data.director);
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(genre);
+    }
+    if (!data.overview.isEmpty()) {
+        doc.setHtml(data.overview);
         movie->setOverview(doc.toPlainText());
         if (Settings::instance()->usePlotForOutline()) {
             movie->setOutline(doc.toPlainText());
         }
     }
-
-    rx.setPattern("href=\"([^\"]*)\"[\\s\\n]*id=\"front-cover\"");
-    if (infos.contains(MovieScraperInfos::Poster) && rx.indexIn(html) != -1) {
-        Poster p;
-        p.thumbUrl = rx.cap(1);
-        p.originalUrl = rx.cap(1);
-        movie->images().addPoster(p);
+    for (const Poster& poster : data.posters) {
+        movie->images().addPoster(poster);
     }
-
-    rx.setPattern(R"(<a href="[^"]*"[\s\r\n]*Category="Item Page" Label="Series">[\s\r\n]*([^<]*)<span)");
-    if (infos.contains(MovieScraperInfos::Set) && rx.indexIn(html) != -1) {
-        doc.setHtml(rx.cap(1));
+    if (!data.set.isEmpty()) {
+        doc.setHtml(data.set);
         QString setName = doc.toPlainText().trimmed();
         if (setName.endsWith("Series", Qt::CaseInsensitive)) {
             setName.chop(6);
@@ -264,17 +338,8 @@ void AdultDvdEmpire::parseAndAssignInfos(QString html, Movie* movie, QSet<MovieS
         set.name = setName.trimmed();
         movie->setSet(set);
     }
-
-    if (infos.contains(MovieScraperInfos::Backdrop)) {
-        rx.setPattern(R"re(<a rel="(scene)?screenshots"[\s\n]*href="([^"]*)")re");
-        int offset = 0;
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            offset += rx.matchedLength();
-            Poster p;
-            p.thumbUrl = rx.cap(2);
-            p.originalUrl = rx.cap(2);
-            movie->images().addBackdrop(p);
-        }
+    for (const Poster& backdrop : data.backdrops) {
+        movie->images().addBackdrop(backdrop);
     }
 }
 
@@ -6,6 +6,7 @@
 
 #include "data/Storage.h"
 #include "globals/Manager.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "scrapers/movie/IMDB.h"
 #include "scrapers/movie/TMDb.h"
@@ -22,7 +23,7 @@ CustomMovieScraper::CustomMovieScraper(QObject* parent)
 
 QNetworkAccessManager* CustomMovieScraper::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 CustomMovieScraper* CustomMovieScraper::instance(QObject* parent)
@@ -39,7 +39,6 @@ private slots:
 
 private:
     QVector<MovieScraperInterface*> m_scrapers;
-    QNetworkAccessManager m_qnam;
 
     QVector<MovieScraperInterface*> scrapersForInfos(QSet<MovieScraperInfos> infos);
     ImageProviderInterface* imageProviderForInfo(int info);
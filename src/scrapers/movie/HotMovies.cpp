@@ -2,13 +2,16 @@
 
 #include "data/Storage.h"
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/HtmlPattern.h"
 #include "ui/main/MainWindow.h"
 
 #include <QDebug>
 #include <QGridLayout>
-#include <QRegExp>
+#include <QPointer>
 #include <QTextDocument>
 #include <QTextDocumentFragment>
 
@@ -70,7 +73,7 @@ QString HotMovies::defaultLanguageKey()
 
 QNetworkAccessManager* HotMovies::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 void HotMovies::search(QString searchStr)
@@ -101,22 +104,31 @@ void HotMovies::onSearchFinished()
     }
 
     const QString msg = QString::fromUtf8(reply->readAll());
-    emit searchDone(parseSearch(msg), {});
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg]() { return parseSearch(msg); },
+        [this](QVector<ScraperSearchResult> results) {
+            // QTextDocumentFragment is only used on the GUI thread.
+            for (ScraperSearchResult& result : results) {
+                result.name = QTextDocumentFragment::fromHtml(result.name).toPlainText().trimmed();
+            }
+            emit searchDone(results, {});
+        });
 }
 
-QVector<ScraperSearchResult> HotMovies::parseSearch(QString html)
+QVector<ScraperSearchResult> HotMovies::parseSearch(const QString& html)
 {
-    QVector<ScraperSearchResult> results;
-    int offset = 0;
+    static const mediaelch::scraper::HtmlPattern rx(
+        R"lit(<div class="cell td_title">.*<h3 class="title">.*<a href="([^"]*)" title="[^"]*">(.*)</a>)lit");
 
-    QRegExp rx(R"lit(<div class="cell td_title">.*<h3 class="title">.*<a href="([^"]*)" title="[^"]*">(.*)</a>)lit");
-    rx.setMinimal(true);
-    while ((offset = rx.indexIn(html, offset)) != -1) {
+    QVector<ScraperSearchResult> results;
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
         ScraperSearchResult result;
-        result.id = rx.cap(1);
-        result.name = QTextDocumentFragment::fromHtml(rx.cap(2)).toPlainText().trimmed();
+        result.id = match.captured(1);
+        result.name = match.captured(2);
         results << result;
-        offset += rx.matchedLength();
     }
 
     return results;
@@ -140,139 +152,175 @@ void HotMovies::onLoadFinished()
     auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
     Movie* movie = reply->property("storage").value<Storage*>()->movie();
     reply->deleteLater();
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, reply->property("infosToLoad").value<Storage*>()->movieInfosToLoad());
-
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error" << reply->errorString();
+        movie->controller()->scraperLoadDone(this);
+        return;
     }
-    movie->controller()->scraperLoadDone(this);
+
+    const QString msg = QString::fromUtf8(reply->readAll());
+    const QSet<MovieScraperInfos> infos = reply->property("infosToLoad").value<Storage*>()->movieInfosToLoad();
+    const QPointer<Movie> moviePtr(movie);
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg, infos]() { return parseInfos(msg, infos); },
+        [this, moviePtr](const ScrapedMovieData& data) {
+            if (moviePtr.isNull()) {
+                return;
+            }
+            assignInfos(data, moviePtr.data());
+            moviePtr->controller()->scraperLoadDone(this);
+        });
 }
 
-void HotMovies::parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos)
+ScrapedMovieData HotMovies::parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxTitle(R"(<h1 class="title" itemprop="name">(.*)</h1>)");
+    // Only the main like count has text after the thumbs-up-count
+    // In 2019, it contained a link (therefore `</a>`).
+    // As of 2020-04-05 this is not the case anymore.
+    static const HtmlPattern rxLikes(
+        R"(<span class="thumbs-up-count">(\d+)</span>(</a>)?<br /><span class="thumbs-up-text">)");
+    static const HtmlPattern rxReleased("<span itemprop=\"copyrightYear\">([0-9]{4})</span>");
+    static const HtmlPattern rxRuntime(R"(<span itemprop="duration" datetime="PT[^"]+">(.*)</span>)");
+    static const HtmlPattern rxOverview(R"(<span class="video_description" itemprop="description">(.*)</span>)");
+    static const HtmlPattern rxPoster(R"rx(<img itemprop="image" alt="[^"]*" id="cover"[\s\n]*[^>]*src="([^"]*)")rx");
+    static const HtmlPattern rxActor(
+        R"re(<div class="star_wrapper" key="([^"]*)"><img .*/><span itemprop="name">([^<]*)</span>)re");
+    static const HtmlPattern rxGenre("<span itemprop=\"genre\">.* -> (.*)</span>");
+    static const HtmlPattern rxStudio(
+        "<strong>Studio:</strong> <a itemprop=\"url\" href=\"[^\"]*\"[\\s\\n]*title=\"[^\"]*\"><span "
+        "itemprop=\"name\">(.*)</span></a>");
+    static const HtmlPattern rxDirector(
+        R"(<span itemprop="director" itemscope itemtype="http://schema.org/Person"><a itemprop="url" )"
+        R"(href="[^"]*"[\s\n]*title="[^"]*" rel="tag"><span itemprop="name">([^<]*)</span></a>)");
+    // Title may contain `"` which results in invalid HTML.
+    static const HtmlPattern rxSet(R"(<a href="https://www.hotmovies.com/series/[^"]*" title=".*" rel="tag">(.*)</a>)");
+
+    ScrapedMovieData data;
+    QRegularExpressionMatch match;
 
-    rx.setPattern(R"(<h1 class="title" itemprop="name">(.*)</h1>)");
-    if (infos.contains(MovieScraperInfos::Title) && rx.indexIn(html) != -1) {
-        movie->setName(rx.cap(1));
+    if (infos.contains(MovieScraperInfos::Title) && rxTitle.find(html, match)) {
+        data.title = match.captured(1);
     }
 
     // Rating currently not available; HotMovies has switched to likes
-    // rx.setPattern("<meta itemprop=\"ratingValue\" content=\"(.*)\">");
-    // if (infos.contains(MovieScraperInfos::Rating) && rx.indexIn(html) != -1) {
-    //     movie->setRating(rx.cap(1).toDouble());
-    // }
-
-    // Only the main like count has text after the thumbs-up-count
-    // In 2019, it contained a link (therefore `</a>`).
-    // As of 2020-04-05 this is not the case anymore.
-    rx.setPattern(R"(<span class="thumbs-up-count">(\d+)</span>(</a>)?<br /><span class="thumbs-up-text">)");
-    if (infos.contains(MovieScraperInfos::Rating) && rx.indexIn(html) != -1) {
-        Rating rating;
-        rating.voteCount = rx.cap(1).toInt();
-        rating.source = "HotMovies";
-        movie->ratings().push_back(rating);
+    if (infos.contains(MovieScraperInfos::Rating) && rxLikes.find(html, match)) {
+        data.hasRating = true;
+        data.rating.voteCount = match.captured(1).toInt();
+        data.rating.source = "HotMovies";
     }
 
-    rx.setPattern("<span itemprop=\"copyrightYear\">([0-9]{4})</span>");
-    if (infos.contains(MovieScraperInfos::Released) && rx.indexIn(html) != -1) {
-        movie->setReleased(QDate::fromString(rx.cap(1), "yyyy"));
+    if (infos.contains(MovieScraperInfos::Released) && rxReleased.find(html, match)) {
+        data.released = QDate::fromString(match.captured(1), "yyyy");
     }
 
-    rx.setPattern(R"(<span itemprop="duration" datetime="PT[^"]+">(.*)</span>)");
-    if (infos.contains(MovieScraperInfos::Runtime) && rx.indexIn(html) != -1) {
-        using namespace std::chrono;
-        QStringList runtimeStr = rx.cap(1).split(":");
+    if (infos.contains(MovieScraperInfos::Runtime) && rxRuntime.find(html, match)) {
+        QStringList runtimeStr = match.captured(1).split(":");
         if (runtimeStr.count() == 3) {
-            minutes runtime = hours(runtimeStr.at(0).toInt()) + minutes(runtimeStr.at(1).toInt());
-            movie->setRuntime(runtime);
+            data.runtime = runtimeStr.at(0).toInt() * 60 + runtimeStr.at(1).toInt();
 
         } else if (runtimeStr.count() == 2) {
-            minutes runtime = minutes(runtimeStr.at(0).toInt());
-            movie->setRuntime(runtime);
+            data.runtime = runtimeStr.at(0).toInt();
         }
     }
 
-    rx.setPattern(R"(<span class="video_description" itemprop="description">(.*)</span>)");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
-        QTextDocument doc;
-        doc.setHtml(rx.cap(1));
-        movie->setOverview(doc.toPlainText().trimmed());
-
-        if (Settings::instance()->usePlotForOutline()) {
-            movie->setOutline(movie->overview());
-        }
+    // HTML; converted by assignInfos()
+    if (infos.contains(MovieScraperInfos::Overview) && rxOverview.find(html, match)) {
+        data.overview = match.captured(1);
     }
 
-    rx.setPattern(R"rx(<img itemprop="image" alt="[^"]*" id="cover"[\s\n]*[^>]*src="([^"]*)")rx");
-    if (infos.contains(MovieScraperInfos::Poster) && rx.indexIn(html) != -1) {
+    if (infos.contains(MovieScraperInfos::Poster) && rxPoster.find(html, match)) {
         Poster p;
-        p.thumbUrl = rx.cap(1);
-        p.originalUrl = rx.cap(1);
-        movie->images().addPoster(p);
+        p.thumbUrl = match.captured(1);
+        p.originalUrl = match.captured(1);
+        data.posters.append(p);
     }
 
     if (infos.contains(MovieScraperInfos::Actors)) {
-        // clear actors
-        movie->setActors({});
-        //        rx.setPattern("key=\"([^\"]*)\"/> <img
-        //        src=\"https://img[0-9]+.vod.com/image[0-9]?/vodimages/images/spacer.gif\" class=\"lg_star_image\"
-        //        itemprop=\"image\" alt\"\" /> </span><a href=\"[^\"]*\".*[\\s\\n]*title=\"[^\"]*\" rel=\"tag\"
-        //        itemprop=\"url\"><span itemprop=\"name\">(.*)<\/span></a>");
-        //                      "title=\"[^\"]*\" rel=\"tag\" itemprop=\"actor\" itemscope
-        //                      itemtype=\"https://schema.org/Person\"><span itemprop=\"name\">(.*)</span></a>");
-
-        //        rx.setPattern("<div class=\"star_wrapper\" key=\"(.*)\"><a href=\".*\" .* title=\".*\" rel=\"tag\"
-        //        itemprop=\"url\"><span itemprop=\"name\">(.*)</span></a></div>");
-        rx.setPattern(R"re(<div class="star_wrapper" key="([^"]*)"><img .*/><span itemprop="name">([^<]*)</span>)re");
-        rx.setMinimal(true);
-        int offset = 0;
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            offset += rx.matchedLength();
+        data.hasActors = true;
+        QRegularExpressionMatchIterator it = rxActor.globalMatch(html);
+        while (it.hasNext()) {
+            match = it.next();
             Actor a;
-            a.name = rx.cap(2);
-            const auto pictureUrl = rx.cap(1);
+            a.name = match.captured(2);
+            const auto pictureUrl = match.captured(1);
             if (!pictureUrl.endsWith("missing_f.gif") && !pictureUrl.endsWith("missing_m.gif")) {
                 a.thumb = pictureUrl;
             }
-            movie->addActor(a);
+            data.actors.append(a);
         }
     }
 
     if (infos.contains(MovieScraperInfos::Genres)) {
-        rx.setPattern("<span itemprop=\"genre\">.* -> (.*)</span>");
-        int offset = 0;
-        while ((offset = rx.indexIn(html, offset)) != -1) {
-            offset += rx.matchedLength();
+        for (const QString& genre : rxGenre.captureAll(html)) {
             // Some "genres" are just some categories of HotMovies
-            const auto genre = rx.cap(1);
             if (genre != "Streaming Video" && genre != "Downloads") {
-                movie->addGenre(genre);
+                data.genres << genre;
             }
         }
     }
 
-    rx.setPattern("<strong>Studio:</strong> <a itemprop=\"url\" href=\"[^\"]*\"[\\s\\n]*title=\"[^\"]*\"><span "
-                  "itemprop=\"name\">(.*)</span></a>");
-    if (infos.contains(MovieScraperInfos::Studios) && rx.indexIn(html) != -1) {
-        movie->addStudio(rx.cap(1));
+    if (infos.contains(MovieScraperInfos::Studios) && rxStudio.find(html, match)) {
+        data.studios << match.captured(1);
     }
 
-    rx.setPattern(R"(<span itemprop="director" itemscope itemtype="http://schema.org/Person"><a itemprop="url" )"
-                  R"(href="[^"]*"[\s\n]*title="[^"]*" rel="tag"><span itemprop="name">([^<]*)</span></a>)");
-    if (infos.contains(MovieScraperInfos::Director) && rx.indexIn(html) != -1) {
-        movie->setDirector(rx.cap(1));
+    if (infos.contains(MovieScraperInfos::Director) && rxDirector.find(html, match)) {
+        data.director = match.captured(1);
     }
 
-    // Title may contain `"` which results in invalid HTML.
-    rx.setPattern(R"(<a href="https://www.hotmovies.com/series/[^"]*" title=".*" rel="tag">(.*)</a>)");
-    if (infos.contains(MovieScraperInfos::Set) && rx.indexIn(html) != -1) {
+    if (infos.contains(MovieScraperInfos::Set) && rxSet.find(html, match)) {
+        data.set = match.captured(1);
+    }
+
+    return data;
+}
+
+void HotMovies::assignInfos(const ScrapedMovieData& data, Movie* movie)
+{
+    if (!data.title.isEmpty()) {
+        movie->setName(data.title);
+    }
+    if (data.hasRating) {
+        movie->ratings().push_back(data.rating);
+    }
+    if (data.released.isValid()) {
+        movie->setReleased(data.released);
+    }
+    if (data.runtime > -1) {
+        movie->setRuntime(std::chrono::minutes(data.runtime));
+    }
+    if (!data.overview.isEmpty()) {
+        QTextDocument doc;
+        doc.setHtml(data.overview);
+        movie->setOverview(doc.toPlainText().trimmed());
+        if (Settings::instance()->usePlotForOutline()) {
+            movie->setOutline(movie->overview());
+        }
+    }
+    for (const Poster& poster : data.posters) {
+        movie->images().addPoster(poster);
+    }
+    if (data.hasActors) {
+        movie->setActors({});
+        for (const Actor& actor : data.actors) {
+            movie->addActor(actor);
+        }
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(genre);
+    }
+    for (const QString& studio : data.studios) {
+        movie->addStudio(studio);
+    }
+    if (!data.director.isEmpty()) {
+        movie->setDirector(data.director);
+    }
+    if (!data.set.isEmpty()) {
         MovieSet set;
-        set.name = rx.cap(1);
+        set.name = data.set;
         movie->setSet(set);
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scrapers/movie/MovieScraperInterface.h"
+#include "scrapers/movie/ScrapedMovieData.h"
 
 #include <QComboBox>
 #include <QNetworkAccessManager>
@@ -29,15 +30,19 @@ public:
     QWidget* settingsWidget() override;
     bool isAdult() const override;
 
+    /// \brief Extracts the results of a search page. Thread-safe.
+    /// Result names are still HTML encoded.
+    static QVector<ScraperSearchResult> parseSearch(const QString& html);
+
 private slots:
     void onSearchFinished();
     void onLoadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QSet<MovieScraperInfos> m_scraperSupports;
 
     QNetworkAccessManager* qnam();
-    QVector<ScraperSearchResult> parseSearch(QString html);
-    void parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos);
+    /// \brief Extracts the infos of a movie's page. Thread-safe.
+    static ScrapedMovieData parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos);
+    void assignInfos(const ScrapedMovieData& data, Movie* movie);
 };
@@ -8,6 +8,9 @@
 #include "globals/Helper.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/HtmlPattern.h"
+#include "scrapers/imdb/ImdbRequestQueue.h"
 #include "scrapers/movie/imdb/ImdbMovieScraper.h"
 #include "settings/Settings.h"
 #include "ui/main/MainWindow.h"
@@ -71,6 +74,11 @@ void IMDB::loadSettings(ScraperSettings& settings)
     m_loadAllTagsWidget->setChecked(m_loadAllTags);
 }
 
+bool IMDB::loadsAllTags() const
+{
+    return m_loadAllTags;
+}
+
 void IMDB::saveSettings(ScraperSettings& settings)
 {
     m_loadAllTags = m_loadAllTagsWidget->isChecked();
@@ -106,23 +114,25 @@ void IMDB::search(QString searchStr)
 {
     QString encodedSearch = QUrl::toPercentEncoding(searchStr);
 
-    QRegExp rx("^tt\\d+$");
-    if (rx.exactMatch(searchStr)) {
+    static const QRegularExpression rxImdbId("^tt\\d+$");
+    if (rxImdbId.match(searchStr).hasMatch()) {
         QUrl url = QUrl(QStringLiteral("https://www.imdb.com/title/%1/").arg(searchStr).toUtf8());
         QNetworkRequest request(url);
         request.setRawHeader("Accept-Language", "en"); // todo: add language dropdown in settings
-        QNetworkReply* reply = m_qnam.get(request);
-        new NetworkReplyWatcher(this, reply);
-        connect(reply, &QNetworkReply::finished, this, &IMDB::onSearchIdFinished);
+        mediaelch::imdb::requestQueue().get(request, this, [this](QNetworkReply* reply) {
+            new NetworkReplyWatcher(this, reply);
+            connect(reply, &QNetworkReply::finished, this, &IMDB::onSearchIdFinished);
+        });
 
     } else {
         QUrl url = QUrl::fromEncoded(
             QStringLiteral("https://www.imdb.com/find?s=tt&ttype=ft&ref_=fn_ft&q=%1").arg(encodedSearch).toUtf8());
         QNetworkRequest request(url);
         request.setRawHeader("Accept-Language", "en"); // todo: add language dropdown in settings
-        QNetworkReply* reply = m_qnam.get(request);
-        new NetworkReplyWatcher(this, reply);
-        connect(reply, &QNetworkReply::finished, this, &IMDB::onSearchFinished);
+        mediaelch::imdb::requestQueue().get(request, this, [this](QNetworkReply* reply) {
+            new NetworkReplyWatcher(this, reply);
+            connect(reply, &QNetworkReply::finished, this, &IMDB::onSearchFinished);
+        });
     }
 }
 
@@ -142,76 +152,82 @@ void IMDB::onSearchFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
-    auto results = parseSearch(msg);
-    emit searchDone(results, {});
+    const QString msg = QString::fromUtf8(reply->readAll());
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg]() { return parseSearch(msg); },
+        [this](QVector<ScraperSearchResult> results) { emit searchDone(results, {}); });
 }
 
 void IMDB::onSearchIdFinished()
 {
     auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    QVector<ScraperSearchResult> results;
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        ScraperSearchResult result;
+    reply->deleteLater();
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "Network Error" << reply->errorString();
+        emit searchDone({}, {});
+        return;
+    }
 
-        QRegExp rx;
-        rx.setMinimal(true);
-        rx.setPattern(R"(<h1 class="header"> <span class="itemprop" itemprop="name">(.*)</span>)");
-        if (rx.indexIn(msg) != -1) {
-            result.name = rx.cap(1);
-
-            rx.setPattern("<h1 class=\"header\"> <span class=\"itemprop\" itemprop=\"name\">.*<span "
-                          "class=\"nobr\">\\(<a href=\"[^\"]*\" >([0-9]*)</a>\\)</span>");
-            if (rx.indexIn(msg) != -1) {
-                result.released = QDate::fromString(rx.cap(1), "yyyy");
-
-            } else {
-                rx.setPattern("<h1 class=\"header\"> <span class=\"itemprop\" itemprop=\"name\">.*</span>.*<span "
-                              "class=\"nobr\">\\(([0-9]*)\\)</span>");
-                if (rx.indexIn(msg) != -1) {
-                    result.released = QDate::fromString(rx.cap(1), "yyyy");
-                }
-            }
-        } else {
-            rx.setPattern(R"(<h1 class="">(.*)&nbsp;<span id="titleYear">\(<a href="/year/([0-9]+)/\?ref_=tt_ov_inf")");
-            if (rx.indexIn(msg) != -1) {
-                result.name = rx.cap(1);
-                result.released = QDate::fromString(rx.cap(2), "yyyy");
-            }
-        }
+    const QString msg = QString::fromUtf8(reply->readAll());
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg]() { return parseIdSearch(msg); },
+        [this](QVector<ScraperSearchResult> results) { emit searchDone(results, {}); });
+}
 
-        rx.setPattern(R"(<link rel="canonical" href="https://www.imdb.com/title/(.*)/" />)");
-        if (rx.indexIn(msg) != -1) {
-            result.id = rx.cap(1);
+QVector<ScraperSearchResult> IMDB::parseIdSearch(const QString& html)
+{
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxName(R"(<h1 class="header"> <span class="itemprop" itemprop="name">(.*)</span>)");
+    static const HtmlPattern rxYearLink("<h1 class=\"header\"> <span class=\"itemprop\" itemprop=\"name\">.*<span "
+                                        "class=\"nobr\">\\(<a href=\"[^\"]*\" >([0-9]*)</a>\\)</span>");
+    static const HtmlPattern rxYear("<h1 class=\"header\"> <span class=\"itemprop\" itemprop=\"name\">.*</span>.*<span "
+                                    "class=\"nobr\">\\(([0-9]*)\\)</span>");
+    static const HtmlPattern rxTitleYear(
+        R"(<h1 class="">(.*)&nbsp;<span id="titleYear">\(<a href="/year/([0-9]+)/\?ref_=tt_ov_inf")");
+    static const HtmlPattern rxId(R"(<link rel="canonical" href="https://www.imdb.com/title/(.*)/" />)");
+
+    ScraperSearchResult result;
+    QRegularExpressionMatch match;
+
+    if (rxName.find(html, match)) {
+        result.name = match.captured(1);
+
+        if (rxYearLink.find(html, match) || rxYear.find(html, match)) {
+            result.released = QDate::fromString(match.captured(1), "yyyy");
         }
+    } else if (rxTitleYear.find(html, match)) {
+        result.name = match.captured(1);
+        result.released = QDate::fromString(match.captured(2), "yyyy");
+    }
 
-        if ((!result.id.isEmpty()) && (!result.name.isEmpty())) {
-            results.append(result);
-        }
-    } else {
-        qWarning() << "Network Error" << reply->errorString();
+    if (rxId.find(html, match)) {
+        result.id = match.captured(1);
     }
 
-    reply->deleteLater();
-    emit searchDone(results, {});
+    QVector<ScraperSearchResult> results;
+    if ((!result.id.isEmpty()) && (!result.name.isEmpty())) {
+        results.append(result);
+    }
+    return results;
 }
 
-QVector<ScraperSearchResult> IMDB::parseSearch(QString html)
+QVector<ScraperSearchResult> IMDB::parseSearch(const QString& html)
 {
-    QVector<ScraperSearchResult> results;
+    static const mediaelch::scraper::HtmlPattern rx(
+        "<td class=\"result_text\"> <a href=\"/title/([t]*[\\d]+)/[^\"]*\" >([^<]*)</a>(?: \\(I+\\) | "
+        ")\\(([0-9]*)\\) (?:</td>|<br/>)");
 
-    QRegExp rx("<td class=\"result_text\"> <a href=\"/title/([t]*[\\d]+)/[^\"]*\" >([^<]*)</a>(?: \\(I+\\) | "
-               ")\\(([0-9]*)\\) (?:</td>|<br/>)");
-    rx.setMinimal(true);
-    int pos = 0;
-    while ((pos = rx.indexIn(html, pos)) != -1) {
+    QVector<ScraperSearchResult> results;
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
         ScraperSearchResult result;
-        result.name = rx.cap(2);
-        result.id = rx.cap(1);
-        result.released = QDate::fromString(rx.cap(3), "yyyy");
+        result.name = match.captured(2);
+        result.id = match.captured(1);
+        result.released = QDate::fromString(match.captured(3), "yyyy");
         results.append(result);
-        pos += rx.matchedLength();
     }
     return results;
 }
@@ -233,269 +249,283 @@ void IMDB::onLoadDone(Movie& movie, ImdbMovieLoader* loader)
     movie.controller()->scraperLoadDone(this);
 }
 
-void IMDB::parseAndAssignInfos(const QString& html, Movie* movie, QSet<MovieScraperInfos> infos)
+ScrapedMovieData IMDB::parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos, bool loadAllTags)
 {
     using namespace std::chrono;
-
-    QRegExp rx;
-    rx.setMinimal(true);
+    using mediaelch::scraper::HtmlPattern;
+    using mediaelch::scraper::removeHtmlTags;
+
+    static const HtmlPattern rxTitle(R"(<h1 class="[^"]*">([^<]*)&nbsp;)");
+    static const HtmlPattern rxTitleWithYear(R"(<h1 itemprop="name" class="">(.*)&nbsp;<span id="titleYear">)");
+    static const HtmlPattern rxOriginalTitle(R"(<div class="originalTitle">([^<]*)<span)");
+    static const HtmlPattern rxDirectors(
+        R"(<div class="txt-block" itemprop="director" itemscope itemtype="http://schema.org/Person">(.*)</div>)");
+    // the ghost span may only exist if there are more than 2 directors
+    static const HtmlPattern rxDirectorsSummary(
+        R"(<div class="credit_summary_item">\n +<h4 class="inline">Directors?:</h4>)"
+        R"((.*)(?:<span class="ghost">|</div>))");
+    static const HtmlPattern rxWriters(
+        R"(<div class="txt-block" itemprop="creator" itemscope itemtype="http://schema.org/Person">(.*)</div>)");
+    // the ghost span may only exist if there are more than 2 writers
+    static const HtmlPattern rxWritersSummary(
+        R"(<div class="credit_summary_item">\n +<h4 class="inline">Writers?:</h4>)"
+        R"((.*)(?:<span class="ghost">|</div>))");
+    static const HtmlPattern rxLink(R"(<a href="[^"]*"[^>]*>([^<]*)</a>)");
+    static const HtmlPattern rxGenres(
+        R"(<div class="see-more inline canwrap">\n *<h4 class="inline">Genres:</h4>(.*)</div>)");
+    static const HtmlPattern rxTagline(R"(<div class="txt-block">[^<]*<h4 class="inline">Taglines:</h4>(.*)</div>)");
+    static const HtmlPattern rxSeeMore("<span class=\"see-more inline\">.*</span>");
+    static const HtmlPattern rxTags(
+        R"(<div class="see-more inline canwrap">\n *<h4 class="inline">Plot Keywords:</h4>(.*)<nobr>)");
+    static const HtmlPattern rxTag(R"(<span class="itemprop">([^<]*)</span>)");
+    static const HtmlPattern rxReleased(
+        "<a href=\"[^\"]*\"(.*)title=\"See all release dates\" >[^<]*<meta itemprop=\"datePublished\" "
+        "content=\"([^\"]*)\" />");
+    static const HtmlPattern rxReleaseDate(R"(<h4 class="inline">Release Date:</h4> ([0-9]+) ([A-z]*) ([0-9]{4}))");
+    static const HtmlPattern rxCertification(R"rx("contentRating": "([^"]*)",)rx");
+    static const HtmlPattern rxDuration(R"("duration": "PT([0-9]+)H?([0-9]+)M")");
+    static const HtmlPattern rxRuntime(R"(<h4 class="inline">Runtime:</h4>[^<]*<time datetime="PT([0-9]+)M">)");
+    static const HtmlPattern rxDescription("<p itemprop=\"description\">(.*)</p>");
+    static const HtmlPattern rxSummary(R"(<div class="summary_text">(.*)</div>)");
+    static const HtmlPattern rxStoryline(
+        R"(<h2>Storyline</h2>\n +\n +<div class="inline canwrap">\n +<p>\n +<span>(.*)</span>)");
+    static const HtmlPattern rxStarBox(
+        "<div class=\"star-box-details\" itemtype=\"http://schema.org/AggregateRating\" itemscope "
+        "itemprop=\"aggregateRating\">(.*)</div>");
+    static const HtmlPattern rxRatingValue("<span itemprop=\"ratingValue\">(.*)</span>");
+    static const HtmlPattern rxRatingCount("<span itemprop=\"ratingCount\">(.*)</span>");
+    static const HtmlPattern rxImdbRating(R"(<div class="imdbRating"[^>]*>\n +<div class="ratingValue">(.*)</div>)");
+    static const HtmlPattern rxRatingEnglish("([0-9]\\.[0-9]) based on ([0-9\\,]*) ");
+    static const HtmlPattern rxRatingGerman("([0-9]\\,[0-9]) based on ([0-9\\.]*) ");
+    static const HtmlPattern rxTop250Movies("Top Rated Movies #([0-9]+)\\n</a>");
+    static const HtmlPattern rxTop250Shows("Top Rated TV #([0-9]+)\\n</a>");
+    static const HtmlPattern rxStudios(R"(<h4 class="inline">Production Co:</h4>(.*)<span class="see-more inline">)");
+    static const HtmlPattern rxStudio(R"(<a href="/company/[^"]*"[^>]*>([^<]+)</a>)");
+    static const HtmlPattern rxCountries(R"(<h4 class="inline">Country:</h4>(.*)</div>)");
+
+    ScrapedMovieData data;
+    QRegularExpressionMatch match;
 
     if (infos.contains(MovieScraperInfos::Title)) {
-        rx.setPattern(R"(<h1 class="[^"]*">([^<]*)&nbsp;)");
-        if (rx.indexIn(html) != -1) {
-            movie->setName(rx.cap(1));
+        if (rxTitle.find(html, match)) {
+            data.title = match.captured(1);
         }
-        rx.setPattern(R"(<h1 itemprop="name" class="">(.*)&nbsp;<span id="titleYear">)");
-        if (rx.indexIn(html) != -1) {
-            movie->setName(rx.cap(1));
+        if (rxTitleWithYear.find(html, match)) {
+            data.title = match.captured(1);
         }
-        rx.setPattern(R"(<div class="originalTitle">([^<]*)<span)");
-        if (rx.indexIn(html) != -1) {
-            movie->setOriginalName(rx.cap(1));
+        if (rxOriginalTitle.find(html, match)) {
+            data.originalTitle = match.captured(1);
         }
     }
 
     if (infos.contains(MovieScraperInfos::Director)) {
-        rx.setPattern(
-            R"(<div class="txt-block" itemprop="director" itemscope itemtype="http://schema.org/Person">(.*)</div>)");
         QString directorsBlock;
-        if (rx.indexIn(html) != -1) {
-            directorsBlock = rx.cap(1);
-        } else {
-            // the ghost span may only exist if there are more than 2 directors
-            rx.setPattern(
-                R"(<div class="credit_summary_item">\n +<h4 class="inline">Directors?:</h4>(.*)(?:<span class="ghost">|</div>))");
-            if (rx.indexIn(html) != -1) {
-                directorsBlock = rx.cap(1);
-            }
+        if (rxDirectors.find(html, match) || rxDirectorsSummary.find(html, match)) {
+            directorsBlock = match.captured(1);
         }
 
         if (!directorsBlock.isEmpty()) {
-            QStringList directors;
-            rx.setPattern(R"(<a href="[^"]*"[^>]*>([^<]*)</a>)");
-            int pos = 0;
-            while ((pos = rx.indexIn(directorsBlock, pos)) != -1) {
-                directors << rx.cap(1);
-                pos += rx.matchedLength();
-            }
-            movie->setDirector(directors.join(", "));
+            data.director = rxLink.captureAll(directorsBlock).join(", ");
         }
     }
 
     if (infos.contains(MovieScraperInfos::Writer)) {
-        rx.setPattern(
-            R"(<div class="txt-block" itemprop="creator" itemscope itemtype="http://schema.org/Person">(.*)</div>)");
         QString writersBlock;
-        if (rx.indexIn(html) != -1) {
-            writersBlock = rx.cap(1);
-        } else {
-            // the ghost span may only exist if there are more than 2 writers
-            rx.setPattern(
-                R"(<div class="credit_summary_item">\n +<h4 class="inline">Writers?:</h4>(.*)(?:<span class="ghost">|</div>))");
-            if (rx.indexIn(html) != -1) {
-                writersBlock = rx.cap(1);
-            }
+        if (rxWriters.find(html, match) || rxWritersSummary.find(html, match)) {
+            writersBlock = match.captured(1);
         }
 
         if (!writersBlock.isEmpty()) {
-            QStringList writers;
-            rx.setPattern(R"(<a href="[^"]*"[^>]*>([^<]*)</a>)");
-            int pos = 0;
-            while ((pos = rx.indexIn(writersBlock, pos)) != -1) {
-                writers << rx.cap(1);
-                pos += rx.matchedLength();
-            }
-            movie->setWriter(writers.join(", "));
+            data.writer = rxLink.captureAll(writersBlock).join(", ");
         }
     }
 
-    rx.setPattern(R"(<div class="see-more inline canwrap">\n *<h4 class="inline">Genres:</h4>(.*)</div>)");
-    if (infos.contains(MovieScraperInfos::Genres) && rx.indexIn(html) != -1) {
-        QString genres = rx.cap(1);
-        rx.setPattern(R"(<a href="[^"]*"[^>]*>([^<]*)</a>)");
-        int pos = 0;
-        while ((pos = rx.indexIn(genres, pos)) != -1) {
-            movie->addGenre(helper::mapGenre(rx.cap(1).trimmed()));
-            pos += rx.matchedLength();
+    if (infos.contains(MovieScraperInfos::Genres) && rxGenres.find(html, match)) {
+        for (const QString& genre : rxLink.captureAll(match.captured(1))) {
+            data.genres << genre.trimmed();
         }
     }
 
-    rx.setPattern(R"(<div class="txt-block">[^<]*<h4 class="inline">Taglines:</h4>(.*)</div>)");
-    if (infos.contains(MovieScraperInfos::Tagline) && rx.indexIn(html) != -1) {
-        QString tagline = rx.cap(1);
-        QRegExp rxMore("<span class=\"see-more inline\">.*</span>");
-        rxMore.setMinimal(true);
-        tagline.remove(rxMore);
-        movie->setTagline(tagline.trimmed());
+    if (infos.contains(MovieScraperInfos::Tagline) && rxTagline.find(html, match)) {
+        data.tagline = rxSeeMore.replaced(match.captured(1)).trimmed();
     }
 
-    rx.setPattern(R"(<div class="see-more inline canwrap">\n *<h4 class="inline">Plot Keywords:</h4>(.*)<nobr>)");
-    if (!m_loadAllTags && infos.contains(MovieScraperInfos::Tags) && rx.indexIn(html) != -1) {
-        QString tags = rx.cap(1);
-        rx.setPattern(R"(<span class="itemprop">([^<]*)</span>)");
-        int pos = 0;
-        while ((pos = rx.indexIn(tags, pos)) != -1) {
-            movie->addTag(rx.cap(1).trimmed());
-            pos += rx.matchedLength();
+    if (!loadAllTags && infos.contains(MovieScraperInfos::Tags) && rxTags.find(html, match)) {
+        for (const QString& tag : rxTag.captureAll(match.captured(1))) {
+            data.tags << tag.trimmed();
         }
     }
 
     if (infos.contains(MovieScraperInfos::Released)) {
-        rx.setPattern("<a href=\"[^\"]*\"(.*)title=\"See all release dates\" >[^<]*<meta itemprop=\"datePublished\" "
-                      "content=\"([^\"]*)\" />");
-        if (rx.indexIn(html) != -1) {
-            movie->setReleased(QDate::fromString(rx.cap(2), "yyyy-MM-dd"));
+        if (rxReleased.find(html, match)) {
+            data.released = QDate::fromString(match.captured(2), "yyyy-MM-dd");
+
+        } else if (rxReleaseDate.find(html, match)) {
+            int day = match.captured(1).trimmed().toInt();
+            int month = -1;
+            QString monthName = match.captured(2).trimmed();
+            int year = match.captured(3).trimmed().toInt();
+            if (monthName.contains("January", Qt::CaseInsensitive)) {
+                month = 1;
+            } else if (monthName.contains("February", Qt::CaseInsensitive)) {
+                month = 2;
+            } else if (monthName.contains("March", Qt::CaseInsensitive)) {
+                month = 3;
+            } else if (monthName.contains("April", Qt::CaseInsensitive)) {
+                month = 4;
+            } else if (monthName.contains("May", Qt::CaseInsensitive)) {
+                month = 5;
+            } else if (monthName.contains("June", Qt::CaseInsensitive)) {
+                month = 6;
+            } else if (monthName.contains("July", Qt::CaseInsensitive)) {
+                month = 7;
+            } else if (monthName.contains("August", Qt::CaseInsensitive)) {
+                month = 8;
+            } else if (monthName.contains("September", Qt::CaseInsensitive)) {
+                month = 9;
+            } else if (monthName.contains("October", Qt::CaseInsensitive)) {
+                month = 10;
+            } else if (monthName.contains("November", Qt::CaseInsensitive)) {
+                month = 11;
+            } else if (monthName.contains("December", Qt::CaseInsensitive)) {
+                month = 12;
+            }
 
-        } else {
-            rx.setPattern(R"(<h4 class="inline">Release Date:</h4> ([0-9]+) ([A-z]*) ([0-9]{4}))");
-            if (rx.indexIn(html) != -1) {
-                int day = rx.cap(1).trimmed().toInt();
-                int month = -1;
-                QString monthName = rx.cap(2).trimmed();
-                int year = rx.cap(3).trimmed().toInt();
-                if (monthName.contains("January", Qt::CaseInsensitive)) {
-                    month = 1;
-                } else if (monthName.contains("February", Qt::CaseInsensitive)) {
-                    month = 2;
-                } else if (monthName.contains("March", Qt::CaseInsensitive)) {
-                    month = 3;
-                } else if (monthName.contains("April", Qt::CaseInsensitive)) {
-                    month = 4;
-                } else if (monthName.contains("May", Qt::CaseInsensitive)) {
-                    month = 5;
-                } else if (monthName.contains("June", Qt::CaseInsensitive)) {
-                    month = 6;
-                } else if (monthName.contains("July", Qt::CaseInsensitive)) {
-                    month = 7;
-                } else if (monthName.contains("August", Qt::CaseInsensitive)) {
-                    month = 8;
-                } else if (monthName.contains("September", Qt::CaseInsensitive)) {
-                    month = 9;
-                } else if (monthName.contains("October", Qt::CaseInsensitive)) {
-                    month = 10;
-                } else if (monthName.contains("November", Qt::CaseInsensitive)) {
-                    month = 11;
-                } else if (monthName.contains("December", Qt::CaseInsensitive)) {
-                    month = 12;
-                }
-
-                if (day != 0 && month != -1 && year != 0) {
-                    movie->setReleased(QDate(year, month, day));
-                }
+            if (day != 0 && month != -1 && year != 0) {
+                data.released = QDate(year, month, day);
             }
         }
     }
 
-
-    rx.setPattern(R"rx("contentRating": "([^"]*)",)rx");
-    if (infos.contains(MovieScraperInfos::Certification) && rx.indexIn(html) != -1) {
-        movie->setCertification(helper::mapCertification(Certification(rx.cap(1))));
+    if (infos.contains(MovieScraperInfos::Certification) && rxCertification.find(html, match)) {
+        data.certification = Certification(match.captured(1));
     }
 
-    rx.setPattern(R"("duration": "PT([0-9]+)H?([0-9]+)M")");
-    if (infos.contains(MovieScraperInfos::Runtime) && rx.indexIn(html) != -1) {
-        if (rx.captureCount() > 1) {
-            minutes runtime = hours(rx.cap(1).toInt()) + minutes(rx.cap(2).toInt());
-            movie->setRuntime(runtime);
+    if (infos.contains(MovieScraperInfos::Runtime) && rxDuration.find(html, match)) {
+        if (rxDuration.regex().captureCount() > 1) {
+            const minutes runtime = hours(match.captured(1).toInt()) + minutes(match.captured(2).toInt());
+            data.runtime = static_cast<int>(runtime.count());
         } else {
-            minutes runtime = minutes(rx.cap(1).toInt());
-            movie->setRuntime(runtime);
+            data.runtime = match.captured(1).toInt();
         }
     }
 
-    rx.setPattern(R"(<h4 class="inline">Runtime:</h4>[^<]*<time datetime="PT([0-9]+)M">)");
-    if (infos.contains(MovieScraperInfos::Runtime) && rx.indexIn(html) != -1) {
-        movie->setRuntime(minutes(rx.cap(1).toInt()));
+    if (infos.contains(MovieScraperInfos::Runtime) && rxRuntime.find(html, match)) {
+        data.runtime = match.captured(1).toInt();
     }
 
-    rx.setPattern("<p itemprop=\"description\">(.*)</p>");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
-        QString outline = rx.cap(1).remove(QRegExp("<[^>]*>"));
-        outline = outline.remove("See full summary&nbsp;&raquo;").trimmed();
-        movie->setOutline(outline);
+    if (infos.contains(MovieScraperInfos::Overview) && rxDescription.find(html, match)) {
+        QString outline = removeHtmlTags(match.captured(1));
+        data.outline = outline.remove("See full summary&nbsp;&raquo;").trimmed();
     }
 
-    rx.setPattern(R"(<div class="summary_text">(.*)</div>)");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
-        QString outline = rx.cap(1).remove(QRegExp("<[^>]*>"));
-        outline = outline.remove("See full summary&nbsp;&raquo;").trimmed();
-        movie->setOutline(outline);
+    if (infos.contains(MovieScraperInfos::Overview) && rxSummary.find(html, match)) {
+        QString outline = removeHtmlTags(match.captured(1));
+        data.outline = outline.remove("See full summary&nbsp;&raquo;").trimmed();
     }
 
-    rx.setPattern(R"(<h2>Storyline</h2>\n +\n +<div class="inline canwrap">\n +<p>\n +<span>(.*)</span>)");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
-        QString overview = rx.cap(1).trimmed();
-        overview.remove(QRegExp("<[^>]*>"));
-        movie->setOverview(overview.trimmed());
+    if (infos.contains(MovieScraperInfos::Overview) && rxStoryline.find(html, match)) {
+        data.overview = removeHtmlTags(match.captured(1).trimmed()).trimmed();
     }
 
     if (infos.contains(MovieScraperInfos::Rating)) {
-        Rating rating;
+        data.hasRating = true;
+        Rating& rating = data.rating;
         rating.source = "imdb";
         rating.maxRating = 10;
-        rx.setPattern("<div class=\"star-box-details\" itemtype=\"http://schema.org/AggregateRating\" itemscope "
-                      "itemprop=\"aggregateRating\">(.*)</div>");
-        if (rx.indexIn(html) != -1) {
-            QString content = rx.cap(1);
-            rx.setPattern("<span itemprop=\"ratingValue\">(.*)</span>");
-            if (rx.indexIn(content) != -1) {
-                rating.rating = rx.cap(1).trimmed().replace(",", ".").toDouble();
+        if (rxStarBox.find(html, match)) {
+            const QString content = match.captured(1);
+            if (rxRatingValue.find(content, match)) {
+                rating.rating = match.captured(1).trimmed().replace(",", ".").toDouble();
             }
-
-            rx.setPattern("<span itemprop=\"ratingCount\">(.*)</span>");
-            if (rx.indexIn(content) != -1) {
-                rating.voteCount = rx.cap(1).replace(",", "").replace(".", "").toInt();
+            if (rxRatingCount.find(content, match)) {
+                rating.voteCount = match.captured(1).replace(",", "").replace(".", "").toInt();
             }
-        } else {
-            rx.setPattern(R"(<div class="imdbRating"[^>]*>\n +<div class="ratingValue">(.*)</div>)");
-            if (rx.indexIn(html) != -1) {
-                QString content = rx.cap(1);
-                rx.setPattern("([0-9]\\.[0-9]) based on ([0-9\\,]*) ");
-                if (rx.indexIn(content) != -1) {
-                    rating.rating = rx.cap(1).trimmed().replace(",", ".").toDouble();
-                    rating.voteCount = rx.cap(2).replace(",", "").replace(".", "").toInt();
-                }
-                rx.setPattern("([0-9]\\,[0-9]) based on ([0-9\\.]*) ");
-                if (rx.indexIn(content) != -1) {
-                    rating.rating = rx.cap(1).trimmed().replace(",", ".").toDouble();
-                    rating.voteCount = rx.cap(2).replace(",", "").replace(".", "").toInt();
-                }
+        } else if (rxImdbRating.find(html, match)) {
+            const QString content = match.captured(1);
+            if (rxRatingEnglish.find(content, match)) {
+                rating.rating = match.captured(1).trimmed().replace(",", ".").toDouble();
+                rating.voteCount = match.captured(2).replace(",", "").replace(".", "").toInt();
+            }
+            if (rxRatingGerman.find(content, match)) {
+                rating.rating = match.captured(1).trimmed().replace(",", ".").toDouble();
+                rating.voteCount = match.captured(2).replace(",", "").replace(".", "").toInt();
             }
         }
 
-        movie->ratings().push_back(rating);
-
         // Top250 for movies
-        rx.setPattern("Top Rated Movies #([0-9]+)\\n</a>");
-        if (rx.indexIn(html) != -1) {
-            movie->setTop250(rx.cap(1).toInt());
+        if (rxTop250Movies.find(html, match)) {
+            data.top250 = match.captured(1).toInt();
         }
         // Top250 for TV shows (used by TheTvDb)
-        rx.setPattern("Top Rated TV #([0-9]+)\\n</a>");
-        if (rx.indexIn(html) != -1) {
-            movie->setTop250(rx.cap(1).toInt());
+        if (rxTop250Shows.find(html, match)) {
+            data.top250 = match.captured(1).toInt();
         }
     }
 
-    rx.setPattern(R"(<h4 class="inline">Production Co:</h4>(.*)<span class="see-more inline">)");
-    if (infos.contains(MovieScraperInfos::Studios) && rx.indexIn(html) != -1) {
-        QString studios = rx.cap(1);
-        rx.setPattern(R"(<a href="/company/[^"]*"[^>]*>([^<]+)</a>)");
-        int pos = 0;
-        while ((pos = rx.indexIn(studios, pos)) != -1) {
-            movie->addStudio(helper::mapStudio(rx.cap(1).trimmed()));
-            pos += rx.matchedLength();
+    if (infos.contains(MovieScraperInfos::Studios) && rxStudios.find(html, match)) {
+        for (const QString& studio : rxStudio.captureAll(match.captured(1))) {
+            data.studios << studio.trimmed();
         }
     }
 
-    rx.setPattern(R"(<h4 class="inline">Country:</h4>(.*)</div>)");
-    if (infos.contains(MovieScraperInfos::Countries) && rx.indexIn(html) != -1) {
-        QString content = rx.cap(1);
-        rx.setPattern(R"(<a href="[^"]*"[^>]*>([^<]*)</a>)");
-        int pos = 0;
-        while ((pos = rx.indexIn(content, pos)) != -1) {
-            movie->addCountry(helper::mapCountry(rx.cap(1).trimmed()));
-            pos += rx.matchedLength();
+    if (infos.contains(MovieScraperInfos::Countries) && rxCountries.find(html, match)) {
+        for (const QString& country : rxLink.captureAll(match.captured(1))) {
+            data.countries << country.trimmed();
         }
     }
+
+    return data;
+}
+
+void IMDB::assignInfos(const ScrapedMovieData& data, Movie* movie)
+{
+    if (!data.title.isEmpty()) {
+        movie->setName(data.title);
+    }
+    if (!data.originalTitle.isEmpty()) {
+        movie->setOriginalName(data.originalTitle);
+    }
+    if (!data.director.isEmpty()) {
+        movie->setDirector(data.director);
+    }
+    if (!data.writer.isEmpty()) {
+        movie->setWriter(data.writer);
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(helper::mapGenre(genre));
+    }
+    if (!data.tagline.isEmpty()) {
+        movie->setTagline(data.tagline);
+    }
+    for (const QString& tag : data.tags) {
+        movie->addTag(tag);
+    }
+    if (data.released.isValid()) {
+        movie->setReleased(data.released);
+    }
+    if (data.certification.isValid()) {
+        movie->setCertification(helper::mapCertification(data.certification));
+    }
+    if (data.runtime > -1) {
+        movie->setRuntime(std::chrono::minutes(data.runtime));
+    }
+    if (!data.outline.isEmpty()) {
+        movie->setOutline(data.outline);
+    }
+    if (!data.overview.isEmpty()) {
+        movie->setOverview(data.overview);
+    }
+    if (data.hasRating) {
+        movie->ratings().push_back(data.rating);
+    }
+    if (data.top250 != 0) {
+        movie->setTop250(data.top250);
+    }
+    for (const QString& studio : data.studios) {
+        movie->addStudio(helper::mapStudio(studio));
+    }
+    for (const QString& country : data.countries) {
+        movie->addCountry(helper::mapCountry(country));
+    }
 }
@@ -2,9 +2,9 @@
 
 #include "movies/Movie.h"
 #include "scrapers/movie/MovieScraperInterface.h"
+#include "scrapers/movie/ScrapedMovieData.h"
 
 #include <QMutexLocker>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 
 class QCheckBox;
@@ -37,7 +37,19 @@ public:
     QString defaultLanguageKey() override;
     QWidget* settingsWidget() override;
     bool isAdult() const override;
-    void parseAndAssignInfos(const QString& html, Movie* movie, QSet<MovieScraperInfos> infos);
+    /// Whether tags are loaded from the separate keywords page instead of the movie's page.
+    bool loadsAllTags() const;
+
+    /// \brief Extracts the infos of a movie's page. Thread-safe.
+    /// \param loadAllTags If true, tags are skipped because they are loaded from the keywords page.
+    static ScrapedMovieData parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos, bool loadAllTags);
+    /// \brief Assigns the result of parseInfos() to the movie. Must be called on the GUI thread.
+    static void assignInfos(const ScrapedMovieData& data, Movie* movie);
+
+    /// \brief Extracts the results of a search page. Thread-safe.
+    static QVector<ScraperSearchResult> parseSearch(const QString& html);
+    /// \brief Extracts the result of a search by IMDb ID, i.e. the movie's page. Thread-safe.
+    static QVector<ScraperSearchResult> parseIdSearch(const QString& html);
 
 private slots:
     void onSearchFinished();
@@ -49,8 +61,5 @@ private:
     QCheckBox* m_loadAllTagsWidget;
 
     bool m_loadAllTags = false;
-    QNetworkAccessManager m_qnam;
     QSet<MovieScraperInfos> m_scraperSupports;
-
-    QVector<ScraperSearchResult> parseSearch(QString html);
 };
@@ -1,14 +1,18 @@
 #include "OFDb.h"
 
 #include <QDomDocument>
+#include <QPointer>
+#include <QRegularExpression>
 #include <QWidget>
 #include <QXmlStreamReader>
 
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
 #include "settings/Settings.h"
 
 /// @brief OFDb scraper. Uses http://ofdbgw.metawave.ch directly because ttp://www.ofdbgw.org
@@ -72,7 +76,7 @@ void OFDb::saveSettings(ScraperSettings& settings)
  */
 QNetworkAccessManager* OFDb::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 /**
@@ -116,8 +120,8 @@ void OFDb::search(QString searchStr)
     QString encodedSearch = helper::toLatin1PercentEncoding(searchStr);
 
     QUrl url;
-    QRegExp rxId("^id\\d+$");
-    if (rxId.exactMatch(searchStr)) {
+    static const QRegularExpression rxId("^id\\d+$");
+    if (rxId.match(searchStr).hasMatch()) {
         url.setUrl(QString("http://ofdbgw.metawave.ch/movie/%1").arg(searchStr.mid(2)).toUtf8());
     } else {
         url.setUrl(QString("http://ofdbgw.metawave.ch/search/%1").arg(encodedSearch).toUtf8());
@@ -186,9 +190,11 @@ void OFDb::searchFinished()
         return;
     }
 
-    QString msg = QString::fromUtf8(reply->readAll());
-    auto results = parseSearch(msg, searchStr);
-    emit searchDone(results, {});
+    const QString msg = QString::fromUtf8(reply->readAll());
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg, searchStr]() { return parseSearch(msg, searchStr); },
+        [this](QVector<ScraperSearchResult> results) { emit searchDone(results, {}); });
 }
 
 /**
@@ -196,7 +202,7 @@ void OFDb::searchFinished()
  * @param xml XML data
  * @return List of search results
  */
-QVector<ScraperSearchResult> OFDb::parseSearch(QString xml, QString searchStr)
+QVector<ScraperSearchResult> OFDb::parseSearch(const QString& xml, const QString& searchStr)
 {
     QVector<ScraperSearchResult> results;
     QDomDocument domDoc;
@@ -258,7 +264,7 @@ void OFDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
 
 /**
  * @brief Called when the movie infos are downloaded
- * @see OFDb::parseAndAssignInfos
+ * @see OFDb::parseInfos
  */
 void OFDb::loadFinished()
 {
@@ -299,30 +305,41 @@ void OFDb::loadFinished()
     }
 
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, infos);
-    } else {
+    reply->deleteLater();
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error" << reply->errorString();
+        movie->controller()->scraperLoadDone(this);
+        return;
     }
-    reply->deleteLater();
-    movie->controller()->scraperLoadDone(this);
+
+    const QString msg = QString::fromUtf8(reply->readAll());
+    const QPointer<Movie> moviePtr(movie);
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg, infos]() { return parseInfos(msg, infos); },
+        [this, moviePtr](const ScrapedMovieData& data) {
+            if (moviePtr.isNull()) {
+                return;
+            }
+            assignInfos(data, moviePtr.data());
+            moviePtr->controller()->scraperLoadDone(this);
+        });
 }
 
 /**
- * @brief Parses HTML data and assigns it to the given movie object
- * @param data HTML data
- * @param movie Movie object
+ * @brief Extracts the infos of the XML response. Thread-safe.
+ * @param data XML data
  * @param infos List of infos to load
  */
-void OFDb::parseAndAssignInfos(QString data, Movie* movie, QSet<MovieScraperInfos> infos)
+ScrapedMovieData OFDb::parseInfos(const QString& data, const QSet<MovieScraperInfos>& infos)
 {
+    ScrapedMovieData movie;
     QXmlStreamReader xml(data);
 
     if (!xml.readNextStartElement()) {
         qWarning() << "[OFDb] XML has unexpected structure; couldn't read root element";
-        return;
+        return movie;
     }
 
     while (xml.readNextStartElement()) {
@@ -335,26 +352,22 @@ void OFDb::parseAndAssignInfos(QString data, Movie* movie, QSet<MovieScraperInfo
 
     while (xml.readNextStartElement()) {
         if (infos.contains(MovieScraperInfos::Title) && xml.name() == "titel") {
-            movie->setName(xml.readElementText());
+            movie.title = xml.readElementText();
         } else if (infos.contains(MovieScraperInfos::Released) && xml.name() == "jahr") {
-            movie->setReleased(QDate::fromString(xml.readElementText(), "yyyy"));
+            movie.released = QDate::fromString(xml.readElementText(), "yyyy");
         } else if (infos.contains(MovieScraperInfos::Poster) && xml.name() == "bild") {
             QString url = xml.readElementText();
             Poster p;
             p.originalUrl = QUrl(url);
             p.thumbUrl = QUrl(url);
-            movie->images().addPoster(p);
+            movie.posters.append(p);
         } else if (infos.contains(MovieScraperInfos::Rating) && xml.name() == "bewertung") {
             while (xml.readNextStartElement()) {
                 if (xml.name() == "note") {
-                    Rating rating;
-                    rating.source = "OFDb";
-                    rating.rating = xml.readElementText().toDouble();
-                    if (movie->ratings().isEmpty()) {
-                        movie->ratings().push_back(rating);
-                    } else {
-                        movie->ratings().back() = rating;
-                    }
+                    movie.hasRating = true;
+                    movie.rating = Rating();
+                    movie.rating.source = "OFDb";
+                    movie.rating.rating = xml.readElementText().toDouble();
 
                 } else {
                     xml.skipCurrentElement();
@@ -363,14 +376,14 @@ void OFDb::parseAndAssignInfos(QString data, Movie* movie, QSet<MovieScraperInfo
         } else if (infos.contains(MovieScraperInfos::Genres) && xml.name() == "genre") {
             while (xml.readNextStartElement()) {
                 if (xml.name() == "titel") {
-                    movie->addGenre(helper::mapGenre(xml.readElementText()));
+                    movie.genres << xml.readElementText();
                 } else {
                     xml.skipCurrentElement();
                 }
             }
         } else if (infos.contains(MovieScraperInfos::Actors) && xml.name() == "besetzung") {
-            // clear actors
-            movie->setActors({});
+            movie.hasActors = true;
+            movie.actors.clear();
 
             while (xml.readNextStartElement()) {
                 if (xml.name() != "person") {
@@ -386,28 +399,70 @@ void OFDb::parseAndAssignInfos(QString data, Movie* movie, QSet<MovieScraperInfo
                             xml.skipCurrentElement();
                         }
                     }
-                    movie->addActor(actor);
+                    movie.actors.append(actor);
                 }
             }
         } else if (infos.contains(MovieScraperInfos::Countries) && xml.name() == "produktionsland") {
             while (xml.readNextStartElement()) {
                 if (xml.name() == "name") {
-                    movie->addCountry(helper::mapCountry(xml.readElementText()));
+                    movie.countries << xml.readElementText();
                 } else {
                     xml.skipCurrentElement();
                 }
             }
         } else if (infos.contains(MovieScraperInfos::Title) && xml.name() == "alternativ") {
-            movie->setOriginalName(xml.readElementText());
+            movie.originalTitle = xml.readElementText();
         } else if (infos.contains(MovieScraperInfos::Overview) && xml.name() == "beschreibung") {
-            movie->setOverview(xml.readElementText());
-            if (Settings::instance()->usePlotForOutline()) {
-                movie->setOutline(xml.readElementText());
-            }
+            movie.overview = xml.readElementText();
         } else {
             xml.skipCurrentElement();
         }
     }
+    return movie;
+}
+
+/**
+ * @brief Assigns the result of parseInfos() to the given movie object
+ */
+void OFDb::assignInfos(const ScrapedMovieData& data, Movie* movie)
+{
+    if (!data.title.isEmpty()) {
+        movie->setName(data.title);
+    }
+    if (data.released.isValid()) {
+        movie->setReleased(data.released);
+    }
+    for (const Poster& poster : data.posters) {
+        movie->images().addPoster(poster);
+    }
+    if (data.hasRating) {
+        if (movie->ratings().isEmpty()) {
+            movie->ratings().push_back(data.rating);
+        } else {
+            movie->ratings().back() = data.rating;
+        }
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(helper::mapGenre(genre));
+    }
+    if (data.hasActors) {
+        movie->setActors({});
+        for (const Actor& actor : data.actors) {
+            movie->addActor(actor);
+        }
+    }
+    for (const QString& country : data.countries) {
+        movie->addCountry(helper::mapCountry(country));
+    }
+    if (!data.originalTitle.isEmpty()) {
+        movie->setOriginalName(data.originalTitle);
+    }
+    if (!data.overview.isEmpty()) {
+        movie->setOverview(data.overview);
+        if (Settings::instance()->usePlotForOutline()) {
+            movie->setOutline(data.overview);
+        }
+    }
 }
 
 QWidget* OFDb::settingsWidget()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scrapers/movie/MovieScraperInterface.h"
+#include "scrapers/movie/ScrapedMovieData.h"
 
 #include <QObject>
 #include <QtNetwork/QNetworkAccessManager>
@@ -31,15 +32,17 @@ public:
     QWidget* settingsWidget() override;
     bool isAdult() const override;
 
+    /// \brief Extracts the results of a search response. Thread-safe.
+    static QVector<ScraperSearchResult> parseSearch(const QString& xml, const QString& searchStr);
+
 private slots:
     void searchFinished();
     void loadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QSet<MovieScraperInfos> m_scraperSupports;
 
     QNetworkAccessManager* qnam();
-    QVector<ScraperSearchResult> parseSearch(QString xml, QString searchStr);
-    void parseAndAssignInfos(QString data, Movie* movie, QSet<MovieScraperInfos> infos);
+    static ScrapedMovieData parseInfos(const QString& data, const QSet<MovieScraperInfos>& infos);
+    void assignInfos(const ScrapedMovieData& data, Movie* movie);
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "data/Certification.h"
+#include "data/Rating.h"
+#include "globals/Actor.h"
+#include "globals/Poster.h"
+
+#include <QDate>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/// \brief Plain values of a movie's detail page as extracted by the HTML and XML scrapers.
+///
+/// Filled by a scraper's parseInfos() on a worker thread and assigned to a Movie on the
+/// GUI thread by the scraper's assignInfos().  Only the requested infos are parsed;
+/// everything else stays empty.  Names are not yet mapped (see helper::mapGenre() and
+/// others) and HTML is not yet converted to plain text, because both depend on the
+/// settings or on GUI classes.
+struct ScrapedMovieData
+{
+    QString title;
+    QString originalTitle;
+    QDate released;
+    /// In minutes
+    int runtime = -1;
+    QString outline;
+    QString overview;
+    QString tagline;
+    QString director;
+    QString writer;
+    QString set;
+    QStringList genres;
+    QStringList tags;
+    QStringList studios;
+    QStringList countries;
+    Certification certification;
+
+    bool hasRating = false;
+    Rating rating;
+    int top250 = 0;
+
+    bool hasActors = false;
+    QVector<Actor> actors;
+
+    QVector<Poster> posters;
+    QVector<Poster> backdrops;
+};
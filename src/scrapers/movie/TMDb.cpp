@@ -13,7 +13,10 @@
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
+#include "network/ScrapeStats.h"
+#include "scrapers/BackgroundParser.h"
 #include "settings/Settings.h"
 #include "ui/main/MainWindow.h"
 
@@ -252,7 +255,7 @@ void TMDb::setup()
     QUrl url(QStringLiteral("https://api.themoviedb.org/3/configuration?api_key=%1").arg(TMDb::apiKey()));
     QNetworkRequest request(url);
     request.setRawHeader("Accept", "application/json");
-    QNetworkReply* const reply = m_qnam.get(request);
+    QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     connect(reply, &QNetworkReply::finished, this, &TMDb::setupFinished);
 }
@@ -350,7 +353,7 @@ void TMDb::search(QString searchStr)
     }
     QNetworkRequest request(url);
     request.setRawHeader("Accept", "application/json");
-    QNetworkReply* const reply = m_qnam.get(request);
+    QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     if (!searchTitle.isEmpty() && !searchYear.isEmpty()) {
         reply->setProperty("searchTitle", searchTitle);
@@ -407,7 +410,7 @@ void TMDb::searchFinished()
 
         QNetworkRequest request(url);
         request.setRawHeader("Accept", "application/json");
-        QNetworkReply* const searchReply = m_qnam.get(request);
+        QNetworkReply* const searchReply = mediaelch::network::accessManager()->get(request);
         new NetworkReplyWatcher(this, searchReply);
         searchReply->setProperty("searchString", searchString);
         searchReply->setProperty("results", Storage::toVariant(searchReply, results));
@@ -492,6 +495,8 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
         movie->setTmdbId(TmdbId(id));
     }
 
+    // Tag requests before clear() resets the title.
+    const QString item = movie->name();
     movie->clear(infos);
 
     QNetworkRequest request;
@@ -504,7 +509,8 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
         loadsLeft.append(ScraperData::Infos);
 
         request.setUrl(getMovieUrl(id, ApiMovieDetails::INFOS));
-        QNetworkReply* const reply = m_qnam.get(request);
+        mediaelch::network::setRequestTag(request, {"TMDb", item, "infos"});
+        QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
         new NetworkReplyWatcher(this, reply);
         reply->setProperty("storage", Storage::toVariant(reply, movie));
         reply->setProperty("infosToLoad", Storage::toVariant(reply, infos));
@@ -516,7 +522,8 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
         || infos.contains(MovieScraperInfos::Writer)) {
         loadsLeft.append(ScraperData::Casts);
         request.setUrl(getMovieUrl(id, ApiMovieDetails::CASTS));
-        QNetworkReply* const reply = m_qnam.get(request);
+        mediaelch::network::setRequestTag(request, {"TMDb", item, "casts"});
+        QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
         new NetworkReplyWatcher(this, reply);
         reply->setProperty("storage", Storage::toVariant(reply, movie));
         reply->setProperty("infosToLoad", Storage::toVariant(reply, infos));
@@ -527,7 +534,8 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
     if (infos.contains(MovieScraperInfos::Trailer)) {
         loadsLeft.append(ScraperData::Trailers);
         request.setUrl(getMovieUrl(id, ApiMovieDetails::TRAILERS));
-        QNetworkReply* const reply = m_qnam.get(request);
+        mediaelch::network::setRequestTag(request, {"TMDb", item, "trailers"});
+        QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
         new NetworkReplyWatcher(this, reply);
         reply->setProperty("storage", Storage::toVariant(reply, movie));
         reply->setProperty("infosToLoad", Storage::toVariant(reply, infos));
@@ -538,7 +546,8 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
     if (infos.contains(MovieScraperInfos::Poster) || infos.contains(MovieScraperInfos::Backdrop)) {
         loadsLeft.append(ScraperData::Images);
         request.setUrl(getMovieUrl(id, ApiMovieDetails::IMAGES));
-        QNetworkReply* const reply = m_qnam.get(request);
+        mediaelch::network::setRequestTag(request, {"TMDb", item, "images"});
+        QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
         new NetworkReplyWatcher(this, reply);
         reply->setProperty("storage", Storage::toVariant(reply, movie));
         reply->setProperty("infosToLoad", Storage::toVariant(reply, infos));
@@ -549,7 +558,8 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
     if (infos.contains(MovieScraperInfos::Certification)) {
         loadsLeft.append(ScraperData::Releases);
         request.setUrl(getMovieUrl(id, ApiMovieDetails::RELEASES));
-        QNetworkReply* const reply = m_qnam.get(request);
+        mediaelch::network::setRequestTag(request, {"TMDb", item, "releases"});
+        QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
         new NetworkReplyWatcher(this, reply);
         reply->setProperty("storage", Storage::toVariant(reply, movie));
         reply->setProperty("infosToLoad", Storage::toVariant(reply, infos));
@@ -560,7 +570,7 @@ void TMDb::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* movie, QS
 }
 
 /// Called when the movie infos are downloaded
-/// @see TMDb::parseAndAssignInfos
+/// @see TMDb::parseInfos
 void TMDb::loadFinished()
 {
     auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
@@ -571,27 +581,27 @@ void TMDb::loadFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        const QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, infos);
+    if (reply->error() != QNetworkReply::NoError) {
+        showNetworkError(*reply);
+        qWarning() << "Network Error (load)" << reply->errorString();
+        movie->controller()->removeFromLoadsLeft(ScraperData::Infos);
+        return;
+    }
 
+    const QString item = mediaelch::network::requestTag(reply->request()).item;
+    parseAndAssignInfos(reply->readAll(), movie, infos, [this, infos, item](Movie* loadedMovie) {
         // if the movie is part of a collection then download the collection data
         // and delay the call to removeFromLoadsLeft(ScraperData::Infos)
         // to loadCollectionFinished()
         if (infos.contains(MovieScraperInfos::Set)) {
-            loadCollection(movie, movie->set().tmdbId);
+            loadCollection(loadedMovie, loadedMovie->set().tmdbId, item);
             return;
         }
-
-    } else {
-        showNetworkError(*reply);
-        qWarning() << "Network Error (load)" << reply->errorString();
-    }
-
-    movie->controller()->removeFromLoadsLeft(ScraperData::Infos);
+        loadedMovie->controller()->removeFromLoadsLeft(ScraperData::Infos);
+    });
 }
 
-void TMDb::loadCollection(Movie* movie, const TmdbId& collectionTmdbId)
+void TMDb::loadCollection(Movie* movie, const TmdbId& collectionTmdbId, const QString& item)
 {
     if (!collectionTmdbId.isValid()) {
         movie->controller()->removeFromLoadsLeft(ScraperData::Infos);
@@ -601,8 +611,9 @@ void TMDb::loadCollection(Movie* movie, const TmdbId& collectionTmdbId)
     QNetworkRequest request;
     request.setRawHeader("Accept", "application/json");
     request.setUrl(getCollectionUrl(collectionTmdbId.toString()));
+    mediaelch::network::setRequestTag(request, {"TMDb", item, "collection"});
 
-    QNetworkReply* const reply = m_qnam.get(request);
+    QNetworkReply* const reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     reply->setProperty("storage", Storage::toVariant(reply, movie));
     connect(reply, &QNetworkReply::finished, this, &TMDb::loadCollectionFinished);
@@ -641,7 +652,7 @@ void TMDb::loadCollectionFinished()
 
 /**
  * @brief Called when the movie casts are downloaded
- * @see TMDb::parseAndAssignInfos
+ * @see TMDb::parseInfos
  */
 void TMDb::loadCastsFinished()
 {
@@ -653,19 +664,21 @@ void TMDb::loadCastsFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error (casts)" << reply->errorString();
+        movie->controller()->removeFromLoadsLeft(ScraperData::Casts);
+        return;
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Casts);
+
+    parseAndAssignInfos(reply->readAll(), movie, infos, [](Movie* loadedMovie) {
+        loadedMovie->controller()->removeFromLoadsLeft(ScraperData::Casts);
+    });
 }
 
 /**
  * @brief Called when the movie trailers are downloaded
- * @see TMDb::parseAndAssignInfos
+ * @see TMDb::parseInfos
  */
 void TMDb::loadTrailersFinished()
 {
@@ -677,19 +690,21 @@ void TMDb::loadTrailersFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        const QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qDebug() << "Network Error (trailers)" << reply->errorString();
+        movie->controller()->removeFromLoadsLeft(ScraperData::Trailers);
+        return;
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Trailers);
+
+    parseAndAssignInfos(reply->readAll(), movie, infos, [](Movie* loadedMovie) {
+        loadedMovie->controller()->removeFromLoadsLeft(ScraperData::Trailers);
+    });
 }
 
 /**
  * @brief Called when the movie images are downloaded
- * @see TMDb::parseAndAssignInfos
+ * @see TMDb::parseInfos
  */
 void TMDb::loadImagesFinished()
 {
@@ -701,19 +716,21 @@ void TMDb::loadImagesFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error (images)" << reply->errorString();
+        movie->controller()->removeFromLoadsLeft(ScraperData::Images);
+        return;
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Images);
+
+    parseAndAssignInfos(reply->readAll(), movie, infos, [](Movie* loadedMovie) {
+        loadedMovie->controller()->removeFromLoadsLeft(ScraperData::Images);
+    });
 }
 
 /**
  * @brief Called when the movie releases are downloaded
- * @see TMDb::parseAndAssignInfos
+ * @see TMDb::parseInfos
  */
 void TMDb::loadReleasesFinished()
 {
@@ -725,14 +742,16 @@ void TMDb::loadReleasesFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = QString::fromUtf8(reply->readAll());
-        parseAndAssignInfos(msg, movie, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error (releases)" << reply->errorString();
+        movie->controller()->removeFromLoadsLeft(ScraperData::Releases);
+        return;
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Releases);
+
+    parseAndAssignInfos(reply->readAll(), movie, infos, [](Movie* loadedMovie) {
+        loadedMovie->controller()->removeFromLoadsLeft(ScraperData::Releases);
+    });
 }
 
 /**
@@ -814,72 +833,56 @@ QUrl TMDb::getCollectionUrl(QString collectionId) const
 }
 
 /**
- * @brief Parses JSON data and assigns it to the given movie object
- *        Handles all types of data from TMDb (info, releases, trailers, casts, images)
+ * @brief Parses JSON data of any TMDb movie response (info, releases, trailers, casts, images).
+ *        Thread-safe.
  * @param json JSON data
- * @param movie Movie object
  * @param infos List of infos to load
+ * @param baseUrl Base URL of TMDb images
  */
-void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfos> infos)
+TmdbMovieData TMDb::parseInfos(const QByteArray& json, const QSet<MovieScraperInfos>& infos, const QString& baseUrl)
 {
+    TmdbMovieData data;
+
     QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto parsedJson = QJsonDocument::fromJson(json, &parseError).object();
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing info json " << parseError.errorString();
-        return;
+        return data;
     }
+    data.isValid = true;
 
     // Infos
-    int tmdbId = parsedJson.value("id").toInt(-1);
-    if (tmdbId > -1) {
-        movie->setTmdbId(TmdbId(tmdbId));
-    }
-    if (!parsedJson.value("imdb_id").toString().isEmpty()) {
-        movie->setId(ImdbId(parsedJson.value("imdb_id").toString()));
-    }
+    data.tmdbId = parsedJson.value("id").toInt(-1);
+    data.imdbId = parsedJson.value("imdb_id").toString();
     if (infos.contains(MovieScraperInfos::Title)) {
-        if (!parsedJson.value("title").toString().isEmpty()) {
-            movie->setName(parsedJson.value("title").toString());
-        }
-        if (!parsedJson.value("original_title").toString().isEmpty()) {
-            movie->setOriginalName(parsedJson.value("original_title").toString());
-        }
+        data.title = parsedJson.value("title").toString();
+        data.originalTitle = parsedJson.value("original_title").toString();
     }
     if (infos.contains(MovieScraperInfos::Set) && parsedJson.value("belongs_to_collection").isObject()) {
         const auto collection = parsedJson.value("belongs_to_collection").toObject();
-        MovieSet set;
-        set.tmdbId = TmdbId(collection.value("id").toInt());
-        set.name = collection.value("name").toString();
-        movie->setSet(set);
+        data.hasCollection = true;
+        data.collection.tmdbId = TmdbId(collection.value("id").toInt());
+        data.collection.name = collection.value("name").toString();
     }
     if (infos.contains(MovieScraperInfos::Overview)) {
-        QTextDocument doc;
-        doc.setHtml(parsedJson.value("overview").toString());
-        const auto overviewStr = doc.toPlainText();
-        if (!overviewStr.isEmpty()) {
-            movie->setOverview(overviewStr);
-            if (Settings::instance()->usePlotForOutline()) {
-                movie->setOutline(overviewStr);
-            }
-        }
+        data.overview = parsedJson.value("overview").toString();
     }
     // Either set both vote_average and vote_count or neither one.
     if (infos.contains(MovieScraperInfos::Rating) && parsedJson.value("vote_average").toDouble(-1) >= 0) {
-        Rating rating;
-        rating.source = "themoviedb";
-        rating.maxRating = 10;
-        rating.rating = parsedJson.value("vote_average").toDouble();
-        rating.voteCount = parsedJson.value("vote_count").toInt();
-        movie->ratings().push_back(rating);
+        data.hasRating = true;
+        data.rating.source = "themoviedb";
+        data.rating.maxRating = 10;
+        data.rating.rating = parsedJson.value("vote_average").toDouble();
+        data.rating.voteCount = parsedJson.value("vote_count").toInt();
     }
-    if (infos.contains(MovieScraperInfos::Tagline) && !parsedJson.value("tagline").toString().isEmpty()) {
-        movie->setTagline(parsedJson.value("tagline").toString());
+    if (infos.contains(MovieScraperInfos::Tagline)) {
+        data.tagline = parsedJson.value("tagline").toString();
     }
     if (infos.contains(MovieScraperInfos::Released) && !parsedJson.value("release_date").toString().isEmpty()) {
-        movie->setReleased(QDate::fromString(parsedJson.value("release_date").toString(), "yyyy-MM-dd"));
+        data.released = QDate::fromString(parsedJson.value("release_date").toString(), "yyyy-MM-dd");
     }
-    if (infos.contains(MovieScraperInfos::Runtime) && parsedJson.value("runtime").toInt(-1) >= 0) {
-        movie->setRuntime(std::chrono::minutes(parsedJson.value("runtime").toInt()));
+    if (infos.contains(MovieScraperInfos::Runtime)) {
+        data.runtime = parsedJson.value("runtime").toInt(-1);
     }
     if (infos.contains(MovieScraperInfos::Genres) && parsedJson.value("genres").isArray()) {
         const auto genres = parsedJson.value("genres").toArray();
@@ -888,7 +891,7 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
             if (genre.value("id").toInt(-1) == -1) {
                 continue;
             }
-            movie->addGenre(helper::mapGenre(genre.value("name").toString()));
+            data.genres << genre.value("name").toString();
         }
     }
     if (infos.contains(MovieScraperInfos::Studios) && parsedJson.value("production_companies").isArray()) {
@@ -898,7 +901,7 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
             if (company.value("id").toInt(-1) == -1) {
                 continue;
             }
-            movie->addStudio(helper::mapStudio(company.value("name").toString()));
+            data.studios << company.value("name").toString();
         }
     }
     if (infos.contains(MovieScraperInfos::Countries) && parsedJson.value("production_countries").isArray()) {
@@ -908,15 +911,13 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
             if (country.value("name").toString().isEmpty()) {
                 continue;
             }
-            movie->addCountry(helper::mapCountry(country.value("name").toString()));
+            data.countries << country.value("name").toString();
         }
     }
 
     // Casts
     if (infos.contains(MovieScraperInfos::Actors) && parsedJson.value("cast").isArray()) {
-        // clear actors
-        movie->setActors({});
-
+        data.hasCast = true;
         const auto cast = parsedJson.value("cast").toArray();
         for (const auto& it : cast) {
             const auto actor = it.toObject();
@@ -927,9 +928,9 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
             a.name = actor.value("name").toString();
             a.role = actor.value("character").toString();
             if (!actor.value("profile_path").toString().isEmpty()) {
-                a.thumb = m_baseUrl + "original" + actor.value("profile_path").toString();
+                a.thumb = baseUrl + "original" + actor.value("profile_path").toString();
             }
-            movie->addActor(a);
+            data.actors << a;
         }
     }
 
@@ -939,23 +940,16 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
         const auto crew = parsedJson.value("crew").toArray();
         for (const auto& it : crew) {
             const auto member = it.toObject();
-            if (member.value("name").toString().isEmpty()) {
+            const QString name = member.value("name").toString();
+            if (name.isEmpty()) {
                 continue;
             }
             if (infos.contains(MovieScraperInfos::Writer) && member.value("department").toString() == "Writing") {
-                QString writer = movie->writer();
-                if (writer.contains(member.value("name").toString())) {
-                    continue;
-                }
-                if (!writer.isEmpty()) {
-                    writer.append(", ");
-                }
-                writer.append(member.value("name").toString());
-                movie->setWriter(writer);
+                data.writers << name;
             }
             if (infos.contains(MovieScraperInfos::Director) && member.value("job").toString() == "Director"
                 && member.value("department").toString() == "Directing") {
-                movie->setDirector(member.value("name").toString());
+                data.director = name;
             }
         }
     }
@@ -966,11 +960,8 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
         const auto videos = parsedJson.value("youtube").toArray();
         for (const auto& it : videos) {
             const auto videoObj = it.toObject();
-            const QString videoType = videoObj.value("type").toString();
-            if (videoType.toLower() == "trailer") {
-                const QString youtubeSrc = videoObj.value("source").toString();
-                movie->setTrailer(QUrl(
-                    helper::formatTrailerUrl(QStringLiteral("https://www.youtube.com/watch?v=%1").arg(youtubeSrc))));
+            if (videoObj.value("type").toString().toLower() == "trailer") {
+                data.youtubeTrailer = videoObj.value("source").toString();
                 break;
             }
         }
@@ -986,11 +977,11 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
                 continue;
             }
             Poster b;
-            b.thumbUrl = m_baseUrl + "w780" + filePath;
-            b.originalUrl = m_baseUrl + "original" + filePath;
+            b.thumbUrl = baseUrl + "w780" + filePath;
+            b.originalUrl = baseUrl + "original" + filePath;
             b.originalSize.setWidth(backdrop.value("width").toInt());
             b.originalSize.setHeight(backdrop.value("height").toInt());
-            movie->images().addBackdrop(b);
+            data.backdrops << b;
         }
     }
 
@@ -1003,34 +994,142 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
                 continue;
             }
             Poster b;
-            b.thumbUrl = m_baseUrl + "w342" + filePath;
-            b.originalUrl = m_baseUrl + "original" + filePath;
+            b.thumbUrl = baseUrl + "w342" + filePath;
+            b.originalUrl = baseUrl + "original" + filePath;
             b.originalSize.setWidth(poster.value("width").toInt());
             b.originalSize.setHeight(poster.value("height").toInt());
             b.language = poster.value("iso_639_1").toString();
-            bool primaryLang = (b.language == language());
-            movie->images().addPoster(b, primaryLang);
+            data.posters << b;
         }
     }
 
     // Releases
     if (infos.contains(MovieScraperInfos::Certification) && parsedJson.value("countries").isArray()) {
-        Certification locale;
-        Certification us;
-        Certification gb;
         const auto countries = parsedJson.value("countries").toArray();
         for (const auto& it : countries) {
             const auto countryObj = it.toObject();
-            const QString iso3166 = countryObj.value("iso_3166_1").toString();
-            const Certification certification = Certification(countryObj.value("certification").toString());
+            data.certifications.append(qMakePair(countryObj.value("iso_3166_1").toString(),
+                Certification(countryObj.value("certification").toString())));
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @brief Assigns data parsed by parseInfos() to the given movie object
+ * @param data Parsed TMDb response
+ * @param movie Movie object
+ */
+void TMDb::assignInfos(const TmdbMovieData& data, Movie* movie)
+{
+    if (!data.isValid) {
+        return;
+    }
+
+    // Infos
+    if (data.tmdbId > -1) {
+        movie->setTmdbId(TmdbId(data.tmdbId));
+    }
+    if (!data.imdbId.isEmpty()) {
+        movie->setId(ImdbId(data.imdbId));
+    }
+    if (!data.title.isEmpty()) {
+        movie->setName(data.title);
+    }
+    if (!data.originalTitle.isEmpty()) {
+        movie->setOriginalName(data.originalTitle);
+    }
+    if (data.hasCollection) {
+        movie->setSet(data.collection);
+    }
+    if (!data.overview.isEmpty()) {
+        QTextDocument doc;
+        doc.setHtml(data.overview);
+        const auto overviewStr = doc.toPlainText();
+        if (!overviewStr.isEmpty()) {
+            movie->setOverview(overviewStr);
+            if (Settings::instance()->usePlotForOutline()) {
+                movie->setOutline(overviewStr);
+            }
+        }
+    }
+    if (data.hasRating) {
+        movie->ratings().push_back(data.rating);
+    }
+    if (!data.tagline.isEmpty()) {
+        movie->setTagline(data.tagline);
+    }
+    if (!data.released.isNull()) {
+        movie->setReleased(data.released);
+    }
+    if (data.runtime >= 0) {
+        movie->setRuntime(std::chrono::minutes(data.runtime));
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(helper::mapGenre(genre));
+    }
+    for (const QString& studio : data.studios) {
+        movie->addStudio(helper::mapStudio(studio));
+    }
+    for (const QString& country : data.countries) {
+        movie->addCountry(helper::mapCountry(country));
+    }
+
+    // Casts
+    if (data.hasCast) {
+        // clear actors
+        movie->setActors({});
+        for (const Actor& actor : data.actors) {
+            movie->addActor(actor);
+        }
+    }
+
+    // Crew
+    for (const QString& name : data.writers) {
+        QString writer = movie->writer();
+        if (writer.contains(name)) {
+            continue;
+        }
+        if (!writer.isEmpty()) {
+            writer.append(", ");
+        }
+        writer.append(name);
+        movie->setWriter(writer);
+    }
+    if (!data.director.isEmpty()) {
+        movie->setDirector(data.director);
+    }
+
+    // Trailers
+    if (!data.youtubeTrailer.isEmpty()) {
+        movie->setTrailer(QUrl(helper::formatTrailerUrl(
+            QStringLiteral("https://www.youtube.com/watch?v=%1").arg(data.youtubeTrailer))));
+    }
+
+    // Images
+    for (const Poster& backdrop : data.backdrops) {
+        movie->images().addBackdrop(backdrop);
+    }
+    for (const Poster& poster : data.posters) {
+        movie->images().addPoster(poster, poster.language == language());
+    }
+
+    // Releases
+    if (!data.certifications.isEmpty()) {
+        Certification locale;
+        Certification us;
+        Certification gb;
+        for (const auto& certification : data.certifications) {
+            const QString& iso3166 = certification.first;
             if (iso3166 == "US") {
-                us = certification;
+                us = certification.second;
             }
             if (iso3166 == "GB") {
-                gb = certification;
+                gb = certification.second;
             }
             if (iso3166.toUpper() == country()) {
-                locale = certification;
+                locale = certification.second;
             }
         }
 
@@ -1051,3 +1150,26 @@ void TMDb::parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfo
         }
     }
 }
+
+/**
+ * @brief Parses the response on a worker thread, assigns it to the movie and calls \p done.
+ *        \p done is not called if the movie is deleted in the meantime.
+ */
+void TMDb::parseAndAssignInfos(const QByteArray& json,
+    Movie* movie,
+    QSet<MovieScraperInfos> infos,
+    std::function<void(Movie*)> done)
+{
+    const QPointer<Movie> moviePtr(movie);
+    const QString baseUrl = m_baseUrl;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [json, infos, baseUrl]() { return parseInfos(json, infos, baseUrl); },
+        [this, moviePtr, done](const TmdbMovieData& data) {
+            if (moviePtr.isNull()) {
+                return;
+            }
+            assignInfos(data, moviePtr.data());
+            done(moviePtr.data());
+        });
+}
@@ -2,6 +2,7 @@
 
 #include "data/TmdbId.h"
 #include "scrapers/movie/MovieScraperInterface.h"
+#include "scrapers/movie/tmdb/TmdbMovieData.h"
 
 #include <QComboBox>
 #include <QLocale>
@@ -12,6 +13,8 @@
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 
+#include <functional>
+
 /**
  * @brief The TMDb class
  */
@@ -51,7 +54,6 @@ private slots:
     void setupFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QLocale m_locale;
     QString m_baseUrl;
     QMutex m_mutex;
@@ -87,7 +89,13 @@ private:
     getMovieUrl(QString movieId, ApiMovieDetails type, const UrlParameterMap& parameters = UrlParameterMap{}) const;
     QUrl getCollectionUrl(QString collectionId) const;
 
-    void parseAndAssignInfos(QString json, Movie* movie, QSet<MovieScraperInfos> infos);
+    static TmdbMovieData
+    parseInfos(const QByteArray& json, const QSet<MovieScraperInfos>& infos, const QString& baseUrl);
+    void assignInfos(const TmdbMovieData& data, Movie* movie);
+    void parseAndAssignInfos(const QByteArray& json,
+        Movie* movie,
+        QSet<MovieScraperInfos> infos,
+        std::function<void(Movie*)> done);
     /// Load the given collection (TMDb id) and store the content in the movie.
-    void loadCollection(Movie* movie, const TmdbId& collectionTmdbId);
+    void loadCollection(Movie* movie, const TmdbId& collectionTmdbId, const QString& item);
 };
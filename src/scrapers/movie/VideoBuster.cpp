@@ -1,12 +1,16 @@
 #include "VideoBuster.h"
 
+#include <QPointer>
 #include <QTextDocument>
 
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/HtmlPattern.h"
 #include "settings/Settings.h"
 
 VideoBuster::VideoBuster(QObject* parent) :
@@ -35,7 +39,7 @@ VideoBuster::VideoBuster(QObject* parent) :
  */
 QNetworkAccessManager* VideoBuster::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 /**
@@ -125,9 +129,11 @@ void VideoBuster::searchFinished()
         return;
     }
 
-    QString msg = reply->readAll();
-    msg = replaceEntities(msg);
-    emit searchDone(parseSearch(msg), {});
+    const QString msg = reply->readAll();
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg]() { return parseSearch(replaceEntities(msg)); },
+        [this](QVector<ScraperSearchResult> results) { emit searchDone(results, {}); });
 }
 
 /**
@@ -135,18 +141,19 @@ void VideoBuster::searchFinished()
  * @param html Downloaded HTML data
  * @return List of search results
  */
-QVector<ScraperSearchResult> VideoBuster::parseSearch(QString html)
+QVector<ScraperSearchResult> VideoBuster::parseSearch(const QString& html)
 {
+    static const mediaelch::scraper::HtmlPattern rx(
+        "<div class=\"infos\"><a href=\"([^\"]*)\" class=\"title\">([^<]*)</a>");
+
     QVector<ScraperSearchResult> results;
-    int pos = 0;
-    QRegExp rx("<div class=\"infos\"><a href=\"([^\"]*)\" class=\"title\">([^<]*)</a>");
-    rx.setMinimal(true);
-    while ((pos = rx.indexIn(html, pos)) != -1) {
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
         ScraperSearchResult result;
-        result.name = rx.cap(2);
-        result.id = rx.cap(1);
+        result.name = match.captured(2);
+        result.id = match.captured(1);
         results.append(result);
-        pos += rx.matchedLength();
     }
     return results;
 }
@@ -172,7 +179,7 @@ void VideoBuster::loadData(QHash<MovieScraperInterface*, QString> ids, Movie* mo
 
 /**
  * @brief Called when the movie infos are downloaded
- * @see VideoBuster::parseAndAssignInfos
+ * @see VideoBuster::parseInfos
  */
 void VideoBuster::loadFinished()
 {
@@ -184,201 +191,245 @@ void VideoBuster::loadFinished()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QString msg = reply->readAll();
-        msg = replaceEntities(msg);
-        parseAndAssignInfos(msg, movie, infos);
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error" << reply->errorString();
         movie->controller()->scraperLoadDone(this);
+        return;
     }
+
+    const QString msg = reply->readAll();
+    const QPointer<Movie> moviePtr(movie);
+    mediaelch::scraper::parseInBackground(
+        this,
+        [msg, infos]() { return parseInfos(replaceEntities(msg), infos); },
+        [this, moviePtr, infos](const ScrapedMovieData& data) {
+            if (moviePtr.isNull()) {
+                return;
+            }
+            moviePtr->clear(infos);
+            assignInfos(data, moviePtr.data());
+            moviePtr->controller()->scraperLoadDone(this);
+        });
 }
 
 /**
- * @brief Parses HTML data and assigns it to the given movie object
+ * @brief Extracts the infos of a movie's page. Thread-safe.
  * @param html HTML data
- * @param movie Movie object
  * @param infos List of infos to load
  */
-void VideoBuster::parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos)
+ScrapedMovieData VideoBuster::parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos)
 {
-    qDebug() << "[VideoBuster] parseAndAssignInfos";
-    movie->clear(infos);
-    QRegExp rx;
-    rx.setMinimal(true);
-    int pos = 0;
-    QTextDocument doc;
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxTitle("<h1 itemprop=\"name\">(.*)</h1>");
+    static const HtmlPattern rxOriginalTitle(
+        "<label>Originaltitel</label><br><span itemprop=\"alternateName\">(.*)</span>");
+    static const HtmlPattern rxYear("<span itemprop=\"copyrightYear\">([0-9]*)</span>");
+    static const HtmlPattern rxCountry(R"(<label>Produktion</label><br><a href="[^"]*">(.*)</a>)");
+    // 2016 | FSK 0
+    static const HtmlPattern rxCertification("[0-9]{4} [|] FSK ([0-9]+)");
+    static const HtmlPattern rxActor(
+        "<span itemprop=\"actor\" itemscope itemtype=\"http://schema.org/Person\"><a href=\"[^\"]*\" "
+        "itemprop=\"url\"><span itemprop=\"name\">(.*)</span></a></span>");
+    static const HtmlPattern rxDirectors("<p><label>Regie</label><br>(.*)</p>");
+    static const HtmlPattern rxDirector(R"(<a href="/persondtl.php/[^"]*">(.*)</a>)");
+    static const HtmlPattern rxTags("<label>Schlagw&ouml;rter</label><br><span itemprop=\"keywords\">(.*)</span>");
+    static const HtmlPattern rxTag(R"(<a href="/titlesearch.php[^"]*">(.*)</a>)");
+    static const HtmlPattern rxStudio(
+        "<label>Studio</label><br><span itemprop=\"publisher\" itemscope "
+        "itemtype=\"http://schema.org/Organization\">.*<span itemprop=\"name\">(.*)</span></a></span>");
+    static const HtmlPattern rxRuntime("ca. ([0-9]*) Minuten");
+    static const HtmlPattern rxRatingCount("<span itemprop=\"ratingCount\">([0-9]*)</span>");
+    static const HtmlPattern rxRatingValue("<span itemprop=\"ratingValue\">(.*)</span>");
+    static const HtmlPattern rxGenre(R"(<a href="/genrelist\.php/.*">(.*)</a>)");
+    static const HtmlPattern rxTagline(R"(<p class="long_name" itemprop="alternativeHeadline">(.*)</p>)");
+    static const HtmlPattern rxOverview("<p itemprop=\"description\">(.*)</p>");
+    static const HtmlPattern rxPosters("<h3>Poster</h3><ul class=\"gallery_box  posters\">(.*)</ul>");
+    static const HtmlPattern rxPoster(
+        "<a href=\"https://gfx.videobuster.de/archive/([^\"]*)\" data-title=\"[^\"]*\" "
+        "rel=\"gallery_posters\" target=\"_blank\" class=\"image\">");
+    static const HtmlPattern rxBackdrops("<h3>Szenenbilder</h3><ul class=\"gallery_box  pictures\">(.*)</ul>");
+    static const HtmlPattern rxBackdrop(
+        "<a href=\"https://gfx.videobuster.de/archive/([^\"]*)\" data-title=\"[^\"]*\" "
+        "rel=\"gallery_pictures\" target=\"_blank\" class=\"image\">");
+
+    ScrapedMovieData data;
+    QRegularExpressionMatch match;
 
     // Title
-    rx.setPattern("<h1 itemprop=\"name\">(.*)</h1>");
-    if (infos.contains(MovieScraperInfos::Title) && rx.indexIn(html) != -1) {
-        movie->setName(rx.cap(1).trimmed());
+    if (infos.contains(MovieScraperInfos::Title) && rxTitle.find(html, match)) {
+        data.title = match.captured(1).trimmed();
     }
 
     // Original Title
-    rx.setPattern("<label>Originaltitel</label><br><span itemprop=\"alternateName\">(.*)</span>");
-    if (infos.contains(MovieScraperInfos::Title) && rx.indexIn(html) != -1) {
-        movie->setOriginalName(rx.cap(1).trimmed());
+    if (infos.contains(MovieScraperInfos::Title) && rxOriginalTitle.find(html, match)) {
+        data.originalTitle = match.captured(1).trimmed();
     }
 
     // Year
-    rx.setPattern("<span itemprop=\"copyrightYear\">([0-9]*)</span>");
-    if (infos.contains(MovieScraperInfos::Released) && rx.indexIn(html) != -1) {
-        movie->setReleased(QDate::fromString(rx.cap(1).trimmed(), "yyyy"));
+    if (infos.contains(MovieScraperInfos::Released) && rxYear.find(html, match)) {
+        data.released = QDate::fromString(match.captured(1).trimmed(), "yyyy");
     }
 
     // Country
-    pos = 0;
-    rx.setPattern(R"(<label>Produktion</label><br><a href="[^"]*">(.*)</a>)");
-    while (infos.contains(MovieScraperInfos::Countries) && (pos = rx.indexIn(html, pos)) != -1) {
-        movie->addCountry(helper::mapCountry(rx.cap(1).trimmed()));
-        pos += rx.matchedLength();
+    if (infos.contains(MovieScraperInfos::Countries)) {
+        for (const QString& country : rxCountry.captureAll(html)) {
+            data.countries << country.trimmed();
+        }
     }
 
     // MPAA
-    if (infos.contains(MovieScraperInfos::Certification)) {
-        // 2016 | FSK 0
-        rx.setPattern("[0-9]{4} [|] FSK ([0-9]+)");
-        if (rx.indexIn(html) != -1) {
-            movie->setCertification(helper::mapCertification(Certification::FSK(rx.cap(1))));
-        }
+    if (infos.contains(MovieScraperInfos::Certification) && rxCertification.find(html, match)) {
+        data.certification = Certification::FSK(match.captured(1));
     }
 
-    // Actors
-    pos = 0;
-
-    // clear actors
-    movie->setActors({});
-
-    rx.setPattern("<span itemprop=\"actor\" itemscope itemtype=\"http://schema.org/Person\"><a href=\"[^\"]*\" "
-                  "itemprop=\"url\"><span itemprop=\"name\">(.*)</span></a></span>");
-    while (infos.contains(MovieScraperInfos::Actors) && (pos = rx.indexIn(html, pos)) != -1) {
-        Actor a;
-        a.name = rx.cap(1).trimmed();
-        movie->addActor(a);
-        pos += rx.matchedLength();
+    // Actors; they are cleared even if they are not loaded
+    data.hasActors = true;
+    if (infos.contains(MovieScraperInfos::Actors)) {
+        for (const QString& name : rxActor.captureAll(html)) {
+            Actor a;
+            a.name = name.trimmed();
+            data.actors.append(a);
+        }
     }
 
-    if (infos.contains(MovieScraperInfos::Director)) {
-        rx.setPattern("<p><label>Regie</label><br>(.*)</p>");
-        if (rx.indexIn(html) != -1) {
-            pos = 0;
-            QString contents = rx.cap(1);
-            QStringList directors;
-            rx.setPattern(R"(<a href="/persondtl.php/[^"]*">(.*)</a>)");
-            while ((pos = rx.indexIn(contents, pos)) != -1) {
-                directors.append(rx.cap(1).trimmed());
-                pos += rx.matchedLength();
-            }
-            movie->setDirector(directors.join(", "));
+    if (infos.contains(MovieScraperInfos::Director) && rxDirectors.find(html, match)) {
+        QStringList directors;
+        for (const QString& director : rxDirector.captureAll(match.captured(1))) {
+            directors.append(director.trimmed());
         }
+        data.director = directors.join(", ");
     }
 
-    if (infos.contains(MovieScraperInfos::Tags)) {
-        rx.setPattern("<label>Schlagw&ouml;rter</label><br><span itemprop=\"keywords\">(.*)</span>");
-        if (rx.indexIn(html) != -1) {
-            pos = 0;
-            QString contents = rx.cap(1);
-            rx.setPattern(R"(<a href="/titlesearch.php[^"]*">(.*)</a>)");
-            while ((pos = rx.indexIn(contents, pos)) != -1) {
-                movie->addTag(rx.cap(1).trimmed());
-                pos += rx.matchedLength();
-            }
+    if (infos.contains(MovieScraperInfos::Tags) && rxTags.find(html, match)) {
+        for (const QString& tag : rxTag.captureAll(match.captured(1))) {
+            data.tags << tag.trimmed();
         }
     }
 
     // Studio
-    rx.setPattern("<label>Studio</label><br><span itemprop=\"publisher\" itemscope "
-                  "itemtype=\"http://schema.org/Organization\">.*<span itemprop=\"name\">(.*)</span></a></span>");
-    if (infos.contains(MovieScraperInfos::Studios) && rx.indexIn(html) != -1) {
-        movie->addStudio(helper::mapStudio(rx.cap(1).trimmed()));
+    if (infos.contains(MovieScraperInfos::Studios) && rxStudio.find(html, match)) {
+        data.studios << match.captured(1).trimmed();
     }
 
     // Runtime
-    rx.setPattern("ca. ([0-9]*) Minuten");
-    if (infos.contains(MovieScraperInfos::Runtime) && rx.indexIn(html) != -1) {
-        movie->setRuntime(std::chrono::minutes(rx.cap(1).trimmed().toInt()));
+    if (infos.contains(MovieScraperInfos::Runtime) && rxRuntime.find(html, match)) {
+        data.runtime = match.captured(1).trimmed().toInt();
     }
 
     // Rating
     if (infos.contains(MovieScraperInfos::Rating)) {
-        Rating rating;
-        rating.source = "VideoBuster";
-        rx.setPattern("<span itemprop=\"ratingCount\">([0-9]*)</span>");
-        if (rx.indexIn(html) != -1) {
-            rating.voteCount = rx.cap(1).trimmed().toInt();
+        data.hasRating = true;
+        data.rating.source = "VideoBuster";
+        if (rxRatingCount.find(html, match)) {
+            data.rating.voteCount = match.captured(1).trimmed().toInt();
         }
-        rx.setPattern("<span itemprop=\"ratingValue\">(.*)</span>");
-        if (rx.indexIn(html) != -1) {
-            rating.rating = rx.cap(1).trimmed().replace(".", "").replace(",", ".").toDouble();
+        if (rxRatingValue.find(html, match)) {
+            data.rating.rating = match.captured(1).trimmed().replace(".", "").replace(",", ".").toDouble();
         }
-        movie->ratings().push_back(rating);
     }
 
     // Genres
     if (infos.contains(MovieScraperInfos::Genres)) {
-        pos = 0;
-        rx.setPattern(R"(<a href="/genrelist\.php/.*">(.*)</a>)");
-        while ((pos = rx.indexIn(html, pos)) != -1) {
-            movie->addGenre(helper::mapGenre(rx.cap(1).trimmed()));
-            pos += rx.matchedLength();
+        for (const QString& genre : rxGenre.captureAll(html)) {
+            data.genres << genre.trimmed();
         }
     }
 
     // Tagline
-    rx.setPattern(R"(<p class="long_name" itemprop="alternativeHeadline">(.*)</p>)");
-    if (infos.contains(MovieScraperInfos::Tagline) && rx.indexIn(html) != -1) {
-        movie->setTagline(rx.cap(1).trimmed());
+    if (infos.contains(MovieScraperInfos::Tagline) && rxTagline.find(html, match)) {
+        data.tagline = match.captured(1).trimmed();
     }
 
-    // Overview
-    rx.setPattern("<p itemprop=\"description\">(.*)</p>");
-    if (infos.contains(MovieScraperInfos::Overview) && rx.indexIn(html) != -1) {
-        doc.setHtml(rx.cap(1).trimmed());
-        movie->setOverview(doc.toPlainText());
-        if (Settings::instance()->usePlotForOutline()) {
-            movie->setOutline(doc.toPlainText());
-        }
+    // Overview; HTML that is converted by assignInfos()
+    if (infos.contains(MovieScraperInfos::Overview) && rxOverview.find(html, match)) {
+        data.overview = match.captured(1).trimmed();
     }
 
     // Posters
-    if (infos.contains(MovieScraperInfos::Poster)) {
-        rx.setPattern("<h3>Poster</h3><ul class=\"gallery_box  posters\">(.*)</ul>");
-        if (rx.indexIn(html) != -1) {
-            QString contents = rx.cap(1);
-            pos = 0;
-            rx.setPattern("<a href=\"https://gfx.videobuster.de/archive/([^\"]*)\" data-title=\"[^\"]*\" "
-                          "rel=\"gallery_posters\" target=\"_blank\" class=\"image\">");
-            while ((pos = rx.indexIn(contents, pos)) != -1) {
-                Poster p;
-                p.thumbUrl = "https://gfx.videobuster.de/archive/" + rx.cap(1);
-                p.originalUrl = "https://gfx.videobuster.de/archive/" + rx.cap(1);
-                movie->images().addPoster(p);
-                pos += rx.matchedLength();
-            }
+    if (infos.contains(MovieScraperInfos::Poster) && rxPosters.find(html, match)) {
+        for (const QString& path : rxPoster.captureAll(match.captured(1))) {
+            Poster p;
+            p.thumbUrl = "https://gfx.videobuster.de/archive/" + path;
+            p.originalUrl = "https://gfx.videobuster.de/archive/" + path;
+            data.posters.append(p);
         }
     }
 
     // Backdrops
-    if (infos.contains(MovieScraperInfos::Backdrop)) {
-        rx.setPattern("<h3>Szenenbilder</h3><ul class=\"gallery_box  pictures\">(.*)</ul>");
-        if (rx.indexIn(html) != -1) {
-            QString contents = rx.cap(1);
-            pos = 0;
-            rx.setPattern("<a href=\"https://gfx.videobuster.de/archive/([^\"]*)\" data-title=\"[^\"]*\" "
-                          "rel=\"gallery_pictures\" target=\"_blank\" class=\"image\">");
-            while ((pos = rx.indexIn(contents, pos)) != -1) {
-                Poster p;
-                p.thumbUrl = "https://gfx.videobuster.de/archive/" + rx.cap(1);
-                p.originalUrl = "https://gfx.videobuster.de/archive/" + rx.cap(1);
-                movie->images().addBackdrop(p);
-                pos += rx.matchedLength();
-            }
+    if (infos.contains(MovieScraperInfos::Backdrop) && rxBackdrops.find(html, match)) {
+        for (const QString& path : rxBackdrop.captureAll(match.captured(1))) {
+            Poster p;
+            p.thumbUrl = "https://gfx.videobuster.de/archive/" + path;
+            p.originalUrl = "https://gfx.videobuster.de/archive/" + path;
+            data.backdrops.append(p);
         }
     }
 
-    movie->controller()->scraperLoadDone(this);
+    return data;
+}
+
+/**
+ * @brief Assigns the result of parseInfos() to the given movie object
+ */
+void VideoBuster::assignInfos(const ScrapedMovieData& data, Movie* movie)
+{
+    if (!data.title.isEmpty()) {
+        movie->setName(data.title);
+    }
+    if (!data.originalTitle.isEmpty()) {
+        movie->setOriginalName(data.originalTitle);
+    }
+    if (data.released.isValid()) {
+        movie->setReleased(data.released);
+    }
+    for (const QString& country : data.countries) {
+        movie->addCountry(helper::mapCountry(country));
+    }
+    if (data.certification.isValid()) {
+        movie->setCertification(helper::mapCertification(data.certification));
+    }
+    if (data.hasActors) {
+        movie->setActors({});
+        for (const Actor& actor : data.actors) {
+            movie->addActor(actor);
+        }
+    }
+    if (!data.director.isEmpty()) {
+        movie->setDirector(data.director);
+    }
+    for (const QString& tag : data.tags) {
+        movie->addTag(tag);
+    }
+    for (const QString& studio : data.studios) {
+        movie->addStudio(helper::mapStudio(studio));
+    }
+    if (data.runtime > -1) {
+        movie->setRuntime(std::chrono::minutes(data.runtime));
+    }
+    if (data.hasRating) {
+        movie->ratings().push_back(data.rating);
+    }
+    for (const QString& genre : data.genres) {
+        movie->addGenre(helper::mapGenre(genre));
+    }
+    if (!data.tagline.isEmpty()) {
+        movie->setTagline(data.tagline);
+    }
+    if (!data.overview.isEmpty()) {
+        QTextDocument doc;
+        doc.setHtml(data.overview);
+        movie->setOverview(doc.toPlainText());
+        if (Settings::instance()->usePlotForOutline()) {
+            movie->setOutline(doc.toPlainText());
+        }
+    }
+    for (const Poster& poster : data.posters) {
+        movie->images().addPoster(poster);
+    }
+    for (const Poster& backdrop : data.backdrops) {
+        movie->images().addBackdrop(backdrop);
+    }
 }
 
 /**
@@ -416,7 +467,7 @@ QWidget* VideoBuster::settingsWidget()
  * @param msg String with entities
  * @return String without entities
  */
-QString VideoBuster::replaceEntities(const QString msg)
+QString VideoBuster::replaceEntities(const QString& msg)
 {
     // not nice but I don't know other methods which don't require the gui module
     QString m = msg;
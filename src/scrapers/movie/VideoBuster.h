@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scrapers/movie/MovieScraperInterface.h"
+#include "scrapers/movie/ScrapedMovieData.h"
 
 #include <QObject>
 #include <QWidget>
@@ -32,16 +33,18 @@ public:
     QWidget* settingsWidget() override;
     bool isAdult() const override;
 
+    /// \brief Extracts the results of a search page. Thread-safe.
+    static QVector<ScraperSearchResult> parseSearch(const QString& html);
+
 private slots:
     void searchFinished();
     void loadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QSet<MovieScraperInfos> m_scraperSupports;
 
     QNetworkAccessManager* qnam();
-    QVector<ScraperSearchResult> parseSearch(QString html);
-    void parseAndAssignInfos(QString html, Movie* movie, QSet<MovieScraperInfos> infos);
-    QString replaceEntities(const QString msg);
+    static ScrapedMovieData parseInfos(const QString& html, const QSet<MovieScraperInfos>& infos);
+    void assignInfos(const ScrapedMovieData& data, Movie* movie);
+    static QString replaceEntities(const QString& msg);
 };
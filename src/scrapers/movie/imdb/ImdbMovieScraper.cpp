@@ -2,19 +2,28 @@
 
 #include "globals/Helper.h"
 #include "network/NetworkRequest.h"
+#include "network/ScrapeStats.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/HtmlPattern.h"
+#include "scrapers/imdb/ImdbActorImageCache.h"
+#include "scrapers/imdb/ImdbRequestQueue.h"
 #include "scrapers/movie/IMDB.h"
 
 void ImdbMovieLoader::load()
 {
+    // Tag requests before clear() resets the title.
+    m_item = m_movie.name();
     m_movie.clear(m_infos);
     m_movie.setId(ImdbId(m_imdbId));
 
     QUrl url = QUrl(QString("https://www.imdb.com/title/%1/").arg(m_imdbId).toUtf8());
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     request.setRawHeader("Accept-Language", "en");
-    QNetworkReply* reply = m_qnam.get(request);
-    new NetworkReplyWatcher(this, reply);
-    connect(reply, &QNetworkReply::finished, this, &ImdbMovieLoader::onLoadFinished);
+    mediaelch::network::setRequestTag(request, {"IMDb", m_item, "infos"});
+    mediaelch::imdb::requestQueue().get(request, this, [this](QNetworkReply* reply) {
+        new NetworkReplyWatcher(this, reply);
+        connect(reply, &QNetworkReply::finished, this, &ImdbMovieLoader::onLoadFinished);
+    });
 }
 
 void ImdbMovieLoader::onLoadFinished()
@@ -35,15 +44,30 @@ void ImdbMovieLoader::onLoadFinished()
         return;
     }
 
-    QUrl posterViewerUrl;
-    {
-        const QString html = QString::fromUtf8(reply->readAll());
-        posterViewerUrl = parsePoster(html);
-        parseAndAssignInfos(html);
-        parseAndStoreActors(html);
+    const QString html = QString::fromUtf8(reply->readAll());
+    const QSet<MovieScraperInfos> infos = m_infos;
+    const bool loadAllTags = m_loadAllTags;
+    mediaelch::scraper::parseInBackground(
+        this,
+        [html, infos, loadAllTags]() {
+            ParsedPage page;
+            page.posterViewerUrl = parsePoster(html);
+            page.infos = IMDB::parseInfos(html, infos, loadAllTags);
+            page.actors = parseActors(html);
+            return page;
+        },
+        [this](const ParsedPage& page) { onPageParsed(page); });
+}
+
+void ImdbMovieLoader::onPageParsed(const ParsedPage& page)
+{
+    IMDB::assignInfos(page.infos, &m_movie);
+    for (const auto& actorUrl : page.actors) {
+        m_movie.addActor(actorUrl.first);
     }
+    m_actorUrls = page.actors;
 
-    const bool shouldLoadPoster = m_infos.contains(MovieScraperInfos::Poster) && !posterViewerUrl.isEmpty();
+    const bool shouldLoadPoster = m_infos.contains(MovieScraperInfos::Poster) && !page.posterViewerUrl.isEmpty();
     const bool shouldLoadTags = m_infos.contains(MovieScraperInfos::Tags) && m_loadAllTags;
     const bool shouldLoadActors = m_infos.contains(MovieScraperInfos::Actors) && !m_actorUrls.isEmpty();
 
@@ -64,7 +88,7 @@ void ImdbMovieLoader::onLoadFinished()
     }
 
     if (shouldLoadPoster) {
-        loadPoster(posterViewerUrl);
+        loadPoster(page.posterViewerUrl);
     }
     if (shouldLoadTags) {
         loadTags();
@@ -81,31 +105,30 @@ void ImdbMovieLoader::loadPoster(const QUrl& posterViewerUrl)
 {
     qDebug() << "[ImdbMovieLoader] Loading movie poster detail view";
     auto request = mediaelch::network::requestWithDefaults(posterViewerUrl);
-    QNetworkReply* posterReply = m_qnam.get(request);
-    new NetworkReplyWatcher(this, posterReply);
-    connect(posterReply, &QNetworkReply::finished, this, &ImdbMovieLoader::onPosterLoadFinished);
+    mediaelch::network::setRequestTag(request, {"IMDb", m_item, "poster"});
+    mediaelch::imdb::requestQueue().get(request, this, [this](QNetworkReply* posterReply) {
+        new NetworkReplyWatcher(this, posterReply);
+        connect(posterReply, &QNetworkReply::finished, this, &ImdbMovieLoader::onPosterLoadFinished);
+    });
 }
 
 void ImdbMovieLoader::loadTags()
 {
     QUrl tagsUrl(QStringLiteral("https://www.imdb.com/title/%1/keywords").arg(m_movie.imdbId().toString()));
     auto request = mediaelch::network::requestWithDefaults(tagsUrl);
-    QNetworkReply* tagsReply = m_qnam.get(request);
-    new NetworkReplyWatcher(this, tagsReply);
-    connect(tagsReply, &QNetworkReply::finished, this, &ImdbMovieLoader::onTagsFinished);
+    mediaelch::network::setRequestTag(request, {"IMDb", m_item, "tags"});
+    mediaelch::imdb::requestQueue().get(request, this, [this](QNetworkReply* tagsReply) {
+        new NetworkReplyWatcher(this, tagsReply);
+        connect(tagsReply, &QNetworkReply::finished, this, &ImdbMovieLoader::onTagsFinished);
+    });
 }
 
 void ImdbMovieLoader::loadActorImageUrls()
 {
+    // Actors that appeared in other movies are usually cached, so only few requests are sent.
     for (int index = 0; index < m_actorUrls.size(); ++index) {
-        auto request = mediaelch::network::requestWithDefaults(m_actorUrls[index].second);
-        // The actor's image should be the same for all languages. So we can
-        // just load the English version of the page.
-        request.setRawHeader("Accept-Language", "en");
-        QNetworkReply* reply = m_qnam.get(request);
-        new NetworkReplyWatcher(this, reply);
-        reply->setProperty("actorIndex", QVariant(index));
-        connect(reply, &QNetworkReply::finished, this, &ImdbMovieLoader::onActorImageUrlLoadDone);
+        mediaelch::imdb::ActorImageCache::instance().imageUrl(
+            m_actorUrls[index].second, this, [this, index](QString url) { onActorImageUrlLoadDone(index, url); });
     }
 }
 
@@ -152,148 +175,99 @@ void ImdbMovieLoader::onTagsFinished()
     decreaseDownloadCount();
 }
 
-void ImdbMovieLoader::onActorImageUrlLoadDone()
+void ImdbMovieLoader::onActorImageUrlLoadDone(int actorIndex, const QString& url)
 {
-    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    if (reply == nullptr) {
-        qCritical() << "[ImdbMovieLoader] onActorImageUrlLoadDone: reply was nullptr; Please report!";
-        decreaseDownloadCount();
-        return;
-    }
-    reply->deleteLater();
-
-    bool ok = false;
-    const int actorIndex = reply->property("actorIndex").toInt(&ok);
-
-    if (!ok) {
-        qCritical() << "[ImdbMovieLoader] onActorImageUrlLoadDone: Cannot get actor index; Please report!";
-        decreaseDownloadCount();
-        return;
-    }
-
     if (actorIndex < 0 || actorIndex >= m_actorUrls.size()) {
         qCritical() << "[ImdbMovieLoader] onActorImageUrlLoadDone: Actor index out of bounds; Please report!";
         decreaseDownloadCount();
         return;
     }
 
-    if (reply->error() != QNetworkReply::NoError) {
-        m_scraper.showNetworkError(*reply);
-        qWarning() << "[ImdbMovieLoader] Network Error (load poster)" << reply->errorString();
-        decreaseDownloadCount();
-        return;
-    }
-
-    const QString html = QString::fromUtf8(reply->readAll());
-    QString url = parseActorImageUrl(html);
     if (!url.isEmpty()) {
         m_actorUrls[actorIndex].first.thumb = url;
     }
     decreaseDownloadCount();
 }
 
-void ImdbMovieLoader::parseAndAssignInfos(const QString& html)
+QVector<QPair<Actor, QUrl>> ImdbMovieLoader::parseActors(const QString& html)
 {
-    m_scraper.parseAndAssignInfos(html, &m_movie, m_infos);
-}
-
-void ImdbMovieLoader::parseAndStoreActors(const QString& html)
-{
-    QRegExp rx;
-    rx.setMinimal(true);
-    rx.setPattern("<table class=\"cast_list\">(.*)</table>");
-    if (rx.indexIn(html) == -1) {
-        return;
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxCastList("<table class=\"cast_list\">(.*)</table>");
+    static const HtmlPattern rxRow(R"(<tr class="[^"]*">(.*)</tr>)");
+    static const HtmlPattern rxName(R"re(<a href="(/name/[^"]+)"\n *>([^<]*)</a>)re");
+    static const HtmlPattern rxRole(R"(<td class="character">\n *(.*)</td>)");
+    static const HtmlPattern rxRoleLink(R"(<a href="[^"]*" >([^<]*)</a>)");
+    static const HtmlPattern rxWhitespace("[\\s\\n]+", HtmlPattern::Matching::Greedy);
+    static const HtmlPattern rxImg("<img [^<]*loadlate=\"([^\"]*)\"[^<]* />");
+    static const HtmlPattern rxImgUrl("https://ia.media-imdb.com/images/(.*)/(.*)._V(.*).jpg");
+
+    QVector<QPair<Actor, QUrl>> actorUrls;
+    QRegularExpressionMatch match;
+    if (!rxCastList.find(html, match)) {
+        return actorUrls;
     }
 
-    QString content = rx.cap(1);
-    rx.setPattern(R"(<tr class="[^"]*">(.*)</tr>)");
-    int pos = 0;
-    while ((pos = rx.indexIn(content, pos)) != -1) {
-        QString actorHtml = rx.cap(1);
-        pos += rx.matchedLength();
-
+    const QStringList rows = rxRow.captureAll(match.captured(1));
+    for (const QString& actorHtml : rows) {
         QPair<Actor, QUrl> actorUrl;
 
-        QRegExp rxName(R"re(<a href="(/name/[^"]+)"\n *>([^<]*)</a>)re");
-        rxName.setMinimal(true);
-        if (rxName.indexIn(actorHtml) != -1) {
-            actorUrl.second = QUrl("https://www.imdb.com" + rxName.cap(1));
-            actorUrl.first.name = rxName.cap(2).trimmed();
+        if (rxName.find(actorHtml, match)) {
+            actorUrl.second = QUrl("https://www.imdb.com" + match.captured(1));
+            actorUrl.first.name = match.captured(2).trimmed();
         }
 
-        QRegExp rxRole(R"(<td class="character">\n *(.*)</td>)");
-        rxRole.setMinimal(true);
-        if (rxRole.indexIn(actorHtml) != -1) {
-            QString role = rxRole.cap(1);
-            rxRole.setPattern(R"(<a href="[^"]*" >([^<]*)</a>)");
-            if (rxRole.indexIn(role) != -1) {
-                role = rxRole.cap(1);
+        if (rxRole.find(actorHtml, match)) {
+            QString role = match.captured(1);
+            if (rxRoleLink.find(role, match)) {
+                role = match.captured(1);
             }
-            actorUrl.first.role = role.trimmed().replace(QRegExp("[\\s\\n]+"), " ");
+            actorUrl.first.role = rxWhitespace.replaced(role.trimmed(), " ");
         }
 
-        QRegExp rxImg("<img [^<]*loadlate=\"([^\"]*)\"[^<]* />");
-        rxImg.setMinimal(true);
-        if (rxImg.indexIn(actorHtml) != -1) {
-            QString img = rxImg.cap(1);
-            QRegExp aRx1("https://ia.media-imdb.com/images/(.*)/(.*)._V(.*).jpg");
-            aRx1.setMinimal(true);
-            if (aRx1.indexIn(img) != -1) {
-                actorUrl.first.thumb = "https://ia.media-imdb.com/images/" + aRx1.cap(1) + "/" + aRx1.cap(2) + ".jpg";
+        if (rxImg.find(actorHtml, match)) {
+            const QString img = match.captured(1);
+            if (rxImgUrl.find(img, match)) {
+                actorUrl.first.thumb =
+                    "https://ia.media-imdb.com/images/" + match.captured(1) + "/" + match.captured(2) + ".jpg";
             } else {
-                actorUrl.first.thumb = rxImg.cap(1);
+                actorUrl.first.thumb = img;
             }
         }
 
-        m_movie.addActor(actorUrl.first);
-        m_actorUrls.push_back(actorUrl);
+        actorUrls.push_back(actorUrl);
     }
+    return actorUrls;
 }
 
 QUrl ImdbMovieLoader::parsePoster(const QString& html)
 {
-    QRegExp rx("<div class=\"poster\">(.*)</div>");
-    rx.setMinimal(true);
-    if (rx.indexIn(html) == -1) {
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxPoster("<div class=\"poster\">(.*)</div>");
+    static const HtmlPattern rxTitle("<a href=\"/title/tt([^\"]*)\"[^>]*>");
+
+    QRegularExpressionMatch match;
+    if (!rxPoster.find(html, match)) {
         return QUrl();
     }
 
-    QString content = rx.cap(1);
-    rx.setPattern("<a href=\"/title/tt([^\"]*)\"[^>]*>");
-    if (rx.indexIn(content) == -1) {
+    const QString content = match.captured(1);
+    if (!rxTitle.find(content, match)) {
         return QUrl();
     }
 
-    return QString("https://www.imdb.com/title/tt%1").arg(rx.cap(1));
+    return QString("https://www.imdb.com/title/tt%1").arg(match.captured(1));
 }
 
 void ImdbMovieLoader::parseAndAssignTags(const QString& html)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
-    if (m_loadAllTags) {
-        rx.setPattern(R"(<a href="/search/keyword[^"]+"\n?>([^<]+)</a>)");
-    } else {
-        rx.setPattern(R"(<a href="/keyword/[^"]+"[^>]*>([^<]+)</a>)");
-    }
-
-    int pos = 0;
-    while ((pos = rx.indexIn(html, pos)) != -1) {
-        m_movie.addTag(rx.cap(1).trimmed());
-        pos += rx.matchedLength();
-    }
-}
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxAllTags(R"(<a href="/search/keyword[^"]+"\n?>([^<]+)</a>)");
+    static const HtmlPattern rxTags(R"(<a href="/keyword/[^"]+"[^>]*>([^<]+)</a>)");
 
-QString ImdbMovieLoader::parseActorImageUrl(const QString& html)
-{
-    QRegExp rx(R"re(<link rel=['"]image_src['"] href="([^"]+)">)re");
-    rx.setMinimal(true);
-    if (rx.indexIn(html) == -1) {
-        return "";
+    const HtmlPattern& rx = m_loadAllTags ? rxAllTags : rxTags;
+    for (const QString& tag : rx.captureAll(html)) {
+        m_movie.addTag(tag.trimmed());
     }
-
-    return rx.cap(1);
 }
 
 void ImdbMovieLoader::mergeActors()
@@ -319,15 +293,19 @@ void ImdbMovieLoader::parseAndAssignPoster(const QString& html, QString posterId
     //   "id":"rm2278496512","h":1000,"msrc":"https://m.media-amazon.com/images/M/<image>.jpg",
     //   "src":"https://m.media-amazon.com/images/M/<image>.jpg",
     //
-    QString regex = QStringLiteral(R"url("id":"%1","h":[0-9]+,"msrc":"([^"]+)","src":"([^"]+)")url");
-    QRegExp rx(regex.arg(posterId));
-    rx.setMinimal(true);
-
-    if (rx.indexIn(html) != -1) {
-        Poster p;
-        p.thumbUrl = rx.cap(1);
-        p.originalUrl = rx.cap(2);
-        m_movie.images().addPoster(p);
+    static const mediaelch::scraper::HtmlPattern rx(
+        R"url("id":"([^"]+)","h":[0-9]+,"msrc":"([^"]+)","src":"([^"]+)")url");
+
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        if (match.captured(1) == posterId) {
+            Poster p;
+            p.thumbUrl = match.captured(2);
+            p.originalUrl = match.captured(3);
+            m_movie.images().addPoster(p);
+            break;
+        }
     }
 }
 
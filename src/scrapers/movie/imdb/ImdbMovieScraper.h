@@ -4,10 +4,13 @@
 #include "globals/ScraperInfos.h"
 #include "movies/Movie.h"
 #include "network/NetworkReplyWatcher.h"
+#include "scrapers/movie/ScrapedMovieData.h"
 
-#include <QNetworkAccessManager>
 #include <QObject>
+#include <QPair>
 #include <QString>
+#include <QUrl>
+#include <QVector>
 
 class IMDB;
 
@@ -40,19 +43,27 @@ private slots:
     void onPosterLoadFinished();
     void onTagsFinished();
 
-    void onActorImageUrlLoadDone();
-
 private:
+    /// Infos of the movie's page, extracted on a worker thread.
+    struct ParsedPage
+    {
+        ScrapedMovieData infos;
+        QUrl posterViewerUrl;
+        QVector<QPair<Actor, QUrl>> actors;
+    };
+
+    void onPageParsed(const ParsedPage& page);
     void loadPoster(const QUrl& posterViewerUrl);
     void loadTags();
     void loadActorImageUrls();
+    void onActorImageUrlLoadDone(int actorIndex, const QString& url);
 
-    void parseAndAssignInfos(const QString& html);
     void parseAndAssignPoster(const QString& html, QString posterId);
-    void parseAndStoreActors(const QString& html);
-    QUrl parsePoster(const QString& html);
+    /// Thread-safe.
+    static QVector<QPair<Actor, QUrl>> parseActors(const QString& html);
+    /// Thread-safe.
+    static QUrl parsePoster(const QString& html);
     void parseAndAssignTags(const QString& html);
-    QString parseActorImageUrl(const QString& html);
 
     void mergeActors();
     void decreaseDownloadCount();
@@ -65,8 +76,9 @@ private:
     QString m_imdbId;
     Movie& m_movie;
     QSet<MovieScraperInfos> m_infos;
-    QNetworkAccessManager m_qnam;
     bool m_loadAllTags = false;
+    /// Name of the movie when loading started, used to tag requests.
+    QString m_item;
 
     QVector<QPair<Actor, QUrl>> m_actorUrls;
 };
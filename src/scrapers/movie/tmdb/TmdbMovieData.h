@@ -0,0 +1,55 @@
+#pragma once
+
+#include "data/Certification.h"
+#include "data/Rating.h"
+#include "globals/Actor.h"
+#include "globals/Poster.h"
+#include "movies/MovieSet.h"
+
+#include <QDate>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/// \brief Plain values of one TMDb movie response (infos, casts, trailers, images or releases).
+///
+/// Filled by TMDb::parseInfos() on a worker thread and assigned to a Movie on the GUI
+/// thread by TMDb::assignInfos().  Only the requested infos are parsed; everything else
+/// stays empty.  Names are not yet mapped (see helper::mapGenre() and others) because the
+/// mappings depend on the settings.
+struct TmdbMovieData
+{
+    bool isValid = false;
+
+    int tmdbId = -1;
+    QString imdbId;
+    QString title;
+    QString originalTitle;
+    bool hasCollection = false;
+    MovieSet collection;
+    /// HTML formatted
+    QString overview;
+    bool hasRating = false;
+    Rating rating;
+    QString tagline;
+    QDate released;
+    int runtime = -1;
+    QStringList genres;
+    QStringList studios;
+    QStringList countries;
+
+    bool hasCast = false;
+    QVector<Actor> actors;
+    QStringList writers;
+    QString director;
+
+    /// YouTube video id of the first trailer
+    QString youtubeTrailer;
+
+    QVector<Poster> backdrops;
+    QVector<Poster> posters;
+
+    /// Pairs of ISO 3166-1 country codes and certifications in the order of the response.
+    QVector<QPair<QString, Certification>> certifications;
+};
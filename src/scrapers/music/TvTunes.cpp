@@ -5,6 +5,7 @@
 #include <QRegExp>
 
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
 
@@ -25,7 +26,7 @@ void TvTunes::search(QString searchStr)
 
     QUrl url(QStringLiteral("https://www.televisiontunes.com/search.php?q=%1").arg(searchStr));
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = mediaelch::network::accessManager()->get(request);
     new NetworkReplyWatcher(this, reply);
     reply->setProperty("searchStr", searchStr);
     connect(reply, &QNetworkReply::finished, this, &TvTunes::onSearchFinished);
@@ -81,7 +82,8 @@ void TvTunes::getNextDownloadUrl(QString searchStr)
     }
 
     ScraperSearchResult res = m_queue.dequeue();
-    QNetworkReply* reply = m_qnam.get(mediaelch::network::requestWithDefaults(QUrl(res.id)));
+    QNetworkReply* reply =
+        mediaelch::network::accessManager()->get(mediaelch::network::requestWithDefaults(QUrl(res.id)));
     new NetworkReplyWatcher(this, reply);
     reply->setProperty("searchStr", searchStr);
     reply->setProperty("name", res.name);
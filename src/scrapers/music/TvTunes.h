@@ -22,7 +22,6 @@ private slots:
     void onDownloadUrlFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QVector<ScraperSearchResult> m_results;
     QQueue<ScraperSearchResult> m_queue;
     QString m_searchStr;
@@ -9,9 +9,12 @@
 #include <QJsonValue>
 #include <QLabel>
 #include <QMutexLocker>
+#include <QRegularExpression>
 
 #include "data/Storage.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkReplyWatcher.h"
+#include "scrapers/HtmlPattern.h"
 #include "ui/main/MainWindow.h"
 
 UniversalMusicScraper::UniversalMusicScraper(QObject* parent)
@@ -54,7 +57,7 @@ UniversalMusicScraper::UniversalMusicScraper(QObject* parent)
 
 QNetworkAccessManager* UniversalMusicScraper::qnam()
 {
-    return &m_qnam;
+    return mediaelch::network::accessManager();
 }
 
 QString UniversalMusicScraper::name() const
@@ -161,9 +164,10 @@ void UniversalMusicScraper::onArtistRelsFinished()
             QDomElement elem = domDoc.elementsByTagName("relation").at(i).toElement();
             if (elem.attribute("type") == "allmusic" && elem.elementsByTagName("target").count() > 0) {
                 QString url = elem.elementsByTagName("target").at(0).toElement().text();
-                QRegExp rx("allmusic\\.com/artist/(.*)$");
-                if (rx.indexIn(url) != -1) {
-                    artist->setAllMusicId(rx.cap(1));
+                static const QRegularExpression rx("allmusic\\.com/artist/(.*)$");
+                QRegularExpressionMatch match = rx.match(url);
+                if (match.hasMatch()) {
+                    artist->setAllMusicId(match.captured(1));
                 }
             }
             if (elem.attribute("type") == "discogs" && elem.elementsByTagName("target").count() > 0) {
@@ -326,16 +330,19 @@ void UniversalMusicScraper::searchAlbum(QString artistName, QString searchStr)
 {
     QString year;
     QString cleanSearchStr = searchStr;
-    QRegExp rx("^(.*)([0-9]{4})\\)?$");
-    rx.setMinimal(true);
-    if (rx.exactMatch(searchStr)) {
-        year = rx.cap(2);
-        cleanSearchStr = rx.cap(1);
-    }
-    rx.setPattern("^\\(?([0-9]{4})\\)?(.*)$");
-    if (rx.exactMatch(searchStr)) {
-        year = rx.cap(1);
-        cleanSearchStr = rx.cap(2);
+    static const QRegularExpression rxYearSuffix("^(.*)([0-9]{4})\\)?$",
+        QRegularExpression::DotMatchesEverythingOption | QRegularExpression::InvertedGreedinessOption);
+    static const QRegularExpression rxYearPrefix("^\\(?([0-9]{4})\\)?(.*)$",
+        QRegularExpression::DotMatchesEverythingOption | QRegularExpression::InvertedGreedinessOption);
+    QRegularExpressionMatch match = rxYearSuffix.match(searchStr);
+    if (match.hasMatch()) {
+        year = match.captured(2);
+        cleanSearchStr = match.captured(1);
+    }
+    match = rxYearPrefix.match(searchStr);
+    if (match.hasMatch()) {
+        year = match.captured(1);
+        cleanSearchStr = match.captured(2);
     }
     cleanSearchStr.replace("(", "");
     cleanSearchStr.replace(")", "");
@@ -488,9 +495,10 @@ void UniversalMusicScraper::onAlbumRelsFinished()
             QDomElement elem = domDoc.elementsByTagName("relation").at(i).toElement();
             if (elem.attribute("type") == "allmusic" && elem.elementsByTagName("target").count() > 0) {
                 QString url = elem.elementsByTagName("target").at(0).toElement().text();
-                QRegExp rx("allmusic\\.com/album/(.*)$");
-                if (rx.indexIn(url) != -1) {
-                    album->setAllMusicId(rx.cap(1));
+                static const QRegularExpression rx("allmusic\\.com/album/(.*)$");
+                QRegularExpressionMatch match = rx.match(url);
+                if (match.hasMatch()) {
+                    album->setAllMusicId(match.captured(1));
                 }
             }
             if (elem.attribute("type") == "discogs" && elem.elementsByTagName("target").count() > 0) {
@@ -705,167 +713,125 @@ void UniversalMusicScraper::parseAndAssignTadbDiscography(QJsonObject document,
 
 void UniversalMusicScraper::parseAndAssignAmInfos(QString html, Artist* artist, QSet<MusicScraperInfos> infos)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxName(R"(<h2 class="artist-name" itemprop="name">[\n\s]*(.*)[\n\s]*</h2>)");
+    static const HtmlPattern rxYearsActive("<h4>Active</h4>[\\n\\s]*<div>(.*)</div>");
+    static const HtmlPattern rxFormed(R"(<h4>[\n\s]*Formed[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxBorn(R"(<h4>[\n\s]*Born[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxDied(R"(<h4>[\n\s]*Died[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxDisbanded(R"(<h4>[\n\s]*Disbanded[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxGenres(R"(<h4>[\n\s]*Genre[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxGenre("<a[^>]*>(.*)</a>");
+    static const HtmlPattern rxStyles(R"(<h4>[\n\s]*Styles[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxMoods(R"(<h3 class="headline">Artists Moods</h3>[\n\s]*<ul>(.*)</ul>)");
+    static const HtmlPattern rxLink("<a [^>]*>(.*)</a>");
 
-    if (shouldLoad(MusicScraperInfos::Name, infos, artist)) {
-        rx.setPattern(R"(<h2 class="artist-name" itemprop="name">[\n\s]*(.*)[\n\s]*</h2>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setName(trim(rx.cap(1)));
-        }
+    QRegularExpressionMatch match;
+
+    if (shouldLoad(MusicScraperInfos::Name, infos, artist) && rxName.find(html, match)) {
+        artist->setName(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::YearsActive, infos, artist)) {
-        rx.setPattern("<h4>Active</h4>[\\n\\s]*<div>(.*)</div>");
-        if (rx.indexIn(html) != -1) {
-            artist->setYearsActive(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::YearsActive, infos, artist) && rxYearsActive.find(html, match)) {
+        artist->setYearsActive(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Formed, infos, artist)) {
-        rx.setPattern(R"(<h4>[\n\s]*Formed[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setFormed(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Formed, infos, artist) && rxFormed.find(html, match)) {
+        artist->setFormed(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Born, infos, artist)) {
-        rx.setPattern(R"(<h4>[\n\s]*Born[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setBorn(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Born, infos, artist) && rxBorn.find(html, match)) {
+        artist->setBorn(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Died, infos, artist)) {
-        rx.setPattern(R"(<h4>[\n\s]*Died[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setDied(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Died, infos, artist) && rxDied.find(html, match)) {
+        artist->setDied(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Disbanded, infos, artist)) {
-        rx.setPattern(R"(<h4>[\n\s]*Disbanded[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setDisbanded(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Disbanded, infos, artist) && rxDisbanded.find(html, match)) {
+        artist->setDisbanded(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Genres, infos, artist)) {
-        rx.setPattern(R"(<h4>[\n\s]*Genre[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString genres = rx.cap(1);
-            rx.setPattern("<a[^>]*>(.*)</a>");
-            int pos = 0;
-            while ((pos = rx.indexIn(genres, pos)) != -1) {
-                artist->addGenre(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Genres, infos, artist) && rxGenres.find(html, match)) {
+        for (const QString& genre : rxGenre.captureAll(match.captured(1))) {
+            artist->addGenre(trim(genre));
         }
     }
 
-    if (shouldLoad(MusicScraperInfos::Styles, infos, artist)) {
-        rx.setPattern(R"(<h4>[\n\s]*Styles[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString styles = rx.cap(1);
-            rx.setPattern("<a [^>]*>(.*)</a>");
-            int pos = 0;
-            while ((pos = rx.indexIn(styles, pos)) != -1) {
-                artist->addStyle(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Styles, infos, artist) && rxStyles.find(html, match)) {
+        for (const QString& style : rxLink.captureAll(match.captured(1))) {
+            artist->addStyle(trim(style));
         }
     }
 
-    if (shouldLoad(MusicScraperInfos::Moods, infos, artist)) {
-        rx.setPattern(R"(<h3 class="headline">Artists Moods</h3>[\n\s]*<ul>(.*)</ul>)");
-        if (rx.indexIn(html) != -1) {
-            QString moods = rx.cap(1);
-            rx.setPattern("<a [^>]*>(.*)</a>");
-            int pos = 0;
-            while ((pos = rx.indexIn(moods, pos)) != -1) {
-                artist->addMood(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Moods, infos, artist) && rxMoods.find(html, match)) {
+        for (const QString& mood : rxLink.captureAll(match.captured(1))) {
+            artist->addMood(trim(mood));
         }
     }
 }
 
 void UniversalMusicScraper::parseAndAssignAmBiography(QString html, Artist* artist, QSet<MusicScraperInfos> infos)
 {
-    if (shouldLoad(MusicScraperInfos::Biography, infos, artist)) {
-        QRegExp rx(R"(<div class="text" itemprop="reviewBody">(.*)</div>)");
-        rx.setMinimal(true);
-        if (rx.indexIn(html) != -1) {
-            QString biography = rx.cap(1);
-            biography.remove(QRegExp("<[^>]*>"));
-            artist->setBiography(trim(biography));
-        }
+    static const mediaelch::scraper::HtmlPattern rx(R"(<div class="text" itemprop="reviewBody">(.*)</div>)");
+    QRegularExpressionMatch match;
+    if (shouldLoad(MusicScraperInfos::Biography, infos, artist) && rx.find(html, match)) {
+        artist->setBiography(trim(mediaelch::scraper::removeHtmlTags(match.captured(1))));
     }
 }
 
 void UniversalMusicScraper::parseAndAssignAmDiscography(QString html, Artist* artist, QSet<MusicScraperInfos> infos)
 {
-    if (shouldLoad(MusicScraperInfos::Discography, infos, artist)) {
-        QRegExp rx("<td class=\"year\" data\\-sort\\-value=\"[^\"]*\">[\\n\\s]*(.*)[\\n\\s]*</td>[\\n\\s]*<td "
-                   "class=\"title\" data\\-sort\\-value=\"(.*)\">");
-        rx.setMinimal(true);
-        int pos = 0;
-        while ((pos = rx.indexIn(html, pos)) != -1) {
-            DiscographyAlbum a;
-            a.title = trim(rx.cap(2));
-            a.year = trim(rx.cap(1));
-            if (!a.title.isEmpty() || !a.year.isEmpty()) {
-                artist->addDiscographyAlbum(a);
-            }
-            pos += rx.matchedLength();
+    if (!shouldLoad(MusicScraperInfos::Discography, infos, artist)) {
+        return;
+    }
+
+    static const mediaelch::scraper::HtmlPattern rx(
+        "<td class=\"year\" data\\-sort\\-value=\"[^\"]*\">[\\n\\s]*(.*)[\\n\\s]*</td>[\\n\\s]*<td "
+        "class=\"title\" data\\-sort\\-value=\"(.*)\">");
+    QRegularExpressionMatchIterator it = rx.globalMatch(html);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        DiscographyAlbum a;
+        a.title = trim(match.captured(2));
+        a.year = trim(match.captured(1));
+        if (!a.title.isEmpty() || !a.year.isEmpty()) {
+            artist->addDiscographyAlbum(a);
         }
     }
 }
 
 void UniversalMusicScraper::parseAndAssignDiscogsInfos(QString html, Artist* artist, QSet<MusicScraperInfos> infos)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxName(R"(<div class="body">[\n\s]*<h1 class="hide_desktop">(.*)</h1>)");
+    static const HtmlPattern rxBiography(R"(<div [^>]* id="profile">[\n\s]*(.*)[\n\s]*</div>)");
+    static const HtmlPattern rxDiscography("<table [^>]* id=\"artist\">(.*)</table>");
+    static const HtmlPattern rxRow(R"(<tr[^>]*data\-object\-id="[^"]*"[^>]*>(.*)</tr>)");
+    static const HtmlPattern rxTitle(R"(<td class="title"[^>]*>.*<a href="[^"]*">(.*)</a>.*</td>)");
+    static const HtmlPattern rxYear(R"(<td class="year has_header" data\-header="Year: ">(.*)</td>)");
 
-    if (shouldLoad(MusicScraperInfos::Name, infos, artist)) {
-        rx.setPattern(R"(<div class="body">[\n\s]*<h1 class="hide_desktop">(.*)</h1>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setName(trim(rx.cap(1)));
-        }
-    }
+    QRegularExpressionMatch match;
 
-    if (shouldLoad(MusicScraperInfos::Biography, infos, artist)) {
-        rx.setPattern(R"(<div [^>]* id="profile">[\n\s]*(.*)[\n\s]*</div>)");
-        if (rx.indexIn(html) != -1) {
-            artist->setBiography(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Name, infos, artist) && rxName.find(html, match)) {
+        artist->setName(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Discography, infos, artist)) {
-        rx.setPattern("<table [^>]* id=\"artist\">(.*)</table>");
-        if (rx.indexIn(html) != -1) {
-            QString table = rx.cap(1);
-            rx.setPattern(R"(<tr[^>]*data\-object\-id="[^"]*"[^>]*>(.*)</tr>)");
-            int pos = 0;
-            while ((pos = rx.indexIn(table, pos)) != -1) {
-                QRegExp rx2(R"(<td class="title"[^>]*>.*<a href="[^"]*">(.*)</a>.*</td>)");
-                rx2.setMinimal(true);
-
-                DiscographyAlbum a;
-                if (rx2.indexIn(rx.cap(1)) != -1) {
-                    a.title = trim(rx2.cap(1));
-                }
-
-                rx2.setPattern(R"(<td class="year has_header" data\-header="Year: ">(.*)</td>)");
-                if (rx2.indexIn(rx.cap(1)) != -1) {
-                    a.year = trim(rx2.cap(1));
-                }
-
-                if (a.title != "" || a.year != "") {
-                    artist->addDiscographyAlbum(a);
-                }
+    if (shouldLoad(MusicScraperInfos::Biography, infos, artist) && rxBiography.find(html, match)) {
+        artist->setBiography(trim(match.captured(1)));
+    }
 
-                pos += rx.matchedLength();
+    if (shouldLoad(MusicScraperInfos::Discography, infos, artist) && rxDiscography.find(html, match)) {
+        for (const QString& row : rxRow.captureAll(match.captured(1))) {
+            DiscographyAlbum a;
+            if (rxTitle.find(row, match)) {
+                a.title = trim(match.captured(1));
+            }
+            if (rxYear.find(row, match)) {
+                a.year = trim(match.captured(1));
+            }
+            if (a.title != "" || a.year != "") {
+                artist->addDiscographyAlbum(a);
             }
         }
     }
@@ -994,146 +960,106 @@ void UniversalMusicScraper::parseAndAssignTadbInfos(QJsonObject document, Album*
 
 void UniversalMusicScraper::parseAndAssignAmInfos(QString html, Album* album, QSet<MusicScraperInfos> infos)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxTitle(R"(<h2 class="album-name" itemprop="name">[\n\s]*(.*)[\n\s]*</h2>)");
+    static const HtmlPattern rxArtist(
+        R"(<h3 class="album-artist"[^>]*>[\n\s]*<span itemprop="name">[\n\s]*<a [^>]*>(.*)</a>)");
+    static const HtmlPattern rxReview(R"(<div class="text" itemprop="reviewBody">(.*)</div>)");
+    static const HtmlPattern rxReleaseDate(R"(<h4>[\n\s]*Release Date[\n\s]*</h4>[\n\s]*<span>(.*)</span>)");
+    static const HtmlPattern rxRating("<div class=\"allmusic-rating rating-allmusic-\\d\" "
+                                      "itemprop=\"ratingValue\">[\\n\\s]*(\\d)[\\n\\s]*</div>");
+    static const HtmlPattern rxYear(R"(<h4>[\n\s]*Release Date[\n\s]*</h4>[\n\s]*<span>.*([0-9]{4}).*</span>)");
+    static const HtmlPattern rxGenres(R"(<h4>[\n\s]*Genre[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxGenre("<a[^>]*>(.*)</a>");
+    static const HtmlPattern rxStyles(R"(<h4>[\n\s]*Styles[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
+    static const HtmlPattern rxStyle("<a [^>]*>([^<]*)</a>");
+    static const HtmlPattern rxMoods("<h4>Album Moods</h4>[\\n\\s]*<div>(.*)</div>");
+    static const HtmlPattern rxMood("<a [^>]*>(.*)</a>");
 
-    if (shouldLoad(MusicScraperInfos::Title, infos, album)) {
-        rx.setPattern(R"(<h2 class="album-name" itemprop="name">[\n\s]*(.*)[\n\s]*</h2>)");
-        if (rx.indexIn(html) != -1) {
-            album->setTitle(trim(rx.cap(1)));
-        }
+    QRegularExpressionMatch match;
+
+    if (shouldLoad(MusicScraperInfos::Title, infos, album) && rxTitle.find(html, match)) {
+        album->setTitle(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Artist, infos, album)) {
-        rx.setPattern(R"(<h3 class="album-artist"[^>]*>[\n\s]*<span itemprop="name">[\n\s]*<a [^>]*>(.*)</a>)");
-        if (rx.indexIn(html) != -1) {
-            album->setArtist(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Artist, infos, album) && rxArtist.find(html, match)) {
+        album->setArtist(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Review, infos, album)) {
-        rx.setPattern(R"(<div class="text" itemprop="reviewBody">(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString review = rx.cap(1);
-            review.remove(QRegExp("<[^>]*>"));
-            album->setReview(trim(review));
-        }
+    if (shouldLoad(MusicScraperInfos::Review, infos, album) && rxReview.find(html, match)) {
+        album->setReview(trim(mediaelch::scraper::removeHtmlTags(match.captured(1))));
     }
 
-    if (shouldLoad(MusicScraperInfos::ReleaseDate, infos, album)) {
-        rx.setPattern(R"(<h4>[\n\s]*Release Date[\n\s]*</h4>[\n\s]*<span>(.*)</span>)");
-        if (rx.indexIn(html) != -1) {
-            album->setReleaseDate(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::ReleaseDate, infos, album) && rxReleaseDate.find(html, match)) {
+        album->setReleaseDate(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Rating, infos, album)) {
-        rx.setPattern("<div class=\"allmusic-rating rating-allmusic-\\d\" "
-                      "itemprop=\"ratingValue\">[\\n\\s]*(\\d)[\\n\\s]*</div>");
-        if (rx.indexIn(html) != -1) {
-            album->setRating(rx.cap(1).toDouble());
-        }
+    if (shouldLoad(MusicScraperInfos::Rating, infos, album) && rxRating.find(html, match)) {
+        album->setRating(match.captured(1).toDouble());
     }
 
-    if (shouldLoad(MusicScraperInfos::Year, infos, album)) {
-        rx.setPattern(R"(<h4>[\n\s]*Release Date[\n\s]*</h4>[\n\s]*<span>.*([0-9]{4}).*</span>)");
-        if (rx.indexIn(html) != -1) {
-            album->setYear(rx.cap(1).toInt());
-        }
+    if (shouldLoad(MusicScraperInfos::Year, infos, album) && rxYear.find(html, match)) {
+        album->setYear(match.captured(1).toInt());
     }
 
-    if (shouldLoad(MusicScraperInfos::Genres, infos, album)) {
-        rx.setPattern(R"(<h4>[\n\s]*Genre[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString genres = rx.cap(1);
-            rx.setPattern("<a[^>]*>(.*)</a>");
-            int pos = 0;
-            while ((pos = rx.indexIn(genres, pos)) != -1) {
-                album->addGenre(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Genres, infos, album) && rxGenres.find(html, match)) {
+        for (const QString& genre : rxGenre.captureAll(match.captured(1))) {
+            album->addGenre(trim(genre));
         }
     }
 
-    if (shouldLoad(MusicScraperInfos::Styles, infos, album)) {
-        rx.setPattern(R"(<h4>[\n\s]*Styles[\n\s]*</h4>[\n\s]*<div>(.*)</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString styles = rx.cap(1);
-            rx.setPattern("<a [^>]*>([^<]*)</a>");
-            int pos = 0;
-            while ((pos = rx.indexIn(styles, pos)) != -1) {
-                album->addStyle(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Styles, infos, album) && rxStyles.find(html, match)) {
+        for (const QString& style : rxStyle.captureAll(match.captured(1))) {
+            album->addStyle(trim(style));
         }
     }
 
-    if (shouldLoad(MusicScraperInfos::Moods, infos, album)) {
-        rx.setPattern("<h4>Album Moods</h4>[\\n\\s]*<div>(.*)</div>");
-        if (rx.indexIn(html) != -1) {
-            QString moods = rx.cap(1);
-            rx.setPattern("<a [^>]*>(.*)</a>");
-            int pos = 0;
-            while ((pos = rx.indexIn(moods, pos)) != -1) {
-                album->addMood(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Moods, infos, album) && rxMoods.find(html, match)) {
+        for (const QString& mood : rxMood.captureAll(match.captured(1))) {
+            album->addMood(trim(mood));
         }
     }
 }
 
 void UniversalMusicScraper::parseAndAssignDiscogsInfos(QString html, Album* album, QSet<MusicScraperInfos> infos)
 {
-    QRegExp rx;
-    rx.setMinimal(true);
+    using mediaelch::scraper::HtmlPattern;
+    static const HtmlPattern rxArtist(
+        "<span itemprop=\"byArtist\" itemscope itemtype=\"http://schema.org/MusicGroup\">[\\n\\s]*<span "
+        "itemprop=\"name\" title=\"(.*)\" >");
+    static const HtmlPattern rxTitle(R"(<span itemprop="name">[\n\s]*(.*)[\n\s]*</span>)");
+    static const HtmlPattern rxGenres(R"(<div class="content" itemprop="genre">[\n\s]*(.*)[\n\s]*</div>)");
+    static const HtmlPattern rxGenre(R"(<a href="[^"]*">([^<]*)</a>)");
+    static const HtmlPattern rxStyles(
+        R"(<div class="head">Style:</div>[\n\s]*<div class="content">[\n\s]*(.*)[\n\s]*</div>)");
+    static const HtmlPattern rxStyle(R"(<a href="[^"]*">(.*)</a>)");
+    static const HtmlPattern rxYear("<div class=\"head\">Year:</div>[\\n\\s]*<div class=\"content\">[\\n\\s]*<a "
+                                    "href=\"[^\"]*\">(.*)</a>[\\n\\s]*</div>");
 
-    if (shouldLoad(MusicScraperInfos::Artist, infos, album)) {
-        rx.setPattern("<span itemprop=\"byArtist\" itemscope itemtype=\"http://schema.org/MusicGroup\">[\\n\\s]*<span "
-                      "itemprop=\"name\" title=\"(.*)\" >");
-        if (rx.indexIn(html) != -1) {
-            album->setArtist(trim(rx.cap(1)));
-        }
+    QRegularExpressionMatch match;
+
+    if (shouldLoad(MusicScraperInfos::Artist, infos, album) && rxArtist.find(html, match)) {
+        album->setArtist(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Title, infos, album)) {
-        rx.setPattern(R"(<span itemprop="name">[\n\s]*(.*)[\n\s]*</span>)");
-        if (rx.indexIn(html) != -1) {
-            album->setTitle(trim(rx.cap(1)));
-        }
+    if (shouldLoad(MusicScraperInfos::Title, infos, album) && rxTitle.find(html, match)) {
+        album->setTitle(trim(match.captured(1)));
     }
 
-    if (shouldLoad(MusicScraperInfos::Genres, infos, album)) {
-        rx.setPattern(R"(<div class="content" itemprop="genre">[\n\s]*(.*)[\n\s]*</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString genres = rx.cap(1);
-            rx.setPattern(R"(<a href="[^"]*">([^<]*)</a>)");
-            int pos = 0;
-            while ((pos = rx.indexIn(genres, pos)) != -1) {
-                album->addGenre(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Genres, infos, album) && rxGenres.find(html, match)) {
+        for (const QString& genre : rxGenre.captureAll(match.captured(1))) {
+            album->addGenre(trim(genre));
         }
     }
 
-    if (shouldLoad(MusicScraperInfos::Styles, infos, album)) {
-        rx.setPattern(R"(<div class="head">Style:</div>[\n\s]*<div class="content">[\n\s]*(.*)[\n\s]*</div>)");
-        if (rx.indexIn(html) != -1) {
-            QString styles = rx.cap(1);
-            rx.setPattern(R"(<a href="[^"]*">(.*)</a>)");
-            int pos = 0;
-            while ((pos = rx.indexIn(styles, pos)) != -1) {
-                album->addStyle(trim(rx.cap(1)));
-                pos += rx.matchedLength();
-            }
+    if (shouldLoad(MusicScraperInfos::Styles, infos, album) && rxStyles.find(html, match)) {
+        for (const QString& style : rxStyle.captureAll(match.captured(1))) {
+            album->addStyle(trim(style));
         }
     }
 
-    if (shouldLoad(MusicScraperInfos::Year, infos, album)) {
-        rx.setPattern("<div class=\"head\">Year:</div>[\\n\\s]*<div class=\"content\">[\\n\\s]*<a "
-                      "href=\"[^\"]*\">(.*)</a>[\\n\\s]*</div>");
-        if (rx.indexIn(html) != -1) {
-            album->setYear(trim(rx.cap(1)).toInt());
-        }
+    if (shouldLoad(MusicScraperInfos::Year, infos, album) && rxYear.find(html, match)) {
+        album->setYear(trim(match.captured(1)).toInt());
     }
 }
 
@@ -1202,7 +1128,8 @@ QWidget* UniversalMusicScraper::settingsWidget()
 
 QString UniversalMusicScraper::trim(QString text)
 {
-    return text.replace(QRegExp("\\s{1,}"), " ").trimmed();
+    static const QRegularExpression rxWhitespace("\\s{1,}");
+    return text.replace(rxWhitespace, " ").trimmed();
 }
 
 bool UniversalMusicScraper::shouldLoad(MusicScraperInfos info, QSet<MusicScraperInfos> infos, Album* album)
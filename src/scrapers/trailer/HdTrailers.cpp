@@ -4,10 +4,11 @@
 #include <QRegExp>
 
 #include "globals/Helper.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
 
 HdTrailers::HdTrailers(QObject* parent) :
-    m_qnam{new QNetworkAccessManager(this)}, m_searchReply{nullptr}, m_loadReply{nullptr}
+    m_qnam{mediaelch::network::accessManager()}, m_searchReply{nullptr}, m_loadReply{nullptr}
 {
     setParent(parent);
     m_libraryPages.enqueue('0');
@@ -8,6 +8,8 @@
 #include "movies/Movie.h"
 #include "network/NetworkReplyWatcher.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/BackgroundParser.h"
+#include "scrapers/imdb/ImdbRequestQueue.h"
 #include "scrapers/movie/IMDB.h"
 #include "scrapers/tv_show/thetvdb/Cache.h"
 #include "scrapers/tv_show/thetvdb/EpisodeLoader.h"
@@ -137,30 +139,33 @@ void TheTvDb::loadShowFromImdb(TvShow& show,
     auto request = mediaelch::network::requestWithDefaults(url);
     request.setRawHeader("Accept-Language", "en;q=0.8");
 
-    QNetworkReply* reply = m_qnam.get(request);
-    new NetworkReplyWatcher(this, reply);
+    mediaelch::imdb::requestQueue().get(request, this, [=, &show](QNetworkReply* reply) {
+        new NetworkReplyWatcher(this, reply);
 
-    connect(reply, &QNetworkReply::finished, this, [=, &show]() {
-        reply->deleteLater();
+        connect(reply, &QNetworkReply::finished, this, [=, &show]() {
+            reply->deleteLater();
 
-        if (reply->error() != QNetworkReply::NoError) {
-            showNetworkError(*reply);
-            qWarning() << "[TheTvDb] Network Error (load imdb):" << reply->errorString();
-            show.scraperLoadDone(); // avoid endless "loading..." message in case of an error
-            return;
-        }
+            if (reply->error() != QNetworkReply::NoError) {
+                showNetworkError(*reply);
+                qWarning() << "[TheTvDb] Network Error (load imdb):" << reply->errorString();
+                show.scraperLoadDone(); // avoid endless "loading..." message in case of an error
+                return;
+            }
 
-        const QString html = QString::fromUtf8(reply->readAll());
-        parseAndAssignImdbInfos(html, show, updateType, infosToLoad);
+            const QString html = QString::fromUtf8(reply->readAll());
+            parseImdbInfos(html, [=, &show]() {
+                assignImdbInfos(show, updateType, infosToLoad);
 
-        // Can't load episodes from IMDb without an IMDb id...
-        if (!show.imdbId().isValid()) {
-            show.scraperLoadDone();
-            return;
-        }
+                // Can't load episodes from IMDb without an IMDb id...
+                if (!show.imdbId().isValid()) {
+                    show.scraperLoadDone();
+                    return;
+                }
 
-        show.setProperty("episodesToLoadCount", episodesToLoad.count());
-        loadEpisodesFromImdb(show, episodesToLoad, infosToLoad);
+                show.setProperty("episodesToLoadCount", episodesToLoad.count());
+                loadEpisodesFromImdb(show, episodesToLoad, infosToLoad);
+            });
+        });
     });
 }
 
@@ -182,14 +187,16 @@ void TheTvDb::loadEpisodesFromImdb(TvShow& show, QVector<TvShowEpisode*> episode
         auto request = mediaelch::network::requestWithDefaults(url);
         request.setRawHeader("Accept-Language", "en;q=0.8");
 
-        QNetworkReply* reply = m_qnam.get(request);
-        reply->setProperty("storage", Storage::toVariant(reply, episode));
-        reply->setProperty("show", Storage::toVariant(reply, &show));
-        reply->setProperty("episodes", Storage::toVariant(reply, episodes));
-        reply->setProperty("infosToLoad", Storage::toVariant(reply, infosToLoad));
+        mediaelch::imdb::requestQueue().get(
+            request, this, [this, episode, &show, episodes, infosToLoad](QNetworkReply* reply) {
+                reply->setProperty("storage", Storage::toVariant(reply, episode));
+                reply->setProperty("show", Storage::toVariant(reply, &show));
+                reply->setProperty("episodes", Storage::toVariant(reply, episodes));
+                reply->setProperty("infosToLoad", Storage::toVariant(reply, infosToLoad));
 
-        new NetworkReplyWatcher(this, reply);
-        connect(reply, &QNetworkReply::finished, this, &TheTvDb::onEpisodesImdbEpisodeLoaded);
+                new NetworkReplyWatcher(this, reply);
+                connect(reply, &QNetworkReply::finished, this, &TheTvDb::onEpisodesImdbEpisodeLoaded);
+            });
     };
 
     if (episode->imdbId().isValid()) {
@@ -214,14 +221,16 @@ void TheTvDb::loadEpisodesFromImdb(TvShow& show, QVector<TvShowEpisode*> episode
     QNetworkRequest request{url};
     request.setRawHeader("Accept-Language", "en;q=0.8");
 
-    QNetworkReply* reply = m_qnam.get(request);
-    reply->setProperty("storage", Storage::toVariant(reply, episode));
-    reply->setProperty("show", Storage::toVariant(reply, &show));
-    reply->setProperty("episodes", Storage::toVariant(reply, episodes));
-    reply->setProperty("infosToLoad", Storage::toVariant(reply, infosToLoad));
+    mediaelch::imdb::requestQueue().get(
+        request, this, [this, episode, &show, episodes, infosToLoad](QNetworkReply* reply) {
+            reply->setProperty("storage", Storage::toVariant(reply, episode));
+            reply->setProperty("show", Storage::toVariant(reply, &show));
+            reply->setProperty("episodes", Storage::toVariant(reply, episodes));
+            reply->setProperty("infosToLoad", Storage::toVariant(reply, infosToLoad));
 
-    new NetworkReplyWatcher(this, reply);
-    connect(reply, &QNetworkReply::finished, this, &TheTvDb::onEpisodesImdbSeasonLoaded);
+            new NetworkReplyWatcher(this, reply);
+            connect(reply, &QNetworkReply::finished, this, &TheTvDb::onEpisodesImdbSeasonLoaded);
+        });
 }
 
 
@@ -278,14 +287,23 @@ void TheTvDb::setupLayout()
     m_widget->setLayout(layout);
 }
 
-void TheTvDb::parseAndAssignImdbInfos(const QString& html,
-    TvShow& show,
-    TvShowUpdateType updateType,
-    QSet<ShowScraperInfos> infosToLoad)
+void TheTvDb::parseImdbInfos(const QString& html, std::function<void()> done)
 {
-    m_dummyMovie->clear();
-    m_imdb->parseAndAssignInfos(html, m_dummyMovie, m_movieInfos);
+    const QSet<MovieScraperInfos> infos = m_movieInfos;
+    const bool loadAllTags = m_imdb->loadsAllTags();
+    mediaelch::scraper::parseInBackground(
+        this,
+        [html, infos, loadAllTags]() { return IMDB::parseInfos(html, infos, loadAllTags); },
+        [this, done](const ScrapedMovieData& data) {
+            // m_dummyMovie is shared by all loads, so it is only filled right before it is read.
+            m_dummyMovie->clear();
+            IMDB::assignInfos(data, m_dummyMovie);
+            done();
+        });
+}
 
+void TheTvDb::assignImdbInfos(TvShow& show, TvShowUpdateType updateType, QSet<ShowScraperInfos> infosToLoad)
+{
     if (!isShowUpdateType(updateType)) {
         return;
     }
@@ -372,11 +390,8 @@ void TheTvDb::fillDatabaseWithAllEpisodes(TvShow& show, std::function<void()> ca
     loader->loadShowAndEpisodes();
 }
 
-void TheTvDb::parseAndAssignImdbInfos(const QString& html, TvShowEpisode& episode, QSet<ShowScraperInfos> infosToLoad)
+void TheTvDb::assignImdbInfos(TvShowEpisode& episode, QSet<ShowScraperInfos> infosToLoad)
 {
-    m_dummyMovie->clear();
-    m_imdb->parseAndAssignInfos(html, m_dummyMovie, m_movieInfos);
-
     if (shouldLoadFromImdb(ShowScraperInfos::Title, infosToLoad) && !m_dummyMovie->name().isEmpty()) {
         episode.setTitle(m_dummyMovie->name());
     }
@@ -476,12 +491,13 @@ void TheTvDb::onImdbSeasonLoaded()
     auto request = mediaelch::network::requestWithDefaults(url);
     request.setRawHeader("Accept-Language", "en;q=0.8");
 
-    QNetworkReply* imdbReply = m_qnam.get(request);
-    new NetworkReplyWatcher(this, imdbReply);
-    imdbReply->setProperty("storage", Storage::toVariant(imdbReply, episode));
-    imdbReply->setProperty("infosToLoad", Storage::toVariant(imdbReply, infos));
+    mediaelch::imdb::requestQueue().get(request, this, [this, episode, infos](QNetworkReply* imdbReply) {
+        new NetworkReplyWatcher(this, imdbReply);
+        imdbReply->setProperty("storage", Storage::toVariant(imdbReply, episode));
+        imdbReply->setProperty("infosToLoad", Storage::toVariant(imdbReply, infos));
 
-    connect(imdbReply, &QNetworkReply::finished, this, &TheTvDb::onImdbEpisodeLoaded);
+        connect(imdbReply, &QNetworkReply::finished, this, &TheTvDb::onImdbEpisodeLoaded);
+    });
 }
 
 
@@ -523,13 +539,16 @@ void TheTvDb::onEpisodesImdbSeasonLoaded()
         auto request = mediaelch::network::requestWithDefaults(url);
         request.setRawHeader("Accept-Language", "en;q=0.8");
 
-        QNetworkReply* episodeImdbReply = m_qnam.get(request);
-        new NetworkReplyWatcher(this, episodeImdbReply);
-        episodeImdbReply->setProperty("storage", Storage::toVariant(episodeImdbReply, episode));
-        episodeImdbReply->setProperty("show", Storage::toVariant(episodeImdbReply, show));
-        episodeImdbReply->setProperty("episodes", Storage::toVariant(episodeImdbReply, episodes));
-        episodeImdbReply->setProperty("infosToLoad", Storage::toVariant(episodeImdbReply, infosToLoad));
-        connect(episodeImdbReply, &QNetworkReply::finished, this, &TheTvDb::onEpisodesImdbEpisodeLoaded);
+        mediaelch::imdb::requestQueue().get(
+            request, this, [this, episode, show, episodes, infosToLoad](QNetworkReply* episodeImdbReply) {
+                new NetworkReplyWatcher(this, episodeImdbReply);
+                episodeImdbReply->setProperty("storage", Storage::toVariant(episodeImdbReply, episode));
+                episodeImdbReply->setProperty("show", Storage::toVariant(episodeImdbReply, show));
+                episodeImdbReply->setProperty("episodes", Storage::toVariant(episodeImdbReply, episodes));
+                episodeImdbReply->setProperty("infosToLoad", Storage::toVariant(episodeImdbReply, infosToLoad));
+                connect(
+                    episodeImdbReply, &QNetworkReply::finished, this, &TheTvDb::onEpisodesImdbEpisodeLoaded);
+            });
         return;
     }
 
@@ -558,8 +577,10 @@ void TheTvDb::onImdbEpisodeLoaded()
     }
 
     const QString html = QString::fromUtf8(reply->readAll());
-    parseAndAssignImdbInfos(html, *episode, infosToLoad);
-    episode->scraperLoadDone();
+    parseImdbInfos(html, [this, episode, infosToLoad]() {
+        assignImdbInfos(*episode, infosToLoad);
+        episode->scraperLoadDone();
+    });
 }
 
 
@@ -577,15 +598,18 @@ void TheTvDb::onEpisodesImdbEpisodeLoaded()
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        const QString data = QString::fromUtf8(reply->readAll());
-        parseAndAssignImdbInfos(data, *episode, infos);
-
-    } else {
+    if (reply->error() != QNetworkReply::NoError) {
         showNetworkError(*reply);
         qWarning() << "Network Error (load)" << reply->errorString();
+        loadEpisodesFromImdb(*show, episodes, infos);
+        return;
     }
-    loadEpisodesFromImdb(*show, episodes, infos);
+
+    const QString data = QString::fromUtf8(reply->readAll());
+    parseImdbInfos(data, [this, episode, episodes, infos, show]() {
+        assignImdbInfos(*episode, infos);
+        loadEpisodesFromImdb(*show, episodes, infos);
+    });
 }
 
 ImdbId TheTvDb::getImdbIdForEpisode(const QString& html, EpisodeNumber episodeNumber)
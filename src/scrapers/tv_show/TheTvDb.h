@@ -10,7 +10,6 @@
 #include <QComboBox>
 #include <QDomElement>
 #include <QList>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
 #include <QString>
@@ -57,7 +56,6 @@ private slots:
 
 private:
     QString m_language{"en"};
-    QNetworkAccessManager m_qnam;
 
     // UI
     QComboBox* m_languageComboBox = nullptr;
@@ -70,11 +68,10 @@ private:
     void setupLanguages();
     void setupLayout();
 
-    void parseAndAssignImdbInfos(const QString& html,
-        TvShow& show,
-        TvShowUpdateType updateType,
-        QSet<ShowScraperInfos> infosToLoad);
-    void parseAndAssignImdbInfos(const QString& html, TvShowEpisode& episode, QSet<ShowScraperInfos> infosToLoad);
+    /// Parses the IMDb page on a worker thread, assigns it to m_dummyMovie and calls \p done.
+    void parseImdbInfos(const QString& html, std::function<void()> done);
+    void assignImdbInfos(TvShow& show, TvShowUpdateType updateType, QSet<ShowScraperInfos> infosToLoad);
+    void assignImdbInfos(TvShowEpisode& episode, QSet<ShowScraperInfos> infosToLoad);
 
     void loadEpisodesFromImdb(TvShow& show, QVector<TvShowEpisode*> episodes, QSet<ShowScraperInfos> infosToLoad);
     void loadShowFromImdb(TvShow& show,
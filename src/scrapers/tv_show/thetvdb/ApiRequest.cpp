@@ -1,9 +1,12 @@
 #include "ApiRequest.h"
 
 #include "globals/JsonRequest.h"
+#include "network/NetworkManager.h"
+#include "network/ScrapeStats.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QStringList>
 #include <QUrl>
 
 namespace thetvdb {
@@ -20,6 +23,23 @@ QUrl ApiRequest::getFullAssetUrl(const QString& suffix)
     return QUrl("https://www.thetvdb.com" + suffix);
 }
 
+/// @brief Returns the phase of scraping that a request to \p url belongs to,
+/// e.g. "actors" for "/series/1234/actors".
+static QString phaseForUrl(const QUrl& url)
+{
+    const QStringList path = url.path().split('/', QString::SkipEmptyParts);
+    if (path.isEmpty()) {
+        return QStringLiteral("request");
+    }
+    if (path.first() == "series") {
+        return path.size() > 2 ? path.at(2) : QStringLiteral("infos");
+    }
+    if (path.first() == "episodes") {
+        return QStringLiteral("episode");
+    }
+    return path.first();
+}
+
 void ApiRequest::sendGetRequest(const QUrl& url, std::function<void(QString)> callback)
 {
     if (thetvdb::hasValidCacheElement(url)) {
@@ -30,11 +50,14 @@ void ApiRequest::sendGetRequest(const QUrl& url, std::function<void(QString)> ca
     obtainJsonWebToken([=]() {
         QNetworkRequest request(url);
         addHeadersToRequest(request);
+        mediaelch::network::setRequestTag(request, {"TheTvDb", m_item, phaseForUrl(url)});
 
-        QNetworkReply* reply(m_qnam.get(request));
+        QNetworkReply* reply(mediaelch::network::accessManager()->get(request));
         new NetworkReplyWatcher(this, reply);
+        // The shared access manager does not delete the reply together with this request.
+        connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
 
-        connect(reply, &QNetworkReply::finished, [reply, callback]() {
+        connect(reply, &QNetworkReply::finished, this, [reply, callback]() {
             QString data{"{}"};
             if (reply->error() == QNetworkReply::NoError) {
                 data = QString::fromUtf8(reply->readAll());
@@ -43,13 +43,15 @@ public:
     static QUrl getFullAssetUrl(const QString& suffix);
 
     void sendGetRequest(const QUrl& url, std::function<void(QString)> callback);
+    /// @brief Set the item (e.g. the TV show's title) that requests are tagged with.
+    void setItem(const QString& item) { m_item = item; }
 
 private:
     void obtainJsonWebToken(std::function<void()> callback);
     void addHeadersToRequest(QNetworkRequest& request);
 
     const QString m_language;
-    QNetworkAccessManager m_qnam;
+    QString m_item;
 };
 
 } // namespace thetvdb
@@ -1,5 +1,6 @@
 #include "EpisodeLoader.h"
 
+#include "scrapers/BackgroundParser.h"
 #include "scrapers/tv_show/thetvdb/ApiRequest.h"
 #include "scrapers/tv_show/thetvdb/EpisodeParser.h"
 #include "settings/Settings.h"
@@ -34,6 +35,7 @@ EpisodeLoader::EpisodeLoader(TvDbId showId,
     m_infosToLoad{std::move(infosToLoad)}
 {
     setParent(parent);
+    m_apiRequest.setItem(episode.tvShow() != nullptr ? episode.tvShow()->title() : episode.title());
 }
 
 void EpisodeLoader::loadData()
@@ -60,9 +62,15 @@ void EpisodeLoader::loadSeason()
 void EpisodeLoader::loadEpisode()
 {
     m_apiRequest.sendGetRequest(getEpisodeUrl(), [this](QString json) {
-        EpisodeParser parser(m_episode, m_infosToLoad);
-        parser.parseInfos(json);
-        emit sigLoadDone();
+        const SeasonOrder order = Settings::instance()->seasonOrder();
+        mediaelch::scraper::parseInBackground(
+            this,
+            [json, order]() { return EpisodeParser::parseData(json, order); },
+            [this](const EpisodeData& data) {
+                EpisodeParser parser(m_episode, m_infosToLoad);
+                parser.assign(data);
+                emit sigLoadDone();
+            });
     });
 }
 
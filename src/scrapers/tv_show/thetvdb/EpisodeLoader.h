@@ -42,7 +42,6 @@ signals:
     void sigLoadDone();
 
 private:
-    QNetworkAccessManager m_qnam;
     QSet<ShowScraperInfos> m_loaded;
 
     TvDbId m_showId;
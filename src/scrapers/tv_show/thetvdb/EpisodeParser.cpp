@@ -11,7 +11,7 @@
 
 namespace thetvdb {
 
-void EpisodeParser::parseInfos(const QString& json)
+EpisodeData EpisodeParser::parseData(const QString& json, SeasonOrder order)
 {
     QJsonParseError parseError{};
     const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
@@ -19,75 +19,95 @@ void EpisodeParser::parseInfos(const QString& json)
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "[TheTvDb][EpisodeParser] Error parsing TheTvDb episode data:" << parseError.errorString();
-        return;
+        return {};
     }
 
-    parseInfos(episodeObj);
+    return parseData(episodeObj, order);
 }
 
-void EpisodeParser::parseInfos(const QJsonObject& episodeObj)
+EpisodeData EpisodeParser::parseData(const QJsonObject& episodeObj, SeasonOrder order)
 {
-    m_episode.setTvdbId(TvDbId(episodeObj.value("id").toInt()));
-    m_episode.setImdbId(ImdbId(episodeObj.value("imdbId").toString()));
+    EpisodeData data;
+    data.isValid = true;
+    data.tvdbId = TvDbId(episodeObj.value("id").toInt());
+    data.imdbId = ImdbId(episodeObj.value("imdbId").toString());
+
+    const bool isDvdOrder = (order == SeasonOrder::Dvd);
+    const auto season = episodeObj.value(isDvdOrder ? "dvdSeason" : "airedSeason").toInt(-1);
+    data.season = season >= 0 ? SeasonNumber(season) : SeasonNumber::NoSeason;
+    const auto episode = episodeObj.value(isDvdOrder ? "dvdEpisodeNumber" : "airedEpisodeNumber").toInt(-1);
+    data.episode = episode >= 0 ? EpisodeNumber(episode) : EpisodeNumber::NoEpisode;
+
+    const auto directorsArray = episodeObj.value("directors").toArray();
+    for (const auto& directorValue : directorsArray) {
+        QString director = directorValue.toString().trimmed();
+        if (!director.isEmpty()) {
+            data.directors.append(director);
+        }
+    }
+    data.title = episodeObj.value("episodeName").toString();
+    // TheTVDb month and day don't have a leading zero
+    data.firstAired = QDate::fromString(episodeObj.value("firstAired").toString(), "yyyy-M-d");
+    data.overview = episodeObj.value("overview").toString();
 
-    const bool isDvdOrder = (Settings::instance()->seasonOrder() == SeasonOrder::Dvd);
+    data.rating.rating = episodeObj.value("siteRating").toDouble();
+    data.rating.voteCount = episodeObj.value("siteRatingCount").toInt();
+    data.rating.maxRating = 10;
+    data.rating.minRating = 0;
+    data.rating.source = "tvdb";
+
+    const auto writersArray = episodeObj.value("writers").toArray();
+    for (const auto& writerValue : writersArray) {
+        QString writer = writerValue.toString().trimmed();
+        if (!writer.isEmpty()) {
+            data.writers.append(writer);
+        }
+    }
+    data.thumbnail =
+        ApiRequest::getFullAssetUrl(QStringLiteral("/banners/%2").arg(episodeObj.value("filename").toString()));
+
+    return data;
+}
+
+void EpisodeParser::assign(const EpisodeData& data)
+{
+    if (!data.isValid) {
+        return;
+    }
+
+    m_episode.setTvdbId(data.tvdbId);
+    m_episode.setImdbId(data.imdbId);
 
     // See TvShowEpisode constructor for initial values
     if (m_episode.seasonNumber() == SeasonNumber::NoSeason) {
-        const auto season = episodeObj.value(isDvdOrder ? "dvdSeason" : "airedSeason").toInt(-1);
-        m_episode.setSeason(season >= 0 ? SeasonNumber(season) : SeasonNumber::NoSeason);
+        m_episode.setSeason(data.season);
     }
     if (m_episode.episodeNumber() == EpisodeNumber::NoEpisode) {
-        const auto episode = episodeObj.value(isDvdOrder ? "dvdEpisodeNumber" : "airedEpisodeNumber").toInt(-1);
-        m_episode.setEpisode(episode >= 0 ? EpisodeNumber(episode) : EpisodeNumber::NoEpisode);
+        m_episode.setEpisode(data.episode);
     }
 
     if (m_infosToLoad.contains(ShowScraperInfos::Director)) {
-        QStringList directors;
-        const auto directorsArray = episodeObj.value("directors").toArray();
-        for (const auto& directorValue : directorsArray) {
-            QString director = directorValue.toString().trimmed();
-            if (!director.isEmpty()) {
-                directors.append(director);
-            }
-        }
-        m_episode.setDirectors(directors);
+        m_episode.setDirectors(data.directors);
     }
     if (m_infosToLoad.contains(ShowScraperInfos::Title)) {
-        m_episode.setTitle(episodeObj.value("episodeName").toString());
+        m_episode.setTitle(data.title);
     }
     if (m_infosToLoad.contains(ShowScraperInfos::FirstAired)) {
-        // TheTVDb month and day don't have a leading zero
-        m_episode.setFirstAired(QDate::fromString(episodeObj.value("firstAired").toString(), "yyyy-M-d"));
+        m_episode.setFirstAired(data.firstAired);
     }
     if (m_infosToLoad.contains(ShowScraperInfos::Overview)) {
-        m_episode.setOverview(episodeObj.value("overview").toString());
+        m_episode.setOverview(data.overview);
     }
     if (m_infosToLoad.contains(ShowScraperInfos::Rating)) {
-        Rating rating;
-        rating.rating = episodeObj.value("siteRating").toDouble();
-        rating.voteCount = episodeObj.value("siteRatingCount").toInt();
-        rating.maxRating = 10;
-        rating.minRating = 0;
-        rating.source = "tvdb";
         // @todo currently only one rating is supported
         m_episode.ratings().clear();
-        m_episode.ratings().push_back(rating);
+        m_episode.ratings().push_back(data.rating);
     }
     if (m_infosToLoad.contains(ShowScraperInfos::Writer)) {
-        QStringList writers;
-        const auto writersArray = episodeObj.value("writers").toArray();
-        for (const auto& writerValue : writersArray) {
-            QString writer = writerValue.toString().trimmed();
-            if (!writer.isEmpty()) {
-                writers.append(writer);
-            }
-        }
-        m_episode.setWriters(writers);
+        m_episode.setWriters(data.writers);
     }
     if (m_infosToLoad.contains(ShowScraperInfos::Thumbnail)) {
-        m_episode.setThumbnail(
-            ApiRequest::getFullAssetUrl(QStringLiteral("/banners/%2").arg(episodeObj.value("filename").toString())));
+        m_episode.setThumbnail(data.thumbnail);
     }
 
     m_episode.setInfosLoaded(true);
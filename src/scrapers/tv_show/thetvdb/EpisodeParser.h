@@ -1,13 +1,40 @@
 #pragma once
 
+#include "data/ImdbId.h"
+#include "data/Rating.h"
+#include "tv_shows/EpisodeNumber.h"
+#include "tv_shows/SeasonNumber.h"
+#include "tv_shows/SeasonOrder.h"
+#include "tv_shows/TvDbId.h"
 #include "tv_shows/TvShowEpisode.h"
 
+#include <QDate>
 #include <QJsonObject>
 #include <QString>
+#include <QStringList>
+#include <QUrl>
 #include <QVector>
 
 namespace thetvdb {
 
+/// Plain values of one episode from TheTvDb. Filled by EpisodeParser::parseData()
+/// on a worker thread and assigned to a TvShowEpisode by EpisodeParser::assign().
+struct EpisodeData
+{
+    bool isValid = false;
+    TvDbId tvdbId;
+    ImdbId imdbId;
+    SeasonNumber season = SeasonNumber::NoSeason;
+    EpisodeNumber episode = EpisodeNumber::NoEpisode;
+    QStringList directors;
+    QString title;
+    QDate firstAired;
+    QString overview;
+    Rating rating;
+    QStringList writers;
+    QUrl thumbnail;
+};
+
 class EpisodeParser
 {
 public:
@@ -16,8 +43,14 @@ public:
     {
     }
 
-    void parseInfos(const QString& json);
-    void parseInfos(const QJsonObject& episodeObj);
+    /// Parses the response of TheTvDb's episode API. Thread-safe.
+    static EpisodeData parseData(const QString& json, SeasonOrder order);
+    /// Parses one episode of any TheTvDb API response. Thread-safe.
+    static EpisodeData parseData(const QJsonObject& episodeObj, SeasonOrder order);
+
+    /// Stores all data that should be loaded in the episode.
+    void assign(const EpisodeData& data);
+
     void parseIdFromSeason(const QString& json);
 
 private:
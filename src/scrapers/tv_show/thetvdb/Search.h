@@ -23,7 +23,6 @@ signals:
     void sigSearchDone(QVector<ScraperSearchResult>);
 
 private:
-    QNetworkAccessManager m_qnam;
     ApiRequest m_apiRequest;
 
     QVector<ScraperSearchResult> parseSearch(const QString& json);
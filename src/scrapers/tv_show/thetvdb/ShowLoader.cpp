@@ -2,9 +2,11 @@
 
 #include "globals/Globals.h"
 #include "globals/Manager.h"
+#include "scrapers/BackgroundParser.h"
 #include "scrapers/tv_show/thetvdb/ApiRequest.h"
 #include "scrapers/tv_show/thetvdb/EpisodeLoader.h"
 #include "scrapers/tv_show/thetvdb/ShowLoader.h"
+#include "settings/Settings.h"
 #include "tv_shows/TvShow.h"
 
 #include <QObject>
@@ -14,6 +16,9 @@
 
 namespace thetvdb {
 
+/// Maximum number of episode pages that are requested at the same time.
+static constexpr int s_maxParallelEpisodeRequests = 4;
+
 // All infos that this API can scrape.
 const QSet<ShowScraperInfos> ShowLoader::scraperInfos = {ShowScraperInfos::Actors,
     ShowScraperInfos::Certification,
@@ -51,6 +56,7 @@ ShowLoader::ShowLoader(TvShow& show,
     m_parser(show, showInfosToLoad)
 {
     setParent(parent);
+    m_apiRequest.setItem(show.title());
 
     // Save only information that we can actually scrape
     m_infosToLoad = [&showInfosToLoad]() {
@@ -73,7 +79,7 @@ void ShowLoader::loadShowAndEpisodes()
     }
 
     if (isEpisodeUpdateType(m_updateType)) {
-        loadAndStoreEpisodes(ApiPage{1});
+        loadEpisodes();
     } else {
         m_episodesLoaded = true;
     }
@@ -132,56 +138,118 @@ void ShowLoader::loadTvShow()
 
     m_apiRequest.sendGetRequest(getShowUrl(ApiShowDetails::INFOS), [this, setInfosLoaded](QString json) {
         // We need to add the loaded information but may not want to actually store the show's information.
-        if (isShowUpdateType(m_updateType)) {
-            m_parser.parseInfos(json);
+        if (!isShowUpdateType(m_updateType)) {
+            setInfosLoaded();
+            checkIfDone();
+            return;
         }
-        setInfosLoaded();
-        checkIfDone();
+        mediaelch::scraper::parseInBackground(
+            this,
+            [json]() { return ShowParser::parseInfos(json); },
+            [this, setInfosLoaded](const ShowData& data) {
+                m_parser.assignInfos(data);
+                setInfosLoaded();
+                checkIfDone();
+            });
     });
 }
 
 void ShowLoader::loadActors()
 {
     m_apiRequest.sendGetRequest(getShowUrl(ApiShowDetails::ACTORS), [this](QString json) {
-        m_parser.parseActors(json);
-        m_loaded.insert(ShowScraperInfos::Actors);
-        checkIfDone();
+        mediaelch::scraper::parseInBackground(
+            this,
+            [json]() { return ShowParser::parseActors(json); },
+            [this](const QVector<Actor>& actors) {
+                m_parser.assignActors(actors);
+                m_loaded.insert(ShowScraperInfos::Actors);
+                checkIfDone();
+            });
     });
 }
 
 void ShowLoader::loadImages(ShowScraperInfos imageType)
 {
     m_apiRequest.sendGetRequest(getImagesUrl(imageType), [this, imageType](QString json) {
-        m_parser.parseImages(json);
-        m_loaded.insert(imageType);
-        checkIfDone();
+        mediaelch::scraper::parseInBackground(
+            this,
+            [json]() { return ShowParser::parseImages(json); },
+            [this, imageType](const QVector<ShowImage>& images) {
+                m_parser.assignImages(images);
+                m_loaded.insert(imageType);
+                checkIfDone();
+            });
     });
 }
 
-void ShowLoader::loadAndStoreEpisodes(ApiPage page)
+void ShowLoader::loadEpisodes()
 {
-    m_apiRequest.sendGetRequest(getEpisodesUrl(page), [this](QString json) {
-        Paginate p = m_parser.parseEpisodes(json, m_episodeInfosToLoad);
-        if (p.hasNextPage()) {
-            return loadAndStoreEpisodes(p.next);
-        }
-
-        m_episodesLoaded = true;
-        checkIfDone();
+    // The first page tells us how many pages there are.
+    m_apiRequest.sendGetRequest(getEpisodesUrl(ApiPage{1}), [this](QString json) {
+        const SeasonOrder order = Settings::instance()->seasonOrder();
+        mediaelch::scraper::parseInBackground(
+            this,
+            [json, order]() { return ShowParser::parseEpisodePage(json, order); },
+            [this](EpisodePage page) {
+                m_parser.addEpisodes(page, m_episodeInfosToLoad);
+                if (!page.paginate.hasNextPage()) {
+                    m_episodesLoaded = true;
+                    checkIfDone();
+                    return;
+                }
+                m_nextEpisodePage = page.paginate.next;
+                m_lastEpisodePage = qMax(page.paginate.last, page.paginate.next);
+                loadRemainingEpisodePages();
+            });
     });
 }
 
-void ShowLoader::storeEpisodesInDatabase()
+void ShowLoader::loadRemainingEpisodePages()
 {
-    Database* const database = Manager::instance()->database();
-    const int showsSettingsId = database->showsSettingsId(&m_show);
-    database->clearEpisodeList(showsSettingsId);
+    while (m_episodeRequestsInFlight < s_maxParallelEpisodeRequests && m_nextEpisodePage <= m_lastEpisodePage) {
+        const ApiPage page = m_nextEpisodePage++;
+        ++m_episodeRequestsInFlight;
+        // Note: The callback is called immediately if the page is cached.
+        m_apiRequest.sendGetRequest(getEpisodesUrl(page), [this, page](QString json) {
+            // Pages are parsed as soon as they arrive but added to the show in order.
+            const SeasonOrder order = Settings::instance()->seasonOrder();
+            mediaelch::scraper::parseInBackground(
+                this,
+                [json, order]() { return ShowParser::parseEpisodePage(json, order); },
+                [this, page](const EpisodePage& episodePage) {
+                    --m_episodeRequestsInFlight;
+                    m_episodePages.insert(page, episodePage);
+                    if (m_nextEpisodePage <= m_lastEpisodePage) {
+                        loadRemainingEpisodePages();
+
+                    } else if (m_episodeRequestsInFlight == 0 && !m_episodesLoaded) {
+                        addRemainingEpisodePages();
+                        m_episodesLoaded = true;
+                        checkIfDone();
+                    }
+                });
+        });
+    }
+}
 
-    for (auto& episode : m_parser.episodes()) {
-        database->addEpisodeToShowList(episode.get(), showsSettingsId, episode->tvdbId());
+void ShowLoader::addRemainingEpisodePages()
+{
+    // QMap is sorted by page, so episodes are in the same order as if loaded one after the other.
+    for (const EpisodePage& page : m_episodePages) {
+        m_parser.addEpisodes(page, m_episodeInfosToLoad);
     }
+    m_episodePages.clear();
+}
 
-    database->cleanUpEpisodeList(showsSettingsId);
+void ShowLoader::storeEpisodesInDatabase()
+{
+    QVector<TvShowEpisode*> episodes;
+    episodes.reserve(static_cast<int>(m_parser.episodes().size()));
+    for (auto& episode : m_parser.episodes()) {
+        episodes.append(episode.get());
+    }
+    // Long running shows have hundreds of episodes. They are copied here and written by the writer thread.
+    Manager::instance()->databaseService()->storeEpisodeList(&m_show, episodes);
 }
 
 /**
@@ -301,13 +369,16 @@ void ShowLoader::mergeEpisode(TvShowEpisode* episode)
 
 const TvShowEpisode* ShowLoader::findLoadedEpisode(SeasonNumber season, EpisodeNumber episode)
 {
-    const auto& episodes = m_parser.episodes();
-    for (const auto& cur_episode : episodes) {
-        if (cur_episode->seasonNumber() == season && cur_episode->episodeNumber() == episode) {
-            return cur_episode.get();
+    if (m_loadedEpisodeIndex.isEmpty()) {
+        for (const auto& loadedEpisode : m_parser.episodes()) {
+            const auto key = qMakePair(loadedEpisode->seasonNumber(), loadedEpisode->episodeNumber());
+            // Keep the first episode in case of duplicates.
+            if (!m_loadedEpisodeIndex.contains(key)) {
+                m_loadedEpisodeIndex.insert(key, loadedEpisode.get());
+            }
         }
     }
-    return nullptr;
+    return m_loadedEpisodeIndex.value(qMakePair(season, episode), nullptr);
 }
 
 } // namespace thetvdb
@@ -6,10 +6,13 @@
 #include "scrapers/tv_show/thetvdb/ShowParser.h"
 #include "tv_shows/TvShow.h"
 
+#include <QHash>
+#include <QMap>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QObject>
+#include <QPair>
 #include <QString>
 #include <QUrl>
 
@@ -57,10 +60,22 @@ private:
     TvShowUpdateType m_updateType;
     ShowParser m_parser;
 
+    /// Parsed episode pages after the first one. They are requested and parsed in parallel
+    /// but added to the show in order once all of them have arrived.
+    QMap<ApiPage, EpisodePage> m_episodePages;
+    ApiPage m_nextEpisodePage{0};
+    ApiPage m_lastEpisodePage{0};
+    int m_episodeRequestsInFlight{0};
+
+    /// Loaded episodes by season and episode number. Built on first use by findLoadedEpisode().
+    QHash<QPair<SeasonNumber, EpisodeNumber>, const TvShowEpisode*> m_loadedEpisodeIndex;
+
     void loadTvShow();
     void loadActors();
     void loadImages(ShowScraperInfos imageType);
-    void loadAndStoreEpisodes(ApiPage page);
+    void loadEpisodes();
+    void loadRemainingEpisodePages();
+    void addRemainingEpisodePages();
 
     void checkIfDone();
     QUrl getFullUrl(const QString& suffix) const;
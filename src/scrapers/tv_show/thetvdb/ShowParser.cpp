@@ -15,7 +15,7 @@
 
 namespace thetvdb {
 
-void ShowParser::parseInfos(const QString& json)
+ShowData ShowParser::parseInfos(const QString& json)
 {
     QJsonParseError parseError{};
     const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
@@ -23,77 +23,53 @@ void ShowParser::parseInfos(const QString& json)
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing TheTvDb show data" << parseError.errorString();
-        return;
-    }
-
-    m_show.setTvdbId(TvDbId(showData.value("id").toInt()));
-    m_show.setImdbId(ImdbId(showData.value("imdbId").toString()));
-
-    if (m_infosToLoad.contains(ShowScraperInfos::Certification)) {
-        const auto cert = Certification(showData.value("rating").toString());
-        m_show.setCertification(helper::mapCertification(cert));
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::FirstAired)) {
-        // TheTVDb month and day don't have a leading zero
-        m_show.setFirstAired(QDate::fromString(showData.value("firstAired").toString(), "yyyy-M-d"));
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::Network)) {
-        m_show.setNetwork(helper::mapStudio(showData.value("network").toString()));
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::Overview)) {
-        m_show.setOverview(showData.value("overview").toString());
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::Rating)) {
-        Rating rating;
-        rating.rating = showData.value("siteRating").toDouble();
-        rating.voteCount = showData.value("siteRatingCount").toInt();
-        rating.source = "tvdb";
-        rating.minRating = 0;
-        rating.maxRating = 10;
-        // @todo currently only one rating is supported
-        m_show.ratings().clear();
-        m_show.ratings().push_back(rating);
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::Title)) {
-        m_show.setTitle(showData.value("seriesName").toString().trimmed());
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::Runtime)) {
-        const auto runtime = std::chrono::minutes(showData.value("runtime").toString().toInt());
-        m_show.setRuntime(runtime);
-    }
-    if (m_infosToLoad.contains(ShowScraperInfos::Status)) {
-        m_show.setStatus(showData.value("status").toString());
-    }
-
-    if (m_infosToLoad.contains(ShowScraperInfos::Genres)) {
-        QStringList genres;
-        const auto jsonGenres = showData.value("genre").toArray();
-        for (const auto& jsonGenre : jsonGenres) {
-            const QString genre = jsonGenre.toString();
-            if (!genre.isEmpty()) {
-                genres << genre;
-            }
+        return {};
+    }
+
+    ShowData data;
+    data.isValid = true;
+    data.tvdbId = TvDbId(showData.value("id").toInt());
+    data.imdbId = ImdbId(showData.value("imdbId").toString());
+    data.certification = Certification(showData.value("rating").toString());
+    // TheTVDb month and day don't have a leading zero
+    data.firstAired = QDate::fromString(showData.value("firstAired").toString(), "yyyy-M-d");
+    data.network = showData.value("network").toString();
+    data.overview = showData.value("overview").toString();
+
+    data.rating.rating = showData.value("siteRating").toDouble();
+    data.rating.voteCount = showData.value("siteRatingCount").toInt();
+    data.rating.source = "tvdb";
+    data.rating.minRating = 0;
+    data.rating.maxRating = 10;
+
+    data.title = showData.value("seriesName").toString().trimmed();
+    data.runtime = std::chrono::minutes(showData.value("runtime").toString().toInt());
+    data.status = showData.value("status").toString();
+
+    const auto jsonGenres = showData.value("genre").toArray();
+    for (const auto& jsonGenre : jsonGenres) {
+        const QString genre = jsonGenre.toString();
+        if (!genre.isEmpty()) {
+            data.genres << genre;
         }
-        m_show.setGenres(helper::mapGenre(genres));
     }
+
+    return data;
 }
 
-void ShowParser::parseActors(const QString& json)
+QVector<Actor> ShowParser::parseActors(const QString& json)
 {
-    if (!m_infosToLoad.contains(ShowScraperInfos::Actors)) {
-        return;
-    }
-
     QJsonParseError parseError{};
     const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
-    const auto actors = parsedJson.value("data").toArray();
+    const auto actorsArray = parsedJson.value("data").toArray();
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing TheTvDb actor data" << parseError.errorString();
-        return;
+        return {};
     }
 
-    for (const auto& actorValue : actors) {
+    QVector<Actor> actors;
+    for (const auto& actorValue : actorsArray) {
         const auto actorObj = actorValue.toObject();
 
         Actor actor;
@@ -101,27 +77,33 @@ void ShowParser::parseActors(const QString& json)
         actor.name = actorObj.value("name").toString();
         actor.role = actorObj.value("role").toString();
         actor.thumb = ApiRequest::getFullAssetUrl("/banners/" + actorObj.value("image").toString()).toString();
-
-        m_show.addActor(actor);
+        actors << actor;
     }
+    return actors;
 }
 
-void ShowParser::parseImages(const QString& json)
+QVector<ShowImage> ShowParser::parseImages(const QString& json)
 {
     QJsonParseError parseError{};
     const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
-    const auto images = parsedJson.value("data").toArray();
+    const auto imagesArray = parsedJson.value("data").toArray();
 
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing TheTvDb image data" << parseError.errorString();
-        return;
+        return {};
     }
 
-    for (const auto& imageValue : images) {
+    QVector<ShowImage> images;
+    for (const auto& imageValue : imagesArray) {
         const auto imageObj = imageValue.toObject();
-        const QString keyType = imageObj.value("keyType").toString();
 
-        Poster p;
+        ShowImage image;
+        image.keyType = imageObj.value("keyType").toString();
+        if (image.keyType == "season" || image.keyType == "seasonwide") {
+            image.season = SeasonNumber(imageObj.value("subKey").toString().toInt());
+        }
+
+        Poster& p = image.poster;
         p.id = QString::number(imageObj.value("id").toInt());
 
         p.originalUrl = ApiRequest::getFullAssetUrl("/banners/" + imageObj.value("fileName").toString());
@@ -132,64 +114,125 @@ void ShowParser::parseImages(const QString& json)
             p.originalSize.setWidth(resolution[0].toInt());
             p.originalSize.setHeight(resolution[1].toInt());
         }
+        images << image;
+    }
+    return images;
+}
+
+EpisodePage ShowParser::parseEpisodePage(const QString& json, SeasonOrder order)
+{
+    QJsonParseError parseError{};
+    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
+    const auto paginateObj = parsedJson.value("links").toObject();
+    const auto episodesArray = parsedJson.value("data").toArray();
+
+    if (parseError.error != QJsonParseError::NoError) {
+        qWarning() << "[TheTvDb][ShowParser] Error parsing TheTvDb episode data:" << parseError.errorString() << json;
+        return {};
+    }
+
+    EpisodePage page;
+    page.isValid = true;
+    page.episodes.reserve(episodesArray.size());
+    for (const auto& episodeValue : episodesArray) {
+        page.episodes << EpisodeParser::parseData(episodeValue.toObject(), order);
+    }
+
+    page.paginate.first = paginateObj.value("first").toInt();
+    page.paginate.last = paginateObj.value("last").toInt();
+    page.paginate.next = paginateObj.value("next").toInt();
+    page.paginate.prev = paginateObj.value("prev").toInt();
+    return page;
+}
+
+void ShowParser::assignInfos(const ShowData& data)
+{
+    if (!data.isValid) {
+        return;
+    }
+
+    m_show.setTvdbId(data.tvdbId);
+    m_show.setImdbId(data.imdbId);
+
+    if (m_infosToLoad.contains(ShowScraperInfos::Certification)) {
+        m_show.setCertification(helper::mapCertification(data.certification));
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::FirstAired)) {
+        m_show.setFirstAired(data.firstAired);
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Network)) {
+        m_show.setNetwork(helper::mapStudio(data.network));
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Overview)) {
+        m_show.setOverview(data.overview);
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Rating)) {
+        // @todo currently only one rating is supported
+        m_show.ratings().clear();
+        m_show.ratings().push_back(data.rating);
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Title)) {
+        m_show.setTitle(data.title);
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Runtime)) {
+        m_show.setRuntime(data.runtime);
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Status)) {
+        m_show.setStatus(data.status);
+    }
+    if (m_infosToLoad.contains(ShowScraperInfos::Genres)) {
+        m_show.setGenres(helper::mapGenre(data.genres));
+    }
+}
+
+void ShowParser::assignActors(const QVector<Actor>& actors)
+{
+    if (!m_infosToLoad.contains(ShowScraperInfos::Actors)) {
+        return;
+    }
+    for (const Actor& actor : actors) {
+        m_show.addActor(actor);
+    }
+}
+
+void ShowParser::assignImages(const QVector<ShowImage>& images)
+{
+    for (const ShowImage& image : images) {
+        const QString& keyType = image.keyType;
 
         if (keyType == "fanart" && m_infosToLoad.contains(ShowScraperInfos::Fanart)) {
-            m_show.addBackdrop(p);
+            m_show.addBackdrop(image.poster);
 
         } else if (keyType == "poster" && m_infosToLoad.contains(ShowScraperInfos::Poster)) {
-            m_show.addPoster(p);
+            m_show.addPoster(image.poster);
 
         } else if (keyType == "season" && m_infosToLoad.contains(ShowScraperInfos::SeasonPoster)) {
-            const auto season = SeasonNumber(imageObj.value("subKey").toString().toInt());
-            m_show.addSeasonPoster(season, p);
+            m_show.addSeasonPoster(image.season, image.poster);
 
         } else if (keyType == "seasonwide" && m_infosToLoad.contains(ShowScraperInfos::SeasonBanner)) {
-            const auto season = SeasonNumber(imageObj.value("subKey").toString().toInt());
-            m_show.addSeasonBanner(season, p);
+            m_show.addSeasonBanner(image.season, image.poster);
 
         } else if (keyType == "series"
                    && (m_infosToLoad.contains(ShowScraperInfos::Banner)
                        || m_infosToLoad.contains(ShowScraperInfos::SeasonBanner))) {
-            m_show.addBanner(p);
+            m_show.addBanner(image.poster);
         }
     }
 }
 
-/**
- * @brief Parses episodes from the json and stores them in this object.
- * @see ShowParser::episodes()
- */
-Paginate ShowParser::parseEpisodes(const QString& json, QSet<ShowScraperInfos> episodeInfosToLoad)
+void ShowParser::addEpisodes(const EpisodePage& page, QSet<ShowScraperInfos> episodeInfosToLoad)
 {
     if (!m_show.tvdbId().isValid()) {
-        qWarning() << "[TheTvDb][ShowParser] Can't parse episodes without TheTvDb id:" << m_show.tvdbId().toString();
-        return Paginate{};
-    }
-
-    QJsonParseError parseError{};
-    const auto parsedJson = QJsonDocument::fromJson(json.toUtf8(), &parseError).object();
-    const auto paginateObj = parsedJson.value("links").toObject();
-    const auto episodesArray = parsedJson.value("data").toArray();
-
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "[TheTvDb][ShowParser] Error parsing TheTvDb episode data:" << parseError.errorString() << json;
-        return Paginate{};
+        qWarning() << "[TheTvDb][ShowParser] Can't add episodes without TheTvDb id:" << m_show.tvdbId().toString();
+        return;
     }
 
-    for (const auto& episodeValue : episodesArray) {
-        const auto episodeObj = episodeValue.toObject();
+    for (const EpisodeData& data : page.episodes) {
         auto episode = std::make_unique<TvShowEpisode>();
         EpisodeParser parser(*episode, episodeInfosToLoad);
-        parser.parseInfos(episodeObj);
+        parser.assign(data);
         m_episodes.push_back(std::move(episode));
     }
-
-    Paginate p;
-    p.first = paginateObj.value("first").toInt();
-    p.last = paginateObj.value("last").toInt();
-    p.next = paginateObj.value("next").toInt();
-    p.prev = paginateObj.value("prev").toInt();
-    return p;
 }
 
 } // namespace thetvdb
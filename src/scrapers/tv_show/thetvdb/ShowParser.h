@@ -1,10 +1,20 @@
 #pragma once
 
+#include "data/Certification.h"
+#include "data/ImdbId.h"
+#include "data/Rating.h"
+#include "globals/Actor.h"
 #include "globals/Globals.h"
+#include "globals/Poster.h"
+#include "scrapers/tv_show/thetvdb/EpisodeParser.h"
+#include "tv_shows/SeasonOrder.h"
 #include "tv_shows/TvShow.h"
 
+#include <QDate>
 #include <QString>
+#include <QStringList>
 #include <QVector>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -19,18 +29,62 @@ struct Paginate
     ApiPage next{0};
     ApiPage prev{0};
 
-    bool hasNextPage() { return next > 0; }
+    bool hasNextPage() const { return next > 0; }
 };
 
+/// Plain values of a show's basic information. See ShowParser::parseInfos().
+struct ShowData
+{
+    bool isValid = false;
+    TvDbId tvdbId;
+    ImdbId imdbId;
+    Certification certification;
+    QDate firstAired;
+    QString network;
+    QString overview;
+    Rating rating;
+    QString title;
+    std::chrono::minutes runtime{0};
+    QString status;
+    QStringList genres;
+};
+
+/// An image of TheTvDb's image query API. See ShowParser::parseImages().
+struct ShowImage
+{
+    /// TheTvDb's key type, e.g. "fanart" or "season"
+    QString keyType;
+    SeasonNumber season = SeasonNumber::NoSeason;
+    Poster poster;
+};
+
+/// One page of a show's episode list. See ShowParser::parseEpisodePage().
+struct EpisodePage
+{
+    bool isValid = false;
+    Paginate paginate;
+    QVector<EpisodeData> episodes;
+};
+
+/// The static parse*() functions are thread-safe and only return plain values. They are
+/// run on worker threads; the assign*() and add*() functions store the values in the show
+/// and have to be called on the show's thread.
 class ShowParser
 {
 public:
     ShowParser(TvShow& show, QSet<ShowScraperInfos> showInfosToLoad) : m_show{show}, m_infosToLoad{showInfosToLoad} {}
 
-    void parseInfos(const QString& json);
-    void parseActors(const QString& json);
-    void parseImages(const QString& json);
-    Paginate parseEpisodes(const QString& json, QSet<ShowScraperInfos> episodeInfosToLoad);
+    static ShowData parseInfos(const QString& json);
+    static QVector<Actor> parseActors(const QString& json);
+    static QVector<ShowImage> parseImages(const QString& json);
+    static EpisodePage parseEpisodePage(const QString& json, SeasonOrder order);
+
+    void assignInfos(const ShowData& data);
+    void assignActors(const QVector<Actor>& actors);
+    void assignImages(const QVector<ShowImage>& images);
+    /// Creates episodes from the page and stores them in this object.
+    /// \see ShowParser::episodes()
+    void addEpisodes(const EpisodePage& page, QSet<ShowScraperInfos> episodeInfosToLoad);
 
     const std::vector<std::unique_ptr<TvShowEpisode>>& episodes() const { return m_episodes; }
 
@@ -77,6 +77,26 @@ QString AdvancedSettings::logFile() const
     return m_logFile;
 }
 
+qint64 AdvancedSettings::logMaxFileSize() const
+{
+    return static_cast<qint64>(m_logMaxFileSizeMiB) * 1024 * 1024;
+}
+
+int AdvancedSettings::logMaxFiles() const
+{
+    return m_logMaxFiles;
+}
+
+mediaelch::LogOverflowPolicy AdvancedSettings::logOverflowPolicy() const
+{
+    return m_logOverflowPolicy;
+}
+
+QHash<QString, QtMsgType> AdvancedSettings::logLevels() const
+{
+    return m_logLevels;
+}
+
 QLocale AdvancedSettings::locale() const
 {
     return m_locale;
@@ -151,6 +171,11 @@ bool AdvancedSettings::portableMode() const
 #endif
 }
 
+qint64 AdvancedSettings::artworkMemoryBudget() const
+{
+    return static_cast<qint64>(m_artworkMemoryBudgetMiB) * 1024 * 1024;
+}
+
 int AdvancedSettings::bookletCut() const
 {
     return m_bookletCut;
@@ -214,6 +239,11 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     out << "    locale:                  " << QLocale::languageToString(settings.m_locale.language()) << nl;
     out << "    debugLog:                " << (settings.m_debugLog ? "true" : "false") << nl;
     out << "    logFile:                 " << settings.m_logFile << nl;
+    out << "    logMaxFileSize:          " << settings.m_logMaxFileSizeMiB << " MiB" << nl;
+    out << "    logMaxFiles:             " << settings.m_logMaxFiles << nl;
+    out << "    logOverflow:             "
+        << (settings.m_logOverflowPolicy == mediaelch::LogOverflowPolicy::Drop ? "drop" : "block") << nl;
+    out << "    logLevels:               " << settings.m_logLevels.size() << nl;
     out << "    forceCache:              " << (settings.m_forceCache ? "true" : "false") << nl;
     out << "    sortTokens:              " << settings.m_sortTokens.join(", ") << nl;
     out << "    movieFilters:            " << settings.m_movieFilters.filters().join(", ") << nl;
@@ -242,6 +272,7 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     out << "    episodeThumb dimensions: " << nl;
     out << "        width:               " << settings.m_episodeThumbnailDimensions.width << nl;
     out << "        height:              " << settings.m_episodeThumbnailDimensions.height << nl;
+    out << "    artworkMemoryBudget:     " << settings.m_artworkMemoryBudgetMiB << " MiB" << nl;
     out << "    bookletCut:              " << settings.m_bookletCut << nl;
     out << "    useFirstStudioOnly:      " << (settings.m_useFirstStudioOnly ? "true" : "false") << nl;
     out << "    exclude patterns:        " << nl;
@@ -3,6 +3,7 @@
 #include "file/FileFilter.h"
 #include "globals/Globals.h"
 #include "image/ThumbnailDimensions.h"
+#include "log/LogWriter.h"
 
 #include <QDir>
 #include <QFile>
@@ -76,6 +77,13 @@ public:
 
     bool debugLog() const;
     QString logFile() const;
+    /// \brief Size in bytes after which the log file is rotated. 0 disables rotation.
+    qint64 logMaxFileSize() const;
+    /// \brief Number of rotated log files that are kept.
+    int logMaxFiles() const;
+    mediaelch::LogOverflowPolicy logOverflowPolicy() const;
+    /// \brief Minimum log level per category, see mediaelch::setLogLevel().
+    QHash<QString, QtMsgType> logLevels() const;
     QLocale locale() const;
     QStringList sortTokens() const;
     QHash<QString, QString> genreMappings() const;
@@ -97,6 +105,8 @@ public:
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
     mediaelch::ThumbnailDimensions episodeThumbnailDimensions() const;
+    /// \brief Bytes of downloaded artwork that are kept in memory, see mediaelch::ArtworkStage.
+    qint64 artworkMemoryBudget() const;
 
     bool isFileExcluded(QString file) const;
     bool isFolderExcluded(QString dir) const;
@@ -110,6 +120,10 @@ private:
 private:
     bool m_debugLog = false;
     QString m_logFile;
+    int m_logMaxFileSizeMiB = 10;
+    int m_logMaxFiles = 3;
+    mediaelch::LogOverflowPolicy m_logOverflowPolicy = mediaelch::LogOverflowPolicy::Drop;
+    QHash<QString, QtMsgType> m_logLevels;
     QLocale m_locale;
     QStringList m_sortTokens;
     QHash<QString, QString> m_genreMappings;
@@ -123,6 +137,7 @@ private:
     QHash<QString, QString> m_studioMappings;
     QHash<QString, QString> m_countryMappings;
     mediaelch::ThumbnailDimensions m_episodeThumbnailDimensions;
+    int m_artworkMemoryBudgetMiB = 64;
     QVector<FileSearchExclude> m_excludePatterns;
     bool m_forceCache = false;
     bool m_portableMode = false;
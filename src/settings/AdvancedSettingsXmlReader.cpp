@@ -1,5 +1,6 @@
 #include "settings/AdvancedSettingsXmlReader.h"
 
+#include "log/Log.h"
 #include "settings/Settings.h"
 
 #include <QDebug>
@@ -116,6 +117,9 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
                 }
             }
 
+        } else if (m_xml.name() == "artworkMemoryBudget") {
+            expectIntChecked(m_settings.m_artworkMemoryBudgetMiB, [](int size) { return size >= 0 && size <= 4096; });
+
         } else if (m_xml.name() == "bookletCut") {
             expectInt(m_settings.m_bookletCut);
 
@@ -163,6 +167,40 @@ void AdvancedSettingsXmlReader::loadLog()
             expectBool(m_settings.m_debugLog);
         } else if (m_xml.name() == "file") {
             m_settings.m_logFile = m_xml.readElementText().trimmed();
+        } else if (m_xml.name() == "maxFileSize") {
+            expectIntChecked(m_settings.m_logMaxFileSizeMiB, [](int size) { return size >= 0 && size <= 4096; });
+        } else if (m_xml.name() == "maxFiles") {
+            expectIntChecked(m_settings.m_logMaxFiles, [](int count) { return count >= 0 && count <= 100; });
+        } else if (m_xml.name() == "overflow") {
+            const QString policy = m_xml.readElementText().trimmed().toLower();
+            if (policy == "drop") {
+                m_settings.m_logOverflowPolicy = mediaelch::LogOverflowPolicy::Drop;
+            } else if (policy == "block") {
+                m_settings.m_logOverflowPolicy = mediaelch::LogOverflowPolicy::Block;
+            } else {
+                invalidValue();
+            }
+        } else if (m_xml.name() == "levels") {
+            loadLogLevels();
+        } else {
+            skipUnsupportedTag();
+        }
+    }
+}
+
+void AdvancedSettingsXmlReader::loadLogLevels()
+{
+    m_settings.m_logLevels.clear();
+    while (m_xml.readNextStartElement()) {
+        if (m_xml.name() == "category") {
+            // An empty name sets the level of all other categories.
+            const QString category = m_xml.attributes().value("name").trimmed().toString();
+            QtMsgType level = QtDebugMsg;
+            if (mediaelch::logLevelFromString(m_xml.readElementText(), level)) {
+                m_settings.m_logLevels.insert(category, level);
+            } else {
+                invalidValue();
+            }
         } else {
             skipUnsupportedTag();
         }
@@ -276,7 +276,7 @@ void TvShow::clearImages()
     m_hasImageChanged.clear();
     m_hasSeasonImageChanged.clear();
     for (auto& actor : m_actors) {
-        actor->image = QByteArray();
+        actor->image = mediaelch::StagedImage();
     }
     m_extraFanartImagesToAdd.clear();
 }
@@ -1288,7 +1288,7 @@ void TvShow::setShowMissingEpisodes(bool showMissing, bool updateDatabase)
 {
     m_showMissingEpisodes = showMissing;
     if (updateDatabase) {
-        Manager::instance()->database()->setShowMissingEpisodes(this, showMissing);
+        Manager::instance()->databaseService()->setShowMissingEpisodes(this, showMissing);
     }
 }
 
@@ -1301,7 +1301,7 @@ void TvShow::setHideSpecialsInMissingEpisodes(bool hideSpecials, bool updateData
 {
     m_hideSpecialsInMissingEpisodes = hideSpecials;
     if (updateDatabase) {
-        Manager::instance()->database()->setHideSpecialsInMissingEpisodes(this, hideSpecials);
+        Manager::instance()->databaseService()->setHideSpecialsInMissingEpisodes(this, hideSpecials);
     }
 }
 
@@ -1312,32 +1312,38 @@ bool TvShow::hideSpecialsInMissingEpisodes() const
 
 void TvShow::fillMissingEpisodes()
 {
-    QVector<TvShowEpisode*> episodes = Manager::instance()->database()->showsEpisodes(this);
-    for (TvShowEpisode* episode : episodes) {
-        if (episode == nullptr) {
-            qCritical() << "[TvShow] Episode loaded from database is a nullptr";
-            continue;
-        }
+    // The episode list is read on a database thread; dummy episodes are created once it is available.
+    Manager::instance()->databaseService()->showsEpisodes(
+        this, this, [this](QVector<Database::ShowsEpisodeRecord> records) { addMissingEpisodes(records); });
+}
+
+void TvShow::addMissingEpisodes(const QVector<Database::ShowsEpisodeRecord>& records)
+{
+    if (!showMissingEpisodes()) {
+        return; // disabled while the list was loaded
+    }
 
+    for (const Database::ShowsEpisodeRecord& record : records) {
         bool found = false;
         for (int i = 0, n = m_episodes.count(); i < n; ++i) {
-            if (m_episodes[i]->seasonNumber() == episode->seasonNumber()
-                && m_episodes[i]->episodeNumber() == episode->episodeNumber()) {
+            if (m_episodes[i]->seasonNumber() == record.season && m_episodes[i]->episodeNumber() == record.episode) {
                 found = true;
                 break;
             }
         }
 
         if (found) {
-            episode->deleteLater();
             continue;
         }
 
-        if (episode->seasonNumber() == SeasonNumber::SpecialsSeason && hideSpecialsInMissingEpisodes()) {
-            episode->deleteLater();
+        if (record.season == SeasonNumber::SpecialsSeason && hideSpecialsInMissingEpisodes()) {
             continue;
         }
 
+        auto* episode = new TvShowEpisode(QStringList(), this);
+        episode->setSeason(record.season);
+        episode->setEpisode(record.episode);
+        episode->setNfoContent(record.content);
         episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false);
         episode->setIsDummy(true);
         episode->setInfosLoaded(true);
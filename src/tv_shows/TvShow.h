@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/Database.h"
 #include "data/Rating.h"
 #include "file/Path.h"
 #include "globals/Actor.h"
@@ -143,6 +144,8 @@ public:
         QSet<ShowScraperInfos> infosToLoad);
     bool saveData(MediaCenterInterface* mediaCenterInterface);
     void clearImages();
+    /// \brief Adds dummy episodes for all episodes of the episode list that don't exist on disk.
+    /// The list is loaded asynchronously.
     void fillMissingEpisodes();
     void clearMissingEpisodes();
 
@@ -188,6 +191,9 @@ signals:
     void sigLoaded(TvShow* show, QSet<ShowScraperInfos> details);
     void sigChanged(TvShow*);
 
+private:
+    void addMissingEpisodes(const QVector<Database::ShowsEpisodeRecord>& records);
+
 private:
     QVector<TvShowEpisode*> m_episodes;
     mediaelch::DirectoryPath m_dir;
@@ -204,6 +204,14 @@ void TvShowEpisode::loadData(TvDbId id, TvScraperInterface* tvScraperInterface,
 void TvShowEpisode::loadStreamDetailsFromFile()
 {
     m_streamDetails->loadStreamDetails();
+    updateFromStreamDetails();
+}
+
+/**
+ * @brief Marks the stream details as loaded, e.g. after they were loaded in the background.
+ */
+void TvShowEpisode::updateFromStreamDetails()
+{
     setStreamDetailsLoaded(true);
     setChanged(true);
 }
@@ -127,6 +127,7 @@ public:
     void loadData(TvDbId id, TvScraperInterface* tvScraperInterface, QSet<ShowScraperInfos> infosToLoad);
     bool saveData(MediaCenterInterface* mediaCenterInterface);
     void loadStreamDetailsFromFile();
+    void updateFromStreamDetails();
     void clearImages();
     QSet<ShowScraperInfos> infosToLoad();
 
@@ -7,6 +7,7 @@
 #include <QSqlRecord>
 #include <QtConcurrent/QtConcurrentMap>
 
+#include "file/DirectoryListingCache.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
@@ -45,8 +46,23 @@ void TvShowFileSearcher::setTvShowDirectories(QVector<SettingsDir> directories)
 /// @brief Starts the scan process
 void TvShowFileSearcher::reload(bool force)
 {
-    qInfo() << "[TvShowFileSearcher] Reload TV shows, clear database:" << force;
+    prepareReload();
+    load(force);
+    addLoadedToGui();
+}
+
+void TvShowFileSearcher::prepareReload()
+{
     m_aborted = false;
+    m_loadedShows.clear();
+    // Pick up files that were changed by other programs.
+    mediaelch::DirectoryListingCache::instance().clear();
+    Manager::instance()->tvShowModel()->clear();
+}
+
+void TvShowFileSearcher::load(bool force)
+{
+    qInfo() << "[TvShowFileSearcher] Reload TV shows, clear database:" << force;
 
     clearOldTvShows(force);
 
@@ -64,16 +80,32 @@ void TvShowFileSearcher::reload(bool force)
     setupShows(files, episodeCounter, episodeSum);
     setupShowsFromDatabase(dbShows, episodeCounter, episodeSum);
 
+    qDebug() << "[TvShowFileSearcher] Searching for TV shows done";
+}
+
+void TvShowFileSearcher::addLoadedToGui()
+{
+    if (m_aborted) {
+        // Shows of an aborted reload are never added to the model. Their episodes are deleted with them.
+        qDeleteAll(m_loadedShows);
+        m_loadedShows.clear();
+        return;
+    }
+    // The library may be empty now, so the snapshot rows are not necessarily replaced by appendShow().
+    Manager::instance()->tvShowModel()->clearSnapshot();
+    for (TvShow* show : m_loadedShows) {
+        Manager::instance()->tvShowModel()->appendShow(show);
+    }
+    m_loadedShows.clear();
+
+    // Updates the model, so it has to be done in the GUI thread.
     for (TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
         if (show->showMissingEpisodes()) {
             show->fillMissingEpisodes();
         }
     }
 
-    qDebug() << "[TvShowFileSearcher] Searching for TV shows done";
-    if (!m_aborted) {
-        emit tvShowsLoaded();
-    }
+    emit tvShowsLoaded();
 }
 
 TvShowEpisode* TvShowFileSearcher::loadEpisodeData(TvShowEpisode* episode)
@@ -424,9 +456,6 @@ Database& TvShowFileSearcher::database()
 
 void TvShowFileSearcher::clearOldTvShows(bool forceClear)
 {
-    // clear gui
-    Manager::instance()->tvShowModel()->clear();
-
     if (forceClear) {
         // Simply delete all shows
         database().clearAllTvShows();
@@ -449,7 +478,7 @@ void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int e
 
         show->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false);
 
-        QVector<TvShowEpisode*> episodes = database().episodes(show->databaseId());
+        QVector<TvShowEpisode*> episodes = database().episodes(show);
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::loadEpisodeData);
         for (TvShowEpisode* episode : episodes) {
             if (episode == nullptr) {
@@ -463,7 +492,7 @@ void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int e
             }
         }
 
-        Manager::instance()->tvShowModel()->appendShow(show);
+        m_loadedShows.append(show);
     }
 }
 
@@ -505,7 +534,6 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
         emit currentDir(show->title());
         database().add(show, path);
 
-        database().transaction();
         QVector<TvShowEpisode*> episodes;
 
         // Setup episodes list
@@ -524,14 +552,19 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
 
         // Add episodes to model
+        const bool stored = database().writeInTransaction([&]() {
+            for (TvShowEpisode* episode : episodes) {
+                database().add(episode, path, show->databaseId());
+            }
+        });
+        if (!stored) {
+            qWarning() << "[TvShowFileSearcher] Could not store the episodes of" << show->title() << "in the cache";
+        }
         for (TvShowEpisode* episode : episodes) {
-            database().add(episode, path, show->databaseId());
             show->addEpisode(episode);
             emit progress(++episodeCounter, episodeSum, m_progressMessageId);
         }
-
-        database().commit();
-        Manager::instance()->tvShowModel()->appendShow(show);
+        m_loadedShows.append(show);
     }
 
     emit currentDir("");
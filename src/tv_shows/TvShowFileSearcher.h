@@ -5,6 +5,7 @@
 
 #include <QDir>
 #include <QObject>
+#include <atomic>
 
 class Database;
 
@@ -19,7 +20,17 @@ public:
     static TvShowEpisode* loadEpisodeData(TvShowEpisode* episode);
     static TvShowEpisode* reloadEpisodeData(TvShowEpisode* episode);
 
+    /// \brief Clears the TV show model and resets the searcher. Must be called in the GUI thread.
+    void prepareReload();
+    /// \brief Loads all TV shows without touching the GUI. May be called in a worker thread
+    ///        if the searcher lives in it, see LibraryReloader.
+    void load(bool force);
+    /// \brief Adds TV shows of the last load() to the TV show model and emits tvShowsLoaded().
+    ///        Must be called in the GUI thread.
+    void addLoadedToGui();
+
 public slots:
+    /// \brief Reloads all TV shows in the current thread.
     void reload(bool force);
     void reloadEpisodes(const mediaelch::DirectoryPath& showDir);
     void abort();
@@ -38,7 +49,8 @@ private:
         const mediaelch::DirectoryPath& path,
         QVector<QStringList>& contents);
     QStringList getFiles(const mediaelch::DirectoryPath& path);
-    bool m_aborted;
+    QVector<TvShow*> m_loadedShows;
+    std::atomic<bool> m_aborted;
 
 private:
     Database& database();
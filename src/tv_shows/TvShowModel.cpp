@@ -56,6 +56,9 @@ QVariant TvShowModel::data(const QModelIndex& index, int role) const
     if (!index.isValid()) {
         return QVariant();
     }
+    if (m_snapshot != nullptr) {
+        return snapshotData(index, role);
+    }
 
     const TvShowBaseModelItem& item = getItem(index);
 
@@ -200,6 +203,13 @@ QModelIndex TvShowModel::index(int row, int column, const QModelIndex& parent) c
     if (parent.isValid() && parent.column() != 0) {
         return QModelIndex{};
     }
+    if (m_snapshot != nullptr) {
+        // Snapshot rows don't have an item.
+        if (parent.isValid() || row < 0 || row >= m_snapshot->count()) {
+            return QModelIndex{};
+        }
+        return createIndex(row, column, nullptr);
+    }
 
     TvShowBaseModelItem* childItem = getItem(parent).child(row);
     if (childItem != nullptr) {
@@ -210,6 +220,7 @@ QModelIndex TvShowModel::index(int row, int column, const QModelIndex& parent) c
 
 void TvShowModel::appendShow(TvShow* show)
 {
+    clearSnapshot();
     const int size = m_rootItem.shows().size();
 
     beginInsertRows(QModelIndex{}, size, size);
@@ -281,13 +292,94 @@ bool TvShowModel::removeRows(int position, int rows, const QModelIndex& parent)
 
 int TvShowModel::rowCount(const QModelIndex& parent) const
 {
+    if (m_snapshot != nullptr) {
+        return parent.isValid() ? 0 : m_snapshot->count();
+    }
     return getItem(parent).childCount();
 }
 
+Qt::ItemFlags TvShowModel::flags(const QModelIndex& index) const
+{
+    if (m_snapshot != nullptr) {
+        return Qt::ItemIsEnabled;
+    }
+    return QAbstractItemModel::flags(index);
+}
+
+QVariant TvShowModel::snapshotData(const QModelIndex& index, int role) const
+{
+    using mediaelch::LibrarySnapshot;
+    if (index.column() != 0) {
+        return QVariant();
+    }
+
+    const LibrarySnapshot::Entry entry = m_snapshot->entry(index.row());
+    switch (role) {
+    case Qt::DisplayRole: return helper::appendArticle(entry.title);
+    case Qt::FontRole: {
+        QFont font;
+        font.setBold(true);
+        return font;
+    }
+    case Qt::SizeHintRole: return QSize(0, 44);
+    case Qt::ForegroundRole: return QColor(17, 51, 80);
+    case TvShowRoles::Type: return static_cast<int>(TvShowType::TvShow);
+    case TvShowRoles::EpisodeCount: return entry.count;
+    case TvShowRoles::HasChanged: return false;
+    case TvShowRoles::IsNew:
+        return (entry.flags & LibrarySnapshot::HasNewEpisodes) != 0 || (entry.flags & LibrarySnapshot::InfoLoaded) == 0;
+    case TvShowRoles::SyncNeeded: return (entry.flags & LibrarySnapshot::SyncNeeded) != 0;
+    case TvShowRoles::SelectionForeground: return QColor(255, 255, 255);
+    case TvShowRoles::FilePath: return entry.path;
+    default: break;
+    }
+    return QVariant();
+}
+
+void TvShowModel::setSnapshot(std::unique_ptr<mediaelch::LibrarySnapshot> snapshot)
+{
+    beginResetModel();
+    m_snapshot = std::move(snapshot);
+    endResetModel();
+}
+
+void TvShowModel::clearSnapshot()
+{
+    if (m_snapshot == nullptr) {
+        return;
+    }
+    beginResetModel();
+    m_snapshot.reset();
+    endResetModel();
+}
+
+bool TvShowModel::writeSnapshot(const QString& fileName)
+{
+    using mediaelch::LibrarySnapshot;
+    QVector<LibrarySnapshot::Entry> entries;
+    for (TvShow* show : tvShows()) {
+        LibrarySnapshot::Entry entry;
+        entry.databaseId = show->databaseId();
+        entry.year = show->firstAired().isValid() ? show->firstAired().year() : 0;
+        entry.flags = (show->infoLoaded() ? LibrarySnapshot::InfoLoaded : 0U)
+                      | (show->syncNeeded() ? LibrarySnapshot::SyncNeeded : 0U)
+                      | (show->hasNewEpisodes() ? LibrarySnapshot::HasNewEpisodes : 0U);
+        entry.count = show->episodeCount();
+        entry.title = show->title();
+        entry.sortTitle = show->sortTitle();
+        entry.path = show->dir().toString();
+        entries.push_back(entry);
+    }
+    return LibrarySnapshot::write(fileName, entries);
+}
+
 /// @brief Removes all children
 void TvShowModel::clear()
 {
     const int size = m_rootItem.shows().size();
+    if (size == 0) {
+        return;
+    }
     beginRemoveRows(QModelIndex(), 0, size);
     m_rootItem.removeChildren(0, size);
     endRemoveRows();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/LibrarySnapshot.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 #include "tv_shows/model/TvShowRootModelItem.h"
@@ -8,6 +9,7 @@
 #include <QIcon>
 #include <QModelIndex>
 #include <QVariant>
+#include <memory>
 
 class TvShowModelItem;
 class SeasonModelItem;
@@ -29,6 +31,7 @@ public:
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     int columnCount(const QModelIndex& parent = QModelIndex()) const override;
     bool removeRows(int position, int rows, const QModelIndex& parent = QModelIndex()) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
 
     /// Append a TV show and its seasons and episodes to the tree view.
     void appendShow(TvShow* show);
@@ -47,15 +50,25 @@ public:
     QVector<TvShow*> tvShows();
     int hasNewShowOrEpisode();
 
+    /// \brief Shows the TV shows of a library snapshot until shows are appended.
+    /// Snapshot rows have no seasons and can't be selected.
+    void setSnapshot(std::unique_ptr<mediaelch::LibrarySnapshot> snapshot);
+    void clearSnapshot();
+    bool hasSnapshot() const { return m_snapshot != nullptr; }
+    /// \brief Writes a snapshot of all TV shows, see mediaelch::LibrarySnapshot.
+    bool writeSnapshot(const QString& fileName);
+
 private slots:
     void onSigChanged(TvShowModelItem* showItem, SeasonModelItem* seasonItem, EpisodeModelItem* episodeItem);
     void onShowChanged(TvShow* show);
 
 private:
     TvShowModelItem* findModelForShow(TvShow* show);
+    QVariant snapshotData(const QModelIndex& index, int role) const;
 
 private:
     TvShowRootModelItem m_rootItem;
+    std::unique_ptr<mediaelch::LibrarySnapshot> m_snapshot;
 
     QMap<int, QMap<bool, QIcon>> m_icons;
     QIcon m_newIcon;
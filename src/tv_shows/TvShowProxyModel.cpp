@@ -86,6 +86,16 @@ bool TvShowProxyModel::hasAcceptedChildren(int source_row, const QModelIndex& so
 bool TvShowProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
     auto model = dynamic_cast<TvShowModel*>(sourceModel());
+    if (model->hasSnapshot()) {
+        // Snapshot rows don't have items. New shows come first, like below.
+        const bool leftNew = model->data(left, TvShowRoles::IsNew).toBool();
+        const bool rightNew = model->data(right, TvShowRoles::IsNew).toBool();
+        if (leftNew != rightNew) {
+            return leftNew;
+        }
+        return QString::localeAwareCompare(model->data(left).toString(), model->data(right).toString()) < 0;
+    }
+
     TvShowBaseModelItem& leftItem = model->getItem(left);
     TvShowBaseModelItem& rightItem = model->getItem(right);
 
@@ -146,9 +146,10 @@ void ConcertFilesWidget::loadStreamDetails()
         concerts.at(0)->controller()->loadStreamDetailsFromFile();
         concerts.at(0)->setChanged(true);
     } else {
-        auto loader = new LoadingStreamDetails(this);
+        auto* loader = new LoadingStreamDetails(this);
+        connect(loader, &QDialog::finished, this, &ConcertFilesWidget::concertSelectedEmitter);
         loader->loadConcerts(concerts);
-        delete loader;
+        return;
     }
     concertSelectedEmitter();
 }
@@ -30,8 +30,6 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     loadingMovie->start();
     ui->loading->setMovie(loadingMovie);
 
-    m_timer.setInterval(500);
-
     m_posterDownloadManager = new DownloadManager(this);
     connect(
         m_posterDownloadManager, &DownloadManager::sigDownloadFinished, this, &ImportDialog::onEpisodeDownloadFinished);
@@ -40,7 +38,6 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     connect(ui->concertSearchWidget, &ConcertSearchWidget::sigResultClicked, this, &ImportDialog::onConcertChosen);
     connect(ui->tvShowSearchEpisode, &TvShowSearchEpisode::sigResultClicked, this, &ImportDialog::onTvShowChosen);
     connect(ui->btnImport, &QAbstractButton::clicked, this, &ImportDialog::onImport);
-    connect(&m_timer, &QTimer::timeout, this, &ImportDialog::onFileWatcherTimeout);
 }
 
 ImportDialog::~ImportDialog()
@@ -609,39 +606,26 @@ void ImportDialog::onImport()
     connect(m_workerThread.data(), &QThread::finished, m_workerThread.data(), &QObject::deleteLater);
     connect(m_worker.data(), &FileWorker::sigFinished, m_workerThread.data(), &QThread::quit);
     connect(m_worker.data(), &FileWorker::sigFinished, this, &ImportDialog::onMovingFilesFinished);
+    connect(m_worker.data(), &FileWorker::sigProgress, this, &ImportDialog::onImportProgress);
     m_worker->moveToThread(m_workerThread);
     m_workerThread->start();
-    m_timer.start();
 }
 
-void ImportDialog::onFileWatcherTimeout()
+void ImportDialog::onImportProgress(qint64 bytesTransferred, qint64 bytesTotal, qint64 bytesPerSecond)
 {
-    qint64 sourceSize = 0;
-    qint64 destinationSize = 0;
-    QMapIterator<QString, QString> it(m_filesToMove);
-    while (it.hasNext()) {
-        it.next();
-        QFileInfo sourceFi(it.key());
-        sourceSize += sourceFi.size();
-
-        QFileInfo destFi(it.value());
-        if (!destFi.exists()) {
-            continue;
-        }
-        destinationSize += destFi.size();
-    }
-
-    if (sourceSize == 0) {
+    if (bytesTotal == 0) {
         return;
     }
 
-    ui->progressBar->setValue(qRound(static_cast<float>(destinationSize) * 100.0f / static_cast<float>(sourceSize)));
+    ui->progressBar->setValue(qRound(static_cast<float>(bytesTransferred) * 100.0f / static_cast<float>(bytesTotal)));
+    ui->progressBar->setFormat(
+        tr("%p% (%1/s)").arg(helper::formatFileSize(static_cast<double>(bytesPerSecond), QLocale())));
 }
 
 void ImportDialog::onMovingFilesFinished()
 {
     ui->progressBar->setValue(100);
-    m_timer.stop();
+    ui->progressBar->setFormat("%p%");
     if (m_type == "movie") {
         m_movie->setFiles(m_newFiles);
         m_movie->setInSeparateFolder(m_separateFolders);
@@ -652,7 +636,6 @@ void ImportDialog::onMovingFilesFinished()
         m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
         Manager::instance()->database()->add(m_movie, importDir());
-        Manager::instance()->database()->commit();
         Manager::instance()->movieModel()->addMovie(m_movie);
         m_movie = nullptr;
 
@@ -688,7 +671,6 @@ void ImportDialog::onMovingFilesFinished()
         m_concert->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_concert->controller()->loadData(Manager::instance()->mediaCenterInterface());
         Manager::instance()->database()->add(m_concert, importDir());
-        Manager::instance()->database()->commit();
         Manager::instance()->concertModel()->addConcert(m_concert);
         m_concert = nullptr;
     }
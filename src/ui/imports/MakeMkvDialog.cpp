@@ -377,7 +377,6 @@ void MakeMkvDialog::importFinished()
     m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
     m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
     Manager::instance()->database()->add(m_movie, ui->comboImportDir->currentText());
-    Manager::instance()->database()->commit();
     Manager::instance()->movieModel()->addMovie(m_movie);
     m_movie = nullptr;
 
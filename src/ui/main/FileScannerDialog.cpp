@@ -2,8 +2,6 @@
 #include "globals/Manager.h"
 #include "ui_FileScannerDialog.h"
 
-#include <QTimer>
-
 #include "data/ImageCache.h"
 
 FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new Ui::FileScannerDialog)
@@ -28,12 +26,11 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
     auto* manager = Manager::instance();
     manager->setFileScannerDialog(this);
 
-    // clang-format off
-    connect(manager->movieFileSearcher(),   &MovieFileSearcher::progress,   this, &FileScannerDialog::onProgress);
-    connect(manager->concertFileSearcher(), &ConcertFileSearcher::progress, this, &FileScannerDialog::onProgress);
-    connect(manager->tvShowFileSearcher(),  &TvShowFileSearcher::progress,  this, &FileScannerDialog::onProgress);
-    connect(manager->musicFileSearcher(),   &MusicFileSearcher::progress,   this, &FileScannerDialog::onProgress);
+    m_reloader = new LibraryReloader(this);
+    connect(m_reloader, &LibraryReloader::progress, this, &FileScannerDialog::onProgress);
+    connect(m_reloader, &LibraryReloader::finished, this, &FileScannerDialog::accept);
 
+    // clang-format off
     connect(manager->movieFileSearcher(),   &MovieFileSearcher::currentDir,   this, &FileScannerDialog::onCurrentDir);
     connect(manager->concertFileSearcher(), &ConcertFileSearcher::currentDir, this, &FileScannerDialog::onCurrentDir);
     connect(manager->tvShowFileSearcher(),  &TvShowFileSearcher::currentDir,  this, &FileScannerDialog::onCurrentDir);
@@ -45,28 +42,17 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
     connect(manager->musicFileSearcher(),   &MusicFileSearcher::searchStarted,   ui->status, &QLabel::setText);
     // clang-format on
 
-    connect(manager->movieFileSearcher(), &MovieFileSearcher::moviesLoaded, [this]() {
-        if (m_reloadType != ReloadType::All) {
-            accept();
-        } else {
-            onStartTvShowScanner();
+    // Episodes are reloaded in the GUI thread without the LibraryReloader.
+    connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::progress, this, [this](int current, int max) {
+        if (m_reloadType == ReloadType::Episodes) {
+            onProgress(current, max);
         }
     });
-    connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, [this]() {
-        if (m_reloadType != ReloadType::All) {
+    connect(manager->tvShowFileSearcher(), &TvShowFileSearcher::tvShowsLoaded, this, [this]() {
+        if (m_reloadType == ReloadType::Episodes) {
             accept();
-        } else {
-            onStartConcertScanner();
         }
     });
-    connect(manager->concertFileSearcher(), &ConcertFileSearcher::concertsLoaded, [this]() {
-        if (m_reloadType != ReloadType::All) {
-            accept();
-        } else {
-            onStartMusicScanner();
-        }
-    });
-    connect(manager->musicFileSearcher(), &MusicFileSearcher::musicLoaded, this, &FileScannerDialog::accept);
 }
 
 /**
@@ -80,6 +66,12 @@ FileScannerDialog::~FileScannerDialog()
 /// Sets directories and starts scanning
 int FileScannerDialog::exec()
 {
+    if (m_reloader->isRunning()) {
+        // A reload is running in the background: Show its progress instead of aborting it.
+        QDialog::show();
+        return 0;
+    }
+
     auto* manager = Manager::instance();
     const auto& dirSettings = Settings::instance()->directorySettings();
     manager->movieFileSearcher()->setMovieDirectories(dirSettings.movieDirectories());
@@ -90,20 +82,24 @@ int FileScannerDialog::exec()
     ui->status->setText("");
     ui->progressBar->setValue(0);
     ui->currentDir->setText("");
-    QDialog::show();
-    adjustSize();
+    if (!m_runInBackground) {
+        QDialog::show();
+        adjustSize();
+    }
+    m_runInBackground = false;
 
     if (m_forceReload) {
         ImageCache::instance()->clearCache();
     }
 
+    using Library = mediaelch::LibraryReloader::Library;
     switch (m_reloadType) {
-    case ReloadType::All: // start with movies
-    case ReloadType::Movies: onStartMovieScanner(); break;
-    case ReloadType::TvShows: onStartTvShowScanner(); break;
-    case ReloadType::Concerts: onStartConcertScanner(); break;
+    case ReloadType::All: startReload({Library::Movies, Library::TvShows, Library::Concerts, Library::Music}); break;
+    case ReloadType::Movies: startReload({Library::Movies}); break;
+    case ReloadType::TvShows: startReload({Library::TvShows}); break;
+    case ReloadType::Concerts: startReload({Library::Concerts}); break;
     case ReloadType::Episodes: onStartEpisodeScanner(); break;
-    case ReloadType::Music: onStartMusicScanner(); break;
+    case ReloadType::Music: startReload({Library::Music}); break;
     }
 
     return 0;
@@ -114,6 +110,11 @@ void FileScannerDialog::setForceReload(bool force)
     m_forceReload = force;
 }
 
+void FileScannerDialog::setRunInBackground(bool background)
+{
+    m_runInBackground = background;
+}
+
 void FileScannerDialog::setReloadType(ReloadType type)
 {
     m_reloadType = type;
@@ -124,13 +125,17 @@ void FileScannerDialog::setReloadType(ReloadType type)
  */
 void FileScannerDialog::reject()
 {
+    m_reloader->abort();
+
     if (m_reloadType == ReloadType::Movies || m_reloadType == ReloadType::All) {
         Manager::instance()->movieFileSearcher()->abort();
         Manager::instance()->movieModel()->clear();
+        Manager::instance()->movieModel()->clearSnapshot();
     }
     if (m_reloadType == ReloadType::TvShows || m_reloadType == ReloadType::All) {
         Manager::instance()->tvShowFileSearcher()->abort();
         Manager::instance()->tvShowModel()->clear();
+        Manager::instance()->tvShowModel()->clearSnapshot();
         Manager::instance()->tvShowFilesWidget()->renewModel();
     }
     if (m_reloadType == ReloadType::Concerts || m_reloadType == ReloadType::All) {
@@ -145,106 +150,19 @@ void FileScannerDialog::reject()
     QDialog::reject();
 }
 
-/**
- * @brief Starts the movie file searcher
- */
-void FileScannerDialog::onStartMovieScanner()
+void FileScannerDialog::startReload(const QVector<mediaelch::LibraryReloader::Library>& libraries)
 {
     ui->progressBar->setValue(0);
-    Manager::instance()->movieModel()->clear();
-    QApplication::processEvents();
-    if (m_forceReload) {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartMovieScannerForce);
-    } else {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartMovieScannerCache);
+    if (!m_reloader->reload(libraries, m_forceReload)) {
+        reject();
     }
 }
 
-void FileScannerDialog::onStartMovieScannerCache()
-{
-    Manager::instance()->movieFileSearcher()->reload(false);
-}
-
-void FileScannerDialog::onStartMovieScannerForce()
-{
-    Manager::instance()->movieFileSearcher()->reload(true);
-}
-
-/// Starts the TV show file searcher
-void FileScannerDialog::onStartTvShowScanner()
-{
-    ui->progressBar->setValue(0);
-    Manager::instance()->tvShowModel()->clear();
-    QApplication::processEvents();
-    if (m_forceReload) {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartTvShowScannerForce);
-    } else {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartTvShowScannerCache);
-    }
-}
-
-void FileScannerDialog::onStartTvShowScannerCache()
-{
-    Manager::instance()->tvShowFileSearcher()->reload(false);
-}
-
-void FileScannerDialog::onStartTvShowScannerForce()
-{
-    Manager::instance()->tvShowFileSearcher()->reload(true);
-}
-
 void FileScannerDialog::onStartEpisodeScanner()
 {
     Manager::instance()->tvShowFileSearcher()->reloadEpisodes(m_scanDir);
 }
 
-/**
- * @brief Starts the concert file scanner
- */
-void FileScannerDialog::onStartConcertScanner()
-{
-    ui->progressBar->setValue(0);
-    Manager::instance()->concertModel()->clear();
-    QApplication::processEvents();
-    if (m_forceReload) {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartConcertScannerForce);
-    } else {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartConcertScannerCache);
-    }
-}
-
-void FileScannerDialog::onStartConcertScannerCache()
-{
-    Manager::instance()->concertFileSearcher()->reload(false);
-}
-
-void FileScannerDialog::onStartConcertScannerForce()
-{
-    Manager::instance()->concertFileSearcher()->reload(true);
-}
-
-void FileScannerDialog::onStartMusicScanner()
-{
-    ui->progressBar->setValue(0);
-    Manager::instance()->musicModel()->clear();
-    QApplication::processEvents();
-    if (m_forceReload) {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartMusicScannerForce);
-    } else {
-        QTimer::singleShot(0, this, &FileScannerDialog::onStartMusicScannerCache);
-    }
-}
-
-void FileScannerDialog::onStartMusicScannerCache()
-{
-    Manager::instance()->musicFileSearcher()->reload(false);
-}
-
-void FileScannerDialog::onStartMusicScannerForce()
-{
-    Manager::instance()->musicFileSearcher()->reload(true);
-}
-
 /**
  * @brief Updates the progress bar
  * @param current Current value
@@ -263,7 +181,10 @@ void FileScannerDialog::onProgress(int current, int max)
 void FileScannerDialog::onCurrentDir(QString dir)
 {
     ui->currentDir->setText(dir);
-    QApplication::processEvents();
+    if (m_reloadType == ReloadType::Episodes) {
+        // Episodes are reloaded in the GUI thread.
+        QApplication::processEvents();
+    }
 }
 
 void FileScannerDialog::setScanDir(const mediaelch::DirectoryPath& dir)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file/Path.h"
+#include "globals/LibraryReloader.h"
 
 #include <QDialog>
 
@@ -28,6 +29,9 @@ public:
     void setForceReload(bool force);
     void setReloadType(ReloadType type);
     void setScanDir(const mediaelch::DirectoryPath& dir);
+    /// \brief The next exec() reloads without showing the dialog, e.g. while
+    /// the lists show library snapshots at startup.
+    void setRunInBackground(bool background);
 
 public slots:
     int exec() override;
@@ -36,24 +40,16 @@ public slots:
 private slots:
     void onProgress(int current, int max);
     void onCurrentDir(QString dir);
-    void onStartMovieScanner();
-    void onStartMovieScannerForce();
-    void onStartMovieScannerCache();
-    void onStartTvShowScanner();
-    void onStartTvShowScannerForce();
-    void onStartTvShowScannerCache();
-    void onStartConcertScanner();
-    void onStartConcertScannerForce();
-    void onStartConcertScannerCache();
     void onStartEpisodeScanner();
-    void onStartMusicScanner();
-    void onStartMusicScannerForce();
-    void onStartMusicScannerCache();
 
 private:
+    void startReload(const QVector<mediaelch::LibraryReloader::Library>& libraries);
+
     Ui::FileScannerDialog* ui;
+    mediaelch::LibraryReloader* m_reloader = nullptr;
 
     bool m_forceReload = false;
+    bool m_runInBackground = false;
     ReloadType m_reloadType = ReloadType::All;
     mediaelch::DirectoryPath m_scanDir;
 };
@@ -249,7 +249,9 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     // hack. without only the fileScannerDialog pops up and blocks until it has finished
     show();
 
-    // Start scanning for files
+    // Start scanning for files. The lists show the snapshots of the last scan meanwhile.
+    m_fileScannerDialog->setRunInBackground(
+        Manager::instance()->movieModel()->hasSnapshot() || Manager::instance()->tvShowModel()->hasSnapshot());
     QTimer::singleShot(0, m_fileScannerDialog, &FileScannerDialog::exec);
 
 #ifdef MEDIAELCH_UPDATER
@@ -12,6 +12,7 @@
 #include "Version.h"
 #include "globals/Helper.h"
 #include "globals/VersionInfo.h"
+#include "network/NetworkManager.h"
 #include "network/NetworkRequest.h"
 #include "settings/Settings.h"
 
@@ -34,7 +35,7 @@ void Update::checkForUpdate()
     // all meta data about MediaElch, e.g. the latest version.
     const QUrl url("https://raw.githubusercontent.com/mediaelch/mediaelch-meta/master/version.xml");
     auto request = mediaelch::network::requestWithDefaults(url);
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = mediaelch::network::accessManager()->get(request);
     connect(reply, &QNetworkReply::finished, this, &Update::onCheckFinished);
 }
 
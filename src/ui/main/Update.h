@@ -17,6 +17,5 @@ private slots:
     void onCheckFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     bool checkIfNewVersion(QString xmlString, QString& version, QString& downloadUrl);
 };
@@ -235,9 +235,14 @@ void MovieFilesWidget::loadStreamDetails()
         movies.at(0)->controller()->loadStreamDetailsFromFile();
         movies.at(0)->setChanged(true);
     } else {
-        auto loader = new LoadingStreamDetails(this);
+        // The dialog deletes itself when the analysis is finished or runs in the background.
+        auto* loader = new LoadingStreamDetails(this);
+        connect(loader, &QDialog::finished, this, [this]() {
+            movieSelectedEmitter();
+            m_movieProxyModel->setSourceModel(Manager::instance()->movieModel());
+        });
         loader->loadMovies(movies);
-        delete loader;
+        return;
     }
     movieSelectedEmitter();
     m_movieProxyModel->setSourceModel(Manager::instance()->movieModel());
@@ -533,7 +538,7 @@ void MovieFilesWidget::onLabel()
     ColorLabel color = static_cast<ColorLabel>(action->property("color").toInt());
     for (Movie* movie : selectedMovies()) {
         movie->setLabel(color);
-        Manager::instance()->database()->setLabel(movie->files(), color);
+        Manager::instance()->databaseService()->setLabel(movie->files(), color);
     }
 }
 
@@ -722,8 +722,12 @@ void MovieWidget::updateImages(QVector<ImageType> images)
 
 void MovieWidget::updateImage(ImageType imageType, ClosableImage* image)
 {
-    if (!m_movie->images().image(imageType).isNull()) {
-        image->setImage(m_movie->images().image(imageType));
+    const mediaelch::StagedImage staged = m_movie->images().stagedImage(imageType);
+    if (!staged.isNull() && !staged.stagedFile().isEmpty()) {
+        // Display images that are staged on disk from their file instead of reading them into memory.
+        image->setImage(staged.stagedFile());
+    } else if (!staged.isNull()) {
+        image->setImage(staged.data());
     } else if (!m_movie->images().imagesToRemove().contains(imageType) && m_movie->hasImage(imageType)) {
         QString imgFileName = Manager::instance()->mediaCenterInterface()->imageFileName(m_movie, imageType);
         if (!imgFileName.isEmpty()) {
@@ -1122,7 +1126,7 @@ void MovieWidget::onActorChanged()
 
     auto* actor = ui->actors->item(ui->actors->currentRow(), 1)->data(Qt::UserRole).value<Actor*>();
     if (!actor->image.isNull()) {
-        QPixmap p = QPixmap::fromImage(QImage::fromData(actor->image));
+        QPixmap p = QPixmap::fromImage(QImage::fromData(actor->image.data()));
         ui->actorResolution->setText(QString("%1 x %2").arg(p.width()).arg(p.height()));
         p = p.scaled(QSize(120, 180) * helper::devicePixelRatio(this), Qt::KeepAspectRatio, Qt::SmoothTransformation);
         helper::setDevicePixelRatio(p, helper::devicePixelRatio(this));
@@ -1159,7 +1163,7 @@ void MovieWidget::onChangeActorImage()
         QFile file(fileName);
         if (file.open(QIODevice::ReadOnly)) {
             auto actor = ui->actors->item(ui->actors->currentRow(), 1)->data(Qt::UserRole).value<Actor*>();
-            actor->image = file.readAll();
+            actor->image = mediaelch::ArtworkStage::instance().stage(file.readAll());
             actor->imageHasChanged = true;
             onActorChanged();
             m_movie->setChanged(true);
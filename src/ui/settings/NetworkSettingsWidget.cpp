@@ -1,15 +1,34 @@
 #include "ui/settings/NetworkSettingsWidget.h"
 #include "ui_NetworkSettingsWidget.h"
 
+#include "network/ScrapeStats.h"
 #include "settings/Settings.h"
 
 #include <QFileDialog>
+#include <QTableWidgetItem>
 
 NetworkSettingsWidget::NetworkSettingsWidget(QWidget* parent) : QWidget(parent), ui(new Ui::NetworkSettingsWidget)
 {
     ui->setupUi(this);
 
     connect(ui->chkUseProxy, &QAbstractButton::clicked, this, &NetworkSettingsWidget::onUseProxy);
+    connect(ui->btnRefreshScrapeStats, &QAbstractButton::clicked, this, &NetworkSettingsWidget::loadScrapeStats);
+    connect(ui->btnClearScrapeStats, &QAbstractButton::clicked, this, &NetworkSettingsWidget::onClearScrapeStats);
+
+    ui->scrapeStatsProviders->setColumnCount(10);
+    ui->scrapeStatsProviders->setHorizontalHeaderLabels({tr("Provider"),
+        tr("Requests"),
+        tr("Failed"),
+        tr("Timeouts"),
+        tr("Retries"),
+        tr("KiB"),
+        tr("p50 (ms)"),
+        tr("p95 (ms)"),
+        tr("p99 (ms)"),
+        tr("Max (ms)")});
+    ui->scrapeStatsItems->setColumnCount(4);
+    ui->scrapeStatsItems->setHorizontalHeaderLabels(
+        {tr("Item"), tr("Requests"), tr("Total (ms)"), tr("Critical path")});
 }
 
 NetworkSettingsWidget::~NetworkSettingsWidget()
@@ -32,6 +51,7 @@ void NetworkSettingsWidget::loadSettings()
     ui->proxyUsername->setText(netSettings.proxyUsername());
     ui->proxyPassword->setText(netSettings.proxyPassword());
     onUseProxy();
+    loadScrapeStats();
 }
 
 void NetworkSettingsWidget::saveSettings()
@@ -53,3 +73,55 @@ void NetworkSettingsWidget::onUseProxy()
     ui->proxyUsername->setEnabled(enabled);
     ui->proxyPassword->setEnabled(enabled);
 }
+
+void NetworkSettingsWidget::loadScrapeStats()
+{
+    using namespace mediaelch::network;
+
+    const auto numberItem = [](qint64 value) {
+        auto* item = new QTableWidgetItem;
+        item->setData(Qt::DisplayRole, value);
+        return item;
+    };
+
+    const QVector<RequestSample> samples = ScrapeStats::instance().samples();
+
+    const QVector<ProviderStats> providers = ScrapeStats::providerStats(samples);
+    ui->scrapeStatsProviders->setSortingEnabled(false);
+    ui->scrapeStatsProviders->setRowCount(providers.size());
+    for (int row = 0; row < providers.size(); ++row) {
+        const ProviderStats& provider = providers.at(row);
+        ui->scrapeStatsProviders->setItem(row, 0, new QTableWidgetItem(provider.provider));
+        ui->scrapeStatsProviders->setItem(row, 1, numberItem(provider.requests));
+        ui->scrapeStatsProviders->setItem(row, 2, numberItem(provider.failed));
+        ui->scrapeStatsProviders->setItem(row, 3, numberItem(provider.timeouts));
+        ui->scrapeStatsProviders->setItem(row, 4, numberItem(provider.retries));
+        ui->scrapeStatsProviders->setItem(row, 5, numberItem(provider.bytes / 1024));
+        ui->scrapeStatsProviders->setItem(row, 6, numberItem(provider.p50Ms));
+        ui->scrapeStatsProviders->setItem(row, 7, numberItem(provider.p95Ms));
+        ui->scrapeStatsProviders->setItem(row, 8, numberItem(provider.p99Ms));
+        ui->scrapeStatsProviders->setItem(row, 9, numberItem(provider.maxMs));
+    }
+    ui->scrapeStatsProviders->setSortingEnabled(true);
+    ui->scrapeStatsProviders->resizeColumnsToContents();
+
+    // Only the slowest items; they are sorted by their total time.
+    const QVector<ItemCriticalPath> items = ScrapeStats::criticalPaths(samples).mid(0, 50);
+    ui->scrapeStatsItems->setSortingEnabled(false);
+    ui->scrapeStatsItems->setRowCount(items.size());
+    for (int row = 0; row < items.size(); ++row) {
+        const ItemCriticalPath& item = items.at(row);
+        ui->scrapeStatsItems->setItem(row, 0, new QTableWidgetItem(item.item));
+        ui->scrapeStatsItems->setItem(row, 1, numberItem(item.requests));
+        ui->scrapeStatsItems->setItem(row, 2, numberItem(item.wallMs));
+        ui->scrapeStatsItems->setItem(row, 3, new QTableWidgetItem(criticalPathToString(item)));
+    }
+    ui->scrapeStatsItems->setSortingEnabled(true);
+    ui->scrapeStatsItems->resizeColumnsToContents();
+}
+
+void NetworkSettingsWidget::onClearScrapeStats()
+{
+    mediaelch::network::ScrapeStats::instance().clear();
+    loadScrapeStats();
+}
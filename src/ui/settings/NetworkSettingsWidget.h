@@ -24,6 +24,8 @@ public:
 
 private slots:
     void onUseProxy();
+    void loadScrapeStats();
+    void onClearScrapeStats();
 
 private:
     Ui::NetworkSettingsWidget* ui = nullptr;
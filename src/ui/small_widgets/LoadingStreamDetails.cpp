@@ -2,12 +2,14 @@
 #include "ui_LoadingStreamDetails.h"
 
 #include "concerts/Concert.h"
+#include "globals/Manager.h"
 #include "movies/Movie.h"
 #include "tv_shows/TvShowEpisode.h"
 
 LoadingStreamDetails::LoadingStreamDetails(QWidget* parent) : QDialog(parent), ui(new Ui::LoadingStreamDetails)
 {
     ui->setupUi(this);
+    setAttribute(Qt::WA_DeleteOnClose);
 
 #ifdef Q_OS_MAC
     setWindowFlags((windowFlags() & ~Qt::WindowType_Mask) | Qt::Sheet);
@@ -22,6 +24,15 @@ LoadingStreamDetails::LoadingStreamDetails(QWidget* parent) : QDialog(parent), u
     font.setPointSize(font.pointSize() - 2);
 #endif
     ui->currentFile->setFont(font);
+    ui->throughput->setFont(font);
+
+    auto* analyzer = Manager::instance()->streamDetailsAnalyzer();
+    connect(analyzer, &mediaelch::StreamDetailsAnalyzer::progress, this, &LoadingStreamDetails::onProgress);
+    connect(analyzer, &mediaelch::StreamDetailsAnalyzer::itemAnalyzed, this, &LoadingStreamDetails::onItemAnalyzed);
+    connect(analyzer, &mediaelch::StreamDetailsAnalyzer::pausedChanged, this, &LoadingStreamDetails::onPausedChanged);
+    connect(analyzer, &mediaelch::StreamDetailsAnalyzer::finished, this, &QDialog::accept);
+    connect(ui->buttonToggle, &QPushButton::clicked, this, &LoadingStreamDetails::onToggleClicked);
+    connect(ui->buttonBackground, &QPushButton::clicked, this, &QDialog::accept);
 }
 
 LoadingStreamDetails::~LoadingStreamDetails()
@@ -31,53 +42,64 @@ LoadingStreamDetails::~LoadingStreamDetails()
 
 void LoadingStreamDetails::loadMovies(QVector<Movie*> movies)
 {
-    ui->progressBar->setRange(0, movies.count());
-    ui->progressBar->setValue(0);
-    ui->currentFile->clear();
-    adjustSize();
-    show();
-    for (Movie* movie : movies) {
-        movie->blockSignals(true);
-        movie->controller()->loadStreamDetailsFromFile();
-        movie->setChanged(true);
-        movie->blockSignals(false);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(movie->name());
-        QApplication::processEvents();
-    }
-    accept();
+    showProgress();
+    auto* analyzer = Manager::instance()->streamDetailsAnalyzer();
+    analyzer->enqueue(movies);
+    onProgress(analyzer->analyzedCount(), analyzer->totalCount());
 }
 
 void LoadingStreamDetails::loadConcerts(QVector<Concert*> concerts)
 {
-    ui->progressBar->setRange(0, concerts.count());
-    ui->progressBar->setValue(0);
-    ui->currentFile->clear();
-    adjustSize();
-    show();
-    for (Concert* concert : concerts) {
-        concert->controller()->loadStreamDetailsFromFile();
-        concert->setChanged(true);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(concert->name());
-        QApplication::processEvents();
-    }
-    accept();
+    showProgress();
+    auto* analyzer = Manager::instance()->streamDetailsAnalyzer();
+    analyzer->enqueue(concerts);
+    onProgress(analyzer->analyzedCount(), analyzer->totalCount());
 }
 
 void LoadingStreamDetails::loadTvShowEpisodes(QVector<TvShowEpisode*> episodes)
 {
-    ui->progressBar->setRange(0, episodes.count());
-    ui->progressBar->setValue(0);
+    showProgress();
+    auto* analyzer = Manager::instance()->streamDetailsAnalyzer();
+    analyzer->enqueue(episodes);
+    onProgress(analyzer->analyzedCount(), analyzer->totalCount());
+}
+
+void LoadingStreamDetails::showProgress()
+{
     ui->currentFile->clear();
+    ui->throughput->clear();
+    onPausedChanged(Manager::instance()->streamDetailsAnalyzer()->isPaused());
     adjustSize();
     show();
-    for (TvShowEpisode* episode : episodes) {
-        episode->loadStreamDetailsFromFile();
-        episode->setChanged(true);
-        ui->progressBar->setValue(ui->progressBar->value() + 1);
-        ui->currentFile->setText(episode->title());
-        QApplication::processEvents();
+}
+
+void LoadingStreamDetails::onProgress(int analyzed, int total)
+{
+    const auto* analyzer = Manager::instance()->streamDetailsAnalyzer();
+    ui->progressBar->setRange(0, total);
+    ui->progressBar->setValue(analyzed);
+    ui->throughput->setText(tr("%1 files/s, %2 MB/s")
+                                .arg(analyzer->filesPerSecond(), 0, 'f', 1)
+                                .arg(analyzer->megabytesPerSecond(), 0, 'f', 1));
+}
+
+void LoadingStreamDetails::onItemAnalyzed(QString name)
+{
+    ui->currentFile->setText(name);
+}
+
+void LoadingStreamDetails::onPausedChanged(bool paused)
+{
+    ui->buttonToggle->setText(paused ? tr("Resume") : tr("Cancel"));
+    ui->label->setText(paused ? tr("Loading Stream Details (paused)") : tr("Loading Stream Details..."));
+}
+
+void LoadingStreamDetails::onToggleClicked()
+{
+    auto* analyzer = Manager::instance()->streamDetailsAnalyzer();
+    if (analyzer->isPaused()) {
+        analyzer->resume();
+    } else {
+        analyzer->pause();
     }
-    accept();
 }
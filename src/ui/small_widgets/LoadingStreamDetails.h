@@ -12,6 +12,9 @@ namespace Ui {
 class LoadingStreamDetails;
 }
 
+/// Shows the progress of the background stream details analysis, see
+/// mediaelch::StreamDetailsAnalyzer. The dialog is not modal and closes itself
+/// when the analysis is finished. It is deleted when it is closed.
 class LoadingStreamDetails : public QDialog
 {
     Q_OBJECT
@@ -23,6 +26,14 @@ public:
     void loadConcerts(QVector<Concert*> concerts);
     void loadTvShowEpisodes(QVector<TvShowEpisode*> episodes);
 
+private slots:
+    void onProgress(int analyzed, int total);
+    void onItemAnalyzed(QString name);
+    void onPausedChanged(bool paused);
+    void onToggleClicked();
+
 private:
+    void showProgress();
+
     Ui::LoadingStreamDetails* ui;
 };
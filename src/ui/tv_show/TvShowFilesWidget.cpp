@@ -295,8 +295,10 @@ void TvShowFilesWidget::loadStreamDetails()
         episodes.at(0)->setChanged(true);
 
     } else {
-        LoadingStreamDetails loader;
-        loader.loadTvShowEpisodes(episodes);
+        auto* loader = new LoadingStreamDetails(this);
+        connect(loader, &QDialog::finished, this, [this]() { emitSelected(ui->files->currentIndex()); });
+        loader->loadTvShowEpisodes(episodes);
+        return;
     }
 
     emitSelected(ui->files->currentIndex());
@@ -525,6 +527,12 @@ void TvShowFilesWidget::onItemSelected(const QModelIndex& current, const QModelI
         return;
     }
 
+    if (Manager::instance()->tvShowModel()->hasSnapshot()) {
+        // Rows of the library snapshot don't have TV show objects, yet.
+        emit sigNothingSelected();
+        return;
+    }
+
     qDebug() << "[TvShowFilesWidget] Selected item at row" << current.row() << "and column" << current.column();
 
     const QModelIndex sourceIndex = m_tvShowProxyModel->mapToSource(current);
@@ -1099,7 +1099,7 @@ void TvShowWidgetEpisode::onActorChanged()
 
     auto actor = ui->actors->item(ui->actors->currentRow(), 1)->data(Qt::UserRole).value<Actor*>();
     if (!actor->image.isNull()) {
-        QImage img = QImage::fromData(actor->image);
+        QImage img = QImage::fromData(actor->image.data());
         ui->actor->setPixmap(QPixmap::fromImage(img).scaled(120, 180, Qt::KeepAspectRatio, Qt::SmoothTransformation));
         ui->actorResolution->setText(QString("%1 x %2").arg(img.width()).arg(img.height()));
     } else if (!Manager::instance()->mediaCenterInterface()->actorImageName(m_episode, *actor).isEmpty()) {
@@ -1128,7 +1128,7 @@ void TvShowWidgetEpisode::onChangeActorImage()
             QBuffer buffer(&ba);
             img.save(&buffer, "jpg", 100);
             auto actor = ui->actors->item(ui->actors->currentRow(), 1)->data(Qt::UserRole).value<Actor*>();
-            actor->image = ba;
+            actor->image = mediaelch::ArtworkStage::instance().stage(ba);
             actor->imageHasChanged = true;
             onActorChanged();
             m_episode->setChanged(true);
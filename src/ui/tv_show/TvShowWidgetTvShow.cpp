@@ -915,7 +915,7 @@ void TvShowWidgetTvShow::onActorChanged()
 
     auto actor = ui->actors->item(ui->actors->currentRow(), 1)->data(Qt::UserRole).value<Actor*>();
     if (!actor->image.isNull()) {
-        QImage img = QImage::fromData(actor->image);
+        QImage img = QImage::fromData(actor->image.data());
         ui->actorResolution->setText(QString("%1 x %2").arg(img.width()).arg(img.height()));
         QPixmap pixmap = QPixmap::fromImage(img).scaled(
             QSize(120, 180) * helper::devicePixelRatio(this), Qt::KeepAspectRatio, Qt::SmoothTransformation);
@@ -954,7 +954,7 @@ void TvShowWidgetTvShow::onChangeActorImage()
             QBuffer buffer(&ba);
             img.save(&buffer, "jpg", 100);
             auto actor = ui->actors->item(ui->actors->currentRow(), 1)->data(Qt::UserRole).value<Actor*>();
-            actor->image = ba;
+            actor->image = mediaelch::ArtworkStage::instance().stage(ba);
             actor->imageHasChanged = true;
             onActorChanged();
             m_show->setChanged(true);
@@ -0,0 +1,33 @@
+#include "test/test_helpers.h"
+
+#include "export/SimpleEngine.h"
+#include "test/benchmarks/synthetic_library.h"
+#include "test/integration/resource_dir.h"
+
+#include <atomic>
+
+TEST_CASE("Benchmark simple HTML export", "[benchmark][export][simple]")
+{
+    const auto movies = createSyntheticMovies(benchmarkLibrarySize());
+    QVector<Movie*> moviePtrs;
+    for (const auto& movie : movies) {
+        moviePtrs.push_back(movie.get());
+    }
+
+    ExportTemplate exportTemplate;
+    exportTemplate.setName("Benchmark Template");
+    exportTemplate.setTemplateEngine(ExportEngine::Simple);
+    exportTemplate.setRemote(false);
+    exportTemplate.setIdentifier("benchmark-template");
+    exportTemplate.setDirectory(resourceDir().path() + "/export/simple");
+
+    std::atomic_bool cancelFlag{false};
+    mediaelch::SimpleEngine engine(exportTemplate, tempDir("benchmarks/export/simple"), cancelFlag);
+
+    // Each movie is rendered twice (list and detail page).
+    BENCHMARK("SimpleEngine::exportMovies, whole library")
+    {
+        engine.exportMovies(moviePtrs);
+        return moviePtrs.size();
+    };
+}
@@ -0,0 +1,36 @@
+#include "test/test_helpers.h"
+
+#include "data/ImageCache.h"
+#include "test/integration/resource_dir.h"
+
+#include <QColor>
+#include <QImage>
+
+TEST_CASE("Benchmark image cache", "[benchmark][image]")
+{
+    // Use a typical poster size
+    const QString posterPath = tempDir("benchmarks/images").filePath("poster.jpg");
+    {
+        QImage poster(1000, 1500, QImage::Format_RGB32);
+        poster.fill(QColor(40, 80, 120));
+        poster.save(posterPath, "jpg", 90);
+    }
+    const mediaelch::FilePath poster(posterPath);
+    ImageCache* cache = ImageCache::instance();
+    cache->invalidateImages(poster);
+
+    BENCHMARK("ImageCache::image, cached thumbnail")
+    {
+        int origWidth = 0;
+        int origHeight = 0;
+        return cache->image(poster, 200, 300, origWidth, origHeight).width();
+    };
+
+    BENCHMARK("ImageCache::image, uncached thumbnail")
+    {
+        int origWidth = 0;
+        int origHeight = 0;
+        cache->invalidateImages(poster);
+        return cache->image(poster, 200, 300, origWidth, origHeight).width();
+    };
+}
@@ -0,0 +1,211 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "globals/Filter.h"
+#include "globals/Manager.h"
+#include "media_centers/KodiXml.h"
+#include "media_centers/kodi/v18/MovieXmlWriterV18.h"
+#include "movies/MovieModel.h"
+#include "movies/MovieProxyModel.h"
+#include "test/benchmarks/synthetic_library.h"
+#include "test/integration/resource_dir.h"
+
+#include <QCoreApplication>
+#include <QSqlQuery>
+
+TEST_CASE("Benchmark Kodi movie NFO handling", "[benchmark][movie][kodi]")
+{
+    const int count = benchmarkLibrarySize();
+    const QString nfoContent = getFileContent("movie/kodi_v18_Toy_Story_3_2010.nfo");
+
+    KodiXml kodi;
+    kodi.setVersion(mediaelch::KodiVersion(mediaelch::KodiVersion::v18));
+
+    BENCHMARK("KodiXml::loadMovie from NFO content")
+    {
+        Movie movie;
+        return kodi.loadMovie(&movie, nfoContent);
+    };
+
+    const mediaelch::FileList files = writeSyntheticMovieLibrary(count);
+
+    BENCHMARK("KodiXml::loadMovie from disk, whole library")
+    {
+        int loaded = 0;
+        for (const mediaelch::FilePath& file : files) {
+            Movie movie(QStringList{file.toString()});
+            loaded += kodi.loadMovie(&movie) ? 1 : 0;
+        }
+        return loaded;
+    };
+
+    BENCHMARK_ADVANCED("KodiXml::saveMovie, whole library")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<std::unique_ptr<Movie>> movies;
+        for (const mediaelch::FilePath& file : files) {
+            movies.push_back(std::make_unique<Movie>(QStringList{file.toString()}));
+            kodi.loadMovie(movies.back().get());
+        }
+        meter.measure([&] {
+            int saved = 0;
+            for (auto& movie : movies) {
+                saved += kodi.saveMovie(movie.get()) ? 1 : 0;
+            }
+            return saved;
+        });
+    };
+
+    const auto movies = createSyntheticMovies(count);
+
+    BENCHMARK("MovieXmlWriterV18::getMovieXml, whole library")
+    {
+        int bytes = 0;
+        for (const auto& movie : movies) {
+            mediaelch::kodi::MovieXmlWriterV18 writer(*movie);
+            bytes += writer.getMovieXml().size();
+        }
+        return bytes;
+    };
+}
+
+TEST_CASE("Benchmark movie database cache", "[benchmark][movie][database]")
+{
+    const int count = benchmarkLibrarySize();
+    const mediaelch::DirectoryPath path(tempDir("benchmarks/database"));
+    Database* database = Manager::instance()->database();
+
+    QVector<QByteArray> contents;
+    {
+        const auto movies = createSyntheticMovies(count);
+        database->transaction();
+        database->clearMoviesInDirectory(path);
+        for (const auto& movie : movies) {
+            mediaelch::kodi::MovieXmlWriterV18 writer(*movie);
+            contents.push_back(writer.getMovieXml());
+            movie->setNfoContent(contents.back());
+            database->add(movie.get(), path);
+        }
+        database->commit();
+    }
+
+    {
+        qint64 uncompressedBytes = 0;
+        for (const QByteArray& content : contents) {
+            uncompressedBytes += content.size();
+        }
+        QSqlQuery query(database->db());
+        query.prepare("SELECT SUM(LENGTH(content)) FROM movies WHERE path=:path");
+        query.bindValue(":path", path.toString().toUtf8());
+        query.exec();
+        query.next();
+        WARN("NFO content: " << uncompressedBytes << " bytes, stored: " << query.value(0).toLongLong() << " bytes");
+    }
+
+    const auto loadMovies = [&]() {
+        QVector<Movie*> movies = database->moviesInDirectory(path);
+        const int size = movies.size();
+        qDeleteAll(movies);
+        return size;
+    };
+
+    BENCHMARK("Database::moviesInDirectory, compressed content") { return loadMovies(); };
+
+    {
+        // Same library as stored by versions before 19.
+        database->transaction();
+        QSqlQuery selectQuery(database->db());
+        selectQuery.prepare("SELECT idMovie, content FROM movies WHERE path=:path");
+        selectQuery.bindValue(":path", path.toString().toUtf8());
+        selectQuery.exec();
+        QSqlQuery updateQuery(database->db());
+        updateQuery.prepare("UPDATE movies SET content=:content WHERE idMovie=:id");
+        while (selectQuery.next()) {
+            updateQuery.bindValue(":content", Database::uncompressContent(selectQuery.value(1).toByteArray()).toUtf8());
+            updateQuery.bindValue(":id", selectQuery.value(0));
+            updateQuery.exec();
+        }
+        database->commit();
+    }
+
+    BENCHMARK("Database::moviesInDirectory, uncompressed content") { return loadMovies(); };
+
+    BENCHMARK("Database::compressContent, whole library")
+    {
+        int bytes = 0;
+        for (const QByteArray& content : contents) {
+            bytes += Database::compressContent(content).size();
+        }
+        return bytes;
+    };
+
+    QVector<QByteArray> compressed;
+    for (const QByteArray& content : contents) {
+        compressed.push_back(Database::compressContent(content));
+    }
+
+    BENCHMARK("Database::uncompressContent, whole library")
+    {
+        int length = 0;
+        for (const QByteArray& data : compressed) {
+            length += Database::uncompressContent(data).size();
+        }
+        return length;
+    };
+
+    database->transaction();
+    database->clearMoviesInDirectory(path);
+    database->commit();
+}
+
+TEST_CASE("Benchmark movie filters", "[benchmark][movie][filter]")
+{
+    const auto movies = createSyntheticMovies(benchmarkLibrarySize());
+
+    Filter titleFilter("Title", "galaxy", {}, MovieFilters::Title, true);
+    Filter genreFilter("Genre", "Drama", {}, MovieFilters::Genres, true);
+    Filter posterFilter("Poster", "", {}, MovieFilters::Poster, false);
+
+    BENCHMARK("Filter::accepts(Movie*), title/genre/poster")
+    {
+        int accepted = 0;
+        for (const auto& movie : movies) {
+            if (titleFilter.accepts(movie.get()) && genreFilter.accepts(movie.get())
+                && posterFilter.accepts(movie.get())) {
+                ++accepted;
+            }
+        }
+        return accepted;
+    };
+}
+
+TEST_CASE("Benchmark movie list sorting", "[benchmark][movie][model]")
+{
+    MovieModel model;
+    for (auto& movie : createSyntheticMovies(benchmarkLibrarySize())) {
+        // The model takes ownership, see MovieModel::clear()
+        model.addMovie(movie.release());
+    }
+    MovieProxyModel proxy;
+    proxy.setSourceModel(&model);
+
+    BENCHMARK("MovieProxyModel sort by name")
+    {
+        proxy.setSortBy(SortBy::Name);
+        return proxy.rowCount();
+    };
+
+    BENCHMARK("MovieProxyModel sort by year")
+    {
+        proxy.setSortBy(SortBy::Year);
+        return proxy.rowCount();
+    };
+
+    BENCHMARK("MovieProxyModel sort by added")
+    {
+        proxy.setSortBy(SortBy::Added);
+        return proxy.rowCount();
+    };
+
+    model.clear();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
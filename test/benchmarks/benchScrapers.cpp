@@ -0,0 +1,133 @@
+#include "test/test_helpers.h"
+
+#include "movies/Movie.h"
+#include "network/ReplayTransport.h"
+#include "scrapers/HtmlPattern.h"
+#include "scrapers/movie/AEBN.h"
+#include "scrapers/movie/AdultDvdEmpire.h"
+#include "scrapers/movie/HotMovies.h"
+#include "scrapers/movie/IMDB.h"
+#include "scrapers/movie/TMDb.h"
+#include "scrapers/movie/VideoBuster.h"
+#include "test/benchmarks/synthetic_library.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDir>
+#include <QFile>
+
+/// Returns the saved page "scrapers/<fileName>" of the resource directory or, if there is
+/// none, a page built from \p entry that is about as large as a real one.  \p entry is
+/// repeated once per item of the synthetic library; "%1" is replaced by the item's index.
+static QString scraperPage(const QString& fileName, const QString& entry)
+{
+    QFile file(resourceDir().filePath("scrapers/" + fileName));
+    if (file.open(QFile::ReadOnly)) {
+        return QString::fromUtf8(file.readAll());
+    }
+
+    // Real pages contain a lot of markup between the results.
+    const QString filler =
+        QStringLiteral("<div class=\"ad\"><span class=\"label\">Sponsored</span><a href=\"/ad\">...</a></div>\n")
+            .repeated(20);
+    QString page = "<html><body>\n";
+    for (int i = 0; i < benchmarkLibrarySize(); ++i) {
+        page += filler;
+        page += entry.arg(i);
+        page += '\n';
+    }
+    page += "</body></html>";
+    return page;
+}
+
+TEST_CASE("Benchmark scraper search parsing", "[benchmark][scraper]")
+{
+    const QString aebn = scraperPage("aebn_search.html",
+        "<a id=\"FTSMovieSearch_link_image_detail_%1\" "
+        "href=\"/dispatcher/movieDetail?genreId=101&amp;theaterId=822&amp;movieId=%1&amp;ref=search\" "
+        "title=\"Movie %1\"><img src=\"/cover/%1.jpg\" alt=\"Movie %1\" /></a>");
+    const QString adultDvdEmpire = scraperPage("adultdvdempire_search.html",
+        "<a href=\"/%1/movie-%1-movies.html\"\n\t\ttitle=\"Movie %1\" Category=\"List Page\" Label=\"Title\">");
+    const QString hotMovies = scraperPage("hotmovies_search.html",
+        "<div class=\"cell td_title\">\n<h3 class=\"title\">\n"
+        "<a href=\"https://www.hotmovies.com/video/%1/\" title=\"Movie %1\">Movie %1</a></h3></div>");
+    const QString videoBuster = scraperPage("videobuster_search.html",
+        "<div class=\"infos\"><a href=\"/dvd-bluray-verleih/%1/movie-%1\" class=\"title\">Movie %1</a></div>");
+    const QString imdb = scraperPage("imdb_search.html",
+        "<td class=\"result_text\"> <a href=\"/title/tt%1/?ref_=fn_al_tt_1\" >Movie %1</a> (2010) </td>");
+
+    BENCHMARK("AEBN::parseSearch") { return AEBN::parseSearch(aebn).size(); };
+    BENCHMARK("AdultDvdEmpire::parseSearch") { return AdultDvdEmpire::parseSearch(adultDvdEmpire).size(); };
+    BENCHMARK("HotMovies::parseSearch") { return HotMovies::parseSearch(hotMovies).size(); };
+    BENCHMARK("VideoBuster::parseSearch") { return VideoBuster::parseSearch(videoBuster).size(); };
+    BENCHMARK("IMDB::parseSearch") { return IMDB::parseSearch(imdb).size(); };
+
+    BENCHMARK("removeHtmlTags, search page") { return mediaelch::scraper::removeHtmlTags(imdb).size(); };
+}
+
+TEST_CASE("Benchmark IMDb movie page parsing", "[benchmark][scraper]")
+{
+    // The movie page's markup is too complex to be generated.  A trimmed page is part of
+    // the resources; it is only skipped if it has been removed.
+    QFile file(resourceDir().filePath("scrapers/imdb_movie.html"));
+    if (!file.open(QFile::ReadOnly)) {
+        WARN("No saved IMDb movie page in resources/scrapers; skipping");
+        return;
+    }
+    const QString html = QString::fromUtf8(file.readAll());
+
+    IMDB imdb;
+    const QSet<MovieScraperInfos> infos = imdb.scraperSupports();
+    REQUIRE_FALSE(IMDB::parseInfos(html, infos, false).title.isEmpty());
+
+    BENCHMARK("IMDB::parseIdSearch") { return IMDB::parseIdSearch(html).size(); };
+    BENCHMARK("IMDB::parseInfos") { return IMDB::parseInfos(html, infos, false).title; };
+
+    BENCHMARK("IMDB::parseInfos and assignInfos")
+    {
+        Movie movie;
+        IMDB::assignInfos(IMDB::parseInfos(html, infos, false), &movie);
+        return movie.name();
+    };
+}
+
+TEST_CASE("Benchmark replayed movie scraping", "[benchmark][scraper][replay]")
+{
+    using namespace mediaelch::network;
+
+    // Trimmed responses of TMDb and IMDb for "Finding Dory" are part of the resources, see
+    // resources/README.md.  More can be recorded with the target "scraper_test_record".
+    const QString fixtureDir = resourceDir().filePath("scrapers/replay");
+    if (!QDir(fixtureDir).exists()) {
+        WARN("No recorded responses in resources/scrapers/replay; skipping");
+        return;
+    }
+
+    const ReplayConfig previousConfig = replayConfig();
+    ReplayConfig config;
+    config.mode = ReplayMode::Replay;
+    config.fixtureDir = fixtureDir;
+
+    TMDb tmdb;
+    IMDB imdb;
+    const QSet<MovieScraperInfos> tmdbInfos = tmdb.scraperNativelySupports();
+    const QSet<MovieScraperInfos> imdbInfos = imdb.scraperSupports();
+
+    const auto loadMovies = [&]() {
+        Movie tmdbMovie(QStringList{});
+        loadDataSync(tmdb, {{nullptr, "tt2277860"}}, tmdbMovie, tmdbInfos);
+        Movie imdbMovie(QStringList{});
+        loadDataSync(imdb, {{nullptr, "tt2277860"}}, imdbMovie, imdbInfos);
+        return tmdbMovie.name().size() + imdbMovie.name().size();
+    };
+
+    setReplayConfig(config);
+    BENCHMARK("TMDb and IMDb loadData, no latency") { return loadMovies(); };
+
+    // Roughly a home connection to a remote server.
+    config.latencyMs = 80;
+    config.bandwidthKiBs = 2048;
+    setReplayConfig(config);
+    BENCHMARK("TMDb and IMDb loadData, 80 ms and 2 MiB/s") { return loadMovies(); };
+
+    setReplayConfig(previousConfig);
+}
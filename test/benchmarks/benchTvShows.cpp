@@ -0,0 +1,18 @@
+#include "test/test_helpers.h"
+
+#include "test/benchmarks/synthetic_library.h"
+#include "tv_shows/TvShowFileSearcher.h"
+
+TEST_CASE("Benchmark TV show file name parsing", "[benchmark][show][utils]")
+{
+    const QStringList files = createSyntheticEpisodeFileNames(benchmarkLibrarySize());
+
+    BENCHMARK("TvShowFileSearcher::getEpisodeNumbers, whole library")
+    {
+        int episodes = 0;
+        for (const QString& file : files) {
+            episodes += TvShowFileSearcher::getEpisodeNumbers({file}).size();
+        }
+        return episodes;
+    };
+}
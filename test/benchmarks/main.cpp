@@ -0,0 +1,66 @@
+#define CATCH_CONFIG_RUNNER
+#include "third_party/catch2/catch.hpp"
+
+#include "test/benchmarks/synthetic_library.h"
+#include "test/integration/resource_dir.h"
+
+#include <QApplication>
+#include <QDir>
+#include <QStandardPaths>
+#include <QtGlobal>
+
+int main(int argc, char** argv)
+{
+    // Same seed as the integration tests so that XML output is deterministic.
+    qSetGlobalQHashSeed(0);
+    // Benchmarks fill the database and image cache with synthetic data.
+    // Never touch the user's real MediaElch data directory.
+    QStandardPaths::setTestModeEnabled(true);
+
+    QApplication app(argc, argv);
+    Catch::Session session; // NOLINT(clang-analyzer-core.uninitialized.UndefReturn)
+
+    std::string resourceDirString;
+    std::string tempDirString;
+    int librarySize = benchmarkLibrarySize();
+
+    using namespace Catch::clara;
+    auto cli = session.cli()
+               | Opt(resourceDirString, "directory")["-w"]["--resource-dir"](
+                   "The test directory which contains reference NFO files, etc.")
+               | Opt(tempDirString, "directory")["--temp-dir"](
+                   "The temporary directory to which the synthetic library is written.")
+               | Opt(librarySize, "items")["--library-size"](
+                   "Number of items in the synthetic library, e.g. 1000 to 100000.");
+
+    session.cli(cli);
+
+    const int returnCode = session.applyCommandLine(argc, argv);
+    if (returnCode != 0) {
+        return returnCode;
+    }
+
+    if (session.config().listTests() || session.config().listTestNamesOnly() || session.config().listTags()
+        || session.config().listReporters()) {
+        return session.run();
+    }
+
+    if (resourceDirString.empty() || !QDir(resourceDirString.c_str()).exists()) {
+        std::cerr << "Missing or invalid resource directory argument!" << std::endl;
+        return 1;
+    }
+    if (tempDirString.empty() || !QDir(tempDirString.c_str()).exists()) {
+        std::cerr << "Missing or invalid temporary directory argument!" << std::endl;
+        return 1;
+    }
+    if (librarySize <= 0) {
+        std::cerr << "Library size must be greater than zero!" << std::endl;
+        return 1;
+    }
+
+    setResourceDir(QDir(resourceDirString.c_str()));
+    setTempDir(QDir(tempDirString.c_str()));
+    setBenchmarkLibrarySize(librarySize);
+
+    return session.run();
+}
@@ -0,0 +1,191 @@
+#include "test/benchmarks/synthetic_library.h"
+
+#include "media_centers/kodi/v18/MovieXmlWriterV18.h"
+#include "movies/Movie.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+
+static int s_librarySize = 1000;
+
+int benchmarkLibrarySize()
+{
+    return s_librarySize;
+}
+
+void setBenchmarkLibrarySize(int size)
+{
+    s_librarySize = size;
+}
+
+static QString syntheticTitle(int index)
+{
+    static const QStringList words{"Alien",
+        "Return",
+        "Galaxy",
+        "Night",
+        "Story",
+        "Hunter",
+        "Empire",
+        "Shadow",
+        "Journey",
+        "Legend",
+        "River",
+        "Winter",
+        "Machine",
+        "Secret",
+        "Kingdom"};
+    // Three words followed by the index, so that titles are unique even in libraries larger than 15^3.
+    return QStringLiteral("%1 %2 %3 %4")
+        .arg(words.at(index % words.size()))
+        .arg(words.at((index / words.size()) % words.size()))
+        .arg(words.at((index / (words.size() * words.size())) % words.size()))
+        .arg(index);
+}
+
+std::vector<std::unique_ptr<Movie>> createSyntheticMovies(int count)
+{
+    static const QStringList genres{
+        "Action", "Adventure", "Animation", "Comedy", "Crime", "Drama", "Horror", "Science Fiction", "Thriller"};
+    static const QStringList countries{"United States of America", "United Kingdom", "Germany", "France", "Japan"};
+    static const QStringList studios{"Universal Pictures", "Warner Bros.", "Paramount", "Pixar", "Summit"};
+    static const QString overview = QStringLiteral(
+        "After a long journey through the galaxy, the crew of a commercial spaceship receives a distress call. "
+        "Following the signal to a distant moon, they discover that they are not alone. What follows is a fight "
+        "for survival against a creature that is perfectly adapted to hunt them down one by one.");
+
+    std::vector<std::unique_ptr<Movie>> movies;
+    movies.reserve(static_cast<std::size_t>(count));
+
+    for (int i = 0; i < count; ++i) {
+        // Stream details are only available if the movie has files.
+        auto movie = std::make_unique<Movie>(QStringList{QStringLiteral("/movies/movie_%1/movie_%1.mkv").arg(i)});
+        movie->setName(syntheticTitle(i));
+        movie->setOriginalName(syntheticTitle(i));
+        movie->setSortTitle(syntheticTitle(count - i));
+        movie->setOverview(overview);
+        movie->setOutline(overview.left(100));
+        movie->setTagline("In space no one can hear you scream.");
+        movie->setReleased(QDate(1950 + (i % 70), 1 + (i % 12), 1 + (i % 28)));
+        movie->setRuntime(std::chrono::minutes(80 + (i % 60)));
+        movie->setCertification(Certification(i % 2 == 0 ? "Rated R" : "Rated PG-13"));
+        movie->setDirector(QStringLiteral("Director %1").arg(i % 200));
+        movie->setWriter(QStringLiteral("Writer %1, Writer %2").arg(i % 300).arg((i + 1) % 300));
+        movie->addGenre(genres.at(i % genres.size()));
+        movie->addGenre(genres.at((i + 3) % genres.size()));
+        movie->addCountry(countries.at(i % countries.size()));
+        movie->addStudio(studios.at(i % studios.size()));
+        movie->addTag(QStringLiteral("tag%1").arg(i % 10));
+        movie->setId(ImdbId(QStringLiteral("tt%1").arg(1000000 + i)));
+        movie->setTmdbId(TmdbId(10000 + i));
+        movie->setPlayCount(i % 3);
+        movie->setLastPlayed(QDateTime(QDate(2019, 1 + (i % 12), 1), QTime(20, 15)));
+        movie->setDateAdded(QDateTime(QDate(2018, 1 + (i % 12), 1 + (i % 28)), QTime(12, 0)));
+        movie->setLabel(static_cast<ColorLabel>(i % 8));
+
+        Rating rating;
+        rating.rating = (i % 100) / 10.0;
+        rating.voteCount = 1000 + i;
+        rating.source = "imdb";
+        movie->ratings().push_back(rating);
+
+        for (int a = 0; a < 10; ++a) {
+            Actor actor;
+            actor.name = QStringLiteral("Actor %1").arg((i + a * 7) % 5000);
+            actor.role = QStringLiteral("Role %1").arg(a);
+            actor.thumb = QStringLiteral("https://image.tmdb.org/t/p/original/actor%1.jpg").arg((i + a) % 5000);
+            actor.order = a;
+            movie->addActor(actor);
+        }
+
+        movie->streamDetails()->setVideoDetail(StreamDetails::VideoDetails::Codec, "h264");
+        movie->streamDetails()->setVideoDetail(StreamDetails::VideoDetails::Width, i % 2 == 0 ? "1920" : "1280");
+        movie->streamDetails()->setVideoDetail(StreamDetails::VideoDetails::Height, i % 2 == 0 ? "1080" : "720");
+        movie->streamDetails()->setAudioDetail(0, StreamDetails::AudioDetails::Codec, "ac3");
+        movie->streamDetails()->setAudioDetail(0, StreamDetails::AudioDetails::Channels, "6");
+        movie->streamDetails()->setAudioDetail(0, StreamDetails::AudioDetails::Language, "eng");
+
+        movie->setChanged(false);
+        movies.push_back(std::move(movie));
+    }
+    return movies;
+}
+
+QStringList createSyntheticEpisodeFileNames(int count)
+{
+    QStringList files;
+    files.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const int season = 1 + (i / 24) % 30;
+        const int episode = 1 + i % 24;
+        switch (i % 5) {
+        case 0:
+            files << QStringLiteral("/tv/Show %1/Season %2/Show.Name.S%3E%4.720p.mkv")
+                         .arg(i / 500)
+                         .arg(season)
+                         .arg(season, 2, 10, QChar('0'))
+                         .arg(episode, 2, 10, QChar('0'));
+            break;
+        case 1:
+            files << QStringLiteral("/tv/Show %1/Show Name - %2x%3 - Episode Title.avi")
+                         .arg(i / 500)
+                         .arg(season)
+                         .arg(episode, 2, 10, QChar('0'));
+            break;
+        case 2:
+            files << QStringLiteral("/tv/Show %1/Show_Name_S%2E%3-S%2E%4.mkv")
+                         .arg(i / 500)
+                         .arg(season, 2, 10, QChar('0'))
+                         .arg(episode, 2, 10, QChar('0'))
+                         .arg(episode + 1, 2, 10, QChar('0'));
+            break;
+        case 3:
+            files << QStringLiteral("/tv/Show %1/Season.%2 Episode.%3.mp4")
+                         .arg(i / 500)
+                         .arg(season, 2, 10, QChar('0'))
+                         .arg(episode, 2, 10, QChar('0'));
+            break;
+        default:
+            files << QStringLiteral("/tv/Show %1/Season %2/%3%4 - Episode Title.mkv")
+                         .arg(i / 500)
+                         .arg(season)
+                         .arg(season)
+                         .arg(episode, 2, 10, QChar('0'));
+            break;
+        }
+    }
+    return files;
+}
+
+mediaelch::FileList writeSyntheticMovieLibrary(int count)
+{
+    const QDir libraryDir = tempDir(QStringLiteral("benchmarks/library_%1").arg(count));
+    const auto movies = createSyntheticMovies(count);
+
+    mediaelch::FileList files;
+    for (int i = 0; i < count; ++i) {
+        const QString movieDirName = QStringLiteral("movie_%1").arg(i);
+        const QString videoFilePath = libraryDir.filePath(movieDirName + "/" + movieDirName + ".mkv");
+        files.push_back(mediaelch::FilePath(videoFilePath));
+
+        if (QFile::exists(videoFilePath)) {
+            continue;
+        }
+
+        libraryDir.mkpath(movieDirName);
+        QFile videoFile(videoFilePath);
+        if (videoFile.open(QIODevice::WriteOnly)) {
+            videoFile.close();
+        }
+
+        mediaelch::kodi::MovieXmlWriterV18 writer(*movies.at(static_cast<std::size_t>(i)));
+        QFile nfoFile(libraryDir.filePath(movieDirName + "/" + movieDirName + ".nfo"));
+        if (nfoFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            nfoFile.write(writer.getMovieXml());
+            nfoFile.close();
+        }
+    }
+    return files;
+}
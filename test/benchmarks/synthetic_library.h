@@ -0,0 +1,26 @@
+#pragma once
+
+#include "file/Path.h"
+
+#include <QStringList>
+#include <memory>
+#include <vector>
+
+class Movie;
+
+/// Number of items in the synthetic library. Set via --library-size.
+int benchmarkLibrarySize();
+void setBenchmarkLibrarySize(int size);
+
+/// Creates movies with realistic details (plot, actors, ratings, genres, ...).
+/// The details are deterministic for a given index so that runs are comparable.
+std::vector<std::unique_ptr<Movie>> createSyntheticMovies(int count);
+
+/// Creates TV show episode file names in the most common naming schemes,
+/// e.g. "Show.Name.S01E02.720p.mkv" or "Show Name - 1x02 - Title.avi".
+QStringList createSyntheticEpisodeFileNames(int count);
+
+/// Writes a synthetic movie library to the temporary directory. Each movie
+/// gets its own directory containing an (empty) video file and an NFO file.
+/// Existing files are reused. Returns the video file of each movie.
+mediaelch::FileList writeSyntheticMovieLibrary(int count);
@@ -0,0 +1,115 @@
+#include "test/test_helpers.h"
+
+#include "data/ArtworkStage.h"
+#include "data/ContentHashCache.h"
+
+#include <QFileInfo>
+
+using namespace mediaelch;
+
+TEST_CASE("ArtworkStage keeps small images in memory and stages others on disk", "[data]")
+{
+    ArtworkStage& stage = ArtworkStage::instance();
+    const qint64 budget = stage.memoryBudget();
+    const qint64 usage = ArtworkStage::memoryUsage();
+    stage.setMemoryBudget(usage + 1024);
+
+    const QByteArray small(512, 's');
+    const QByteArray large(ArtworkStage::smallImageLimit() + 1, 'l');
+
+    SECTION("null data is not staged")
+    {
+        CHECK(stage.stage(QByteArray()).isNull());
+    }
+
+    SECTION("small images are kept in memory")
+    {
+        const StagedImage image = stage.stage(small);
+        CHECK(image.stagedFile().isEmpty());
+        CHECK(image.data() == small);
+        CHECK(image.size() == small.size());
+        CHECK(image.hash() == ContentHashCache::contentHash(small));
+        CHECK(ArtworkStage::memoryUsage() == usage + small.size());
+    }
+
+    SECTION("large images are staged on disk")
+    {
+        QString file;
+        {
+            const StagedImage image = stage.stage(large);
+            // Written by the stage's writer thread; until then, the image is kept in memory.
+            CHECK(image.data() == large);
+            stage.waitForPendingWrites();
+            file = image.stagedFile();
+            REQUIRE_FALSE(file.isEmpty());
+            CHECK(QFileInfo(file).size() == large.size());
+            CHECK(image.data() == large);
+            CHECK(image.hash() == ContentHashCache::contentHash(large));
+            CHECK(ArtworkStage::memoryUsage() == usage);
+        }
+        // Released with the last handle.
+        CHECK_FALSE(QFileInfo::exists(file));
+    }
+
+    SECTION("small images that exceed the budget are staged on disk")
+    {
+        const StagedImage first = stage.stage(small);
+        const StagedImage second = stage.stage(small);
+        const StagedImage third = stage.stage(small);
+        stage.waitForPendingWrites();
+        CHECK(first.stagedFile().isEmpty());
+        CHECK(second.stagedFile().isEmpty());
+        CHECK_FALSE(third.stagedFile().isEmpty());
+        CHECK(third.data() == small);
+        CHECK(ArtworkStage::memoryUsage() == usage + 2 * small.size());
+    }
+
+    CHECK(ArtworkStage::memoryUsage() == usage);
+    stage.setMemoryBudget(budget);
+}
+
+TEST_CASE("ArtworkStage stages images while they arrive in chunks", "[data]")
+{
+    ArtworkStage& stage = ArtworkStage::instance();
+    const qint64 budget = stage.memoryBudget();
+    const qint64 usage = ArtworkStage::memoryUsage();
+    stage.setMemoryBudget(usage + 1024);
+
+    SECTION("nothing written results in a null image")
+    {
+        auto writer = stage.beginStaging();
+        CHECK(writer->finish().isNull());
+    }
+
+    SECTION("small images are kept in memory")
+    {
+        auto writer = stage.beginStaging();
+        writer->write("small ");
+        writer->write("image");
+        const StagedImage image = writer->finish();
+        CHECK(image.stagedFile().isEmpty());
+        CHECK(image.data() == "small image");
+        CHECK(image.hash() == ContentHashCache::contentHash("small image"));
+    }
+
+    SECTION("large images are written to disk chunk by chunk")
+    {
+        const QByteArray chunk(64 * 1024, 'c');
+        QByteArray large;
+        auto writer = stage.beginStaging();
+        while (large.size() <= ArtworkStage::smallImageLimit()) {
+            writer->write(chunk);
+            large.append(chunk);
+        }
+        const StagedImage image = writer->finish();
+        REQUIRE_FALSE(image.stagedFile().isEmpty());
+        CHECK(QFileInfo(image.stagedFile()).size() == large.size());
+        CHECK(image.size() == large.size());
+        CHECK(image.data() == large);
+        CHECK(image.hash() == ContentHashCache::contentHash(large));
+        CHECK(ArtworkStage::memoryUsage() == usage);
+    }
+
+    CHECK(ArtworkStage::memoryUsage() == usage);
+    stage.setMemoryBudget(budget);
+}
@@ -0,0 +1,116 @@
+#include "test/test_helpers.h"
+
+#include "data/ArtworkWriter.h"
+#include "data/ContentHashCache.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace mediaelch;
+
+static QByteArray readFile(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return file.readAll();
+}
+
+TEST_CASE("ArtworkWriter writes batches of images", "[data]")
+{
+    QDir dir = tempDir("data/artwork_writer");
+    dir.removeRecursively();
+    dir.mkpath(".");
+
+    ContentHashCache cache(nullptr);
+    const QByteArray poster = "poster";
+    const QByteArray thumb = "actor thumbnail";
+
+    SECTION("identical actor thumbnails are written once and hardlinked")
+    {
+        // An older thumbnail of another movie is replaced by a link.
+        writeTempFile("data/artwork_writer/Aliens/.actors/Sigourney_Weaver.jpg", "old thumbnail");
+
+        ArtworkWriter writer(&cache);
+        writer.add(dir.filePath("Alien/poster.jpg"), poster);
+        writer.addActorThumb(dir.filePath("Alien/.actors/Sigourney_Weaver.jpg"), thumb);
+        writer.addActorThumb(dir.filePath("Alien/.actors/Tom_Skerritt.jpg"), thumb);
+        writer.addActorThumb(dir.filePath("Aliens/.actors/Sigourney_Weaver.jpg"), thumb);
+        REQUIRE(writer.commit());
+
+        CHECK(writer.writtenFiles() == 2);
+        CHECK(writer.linkedFiles() == 2);
+        CHECK(readFile(dir.filePath("Alien/poster.jpg")) == poster);
+        CHECK(readFile(dir.filePath("Alien/.actors/Tom_Skerritt.jpg")) == thumb);
+        CHECK(readFile(dir.filePath("Aliens/.actors/Sigourney_Weaver.jpg")) == thumb);
+        // No temporary links are left behind.
+        CHECK(QDir(dir.filePath("Aliens/.actors")).entryList(QDir::Files) == QStringList{"Sigourney_Weaver.jpg"});
+
+        // Later batches link to thumbnails of earlier ones and skip unchanged files.
+        ArtworkWriter next(&cache);
+        next.add(dir.filePath("Alien/poster.jpg"), poster);
+        next.addActorThumb(dir.filePath("Alien/.actors/John_Hurt.jpg"), thumb);
+        next.addActorThumb(dir.filePath("Alien 3/.actors/Sigourney_Weaver.jpg"), thumb);
+        REQUIRE(next.commit());
+        CHECK(next.skippedFiles() == 1);
+        CHECK(next.linkedFiles() == 2);
+        CHECK(next.writtenFiles() == 0);
+        CHECK(readFile(dir.filePath("Alien/.actors/John_Hurt.jpg")) == thumb);
+        CHECK(readFile(dir.filePath("Alien 3/.actors/Sigourney_Weaver.jpg")) == thumb);
+
+        // Replacing a linked file must not change the others.
+        ArtworkWriter replace(&cache);
+        replace.addActorThumb(dir.filePath("Alien/.actors/Sigourney_Weaver.jpg"), "new thumbnail");
+        REQUIRE(replace.commit());
+        CHECK(readFile(dir.filePath("Alien/.actors/Sigourney_Weaver.jpg")) == "new thumbnail");
+        CHECK(readFile(dir.filePath("Alien/.actors/Tom_Skerritt.jpg")) == thumb);
+        CHECK(readFile(dir.filePath("Aliens/.actors/Sigourney_Weaver.jpg")) == thumb);
+    }
+
+    SECTION("images staged on disk are written without changing the staged file")
+    {
+        const QByteArray backdrop(ArtworkStage::smallImageLimit() + 1, 'b');
+        const StagedImage image = ArtworkStage::instance().stage(backdrop);
+        ArtworkStage::instance().waitForPendingWrites();
+        REQUIRE_FALSE(image.stagedFile().isEmpty());
+
+        ArtworkWriter writer(&cache);
+        writer.add(dir.filePath("Alien/fanart.jpg"), image);
+        writer.add(dir.filePath("Aliens/fanart.jpg"), image);
+        REQUIRE(writer.commit());
+        CHECK(writer.writtenFiles() == 2);
+        CHECK(readFile(dir.filePath("Alien/fanart.jpg")) == backdrop);
+        CHECK(readFile(dir.filePath("Aliens/fanart.jpg")) == backdrop);
+        CHECK(image.data() == backdrop);
+
+        ArtworkWriter next(&cache);
+        next.add(dir.filePath("Alien/fanart.jpg"), image);
+        REQUIRE(next.commit());
+        CHECK(next.skippedFiles() == 1);
+    }
+
+    SECTION("extra fanarts are only added if they don't exist yet")
+    {
+        const QString extraFanartDir = dir.filePath("Alien/extrafanart");
+        ArtworkWriter writer(&cache);
+        writer.addExtraFanart(extraFanartDir, "fanart 1");
+        writer.addExtraFanart(extraFanartDir, "fanart 2");
+        writer.addExtraFanart(extraFanartDir, "fanart 1");
+        REQUIRE(writer.commit());
+        CHECK(writer.writtenFiles() == 2);
+        CHECK(readFile(extraFanartDir + "/fanart1.jpg") == "fanart 1");
+        CHECK(readFile(extraFanartDir + "/fanart2.jpg") == "fanart 2");
+
+        ArtworkWriter next(&cache);
+        next.addExtraFanart(extraFanartDir, "fanart 2");
+        next.addExtraFanart(extraFanartDir, "fanart 3");
+        REQUIRE(next.commit());
+        CHECK(next.skippedFiles() == 1);
+        CHECK(next.writtenFiles() == 1);
+        CHECK(readFile(extraFanartDir + "/fanart3.jpg") == "fanart 3");
+        CHECK_FALSE(QFileInfo::exists(extraFanartDir + "/fanart4.jpg"));
+    }
+}
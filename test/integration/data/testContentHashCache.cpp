@@ -0,0 +1,117 @@
+#include "test/test_helpers.h"
+
+#include "data/ContentHashCache.h"
+#include "data/Database.h"
+#include "data/DatabaseService.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+
+using namespace mediaelch;
+
+TEST_CASE("ContentHashCache skips unchanged files", "[data]")
+{
+    const QString fileName = tempDir("data/content_hash_cache").filePath("movie.nfo");
+    QFile::remove(fileName);
+
+    ContentHashCache cache(nullptr);
+    const QByteArray content = "<movie><title>Alien</title></movie>";
+
+    SECTION("files are only written if their content changes")
+    {
+        CHECK_FALSE(cache.isUnchanged(fileName, content));
+        REQUIRE(cache.write(fileName, content));
+        CHECK(cache.skippedFiles() == 0);
+        CHECK(cache.isUnchanged(fileName, content));
+
+        REQUIRE(cache.write(fileName, content));
+        CHECK(cache.skippedFiles() == 1);
+        CHECK(cache.skippedBytes() == content.size());
+
+        const QByteArray changed = "<movie><title>Aliens</title></movie>";
+        CHECK_FALSE(cache.isUnchanged(fileName, changed));
+        REQUIRE(cache.write(fileName, changed));
+        CHECK(cache.skippedFiles() == 1);
+        CHECK(getTempFileContent("data/content_hash_cache/movie.nfo") == QString(changed));
+    }
+
+    SECTION("files written by other programs are compared by content")
+    {
+        writeTempFile("data/content_hash_cache/movie.nfo", QString(content));
+        ContentHashCache otherCache(nullptr);
+        CHECK(otherCache.isUnchanged(fileName, content));
+        CHECK_FALSE(otherCache.isUnchanged(fileName, content + "\n"));
+    }
+
+    SECTION("files that could not be written are not remembered")
+    {
+        // A directory can't be replaced by a file.
+        const QString dirName = tempDir("data/content_hash_cache").filePath("movie_dir.nfo");
+        QDir(dirName).mkpath(".");
+        CHECK_FALSE(cache.write(dirName, content));
+        CHECK(QFileInfo(dirName).isDir());
+        CHECK_FALSE(cache.isUnchanged(dirName, content));
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    SECTION("files changed within the time resolution of the file system are compared by content")
+    {
+        // Whole seconds like on FAT file systems.
+        const QDateTime modified = QDateTime::fromMSecsSinceEpoch(QDateTime::currentMSecsSinceEpoch() / 1000 * 1000);
+        const auto writeFile = [&](const QByteArray& data) {
+            QFile file(fileName);
+            REQUIRE(file.open(QIODevice::WriteOnly));
+            file.write(data);
+            file.flush();
+            REQUIRE(file.setFileTime(modified, QFileDevice::FileModificationTime));
+        };
+
+        writeFile(content);
+        CHECK(cache.isUnchanged(fileName, content));
+        // Another program changes the file in the same second without changing its size.
+        const QByteArray changed = "<movie><title>Alias</title></movie>";
+        REQUIRE(changed.size() == content.size());
+        writeFile(changed);
+        CHECK(QFileInfo(fileName).lastModified() == modified);
+        CHECK_FALSE(cache.isUnchanged(fileName, content));
+        CHECK(cache.isUnchanged(fileName, changed));
+    }
+#endif
+}
+
+TEST_CASE("ContentHashCache loads hashes of earlier sessions in the background", "[data]")
+{
+    const QString databaseFile = tempDir("data/content_hash_cache").filePath("Hashes.sqlite");
+    QFile::remove(databaseFile);
+    QFile::remove(databaseFile + "-wal");
+    QFile::remove(databaseFile + "-shm");
+    const QString fileName = tempDir("data/content_hash_cache").filePath("poster.jpg");
+    QFile::remove(fileName);
+
+    Database database(databaseFile);
+    DatabaseService service(&database);
+    {
+        ContentHashCache cache(&service);
+        REQUIRE(cache.write(fileName, "poster"));
+        service.flush();
+    }
+
+    // Replace the file behind the cache's back but keep size and modification time:
+    // Only a stored hash can tell that the file is unchanged without reading it.
+    const QFileInfo written(fileName);
+    database.setFileHash(FilePath(fileName),
+        ContentHashCache::contentHash(QByteArray("stored")),
+        written.size(),
+        written.lastModified().toMSecsSinceEpoch());
+
+    ContentHashCache cache(&service);
+    for (int i = 0; i < 500 && !cache.persistedHashesLoaded(); ++i) {
+        QThread::msleep(10);
+    }
+    REQUIRE(cache.persistedHashesLoaded());
+    CHECK(cache.isUnchanged(fileName, QByteArray("stored")));
+}
@@ -0,0 +1,240 @@
+#include "test/test_helpers.h"
+
+#include "data/Database.h"
+#include "test/integration/resource_dir.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QThread>
+
+namespace {
+
+/// Returns the path of a database file in the temporary directory after removing the
+/// file and its write-ahead log from previous runs.
+QString freshDatabaseFile(const QString& name)
+{
+    const QString fileName = tempDir("data/database").filePath(name);
+    QFile::remove(fileName);
+    QFile::remove(fileName + "-wal");
+    QFile::remove(fileName + "-shm");
+    return fileName;
+}
+
+/// Returns the details of all steps of the query plan, e.g. "SEARCH movies USING INDEX movies_path_idx (path=?)".
+QStringList queryPlan(Database& database, const QString& statement)
+{
+    QSqlQuery query(database.db());
+    REQUIRE(query.exec("EXPLAIN QUERY PLAN " + statement));
+    QStringList steps;
+    while (query.next()) {
+        // Columns: id, parent, notused, detail
+        steps << query.value(3).toString();
+    }
+    return steps;
+}
+
+/// A step that starts with "SCAN" reads all rows of a table (or index).
+bool scansTable(const QStringList& steps)
+{
+    for (const QString& step : steps) {
+        if (step.startsWith("SCAN")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("Database compresses NFO content", "[data]")
+{
+    QString content = "<movie><title>Alien</title><plot>";
+    for (int i = 0; i < 50; ++i) {
+        content += "In space no one can hear you scream. ";
+    }
+    content += "</plot></movie>";
+
+    SECTION("long content is compressed and restored")
+    {
+        const QByteArray data = Database::compressContent(content);
+        CHECK(data.size() < content.toUtf8().size());
+        CHECK(Database::uncompressContent(data) == content);
+    }
+
+    SECTION("short and empty content is stored as is")
+    {
+        CHECK(Database::compressContent(QString("<movie/>")) == "<movie/>");
+        CHECK(Database::compressContent(QString()).isEmpty());
+        CHECK_FALSE(Database::compressContent(QString()).isNull());
+    }
+
+    SECTION("content of older versions is read as is")
+    {
+        CHECK(Database::uncompressContent(content.toUtf8()) == content);
+        CHECK(Database::uncompressContent(QByteArray()).isEmpty());
+    }
+}
+
+TEST_CASE("Database queries use indexes", "[data]")
+{
+    const QString fileName = freshDatabaseFile("MediaElch.sqlite");
+
+    Database database(fileName);
+
+    SECTION("the schema is tuned")
+    {
+        QSqlQuery query(database.db());
+        REQUIRE(query.exec("PRAGMA journal_mode;"));
+        REQUIRE(query.next());
+        CHECK(query.value(0).toString() == "wal");
+
+        REQUIRE(query.exec("PRAGMA page_size;"));
+        REQUIRE(query.next());
+        CHECK(query.value(0).toInt() == 8192);
+    }
+
+    SECTION("lookups by path, directory, file name and id don't scan tables")
+    {
+        for (const QString& statement : Database::indexedStatements()) {
+            const QStringList steps = queryPlan(database, statement);
+            INFO(statement.toStdString() << "\n" << steps.join("\n").toStdString());
+            CHECK_FALSE(steps.isEmpty());
+            CHECK_FALSE(scansTable(steps));
+        }
+    }
+}
+
+TEST_CASE("Database stores IMDb actor image URLs", "[data]")
+{
+    const QString fileName = freshDatabaseFile("ActorImages.sqlite");
+
+    Database database(fileName);
+    const QString profileUrl = "https://www.imdb.com/name/nm0000244/";
+
+    database.setImdbActorImageUrl(profileUrl, "https://m.media-amazon.com/images/M/old.jpg", 1000);
+    database.setImdbActorImageUrl(profileUrl, "https://m.media-amazon.com/images/M/new.jpg", 2000);
+    // Profiles without an image are stored as well, so that they aren't loaded again.
+    database.setImdbActorImageUrl("https://www.imdb.com/name/nm0000001/", "", 2000);
+
+    const QHash<QString, QString> imageUrls = database.imdbActorImageUrls(1500);
+    CHECK(imageUrls.size() == 2);
+    CHECK(imageUrls.value(profileUrl) == "https://m.media-amazon.com/images/M/new.jpg");
+    CHECK(imageUrls.value("https://www.imdb.com/name/nm0000001/", "missing").isEmpty());
+    CHECK(database.imdbActorImageUrls(2000).isEmpty());
+}
+
+TEST_CASE("Database creates cached episodes as children of their show", "[data]")
+{
+    const QString fileName = freshDatabaseFile("Episodes.sqlite");
+
+    Database database(fileName);
+    int idShow = -1;
+    {
+        QSqlQuery query(database.db());
+        REQUIRE(query.exec("INSERT INTO shows(dir, content, path) VALUES('/tv/Firefly', '', '/tv')"));
+        idShow = query.lastInsertId().toInt();
+    }
+    TvShowEpisode cached(QStringList{"/tv/Firefly/S01E01.mkv"});
+    cached.setSeason(SeasonNumber(1));
+    cached.setEpisode(EpisodeNumber(1));
+    database.add(&cached, mediaelch::DirectoryPath("/tv"), idShow);
+
+    // Same as a cached reload by LibraryReloader: The searcher loads the library on a worker thread
+    // and is then moved back to the GUI thread together with all objects it created.
+    QObject searcher;
+    QThread worker;
+    searcher.moveToThread(&worker);
+    QThread* guiThread = QThread::currentThread();
+    QVector<TvShowEpisode*> episodes;
+    QObject::connect(&worker, &QThread::started, &searcher, [&]() {
+        auto* show = new TvShow(mediaelch::DirectoryPath("/tv/Firefly"), &searcher);
+        show->setDatabaseId(idShow);
+        episodes = database.episodes(show);
+        searcher.moveToThread(guiThread);
+        QThread::currentThread()->quit();
+    });
+    worker.start();
+    REQUIRE(worker.wait(10000));
+
+    REQUIRE(episodes.size() == 1);
+    CHECK(episodes.first()->files().size() == 1);
+    CHECK(episodes.first()->thread() == qApp->thread());
+    CHECK(episodes.first()->tvShow() != nullptr);
+}
+
+TEST_CASE("Database uses a connection per instance in worker threads", "[data]")
+{
+    const QString moviesFile = freshDatabaseFile("Movies.sqlite");
+    const QString showsFile = freshDatabaseFile("Shows.sqlite");
+    Database movies(moviesFile);
+    Database shows(showsFile);
+
+    QObject context;
+    QThread worker;
+    context.moveToThread(&worker);
+    QStringList databaseNames;
+    QObject::connect(&worker, &QThread::started, &context, [&]() {
+        databaseNames << movies.db().databaseName() << shows.db().databaseName() << movies.db().databaseName();
+        QThread::currentThread()->quit();
+    });
+    worker.start();
+    REQUIRE(worker.wait(10000));
+
+    CHECK(databaseNames == QStringList({moviesFile, showsFile, moviesFile}));
+    CHECK(movies.db().databaseName() == moviesFile);
+    CHECK(shows.db().databaseName() == showsFile);
+}
+
+TEST_CASE("Database reverts renamed paths", "[data]")
+{
+    const QString fileName = freshDatabaseFile("Renamed.sqlite");
+
+    Database database(fileName);
+    QSqlQuery query(database.db());
+    REQUIRE(query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(1, :file)"));
+    for (const QString& file : {"/movies/Alien/Alien.mkv", "/movies/Alien 2/Aliens.mkv", "/movies/Alien"}) {
+        query.bindValue(":file", file.toUtf8());
+        REQUIRE(query.exec());
+    }
+
+    database.renamePath("/movies/Alien", "/movies/Alien (1979)");
+
+    QStringList files;
+    REQUIRE(query.exec("SELECT file FROM movieFiles ORDER BY idFile"));
+    while (query.next()) {
+        files << QString::fromUtf8(query.value(0).toByteArray());
+    }
+    CHECK(files
+          == QStringList({"/movies/Alien (1979)/Alien.mkv", "/movies/Alien 2/Aliens.mkv", "/movies/Alien (1979)"}));
+}
+
+TEST_CASE("Database reports whether writes were committed", "[data]")
+{
+    const QString fileName = freshDatabaseFile("Transactions.sqlite");
+
+    Database database(fileName);
+    Database otherConnection(fileName);
+
+    SECTION("writes are visible to other connections after the commit")
+    {
+        const bool committed = database.writeInTransaction([&database]() {
+            QSqlQuery query(database.db());
+            REQUIRE(query.exec("INSERT INTO movieFiles(idMovie, file) VALUES(1, '/movies/Alien.mkv')"));
+        });
+        CHECK(committed);
+
+        QSqlQuery query(otherConnection.db());
+        REQUIRE(query.exec("SELECT COUNT(*) FROM movieFiles"));
+        REQUIRE(query.next());
+        CHECK(query.value(0).toInt() == 1);
+    }
+
+    SECTION("a commit without transaction fails")
+    {
+        CHECK_FALSE(database.commit());
+    }
+}
@@ -0,0 +1,65 @@
+#include "test/test_helpers.h"
+
+#include "data/LibrarySnapshot.h"
+#include "test/integration/resource_dir.h"
+
+#include <QFile>
+
+using namespace mediaelch;
+
+TEST_CASE("LibrarySnapshot stores list entries", "[data]")
+{
+    const QString fileName = tempDir("data/library_snapshot").filePath("movies.snapshot");
+    QFile::remove(fileName);
+
+    SECTION("missing files are no snapshots")
+    {
+        CHECK(LibrarySnapshot::open(fileName) == nullptr);
+    }
+
+    SECTION("entries are read back")
+    {
+        LibrarySnapshot::Entry alien;
+        alien.databaseId = 42;
+        alien.year = 1979;
+        alien.flags = LibrarySnapshot::InfoLoaded | LibrarySnapshot::Watched;
+        alien.label = 3;
+        alien.title = "Alien";
+        alien.path = "/movies/Alien (1979)/Alien.mkv";
+
+        LibrarySnapshot::Entry amelie;
+        amelie.title = QString::fromUtf8("Die fabelhafte Welt der Amélie");
+        amelie.sortTitle = "Fabelhafte Welt der Amélie";
+
+        REQUIRE(LibrarySnapshot::write(fileName, {alien, amelie}));
+        auto snapshot = LibrarySnapshot::open(fileName);
+        REQUIRE(snapshot != nullptr);
+        REQUIRE(snapshot->count() == 2);
+
+        const LibrarySnapshot::Entry first = snapshot->entry(0);
+        CHECK(first.databaseId == 42);
+        CHECK(first.year == 1979);
+        CHECK(first.flags == (LibrarySnapshot::InfoLoaded | LibrarySnapshot::Watched));
+        CHECK(first.label == 3);
+        CHECK(first.title == alien.title);
+        CHECK(first.sortTitle.isEmpty());
+        CHECK(first.path == alien.path);
+
+        const LibrarySnapshot::Entry second = snapshot->entry(1);
+        CHECK(second.databaseId == -1);
+        CHECK(second.title == amelie.title);
+        CHECK(second.sortTitle == amelie.sortTitle);
+
+        CHECK(snapshot->entry(2).title.isEmpty());
+    }
+
+    SECTION("truncated files are ignored")
+    {
+        LibrarySnapshot::Entry entry;
+        entry.title = "Alien";
+        REQUIRE(LibrarySnapshot::write(fileName, {entry, entry}));
+        QFile file(fileName);
+        REQUIRE(file.resize(20));
+        CHECK(LibrarySnapshot::open(fileName) == nullptr);
+    }
+}
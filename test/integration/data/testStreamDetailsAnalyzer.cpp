@@ -0,0 +1,70 @@
+#include "test/test_helpers.h"
+
+#include "data/StreamDetailsAnalyzer.h"
+#include "movies/Movie.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+using namespace mediaelch;
+
+TEST_CASE("StreamDetailsAnalyzer keeps its queue between sessions", "[data]")
+{
+    const QString queueFile = tempDir("data/stream_details").filePath("queue.json");
+    QFile::remove(queueFile);
+
+    Movie alien(QStringList{"/movies/Alien.mkv"});
+    Movie aliens(QStringList{"/movies/Aliens.mkv"});
+    Movie alien3(QStringList{"/movies/Alien 3.mkv"});
+
+    SECTION("items are restored in the order in which they were queued")
+    {
+        {
+            StreamDetailsAnalyzer analyzer(queueFile);
+            // Paused, so that no file is probed.
+            analyzer.pause();
+            analyzer.enqueue(QVector<Movie*>{&alien, &aliens});
+            analyzer.enqueue(QVector<Movie*>{&alien3});
+            CHECK(analyzer.queuedFiles()
+                  == QStringList({"/movies/Alien.mkv", "/movies/Aliens.mkv", "/movies/Alien 3.mkv"}));
+            // Stored with a delay, but at the latest when the analyzer is destroyed.
+        }
+        REQUIRE(QFile::exists(queueFile));
+
+        StreamDetailsAnalyzer analyzer(queueFile);
+        CHECK(analyzer.isPaused());
+        CHECK(analyzer.unresolvedCount() == 3);
+        analyzer.restore(QVector<Movie*>{&alien3, &alien, &aliens});
+        CHECK(analyzer.unresolvedCount() == 0);
+        CHECK(analyzer.queuedFiles()
+              == QStringList({"/movies/Alien.mkv", "/movies/Aliens.mkv", "/movies/Alien 3.mkv"}));
+    }
+
+    SECTION("items that were not found for a long time are dropped")
+    {
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const qint64 twoMonthsAgo = now - 60LL * 24 * 60 * 60 * 1000;
+        const QJsonArray items{
+            QJsonObject{{"type", "movie"}, {"file", "/movies/Alien.mkv"}, {"queuedAt", double(twoMonthsAgo)}},
+            QJsonObject{{"type", "movie"}, {"file", "/movies/Aliens.mkv"}, {"queuedAt", double(now)}},
+            // Stored by older versions
+            QJsonObject{{"type", "movie"}, {"file", "/movies/Alien 3.mkv"}}};
+        {
+            QFile file(queueFile);
+            REQUIRE(file.open(QIODevice::WriteOnly));
+            file.write(QJsonDocument(QJsonObject{{"paused", true}, {"items", items}}).toJson());
+        }
+
+        StreamDetailsAnalyzer analyzer(queueFile);
+        CHECK(analyzer.unresolvedCount() == 2);
+        analyzer.restore(QVector<Movie*>{&alien, &aliens, &alien3});
+        CHECK(analyzer.queuedFiles() == QStringList({"/movies/Aliens.mkv", "/movies/Alien 3.mkv"}));
+    }
+
+    QFile::remove(queueFile);
+}
@@ -36,9 +36,8 @@ QVector<Movie*> fakeMovies()
     return moviePtrs;
 }
 
-TEST_CASE("Simple HTML export", "[export][simple]")
+static void setUpTestTemplate(ExportTemplate& exportTemplate)
 {
-    ExportTemplate exportTemplate;
     exportTemplate.setName("Test Template");
     exportTemplate.setAuthor("MediaElch authors");
     exportTemplate.setTemplateEngine(ExportEngine::Simple);
@@ -47,6 +46,12 @@ TEST_CASE("Simple HTML export", "[export][simple]")
     exportTemplate.setIdentifier("test-template");
     exportTemplate.addDescription("en", "Export Template for Testing");
     exportTemplate.setDirectory(exportDir("simple"));
+}
+
+TEST_CASE("Simple HTML export", "[export][simple]")
+{
+    ExportTemplate exportTemplate;
+    setUpTestTemplate(exportTemplate);
 
     std::atomic_bool cancelFlag{false};
 
@@ -70,3 +75,20 @@ TEST_CASE("Simple HTML export", "[export][simple]")
         CHECK_FALSE(moviesHtml.contains("}"));
     }
 }
+
+TEST_CASE("Cancelled simple HTML export", "[export][simple]")
+{
+    ExportTemplate exportTemplate;
+    setUpTestTemplate(exportTemplate);
+
+    std::atomic_bool cancelFlag{true};
+
+    SimpleEngine engine(exportTemplate, tempDir("export/simple_cancelled"), cancelFlag);
+    engine.exportMovies(fakeMovies());
+
+    // The list page is left incomplete; neither items nor its end are written.
+    QString moviesHtml = getTempFileContent("export/simple_cancelled/movies.html");
+    CHECK(moviesHtml.contains("<title>Movies</title>"));
+    CHECK_FALSE(moviesHtml.contains("Oceans 12"));
+    CHECK_FALSE(moviesHtml.contains("</html>"));
+}
@@ -0,0 +1,59 @@
+#include "test/test_helpers.h"
+
+#include "file/DirectoryListingCache.h"
+#include "test/integration/resource_dir.h"
+
+#include <QFile>
+
+using namespace mediaelch;
+
+TEST_CASE("DirectoryListingCache", "[path]")
+{
+    QDir dir = tempDir("file/directory_listing_cache");
+    for (const QString& file : dir.entryList(QDir::Files | QDir::Hidden)) {
+        dir.remove(file);
+    }
+    writeTempFile("file/directory_listing_cache/movie.mkv", "");
+    writeTempFile("file/directory_listing_cache/movie-poster.jpg", "");
+    writeTempFile("file/directory_listing_cache/Movie-fanart.JPG", "");
+    writeTempFile("file/directory_listing_cache/.hidden.jpg", "");
+
+    const DirectoryPath path(dir);
+    DirectoryListingCache cache;
+
+    SECTION("files are found in the listing")
+    {
+        CHECK(cache.isFile(path, "movie-poster.jpg"));
+        CHECK(cache.isFile(path.filePath("movie.mkv")));
+        CHECK(cache.isFile(path, ".hidden.jpg"));
+        CHECK_FALSE(cache.isFile(path, "movie-banner.jpg"));
+        CHECK_FALSE(cache.isFile(DirectoryPath(dir.filePath("extrafanart")), "fanart1.jpg"));
+        CHECK(cache.cachedDirectories() == 2);
+    }
+
+    SECTION("name filters and sorting work like QDir::entryList()")
+    {
+        CHECK(cache.files(path, {"*.jpg"}) == QStringList({"Movie-fanart.JPG", "movie-poster.jpg"}));
+        CHECK(cache.files(path, {"*.jpg"}, QDir::Files, QDir::Name)
+              == QStringList({"Movie-fanart.JPG", "movie-poster.jpg"}));
+        CHECK(cache.files(path, {"*.jpg"}, QDir::Files | QDir::Hidden)
+              == QStringList({".hidden.jpg", "Movie-fanart.JPG", "movie-poster.jpg"}));
+        CHECK(cache.files(path, {"*.mkv", "*.avi"}) == QStringList({"movie.mkv"}));
+        CHECK(cache.files(path, {"*.mkv"}) == dir.entryList({"*.mkv"}, QDir::Files));
+    }
+
+    SECTION("listings are only updated after invalidation")
+    {
+        REQUIRE_FALSE(cache.isFile(path, "movie-banner.jpg"));
+        writeTempFile("file/directory_listing_cache/movie-banner.jpg", "");
+        CHECK_FALSE(cache.isFile(path, "movie-banner.jpg"));
+
+        cache.invalidateFileDir(path.filePath("movie-banner.jpg"));
+        CHECK(cache.isFile(path, "movie-banner.jpg"));
+
+        QFile::remove(path.filePath("movie-banner.jpg"));
+        cache.clear();
+        CHECK(cache.cachedDirectories() == 0);
+        CHECK_FALSE(cache.isFile(path, "movie-banner.jpg"));
+    }
+}
@@ -0,0 +1,132 @@
+#include "test/test_helpers.h"
+
+#include "imports/FileWorker.h"
+#include "imports/MyFile.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+
+static QDir freshImportDir(const QString& name)
+{
+    QDir dir = tempDir("imports/" + name);
+    dir.removeRecursively();
+    dir.mkpath(".");
+    return dir;
+}
+
+static void writeFile(const QString& fileName, const QByteArray& content)
+{
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    REQUIRE(file.write(content) == content.size());
+}
+
+static QByteArray readFile(const QString& fileName)
+{
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+TEST_CASE("FileWorker copies files and keeps the sources", "[imports]")
+{
+    QDir dir = freshImportDir("copy");
+    dir.mkpath("dest");
+    const QByteArray content(300 * 1024, 'x');
+    writeFile(dir.filePath("movie.mkv"), content);
+    writeFile(dir.filePath("movie.nfo"), "<movie/>");
+
+    FileWorker worker;
+    worker.setFiles(QMap<QString, QString>{{dir.filePath("movie.mkv"), dir.filePath("dest/movie.mkv")},
+        {dir.filePath("movie.nfo"), dir.filePath("dest/movie.nfo")}});
+
+    qint64 lastTransferred = 0;
+    qint64 lastTotal = 0;
+    QObject::connect(&worker, &FileWorker::sigProgress, [&](qint64 transferred, qint64 total, qint64) {
+        lastTransferred = transferred;
+        lastTotal = total;
+    });
+    bool finished = false;
+    QObject::connect(&worker, &FileWorker::sigFinished, [&]() { finished = true; });
+
+    worker.copyFiles();
+
+    CHECK(finished);
+    CHECK(readFile(dir.filePath("dest/movie.mkv")) == content);
+    CHECK(readFile(dir.filePath("dest/movie.nfo")) == "<movie/>");
+    CHECK(QFileInfo::exists(dir.filePath("movie.mkv")));
+    CHECK(QFileInfo::exists(dir.filePath("movie.nfo")));
+    CHECK(lastTotal == content.size() + 8);
+    CHECK(lastTransferred == lastTotal);
+}
+
+TEST_CASE("FileWorker renames files when moving them on the same device", "[imports]")
+{
+    QDir dir = freshImportDir("move");
+    dir.mkpath("dest");
+    const QByteArray content(64 * 1024, 'y');
+    writeFile(dir.filePath("episode.mkv"), content);
+
+    FileWorker worker;
+    worker.setFiles(QMap<QString, QString>{{dir.filePath("episode.mkv"), dir.filePath("dest/S01E01.mkv")}});
+    qint64 lastTransferred = 0;
+    QObject::connect(&worker, &FileWorker::sigProgress, [&](qint64 transferred, qint64, qint64) {
+        lastTransferred = transferred;
+    });
+
+    worker.moveFiles();
+
+    CHECK_FALSE(QFileInfo::exists(dir.filePath("episode.mkv")));
+    CHECK(readFile(dir.filePath("dest/S01E01.mkv")) == content);
+    CHECK(lastTransferred == content.size());
+}
+
+TEST_CASE("FileWorker keeps the source if moving it fails", "[imports]")
+{
+    QDir dir = freshImportDir("move_fails");
+    dir.mkpath("dest");
+    writeFile(dir.filePath("concert.mkv"), "new");
+
+    SECTION("destination already exists")
+    {
+        // Neither renaming nor the copy fallback may overwrite existing files.
+        writeFile(dir.filePath("dest/concert.mkv"), "existing");
+        FileWorker worker;
+        worker.setFiles(QMap<QString, QString>{{dir.filePath("concert.mkv"), dir.filePath("dest/concert.mkv")}});
+        worker.moveFiles();
+
+        CHECK(readFile(dir.filePath("concert.mkv")) == "new");
+        CHECK(readFile(dir.filePath("dest/concert.mkv")) == "existing");
+    }
+
+    SECTION("destination directory does not exist")
+    {
+        FileWorker worker;
+        worker.setFiles(QMap<QString, QString>{{dir.filePath("concert.mkv"), dir.filePath("missing/concert.mkv")}});
+        worker.moveFiles();
+
+        CHECK(readFile(dir.filePath("concert.mkv")) == "new");
+        CHECK_FALSE(QFileInfo::exists(dir.filePath("missing/concert.mkv")));
+    }
+}
+
+TEST_CASE("MyFile reports the checksum of copied data", "[imports]")
+{
+    QDir dir = freshImportDir("checksum");
+    const QByteArray content(200 * 1024, 'z');
+    writeFile(dir.filePath("source.mkv"), content);
+
+    MyFile file(dir.filePath("source.mkv"));
+    QByteArray checksum;
+    qint64 progress = 0;
+    REQUIRE(file.copy(dir.filePath("copy.mkv"), [&](qint64 bytes) { progress += bytes; }, &checksum));
+
+    CHECK_FALSE(checksum.isEmpty());
+    CHECK(checksum == MyFile::checksum(dir.filePath("source.mkv")));
+    CHECK(checksum == MyFile::checksum(dir.filePath("copy.mkv")));
+    CHECK(progress == content.size());
+    CHECK_FALSE(file.copy(dir.filePath("copy.mkv")));
+}
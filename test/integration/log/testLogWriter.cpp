@@ -0,0 +1,126 @@
+#include "test/test_helpers.h"
+
+#include "log/Log.h"
+#include "log/LogWriter.h"
+#include "test/integration/resource_dir.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QStringList>
+#include <QVector>
+
+#include <thread>
+#include <vector>
+
+using namespace mediaelch;
+
+static QStringList readLines(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly)) {
+        return {};
+    }
+    return QString::fromLocal8Bit(file.readAll()).split(QRegExp("\r?\n"), QString::SkipEmptyParts);
+}
+
+TEST_CASE("LogWriter", "[log]")
+{
+    QDir dir = tempDir("log/log_writer");
+    for (const QString& file : dir.entryList(QDir::Files)) {
+        dir.remove(file);
+    }
+    const QString logFile = dir.filePath("MediaElch.log");
+
+    SECTION("messages of many threads are all written in order per thread")
+    {
+        LogWriter writer(64);
+        writer.setOverflowPolicy(LogOverflowPolicy::Block);
+        REQUIRE(writer.openFile(logFile));
+
+        const int threadCount = 4;
+        const int messagesPerThread = 500;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&writer, t]() {
+                for (int i = 0; i < messagesPerThread; ++i) {
+                    writer.write(QStringLiteral("%1 %2").arg(t).arg(i).toLocal8Bit());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        writer.flush();
+
+        const QStringList lines = readLines(logFile);
+        REQUIRE(lines.size() == threadCount * messagesPerThread);
+        QVector<int> next(threadCount, 0);
+        for (const QString& line : lines) {
+            const QStringList parts = line.split(' ');
+            REQUIRE(parts.size() == 2);
+            const int thread = parts[0].toInt();
+            CHECK(parts[1].toInt() == next[thread]);
+            ++next[thread];
+        }
+        CHECK(writer.droppedMessages() == 0);
+    }
+
+    SECTION("log file is rotated")
+    {
+        LogWriter writer;
+        writer.setRotation(100, 2);
+        REQUIRE(writer.openFile(logFile));
+
+        const QByteArray line(39, 'x'); // 40 bytes with newline on Linux/macOS
+        for (int i = 0; i < 12; ++i) {
+            writer.write(line);
+            writer.flush(); // one batch per message
+        }
+        writer.stop();
+
+        CHECK(QFile::exists(logFile));
+        CHECK(QFile::exists(logFile + ".1"));
+        CHECK(QFile::exists(logFile + ".2"));
+        CHECK_FALSE(QFile::exists(logFile + ".3"));
+        CHECK(QFileInfo(logFile).size() <= 100);
+        CHECK(QFileInfo(logFile + ".1").size() <= 100);
+    }
+
+    SECTION("stopped writer rejects messages")
+    {
+        LogWriter writer;
+        REQUIRE(writer.openFile(logFile));
+        writer.write("before");
+        writer.stop();
+        CHECK_FALSE(writer.isRunning());
+        CHECK_FALSE(writer.write("after"));
+        CHECK(readLines(logFile) == QStringList({"before"}));
+    }
+}
+
+TEST_CASE("Log levels", "[log]")
+{
+    resetLogLevels();
+    CHECK(isLogLevelEnabled("ImdbApi", QtDebugMsg));
+
+    setLogLevel("ImdbApi", QtWarningMsg);
+    CHECK_FALSE(isLogLevelEnabled("ImdbApi", QtDebugMsg));
+    CHECK_FALSE(isLogLevelEnabled("ImdbApi", QtInfoMsg));
+    CHECK(isLogLevelEnabled("ImdbApi", QtWarningMsg));
+    CHECK(isLogLevelEnabled("ImdbApi", QtCriticalMsg));
+    CHECK(isLogLevelEnabled("TMDb", QtDebugMsg));
+
+    setLogLevel("", QtCriticalMsg);
+    CHECK_FALSE(isLogLevelEnabled("TMDb", QtWarningMsg));
+    CHECK(isLogLevelEnabled("ImdbApi", QtWarningMsg));
+    CHECK(isLogLevelEnabled("TMDb", QtFatalMsg));
+
+    QtMsgType level = QtDebugMsg;
+    CHECK(logLevelFromString(" Warning ", level));
+    CHECK(level == QtWarningMsg);
+    CHECK_FALSE(logLevelFromString("verbose", level));
+
+    resetLogLevels();
+    CHECK(isLogLevelEnabled("TMDb", QtDebugMsg));
+}
@@ -0,0 +1,113 @@
+#include "test/test_helpers.h"
+
+#include "media_centers/kodi/NfoMergeWriter.h"
+#include "media_centers/kodi/v18/MovieXmlWriterV18.h"
+#include "movies/Movie.h"
+
+#include <QDomDocument>
+#include <QtConcurrent>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace mediaelch::kodi;
+
+static QStringList childNames(const QString& xml)
+{
+    QDomDocument doc;
+    REQUIRE(doc.setContent(xml));
+    QStringList names;
+    for (QDomNode node = doc.documentElement().firstChild(); !node.isNull(); node = node.nextSibling()) {
+        names << (node.isComment() ? "#comment" : node.nodeName());
+    }
+    return names;
+}
+
+TEST_CASE("NfoMergeWriter merges into existing NFO content", "[nfo][kodi]")
+{
+    const QString existing = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<movie>
+    <title lang="en">Old Title</title>
+    <!-- keep me -->
+    <custom attr="1"><nested>value</nested></custom>
+    <genre>Drama</genre>
+    <genre>Horror</genre>
+    <year>1979</year>
+</movie>
+)";
+
+    SECTION("unknown elements and comments are kept at their position")
+    {
+        NfoMergeWriter nfo("movie");
+        nfo.setTextValue("title", "Alien");
+        nfo.setListValue("genre", {"Sci-Fi"});
+        nfo.setTextValue("plot", "In space no one can hear you scream.");
+        const QString actual = nfo.merge(existing);
+
+        CHECK(childNames(actual) == QStringList({"title", "#comment", "custom", "year", "genre", "plot"}));
+        QDomDocument doc;
+        REQUIRE(doc.setContent(actual));
+        const QDomElement title = doc.documentElement().firstChildElement("title");
+        CHECK(title.text() == "Alien");
+        CHECK(title.attribute("lang") == "en");
+        CHECK(doc.documentElement().firstChildElement("custom").attribute("attr") == "1");
+        CHECK(doc.documentElement().firstChildElement("custom").firstChildElement("nested").text() == "value");
+        CHECK(doc.documentElement().firstChildElement("year").text() == "1979");
+    }
+
+    SECTION("removed elements are not written")
+    {
+        NfoMergeWriter nfo("movie");
+        nfo.setTextValue("year", "2000");
+        nfo.removeChildNodes("year");
+        nfo.removeChildNodes("custom");
+        CHECK(childNames(nfo.merge(existing)) == QStringList({"title", "#comment", "genre", "genre"}));
+    }
+
+    SECTION("invalid content is replaced by a new document")
+    {
+        NfoMergeWriter nfo("movie");
+        nfo.setTextValue("title", "Alien");
+        CHECK(childNames(nfo.merge("<movie><title>")) == QStringList({"title"}));
+    }
+
+    SECTION("invalid content near the end of a large NFO is replaced completely")
+    {
+        // The partial output of the failed merge is longer than the new document.
+        QString large = "<movie>\n";
+        for (int i = 0; i < 500; ++i) {
+            large += QString("    <tag>Tag %1</tag>\n").arg(i);
+        }
+        large += "    <title>Old Title</plot>\n</movie>\n";
+
+        NfoMergeWriter nfo("movie");
+        nfo.setTextValue("title", "Alien");
+        const QByteArray actual = nfo.merge(large);
+        CHECK_FALSE(actual.contains("Tag 0"));
+        CHECK(childNames(actual) == QStringList({"title"}));
+    }
+}
+
+TEST_CASE("NFO writers can run in parallel", "[nfo][kodi]")
+{
+    std::vector<std::unique_ptr<Movie>> movies;
+    for (int i = 0; i < 200; ++i) {
+        auto movie = std::make_unique<Movie>();
+        movie->setName(QStringLiteral("Movie %1").arg(i));
+        movie->setOverview(QString("Plot of movie %1. ").repeated(i % 20 + 1).arg(i));
+        movie->addGenre(i % 2 == 0 ? "Drama" : "Comedy");
+        movies.push_back(std::move(movie));
+    }
+
+    QVector<Movie*> pointers;
+    QVector<QByteArray> expected;
+    for (auto& movie : movies) {
+        pointers << movie.get();
+        expected << MovieXmlWriterV18(*movie).getMovieXml();
+    }
+
+    std::function<QByteArray(Movie*)> write = [](Movie* movie) { return MovieXmlWriterV18(*movie).getMovieXml(); };
+    const QVector<QByteArray> actual = QtConcurrent::blockingMapped<QVector<QByteArray>>(pointers, write);
+
+    CHECK(actual == expected);
+}
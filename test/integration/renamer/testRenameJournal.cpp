@@ -0,0 +1,81 @@
+#include "test/test_helpers.h"
+
+#include "renamer/RenameJournal.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+using namespace mediaelch;
+
+static QByteArray journalEntry(QJsonArray entry)
+{
+    return QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n';
+}
+
+static QByteArray journalEntry(Renamer::RenameOperation type, const QString& source, const QString& destination)
+{
+    return journalEntry(QJsonArray{static_cast<int>(type), source, destination});
+}
+
+static void touch(const QString& fileName)
+{
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+}
+
+TEST_CASE("RenameJournal reverts the unfinished batch of an interrupted rename", "[renamer]")
+{
+    QDir dir = tempDir("renamer/journal");
+    dir.removeRecursively();
+    dir.mkpath(".");
+
+    // Season 1 existed before and was merged into, Season 2 was created by the rename.
+    const QString existingDir = dir.filePath("Season 1");
+    const QString createdDir = dir.filePath("Season 2");
+    dir.mkpath("Season 1");
+    dir.mkpath("Season 2");
+    touch(existingDir + "/S01E01.mkv");
+    touch(createdDir + "/S02E01.mkv");
+
+    const QString journalFile = dir.filePath("renamer.journal");
+    QFile journal(journalFile);
+    REQUIRE(journal.open(QIODevice::WriteOnly));
+    journal.write(journalEntry(Renamer::RenameOperation::CreateDir, "", existingDir));
+    journal.write(
+        journalEntry(Renamer::RenameOperation::Move, dir.filePath("S01E01.mkv"), existingDir + "/S01E01.mkv"));
+    journal.write(journalEntry(Renamer::RenameOperation::CreateDir, "", createdDir));
+    journal.write(
+        journalEntry(Renamer::RenameOperation::Move, dir.filePath("S02E01.mkv"), createdDir + "/S02E01.mkv"));
+    journal.write(journalEntry(QJsonArray{"created", createdDir}));
+    journal.close();
+
+    CHECK(RenameJournal(journalFile).recover() == 3);
+    CHECK(QFileInfo::exists(dir.filePath("S01E01.mkv")));
+    CHECK(QFileInfo::exists(dir.filePath("S02E01.mkv")));
+    CHECK(QFileInfo(existingDir).isDir());
+    CHECK_FALSE(QFileInfo::exists(createdDir));
+    CHECK_FALSE(QFileInfo::exists(journalFile));
+}
+
+TEST_CASE("RenameJournal doesn't revert committed batches", "[renamer]")
+{
+    QDir dir = tempDir("renamer/journal_committed");
+    dir.removeRecursively();
+    dir.mkpath(".");
+    touch(dir.filePath("Alien.mkv"));
+
+    const QString journalFile = dir.filePath("renamer.journal");
+    QFile journal(journalFile);
+    REQUIRE(journal.open(QIODevice::WriteOnly));
+    journal.write(
+        journalEntry(Renamer::RenameOperation::Rename, dir.filePath("Alien (1979).mkv"), dir.filePath("Alien.mkv")));
+    journal.write("commit\n");
+    journal.close();
+
+    CHECK(RenameJournal(journalFile).recover() == 0);
+    CHECK(QFileInfo::exists(dir.filePath("Alien.mkv")));
+}
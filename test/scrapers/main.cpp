@@ -1,12 +1,50 @@
 #define CATCH_CONFIG_RUNNER
 #include "third_party/catch2/catch.hpp"
 
+#include "network/ReplayTransport.h"
+
 #include <QApplication>
+#include <QDir>
 
 int main(int argc, char** argv)
 {
     QApplication app(argc, argv);
     Catch::Session session; // NOLINT(clang-analyzer-core.uninitialized.UndefReturn)
-    const int res = session.run(argc, argv);
-    return res;
+
+    // Defaults to the MEDIAELCH_NETWORK_* environment variables.
+    mediaelch::network::ReplayConfig replay = mediaelch::network::replayConfig();
+    std::string recordDirString;
+    std::string replayDirString;
+
+    using namespace Catch::clara;
+    auto cli = session.cli()
+               | Opt(recordDirString, "directory")["--record"](
+                   "Record all responses into the given fixture directory.")
+               | Opt(replayDirString, "directory")["--replay"](
+                   "Replay responses from the given fixture directory instead of using the network.")
+               | Opt(replay.latencyMs, "ms")["--latency"]("Simulated latency of replayed responses.")
+               | Opt(replay.bandwidthKiBs, "KiB/s")["--bandwidth"](
+                   "Simulated bandwidth of replayed responses; 0 means unlimited.");
+
+    session.cli(cli);
+
+    const int returnCode = session.applyCommandLine(argc, argv);
+    if (returnCode != 0) {
+        return returnCode;
+    }
+
+    if (!replayDirString.empty()) {
+        replay.mode = mediaelch::network::ReplayMode::Replay;
+        replay.fixtureDir = QString::fromStdString(replayDirString);
+    } else if (!recordDirString.empty()) {
+        replay.mode = mediaelch::network::ReplayMode::Record;
+        replay.fixtureDir = QString::fromStdString(recordDirString);
+    }
+    if (replay.mode == mediaelch::network::ReplayMode::Replay && !QDir(replay.fixtureDir).exists()) {
+        std::cerr << "Fixture directory does not exist: " << replay.fixtureDir.toStdString() << std::endl;
+        return 1;
+    }
+    mediaelch::network::setReplayConfig(replay);
+
+    return session.run();
 }
@@ -0,0 +1,67 @@
+#include "test/test_helpers.h"
+
+#include "export/CompiledTemplate.h"
+
+using namespace mediaelch;
+
+TEST_CASE("CompiledTemplate renders placeholders", "[export]")
+{
+    SECTION("variables")
+    {
+        TemplateValues values;
+        values.set("MOVIE.TITLE", "Alien");
+        values.set("MOVIE.YEAR", "1979");
+
+        CompiledTemplate compiled("<h1>{{ MOVIE.TITLE }} ({{ MOVIE.YEAR }})</h1>");
+        CHECK(compiled.render(values) == "<h1>Alien (1979)</h1>");
+    }
+
+    SECTION("unknown placeholders are kept")
+    {
+        const QString content = "{{ UNKNOWN }} {{ BEGIN_BLOCK_X }}a{{ END_BLOCK_X }} {{ IMAGE.POSTER[100, 150] }}";
+        CHECK(CompiledTemplate(content).render(TemplateValues{}) == content);
+    }
+
+    SECTION("blocks")
+    {
+        TemplateValues values;
+        values.set("MOVIE.TITLE", "Alien");
+        TemplateValues::Variables actor1;
+        actor1.insert("ACTOR.NAME", "Sigourney Weaver");
+        TemplateValues::Variables actor2;
+        actor2.insert("ACTOR.NAME", "Tom Skerritt");
+        values.setBlock("ACTORS", {actor1, actor2}, ", ");
+
+        CompiledTemplate compiled(
+            "{{ BEGIN_BLOCK_ACTORS }} {{ ACTOR.NAME }} in {{ MOVIE.TITLE }} {{ END_BLOCK_ACTORS }}");
+        CHECK(compiled.render(values) == "Sigourney Weaver in Alien, Tom Skerritt in Alien");
+
+        values.setBlock("ACTORS", {});
+        CHECK(compiled.render(values).isEmpty());
+    }
+
+    SECTION("images")
+    {
+        CompiledTemplate compiled("<img src=\"{{ IMAGE.POSTER[100, 150] }}\">");
+        const QString html = compiled.render(TemplateValues{}, [](const QString& type, const QSize& size) {
+            return QStringLiteral("%1_%2x%3.jpg").arg(type).arg(size.width()).arg(size.height());
+        });
+        CHECK(html == "<img src=\"poster_100x150.jpg\">");
+    }
+
+    SECTION("split list template")
+    {
+        CompiledTemplate compiled("<ul>{{ BEGIN_BLOCK_MOVIE }}<li>{{ MOVIE.TITLE }}</li>{{ END_BLOCK_MOVIE }}</ul>");
+        CompiledTemplate before;
+        CompiledTemplate item;
+        CompiledTemplate after;
+        REQUIRE(compiled.splitAtBlock("MOVIE", before, item, after));
+
+        TemplateValues values;
+        values.set("MOVIE.TITLE", "Alien");
+        CHECK(before.render(values) == "<ul>");
+        CHECK(item.render(values) == "<li>Alien</li>");
+        CHECK(after.render(values) == "</ul>");
+        CHECK_FALSE(compiled.splitAtBlock("CONCERT", before, item, after));
+    }
+}
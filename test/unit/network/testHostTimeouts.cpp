@@ -0,0 +1,52 @@
+#include "test/test_helpers.h"
+
+#include "network/HostTimeouts.h"
+
+using namespace mediaelch::network;
+
+TEST_CASE("HostTimeouts", "[network]")
+{
+    HostTimeouts& timeouts = HostTimeouts::instance();
+    timeouts.clear();
+
+    SECTION("unknown hosts get the default timeout")
+    {
+        CHECK(timeouts.timeoutFor("example.com") == HostTimeouts::defaultTimeout());
+    }
+
+    SECTION("fast hosts time out early")
+    {
+        for (int i = 0; i < 20; ++i) {
+            timeouts.reportLatency("fast.example.com", 200);
+        }
+        CHECK(timeouts.timeoutFor("fast.example.com") == HostTimeouts::minTimeout());
+    }
+
+    SECTION("slow but healthy hosts are given more time")
+    {
+        for (int i = 0; i < 20; ++i) {
+            timeouts.reportLatency("slow.example.com", i % 2 == 0 ? 7000 : 9000);
+        }
+        const int timeout = timeouts.timeoutFor("slow.example.com");
+        CHECK(timeout > 9000);
+        CHECK(timeout <= HostTimeouts::maxTimeout());
+    }
+
+    SECTION("timeouts back off until the host is considered dead")
+    {
+        const QString host = "dead.example.com";
+        timeouts.reportTimeout(host);
+        CHECK(timeouts.timeoutFor(host) == 2 * HostTimeouts::defaultTimeout());
+        timeouts.reportTimeout(host);
+        CHECK(timeouts.timeoutFor(host) == 4 * HostTimeouts::defaultTimeout());
+        timeouts.reportTimeout(host);
+        CHECK(timeouts.timeoutFor(host) == HostTimeouts::minTimeout());
+
+        // One response and the host is alive again.
+        timeouts.reportLatency(host, 1000);
+        CHECK(timeouts.timeoutFor(host) == HostTimeouts::minTimeout());
+        CHECK(timeouts.timeoutFor("other.example.com") == HostTimeouts::defaultTimeout());
+    }
+
+    timeouts.clear();
+}
@@ -0,0 +1,114 @@
+#include "test/test_helpers.h"
+
+#include "network/NetworkManager.h"
+#include "network/ReplayTransport.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTemporaryDir>
+
+using namespace mediaelch::network;
+
+static QNetworkReply* getSync(const QUrl& url)
+{
+    QNetworkReply* reply = accessManager()->get(QNetworkRequest(url));
+    QEventLoop loop;
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+    return reply;
+}
+
+TEST_CASE("NetworkFixtureStore", "[network][replay]")
+{
+    SECTION("keys ignore API keys and the order of query items")
+    {
+        const QString key = NetworkFixtureStore::keyFor(QNetworkAccessManager::GetOperation,
+            QUrl("https://api.themoviedb.org/3/movie/127380?language=en&api_key=secret&append=images"));
+        CHECK(key == "GET https://api.themoviedb.org/3/movie/127380?append=images&language=en");
+        CHECK(key
+              == NetworkFixtureStore::keyFor(QNetworkAccessManager::GetOperation,
+                  QUrl("https://api.themoviedb.org/3/movie/127380?append=images&language=en&api_key=other")));
+        CHECK(key
+              != NetworkFixtureStore::keyFor(QNetworkAccessManager::PostOperation,
+                  QUrl("https://api.themoviedb.org/3/movie/127380?append=images&language=en")));
+    }
+
+    SECTION("fixtures can be saved and loaded")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        NetworkFixtureStore store(QDir(dir.path()));
+        const QUrl url("https://webservice.fanart.tv/v3/movies/127380?api_key=secret");
+
+        NetworkFixture fixture;
+        fixture.url = url;
+        fixture.statusCode = 200;
+        fixture.headers.append({"Content-Type", "application/json"});
+        fixture.body = QByteArray("{\"name\":\"Finding Dory\"}\0binary", 30);
+        REQUIRE(store.save(QNetworkAccessManager::GetOperation, url, fixture));
+
+        NetworkFixture loaded;
+        REQUIRE(store.load(QNetworkAccessManager::GetOperation, url, loaded));
+        CHECK(loaded.url == QUrl("https://webservice.fanart.tv/v3/movies/127380"));
+        CHECK(loaded.statusCode == 200);
+        REQUIRE(loaded.headers.size() == 1);
+        CHECK(loaded.headers[0].second == "application/json");
+        CHECK(loaded.body == fixture.body);
+        CHECK(loaded.error == QNetworkReply::NoError);
+
+        CHECK_FALSE(store.load(QNetworkAccessManager::PostOperation, url, loaded));
+    }
+}
+
+TEST_CASE("Replayed responses", "[network][replay]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QUrl url("https://api.themoviedb.org/3/movie/127380");
+
+    NetworkFixture fixture;
+    fixture.url = url;
+    fixture.statusCode = 200;
+    fixture.body = QByteArray(64 * 1024, 'x');
+    REQUIRE(NetworkFixtureStore(QDir(dir.path())).save(QNetworkAccessManager::GetOperation, url, fixture));
+
+    const ReplayConfig previousConfig = replayConfig();
+    ReplayConfig config;
+    config.mode = ReplayMode::Replay;
+    config.fixtureDir = dir.path();
+
+    SECTION("serve the recorded body")
+    {
+        setReplayConfig(config);
+        QNetworkReply* reply = getSync(url);
+        CHECK(reply->error() == QNetworkReply::NoError);
+        CHECK(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200);
+        CHECK(reply->readAll() == fixture.body);
+        reply->deleteLater();
+    }
+
+    SECTION("simulate latency and bandwidth")
+    {
+        config.latencyMs = 50;
+        config.bandwidthKiBs = 640; // 64 KiB take 100 ms
+        setReplayConfig(config);
+
+        QElapsedTimer timer;
+        timer.start();
+        QNetworkReply* reply = getSync(url);
+        CHECK(timer.elapsed() >= 140);
+        CHECK(reply->readAll().size() == fixture.body.size());
+        reply->deleteLater();
+    }
+
+    SECTION("fail for requests without a recorded response")
+    {
+        setReplayConfig(config);
+        QNetworkReply* reply = getSync(QUrl("https://api.themoviedb.org/3/movie/1"));
+        CHECK(reply->error() == QNetworkReply::ContentNotFoundError);
+        CHECK(reply->readAll().isEmpty());
+        reply->deleteLater();
+    }
+
+    setReplayConfig(previousConfig);
+}
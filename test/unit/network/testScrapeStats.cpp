@@ -0,0 +1,146 @@
+#include "test/test_helpers.h"
+
+#include "network/ScrapeStats.h"
+
+#include <QTemporaryDir>
+
+using namespace mediaelch::network;
+
+static RequestSample sample(QString provider, QString item, QString phase, qint64 startedAt, qint64 durationMs)
+{
+    RequestSample s;
+    s.tag = {std::move(provider), std::move(item), std::move(phase)};
+    s.startedAt = startedAt;
+    s.durationMs = durationMs;
+    return s;
+}
+
+TEST_CASE("ScrapeStats provider statistics", "[network][stats]")
+{
+    QVector<RequestSample> samples;
+    for (int i = 1; i <= 100; ++i) {
+        RequestSample s = sample("TMDb", "Movie", "infos", 0, i * 10);
+        s.bytes = 1024;
+        s.timedOut = (i == 100);
+        s.failed = s.timedOut;
+        samples << s;
+    }
+    RequestSample retried = sample("IMDb", "Movie", "infos", 0, 50);
+    retried.retries = 2;
+    samples << retried;
+
+    const QVector<ProviderStats> stats = ScrapeStats::providerStats(samples);
+    REQUIRE(stats.size() == 2);
+
+    const ProviderStats& imdb = stats[0];
+    CHECK(imdb.provider == "IMDb");
+    CHECK(imdb.requests == 1);
+    CHECK(imdb.retries == 2);
+    CHECK(imdb.p50Ms == 50);
+    CHECK(imdb.p99Ms == 50);
+
+    const ProviderStats& tmdb = stats[1];
+    CHECK(tmdb.provider == "TMDb");
+    CHECK(tmdb.requests == 100);
+    CHECK(tmdb.timeouts == 1);
+    CHECK(tmdb.failed == 1);
+    CHECK(tmdb.bytes == 100 * 1024);
+    CHECK(tmdb.p50Ms == 500);
+    CHECK(tmdb.p95Ms == 950);
+    CHECK(tmdb.p99Ms == 990);
+    CHECK(tmdb.maxMs == 1000);
+
+    REQUIRE(tmdb.histogram.size() == ScrapeStats::histogramBuckets().size() + 1);
+    CHECK(tmdb.histogram[0] == 10); // <= 100 ms
+    CHECK(tmdb.histogram[1] == 15); // <= 250 ms
+}
+
+TEST_CASE("ScrapeStats critical path", "[network][stats]")
+{
+    // "infos" and "images" run in parallel; "collection" and the download follow "infos".
+    const QVector<RequestSample> samples{sample("TMDb", "Movie", "infos", 0, 300),
+        sample("TMDb", "Movie", "images", 10, 200),
+        sample("TMDb", "Movie", "collection", 310, 100),
+        sample("TMDb", "Movie", "download", 420, 80),
+        sample("TMDb", "Other", "infos", 0, 50),
+        sample("TMDb", "", "search", 0, 5000)};
+
+    const QVector<ItemCriticalPath> paths = ScrapeStats::criticalPaths(samples);
+    REQUIRE(paths.size() == 2); // requests without an item are ignored
+
+    const ItemCriticalPath& movie = paths[0];
+    CHECK(movie.item == "Movie");
+    CHECK(movie.requests == 4);
+    CHECK(movie.wallMs == 500);
+    CHECK(movie.criticalMs == 480);
+    REQUIRE(movie.path.size() == 3);
+    CHECK(criticalPathToString(movie) == "TMDb infos 300 ms > TMDb collection 100 ms > TMDb download 80 ms");
+
+    CHECK(paths[1].item == "Other");
+    CHECK(paths[1].wallMs == 50);
+}
+
+TEST_CASE("ScrapeStats critical paths of several runs", "[network][stats]")
+{
+    // The same movie was scraped in an earlier session and again in this one.
+    RequestSample earlierInfos = sample("TMDb", "Movie", "infos", 0, 300);
+    earlierInfos.run = "earlier";
+    RequestSample earlierImages = sample("TMDb", "Movie", "images", 310, 100);
+    earlierImages.run = "earlier";
+    RequestSample laterInfos = sample("TMDb", "Movie", "infos", 3600000, 200);
+    laterInfos.run = "later";
+
+    const QVector<ItemCriticalPath> paths = ScrapeStats::criticalPaths({earlierInfos, laterInfos, earlierImages});
+    REQUIRE(paths.size() == 2);
+
+    CHECK(paths[0].run == "earlier");
+    CHECK(paths[0].item == "Movie");
+    CHECK(paths[0].requests == 2);
+    CHECK(paths[0].wallMs == 410);
+
+    CHECK(paths[1].run == "later");
+    CHECK(paths[1].requests == 1);
+    CHECK(paths[1].wallMs == 200);
+}
+
+TEST_CASE("ScrapeStats keeps the run of stored samples", "[network][stats]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.path() + "/scrape-stats.json";
+
+    ScrapeStats& stats = ScrapeStats::instance();
+    stats.clear();
+    stats.record(sample("TMDb", "Movie", "infos", 0, 300));
+    RequestSample earlier = sample("TMDb", "Movie", "infos", 0, 100);
+    earlier.run = "earlier";
+    stats.record(earlier);
+    REQUIRE(stats.save(fileName));
+
+    stats.clear();
+    REQUIRE(stats.load(fileName));
+    const QVector<RequestSample> loaded = stats.samples();
+    stats.clear();
+
+    REQUIRE(loaded.size() == 2);
+    CHECK(loaded[0].run == stats.runId());
+    CHECK(loaded[1].run == "earlier");
+}
+
+TEST_CASE("ScrapeStats request tags", "[network][stats]")
+{
+    QNetworkRequest request(QUrl("https://api.themoviedb.org/3/movie/550"));
+    RequestTag tag = requestTag(request);
+    CHECK(tag.provider == "TMDb");
+    CHECK(tag.phase == "request");
+    CHECK(tag.item.isEmpty());
+
+    setRequestTag(request, {"", "Fight Club", "infos"});
+    tag = requestTag(request);
+    CHECK(tag.provider == "TMDb");
+    CHECK(tag.item == "Fight Club");
+    CHECK(tag.phase == "infos");
+
+    CHECK(providerForHost("assets.fanart.tv") == "FanartTv");
+    CHECK(providerForHost("www.example.com") == "example.com");
+}
@@ -0,0 +1,40 @@
+#include "test/test_helpers.h"
+
+#include "renamer/RenamerTemplate.h"
+
+using namespace mediaelch;
+
+TEST_CASE("RenamerTemplate renders placeholders", "[renamer]")
+{
+    SECTION("placeholders")
+    {
+        RenamerValues values;
+        values.set("title", "Alien");
+        values.set("year", "1979");
+        values.set("extension", "mkv");
+
+        RenamerTemplate compiled("<title> (<year>).<extension>");
+        CHECK(compiled.render(values) == "Alien (1979).mkv");
+    }
+
+    SECTION("unknown placeholders and conditions are kept")
+    {
+        const QString pattern = "<unknown> {unknown}a{/unknown} <title";
+        CHECK(RenamerTemplate(pattern).render(RenamerValues{}) == pattern);
+    }
+
+    SECTION("conditions")
+    {
+        RenamerValues values;
+        values.set("title", "Alien");
+        values.setCondition("3D", true);
+        values.setValueCondition("partNo", "");
+
+        RenamerTemplate compiled("<title>{3D} 3D{/3D}{partNo}-part<partNo>{/partNo}");
+        CHECK(compiled.render(values) == "Alien 3D");
+
+        values.setCondition("3D", false);
+        values.setValueCondition("partNo", "2");
+        CHECK(compiled.render(values) == "Alien-part2");
+    }
+}
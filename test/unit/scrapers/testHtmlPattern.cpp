@@ -0,0 +1,39 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/HtmlPattern.h"
+
+using mediaelch::scraper::HtmlPattern;
+
+TEST_CASE("HtmlPattern matches like QRegExp with setMinimal(true)", "[scraper][HtmlPattern]")
+{
+    const QString html = "<div class=\"a\">\nfirst\n</div><div class=\"a\">second</div>";
+
+    SECTION("quantifiers are lazy and dots match newlines")
+    {
+        const HtmlPattern rx("<div class=\"a\">(.*)</div>");
+        CHECK(rx.capture(html) == "\nfirst\n");
+        CHECK(rx.captureAll(html) == QStringList({"\nfirst\n", "second"}));
+    }
+
+    SECTION("greedy matching")
+    {
+        const HtmlPattern rx("<div class=\"a\">(.*)</div>", HtmlPattern::Matching::Greedy);
+        CHECK(rx.capture(html) == "\nfirst\n</div><div class=\"a\">second");
+    }
+
+    SECTION("no match")
+    {
+        const HtmlPattern rx("<span>(.*)</span>");
+        QRegularExpressionMatch match;
+        CHECK_FALSE(rx.find(html, match));
+        CHECK(rx.capture(html).isEmpty());
+        CHECK(rx.captureAll(html).isEmpty());
+    }
+
+    SECTION("replaced")
+    {
+        const HtmlPattern rx("\\s+", HtmlPattern::Matching::Greedy);
+        CHECK(rx.replaced("a \n b", " ") == "a b");
+        CHECK(mediaelch::scraper::removeHtmlTags("<b>Title</b> <i>(2010)</i>") == "Title (2010)");
+    }
+}
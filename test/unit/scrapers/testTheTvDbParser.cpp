@@ -0,0 +1,57 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/tv_show/thetvdb/ShowParser.h"
+
+using namespace thetvdb;
+
+TEST_CASE("TheTvDb episode page parser", "[scraper][TheTvDb]")
+{
+    const QString json = R"json({
+        "links": {"first": 1, "last": 3, "next": 2, "prev": null},
+        "data": [
+            {"id": 1001, "airedSeason": 1, "airedEpisodeNumber": 2, "dvdSeason": 2, "dvdEpisodeNumber": 5,
+             "episodeName": "Pilot", "firstAired": "2005-2-6", "directors": [" Jane Doe ", ""],
+             "writers": ["John Doe"], "siteRating": 7.5, "siteRatingCount": 42, "filename": "episodes/1001.jpg"},
+            {"id": 1002, "airedSeason": null, "airedEpisodeNumber": null}
+        ]
+    })json";
+
+    SECTION("aired order")
+    {
+        const EpisodePage page = ShowParser::parseEpisodePage(json, SeasonOrder::Aired);
+        REQUIRE(page.isValid);
+        CHECK(page.paginate.next == 2);
+        CHECK(page.paginate.last == 3);
+        REQUIRE(page.episodes.size() == 2);
+
+        const EpisodeData& first = page.episodes[0];
+        CHECK(first.tvdbId == TvDbId(1001));
+        CHECK(first.season == SeasonNumber(1));
+        CHECK(first.episode == EpisodeNumber(2));
+        CHECK(first.title == "Pilot");
+        CHECK(first.firstAired == QDate(2005, 2, 6));
+        CHECK(first.directors == QStringList({"Jane Doe"}));
+        CHECK(first.writers == QStringList({"John Doe"}));
+        CHECK(first.rating.voteCount == 42);
+        CHECK(first.thumbnail == QUrl("https://www.thetvdb.com/banners/episodes/1001.jpg"));
+
+        CHECK(page.episodes[1].season == SeasonNumber::NoSeason);
+        CHECK(page.episodes[1].episode == EpisodeNumber::NoEpisode);
+    }
+
+    SECTION("DVD order")
+    {
+        const EpisodePage page = ShowParser::parseEpisodePage(json, SeasonOrder::Dvd);
+        REQUIRE(page.episodes.size() == 2);
+        CHECK(page.episodes[0].season == SeasonNumber(2));
+        CHECK(page.episodes[0].episode == EpisodeNumber(5));
+    }
+
+    SECTION("invalid JSON")
+    {
+        const EpisodePage page = ShowParser::parseEpisodePage("{", SeasonOrder::Aired);
+        CHECK_FALSE(page.isValid);
+        CHECK(page.episodes.isEmpty());
+        CHECK_FALSE(page.paginate.hasNextPage());
+    }
+}
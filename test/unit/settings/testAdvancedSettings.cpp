@@ -29,6 +29,7 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         CHECK(settings.forceCache() == defaults.forceCache());
         CHECK(settings.portableMode() == defaults.portableMode());
         CHECK(settings.episodeThumbnailDimensions() == defaults.episodeThumbnailDimensions());
+        CHECK(settings.artworkMemoryBudget() == 64 * 1024 * 1024);
         CHECK(messages.isEmpty());
     }
 
@@ -38,18 +39,33 @@ TEST_CASE("Advanced Settings XML", "[settings]")
             <log>
                 <debug>true</debug>
                 <file>./MediaElchTest.log</file>
+                <maxFileSize>2</maxFileSize>
+                <maxFiles>5</maxFiles>
+                <overflow>block</overflow>
+                <levels>
+                    <category name="ImdbApi">warning</category>
+                    <category name="">info</category>
+                </levels>
             </log>
             <genres>
                 <map from="SciFi" to="Science Fiction" />
             </genres>
+            <artworkMemoryBudget>16</artworkMemoryBudget>
         )xml");
 
         AdvancedSettings settings = AdvancedSettingsXmlReader::loadFromXml(emptyXml).first;
 
         CHECK(settings.debugLog());
         CHECK(settings.logFile() == "./MediaElchTest.log");
+        CHECK(settings.logMaxFileSize() == 2 * 1024 * 1024);
+        CHECK(settings.logMaxFiles() == 5);
+        CHECK(settings.logOverflowPolicy() == mediaelch::LogOverflowPolicy::Block);
+        REQUIRE(settings.logLevels().size() == 2);
+        CHECK(settings.logLevels()["ImdbApi"] == QtWarningMsg);
+        CHECK(settings.logLevels()[""] == QtInfoMsg);
         REQUIRE(settings.genreMappings().size() == 1);
         CHECK(settings.genreMappings()["SciFi"] == "Science Fiction");
+        CHECK(settings.artworkMemoryBudget() == 16 * 1024 * 1024);
     }
 
     const auto checkEpisodeThumbValues = [](auto pair) {
@@ -122,6 +138,20 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         }
     }
 
+    SECTION("xml with invalid content: artworkMemoryBudget")
+    {
+        QString xml = addBaseXml(R"xml(
+            <artworkMemoryBudget>-1</artworkMemoryBudget>
+        )xml");
+
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(xml);
+
+        CHECK(pair.first.artworkMemoryBudget() == 64 * 1024 * 1024);
+        REQUIRE(pair.second.size() == 1);
+        CHECK(pair.second[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidValue);
+        CHECK(pair.second[0].tag == "artworkMemoryBudget");
+    }
+
     SECTION("exclude patterns")
     {
         SECTION("invalid attribute value")